@@ -1424,6 +1424,19 @@ QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
 			      uint8_t *pcl_weight, uint32_t weight_len,
 			      uint8_t vdev_id);
 
+/**
+ * policy_mgr_invalidate_pcl_cache() - drop the PCLs cached by
+ * policy_mgr_get_pcl()
+ * @psoc: PSOC object information
+ *
+ * Components which change a PCL input owned outside policy manager, like
+ * the DNBS restriction of a SAP, use this to force the next
+ * policy_mgr_get_pcl() to recompute the list.
+ *
+ * Return: None
+ */
+void policy_mgr_invalidate_pcl_cache(struct wlan_objmgr_psoc *psoc);
+
 /**
  * policy_mgr_init_chan_avoidance() - init channel avoidance in policy manager.
  * @psoc: PSOC object information
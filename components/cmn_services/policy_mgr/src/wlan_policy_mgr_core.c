@@ -515,6 +515,7 @@ void policy_mgr_update_conc_list(struct wlan_objmgr_psoc *psoc,
 	pm_conc_connection_list[conn_index].vdev_id = vdev_id;
 	pm_conc_connection_list[conn_index].in_use = in_use;
 	pm_conc_connection_list[conn_index].ch_flagext = ch_flagext;
+	policy_mgr_conc_snapshot_update(pm_ctx);
 	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
 
 	/*
@@ -548,6 +549,101 @@ void policy_mgr_update_conc_list(struct wlan_objmgr_psoc *psoc,
 		pm_ctx->conc_cbacks.connection_info_update();
 }
 
+/**
+ * policy_mgr_conc_snapshot_build() - Build a snapshot of a connection table
+ * @pm_ctx: policy manager context
+ * @conn_list: connection table of MAX_NUMBER_OF_CONC_CONNECTIONS entries
+ * @snap: snapshot to fill
+ *
+ * Return: None
+ */
+static void
+policy_mgr_conc_snapshot_build(struct policy_mgr_psoc_priv_obj *pm_ctx,
+			       struct policy_mgr_conc_connection_info *conn_list,
+			       struct policy_mgr_conc_snapshot *snap)
+{
+	struct policy_mgr_conc_connection_info *conn;
+	uint32_t i, j, num = 0;
+
+	qdf_mem_zero(snap, sizeof(*snap));
+	for (i = 0; i < MAX_NUMBER_OF_CONC_CONNECTIONS; i++) {
+		conn = &conn_list[i];
+		if (!conn->in_use)
+			continue;
+
+		snap->conn[num++] = *conn;
+		if (conn->mode < PM_MAX_NUM_OF_MODE)
+			snap->mode_count[conn->mode]++;
+	}
+	snap->num_connections = num;
+
+	/*
+	 * Same as policy_mgr_current_concurrency_is_mcc() always did, MCC
+	 * is only reported for two or three connections.
+	 */
+	for (i = 0; i < num; i++) {
+		for (j = i + 1; j < num; j++) {
+			if (snap->conn[i].freq == snap->conn[j].freq) {
+				if (snap->conn[i].vdev_id ==
+				    snap->conn[j].vdev_id)
+					continue;
+				snap->scc_with_other[i] = true;
+				snap->scc_with_other[j] = true;
+				continue;
+			}
+			if (!snap->is_mcc && num <= 3 &&
+			    policy_mgr_are_2_freq_on_same_mac(pm_ctx->psoc,
+							      snap->conn[i].freq,
+							      snap->conn[j].freq))
+				snap->is_mcc = true;
+		}
+	}
+}
+
+void policy_mgr_conc_snapshot_update(struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+	policy_mgr_conc_snapshot_set(pm_ctx, pm_conc_connection_list);
+}
+
+void
+policy_mgr_conc_snapshot_set(struct policy_mgr_psoc_priv_obj *pm_ctx,
+			     struct policy_mgr_conc_connection_info *conn_list)
+{
+	struct policy_mgr_conc_snapshot snap;
+
+	policy_mgr_conc_snapshot_build(pm_ctx, conn_list, &snap);
+	snap.version = pm_ctx->conc_snapshot.version + 1;
+
+	/* odd sequence count tells readers the copy below is in progress */
+	qdf_atomic_inc(&pm_ctx->conc_snapshot_seq);
+	qdf_mb();
+	pm_ctx->conc_snapshot = snap;
+	qdf_mb();
+	qdf_atomic_inc(&pm_ctx->conc_snapshot_seq);
+}
+
+void policy_mgr_get_conc_snapshot(struct policy_mgr_psoc_priv_obj *pm_ctx,
+				  struct policy_mgr_conc_snapshot *snap)
+{
+	int32_t seq;
+	uint8_t retry;
+
+	for (retry = 0; retry < PM_SNAPSHOT_READ_RETRY; retry++) {
+		seq = qdf_atomic_read(&pm_ctx->conc_snapshot_seq);
+		if (seq & 1)
+			continue;
+		qdf_mb();
+		qdf_mem_copy(snap, &pm_ctx->conc_snapshot, sizeof(*snap));
+		qdf_mb();
+		if (qdf_atomic_read(&pm_ctx->conc_snapshot_seq) == seq)
+			return;
+	}
+
+	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
+	qdf_mem_copy(snap, &pm_ctx->conc_snapshot, sizeof(*snap));
+	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
+}
+
 /**
  * policy_mgr_store_and_del_conn_info() - Store and del a connection info
  * @psoc: psoc handle
@@ -769,6 +865,7 @@ void policy_mgr_restore_deleted_conn_info(struct wlan_objmgr_psoc *psoc,
 	for (i = 0; i < num_cxn_del; i++)
 		policy_mgr_debug("Restored the deleleted conn info, vdev:%d, index:%d",
 				 info[i].vdev_id, conn_index++);
+	policy_mgr_conc_snapshot_update(pm_ctx);
 	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
 }
 
@@ -903,17 +1000,17 @@ policy_mgr_update_curr_mac_freq(uint32_t num_mac_freq,
 				struct policy_mgr_psoc_priv_obj *pm_ctx,
 				struct policy_mgr_hw_mode_params hw_mode)
 {
-	QDF_STATUS status;
+	QDF_STATUS status = QDF_STATUS_E_INVAL;
 
-	if (num_mac_freq && freq) {
+	if (num_mac_freq && freq)
 		status = policy_mgr_fill_curr_freq_by_pdev_freq(num_mac_freq,
 								freq, pm_ctx,
 								hw_mode);
-		if (QDF_IS_STATUS_SUCCESS(status))
-			return;
-	}
+	if (QDF_IS_STATUS_ERROR(status))
+		policy_mgr_fill_legacy_freq_range(pm_ctx, hw_mode);
 
-	policy_mgr_fill_legacy_freq_range(pm_ctx, hw_mode);
+	/* PCLs built for the previous MAC frequency ranges are stale */
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 }
 
 /**
@@ -974,6 +1071,7 @@ void policy_mgr_update_hw_mode_conn_info(struct wlan_objmgr_psoc *psoc,
 					vdev_mac_map[i].mac_id);
 		}
 	}
+	policy_mgr_conc_snapshot_update(pm_ctx);
 	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
 
 	policy_mgr_dump_connection_status_info(psoc);
@@ -5165,6 +5263,7 @@ void policy_mgr_add_sap_mandatory_chan(struct wlan_objmgr_psoc *psoc,
 
 	pm_ctx->sap_mandatory_channels[pm_ctx->sap_mandatory_channels_len++]
 		= ch_freq;
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 }
 
 uint32_t policy_mgr_get_sap_mandatory_chan_list_len(
@@ -5233,6 +5332,7 @@ void  policy_mgr_add_sap_mandatory_6ghz_chan(struct wlan_objmgr_psoc *psoc)
 				ch_freq_list[i];
 		}
 	}
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 }
 #else
 static inline
@@ -5288,6 +5388,7 @@ policy_mgr_init_sap_mandatory_chan_by_band(struct wlan_objmgr_psoc *psoc,
 				psoc, sap_mand_5g_freq_list[i]);
 	if (band_bitmap & BIT(REG_BAND_6G))
 		policy_mgr_add_sap_mandatory_6ghz_chan(psoc);
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 }
 
 void  policy_mgr_init_sap_mandatory_chan(struct wlan_objmgr_psoc *psoc,
@@ -5343,4 +5444,5 @@ void policy_mgr_remove_sap_mandatory_chan(struct wlan_objmgr_psoc *psoc,
 	qdf_mem_copy(pm_ctx->sap_mandatory_channels, ch_freq_list,
 		     num_chan * sizeof(*pm_ctx->sap_mandatory_channels));
 	pm_ctx->sap_mandatory_channels_len = num_chan;
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 }
@@ -114,6 +114,7 @@ QDF_STATUS policy_mgr_set_dual_mac_feature(struct wlan_objmgr_psoc *psoc,
 	}
 
 	pm_ctx->cfg.dual_mac_feature = dual_mac_feature;
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -175,6 +176,7 @@ QDF_STATUS policy_mgr_set_max_conc_cxns(struct wlan_objmgr_psoc *psoc,
 	policy_mgr_debug("set max_conc_cxns %d old %d", max_conc_cxns,
 			 pm_ctx->cfg.max_conc_cxns);
 	pm_ctx->cfg.max_conc_cxns = max_conc_cxns;
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -191,6 +193,7 @@ policy_mgr_set_sta_sap_scc_on_dfs_chnl(struct wlan_objmgr_psoc *psoc,
 		return QDF_STATUS_E_FAILURE;
 	}
 	pm_ctx->cfg.sta_sap_scc_on_dfs_chnl = sta_sap_scc_on_dfs_chnl;
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -271,6 +274,7 @@ policy_mgr_set_original_bw_for_sap_restart(struct wlan_objmgr_psoc *psoc,
 		return QDF_STATUS_E_FAILURE;
 	}
 	pm_ctx->cfg.use_sap_original_bw = use_sap_original_bw;
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -362,6 +366,7 @@ policy_mgr_update_dfs_master_dynamic_enabled(
 		enable = false;
 end:
 	pm_ctx->dynamic_dfs_master_disabled = !enable;
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 	if (!enable)
 		policy_mgr_debug("sta_sap_scc_on_dfs_chnl %d sta_on_2g %d sta_on_5g %d enable %d",
 				 pm_ctx->cfg.sta_sap_scc_on_dfs_chnl, sta_on_2g,
@@ -488,6 +493,7 @@ QDF_STATUS policy_mgr_set_sys_pref(struct wlan_objmgr_psoc *psoc,
 		return QDF_STATUS_E_FAILURE;
 	}
 	pm_ctx->cfg.sys_pref = sys_pref;
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -548,6 +554,7 @@ QDF_STATUS policy_mgr_set_ch_select_plcy(struct wlan_objmgr_psoc *psoc,
 		return QDF_STATUS_E_FAILURE;
 	}
 	pm_ctx->cfg.chnl_select_plcy = ch_select_policy;
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -624,7 +631,10 @@ void policy_mgr_update_new_hw_mode_index(struct wlan_objmgr_psoc *psoc,
 		policy_mgr_err("Invalid Context");
 		return;
 	}
+	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
 	pm_ctx->new_hw_mode_index = new_hw_mode_index;
+	policy_mgr_conc_snapshot_update(pm_ctx);
+	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
 }
 
 void policy_mgr_update_old_hw_mode_index(struct wlan_objmgr_psoc *psoc,
@@ -637,7 +647,10 @@ void policy_mgr_update_old_hw_mode_index(struct wlan_objmgr_psoc *psoc,
 		policy_mgr_err("Invalid Context");
 		return;
 	}
+	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
 	pm_ctx->old_hw_mode_index = old_hw_mode_index;
+	policy_mgr_conc_snapshot_update(pm_ctx);
+	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
 }
 
 void policy_mgr_update_hw_mode_index(struct wlan_objmgr_psoc *psoc,
@@ -650,12 +663,16 @@ void policy_mgr_update_hw_mode_index(struct wlan_objmgr_psoc *psoc,
 		policy_mgr_err("Invalid Context");
 		return;
 	}
+	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
 	if (POLICY_MGR_DEFAULT_HW_MODE_INDEX == pm_ctx->new_hw_mode_index) {
 		pm_ctx->new_hw_mode_index = new_hw_mode_index;
 	} else {
 		pm_ctx->old_hw_mode_index = pm_ctx->new_hw_mode_index;
 		pm_ctx->new_hw_mode_index = new_hw_mode_index;
 	}
+	/* MCC state of the current connections depends on the HW mode */
+	policy_mgr_conc_snapshot_update(pm_ctx);
+	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
 	policy_mgr_debug("Updated: old_hw_mode_index:%d new_hw_mode_index:%d",
 		pm_ctx->old_hw_mode_index, pm_ctx->new_hw_mode_index);
 }
@@ -1635,6 +1652,11 @@ QDF_STATUS policy_mgr_update_hw_mode_list(struct wlan_objmgr_psoc *psoc,
 	 * Initializing Current frequency with SMM frequency.
 	 */
 	policy_mgr_fill_curr_mac_freq_by_hwmode(pm_ctx, MODE_SMM);
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
+	/* MCC state of the snapshot depends on the frequency ranges */
+	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
+	policy_mgr_conc_snapshot_update(pm_ctx);
+	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
 	policy_mgr_dump_freq_range(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
@@ -3112,24 +3134,18 @@ bool policy_mgr_is_2x2_2G_1x1_5G_dbs_capable(struct wlan_objmgr_psoc *psoc)
 
 uint32_t policy_mgr_get_connection_count(struct wlan_objmgr_psoc *psoc)
 {
-	uint32_t conn_index, count = 0;
 	struct policy_mgr_psoc_priv_obj *pm_ctx;
+	struct policy_mgr_conc_snapshot snap;
 
 	pm_ctx = policy_mgr_get_context(psoc);
 	if (!pm_ctx) {
 		policy_mgr_err("Invalid Context");
-		return count;
+		return 0;
 	}
 
-	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
-	for (conn_index = 0; conn_index < MAX_NUMBER_OF_CONC_CONNECTIONS;
-		conn_index++) {
-		if (pm_conc_connection_list[conn_index].in_use)
-			count++;
-	}
-	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
+	policy_mgr_get_conc_snapshot(pm_ctx, &snap);
 
-	return count;
+	return snap.num_connections;
 }
 
 uint32_t
@@ -3241,14 +3257,25 @@ uint32_t policy_mgr_mode_specific_connection_count(
 		policy_mgr_err("Invalid Context");
 		return count;
 	}
+
+	/* Without a list the precomputed per mode count is enough */
+	if (!list) {
+		struct policy_mgr_conc_snapshot snap;
+
+		if (mode >= PM_MAX_NUM_OF_MODE)
+			return count;
+		policy_mgr_get_conc_snapshot(pm_ctx, &snap);
+
+		return snap.mode_count[mode];
+	}
+
 	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
 	for (conn_index = 0; conn_index < MAX_NUMBER_OF_CONC_CONNECTIONS;
 		conn_index++) {
 		if ((pm_conc_connection_list[conn_index].mode == mode) &&
 			pm_conc_connection_list[conn_index].in_use) {
-			if (list)
-				list[count] = conn_index;
-			 count++;
+			list[count] = conn_index;
+			count++;
 		}
 	}
 	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
@@ -3424,8 +3451,8 @@ bool policy_mgr_is_scc_with_this_vdev_id(struct wlan_objmgr_psoc *psoc,
 					 uint8_t vdev_id)
 {
 	struct policy_mgr_psoc_priv_obj *pm_ctx;
-	uint32_t i, ch_freq;
-	QDF_STATUS status = QDF_STATUS_E_FAILURE;
+	struct policy_mgr_conc_snapshot snap;
+	uint32_t i;
 
 	pm_ctx = policy_mgr_get_context(psoc);
 	if (!pm_ctx) {
@@ -3433,25 +3460,14 @@ bool policy_mgr_is_scc_with_this_vdev_id(struct wlan_objmgr_psoc *psoc,
 		return false;
 	}
 
-	/* Get the channel freq for a given vdev_id */
-	status = policy_mgr_get_chan_by_session_id(psoc, vdev_id,
-						   &ch_freq);
-	if (QDF_IS_STATUS_ERROR(status)) {
-		policy_mgr_err("Failed to get channel for vdev:%d", vdev_id);
-		return false;
+	/* SCC state of every connection is precomputed in the snapshot */
+	policy_mgr_get_conc_snapshot(pm_ctx, &snap);
+	for (i = 0; i < snap.num_connections; i++) {
+		if (snap.conn[i].vdev_id == vdev_id)
+			return snap.scc_with_other[i];
 	}
 
-	/* Compare given vdev_id freq against other vdev_id's */
-	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
-	for (i = 0; i < MAX_NUMBER_OF_CONC_CONNECTIONS; i++) {
-		if ((pm_conc_connection_list[i].vdev_id != vdev_id) &&
-		    (pm_conc_connection_list[i].in_use) &&
-		    (pm_conc_connection_list[i].freq == ch_freq)) {
-			qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
-			return true;
-		}
-	}
-	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
+	policy_mgr_err("Failed to get channel for vdev:%d", vdev_id);
 
 	return false;
 }
@@ -3584,62 +3600,18 @@ bool policy_mgr_current_concurrency_is_scc(struct wlan_objmgr_psoc *psoc)
 
 bool policy_mgr_current_concurrency_is_mcc(struct wlan_objmgr_psoc *psoc)
 {
-	uint32_t num_connections = 0;
-	bool is_mcc = false;
 	struct policy_mgr_psoc_priv_obj *pm_ctx;
+	struct policy_mgr_conc_snapshot snap;
 
 	pm_ctx = policy_mgr_get_context(psoc);
 	if (!pm_ctx) {
 		policy_mgr_err("Invalid Context");
-		return is_mcc;
+		return false;
 	}
 
-	num_connections = policy_mgr_get_connection_count(psoc);
-	if (!num_connections)
-		return is_mcc;
-
-	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
-	switch (num_connections) {
-	case 1:
-		break;
-	case 2:
-		if (pm_conc_connection_list[0].freq !=
-		    pm_conc_connection_list[1].freq &&
-		    policy_mgr_are_2_freq_on_same_mac(psoc,
-			pm_conc_connection_list[0].freq,
-			pm_conc_connection_list[1].freq))
-			is_mcc = true;
-		break;
-	case 3:
-		/*
-		 * Check if any 2 different freq is on same MAC.
-		 * Return true if any of the different freq is on same MAC.
-		 */
-		if ((pm_conc_connection_list[0].freq !=
-		     pm_conc_connection_list[1].freq &&
-		     policy_mgr_are_2_freq_on_same_mac(psoc,
-			pm_conc_connection_list[0].freq,
-			pm_conc_connection_list[1].freq)) ||
-		    (pm_conc_connection_list[0].freq !=
-		     pm_conc_connection_list[2].freq &&
-		     policy_mgr_are_2_freq_on_same_mac(psoc,
-			pm_conc_connection_list[0].freq,
-			pm_conc_connection_list[2].freq)) ||
-		    (pm_conc_connection_list[1].freq !=
-		     pm_conc_connection_list[2].freq &&
-		     policy_mgr_are_2_freq_on_same_mac(psoc,
-			pm_conc_connection_list[1].freq,
-			pm_conc_connection_list[2].freq)))
-			is_mcc = true;
-		break;
-	default:
-		policy_mgr_debug("unexpected num_connections value %d",
-				 num_connections);
-		break;
-	}
-	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
+	policy_mgr_get_conc_snapshot(pm_ctx, &snap);
 
-	return is_mcc;
+	return snap.is_mcc;
 }
 
 bool policy_mgr_is_sap_p2pgo_on_dfs(struct wlan_objmgr_psoc *psoc)
@@ -5407,6 +5379,7 @@ QDF_STATUS policy_mgr_decr_connection_count(struct wlan_objmgr_psoc *psoc,
 	/* clean up the entry */
 	qdf_mem_zero(&pm_conc_connection_list[next_conn_index - 1],
 		sizeof(*pm_conc_connection_list));
+	policy_mgr_conc_snapshot_update(pm_ctx);
 
 	conn_index = 0;
 	while (PM_CONC_CONNECTION_LIST_VALID_INDEX(conn_index)) {
@@ -9913,6 +9886,7 @@ QDF_STATUS policy_mgr_set_user_cfg(struct wlan_objmgr_psoc *psoc,
 	policy_mgr_debug("vdev_priority_list 0x%x",
 			 pm_ctx->cfg.vdev_priority_list);
 	pm_ctx->cur_conc_system_pref = pm_ctx->cfg.sys_pref;
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -10727,6 +10701,7 @@ void policy_mgr_dump_connection_status_info(struct wlan_objmgr_psoc *psoc)
 
 	policy_mgr_dump_curr_freq_range(pm_ctx);
 	policy_mgr_validate_conn_info(psoc);
+	policy_mgr_dump_pcl_cache_stats(pm_ctx);
 }
 
 bool policy_mgr_is_any_mode_active_on_band_along_with_session(
@@ -11146,6 +11121,7 @@ void policy_mgr_set_cur_conc_system_pref(struct wlan_objmgr_psoc *psoc,
 
 	policy_mgr_debug("conc_system_pref %hu", conc_system_pref);
 	pm_ctx->cur_conc_system_pref = conc_system_pref;
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 }
 
 uint8_t policy_mgr_get_cur_conc_system_pref(struct wlan_objmgr_psoc *psoc)
@@ -11691,6 +11667,7 @@ void policy_mgr_init_ap_6ghz_capable(struct wlan_objmgr_psoc *psoc,
 			conn_info->conn_6ghz_flag = ap_6ghz_capable;
 			conn_info->conn_6ghz_flag |= CONN_6GHZ_FLAG_VALID;
 			conn_6ghz_flag = conn_info->conn_6ghz_flag;
+			policy_mgr_conc_snapshot_update(pm_ctx);
 			break;
 		}
 	}
@@ -11729,6 +11706,7 @@ void policy_mgr_set_ap_6ghz_capable(struct wlan_objmgr_psoc *psoc,
 				conn_info->conn_6ghz_flag &= ~ap_6ghz_capable;
 			conn_info->conn_6ghz_flag |= CONN_6GHZ_FLAG_VALID;
 			conn_6ghz_flag = conn_info->conn_6ghz_flag;
+			policy_mgr_conc_snapshot_update(pm_ctx);
 			break;
 		}
 	}
@@ -12836,6 +12814,7 @@ policy_mgr_reset_sap_mandatory_channels(struct wlan_objmgr_psoc *psoc)
 	qdf_mem_zero(pm_ctx->sap_mandatory_channels,
 		     QDF_ARRAY_SIZE(pm_ctx->sap_mandatory_channels) *
 		     sizeof(*pm_ctx->sap_mandatory_channels));
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -24,6 +24,7 @@
 #include "qdf_event.h"
 #include "qdf_mc_timer.h"
 #include "qdf_lock.h"
+#include "qdf_atomic.h"
 #include "qdf_defer.h"
 #include "wlan_reg_services_api.h"
 #include "cds_ieee80211_common_i.h"
@@ -312,6 +313,76 @@ struct policy_mgr_cfg {
 	bool move_sap_go_1st_on_dfs_sta_csa;
 };
 
+/* Lockless snapshot read attempts before falling back to the list lock */
+#define PM_SNAPSHOT_READ_RETRY 4
+
+/**
+ * struct policy_mgr_conc_snapshot - read only copy of the connection table
+ * @version: incremented every time the snapshot is rebuilt
+ * @num_connections: number of in use entries in @conn
+ * @mode_count: number of connections per policy_mgr_con_mode
+ * @is_mcc: two different frequencies share a MAC
+ * @scc_with_other: @conn[i] shares its frequency with another vdev
+ * @conn: in use entries, in pm_conc_connection_list order
+ */
+struct policy_mgr_conc_snapshot {
+	uint32_t version;
+	uint32_t num_connections;
+	uint8_t mode_count[PM_MAX_NUM_OF_MODE];
+	bool is_mcc;
+	bool scc_with_other[MAX_NUMBER_OF_CONC_CONNECTIONS];
+	struct policy_mgr_conc_connection_info
+				conn[MAX_NUMBER_OF_CONC_CONNECTIONS];
+};
+
+/* Number of buckets of the PCL compute time histogram */
+#define PM_PCL_CACHE_HIST_BUCKETS 6
+
+/**
+ * struct policy_mgr_pcl_cache_entry - cached PCL of one connection mode
+ * @valid: entry holds a PCL
+ * @conc_version: connection table snapshot version the PCL was built for
+ * @chan_gen: policy_mgr_pcl_cache.gen the PCL was built for
+ * @sys_pref: concurrency system preference the PCL was built for
+ * @cfg_key: configuration the PCL was built for, see
+ *	     policy_mgr_pcl_cache_cfg_key()
+ * @weight_len: weight list length requested by the caller
+ * @len: number of channels in @pcl
+ * @pcl: preferred channel frequency list
+ * @weight: weights of @pcl
+ */
+struct policy_mgr_pcl_cache_entry {
+	bool valid;
+	uint32_t conc_version;
+	int32_t chan_gen;
+	uint8_t sys_pref;
+	uint32_t cfg_key;
+	uint32_t weight_len;
+	uint32_t len;
+	uint32_t pcl[NUM_CHANNELS];
+	uint8_t weight[NUM_CHANNELS];
+};
+
+/**
+ * struct policy_mgr_pcl_cache - PCL cache of policy_mgr_get_pcl()
+ * @gen: bumped every time a PCL input other than the connection table
+ *       changes, i.e. regulatory/NOL, unsafe channels, SAP mandatory
+ *       channels and concurrency config; also counts invalidations
+ * @entry: one cached PCL per connection mode
+ * @hit: number of PCLs served from the cache
+ * @miss: number of PCLs computed
+ * @compute_hist: histogram of PCL compute time in usecs
+ *
+ * Entries are protected by qdf_conc_list_lock.
+ */
+struct policy_mgr_pcl_cache {
+	qdf_atomic_t gen;
+	struct policy_mgr_pcl_cache_entry entry[PM_MAX_NUM_OF_MODE];
+	uint32_t hit;
+	uint32_t miss;
+	uint32_t compute_hist[PM_PCL_CACHE_HIST_BUCKETS];
+};
+
 /**
  * struct policy_mgr_psoc_priv_obj - Policy manager private data
  * @psoc: pointer to PSOC object information
@@ -382,6 +453,11 @@ struct policy_mgr_cfg {
  * @set_link_update_done_evt: qdf event to synchronize set link
  * @active_vdev_bitmap: Active vdev id bitmap
  * @inactive_vdev_bitmap: Inactive vdev id bitmap
+ * @conc_snapshot_seq: sequence count of @conc_snapshot, odd while the
+ *                     snapshot is being rebuilt
+ * @conc_snapshot: lockless readable copy of pm_conc_connection_list
+ * @pcl_cache: PCL cache keyed by mode, connection table version and
+ *             channel generation
  * @restriction_mask:
  */
 struct policy_mgr_psoc_priv_obj {
@@ -433,6 +509,9 @@ struct policy_mgr_psoc_priv_obj {
 #endif
 	uint32_t active_vdev_bitmap;
 	uint32_t inactive_vdev_bitmap;
+	qdf_atomic_t conc_snapshot_seq;
+	struct policy_mgr_conc_snapshot conc_snapshot;
+	struct policy_mgr_pcl_cache pcl_cache;
 #ifdef FEATURE_WLAN_CH_AVOID_EXT
 	uint32_t restriction_mask;
 #endif
@@ -721,6 +800,121 @@ void policy_mgr_update_conc_list(struct wlan_objmgr_psoc *psoc,
 		bool update_conn,
 		uint16_t ch_flagext);
 
+/**
+ * policy_mgr_conc_snapshot_update() - Rebuild the connection table snapshot
+ * @pm_ctx: policy manager context
+ *
+ * Must be called with qdf_conc_list_lock held, after every change of
+ * pm_conc_connection_list or of the current HW mode, so that lockless
+ * readers observe the new table.
+ *
+ * Return: None
+ */
+void policy_mgr_conc_snapshot_update(struct policy_mgr_psoc_priv_obj *pm_ctx);
+
+/**
+ * policy_mgr_conc_snapshot_set() - Publish a snapshot of a connection table
+ * @pm_ctx: policy manager context
+ * @conn_list: connection table of MAX_NUMBER_OF_CONC_CONNECTIONS entries
+ *
+ * policy_mgr_conc_snapshot_update() for pm_conc_connection_list; other
+ * tables are only used by the policy manager unit test together with a
+ * private @pm_ctx. Must be called with qdf_conc_list_lock of @pm_ctx held.
+ *
+ * Return: None
+ */
+void
+policy_mgr_conc_snapshot_set(struct policy_mgr_psoc_priv_obj *pm_ctx,
+			     struct policy_mgr_conc_connection_info *conn_list);
+
+/**
+ * policy_mgr_get_conc_snapshot() - Get a consistent copy of the
+ * connection table snapshot
+ * @pm_ctx: policy manager context
+ * @snap: filled with the snapshot
+ *
+ * Copies the snapshot without taking qdf_conc_list_lock. If a writer keeps
+ * rebuilding the snapshot for PM_SNAPSHOT_READ_RETRY attempts the copy is
+ * taken under the lock instead. All fields of @snap describe the same
+ * version of the table.
+ *
+ * Return: None
+ */
+void policy_mgr_get_conc_snapshot(struct policy_mgr_psoc_priv_obj *pm_ctx,
+				  struct policy_mgr_conc_snapshot *snap);
+
+/**
+ * policy_mgr_pcl_cache_invalidate() - Invalidate all cached PCLs
+ * @pm_ctx: policy manager context
+ *
+ * To be called whenever a PCL input which is not part of the connection
+ * table changes. Changes of the connection table invalidate the cache
+ * through the snapshot version.
+ *
+ * Return: None
+ */
+void policy_mgr_pcl_cache_invalidate(struct policy_mgr_psoc_priv_obj *pm_ctx);
+
+/**
+ * policy_mgr_compute_pcl() - Build the PCL of a new connection
+ * @psoc: PSOC object information
+ * @mode: Device mode
+ * @pcl_channels: Preferred channel freq list
+ * @len: length of the PCL
+ * @pcl_weight: Weights of the PCL
+ * @weight_len: Max length of the weights list
+ * @vdev_id: Vdev id
+ *
+ * Same as policy_mgr_get_pcl() without the PCL cache.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS policy_mgr_compute_pcl(struct wlan_objmgr_psoc *psoc,
+				  enum policy_mgr_con_mode mode,
+				  uint32_t *pcl_channels, uint32_t *len,
+				  uint8_t *pcl_weight, uint32_t weight_len,
+				  uint8_t vdev_id);
+
+/* Signature of policy_mgr_compute_pcl() */
+typedef QDF_STATUS
+(*policy_mgr_pcl_compute_cb)(struct wlan_objmgr_psoc *psoc,
+			     enum policy_mgr_con_mode mode,
+			     uint32_t *pcl_channels, uint32_t *len,
+			     uint8_t *pcl_weight, uint32_t weight_len,
+			     uint8_t vdev_id);
+
+/**
+ * policy_mgr_pcl_cache_lookup() - Serve a PCL from the cache or compute it
+ * @pm_ctx: policy manager context
+ * @mode: Device mode
+ * @cfg_key: configuration key the PCL is computed for
+ * @compute: computes the PCL on a cache miss
+ * @pcl_channels: Preferred channel freq list
+ * @len: length of the PCL
+ * @pcl_weight: Weights of the PCL
+ * @weight_len: Max length of the weights list
+ * @vdev_id: Vdev id
+ *
+ * Body of policy_mgr_get_pcl(), which passes policy_mgr_compute_pcl().
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS
+policy_mgr_pcl_cache_lookup(struct policy_mgr_psoc_priv_obj *pm_ctx,
+			    enum policy_mgr_con_mode mode, uint32_t cfg_key,
+			    policy_mgr_pcl_compute_cb compute,
+			    uint32_t *pcl_channels, uint32_t *len,
+			    uint8_t *pcl_weight, uint32_t weight_len,
+			    uint8_t vdev_id);
+
+/**
+ * policy_mgr_dump_pcl_cache_stats() - Log PCL cache counters
+ * @pm_ctx: policy manager context
+ *
+ * Return: None
+ */
+void policy_mgr_dump_pcl_cache_stats(struct policy_mgr_psoc_priv_obj *pm_ctx);
+
 void policy_mgr_store_and_del_conn_info(struct wlan_objmgr_psoc *psoc,
 				enum policy_mgr_con_mode mode,
 				bool all_matching_cxn_to_del,
@@ -548,7 +548,10 @@ QDF_STATUS policy_mgr_psoc_enable(struct wlan_objmgr_psoc *psoc)
 	policy_mgr_debug("Initializing the policy manager");
 
 	/* init pm_conc_connection_list */
+	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
 	qdf_mem_zero(pm_conc_connection_list, sizeof(pm_conc_connection_list));
+	policy_mgr_conc_snapshot_update(pm_ctx);
+	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
 	policy_mgr_memzero_disabled_ml_list();
 	policy_mgr_clear_concurrent_session_count(psoc);
 	/* init dbs_opportunistic_timer */
@@ -747,7 +750,10 @@ QDF_STATUS policy_mgr_psoc_disable(struct wlan_objmgr_psoc *psoc)
 	}
 
 	/* deinit pm_conc_connection_list */
+	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
 	qdf_mem_zero(pm_conc_connection_list, sizeof(pm_conc_connection_list));
+	policy_mgr_conc_snapshot_update(pm_ctx);
+	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
 	policy_mgr_clear_concurrent_session_count(psoc);
 
 	return status;
@@ -547,6 +547,7 @@ policy_mgr_reg_chan_change_callback(struct wlan_objmgr_psoc *psoc,
 	}
 
 	policy_mgr_update_valid_ch_freq_list(pm_ctx, chan_list, false);
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 
 	if (!avoid_freq_ind) {
 		policy_mgr_debug("avoid_freq_ind NULL");
@@ -568,6 +569,7 @@ policy_mgr_reg_chan_change_callback(struct wlan_objmgr_psoc *psoc,
 	for (i = 0; i < pm_ctx->unsafe_channel_count; i++)
 		pm_ctx->unsafe_channel_list[i] =
 			avoid_freq_ind->chan_list.chan_freq_list[i];
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 
 	policy_mgr_debug("Channel list update, received %d avoided channels",
 			 pm_ctx->unsafe_channel_count);
@@ -591,6 +593,7 @@ QDF_STATUS policy_mgr_init_chan_avoidance(struct wlan_objmgr_psoc *psoc,
 
 	for (i = 0; i < pm_ctx->unsafe_channel_count; i++)
 		pm_ctx->unsafe_channel_list[i] = chan_freq_list[i];
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 
 	policy_mgr_debug("Channel list init, received %d avoided channels",
 			 pm_ctx->unsafe_channel_count);
@@ -1714,11 +1717,11 @@ static inline enum policy_mgr_pcl_type policy_mgr_get_pcl_4_port(
 {return PM_MAX_PCL_TYPE; }
 #endif
 
-QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
-			      enum policy_mgr_con_mode mode,
-			      uint32_t *pcl_channels, uint32_t *len,
-			      uint8_t *pcl_weight, uint32_t weight_len,
-			      uint8_t vdev_id)
+QDF_STATUS policy_mgr_compute_pcl(struct wlan_objmgr_psoc *psoc,
+				  enum policy_mgr_con_mode mode,
+				  uint32_t *pcl_channels, uint32_t *len,
+				  uint8_t *pcl_weight, uint32_t weight_len,
+				  uint8_t vdev_id)
 {
 	QDF_STATUS status = QDF_STATUS_E_FAILURE;
 	uint32_t num_connections = 0;
@@ -1852,6 +1855,250 @@ QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
 	return QDF_STATUS_SUCCESS;
 }
 
+/* Upper bounds in usecs of all but the last PCL compute time bucket */
+static const uint32_t
+pm_pcl_hist_bound_us[PM_PCL_CACHE_HIST_BUCKETS - 1] = {
+	50, 100, 250, 500, 1000
+};
+
+void policy_mgr_pcl_cache_invalidate(struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+	qdf_atomic_inc(&pm_ctx->pcl_cache.gen);
+}
+
+void policy_mgr_invalidate_pcl_cache(struct wlan_objmgr_psoc *psoc)
+{
+	struct policy_mgr_psoc_priv_obj *pm_ctx;
+
+	pm_ctx = policy_mgr_get_context(psoc);
+	if (!pm_ctx) {
+		policy_mgr_err("Invalid Context");
+		return;
+	}
+
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
+}
+
+void policy_mgr_dump_pcl_cache_stats(struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+	struct policy_mgr_pcl_cache *cache = &pm_ctx->pcl_cache;
+
+	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
+	policy_mgr_debug("PCL cache: hit %u miss %u invalidate %d",
+			 cache->hit, cache->miss,
+			 qdf_atomic_read(&cache->gen));
+	policy_mgr_debug("PCL compute us: <50 %u <100 %u <250 %u <500 %u <1000 %u >=1000 %u",
+			 cache->compute_hist[0], cache->compute_hist[1],
+			 cache->compute_hist[2], cache->compute_hist[3],
+			 cache->compute_hist[4], cache->compute_hist[5]);
+	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
+}
+
+/* Bits of the PCL cache configuration key */
+#define PM_PCL_KEY_DFS_MASTER		BIT(0)
+#define PM_PCL_KEY_INDOOR		BIT(1)
+#define PM_PCL_KEY_KEEP_6GHZ_STA_CLI	BIT(2)
+#define PM_PCL_KEY_SRD_SAP		BIT(3)
+#define PM_PCL_KEY_SRD_GO		BIT(4)
+#define PM_PCL_KEY_6GHZ_PWR_SHIFT	8
+
+/**
+ * policy_mgr_pcl_cache_cfg_key() - Sample the PCL inputs owned by other
+ * components
+ * @psoc: PSOC object information
+ * @pm_ctx: policy manager context
+ *
+ * DFS master capability, indoor channel support, SRD master mode, the
+ * keep 6 GHz STA/CLI setting and the 6 GHz power type of a STA/CLI are
+ * set outside policy manager without notifying it, so they are part of
+ * the cache key instead of bumping policy_mgr_pcl_cache.gen.
+ *
+ * Return: configuration key
+ */
+static uint32_t
+policy_mgr_pcl_cache_cfg_key(struct wlan_objmgr_psoc *psoc,
+			     struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+	struct policy_mgr_conc_snapshot snap;
+	struct policy_mgr_conc_connection_info *conn;
+	struct wlan_objmgr_vdev *vdev;
+	uint32_t key = 0, pwr_type = REG_MAX_AP_TYPE, i;
+	bool val;
+
+	if (QDF_IS_STATUS_SUCCESS(ucfg_mlme_get_dfs_master_capability(psoc,
+								      &val)) &&
+	    val)
+		key |= PM_PCL_KEY_DFS_MASTER;
+	if (QDF_IS_STATUS_SUCCESS(ucfg_mlme_get_indoor_channel_support(psoc,
+								       &val)) &&
+	    val)
+		key |= PM_PCL_KEY_INDOOR;
+	if (wlan_reg_get_keep_6ghz_sta_cli_connection(pm_ctx->pdev))
+		key |= PM_PCL_KEY_KEEP_6GHZ_STA_CLI;
+	val = false;
+	wlan_mlme_get_srd_master_mode_for_vdev(psoc, QDF_SAP_MODE, &val);
+	if (val)
+		key |= PM_PCL_KEY_SRD_SAP;
+	val = false;
+	wlan_mlme_get_srd_master_mode_for_vdev(psoc, QDF_P2P_GO_MODE, &val);
+	if (val)
+		key |= PM_PCL_KEY_SRD_GO;
+
+	/* same STA/CLI policy_mgr_modify_pcl_based_on_6ghz() looks at */
+	policy_mgr_get_conc_snapshot(pm_ctx, &snap);
+	for (i = 0; i < snap.num_connections; i++) {
+		conn = &snap.conn[i];
+		if ((conn->mode != PM_STA_MODE &&
+		     conn->mode != PM_P2P_CLIENT_MODE) ||
+		    !WLAN_REG_IS_6GHZ_CHAN_FREQ(conn->freq))
+			continue;
+
+		vdev = wlan_objmgr_get_vdev_by_id_from_psoc(psoc,
+							    conn->vdev_id,
+							    WLAN_POLICY_MGR_ID);
+		if (vdev) {
+			pwr_type = wlan_mlme_get_6g_ap_power_type(vdev);
+			wlan_objmgr_vdev_release_ref(vdev, WLAN_POLICY_MGR_ID);
+		}
+		break;
+	}
+
+	return key | (pwr_type << PM_PCL_KEY_6GHZ_PWR_SHIFT);
+}
+
+/**
+ * policy_mgr_pcl_cache_match() - Check if a cached PCL can be used
+ * @entry: cache entry
+ * @conc_version: current connection table snapshot version
+ * @chan_gen: current channel generation
+ * @sys_pref: current concurrency system preference
+ * @cfg_key: current configuration key
+ * @weight_len: weight list length requested by the caller
+ *
+ * Return: true if @entry was built for the given state
+ */
+static bool
+policy_mgr_pcl_cache_match(struct policy_mgr_pcl_cache_entry *entry,
+			   uint32_t conc_version, int32_t chan_gen,
+			   uint8_t sys_pref, uint32_t cfg_key,
+			   uint32_t weight_len)
+{
+	return entry->valid && entry->conc_version == conc_version &&
+	       entry->chan_gen == chan_gen && entry->sys_pref == sys_pref &&
+	       entry->cfg_key == cfg_key && entry->weight_len == weight_len;
+}
+
+/**
+ * policy_mgr_pcl_cache_account() - Update the PCL compute time histogram
+ * @cache: PCL cache
+ * @duration_us: time taken by policy_mgr_compute_pcl()
+ *
+ * Return: None
+ */
+static void policy_mgr_pcl_cache_account(struct policy_mgr_pcl_cache *cache,
+					 uint64_t duration_us)
+{
+	uint8_t i;
+
+	for (i = 0; i < PM_PCL_CACHE_HIST_BUCKETS - 1; i++) {
+		if (duration_us < pm_pcl_hist_bound_us[i])
+			break;
+	}
+	cache->compute_hist[i]++;
+}
+
+QDF_STATUS
+policy_mgr_pcl_cache_lookup(struct policy_mgr_psoc_priv_obj *pm_ctx,
+			    enum policy_mgr_con_mode mode, uint32_t cfg_key,
+			    policy_mgr_pcl_compute_cb compute,
+			    uint32_t *pcl_channels, uint32_t *len,
+			    uint8_t *pcl_weight, uint32_t weight_len,
+			    uint8_t vdev_id)
+{
+	struct policy_mgr_pcl_cache_entry *entry;
+	uint32_t conc_version;
+	int32_t chan_gen;
+	uint8_t sys_pref;
+	uint64_t start_us;
+	QDF_STATUS status;
+
+	entry = &pm_ctx->pcl_cache.entry[mode];
+	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
+	conc_version = pm_ctx->conc_snapshot.version;
+	chan_gen = qdf_atomic_read(&pm_ctx->pcl_cache.gen);
+	sys_pref = pm_ctx->cur_conc_system_pref;
+	if (policy_mgr_pcl_cache_match(entry, conc_version, chan_gen,
+				       sys_pref, cfg_key, weight_len)) {
+		pm_ctx->pcl_cache.hit++;
+		*len = entry->len;
+		qdf_mem_copy(pcl_channels, entry->pcl,
+			     entry->len * sizeof(*pcl_channels));
+		qdf_mem_copy(pcl_weight, entry->weight, entry->len);
+		qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
+		policy_mgr_debug("mode %d vdev_id %d: cached PCL len %d",
+				 mode, vdev_id, *len);
+		return QDF_STATUS_SUCCESS;
+	}
+	pm_ctx->pcl_cache.miss++;
+	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
+
+	start_us = qdf_get_log_timestamp_usecs();
+	status = compute(pm_ctx->psoc, mode, pcl_channels, len, pcl_weight,
+			 weight_len, vdev_id);
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
+	/*
+	 * The entry is keyed with the state sampled before the compute, if
+	 * the state changed meanwhile the entry is simply never hit.
+	 */
+	qdf_mutex_acquire(&pm_ctx->qdf_conc_list_lock);
+	policy_mgr_pcl_cache_account(&pm_ctx->pcl_cache,
+				     qdf_get_log_timestamp_usecs() - start_us);
+	if (*len <= NUM_CHANNELS && *len <= weight_len) {
+		entry->conc_version = conc_version;
+		entry->chan_gen = chan_gen;
+		entry->sys_pref = sys_pref;
+		entry->cfg_key = cfg_key;
+		entry->weight_len = weight_len;
+		entry->len = *len;
+		qdf_mem_copy(entry->pcl, pcl_channels,
+			     *len * sizeof(*pcl_channels));
+		qdf_mem_copy(entry->weight, pcl_weight, *len);
+		entry->valid = true;
+	}
+	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
+
+	return status;
+}
+
+QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
+			      enum policy_mgr_con_mode mode,
+			      uint32_t *pcl_channels, uint32_t *len,
+			      uint8_t *pcl_weight, uint32_t weight_len,
+			      uint8_t vdev_id)
+{
+	struct policy_mgr_psoc_priv_obj *pm_ctx;
+
+	pm_ctx = policy_mgr_get_context(psoc);
+	if (!pm_ctx) {
+		policy_mgr_err("context is NULL");
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	if ((mode < 0) || (mode >= PM_MAX_NUM_OF_MODE)) {
+		policy_mgr_err("Invalid connection mode %d received", mode);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	return policy_mgr_pcl_cache_lookup(pm_ctx, mode,
+					   policy_mgr_pcl_cache_cfg_key(psoc,
+									pm_ctx),
+					   policy_mgr_compute_pcl,
+					   pcl_channels, len, pcl_weight,
+					   weight_len, vdev_id);
+}
+
 enum policy_mgr_conc_priority_mode
 		policy_mgr_get_first_connection_pcl_table_index(
 		struct wlan_objmgr_psoc *psoc)
@@ -3990,6 +4237,7 @@ policy_mgr_set_sap_mandatory_channels(struct wlan_objmgr_psoc *psoc,
 	}
 
 	pm_ctx->sap_mandatory_channels_len = len;
+	policy_mgr_pcl_cache_invalidate(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
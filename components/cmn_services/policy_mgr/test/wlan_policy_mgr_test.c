@@ -0,0 +1,491 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "wlan_policy_mgr_api.h"
+#include "wlan_policy_mgr_i.h"
+#include "wlan_policy_mgr_test.h"
+#include "wlan_objmgr_global_obj.h"
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+
+#define pm_test_log(fmt, args...) \
+	qdf_nofl_info("pm_test: " fmt, ##args)
+
+#define PM_TEST_MAX_STEPS	6
+
+/* Base of the channel the stub PCL appends for the new connection */
+#define PM_TEST_PCL_BASE_FREQ	2412
+
+/**
+ * enum pm_test_op - scripted connection table operation
+ * @PM_TEST_ADD: add a connection
+ * @PM_TEST_DEL: remove a connection
+ */
+enum pm_test_op {
+	PM_TEST_ADD,
+	PM_TEST_DEL,
+};
+
+/**
+ * struct pm_test_step - one step of a concurrency scenario
+ * @op: operation
+ * @mode: connection mode
+ * @freq: operating frequency, PM_TEST_ADD only
+ * @bw: bandwidth, PM_TEST_ADD only
+ * @vdev_id: vdev id of the simulated connection
+ */
+struct pm_test_step {
+	enum pm_test_op op;
+	enum policy_mgr_con_mode mode;
+	qdf_freq_t freq;
+	enum hw_mode_bandwidth bw;
+	uint8_t vdev_id;
+};
+
+/**
+ * struct pm_test_scenario - scripted connection sequence
+ * @name: scenario name
+ * @num_steps: number of valid entries in @step
+ * @step: steps replayed in order
+ */
+struct pm_test_scenario {
+	const char *name;
+	uint8_t num_steps;
+	struct pm_test_step step[PM_TEST_MAX_STEPS];
+};
+
+/**
+ * struct pm_test_ctx - test working memory
+ * @pm_ctx: private policy manager context, never registered with the psoc
+ * @conn_list: private connection table the snapshot is built from
+ * @num_compute: number of PCLs computed by the stub
+ * @cfg_key: configuration key passed to the cache
+ * @pcl: PCL of the cold run
+ * @weight: weights of the cold run
+ * @cached_pcl: PCL of the warm run
+ * @cached_weight: weights of the warm run
+ * @ref_pcl: PCL computed without the cache
+ * @ref_weight: weights computed without the cache
+ * @num_lookup: number of cache hits timed
+ * @warm_us: total cache hit latency
+ */
+struct pm_test_ctx {
+	struct policy_mgr_psoc_priv_obj *pm_ctx;
+	struct policy_mgr_conc_connection_info
+				conn_list[MAX_NUMBER_OF_CONC_CONNECTIONS];
+	uint32_t num_compute;
+	uint32_t cfg_key;
+	uint32_t pcl[NUM_CHANNELS];
+	uint8_t weight[NUM_CHANNELS];
+	uint32_t cached_pcl[NUM_CHANNELS];
+	uint8_t cached_weight[NUM_CHANNELS];
+	uint32_t ref_pcl[NUM_CHANNELS];
+	uint8_t ref_weight[NUM_CHANNELS];
+	uint32_t num_lookup;
+	uint64_t warm_us;
+};
+
+/* context the stub PCL compute runs on, set while the test runs */
+static struct pm_test_ctx *pm_test_cur;
+
+static const struct pm_test_scenario pm_test_scenarios[] = {
+	{
+		.name = "sta_sap",
+		.num_steps = 4,
+		.step = {
+			{ PM_TEST_ADD, PM_STA_MODE, 5180, HW_MODE_80_MHZ, 0 },
+			{ PM_TEST_ADD, PM_SAP_MODE, 2437, HW_MODE_20_MHZ, 1 },
+			{ PM_TEST_DEL, PM_SAP_MODE, 0, 0, 1 },
+			{ PM_TEST_DEL, PM_STA_MODE, 0, 0, 0 },
+		},
+	},
+	{
+		.name = "sta_p2p",
+		.num_steps = 3,
+		.step = {
+			{ PM_TEST_ADD, PM_STA_MODE, 2412, HW_MODE_20_MHZ, 0 },
+			{ PM_TEST_ADD, PM_P2P_CLIENT_MODE, 5745,
+			  HW_MODE_80_MHZ, 1 },
+			{ PM_TEST_ADD, PM_P2P_GO_MODE, 5180, HW_MODE_80_MHZ, 2 },
+		},
+	},
+	{
+		.name = "sta_nan_sap",
+		.num_steps = 3,
+		.step = {
+			{ PM_TEST_ADD, PM_STA_MODE, 5745, HW_MODE_80_MHZ, 0 },
+			{ PM_TEST_ADD, PM_NAN_DISC_MODE, 2437,
+			  HW_MODE_20_MHZ, 1 },
+			{ PM_TEST_ADD, PM_SAP_MODE, 5745, HW_MODE_80_MHZ, 2 },
+		},
+	},
+	{
+		.name = "sta_sta_sap",
+		.num_steps = 4,
+		.step = {
+			{ PM_TEST_ADD, PM_STA_MODE, 5180, HW_MODE_80_MHZ, 0 },
+			{ PM_TEST_ADD, PM_STA_MODE, 5955, HW_MODE_160_MHZ, 1 },
+			{ PM_TEST_ADD, PM_SAP_MODE, 2412, HW_MODE_20_MHZ, 2 },
+			{ PM_TEST_DEL, PM_STA_MODE, 0, 0, 1 },
+		},
+	},
+};
+
+static const enum policy_mgr_con_mode pm_test_query_modes[] = {
+	PM_STA_MODE,
+	PM_SAP_MODE,
+	PM_P2P_CLIENT_MODE,
+	PM_P2P_GO_MODE,
+	PM_NAN_DISC_MODE,
+};
+
+/**
+ * pm_test_compute_pcl() - stub of policy_mgr_compute_pcl()
+ * @psoc: unused
+ * @mode: mode of the new connection
+ * @pcl_channels: filled with the frequencies of the current connections
+ *		  followed by one frequency derived from @mode
+ * @len: length of the PCL
+ * @pcl_weight: weights of the PCL
+ * @weight_len: max length of @pcl_weight
+ * @vdev_id: unused
+ *
+ * The PCL only depends on the private snapshot and @mode, so a cached
+ * PCL which outlived a table change shows up as a mismatch.
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS pm_test_compute_pcl(struct wlan_objmgr_psoc *psoc,
+				      enum policy_mgr_con_mode mode,
+				      uint32_t *pcl_channels, uint32_t *len,
+				      uint8_t *pcl_weight, uint32_t weight_len,
+				      uint8_t vdev_id)
+{
+	struct policy_mgr_conc_snapshot snap;
+	uint32_t i, num = 0;
+
+	pm_test_cur->num_compute++;
+	policy_mgr_get_conc_snapshot(pm_test_cur->pm_ctx, &snap);
+	for (i = 0; i < snap.num_connections && num < weight_len; i++) {
+		pcl_channels[num] = snap.conn[i].freq;
+		pcl_weight[num++] = WEIGHT_OF_GROUP1_PCL_CHANNELS - i;
+	}
+	if (num < weight_len) {
+		pcl_channels[num] = PM_TEST_PCL_BASE_FREQ + 5 * mode;
+		pcl_weight[num++] = WEIGHT_OF_NON_PCL_CHANNELS;
+	}
+	*len = num;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static void pm_test_publish(struct pm_test_ctx *ctx)
+{
+	qdf_mutex_acquire(&ctx->pm_ctx->qdf_conc_list_lock);
+	policy_mgr_conc_snapshot_set(ctx->pm_ctx, ctx->conn_list);
+	qdf_mutex_release(&ctx->pm_ctx->qdf_conc_list_lock);
+}
+
+static void pm_test_apply(struct pm_test_ctx *ctx,
+			  const struct pm_test_step *step)
+{
+	struct policy_mgr_conc_connection_info *conn;
+	uint32_t i, j;
+
+	for (i = 0; i < MAX_NUMBER_OF_CONC_CONNECTIONS; i++) {
+		conn = &ctx->conn_list[i];
+		if (step->op == PM_TEST_ADD && !conn->in_use)
+			break;
+		if (step->op == PM_TEST_DEL && conn->in_use &&
+		    conn->vdev_id == step->vdev_id)
+			break;
+	}
+	if (i == MAX_NUMBER_OF_CONC_CONNECTIONS)
+		return;
+
+	if (step->op == PM_TEST_ADD) {
+		qdf_mem_zero(conn, sizeof(*conn));
+		conn->mode = step->mode;
+		conn->freq = step->freq;
+		conn->bw = step->bw;
+		conn->chain_mask = POLICY_MGR_TWO_TWO;
+		conn->original_nss = 2;
+		conn->vdev_id = step->vdev_id;
+		conn->in_use = true;
+	} else {
+		/* keep the table packed like policy_mgr_decr_connection_count */
+		for (j = i; j + 1 < MAX_NUMBER_OF_CONC_CONNECTIONS; j++)
+			ctx->conn_list[j] = ctx->conn_list[j + 1];
+		qdf_mem_zero(&ctx->conn_list[j], sizeof(ctx->conn_list[j]));
+	}
+
+	pm_test_publish(ctx);
+}
+
+/**
+ * pm_test_pcl_cmp() - compare a PCL with the one computed without the cache
+ * @ctx: test context
+ * @mode: mode of the new connection
+ * @name: run the PCL comes from
+ * @len: PCL length of the run
+ * @pcl: PCL of the run
+ * @weight: weights of the run
+ * @ref_len: PCL length of the uncached computation
+ *
+ * Return: number of errors
+ */
+static uint32_t pm_test_pcl_cmp(struct pm_test_ctx *ctx,
+				enum policy_mgr_con_mode mode,
+				const char *name, uint32_t len,
+				uint32_t *pcl, uint8_t *weight,
+				uint32_t ref_len)
+{
+	uint32_t i;
+
+	if (len != ref_len) {
+		pm_test_log("  %s: %s PCL len %u expected %u",
+			    device_mode_to_string(mode), name, len, ref_len);
+		return 1;
+	}
+
+	for (i = 0; i < len && i < NUM_CHANNELS; i++) {
+		if (pcl[i] != ctx->ref_pcl[i] ||
+		    weight[i] != ctx->ref_weight[i]) {
+			pm_test_log("  %s: %s PCL mismatch at %u",
+				    device_mode_to_string(mode), name, i);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static QDF_STATUS pm_test_lookup(struct pm_test_ctx *ctx,
+				 enum policy_mgr_con_mode mode,
+				 uint32_t *pcl, uint8_t *weight,
+				 uint32_t *len)
+{
+	return policy_mgr_pcl_cache_lookup(ctx->pm_ctx, mode, ctx->cfg_key,
+					   pm_test_compute_pcl, pcl, len,
+					   weight, NUM_CHANNELS,
+					   WLAN_INVALID_VDEV_ID);
+}
+
+/**
+ * pm_test_pcl() - check the cached PCL of a mode against an uncached one
+ * @ctx: test context
+ * @mode: mode of the new connection
+ * @expect_miss: the first lookup must compute the PCL
+ *
+ * The second lookup is expected to be served from the cache. Both are
+ * compared with the PCL computed by the stub directly.
+ *
+ * Return: number of errors
+ */
+static uint32_t pm_test_pcl(struct pm_test_ctx *ctx,
+			    enum policy_mgr_con_mode mode, bool expect_miss)
+{
+	uint32_t len = 0, cached_len = 0, ref_len = 0, computed;
+	uint32_t errors = 0;
+	uint64_t start_us;
+
+	qdf_mem_zero(ctx->pcl, sizeof(ctx->pcl));
+	qdf_mem_zero(ctx->weight, sizeof(ctx->weight));
+	qdf_mem_zero(ctx->cached_pcl, sizeof(ctx->cached_pcl));
+	qdf_mem_zero(ctx->cached_weight, sizeof(ctx->cached_weight));
+
+	computed = ctx->num_compute;
+	if (QDF_IS_STATUS_ERROR(pm_test_lookup(ctx, mode, ctx->pcl,
+					       ctx->weight, &len)))
+		return 1;
+	if (expect_miss && ctx->num_compute == computed) {
+		pm_test_log("  %s: stale PCL served from the cache",
+			    device_mode_to_string(mode));
+		errors++;
+	}
+
+	computed = ctx->num_compute;
+	start_us = qdf_get_log_timestamp_usecs();
+	if (QDF_IS_STATUS_ERROR(pm_test_lookup(ctx, mode, ctx->cached_pcl,
+					       ctx->cached_weight,
+					       &cached_len)))
+		return errors + 1;
+	ctx->warm_us += qdf_get_log_timestamp_usecs() - start_us;
+	ctx->num_lookup++;
+	if (ctx->num_compute != computed) {
+		pm_test_log("  %s: PCL not served from the cache",
+			    device_mode_to_string(mode));
+		errors++;
+	}
+
+	computed = ctx->num_compute;
+	pm_test_compute_pcl(NULL, mode, ctx->ref_pcl, &ref_len,
+			    ctx->ref_weight, NUM_CHANNELS,
+			    WLAN_INVALID_VDEV_ID);
+	ctx->num_compute = computed;
+
+	errors += pm_test_pcl_cmp(ctx, mode, "cold", len, ctx->pcl,
+				  ctx->weight, ref_len);
+	errors += pm_test_pcl_cmp(ctx, mode, "cached", cached_len,
+				  ctx->cached_pcl, ctx->cached_weight,
+				  ref_len);
+
+	return errors;
+}
+
+static uint32_t pm_test_all_modes(struct pm_test_ctx *ctx, bool expect_miss)
+{
+	uint32_t errors = 0;
+	uint8_t i;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(pm_test_query_modes); i++)
+		errors += pm_test_pcl(ctx, pm_test_query_modes[i],
+				      expect_miss);
+
+	return errors;
+}
+
+static uint32_t pm_test_scenario(struct pm_test_ctx *ctx,
+				 const struct pm_test_scenario *scenario)
+{
+	const struct pm_test_step *step;
+	struct policy_mgr_conc_snapshot snap;
+	uint32_t errors = 0, expected = 0;
+	uint8_t i;
+
+	pm_test_log("scenario %s", scenario->name);
+	for (i = 0; i < scenario->num_steps; i++) {
+		step = &scenario->step[i];
+		pm_test_apply(ctx, step);
+		if (step->op == PM_TEST_ADD)
+			expected++;
+		else
+			expected--;
+
+		policy_mgr_get_conc_snapshot(ctx->pm_ctx, &snap);
+		pm_test_log(" step %u: %s %s freq %u -> conn %u mcc %d",
+			    i, step->op == PM_TEST_ADD ? "add" : "del",
+			    device_mode_to_string(step->mode), step->freq,
+			    snap.num_connections, snap.is_mcc);
+		if (snap.num_connections != expected) {
+			pm_test_log(" step %u: expected %u connections",
+				    i, expected);
+			errors++;
+		}
+
+		/* every table change must reach the PCL */
+		errors += pm_test_all_modes(ctx, true);
+	}
+
+	return errors;
+}
+
+/**
+ * pm_test_invalidate() - check the non table inputs of the PCL cache
+ * @ctx: test context
+ *
+ * Return: number of errors
+ */
+static uint32_t pm_test_invalidate(struct pm_test_ctx *ctx)
+{
+	uint32_t errors = 0;
+
+	errors += pm_test_all_modes(ctx, false);
+
+	policy_mgr_pcl_cache_invalidate(ctx->pm_ctx);
+	errors += pm_test_all_modes(ctx, true);
+
+	ctx->pm_ctx->cur_conc_system_pref++;
+	errors += pm_test_all_modes(ctx, true);
+
+	ctx->cfg_key ^= BIT(0);
+	errors += pm_test_all_modes(ctx, true);
+
+	return errors;
+}
+
+static uint32_t pm_test_run(struct pm_test_ctx *ctx)
+{
+	uint32_t errors = 0;
+	uint8_t i;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(pm_test_scenarios); i++) {
+		errors += pm_test_scenario(ctx, &pm_test_scenarios[i]);
+		errors += pm_test_invalidate(ctx);
+
+		/* start the next scenario from an empty table */
+		qdf_mem_zero(ctx->conn_list, sizeof(ctx->conn_list));
+		pm_test_publish(ctx);
+	}
+
+	if (ctx->num_lookup)
+		pm_test_log("%u cached PCLs, avg %llu us, hit %u miss %u",
+			    ctx->num_lookup,
+			    qdf_do_div(ctx->warm_us, ctx->num_lookup),
+			    ctx->pm_ctx->pcl_cache.hit,
+			    ctx->pm_ctx->pcl_cache.miss);
+
+	return errors;
+}
+
+uint32_t policy_mgr_unit_test(void)
+{
+	struct pm_test_ctx *ctx;
+	struct wlan_objmgr_psoc *psoc;
+	uint32_t errors = 0;
+
+	ctx = qdf_mem_malloc(sizeof(*ctx));
+	if (!ctx)
+		return 1;
+
+	ctx->pm_ctx = qdf_mem_malloc(sizeof(*ctx->pm_ctx));
+	if (!ctx->pm_ctx) {
+		qdf_mem_free(ctx);
+		return 1;
+	}
+
+	/*
+	 * The psoc is only used read only, to place frequencies on a MAC
+	 * when the snapshot works out MCC.
+	 */
+	psoc = wlan_objmgr_get_psoc_by_id(0, WLAN_POLICY_MGR_ID);
+	if (!psoc) {
+		pm_test_log("psoc not found");
+		errors++;
+		goto free;
+	}
+
+	ctx->pm_ctx->psoc = psoc;
+	qdf_mutex_create(&ctx->pm_ctx->qdf_conc_list_lock);
+	qdf_atomic_init(&ctx->pm_ctx->conc_snapshot_seq);
+	qdf_atomic_init(&ctx->pm_ctx->pcl_cache.gen);
+	pm_test_cur = ctx;
+
+	errors += pm_test_run(ctx);
+
+	pm_test_cur = NULL;
+	qdf_mutex_destroy(&ctx->pm_ctx->qdf_conc_list_lock);
+	wlan_objmgr_psoc_release_ref(psoc, WLAN_POLICY_MGR_ID);
+free:
+	qdf_mem_free(ctx->pm_ctx);
+	qdf_mem_free(ctx);
+
+	return errors;
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __WLAN_POLICY_MGR_TEST
+#define __WLAN_POLICY_MGR_TEST
+
+#ifdef WLAN_POLICY_MGR_TEST
+/**
+ * policy_mgr_unit_test() - replay scripted concurrency scenarios
+ *
+ * Each scenario is replayed on a private policy manager context and
+ * connection table, with a stub PCL computation. After every step the
+ * connection snapshot and the PCL cache are checked: a table change, a
+ * cache invalidation, a system preference or configuration change must
+ * recompute the PCL, a repeated lookup must be served from the cache.
+ * Live policy manager state is never written.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t policy_mgr_unit_test(void);
+#else
+static inline uint32_t policy_mgr_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_POLICY_MGR_TEST */
+
+#endif /* __WLAN_POLICY_MGR_TEST */
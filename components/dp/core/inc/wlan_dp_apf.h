@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: contains host side Android Packet Filter (APF) declarations
+ *
+ * The host APF engine runs the same APF program which is installed in
+ * firmware against RX frames while the host is awake, so that frames the
+ * filter would drop in WoW are also dropped before they reach the RX
+ * thread, GRO and the network stack.
+ */
+
+#ifndef _WLAN_DP_APF_H_
+#define _WLAN_DP_APF_H_
+
+#include <qdf_types.h>
+#include <qdf_nbuf.h>
+#include <qdf_lock.h>
+#include <qdf_atomic.h>
+#include "wlan_dp_public_struct.h"
+
+struct wlan_dp_intf;
+
+/**
+ * enum dp_host_apf_mode - host APF operating mode
+ * @DP_HOST_APF_DISABLED: host APF is not run
+ * @DP_HOST_APF_GROUP_ADDR: run host APF only on group addressed frames
+ * @DP_HOST_APF_ALL: run host APF on every RX frame
+ */
+enum dp_host_apf_mode {
+	DP_HOST_APF_DISABLED,
+	DP_HOST_APF_GROUP_ADDR,
+	DP_HOST_APF_ALL,
+};
+
+/**
+ * enum dp_apf_verdict - result of running an APF program on a frame
+ * @DP_APF_PASS: program passed the frame
+ * @DP_APF_DROP: program dropped the frame
+ * @DP_APF_ABORT: program hit an out of bounds access, an illegal
+ *		  instruction or exhausted its instruction budget; the
+ *		  frame is passed, same as the firmware interpreter does
+ */
+enum dp_apf_verdict {
+	DP_APF_PASS,
+	DP_APF_DROP,
+	DP_APF_ABORT,
+};
+
+#ifdef WLAN_DP_HOST_APF
+
+/* Maximum size of program plus data memory accepted by the host engine */
+#define DP_HOST_APF_MAX_MEM_LEN 4096
+
+/**
+ * struct dp_apf_insn - pre-decoded APF instruction
+ * @opcode: APF opcode
+ * @reg: register number encoded in the instruction
+ * @imm: unsigned immediate
+ * @signed_imm: sign extended immediate
+ * @cmp_imm: second immediate of conditional jumps, byte count for JNEBS
+ * @bytes_off: JNEBS only, program offset of the bytes to compare
+ * @target: decoded index of the jump target, or one of the
+ *	    DP_APF_INSN_* sentinels
+ */
+struct dp_apf_insn {
+	uint8_t opcode;
+	uint8_t reg;
+	uint32_t imm;
+	int32_t signed_imm;
+	uint32_t cmp_imm;
+	uint32_t bytes_off;
+	uint32_t target;
+};
+
+/**
+ * struct dp_apf_prog_stats - per CPU counters of a host APF program
+ * @run: number of frames the program was run on
+ * @drop: number of frames dropped by the program
+ * @abort: number of runs which aborted and passed the frame
+ */
+struct dp_apf_prog_stats {
+	uint64_t run;
+	uint64_t drop;
+	uint64_t abort;
+};
+
+/**
+ * struct dp_apf_prog - verified APF program installed in the host engine
+ * @ref: reference count, RX path holds a reference while running
+ * @filter_id: filter id given by userspace
+ * @mem: program followed by data memory
+ * @prog_len: length of the program in bytes
+ * @mem_len: length of program plus data memory in bytes
+ * @has_store: program writes to data memory
+ * @data_lock: serializes runs of a program with @has_store, so that all
+ *	       CPUs update the one data memory the firmware also sees
+ * @data_base: data memory as installed, kept for programs with
+ *	       @has_store to merge host counter deltas into firmware reads
+ * @insn: pre-decoded instructions, NULL if program is interpreted
+ * @num_insn: number of entries in @insn
+ * @install_ticks: system ticks when program was installed
+ * @stats: per CPU counters
+ */
+struct dp_apf_prog {
+	qdf_atomic_t ref;
+	uint32_t filter_id;
+	uint8_t *mem;
+	uint32_t prog_len;
+	uint32_t mem_len;
+	bool has_store;
+	qdf_spinlock_t data_lock;
+	uint8_t *data_base;
+	struct dp_apf_insn *insn;
+	uint32_t num_insn;
+	unsigned long install_ticks;
+	struct dp_apf_prog_stats stats[NUM_CPUS];
+};
+
+/**
+ * struct dp_host_apf_ctx - per interface host APF context
+ * @lock: protects @prog and @active
+ * @prog: program currently run on RX frames
+ * @active: APF interpreter enabled by userspace
+ * @staging_lock: protects the staging area
+ * @staging: APF work memory mirror written by userspace, allocated once
+ *	     at init when host APF is enabled
+ * @staging_len: number of valid bytes in @staging
+ * @staging_prog_len: length of the program part of @staging
+ * @verify_fail: number of programs rejected by the verifier
+ */
+struct dp_host_apf_ctx {
+	qdf_spinlock_t lock;
+	struct dp_apf_prog *prog;
+	bool active;
+	qdf_mutex_t staging_lock;
+	uint8_t *staging;
+	uint32_t staging_len;
+	uint32_t staging_prog_len;
+	uint32_t verify_fail;
+};
+
+/**
+ * dp_apf_verify() - statically verify an APF program
+ * @prog: program bytes
+ * @prog_len: length of the program
+ * @mem_len: length of program plus data memory
+ * @has_store: set if the program writes to data memory
+ *
+ * Every instruction must decode fully inside the program, use a known
+ * opcode and jump only to an instruction boundary or to the PASS/DROP
+ * labels right after the program.
+ *
+ * Return: QDF_STATUS_SUCCESS if the program is safe to run
+ */
+QDF_STATUS dp_apf_verify(const uint8_t *prog, uint32_t prog_len,
+			 uint32_t mem_len, bool *has_store);
+
+/**
+ * dp_apf_predecode() - pre-decode a verified APF program
+ * @prog: verified program
+ *
+ * On failure @prog keeps running through the byte code interpreter.
+ *
+ * Return: QDF_STATUS_SUCCESS if @prog->insn has been populated
+ */
+QDF_STATUS dp_apf_predecode(struct dp_apf_prog *prog);
+
+/**
+ * dp_apf_run() - run an APF program on a frame
+ * @prog: program to run
+ * @pkt: frame starting at the ethernet header
+ * @pkt_len: length of @pkt
+ *
+ * Return: enum dp_apf_verdict
+ */
+enum dp_apf_verdict dp_apf_run(struct dp_apf_prog *prog,
+			       const uint8_t *pkt, uint32_t pkt_len);
+
+/**
+ * dp_apf_prog_alloc() - allocate and verify a host APF program
+ * @mem: program followed by data memory
+ * @prog_len: length of the program
+ * @mem_len: length of @mem
+ * @filter_id: filter id given by userspace
+ * @predecode: pre-decode the program
+ *
+ * Return: program with one reference held, NULL on failure
+ */
+struct dp_apf_prog *dp_apf_prog_alloc(const uint8_t *mem, uint32_t prog_len,
+				      uint32_t mem_len, uint32_t filter_id,
+				      bool predecode);
+
+/**
+ * dp_apf_prog_put() - release a reference of a host APF program
+ * @prog: program
+ *
+ * Return: None
+ */
+void dp_apf_prog_put(struct dp_apf_prog *prog);
+
+/**
+ * dp_host_apf_init() - initialize host APF for a DP interface
+ * @dp_intf: DP interface
+ *
+ * Return: None
+ */
+void dp_host_apf_init(struct wlan_dp_intf *dp_intf);
+
+/**
+ * dp_host_apf_deinit() - deinitialize host APF for a DP interface
+ * @dp_intf: DP interface
+ *
+ * Return: None
+ */
+void dp_host_apf_deinit(struct wlan_dp_intf *dp_intf);
+
+/**
+ * dp_host_apf_write() - write into the host copy of the APF work memory
+ * @dp_intf: DP interface
+ * @offset: offset into the work memory
+ * @buf: bytes to write
+ * @len: length of @buf
+ * @prog_len: length of the program part of the work memory
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS dp_host_apf_write(struct wlan_dp_intf *dp_intf, uint32_t offset,
+			     const uint8_t *buf, uint32_t len,
+			     uint32_t prog_len);
+
+/**
+ * dp_host_apf_commit() - verify and install the staged APF program
+ * @dp_intf: DP interface
+ * @filter_id: filter id given by userspace
+ *
+ * A program rejected by the verifier leaves the installed one in place.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS dp_host_apf_commit(struct wlan_dp_intf *dp_intf,
+			      uint32_t filter_id);
+
+/**
+ * dp_host_apf_reset() - remove the host APF program
+ * @dp_intf: DP interface
+ *
+ * Return: None
+ */
+void dp_host_apf_reset(struct wlan_dp_intf *dp_intf);
+
+/**
+ * dp_host_apf_set_active() - enable/disable the host APF interpreter
+ * @dp_intf: DP interface
+ * @active: enable or disable
+ *
+ * Return: None
+ */
+void dp_host_apf_set_active(struct wlan_dp_intf *dp_intf, bool active);
+
+/**
+ * dp_host_apf_read_merge() - merge host counters into a firmware read
+ * @dp_intf: DP interface
+ * @offset: offset of @buf in the work memory
+ * @buf: work memory read back from firmware
+ * @len: length of @buf
+ *
+ * Frames dropped by the host never reach firmware, so the counters the
+ * program keeps in data memory are split between both copies. Add what
+ * the host counted since install to every 32 bit counter word, aligned
+ * from the end of memory, covered by @buf.
+ *
+ * Return: None
+ */
+void dp_host_apf_read_merge(struct wlan_dp_intf *dp_intf, uint32_t offset,
+			    uint8_t *buf, uint32_t len);
+
+/**
+ * dp_host_apf_filter_list() - run host APF on a list of RX frames
+ * @dp_intf: DP interface
+ * @nbuf_list: RX frame list
+ *
+ * Frames dropped by the program are freed and unlinked from the list.
+ *
+ * Return: remaining frame list, may be NULL
+ */
+qdf_nbuf_t dp_host_apf_filter_list(struct wlan_dp_intf *dp_intf,
+				   qdf_nbuf_t nbuf_list);
+
+/**
+ * dp_host_apf_display_stats() - log host APF counters of an interface
+ * @dp_intf: DP interface
+ *
+ * Return: None
+ */
+void dp_host_apf_display_stats(struct wlan_dp_intf *dp_intf);
+#else
+static inline void dp_host_apf_init(struct wlan_dp_intf *dp_intf)
+{
+}
+
+static inline void dp_host_apf_deinit(struct wlan_dp_intf *dp_intf)
+{
+}
+
+static inline QDF_STATUS
+dp_host_apf_write(struct wlan_dp_intf *dp_intf, uint32_t offset,
+		  const uint8_t *buf, uint32_t len, uint32_t prog_len)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline QDF_STATUS
+dp_host_apf_commit(struct wlan_dp_intf *dp_intf, uint32_t filter_id)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline void dp_host_apf_reset(struct wlan_dp_intf *dp_intf)
+{
+}
+
+static inline void
+dp_host_apf_set_active(struct wlan_dp_intf *dp_intf, bool active)
+{
+}
+
+static inline void
+dp_host_apf_read_merge(struct wlan_dp_intf *dp_intf, uint32_t offset,
+		       uint8_t *buf, uint32_t len)
+{
+}
+
+static inline qdf_nbuf_t
+dp_host_apf_filter_list(struct wlan_dp_intf *dp_intf, qdf_nbuf_t nbuf_list)
+{
+	return nbuf_list;
+}
+
+static inline void dp_host_apf_display_stats(struct wlan_dp_intf *dp_intf)
+{
+}
+#endif /* WLAN_DP_HOST_APF */
+#endif /* _WLAN_DP_APF_H_ */
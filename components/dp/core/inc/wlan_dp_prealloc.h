@@ -147,6 +147,37 @@ void *dp_prealloc_get_consistent_mem_unaligned(qdf_size_t size,
  */
 void dp_prealloc_put_consistent_mem_unaligned(void *va_unaligned);
 
+/**
+ * dp_prealloc_profile_show() - Dump pre-alloc usage profile
+ * @buf: buffer to write the profile to
+ * @size: size of @buf
+ *
+ * The profile has one line per pre-alloc table with the high water mark,
+ * hit and miss counts of each element as "hwm/hits/misses". It can be
+ * loaded back with dp_prealloc_profile_load() on a later module load.
+ *
+ * Return: number of bytes written
+ */
+int dp_prealloc_profile_show(char *buf, qdf_size_t size);
+
+#ifdef DP_PREALLOC_AUTO_SIZE
+/**
+ * dp_prealloc_profile_load() - Load pre-alloc usage profile
+ * @str: profile in the format produced by dp_prealloc_profile_show()
+ *
+ * Pre-alloc elements are sized from the loaded profile on the next
+ * dp_prealloc_init(). Must not be called while pools are allocated.
+ *
+ * Return: QDF_STATUS_SUCCESS on success, error qdf status on failure
+ */
+QDF_STATUS dp_prealloc_profile_load(const char *str);
+#else
+static inline QDF_STATUS dp_prealloc_profile_load(const char *str)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+#endif
+
 #else
 static inline
 QDF_STATUS dp_prealloc_init(struct cdp_ctrl_objmgr_psoc *ctrl_psoc)
@@ -156,6 +187,15 @@ QDF_STATUS dp_prealloc_init(struct cdp_ctrl_objmgr_psoc *ctrl_psoc)
 
 static inline void dp_prealloc_deinit(void) { }
 
+static inline int dp_prealloc_profile_show(char *buf, qdf_size_t size)
+{
+	return 0;
+}
+
+static inline QDF_STATUS dp_prealloc_profile_load(const char *str)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
 #endif
 
 uint32_t dp_get_tx_inqueue(ol_txrx_soc_handle soc);
@@ -35,6 +35,8 @@
 #include <cds_api.h>
 #include "pld_common.h"
 #include "wlan_dp_nud_tracking.h"
+#include "wlan_dp_apf.h"
+#include "wlan_dp_stats_sampler.h"
 #include <i_qdf_net_stats.h>
 #include <qdf_types.h>
 #include "htc_api.h"
@@ -138,6 +140,9 @@ struct dp_rtpm_tput_policy_context {
  * @gro_enable: Enable/Disable gro
  * @is_rx_fisa_enabled: flag to enable/disable FISA Rx
  * @is_rx_fisa_lru_del_enabled: flag to enable/disable FST entry delete
+ * @host_apf_mode: host APF mode, enum dp_host_apf_mode
+ * @host_apf_predecode: pre-decode host APF programs
+ * @stats_sample_interval: DP stats sampler interval in ms, 0 to disable
  */
 struct wlan_dp_psoc_cfg {
 	bool tx_orphan_enable;
@@ -209,6 +214,13 @@ struct wlan_dp_psoc_cfg {
 	bool is_rx_fisa_enabled;
 	bool is_rx_fisa_lru_del_enabled;
 #endif
+#ifdef WLAN_DP_HOST_APF
+	uint8_t host_apf_mode;
+	bool host_apf_predecode;
+#endif
+#ifdef WLAN_DP_STATS_SAMPLER
+	uint32_t stats_sample_interval;
+#endif
 };
 
 /**
@@ -624,6 +636,8 @@ struct dp_rx_fst {
  * @def_link: Pointer to default link (usually used for TX operation)
  * @dp_link_list_lock: Lock to protect dp_link_list operatiosn
  * @dp_link_list: List of dp_links for this DP interface
+ * @host_apf: host APF context
+ * @stats_hist: TX/RX sample history of the DP stats sampler
  */
 struct wlan_dp_intf {
 	struct wlan_dp_psoc_context *dp_ctx;
@@ -692,6 +706,12 @@ struct wlan_dp_intf {
 	struct wlan_dp_link *def_link;
 	qdf_spinlock_t dp_link_list_lock;
 	qdf_list_t dp_link_list;
+#ifdef WLAN_DP_HOST_APF
+	struct dp_host_apf_ctx host_apf;
+#endif
+#ifdef WLAN_DP_STATS_SAMPLER
+	struct dp_stats_sampler_hist stats_hist;
+#endif
 };
 
 /**
@@ -788,6 +808,8 @@ struct dp_direct_link_context {
  * @bus_bw_lock: Bus bandwidth work lock
  * @cur_rx_level: Current Rx level
  * @bus_low_vote_cnt: bus low level count
+ * @pm_qos_cpu_hint: CPUs the datapath affinity manager placed the datapath
+ *		     on, voted for PM QoS instead of the whole perf cluster
  * @disable_rx_ol_in_concurrency: disable RX offload in concurrency scenarios
  * @disable_rx_ol_in_low_tput: disable RX offload in tput scenarios
  * @txrx_hist_idx: txrx histogram index
@@ -818,6 +840,7 @@ struct dp_direct_link_context {
  * @fst_cmem_size: CMEM size for FISA flow table
  * @inactive_dp_link_list: inactive DP links list
  * @dp_link_del_lock: DP link delete operation lock
+ * @stats_sampler_work: work sampling the interface TX/RX counters
  */
 struct wlan_dp_psoc_context {
 	struct wlan_objmgr_psoc *psoc;
@@ -862,6 +885,7 @@ struct wlan_dp_psoc_context {
 	uint64_t prev_tx;
 	qdf_atomic_t low_tput_gro_enable;
 	uint32_t bus_low_vote_cnt;
+	qdf_cpu_mask pm_qos_cpu_hint;
 #ifdef FEATURE_RUNTIME_PM
 	struct dp_rtpm_tput_policy_context rtpm_tput_policy_ctx;
 #endif
@@ -920,6 +944,9 @@ struct wlan_dp_psoc_context {
 #endif
 	TAILQ_HEAD(, wlan_dp_link) inactive_dp_link_list;
 	qdf_spinlock_t dp_link_del_lock;
+#ifdef WLAN_DP_STATS_SAMPLER
+	struct qdf_periodic_work stats_sampler_work;
+#endif
 };
 
 #ifdef WLAN_DP_PROFILE_SUPPORT
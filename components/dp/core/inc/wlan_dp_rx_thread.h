@@ -688,6 +688,36 @@ ret:
 	return qdf_status;
 }
 
+/**
+ * dp_txrx_set_refill_cpu_mask() - set CPU mask for the RX refill thread
+ * @soc: ol_txrx_soc_handle object
+ * @new_mask: New CPU mask pointer
+ *
+ * Return: QDF_STATUS_SUCCESS on success, error qdf status on failure
+ */
+static inline
+QDF_STATUS dp_txrx_set_refill_cpu_mask(ol_txrx_soc_handle soc,
+				       qdf_cpu_mask *new_mask)
+{
+	struct dp_txrx_handle *dp_ext_hdl;
+
+	if (!soc)
+		return QDF_STATUS_E_INVAL;
+
+	dp_ext_hdl = cdp_soc_get_dp_txrx_handle(soc);
+	if (!dp_ext_hdl)
+		return QDF_STATUS_E_FAULT;
+
+	if (!dp_ext_hdl->refill_thread.enabled ||
+	    !dp_ext_hdl->refill_thread.task)
+		return QDF_STATUS_E_NOSUPPORT;
+
+	qdf_thread_set_cpus_allowed_mask(dp_ext_hdl->refill_thread.task,
+					 new_mask);
+
+	return QDF_STATUS_SUCCESS;
+}
+
 #else
 
 static inline
@@ -750,6 +780,13 @@ QDF_STATUS dp_txrx_set_cpu_mask(ol_txrx_soc_handle soc, qdf_cpu_mask *new_mask)
 	return QDF_STATUS_SUCCESS;
 }
 
+static inline
+QDF_STATUS dp_txrx_set_refill_cpu_mask(ol_txrx_soc_handle soc,
+				       qdf_cpu_mask *new_mask)
+{
+	return QDF_STATUS_SUCCESS;
+}
+
 #endif /* FEATURE_WLAN_DP_RX_THREADS */
 
 /**
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: contains DP data stall root cause correlator declarations
+ *
+ * On a gateway NUD failure or a data stall report, the correlator splits
+ * the stats sampler history of an interface into a baseline and the last
+ * DP_STALL_CORR_TAIL_MS before the trigger, derives evidence from the TX/RX
+ * counters, flow control, bus bandwidth votes and pending WMI commands, and
+ * ranks the candidate root causes by the evidence supporting each of them.
+ * The evaluation only looks at the history record, so histories captured
+ * through the stats snapshot can be replayed through it.
+ */
+
+#ifndef _WLAN_DP_STALL_CORR_H_
+#define _WLAN_DP_STALL_CORR_H_
+
+#include <qdf_types.h>
+#include "wlan_dp_public_struct.h"
+
+struct wlan_dp_intf;
+struct wlan_dp_psoc_context;
+
+/* Part of the history, up to the trigger, where the stall is looked for */
+#define DP_STALL_CORR_TAIL_MS		2000
+
+/* Traffic below 1/DP_STALL_CORR_COLLAPSE_RATIO of the baseline collapsed */
+#define DP_STALL_CORR_COLLAPSE_RATIO	8
+
+/* Baseline packets needed before a collapse is considered */
+#define DP_STALL_CORR_MIN_PKTS		16
+
+/**
+ * enum dp_stall_cause - candidate root causes of a data stall
+ * @DP_STALL_CAUSE_RX_STARVATION: RX ring not refilled, nothing received
+ * @DP_STALL_CAUSE_TX_DESC_EXHAUSTION: TX descriptors held, not completed
+ * @DP_STALL_CAUSE_FLOW_PAUSED: netdev queues paused by flow control
+ * @DP_STALL_CAUSE_BUS_BW_DOWNVOTE: bus bandwidth voted down under traffic
+ * @DP_STALL_CAUSE_FW: firmware not serving commands or completions
+ * @DP_STALL_CAUSE_MAX: number of causes
+ */
+enum dp_stall_cause {
+	DP_STALL_CAUSE_RX_STARVATION,
+	DP_STALL_CAUSE_TX_DESC_EXHAUSTION,
+	DP_STALL_CAUSE_FLOW_PAUSED,
+	DP_STALL_CAUSE_BUS_BW_DOWNVOTE,
+	DP_STALL_CAUSE_FW,
+	DP_STALL_CAUSE_MAX,
+};
+
+/**
+ * enum dp_stall_evidence - observations the causes are scored on
+ * @DP_STALL_EV_RX_COLLAPSED: RX in the tail collapsed against the baseline
+ * @DP_STALL_EV_TX_ACKED: the peer still acked frames in the tail
+ * @DP_STALL_EV_RX_REFILL: the trigger reported RX ring refill failures
+ * @DP_STALL_EV_TX_PENDING_STUCK: TX descriptors outstanding in every tail
+ *				  sample, and not fewer at its end
+ * @DP_STALL_EV_TX_NO_COMPLETION: frames sent in the tail, none acked
+ * @DP_STALL_EV_TX_DROPPED: start_xmit dropped frames in the tail
+ * @DP_STALL_EV_PAUSED_MOST: queues paused in 3/4 of the tail samples
+ * @DP_STALL_EV_PAUSED_ALL: queues paused in every tail sample
+ * @DP_STALL_EV_TX_CALLED_COLLAPSED: the stack stopped handing frames
+ * @DP_STALL_EV_BW_DOWNVOTE: bus bandwidth vote in the tail below the
+ *			     baseline peak
+ * @DP_STALL_EV_BW_BEFORE_COLLAPSE: the vote went down while traffic still
+ *				    flowed
+ * @DP_STALL_EV_TPUT_COLLAPSED: TX and RX in the tail collapsed against the
+ *				baseline
+ * @DP_STALL_EV_WMI_STUCK: WMI commands pending in every tail sample, and
+ *			   not fewer at its end
+ * @DP_STALL_EV_FW_TRIGGER: the trigger was reported by the firmware
+ * @DP_STALL_EV_MAX: number of evidence types
+ */
+enum dp_stall_evidence {
+	DP_STALL_EV_RX_COLLAPSED,
+	DP_STALL_EV_TX_ACKED,
+	DP_STALL_EV_RX_REFILL,
+	DP_STALL_EV_TX_PENDING_STUCK,
+	DP_STALL_EV_TX_NO_COMPLETION,
+	DP_STALL_EV_TX_DROPPED,
+	DP_STALL_EV_PAUSED_MOST,
+	DP_STALL_EV_PAUSED_ALL,
+	DP_STALL_EV_TX_CALLED_COLLAPSED,
+	DP_STALL_EV_BW_DOWNVOTE,
+	DP_STALL_EV_BW_BEFORE_COLLAPSE,
+	DP_STALL_EV_TPUT_COLLAPSED,
+	DP_STALL_EV_WMI_STUCK,
+	DP_STALL_EV_FW_TRIGGER,
+	DP_STALL_EV_MAX,
+};
+
+/**
+ * struct dp_stall_corr_window - counters summed over part of the history
+ * @num_samples: samples in the window
+ * @duration_ms: time covered by the samples
+ * @tx_called: frames given to start_xmit
+ * @tx_dropped: frames dropped in start_xmit
+ * @tx_acked: frames acked by the peer
+ * @rx_packets: frames received
+ * @num_paused: samples with paused netdev queues
+ * @bw_min: lowest bus bandwidth vote
+ * @bw_max: highest bus bandwidth vote
+ * @tx_pending_first: outstanding TX descriptors at the start of the window
+ * @tx_pending_min: fewest outstanding TX descriptors
+ * @tx_pending_last: outstanding TX descriptors at the end of the window
+ * @wmi_pending_first: pending WMI commands at the start of the window
+ * @wmi_pending_min: fewest pending WMI commands
+ * @wmi_pending_last: pending WMI commands at the end of the window
+ */
+struct dp_stall_corr_window {
+	uint32_t num_samples;
+	uint32_t duration_ms;
+	uint32_t tx_called;
+	uint32_t tx_dropped;
+	uint32_t tx_acked;
+	uint32_t rx_packets;
+	uint32_t num_paused;
+	uint32_t bw_min;
+	uint32_t bw_max;
+	uint32_t tx_pending_first;
+	uint32_t tx_pending_min;
+	uint32_t tx_pending_last;
+	uint32_t wmi_pending_first;
+	uint32_t wmi_pending_min;
+	uint32_t wmi_pending_last;
+};
+
+/**
+ * struct dp_stall_cause_score - score of a candidate root cause
+ * @cause: enum dp_stall_cause
+ * @score: sum of the weights of the evidence found for @cause, 0 to 100
+ * @evidence: bitmap of enum dp_stall_evidence supporting @cause
+ */
+struct dp_stall_cause_score {
+	uint8_t cause;
+	uint8_t score;
+	uint16_t evidence;
+};
+
+/**
+ * struct dp_stall_verdict - ranked root causes of a data stall
+ * @trigger: enum dp_stall_trigger the verdict was asked for
+ * @evidence: bitmap of all enum dp_stall_evidence found
+ * @base: baseline part of the history
+ * @tail: part of the history leading to the trigger
+ * @num_causes: causes with a non zero score
+ * @ranked: causes with a non zero score, best supported first
+ */
+struct dp_stall_verdict {
+	enum dp_stall_trigger trigger;
+	uint32_t evidence;
+	struct dp_stall_corr_window base;
+	struct dp_stall_corr_window tail;
+	uint8_t num_causes;
+	struct dp_stall_cause_score ranked[DP_STALL_CAUSE_MAX];
+};
+
+#ifdef WLAN_DP_STALL_CORRELATOR
+/**
+ * dp_stall_corr_evaluate() - rank the root causes of a stall in a history
+ * @rec: sample history of the stalled interface, oldest sample first
+ * @trigger: event the verdict is asked for
+ * @verdict: verdict to fill
+ *
+ * Return: None
+ */
+void dp_stall_corr_evaluate(const struct dp_stats_snapshot_intf *rec,
+			    enum dp_stall_trigger trigger,
+			    struct dp_stall_verdict *verdict);
+
+/**
+ * dp_stall_corr_report() - log the verdict on a stalled interface
+ * @dp_intf: DP interface
+ * @trigger: event the verdict is asked for
+ *
+ * Return: None
+ */
+void dp_stall_corr_report(struct wlan_dp_intf *dp_intf,
+			  enum dp_stall_trigger trigger);
+
+/**
+ * dp_stall_corr_trigger() - log the verdict on the stalled interfaces
+ * @dp_ctx: DP context
+ * @vdev_id_bitmap: vdevs reported as stalled, 0 for all the interfaces
+ *		    with links
+ * @trigger: event the verdict is asked for
+ *
+ * Return: None
+ */
+void dp_stall_corr_trigger(struct wlan_dp_psoc_context *dp_ctx,
+			   uint32_t vdev_id_bitmap,
+			   enum dp_stall_trigger trigger);
+#else
+static inline void dp_stall_corr_report(struct wlan_dp_intf *dp_intf,
+					enum dp_stall_trigger trigger)
+{
+}
+
+static inline void
+dp_stall_corr_trigger(struct wlan_dp_psoc_context *dp_ctx,
+		      uint32_t vdev_id_bitmap, enum dp_stall_trigger trigger)
+{
+}
+#endif /* WLAN_DP_STALL_CORRELATOR */
+#endif /* _WLAN_DP_STALL_CORR_H_ */
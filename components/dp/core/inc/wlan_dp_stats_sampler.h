@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: contains DP stats sampler declarations
+ *
+ * The stats sampler runs its own periodic work, independent of the bus
+ * bandwidth work, which sums the per CPU TX/RX counters of every interface
+ * and appends the deltas to a fixed size per interface history. The
+ * sampler is the only writer of a history; readers copy it without locks
+ * and drop the entries the sampler overwrote while they were copying.
+ */
+
+#ifndef _WLAN_DP_STATS_SAMPLER_H_
+#define _WLAN_DP_STATS_SAMPLER_H_
+
+#include <qdf_types.h>
+#include <qdf_atomic.h>
+#include "wlan_dp_public_struct.h"
+
+struct wlan_dp_intf;
+struct wlan_dp_psoc_context;
+
+#ifdef WLAN_DP_STATS_SAMPLER
+
+/**
+ * struct dp_stats_sampler_hist - sample history of an interface
+ * @head: number of samples recorded, the next one goes to
+ *	  @samples[@head % DP_STATS_SAMPLER_HIST_LEN]
+ * @last: counter totals at the previous sample, sampler private
+ * @last_ms: timestamp of the previous sample, 0 until the first one is
+ *	     taken, sampler private
+ * @samples: sample ring
+ */
+struct dp_stats_sampler_hist {
+	qdf_atomic_t head;
+	struct dp_stats_sample last;
+	uint64_t last_ms;
+	struct dp_stats_sample samples[DP_STATS_SAMPLER_HIST_LEN];
+};
+
+/**
+ * struct dp_stats_sampler_input - values sampled outside the DP counters
+ * @tx_acked: frames acked on the links of the interface so far
+ * @tx_pending: TX descriptors outstanding on the pdev
+ * @wmi_pending: WMI commands pending on the psoc
+ * @pause_map: netdev queue pause reasons of the interface
+ */
+struct dp_stats_sampler_input {
+	uint32_t tx_acked;
+	uint32_t tx_pending;
+	uint32_t wmi_pending;
+	uint32_t pause_map;
+};
+
+/**
+ * dp_stats_sampler_init() - create the stats sampler work
+ * @dp_ctx: DP context
+ *
+ * Return: None
+ */
+void dp_stats_sampler_init(struct wlan_dp_psoc_context *dp_ctx);
+
+/**
+ * dp_stats_sampler_deinit() - destroy the stats sampler work
+ * @dp_ctx: DP context
+ *
+ * Return: None
+ */
+void dp_stats_sampler_deinit(struct wlan_dp_psoc_context *dp_ctx);
+
+/**
+ * dp_stats_sampler_start() - start sampling at the configured interval
+ * @dp_ctx: DP context
+ *
+ * Return: None
+ */
+void dp_stats_sampler_start(struct wlan_dp_psoc_context *dp_ctx);
+
+/**
+ * dp_stats_sampler_stop() - stop sampling
+ * @dp_ctx: DP context
+ *
+ * Return: None
+ */
+void dp_stats_sampler_stop(struct wlan_dp_psoc_context *dp_ctx);
+
+/**
+ * dp_stats_sampler_intf_init() - reset the sample history of an interface
+ * @dp_intf: DP interface, not yet visible to the sampler
+ *
+ * Return: None
+ */
+void dp_stats_sampler_intf_init(struct wlan_dp_intf *dp_intf);
+
+/**
+ * dp_stats_sampler_intf_sample() - append a sample to an interface history
+ * @dp_intf: DP interface
+ * @now_ms: current system timestamp
+ * @input: values read by the caller outside the DP counters
+ *
+ * The first call only records the counter totals. Called from the sampler
+ * work, which serializes the writers of a history.
+ *
+ * Return: None
+ */
+void dp_stats_sampler_intf_sample(struct wlan_dp_intf *dp_intf,
+				  uint64_t now_ms,
+				  const struct dp_stats_sampler_input *input);
+
+/**
+ * dp_stats_sampler_intf_read() - copy the sample history of an interface
+ * @dp_intf: DP interface
+ * @rec: record to fill, oldest sample first
+ *
+ * Lockless, may run concurrently with the sampler.
+ *
+ * Return: number of samples copied
+ */
+uint32_t dp_stats_sampler_intf_read(struct wlan_dp_intf *dp_intf,
+				    struct dp_stats_snapshot_intf *rec);
+
+/**
+ * dp_stats_sampler_snapshot() - produce a binary snapshot of all histories
+ * @dp_ctx: DP context
+ * @cb: consumer of the snapshot, called for the header and then for each
+ *	interface record
+ * @cb_ctx: context for @cb
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS dp_stats_sampler_snapshot(struct wlan_dp_psoc_context *dp_ctx,
+				     dp_stats_snapshot_cb cb, void *cb_ctx);
+#else
+static inline void dp_stats_sampler_init(struct wlan_dp_psoc_context *dp_ctx)
+{
+}
+
+static inline void
+dp_stats_sampler_deinit(struct wlan_dp_psoc_context *dp_ctx)
+{
+}
+
+static inline void dp_stats_sampler_start(struct wlan_dp_psoc_context *dp_ctx)
+{
+}
+
+static inline void dp_stats_sampler_stop(struct wlan_dp_psoc_context *dp_ctx)
+{
+}
+
+static inline void dp_stats_sampler_intf_init(struct wlan_dp_intf *dp_intf)
+{
+}
+
+static inline QDF_STATUS
+dp_stats_sampler_snapshot(struct wlan_dp_psoc_context *dp_ctx,
+			  dp_stats_snapshot_cb cb, void *cb_ctx)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+#endif /* WLAN_DP_STATS_SAMPLER */
+#endif /* _WLAN_DP_STATS_SAMPLER_H_ */
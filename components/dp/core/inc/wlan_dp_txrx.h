@@ -47,6 +47,75 @@
 #define DP_CONNECTIVITY_CHECK_SET_TCP_SYN_ACK	7
 #define DP_CONNECTIVITY_CHECK_SET_TCP_ACK	8
 
+/* struct dp_pkt_class flags, TCP/UDP/DHCP/DNS are over IPv4 */
+#define DP_PKT_CLASS_ARP		BIT(0)
+#define DP_PKT_CLASS_EAPOL		BIT(1)
+#define DP_PKT_CLASS_IPV4		BIT(2)
+#define DP_PKT_CLASS_IPV6		BIT(3)
+#define DP_PKT_CLASS_IPV4_FRAG		BIT(4)
+#define DP_PKT_CLASS_ICMP		BIT(5)
+#define DP_PKT_CLASS_ICMPV6		BIT(6)
+#define DP_PKT_CLASS_TCP		BIT(7)
+#define DP_PKT_CLASS_UDP		BIT(8)
+#define DP_PKT_CLASS_DHCP		BIT(9)
+#define DP_PKT_CLASS_DNS_QUERY		BIT(10)
+#define DP_PKT_CLASS_DNS_RSP		BIT(11)
+
+/* struct dp_pkt_class l4_op values */
+#define DP_PKT_ICMP_ECHO_RSP		0
+#define DP_PKT_ICMP_ECHO_REQ		8
+#define DP_PKT_ICMPV6_ECHO_REQ		128
+#define DP_PKT_TCP_SYN			0x02
+#define DP_PKT_TCP_ACK			0x10
+#define DP_PKT_TCP_SYN_ACK		0x12
+
+/**
+ * struct dp_pkt_class - L2 to L4 classification of an ethernet frame
+ * @flags: DP_PKT_CLASS_* flags
+ * @l4_op: ICMP/ICMPv6 type or TCP flags
+ * @src_port: TCP/UDP source port, in network byte order
+ * @dst_port: TCP/UDP destination port, in network byte order
+ * @src_ip: IPv4 source address, in network byte order
+ * @dst_ip: IPv4 destination address, in network byte order
+ *
+ * Filled in one pass over the headers by dp_pkt_classify(), for the
+ * connectivity tracking, EAPOL logging and ICMP marking of the same frame to
+ * share instead of each reparsing it.
+ */
+struct dp_pkt_class {
+	uint16_t flags;
+	uint8_t l4_op;
+	uint16_t src_port;
+	uint16_t dst_port;
+	uint32_t src_ip;
+	uint32_t dst_ip;
+};
+
+/**
+ * dp_pkt_classify_data() - classify an ethernet frame
+ * @data: frame, starting with the ethernet header
+ * @len: frame length
+ * @cls: classification to fill
+ *
+ * L4 headers of non first IPv4 fragments are not parsed.
+ *
+ * Return: None
+ */
+void dp_pkt_classify_data(uint8_t *data, uint32_t len,
+			  struct dp_pkt_class *cls);
+
+/**
+ * dp_pkt_classify() - classify an ethernet frame nbuf
+ * @nbuf: frame
+ * @cls: classification to fill
+ *
+ * Return: None
+ */
+static inline void dp_pkt_classify(qdf_nbuf_t nbuf, struct dp_pkt_class *cls)
+{
+	dp_pkt_classify_data(qdf_nbuf_data(nbuf), qdf_nbuf_len(nbuf), cls);
+}
+
 /**
  * wlan_dp_intf_get_pkt_type_bitmap_value() - Get packt type bitmap info
  * @intf_ctx: DP interface context
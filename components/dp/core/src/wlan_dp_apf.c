@@ -0,0 +1,1144 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: contains host side Android Packet Filter (APF) engine
+ *
+ * The byte code semantics follow the APF v4 interpreter used by firmware:
+ * a jump to program_len passes the frame, a jump to program_len + 1 drops
+ * it and any out of bounds access passes the frame.
+ */
+
+#include "wlan_dp_main.h"
+#include "wlan_dp_apf.h"
+#include <qdf_defer.h>
+#include <qdf_mem.h>
+#include <qdf_time.h>
+
+#ifdef WLAN_DP_HOST_APF
+
+#define DP_APF_LDB	1
+#define DP_APF_LDH	2
+#define DP_APF_LDW	3
+#define DP_APF_LDBX	4
+#define DP_APF_LDHX	5
+#define DP_APF_LDWX	6
+#define DP_APF_ADD	7
+#define DP_APF_MUL	8
+#define DP_APF_DIV	9
+#define DP_APF_AND	10
+#define DP_APF_OR	11
+#define DP_APF_SH	12
+#define DP_APF_LI	13
+#define DP_APF_JMP	14
+#define DP_APF_JEQ	15
+#define DP_APF_JNE	16
+#define DP_APF_JGT	17
+#define DP_APF_JLT	18
+#define DP_APF_JSET	19
+#define DP_APF_JNEBS	20
+#define DP_APF_EXT	21
+#define DP_APF_LDDW	22
+#define DP_APF_STDW	23
+
+#define DP_APF_EXT_LDM	0
+#define DP_APF_EXT_STM	16
+#define DP_APF_EXT_NOT	32
+#define DP_APF_EXT_NEG	33
+#define DP_APF_EXT_SWAP	34
+#define DP_APF_EXT_MOV	35
+
+#define DP_APF_MEMORY_ITEMS		16
+#define DP_APF_MEM_PROGRAM_SIZE		11
+#define DP_APF_MEM_DATA_SIZE		12
+#define DP_APF_MEM_IPV4_HDR_SIZE	13
+#define DP_APF_MEM_PACKET_SIZE		14
+#define DP_APF_MEM_FILTER_AGE		15
+
+#define DP_APF_FRAME_HEADER_SIZE	14
+
+#define DP_APF_OPCODE(b)	(((b) >> 3) & 31)
+#define DP_APF_REG(b)		((b) & 1)
+#define DP_APF_IMM_LEN(b)	(((b) >> 1) & 3)
+
+/* Jump target sentinels of pre-decoded programs */
+#define DP_APF_INSN_PASS	0xFFFFFFFD
+#define DP_APF_INSN_DROP	0xFFFFFFFE
+#define DP_APF_INSN_ABORT	0xFFFFFFFF
+
+/**
+ * struct dp_apf_raw_insn - instruction as read from the byte code
+ * @opcode: APF opcode
+ * @reg: register number
+ * @imm_len: length of the immediate(s) in bytes
+ * @imm: unsigned immediate
+ * @signed_imm: sign extended immediate
+ * @cmp_imm: second immediate of conditional jumps with reg 0
+ * @len: total length of the instruction including JNEBS bytes
+ */
+struct dp_apf_raw_insn {
+	uint8_t opcode;
+	uint8_t reg;
+	uint8_t imm_len;
+	uint32_t imm;
+	int32_t signed_imm;
+	uint32_t cmp_imm;
+	uint32_t len;
+};
+
+static inline bool dp_apf_is_cond_jump(uint8_t opcode)
+{
+	return opcode >= DP_APF_JEQ && opcode <= DP_APF_JNEBS;
+}
+
+/**
+ * dp_apf_decode_one() - decode the instruction at @pc
+ * @prog: program bytes
+ * @prog_len: program length
+ * @pc: offset of the instruction
+ * @insn: decoded instruction
+ *
+ * The JNEBS byte count is only known statically when the instruction
+ * uses R0, @insn->len then covers the compared bytes as well.
+ *
+ * Return: true if the instruction fits inside the program
+ */
+static bool dp_apf_decode_one(const uint8_t *prog, uint32_t prog_len,
+			      uint32_t pc, struct dp_apf_raw_insn *insn)
+{
+	uint8_t bytecode = prog[pc];
+	uint32_t len_field;
+	uint32_t i;
+
+	qdf_mem_zero(insn, sizeof(*insn));
+	insn->opcode = DP_APF_OPCODE(bytecode);
+	insn->reg = DP_APF_REG(bytecode);
+	len_field = DP_APF_IMM_LEN(bytecode);
+	insn->len = 1;
+
+	if (len_field) {
+		insn->imm_len = 1 << (len_field - 1);
+		if (insn->imm_len > prog_len - pc - insn->len)
+			return false;
+
+		for (i = 0; i < insn->imm_len; i++)
+			insn->imm = (insn->imm << 8) | prog[pc + insn->len++];
+
+		insn->signed_imm = (int32_t)(insn->imm <<
+					     ((4 - insn->imm_len) * 8));
+		insn->signed_imm >>= (4 - insn->imm_len) * 8;
+	}
+
+	if (!dp_apf_is_cond_jump(insn->opcode) || insn->reg)
+		return true;
+
+	if (insn->imm_len) {
+		if (insn->imm_len > prog_len - pc - insn->len)
+			return false;
+
+		for (i = 0; i < insn->imm_len; i++)
+			insn->cmp_imm = (insn->cmp_imm << 8) |
+					prog[pc + insn->len++];
+	}
+
+	if (insn->opcode == DP_APF_JNEBS) {
+		if (insn->cmp_imm > prog_len - pc - insn->len)
+			return false;
+
+		insn->len += insn->cmp_imm;
+	}
+
+	return true;
+}
+
+/**
+ * dp_apf_insn_valid() - check opcode specific constraints
+ * @insn: decoded instruction
+ * @has_store: set if the instruction writes to data memory
+ *
+ * Return: true if the firmware interpreter would not bail out on it
+ */
+static bool dp_apf_insn_valid(struct dp_apf_raw_insn *insn, bool *has_store)
+{
+	switch (insn->opcode) {
+	case DP_APF_LDB:
+	case DP_APF_LDH:
+	case DP_APF_LDW:
+	case DP_APF_LDBX:
+	case DP_APF_LDHX:
+	case DP_APF_LDWX:
+	case DP_APF_ADD:
+	case DP_APF_MUL:
+	case DP_APF_AND:
+	case DP_APF_OR:
+	case DP_APF_SH:
+	case DP_APF_LI:
+	case DP_APF_JMP:
+	case DP_APF_JEQ:
+	case DP_APF_JNE:
+	case DP_APF_JGT:
+	case DP_APF_JLT:
+	case DP_APF_JSET:
+	case DP_APF_LDDW:
+		return true;
+	case DP_APF_JNEBS:
+		/* byte count in R1 makes the fall through address dynamic */
+		return !insn->reg;
+	case DP_APF_DIV:
+		return insn->reg || insn->imm;
+	case DP_APF_STDW:
+		*has_store = true;
+		return true;
+	case DP_APF_EXT:
+		if (insn->imm < DP_APF_EXT_LDM + DP_APF_MEMORY_ITEMS)
+			return true;
+		if (insn->imm >= DP_APF_EXT_STM &&
+		    insn->imm < DP_APF_EXT_STM + DP_APF_MEMORY_ITEMS)
+			return true;
+		return insn->imm >= DP_APF_EXT_NOT &&
+		       insn->imm <= DP_APF_EXT_MOV;
+	default:
+		return false;
+	}
+}
+
+/**
+ * dp_apf_jump_target() - byte offset a jump instruction branches to
+ * @pc: offset of the instruction
+ * @insn: decoded instruction
+ *
+ * Return: target offset, wraps around like the firmware interpreter
+ */
+static inline uint32_t dp_apf_jump_target(uint32_t pc,
+					  struct dp_apf_raw_insn *insn)
+{
+	return pc + insn->len + insn->imm;
+}
+
+QDF_STATUS dp_apf_verify(const uint8_t *prog, uint32_t prog_len,
+			 uint32_t mem_len, bool *has_store)
+{
+	struct dp_apf_raw_insn insn;
+	unsigned long *boundary;
+	uint32_t pc = 0;
+	uint32_t target;
+	QDF_STATUS status = QDF_STATUS_SUCCESS;
+
+	*has_store = false;
+
+	if (!prog_len || prog_len > mem_len ||
+	    mem_len > DP_HOST_APF_MAX_MEM_LEN)
+		return QDF_STATUS_E_INVAL;
+
+	boundary = qdf_mem_malloc(BITS_TO_LONGS(prog_len + 2) *
+				  sizeof(unsigned long));
+	if (!boundary)
+		return QDF_STATUS_E_NOMEM;
+
+	while (pc < prog_len) {
+		if (!dp_apf_decode_one(prog, prog_len, pc, &insn) ||
+		    !dp_apf_insn_valid(&insn, has_store)) {
+			dp_debug("APF insn at %u invalid", pc);
+			status = QDF_STATUS_E_INVAL;
+			goto free;
+		}
+		qdf_set_bit(pc, boundary);
+		pc += insn.len;
+	}
+	qdf_set_bit(prog_len, boundary);
+	qdf_set_bit(prog_len + 1, boundary);
+
+	for (pc = 0; pc < prog_len; pc += insn.len) {
+		dp_apf_decode_one(prog, prog_len, pc, &insn);
+		if (insn.opcode != DP_APF_JMP &&
+		    !dp_apf_is_cond_jump(insn.opcode))
+			continue;
+
+		target = dp_apf_jump_target(pc, &insn);
+		if (target > prog_len + 1 || !qdf_test_bit(target, boundary)) {
+			dp_debug("APF jump at %u to %u invalid", pc, target);
+			status = QDF_STATUS_E_INVAL;
+			goto free;
+		}
+	}
+
+free:
+	qdf_mem_free(boundary);
+
+	return status;
+}
+
+/**
+ * dp_apf_map_target() - translate a byte offset into a decoded index
+ * @prog_len: program length
+ * @index: map of byte offset to decoded index
+ * @target: byte offset
+ *
+ * Return: decoded index or sentinel
+ */
+static uint32_t dp_apf_map_target(uint32_t prog_len, uint16_t *index,
+				  uint32_t target)
+{
+	if (target == prog_len)
+		return DP_APF_INSN_PASS;
+	if (target == prog_len + 1)
+		return DP_APF_INSN_DROP;
+	if (target > prog_len)
+		return DP_APF_INSN_ABORT;
+
+	return index[target];
+}
+
+QDF_STATUS dp_apf_predecode(struct dp_apf_prog *prog)
+{
+	struct dp_apf_raw_insn raw;
+	struct dp_apf_insn *insn;
+	uint16_t *index;
+	uint32_t pc, n = 0;
+
+	index = qdf_mem_malloc(prog->prog_len * sizeof(*index));
+	if (!index)
+		return QDF_STATUS_E_NOMEM;
+
+	for (pc = 0; pc < prog->prog_len; pc += raw.len) {
+		dp_apf_decode_one(prog->mem, prog->prog_len, pc, &raw);
+		index[pc] = n++;
+	}
+
+	insn = qdf_mem_malloc(n * sizeof(*insn));
+	if (!insn) {
+		qdf_mem_free(index);
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	n = 0;
+	for (pc = 0; pc < prog->prog_len; pc += raw.len, n++) {
+		dp_apf_decode_one(prog->mem, prog->prog_len, pc, &raw);
+		insn[n].opcode = raw.opcode;
+		insn[n].reg = raw.reg;
+		insn[n].imm = raw.imm;
+		insn[n].signed_imm = raw.signed_imm;
+		insn[n].cmp_imm = raw.cmp_imm;
+		insn[n].bytes_off = pc + raw.len - raw.cmp_imm;
+		if (raw.opcode == DP_APF_JMP ||
+		    dp_apf_is_cond_jump(raw.opcode))
+			insn[n].target =
+				dp_apf_map_target(prog->prog_len, index,
+						  dp_apf_jump_target(pc, &raw));
+	}
+
+	qdf_mem_free(index);
+	prog->insn = insn;
+	prog->num_insn = n;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * dp_apf_load_pkt() - load a big endian value from the frame
+ * @pkt: frame
+ * @pkt_len: frame length
+ * @offs: offset of the value
+ * @size: size of the value in bytes
+ * @val: loaded value
+ *
+ * Return: false if the load is out of bounds
+ */
+static inline bool dp_apf_load_pkt(const uint8_t *pkt, uint32_t pkt_len,
+				   uint32_t offs, uint32_t size, uint32_t *val)
+{
+	uint32_t v = 0;
+
+	if (offs >= pkt_len || size > pkt_len - offs)
+		return false;
+
+	while (size--)
+		v = (v << 8) | pkt[offs++];
+	*val = v;
+
+	return true;
+}
+
+/**
+ * dp_apf_data_offs() - resolve and check an LDDW/STDW data address
+ * @prog: program
+ * @offs: address, negative values wrap around the end of memory
+ *
+ * Return: false if the access is outside the data memory
+ */
+static inline bool dp_apf_data_offs(struct dp_apf_prog *prog, uint32_t *offs)
+{
+	if (*offs & 0x80000000)
+		*offs += prog->mem_len;
+
+	return *offs >= prog->prog_len && *offs < prog->mem_len &&
+	       prog->mem_len - *offs >= 4;
+}
+
+static inline uint32_t dp_apf_ld_size(uint8_t opcode)
+{
+	switch (opcode) {
+	case DP_APF_LDB:
+	case DP_APF_LDBX:
+		return 1;
+	case DP_APF_LDH:
+	case DP_APF_LDHX:
+		return 2;
+	default:
+		return 4;
+	}
+}
+
+/**
+ * dp_apf_init_memory() - fill the pre-filled memory slots
+ * @prog: program
+ * @pkt: frame
+ * @pkt_len: frame length
+ * @memory: memory slots
+ *
+ * Return: None
+ */
+static void dp_apf_init_memory(struct dp_apf_prog *prog, const uint8_t *pkt,
+			       uint32_t pkt_len, uint32_t *memory)
+{
+	qdf_mem_zero(memory, DP_APF_MEMORY_ITEMS * sizeof(*memory));
+	memory[DP_APF_MEM_PROGRAM_SIZE] = prog->prog_len;
+	memory[DP_APF_MEM_DATA_SIZE] = prog->mem_len;
+	memory[DP_APF_MEM_PACKET_SIZE] = pkt_len;
+	memory[DP_APF_MEM_FILTER_AGE] =
+		qdf_system_ticks_to_msecs(qdf_system_ticks() -
+					  prog->install_ticks) / 1000;
+	if (pkt_len > DP_APF_FRAME_HEADER_SIZE &&
+	    (pkt[DP_APF_FRAME_HEADER_SIZE] & 0xf0) == 0x40)
+		memory[DP_APF_MEM_IPV4_HDR_SIZE] =
+			(pkt[DP_APF_FRAME_HEADER_SIZE] & 15) * 4;
+}
+
+/**
+ * dp_apf_alu() - execute an ALU/EXT/data memory instruction
+ * @prog: program
+ * @data: data memory of this run, right after the program
+ * @opcode: APF opcode
+ * @reg: register number
+ * @imm: unsigned immediate
+ * @signed_imm: sign extended immediate
+ * @regs: registers
+ * @memory: memory slots
+ *
+ * Return: false if the instruction aborts the program
+ */
+static inline bool dp_apf_alu(struct dp_apf_prog *prog, uint8_t *data,
+			      uint8_t opcode, uint8_t reg, uint32_t imm,
+			      int32_t signed_imm, uint32_t *regs,
+			      uint32_t *memory)
+{
+	uint32_t operand = reg ? regs[1] : imm;
+	uint32_t offs, tmp;
+	int32_t shift;
+
+	switch (opcode) {
+	case DP_APF_ADD:
+		regs[0] += operand;
+		break;
+	case DP_APF_MUL:
+		regs[0] *= operand;
+		break;
+	case DP_APF_DIV:
+		if (!operand)
+			return false;
+		regs[0] /= operand;
+		break;
+	case DP_APF_AND:
+		regs[0] &= operand;
+		break;
+	case DP_APF_OR:
+		regs[0] |= operand;
+		break;
+	case DP_APF_SH:
+		shift = reg ? (int32_t)regs[1] : signed_imm;
+		if (shift > 31 || shift < -31)
+			regs[0] = 0;
+		else if (shift > 0)
+			regs[0] <<= shift;
+		else
+			regs[0] >>= -shift;
+		break;
+	case DP_APF_LI:
+		regs[reg] = signed_imm;
+		break;
+	case DP_APF_EXT:
+		if (imm < DP_APF_EXT_LDM + DP_APF_MEMORY_ITEMS) {
+			regs[reg] = memory[imm - DP_APF_EXT_LDM];
+		} else if (imm >= DP_APF_EXT_STM &&
+			   imm < DP_APF_EXT_STM + DP_APF_MEMORY_ITEMS) {
+			memory[imm - DP_APF_EXT_STM] = regs[reg];
+		} else if (imm == DP_APF_EXT_NOT) {
+			regs[reg] = ~regs[reg];
+		} else if (imm == DP_APF_EXT_NEG) {
+			regs[reg] = -regs[reg];
+		} else if (imm == DP_APF_EXT_SWAP) {
+			tmp = regs[0];
+			regs[0] = regs[1];
+			regs[1] = tmp;
+		} else if (imm == DP_APF_EXT_MOV) {
+			regs[reg] = regs[reg ^ 1];
+		} else {
+			return false;
+		}
+		break;
+	case DP_APF_LDDW:
+		offs = regs[reg ^ 1] + signed_imm;
+		if (!dp_apf_data_offs(prog, &offs))
+			return false;
+		offs -= prog->prog_len;
+		regs[reg] = (data[offs] << 24) | (data[offs + 1] << 16) |
+			    (data[offs + 2] << 8) | data[offs + 3];
+		break;
+	case DP_APF_STDW:
+		offs = regs[reg ^ 1] + signed_imm;
+		if (!dp_apf_data_offs(prog, &offs))
+			return false;
+		offs -= prog->prog_len;
+		data[offs] = regs[reg] >> 24;
+		data[offs + 1] = regs[reg] >> 16;
+		data[offs + 2] = regs[reg] >> 8;
+		data[offs + 3] = regs[reg];
+		break;
+	default:
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * dp_apf_cond() - evaluate a conditional jump
+ * @opcode: APF opcode
+ * @r0: register 0
+ * @cmp: compare value
+ *
+ * Return: true if the jump is taken
+ */
+static inline bool dp_apf_cond(uint8_t opcode, uint32_t r0, uint32_t cmp)
+{
+	switch (opcode) {
+	case DP_APF_JEQ:
+		return r0 == cmp;
+	case DP_APF_JNE:
+		return r0 != cmp;
+	case DP_APF_JGT:
+		return r0 > cmp;
+	case DP_APF_JLT:
+		return r0 < cmp;
+	case DP_APF_JSET:
+		return r0 & cmp;
+	default:
+		return false;
+	}
+}
+
+/**
+ * dp_apf_jnebs() - evaluate a JNEBS comparison
+ * @prog: program
+ * @bytes_off: program offset of the bytes to compare
+ * @count: number of bytes
+ * @pkt: frame
+ * @pkt_len: frame length
+ * @offs: frame offset to compare at
+ * @taken: set if the bytes differ
+ *
+ * Return: false if the comparison is out of bounds
+ */
+static inline bool dp_apf_jnebs(struct dp_apf_prog *prog, uint32_t bytes_off,
+				uint32_t count, const uint8_t *pkt,
+				uint32_t pkt_len, uint32_t offs, bool *taken)
+{
+	if (offs >= pkt_len || count > pkt_len - offs)
+		return false;
+
+	*taken = !!qdf_mem_cmp(prog->mem + bytes_off, pkt + offs, count);
+
+	return true;
+}
+
+/**
+ * dp_apf_interpret() - run the program byte code
+ * @prog: verified program
+ * @data: data memory of this run
+ * @pkt: frame
+ * @pkt_len: frame length
+ *
+ * All program accesses are bounds checked here as well, so the byte code
+ * interpreter stays safe even for a program which was not pre-decoded.
+ *
+ * Return: enum dp_apf_verdict
+ */
+static enum dp_apf_verdict dp_apf_interpret(struct dp_apf_prog *prog,
+					    uint8_t *data,
+					    const uint8_t *pkt,
+					    uint32_t pkt_len)
+{
+	uint32_t memory[DP_APF_MEMORY_ITEMS];
+	uint32_t regs[2] = {0};
+	uint32_t budget = prog->prog_len;
+	struct dp_apf_raw_insn insn;
+	uint32_t pc = 0, next, cmp;
+	bool taken;
+
+	dp_apf_init_memory(prog, pkt, pkt_len, memory);
+
+	do {
+		if (pc == prog->prog_len)
+			return DP_APF_PASS;
+		if (pc == prog->prog_len + 1)
+			return DP_APF_DROP;
+		if (pc > prog->prog_len ||
+		    !dp_apf_decode_one(prog->mem, prog->prog_len, pc, &insn))
+			return DP_APF_ABORT;
+
+		next = pc + insn.len;
+
+		switch (insn.opcode) {
+		case DP_APF_LDB:
+		case DP_APF_LDH:
+		case DP_APF_LDW:
+		case DP_APF_LDBX:
+		case DP_APF_LDHX:
+		case DP_APF_LDWX:
+			cmp = insn.imm;
+			if (insn.opcode >= DP_APF_LDBX)
+				cmp += regs[1];
+			if (!dp_apf_load_pkt(pkt, pkt_len, cmp,
+					     dp_apf_ld_size(insn.opcode),
+					     &regs[insn.reg]))
+				return DP_APF_ABORT;
+			break;
+		case DP_APF_JMP:
+			next += insn.imm;
+			break;
+		case DP_APF_JNEBS:
+			if (insn.reg)
+				return DP_APF_ABORT;
+			if (!dp_apf_jnebs(prog, next - insn.cmp_imm,
+					  insn.cmp_imm, pkt, pkt_len, regs[0],
+					  &taken))
+				return DP_APF_ABORT;
+			if (taken)
+				next += insn.imm;
+			break;
+		case DP_APF_JEQ:
+		case DP_APF_JNE:
+		case DP_APF_JGT:
+		case DP_APF_JLT:
+		case DP_APF_JSET:
+			cmp = insn.reg ? regs[1] : insn.cmp_imm;
+			if (dp_apf_cond(insn.opcode, regs[0], cmp))
+				next += insn.imm;
+			break;
+		default:
+			if (!dp_apf_alu(prog, data, insn.opcode, insn.reg,
+					insn.imm, insn.signed_imm, regs, memory))
+				return DP_APF_ABORT;
+		}
+
+		pc = next;
+	} while (budget--);
+
+	return DP_APF_ABORT;
+}
+
+/**
+ * dp_apf_execute() - run the pre-decoded program
+ * @prog: verified and pre-decoded program
+ * @data: data memory of this run
+ * @pkt: frame
+ * @pkt_len: frame length
+ *
+ * Instruction decode and jump targets were validated by the verifier, so
+ * only frame and data memory accesses are checked here.
+ *
+ * Return: enum dp_apf_verdict
+ */
+static enum dp_apf_verdict dp_apf_execute(struct dp_apf_prog *prog,
+					  uint8_t *data,
+					  const uint8_t *pkt,
+					  uint32_t pkt_len)
+{
+	uint32_t memory[DP_APF_MEMORY_ITEMS];
+	uint32_t regs[2] = {0};
+	uint32_t budget = prog->prog_len;
+	struct dp_apf_insn *insn;
+	uint32_t idx = 0, offs;
+	bool taken;
+
+	dp_apf_init_memory(prog, pkt, pkt_len, memory);
+
+	do {
+		if (qdf_unlikely(idx >= prog->num_insn)) {
+			/* falling off the last instruction is a PASS */
+			if (idx == DP_APF_INSN_PASS || idx == prog->num_insn)
+				return DP_APF_PASS;
+			if (idx == DP_APF_INSN_DROP)
+				return DP_APF_DROP;
+			return DP_APF_ABORT;
+		}
+
+		insn = &prog->insn[idx++];
+
+		switch (insn->opcode) {
+		case DP_APF_LDB:
+		case DP_APF_LDH:
+		case DP_APF_LDW:
+		case DP_APF_LDBX:
+		case DP_APF_LDHX:
+		case DP_APF_LDWX:
+			offs = insn->imm;
+			if (insn->opcode >= DP_APF_LDBX)
+				offs += regs[1];
+			if (!dp_apf_load_pkt(pkt, pkt_len, offs,
+					     dp_apf_ld_size(insn->opcode),
+					     &regs[insn->reg]))
+				return DP_APF_ABORT;
+			break;
+		case DP_APF_JMP:
+			idx = insn->target;
+			break;
+		case DP_APF_JNEBS:
+			if (!dp_apf_jnebs(prog, insn->bytes_off, insn->cmp_imm,
+					  pkt, pkt_len, regs[0], &taken))
+				return DP_APF_ABORT;
+			if (taken)
+				idx = insn->target;
+			break;
+		case DP_APF_JEQ:
+		case DP_APF_JNE:
+		case DP_APF_JGT:
+		case DP_APF_JLT:
+		case DP_APF_JSET:
+			if (dp_apf_cond(insn->opcode, regs[0],
+					insn->reg ? regs[1] : insn->cmp_imm))
+				idx = insn->target;
+			break;
+		default:
+			if (!dp_apf_alu(prog, data, insn->opcode, insn->reg,
+					insn->imm, insn->signed_imm, regs,
+					memory))
+				return DP_APF_ABORT;
+		}
+	} while (budget--);
+
+	return DP_APF_ABORT;
+}
+
+enum dp_apf_verdict dp_apf_run(struct dp_apf_prog *prog,
+			       const uint8_t *pkt, uint32_t pkt_len)
+{
+	struct dp_apf_prog_stats *stats;
+	enum dp_apf_verdict verdict;
+	uint8_t *data = prog->mem + prog->prog_len;
+
+	/*
+	 * Runs of a program which stores are serialized, so that counters
+	 * kept in data memory see every frame no matter the CPU.
+	 */
+	if (prog->has_store)
+		qdf_spin_lock_bh(&prog->data_lock);
+
+	stats = &prog->stats[qdf_get_cpu()];
+
+	if (prog->insn)
+		verdict = dp_apf_execute(prog, data, pkt, pkt_len);
+	else
+		verdict = dp_apf_interpret(prog, data, pkt, pkt_len);
+
+	stats->run++;
+	if (verdict == DP_APF_DROP)
+		stats->drop++;
+	else if (verdict == DP_APF_ABORT)
+		stats->abort++;
+
+	if (prog->has_store)
+		qdf_spin_unlock_bh(&prog->data_lock);
+
+	return verdict;
+}
+
+static void dp_apf_prog_free(struct dp_apf_prog *prog)
+{
+	if (prog->has_store)
+		qdf_spinlock_destroy(&prog->data_lock);
+	if (prog->data_base)
+		qdf_mem_free(prog->data_base);
+	if (prog->insn)
+		qdf_mem_free(prog->insn);
+	qdf_mem_free(prog->mem);
+	qdf_mem_free(prog);
+}
+
+/**
+ * dp_apf_alloc_data_base() - keep the installed image of the data memory
+ * @prog: program with stores
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS dp_apf_alloc_data_base(struct dp_apf_prog *prog)
+{
+	uint32_t data_len = prog->mem_len - prog->prog_len;
+
+	if (!data_len)
+		return QDF_STATUS_SUCCESS;
+
+	prog->data_base = qdf_mem_malloc(data_len);
+	if (!prog->data_base)
+		return QDF_STATUS_E_NOMEM;
+
+	qdf_mem_copy(prog->data_base, prog->mem + prog->prog_len, data_len);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+struct dp_apf_prog *dp_apf_prog_alloc(const uint8_t *mem, uint32_t prog_len,
+				      uint32_t mem_len, uint32_t filter_id,
+				      bool predecode)
+{
+	struct dp_apf_prog *prog;
+	bool has_store;
+
+	if (QDF_IS_STATUS_ERROR(dp_apf_verify(mem, prog_len, mem_len,
+					      &has_store)))
+		return NULL;
+
+	prog = qdf_mem_malloc(sizeof(*prog));
+	if (!prog)
+		return NULL;
+
+	prog->mem = qdf_mem_malloc(mem_len);
+	if (!prog->mem) {
+		qdf_mem_free(prog);
+		return NULL;
+	}
+
+	qdf_mem_copy(prog->mem, mem, mem_len);
+	prog->prog_len = prog_len;
+	prog->mem_len = mem_len;
+	prog->filter_id = filter_id;
+	prog->has_store = has_store;
+	prog->install_ticks = qdf_system_ticks();
+	qdf_atomic_init(&prog->ref);
+	qdf_atomic_inc(&prog->ref);
+
+	if (has_store) {
+		qdf_spinlock_create(&prog->data_lock);
+		if (QDF_IS_STATUS_ERROR(dp_apf_alloc_data_base(prog))) {
+			dp_apf_prog_free(prog);
+			return NULL;
+		}
+	}
+
+	if (predecode && QDF_IS_STATUS_ERROR(dp_apf_predecode(prog)))
+		dp_info("APF filter %u: predecode failed, interpreting",
+			filter_id);
+
+	return prog;
+}
+
+void dp_apf_prog_put(struct dp_apf_prog *prog)
+{
+	if (prog && qdf_atomic_dec_and_test(&prog->ref))
+		dp_apf_prog_free(prog);
+}
+
+/**
+ * dp_host_apf_get_prog() - take a reference of the active program
+ * @apf: host APF context
+ *
+ * Return: active program, NULL if none is installed or enabled
+ */
+static struct dp_apf_prog *dp_host_apf_get_prog(struct dp_host_apf_ctx *apf)
+{
+	struct dp_apf_prog *prog = NULL;
+
+	qdf_spin_lock_bh(&apf->lock);
+	if (apf->active && apf->prog) {
+		prog = apf->prog;
+		qdf_atomic_inc(&prog->ref);
+	}
+	qdf_spin_unlock_bh(&apf->lock);
+
+	return prog;
+}
+
+void dp_host_apf_init(struct wlan_dp_intf *dp_intf)
+{
+	struct dp_host_apf_ctx *apf = &dp_intf->host_apf;
+
+	qdf_mem_zero(apf, sizeof(*apf));
+	qdf_spinlock_create(&apf->lock);
+	qdf_mutex_create(&apf->staging_lock);
+	/* legacy APF programs are active as soon as they are installed */
+	apf->active = true;
+
+	if (dp_intf->dp_ctx->dp_cfg.host_apf_mode == DP_HOST_APF_DISABLED)
+		return;
+
+	apf->staging = qdf_mem_malloc(DP_HOST_APF_MAX_MEM_LEN);
+	if (!apf->staging)
+		dp_err("host APF staging alloc failed, host APF off");
+}
+
+void dp_host_apf_deinit(struct wlan_dp_intf *dp_intf)
+{
+	struct dp_host_apf_ctx *apf = &dp_intf->host_apf;
+
+	dp_host_apf_reset(dp_intf);
+	if (apf->staging) {
+		qdf_mem_free(apf->staging);
+		apf->staging = NULL;
+	}
+	qdf_mutex_destroy(&apf->staging_lock);
+	qdf_spinlock_destroy(&apf->lock);
+}
+
+QDF_STATUS dp_host_apf_write(struct wlan_dp_intf *dp_intf, uint32_t offset,
+			     const uint8_t *buf, uint32_t len,
+			     uint32_t prog_len)
+{
+	struct dp_host_apf_ctx *apf = &dp_intf->host_apf;
+
+	if (dp_intf->dp_ctx->dp_cfg.host_apf_mode == DP_HOST_APF_DISABLED ||
+	    !apf->staging)
+		return QDF_STATUS_E_NOSUPPORT;
+
+	if (!len || offset > DP_HOST_APF_MAX_MEM_LEN ||
+	    len > DP_HOST_APF_MAX_MEM_LEN - offset ||
+	    prog_len > DP_HOST_APF_MAX_MEM_LEN)
+		return QDF_STATUS_E_INVAL;
+
+	qdf_mutex_acquire(&apf->staging_lock);
+	/* a write at offset 0 starts a new program image */
+	if (!offset)
+		apf->staging_len = 0;
+	qdf_mem_copy(apf->staging + offset, buf, len);
+	apf->staging_len = QDF_MAX(apf->staging_len, offset + len);
+	apf->staging_prog_len = prog_len;
+	qdf_mutex_release(&apf->staging_lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS dp_host_apf_commit(struct wlan_dp_intf *dp_intf,
+			      uint32_t filter_id)
+{
+	struct dp_host_apf_ctx *apf = &dp_intf->host_apf;
+	struct wlan_dp_psoc_cfg *cfg = &dp_intf->dp_ctx->dp_cfg;
+	struct dp_apf_prog *prog, *old;
+	uint32_t mem_len, prog_len;
+
+	if (cfg->host_apf_mode == DP_HOST_APF_DISABLED || !apf->staging)
+		return QDF_STATUS_E_NOSUPPORT;
+
+	qdf_mutex_acquire(&apf->staging_lock);
+	mem_len = apf->staging_len;
+	prog_len = apf->staging_prog_len;
+	if (!mem_len && !prog_len) {
+		qdf_mutex_release(&apf->staging_lock);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	prog = dp_apf_prog_alloc(apf->staging, prog_len,
+				 QDF_MAX(mem_len, prog_len), filter_id,
+				 cfg->host_apf_predecode);
+	apf->staging_len = 0;
+	apf->staging_prog_len = 0;
+	qdf_mutex_release(&apf->staging_lock);
+
+	/* keep running the program which was verified last */
+	if (!prog) {
+		apf->verify_fail++;
+		dp_err("APF filter %u (len %u) rejected by host verifier",
+		       filter_id, prog_len);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	qdf_spin_lock_bh(&apf->lock);
+	old = apf->prog;
+	apf->prog = prog;
+	qdf_spin_unlock_bh(&apf->lock);
+
+	dp_apf_prog_put(old);
+	dp_info("APF filter %u installed on host, len %u mem %u %s",
+		filter_id, prog->prog_len, prog->mem_len,
+		prog->insn ? "predecoded" : "interpreted");
+
+	return QDF_STATUS_SUCCESS;
+}
+
+void dp_host_apf_reset(struct wlan_dp_intf *dp_intf)
+{
+	struct dp_host_apf_ctx *apf = &dp_intf->host_apf;
+	struct dp_apf_prog *old;
+
+	qdf_spin_lock_bh(&apf->lock);
+	old = apf->prog;
+	apf->prog = NULL;
+	qdf_spin_unlock_bh(&apf->lock);
+
+	qdf_mutex_acquire(&apf->staging_lock);
+	apf->staging_len = 0;
+	apf->staging_prog_len = 0;
+	qdf_mutex_release(&apf->staging_lock);
+
+	dp_apf_prog_put(old);
+}
+
+void dp_host_apf_set_active(struct wlan_dp_intf *dp_intf, bool active)
+{
+	struct dp_host_apf_ctx *apf = &dp_intf->host_apf;
+
+	qdf_spin_lock_bh(&apf->lock);
+	apf->active = active;
+	qdf_spin_unlock_bh(&apf->lock);
+}
+
+static inline uint32_t dp_apf_get_be32(const uint8_t *p)
+{
+	return (p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static inline void dp_apf_put_be32(uint8_t *p, uint32_t val)
+{
+	p[0] = val >> 24;
+	p[1] = val >> 16;
+	p[2] = val >> 8;
+	p[3] = val;
+}
+
+void dp_host_apf_read_merge(struct wlan_dp_intf *dp_intf, uint32_t offset,
+			    uint8_t *buf, uint32_t len)
+{
+	struct dp_host_apf_ctx *apf = &dp_intf->host_apf;
+	struct dp_apf_prog *prog;
+	uint32_t pos, end, delta;
+	uint8_t *data;
+
+	qdf_spin_lock_bh(&apf->lock);
+	prog = apf->prog;
+	if (prog)
+		qdf_atomic_inc(&prog->ref);
+	qdf_spin_unlock_bh(&apf->lock);
+
+	if (!prog)
+		return;
+
+	if (!prog->has_store || !prog->data_base)
+		goto put;
+
+	data = prog->mem + prog->prog_len;
+	end = QDF_MIN(prog->mem_len, offset + len);
+	pos = prog->prog_len + (prog->mem_len - prog->prog_len) % 4;
+
+	qdf_spin_lock_bh(&prog->data_lock);
+	for (; pos + 4 <= end; pos += 4) {
+		if (pos < offset)
+			continue;
+
+		delta = dp_apf_get_be32(data + pos - prog->prog_len) -
+			dp_apf_get_be32(prog->data_base + pos - prog->prog_len);
+		if (delta)
+			dp_apf_put_be32(buf + pos - offset,
+					dp_apf_get_be32(buf + pos - offset) +
+					delta);
+	}
+	qdf_spin_unlock_bh(&prog->data_lock);
+
+put:
+	dp_apf_prog_put(prog);
+}
+
+qdf_nbuf_t dp_host_apf_filter_list(struct wlan_dp_intf *dp_intf,
+				   qdf_nbuf_t nbuf_list)
+{
+	struct wlan_dp_psoc_cfg *cfg = &dp_intf->dp_ctx->dp_cfg;
+	struct dp_apf_prog *prog;
+	qdf_nbuf_t nbuf, next, head = NULL, tail = NULL;
+	uint8_t *data;
+
+	if (qdf_likely(!dp_intf->host_apf.prog))
+		return nbuf_list;
+
+	prog = dp_host_apf_get_prog(&dp_intf->host_apf);
+	if (!prog)
+		return nbuf_list;
+
+	for (nbuf = nbuf_list; nbuf; nbuf = next) {
+		next = qdf_nbuf_next(nbuf);
+		data = qdf_nbuf_data(nbuf);
+
+		if (qdf_nbuf_is_nonlinear(nbuf) ||
+		    (cfg->host_apf_mode == DP_HOST_APF_GROUP_ADDR &&
+		     !(data[QDF_NBUF_DEST_MAC_OFFSET] & 0x01)) ||
+		    dp_apf_run(prog, data, qdf_nbuf_len(nbuf)) != DP_APF_DROP) {
+			if (tail)
+				qdf_nbuf_set_next(tail, nbuf);
+			else
+				head = nbuf;
+			tail = nbuf;
+			continue;
+		}
+
+		qdf_nbuf_set_next(nbuf, NULL);
+		qdf_nbuf_free(nbuf);
+	}
+
+	if (tail)
+		qdf_nbuf_set_next(tail, NULL);
+
+	dp_apf_prog_put(prog);
+
+	return head;
+}
+
+void dp_host_apf_display_stats(struct wlan_dp_intf *dp_intf)
+{
+	struct dp_apf_prog *prog;
+	uint64_t run = 0, drop = 0, abort = 0;
+	int i;
+
+	qdf_spin_lock_bh(&dp_intf->host_apf.lock);
+	prog = dp_intf->host_apf.prog;
+	if (prog)
+		qdf_atomic_inc(&prog->ref);
+	qdf_spin_unlock_bh(&dp_intf->host_apf.lock);
+
+	if (!prog)
+		return;
+
+	for (i = 0; i < NUM_CPUS; i++) {
+		run += prog->stats[i].run;
+		drop += prog->stats[i].drop;
+		abort += prog->stats[i].abort;
+	}
+
+	dp_info("Host APF filter %u (%s, len %u): run %llu drop %llu abort %llu verify_fail %u",
+		prog->filter_id, prog->insn ? "predecoded" : "interpreted",
+		prog->prog_len, run, drop, abort,
+		dp_intf->host_apf.verify_fail);
+
+	dp_apf_prog_put(prog);
+}
+#endif /* WLAN_DP_HOST_APF */
@@ -1140,6 +1140,8 @@ static void wlan_dp_display_txrx_stats(struct wlan_dp_psoc_context *dp_ctx)
 			stats->rx_gro_low_tput_flush,
 			qdf_atomic_read(&dp_ctx->disable_rx_ol_in_concurrency),
 			qdf_atomic_read(&dp_ctx->disable_rx_ol_in_low_tput));
+
+		dp_host_apf_display_stats(dp_intf);
 	}
 }
 
@@ -1208,32 +1210,43 @@ static void dp_display_periodic_stats(struct wlan_dp_psoc_context *dp_ctx,
 
 /**
  * dp_pm_qos_update_cpu_mask() - Prepare CPU mask for PM_qos voting
+ * @dp_ctx: DP context
  * @mask: return variable of cpumask for the TPUT
  * @enable_perf_cluster: Enable PERF cluster or not
  *
  * By default, the function sets CPU mask for silver cluster unless
- * enable_perf_cluster is set as true.
+ * enable_perf_cluster is set as true. With enable_perf_cluster, the CPUs
+ * the affinity manager placed the datapath on are voted instead of the
+ * whole perf cluster, if such a placement exists.
  *
  * Return: none
  */
-static inline void dp_pm_qos_update_cpu_mask(qdf_cpu_mask *mask,
-					     bool enable_perf_cluster)
+static inline void
+dp_pm_qos_update_cpu_mask(struct wlan_dp_psoc_context *dp_ctx,
+			  qdf_cpu_mask *mask, bool enable_perf_cluster)
 {
 	int package_id;
 	unsigned int cpus;
 	int perf_cpu_cluster = hif_get_perf_cluster_bitmap();
 	int little_cpu_cluster = BIT(CPU_CLUSTER_TYPE_LITTLE);
+	bool use_hint;
+
+	use_hint = enable_perf_cluster &&
+		   !qdf_cpumask_empty(&dp_ctx->pm_qos_cpu_hint);
 
 	qdf_cpumask_clear(mask);
 	qdf_for_each_online_cpu(cpus) {
 		package_id = qdf_topology_physical_package_id(cpus);
 		if (package_id >= 0 &&
 		    (BIT(package_id) & little_cpu_cluster ||
-		     (enable_perf_cluster &&
+		     (enable_perf_cluster && !use_hint &&
 		      BIT(package_id) & perf_cpu_cluster))) {
 			qdf_cpumask_set_cpu(cpus, mask);
 		}
 	}
+
+	if (use_hint)
+		qdf_cpumask_or(mask, mask, &dp_ctx->pm_qos_cpu_hint);
 }
 
 /**
@@ -1297,11 +1310,11 @@ bool dp_bus_bandwidth_work_tune_rx(struct wlan_dp_psoc_context *dp_ctx,
 		rxthread_high_tput_req = true;
 		*is_rx_pm_qos_high = true;
 		/*Todo: move hdd implementation to qdf */
-		dp_pm_qos_update_cpu_mask(cpu_mask, true);
+		dp_pm_qos_update_cpu_mask(dp_ctx, cpu_mask, true);
 	} else if (avg_rx > dp_ctx->dp_cfg.bus_bw_high_threshold) {
 		rxthread_high_tput_req = false;
 		*is_rx_pm_qos_high = false;
-		dp_pm_qos_update_cpu_mask(cpu_mask, false);
+		dp_pm_qos_update_cpu_mask(dp_ctx, cpu_mask, false);
 	} else {
 		*is_rx_pm_qos_high = false;
 		rxthread_high_tput_req = false;
@@ -1411,10 +1424,10 @@ bool dp_bus_bandwidth_work_tune_tx(struct wlan_dp_psoc_context *dp_ctx,
 
 	if (avg_no_tx_offload_pkts >
 		dp_ctx->dp_cfg.bus_bw_very_high_threshold) {
-		dp_pm_qos_update_cpu_mask(cpu_mask, true);
+		dp_pm_qos_update_cpu_mask(dp_ctx, cpu_mask, true);
 		*is_tx_pm_qos_high = true;
 	} else if (avg_tx > dp_ctx->dp_cfg.bus_bw_high_threshold) {
-		dp_pm_qos_update_cpu_mask(cpu_mask, false);
+		dp_pm_qos_update_cpu_mask(dp_ctx, cpu_mask, false);
 		*is_tx_pm_qos_high = false;
 	} else {
 		*is_tx_pm_qos_high = false;
@@ -1654,7 +1667,8 @@ static void dp_pld_request_bus_bandwidth(struct wlan_dp_psoc_context *dp_ctx,
 			    rx_packets > tx_packets &&
 			    !legacy_client) {
 				pmqos_on_low_tput = true;
-				dp_pm_qos_update_cpu_mask(&pm_qos_cpu_mask,
+				dp_pm_qos_update_cpu_mask(dp_ctx,
+							  &pm_qos_cpu_mask,
 							  false);
 			}
 		} else {
@@ -1665,7 +1679,8 @@ static void dp_pld_request_bus_bandwidth(struct wlan_dp_psoc_context *dp_ctx,
 
 			/* Default mask in case throughput is high */
 			if (qdf_cpumask_empty(&pm_qos_cpu_mask))
-				dp_pm_qos_update_cpu_mask(&pm_qos_cpu_mask,
+				dp_pm_qos_update_cpu_mask(dp_ctx,
+							  &pm_qos_cpu_mask,
 							  false);
 		}
 		dp_ops->dp_pm_qos_update_request(ctx, &pm_qos_cpu_mask);
@@ -2135,6 +2150,7 @@ static void __dp_bus_bw_compute_timer_start(struct wlan_objmgr_psoc *psoc)
 	qdf_periodic_work_start(&dp_ctx->bus_bw_work,
 				dp_ctx->dp_cfg.bus_bw_compute_interval);
 	dp_ctx->bw_vote_time = qdf_get_log_timestamp();
+	dp_stats_sampler_start(dp_ctx);
 }
 
 void dp_bus_bw_compute_timer_start(struct wlan_objmgr_psoc *psoc)
@@ -2183,6 +2199,7 @@ static void __dp_bus_bw_compute_timer_stop(struct wlan_objmgr_psoc *psoc)
 	ctx = dp_ctx->dp_ops.callback_ctx;
 	is_any_adapter_conn = dp_ctx->dp_ops.dp_any_adapter_connected(ctx);
 
+	dp_stats_sampler_stop(dp_ctx);
 	if (!qdf_periodic_work_stop_sync(&dp_ctx->bus_bw_work))
 		goto exit;
 
@@ -2308,4 +2325,19 @@ void dp_bus_bw_compute_reset_prev_txrx_stats(struct wlan_objmgr_vdev *vdev)
 	dp_intf->prev_tx_bytes = 0;
 	qdf_spin_unlock_bh(&dp_ctx->bus_bw_lock);
 }
+
+void dp_bus_bw_set_pm_qos_cpu_hint(struct wlan_objmgr_psoc *psoc,
+				   qdf_cpu_mask *mask)
+{
+	struct wlan_dp_psoc_context *dp_ctx = dp_psoc_get_priv(psoc);
+
+	if (!dp_ctx)
+		return;
+
+	/*
+	 * Set from the NAPI throughput policy callback of the bus bandwidth
+	 * work, the only reader of the hint.
+	 */
+	qdf_cpumask_copy(&dp_ctx->pm_qos_cpu_hint, mask);
+}
 #endif /* WLAN_FEATURE_DP_BUS_BANDWIDTH */
@@ -350,6 +350,16 @@ void dp_bus_bw_compute_prev_txrx_stats(struct wlan_objmgr_vdev *vdev);
  */
 void dp_bus_bw_compute_reset_prev_txrx_stats(struct wlan_objmgr_vdev *vdev);
 
+/**
+ * dp_bus_bw_set_pm_qos_cpu_hint() - set CPUs to vote for on high throughput
+ * @psoc: psoc handle
+ * @mask: CPUs the datapath is placed on, empty mask to clear the hint
+ *
+ * Return: None
+ */
+void dp_bus_bw_set_pm_qos_cpu_hint(struct wlan_objmgr_psoc *psoc,
+				   qdf_cpu_mask *mask);
+
 /**
  * dp_get_bus_bw_high_threshold() - Get the bus bw high threshold
  * level
@@ -443,6 +453,12 @@ void dp_bus_bw_compute_reset_prev_txrx_stats(struct wlan_objmgr_vdev *vdev)
 {
 }
 
+static inline
+void dp_bus_bw_set_pm_qos_cpu_hint(struct wlan_objmgr_psoc *psoc,
+				   qdf_cpu_mask *mask)
+{
+}
+
 static inline uint32_t
 dp_get_bus_bw_high_threshold(struct wlan_dp_psoc_context *dp_ctx)
 {
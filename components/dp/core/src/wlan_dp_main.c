@@ -589,6 +589,48 @@ dp_nud_tracking_cfg_update(struct wlan_dp_psoc_cfg *config,
 }
 #endif
 
+#ifdef WLAN_DP_HOST_APF
+/**
+ * dp_host_apf_cfg_update() - initialize host APF config
+ * @config : Configuration parameters
+ * @psoc: psoc handle
+ */
+static void
+dp_host_apf_cfg_update(struct wlan_dp_psoc_cfg *config,
+		       struct wlan_objmgr_psoc *psoc)
+{
+	config->host_apf_mode = cfg_get(psoc, CFG_DP_HOST_APF_MODE);
+	config->host_apf_predecode = cfg_get(psoc, CFG_DP_HOST_APF_PREDECODE);
+}
+#else
+static void
+dp_host_apf_cfg_update(struct wlan_dp_psoc_cfg *config,
+		       struct wlan_objmgr_psoc *psoc)
+{
+}
+#endif
+
+#ifdef WLAN_DP_STATS_SAMPLER
+/**
+ * dp_stats_sampler_cfg_update() - initialize DP stats sampler config
+ * @config : Configuration parameters
+ * @psoc: psoc handle
+ */
+static void
+dp_stats_sampler_cfg_update(struct wlan_dp_psoc_cfg *config,
+			    struct wlan_objmgr_psoc *psoc)
+{
+	config->stats_sample_interval =
+		cfg_get(psoc, CFG_DP_STATS_SAMPLE_INTERVAL);
+}
+#else
+static void
+dp_stats_sampler_cfg_update(struct wlan_dp_psoc_cfg *config,
+			    struct wlan_objmgr_psoc *psoc)
+{
+}
+#endif
+
 #ifdef QCA_SUPPORT_TXRX_DRIVER_TCP_DEL_ACK
 /**
  * dp_ini_tcp_del_ack_settings() - initialize TCP delack config
@@ -740,6 +782,8 @@ static void dp_cfg_init(struct wlan_dp_psoc_context *ctx)
 	dp_trace_cfg_update(config, psoc);
 	dp_nud_tracking_cfg_update(config, psoc);
 	dp_trace_cfg_update(config, psoc);
+	dp_host_apf_cfg_update(config, psoc);
+	dp_stats_sampler_cfg_update(config, psoc);
 	dp_fisa_cfg_init(config, psoc);
 }
 
@@ -28,6 +28,7 @@
 #include "wlan_cm_roam_ucfg_api.h"
 #include <wlan_cm_api.h>
 #include "wlan_dp_nud_tracking.h"
+#include "wlan_dp_stall_corr.h"
 #include "wlan_vdev_mgr_api.h"
 
 #ifdef WLAN_NUD_TRACKING
@@ -284,6 +285,8 @@ static void dp_nud_failure_work(void *data)
 		return;
 	}
 
+	dp_stall_corr_report(dp_intf, DP_STALL_TRIGGER_NUD);
+
 	dp_ctx->dp_ops.dp_nud_failure_work(dp_ctx->dp_ops.callback_ctx,
 					   dp_intf->dev);
 }
@@ -37,6 +37,14 @@ void dp_periodic_sta_stats_display(struct wlan_dp_psoc_context *dp_ctx)
 		if (dp_intf->device_mode != QDF_STA_MODE)
 			continue;
 
+		/*
+		 * Unlocked peek, periodic stats are off on most interfaces
+		 * and the mutex is taken on every bus bandwidth tick otherwise.
+		 * An enable racing with the peek is seen on the next tick.
+		 */
+		if (!dp_intf->is_sta_periodic_stats_enabled)
+			continue;
+
 		dp_cfg = dp_ctx->dp_cfg;
 		qdf_mutex_acquire(&dp_intf->sta_periodic_stats_lock);
 
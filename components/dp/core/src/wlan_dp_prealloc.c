@@ -63,6 +63,26 @@
 		(WLAN_CFG_NUM_TX_DESC_MAX * MAX_TXDESC_POOLS + \
 			WLAN_CFG_RX_SW_DESC_NUM_SIZE_MAX * MAX_RXDESC_POOLS)
 
+/**
+ * struct dp_prealloc_usage - usage accounting of a pre-alloc element
+ * @hwm: largest request seen for this element, in bytes or in number of
+ *	 elements for multi-page memory. Requests which missed are included
+ *	 so that a profiled pool grows to serve them.
+ * @hits: number of requests served by this element
+ * @misses: number of requests of this element type which could not be
+ *	    served by any element
+ * @dflt: size of the element before profile based sizing, 0 until the
+ *	  element was sized from a profile
+ *
+ * Usage is kept across driver loads for the lifetime of the module.
+ */
+struct dp_prealloc_usage {
+	uint32_t hwm;
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t dflt;
+};
+
 /**
  * struct dp_consistent_prealloc - element representing DP pre-alloc memory
  * @ring_type: HAL ring type
@@ -72,6 +92,7 @@
  * @va_aligned: aligned virtual address.
  * @pa_unaligned: Unaligned physical address.
  * @pa_aligned: Aligned physical address.
+ * @usage: usage accounting, @hwm in bytes
  */
 
 struct dp_consistent_prealloc {
@@ -82,6 +103,7 @@ struct dp_consistent_prealloc {
 	void *va_aligned;
 	qdf_dma_addr_t pa_unaligned;
 	qdf_dma_addr_t pa_aligned;
+	struct dp_prealloc_usage usage;
 };
 
 /**
@@ -93,6 +115,7 @@ struct dp_consistent_prealloc {
  * @in_use: whether this element is in use (occupied)
  * @cacheable: coherent memory or cacheable memory
  * @pages: multi page information storage
+ * @usage: usage accounting, @hwm in number of elements
  */
 struct dp_multi_page_prealloc {
 	enum qdf_dp_desc_type desc_type;
@@ -101,6 +124,7 @@ struct dp_multi_page_prealloc {
 	bool in_use;
 	bool cacheable;
 	struct qdf_mem_multi_page_t pages;
+	struct dp_prealloc_usage usage;
 };
 
 /**
@@ -111,6 +135,7 @@ struct dp_multi_page_prealloc {
  * @in_use: whether this element is in use (occupied)
  * @va_unaligned: unaligned virtual address
  * @pa_unaligned: unaligned physical address
+ * @usage: usage accounting, @hwm in bytes
  */
 struct dp_consistent_prealloc_unaligned {
 	enum hal_ring_type ring_type;
@@ -118,6 +143,7 @@ struct dp_consistent_prealloc_unaligned {
 	bool in_use;
 	void *va_unaligned;
 	qdf_dma_addr_t pa_unaligned;
+	struct dp_prealloc_usage usage;
 };
 
 /**
@@ -127,6 +153,7 @@ struct dp_consistent_prealloc_unaligned {
  * @in_use: check if element is being used
  * @is_critical: critical prealloc failure would cause prealloc_init to fail
  * @addr: address of memory allocated
+ * @usage: usage accounting, @hwm in bytes
  */
 struct dp_prealloc_context {
 	enum dp_ctxt_type ctxt_type;
@@ -134,6 +161,7 @@ struct dp_prealloc_context {
 	bool in_use;
 	bool is_critical;
 	void *addr;
+	struct dp_prealloc_usage usage;
 };
 
 static struct dp_prealloc_context g_dp_context_allocs[] = {
@@ -458,6 +486,279 @@ static struct dp_consistent_prealloc_unaligned
 	 + CE_DESC_RING_ALIGN), false, NULL, 0},
 };
 
+/* Set once dp_prealloc_init() succeeds, cleared by dp_prealloc_deinit() */
+static bool g_dp_prealloc_active;
+
+/* Number of driver loads recorded in the usage accounting */
+static uint32_t g_dp_prealloc_profiled_loads;
+
+/**
+ * dp_prealloc_usage_hit() - Account a request served by a pre-alloc element
+ * @usage: usage accounting of the element
+ * @req: requested bytes or number of elements
+ *
+ * Return: None
+ */
+static inline void dp_prealloc_usage_hit(struct dp_prealloc_usage *usage,
+					 uint32_t req)
+{
+	usage->hits++;
+	if (req > usage->hwm)
+		usage->hwm = req;
+}
+
+/**
+ * dp_prealloc_usage_miss() - Account a request no pre-alloc element served
+ * @usage: usage accounting of the largest element of the requested type
+ * @req: requested bytes or number of elements
+ *
+ * Return: None
+ */
+static inline void dp_prealloc_usage_miss(struct dp_prealloc_usage *usage,
+					  uint32_t req)
+{
+	usage->misses++;
+	if (req > usage->hwm)
+		usage->hwm = req;
+}
+
+/**
+ * dp_prealloc_default_size() - Get the size of an element before profiling
+ * @usage: usage accounting of the element
+ * @size: current size of the element
+ *
+ * Return: size the element had before it was sized from a profile
+ */
+static inline uint32_t
+dp_prealloc_default_size(struct dp_prealloc_usage *usage, uint32_t size)
+{
+	return usage->dflt ? usage->dflt : size;
+}
+
+#ifdef DP_PREALLOC_AUTO_SIZE
+/**
+ * dp_prealloc_profile_size() - Get the size of an element from the profile
+ * @usage: usage accounting of the element
+ * @size: default size of the element, bytes or number of elements
+ * @unit: bytes per unit of @size
+ * @reclaimed: bytes saved against the default size, negative if grown
+ *
+ * An element never used in the profiled loads is not allocated at all,
+ * the others are sized to the largest request seen including the ones
+ * which missed. Requests beyond the profiled size fall back to regular
+ * allocation and grow the profile for the next load.
+ *
+ * Return: profiled size of the element
+ */
+static uint32_t dp_prealloc_profile_size(struct dp_prealloc_usage *usage,
+					 uint32_t size, uint32_t unit,
+					 int64_t *reclaimed)
+{
+	if (!g_dp_prealloc_profiled_loads)
+		return size;
+
+	usage->dflt = size;
+	*reclaimed += ((int64_t)size - (int64_t)usage->hwm) * unit;
+
+	return usage->hwm;
+}
+
+/**
+ * dp_prealloc_profile_unused() - Check if the profile never used an element
+ * @usage: usage accounting of the element
+ *
+ * Return: true if profiled loads never requested the element
+ */
+static bool dp_prealloc_profile_unused(struct dp_prealloc_usage *usage)
+{
+	return g_dp_prealloc_profiled_loads && !usage->hwm;
+}
+#else
+static inline
+uint32_t dp_prealloc_profile_size(struct dp_prealloc_usage *usage,
+				  uint32_t size, uint32_t unit,
+				  int64_t *reclaimed)
+{
+	return size;
+}
+
+static inline bool dp_prealloc_profile_unused(struct dp_prealloc_usage *usage)
+{
+	return false;
+}
+#endif
+
+static struct dp_prealloc_usage *dp_prealloc_context_usage(int i)
+{
+	return &g_dp_context_allocs[i].usage;
+}
+
+static struct dp_prealloc_usage *dp_prealloc_coherent_usage(int i)
+{
+	return &g_dp_consistent_allocs[i].usage;
+}
+
+static struct dp_prealloc_usage *dp_prealloc_multi_page_usage(int i)
+{
+	return &g_dp_multi_page_allocs[i].usage;
+}
+
+static struct dp_prealloc_usage *dp_prealloc_unaligned_usage(int i)
+{
+	return &g_dp_consistent_unaligned_allocs[i].usage;
+}
+
+/**
+ * struct dp_prealloc_profile_table - pre-alloc table in the usage profile
+ * @name: table name in the profile text
+ * @num: number of elements in the table
+ * @usage: get the usage accounting of the element at an index
+ */
+struct dp_prealloc_profile_table {
+	const char *name;
+	uint32_t num;
+	struct dp_prealloc_usage *(*usage)(int i);
+};
+
+static const struct dp_prealloc_profile_table g_dp_prealloc_profile[] = {
+	{"context", QDF_ARRAY_SIZE(g_dp_context_allocs),
+	 dp_prealloc_context_usage},
+	{"coherent", QDF_ARRAY_SIZE(g_dp_consistent_allocs),
+	 dp_prealloc_coherent_usage},
+	{"pages", QDF_ARRAY_SIZE(g_dp_multi_page_allocs),
+	 dp_prealloc_multi_page_usage},
+	{"unaligned", QDF_ARRAY_SIZE(g_dp_consistent_unaligned_allocs),
+	 dp_prealloc_unaligned_usage},
+};
+
+int dp_prealloc_profile_show(char *buf, qdf_size_t size)
+{
+	const struct dp_prealloc_profile_table *t;
+	struct dp_prealloc_usage *usage;
+	int len;
+	int i, j;
+
+	len = qdf_scnprintf(buf, size, "loads %u\n",
+			    g_dp_prealloc_profiled_loads);
+	for (i = 0; i < QDF_ARRAY_SIZE(g_dp_prealloc_profile); i++) {
+		t = &g_dp_prealloc_profile[i];
+		len += qdf_scnprintf(buf + len, size - len, "%s", t->name);
+		for (j = 0; j < t->num; j++) {
+			usage = t->usage(j);
+			len += qdf_scnprintf(buf + len, size - len,
+					     " %u/%u/%u", usage->hwm,
+					     usage->hits, usage->misses);
+		}
+		len += qdf_scnprintf(buf + len, size - len, "\n");
+	}
+
+	return len;
+}
+
+#ifdef DP_PREALLOC_AUTO_SIZE
+/**
+ * dp_prealloc_parse_u32() - Parse a decimal number
+ * @str: string to parse
+ * @val: parsed number
+ *
+ * Return: pointer past the number, NULL if @str does not start with a digit
+ */
+static const char *dp_prealloc_parse_u32(const char *str, uint32_t *val)
+{
+	uint32_t v = 0;
+
+	if (*str < '0' || *str > '9')
+		return NULL;
+
+	while (*str >= '0' && *str <= '9')
+		v = v * 10 + (*str++ - '0');
+
+	*val = v;
+
+	return str;
+}
+
+/**
+ * dp_prealloc_parse_profile() - Parse a usage profile
+ * @str: profile text in the format produced by dp_prealloc_profile_show(),
+ *	 lines may also be separated by a space to pass it as module param
+ * @apply: update the usage accounting, only validate the text if false
+ *
+ * Only the high water mark of each element is taken from the profile, the
+ * hit and miss counters restart from zero.
+ *
+ * Return: QDF_STATUS_SUCCESS if the profile matches the pre-alloc tables
+ */
+static QDF_STATUS dp_prealloc_parse_profile(const char *str, bool apply)
+{
+	const struct dp_prealloc_profile_table *t;
+	struct dp_prealloc_usage *usage;
+	uint32_t loads, hwm;
+	int i, j;
+
+	if (qdf_mem_cmp(str, "loads ", 6))
+		return QDF_STATUS_E_INVAL;
+
+	str = dp_prealloc_parse_u32(str + 6, &loads);
+	if (!str)
+		return QDF_STATUS_E_INVAL;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(g_dp_prealloc_profile); i++) {
+		t = &g_dp_prealloc_profile[i];
+		while (*str == '\n' || *str == ' ')
+			str++;
+		if (qdf_mem_cmp(str, t->name, qdf_str_len(t->name)))
+			return QDF_STATUS_E_INVAL;
+		str += qdf_str_len(t->name);
+
+		for (j = 0; j < t->num; j++) {
+			if (*str++ != ' ')
+				return QDF_STATUS_E_INVAL;
+			str = dp_prealloc_parse_u32(str, &hwm);
+			if (!str)
+				return QDF_STATUS_E_INVAL;
+			/* skip hit and miss counters */
+			while (*str == '/' || (*str >= '0' && *str <= '9'))
+				str++;
+
+			if (!apply)
+				continue;
+
+			usage = t->usage(j);
+			usage->hwm = hwm;
+			usage->hits = 0;
+			usage->misses = 0;
+		}
+
+		if (*str != '\n' && *str != ' ' && *str != '\0')
+			return QDF_STATUS_E_INVAL;
+	}
+
+	if (apply)
+		g_dp_prealloc_profiled_loads = loads;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS dp_prealloc_profile_load(const char *str)
+{
+	QDF_STATUS status;
+
+	if (g_dp_prealloc_active) {
+		dp_err("pre-alloc pools in use, profile not loaded");
+		return QDF_STATUS_E_BUSY;
+	}
+
+	status = dp_prealloc_parse_profile(str, false);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		dp_err("pre-alloc profile does not match pre-alloc tables");
+		return status;
+	}
+
+	return dp_prealloc_parse_profile(str, true);
+}
+#endif /* DP_PREALLOC_AUTO_SIZE */
+
 void dp_prealloc_deinit(void)
 {
 	int i;
@@ -470,6 +771,11 @@ void dp_prealloc_deinit(void)
 	if (!qdf_ctx)
 		return;
 
+	if (g_dp_prealloc_active) {
+		g_dp_prealloc_active = false;
+		g_dp_prealloc_profiled_loads++;
+	}
+
 	for (i = 0; i < QDF_ARRAY_SIZE(g_dp_consistent_allocs); i++) {
 		p = &g_dp_consistent_allocs[i];
 
@@ -805,6 +1111,7 @@ QDF_STATUS dp_prealloc_init(struct cdp_ctrl_objmgr_psoc *ctrl_psoc)
 	struct dp_consistent_prealloc_unaligned *up;
 	qdf_device_t qdf_ctx = cds_get_context(QDF_MODULE_ID_QDF_DEVICE);
 	struct wlan_dp_prealloc_cfg cfg;
+	int64_t reclaimed = 0;
 
 	if (!qdf_ctx || !ctrl_psoc) {
 		QDF_BUG(0);
@@ -817,8 +1124,16 @@ QDF_STATUS dp_prealloc_init(struct cdp_ctrl_objmgr_psoc *ctrl_psoc)
 	/*Context pre-alloc*/
 	for (i = 0; i < QDF_ARRAY_SIZE(g_dp_context_allocs); i++) {
 		cp = &g_dp_context_allocs[i];
+		cp->size = dp_prealloc_default_size(&cp->usage, cp->size);
 		dp_update_mem_size_by_ctx_type(&cfg, cp->ctxt_type,
 					       &cp->size);
+		if (!cp->is_critical)
+			cp->size = dp_prealloc_profile_size(&cp->usage,
+							    cp->size, 1,
+							    &reclaimed);
+		if (!cp->size)
+			continue;
+
 		cp->addr = qdf_mem_malloc(cp->size);
 
 		if (qdf_unlikely(!cp->addr) && cp->is_critical) {
@@ -836,7 +1151,13 @@ QDF_STATUS dp_prealloc_init(struct cdp_ctrl_objmgr_psoc *ctrl_psoc)
 	for (i = 0; i < QDF_ARRAY_SIZE(g_dp_consistent_allocs); i++) {
 		p = &g_dp_consistent_allocs[i];
 		p->in_use = 0;
+		p->size = dp_prealloc_default_size(&p->usage, p->size);
 		dp_update_mem_size_by_ring_type(&cfg, p->ring_type, &p->size);
+		p->size = dp_prealloc_profile_size(&p->usage, p->size, 1,
+						   &reclaimed);
+		if (!p->size)
+			continue;
+
 		p->va_aligned =
 			qdf_aligned_mem_alloc_consistent(qdf_ctx,
 							 &p->size,
@@ -861,8 +1182,17 @@ QDF_STATUS dp_prealloc_init(struct cdp_ctrl_objmgr_psoc *ctrl_psoc)
 	for (i = 0; i < QDF_ARRAY_SIZE(g_dp_multi_page_allocs); i++) {
 		mp = &g_dp_multi_page_allocs[i];
 		mp->in_use = false;
+		mp->element_num = dp_prealloc_default_size(&mp->usage,
+							   mp->element_num);
 		dp_update_num_elements_by_desc_type(&cfg, mp->desc_type,
 						    &mp->element_num);
+		mp->element_num = dp_prealloc_profile_size(&mp->usage,
+							   mp->element_num,
+							   mp->element_size,
+							   &reclaimed);
+		if (!mp->element_num)
+			continue;
+
 		if (mp->cacheable)
 			mp->pages.page_size = DP_BLOCKMEM_SIZE;
 
@@ -891,6 +1221,12 @@ QDF_STATUS dp_prealloc_init(struct cdp_ctrl_objmgr_psoc *ctrl_psoc)
 	for (i = 0; i < QDF_ARRAY_SIZE(g_dp_consistent_unaligned_allocs); i++) {
 		up = &g_dp_consistent_unaligned_allocs[i];
 		up->in_use = 0;
+		/* CE rings are matched by exact size, only skip unused ones */
+		if (dp_prealloc_profile_unused(&up->usage)) {
+			reclaimed += up->size;
+			continue;
+		}
+
 		up->va_unaligned = qdf_mem_alloc_consistent(qdf_ctx,
 							    qdf_ctx->dev,
 							    up->size,
@@ -914,6 +1250,11 @@ QDF_STATUS dp_prealloc_init(struct cdp_ctrl_objmgr_psoc *ctrl_psoc)
 		goto deinit;
 	}
 
+	g_dp_prealloc_active = true;
+	if (g_dp_prealloc_profiled_loads)
+		dp_info("pre-alloc sized from %u profiled loads, %lld bytes reclaimed",
+			g_dp_prealloc_profiled_loads, reclaimed);
+
 	return QDF_STATUS_SUCCESS;
 deinit:
 	dp_prealloc_deinit();
@@ -931,10 +1272,20 @@ void *dp_prealloc_get_context_memory(uint32_t ctxt_type, qdf_size_t ctxt_size)
 		if ((ctxt_type == cp->ctxt_type) && !cp->in_use &&
 		    cp->addr && ctxt_size <= cp->size) {
 			cp->in_use = true;
+			dp_prealloc_usage_hit(&cp->usage, ctxt_size);
 			return cp->addr;
 		}
 	}
 
+	cp = NULL;
+	for (i = 0; i < QDF_ARRAY_SIZE(g_dp_context_allocs); i++) {
+		if (ctxt_type == g_dp_context_allocs[i].ctxt_type &&
+		    (!cp || g_dp_context_allocs[i].size > cp->size))
+			cp = &g_dp_context_allocs[i];
+	}
+	if (cp)
+		dp_prealloc_usage_miss(&cp->usage, ctxt_size);
+
 	return NULL;
 }
 
@@ -967,13 +1318,18 @@ void *dp_prealloc_get_coherent(uint32_t *size, void **base_vaddr_unaligned,
 {
 	int i;
 	struct dp_consistent_prealloc *p;
+	struct dp_consistent_prealloc *max_p = NULL;
 	void *va_aligned = NULL;
 
 	for (i = 0; i < QDF_ARRAY_SIZE(g_dp_consistent_allocs); i++) {
 		p = &g_dp_consistent_allocs[i];
+		if (p->ring_type == ring_type &&
+		    (!max_p || p->size > max_p->size))
+			max_p = p;
 		if (p->ring_type == ring_type && !p->in_use &&
 		    p->va_unaligned && *size <= p->size) {
 			p->in_use = 1;
+			dp_prealloc_usage_hit(&p->usage, *size);
 			*base_vaddr_unaligned = p->va_unaligned;
 			*paddr_unaligned = p->pa_unaligned;
 			*paddr_aligned = p->pa_aligned;
@@ -986,10 +1342,13 @@ void *dp_prealloc_get_coherent(uint32_t *size, void **base_vaddr_unaligned,
 		}
 	}
 
-	if (i == QDF_ARRAY_SIZE(g_dp_consistent_allocs))
+	if (i == QDF_ARRAY_SIZE(g_dp_consistent_allocs)) {
 		dp_info("unable to allocate memory for ring type %s (%d) size %d",
 			dp_srng_get_str_from_hal_ring_type(ring_type),
 			ring_type, *size);
+		if (max_p)
+			dp_prealloc_usage_miss(&max_p->usage, *size);
+	}
 	return va_aligned;
 }
 
@@ -1021,15 +1380,22 @@ void dp_prealloc_get_multi_pages(uint32_t desc_type,
 {
 	int i;
 	struct dp_multi_page_prealloc *mp;
+	struct dp_multi_page_prealloc *max_mp = NULL;
 
 	for (i = 0; i < QDF_ARRAY_SIZE(g_dp_multi_page_allocs); i++) {
 		mp = &g_dp_multi_page_allocs[i];
 
+		if (desc_type == mp->desc_type &&
+		    element_size == mp->element_size &&
+		    (!max_mp || mp->element_num > max_mp->element_num))
+			max_mp = mp;
+
 		if (desc_type == mp->desc_type && !mp->in_use &&
 		    mp->pages.num_pages && element_size == mp->element_size &&
 		    element_num <= mp->element_num) {
 			mp->in_use = true;
 			*pages = mp->pages;
+			dp_prealloc_usage_hit(&mp->usage, element_num);
 
 			dp_info("i %d: desc_type %d cacheable_pages %pK dma_pages %pK num_pages %d",
 				i, desc_type,
@@ -1039,6 +1405,9 @@ void dp_prealloc_get_multi_pages(uint32_t desc_type,
 			break;
 		}
 	}
+
+	if (i == QDF_ARRAY_SIZE(g_dp_multi_page_allocs) && max_mp)
+		dp_prealloc_usage_miss(&max_mp->usage, element_num);
 }
 
 void dp_prealloc_put_multi_pages(uint32_t desc_type,
@@ -1083,13 +1452,18 @@ void *dp_prealloc_get_consistent_mem_unaligned(qdf_size_t size,
 {
 	int i;
 	struct dp_consistent_prealloc_unaligned *up;
+	struct dp_consistent_prealloc_unaligned *miss_up = NULL;
 
 	for (i = 0; i < QDF_ARRAY_SIZE(g_dp_consistent_unaligned_allocs); i++) {
 		up = &g_dp_consistent_unaligned_allocs[i];
 
+		if (ring_type == up->ring_type && size == up->size)
+			miss_up = up;
+
 		if (ring_type == up->ring_type && size == up->size &&
 		    up->va_unaligned && !up->in_use) {
 			up->in_use = true;
+			dp_prealloc_usage_hit(&up->usage, size);
 			*base_addr = up->pa_unaligned;
 			dp_info("i %d: va unalign %pK pa unalign %pK size %d",
 				i, up->va_unaligned,
@@ -1098,6 +1472,9 @@ void *dp_prealloc_get_consistent_mem_unaligned(qdf_size_t size,
 		}
 	}
 
+	if (miss_up)
+		dp_prealloc_usage_miss(&miss_up->usage, size);
+
 	return NULL;
 }
 
@@ -0,0 +1,458 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: DP data stall root cause correlator implementation
+ */
+
+#include "wlan_dp_stall_corr.h"
+#include "wlan_dp_stats_sampler.h"
+#include "wlan_dp_main.h"
+#include <qdf_mem.h>
+
+/**
+ * struct dp_stall_corr_rule - how a root cause is scored
+ * @required: the cause is only scored if one of this evidence is found
+ * @weight: score each evidence found adds to the cause
+ */
+struct dp_stall_corr_rule {
+	uint32_t required;
+	uint8_t weight[DP_STALL_EV_MAX];
+};
+
+/*
+ * The weights of a cause add up to 100. Evidence shared by several causes,
+ * like frames not being completed, only ranks causes that have their own
+ * evidence as well.
+ */
+static const struct dp_stall_corr_rule dp_stall_corr_rules[] = {
+	[DP_STALL_CAUSE_RX_STARVATION] = {
+		.required = BIT(DP_STALL_EV_RX_COLLAPSED) |
+			    BIT(DP_STALL_EV_RX_REFILL),
+		.weight = {
+			[DP_STALL_EV_RX_COLLAPSED] = 40,
+			[DP_STALL_EV_TX_ACKED] = 30,
+			[DP_STALL_EV_RX_REFILL] = 30,
+		},
+	},
+	[DP_STALL_CAUSE_TX_DESC_EXHAUSTION] = {
+		.required = BIT(DP_STALL_EV_TX_PENDING_STUCK),
+		.weight = {
+			[DP_STALL_EV_TX_PENDING_STUCK] = 40,
+			[DP_STALL_EV_TX_DROPPED] = 40,
+			[DP_STALL_EV_TX_NO_COMPLETION] = 20,
+		},
+	},
+	[DP_STALL_CAUSE_FLOW_PAUSED] = {
+		.required = BIT(DP_STALL_EV_PAUSED_MOST),
+		.weight = {
+			[DP_STALL_EV_PAUSED_MOST] = 50,
+			[DP_STALL_EV_PAUSED_ALL] = 20,
+			[DP_STALL_EV_TX_CALLED_COLLAPSED] = 30,
+		},
+	},
+	[DP_STALL_CAUSE_BUS_BW_DOWNVOTE] = {
+		.required = BIT(DP_STALL_EV_BW_DOWNVOTE),
+		.weight = {
+			[DP_STALL_EV_BW_DOWNVOTE] = 30,
+			[DP_STALL_EV_BW_BEFORE_COLLAPSE] = 40,
+			[DP_STALL_EV_TPUT_COLLAPSED] = 30,
+		},
+	},
+	[DP_STALL_CAUSE_FW] = {
+		.required = BIT(DP_STALL_EV_WMI_STUCK) |
+			    BIT(DP_STALL_EV_FW_TRIGGER),
+		.weight = {
+			[DP_STALL_EV_WMI_STUCK] = 40,
+			[DP_STALL_EV_TX_NO_COMPLETION] = 30,
+			[DP_STALL_EV_FW_TRIGGER] = 30,
+		},
+	},
+};
+
+static const char * const dp_stall_corr_cause_names[] = {
+	[DP_STALL_CAUSE_RX_STARVATION] = "rx_starvation",
+	[DP_STALL_CAUSE_TX_DESC_EXHAUSTION] = "tx_desc_exhaustion",
+	[DP_STALL_CAUSE_FLOW_PAUSED] = "flow_paused",
+	[DP_STALL_CAUSE_BUS_BW_DOWNVOTE] = "bus_bw_downvote",
+	[DP_STALL_CAUSE_FW] = "firmware",
+};
+
+static const char * const dp_stall_corr_evidence_names[] = {
+	[DP_STALL_EV_RX_COLLAPSED] = "rx_collapsed",
+	[DP_STALL_EV_TX_ACKED] = "tx_acked",
+	[DP_STALL_EV_RX_REFILL] = "rx_refill_failed",
+	[DP_STALL_EV_TX_PENDING_STUCK] = "tx_pending_stuck",
+	[DP_STALL_EV_TX_NO_COMPLETION] = "tx_no_completion",
+	[DP_STALL_EV_TX_DROPPED] = "tx_dropped",
+	[DP_STALL_EV_PAUSED_MOST] = "paused_most",
+	[DP_STALL_EV_PAUSED_ALL] = "paused_all",
+	[DP_STALL_EV_TX_CALLED_COLLAPSED] = "tx_called_collapsed",
+	[DP_STALL_EV_BW_DOWNVOTE] = "bw_downvote",
+	[DP_STALL_EV_BW_BEFORE_COLLAPSE] = "bw_before_collapse",
+	[DP_STALL_EV_TPUT_COLLAPSED] = "tput_collapsed",
+	[DP_STALL_EV_WMI_STUCK] = "wmi_stuck",
+	[DP_STALL_EV_FW_TRIGGER] = "fw_trigger",
+};
+
+static const char * const dp_stall_corr_trigger_names[] = {
+	[DP_STALL_TRIGGER_NUD] = "nud",
+	[DP_STALL_TRIGGER_HOST] = "host",
+	[DP_STALL_TRIGGER_FW] = "fw",
+	[DP_STALL_TRIGGER_FW_RX_REFILL] = "fw_rx_refill",
+};
+
+/**
+ * dp_stall_corr_window_add() - add a sample to a window
+ * @win: window
+ * @sample: sample
+ *
+ * Return: None
+ */
+static void dp_stall_corr_window_add(struct dp_stall_corr_window *win,
+				     const struct dp_stats_sample *sample)
+{
+	if (!win->num_samples) {
+		win->bw_min = sample->bus_bw_level;
+		win->bw_max = sample->bus_bw_level;
+		win->tx_pending_first = sample->tx_pending;
+		win->tx_pending_min = sample->tx_pending;
+		win->wmi_pending_first = sample->wmi_pending;
+		win->wmi_pending_min = sample->wmi_pending;
+	}
+
+	win->num_samples++;
+	win->duration_ms += sample->interval_ms;
+	win->tx_called += sample->tx_called;
+	win->tx_dropped += sample->tx_dropped;
+	win->tx_acked += sample->tx_acked;
+	win->rx_packets += sample->rx_packets;
+	if (sample->pause_map)
+		win->num_paused++;
+	win->bw_min = qdf_min(win->bw_min, sample->bus_bw_level);
+	win->bw_max = qdf_max(win->bw_max, sample->bus_bw_level);
+	win->tx_pending_min = qdf_min(win->tx_pending_min, sample->tx_pending);
+	win->tx_pending_last = sample->tx_pending;
+	win->wmi_pending_min = qdf_min(win->wmi_pending_min,
+				       sample->wmi_pending);
+	win->wmi_pending_last = sample->wmi_pending;
+}
+
+/**
+ * dp_stall_corr_collapsed() - check if traffic collapsed against a baseline
+ * @pkts: packets counted
+ * @ms: time @pkts were counted over
+ * @base_pkts: baseline packets
+ * @base_ms: time @base_pkts were counted over
+ *
+ * Return: true if the packet rate fell below 1/DP_STALL_CORR_COLLAPSE_RATIO
+ *	   of a baseline with enough traffic to tell
+ */
+static bool dp_stall_corr_collapsed(uint32_t pkts, uint32_t ms,
+				    uint32_t base_pkts, uint32_t base_ms)
+{
+	if (base_pkts < DP_STALL_CORR_MIN_PKTS || !base_ms || !ms)
+		return false;
+
+	return (uint64_t)pkts * base_ms * DP_STALL_CORR_COLLAPSE_RATIO <
+	       (uint64_t)base_pkts * ms;
+}
+
+/**
+ * dp_stall_corr_bw_before_collapse() - check if the bus bandwidth vote was
+ *	already down when the traffic collapsed
+ * @samples: history, oldest first
+ * @num: number of samples
+ * @tail_start: first sample of the tail
+ * @base: baseline window
+ *
+ * The bus bandwidth work votes down after traffic drops, so a vote that is
+ * lowered only after the collapse is a consequence rather than a cause.
+ *
+ * Return: true if the vote in effect when the traffic collapsed was below
+ *	   the baseline peak
+ */
+static bool
+dp_stall_corr_bw_before_collapse(const struct dp_stats_sample *samples,
+				 uint32_t num, uint32_t tail_start,
+				 const struct dp_stall_corr_window *base)
+{
+	uint32_t base_pkts = base->tx_called + base->rx_packets;
+	uint32_t c = num;
+
+	while (c > tail_start &&
+	       dp_stall_corr_collapsed(samples[c - 1].tx_called +
+				       samples[c - 1].rx_packets,
+				       samples[c - 1].interval_ms,
+				       base_pkts, base->duration_ms))
+		c--;
+
+	if (c == num || !c)
+		return false;
+
+	/* the vote read at the end of the last interval before the collapse */
+	return samples[c - 1].bus_bw_level < base->bw_max;
+}
+
+/**
+ * dp_stall_corr_find_evidence() - find the evidence in the windows
+ * @verdict: verdict with the windows filled
+ * @samples: history, oldest first
+ * @num: number of samples
+ * @tail_start: first sample of the tail
+ *
+ * Return: bitmap of enum dp_stall_evidence found
+ */
+static uint32_t
+dp_stall_corr_find_evidence(struct dp_stall_verdict *verdict,
+			    const struct dp_stats_sample *samples,
+			    uint32_t num, uint32_t tail_start)
+{
+	struct dp_stall_corr_window *base = &verdict->base;
+	struct dp_stall_corr_window *tail = &verdict->tail;
+	uint32_t ev = 0;
+
+	if (dp_stall_corr_collapsed(tail->rx_packets, tail->duration_ms,
+				    base->rx_packets, base->duration_ms))
+		ev |= BIT(DP_STALL_EV_RX_COLLAPSED);
+
+	if (tail->tx_acked)
+		ev |= BIT(DP_STALL_EV_TX_ACKED);
+
+	if (tail->tx_pending_min &&
+	    tail->tx_pending_last >= tail->tx_pending_first)
+		ev |= BIT(DP_STALL_EV_TX_PENDING_STUCK);
+
+	if (tail->tx_called && !tail->tx_acked)
+		ev |= BIT(DP_STALL_EV_TX_NO_COMPLETION);
+
+	if (tail->tx_dropped)
+		ev |= BIT(DP_STALL_EV_TX_DROPPED);
+
+	if (tail->num_paused * 4 >= tail->num_samples * 3) {
+		ev |= BIT(DP_STALL_EV_PAUSED_MOST);
+		if (tail->num_paused == tail->num_samples)
+			ev |= BIT(DP_STALL_EV_PAUSED_ALL);
+	}
+
+	if (dp_stall_corr_collapsed(tail->tx_called, tail->duration_ms,
+				    base->tx_called, base->duration_ms))
+		ev |= BIT(DP_STALL_EV_TX_CALLED_COLLAPSED);
+
+	if (dp_stall_corr_collapsed(tail->tx_called + tail->rx_packets,
+				    tail->duration_ms,
+				    base->tx_called + base->rx_packets,
+				    base->duration_ms))
+		ev |= BIT(DP_STALL_EV_TPUT_COLLAPSED);
+
+	if (base->num_samples && tail->bw_min < base->bw_max) {
+		ev |= BIT(DP_STALL_EV_BW_DOWNVOTE);
+		if (dp_stall_corr_bw_before_collapse(samples, num, tail_start,
+						     base))
+			ev |= BIT(DP_STALL_EV_BW_BEFORE_COLLAPSE);
+	}
+
+	if (tail->wmi_pending_min &&
+	    tail->wmi_pending_last >= tail->wmi_pending_first)
+		ev |= BIT(DP_STALL_EV_WMI_STUCK);
+
+	return ev;
+}
+
+/**
+ * dp_stall_corr_rank() - score the causes and rank them
+ * @verdict: verdict with the evidence filled
+ *
+ * Return: None
+ */
+static void dp_stall_corr_rank(struct dp_stall_verdict *verdict)
+{
+	const struct dp_stall_corr_rule *rule;
+	struct dp_stall_cause_score cur;
+	uint32_t cause, ev, i;
+
+	for (cause = 0; cause < DP_STALL_CAUSE_MAX; cause++) {
+		rule = &dp_stall_corr_rules[cause];
+		if (!(verdict->evidence & rule->required))
+			continue;
+
+		cur.cause = cause;
+		cur.score = 0;
+		cur.evidence = 0;
+		for (ev = 0; ev < DP_STALL_EV_MAX; ev++) {
+			if (!rule->weight[ev] || !(verdict->evidence & BIT(ev)))
+				continue;
+
+			cur.score += rule->weight[ev];
+			cur.evidence |= BIT(ev);
+		}
+
+		/* insertion sort, ties keep the order of enum dp_stall_cause */
+		i = verdict->num_causes++;
+		while (i && verdict->ranked[i - 1].score < cur.score) {
+			verdict->ranked[i] = verdict->ranked[i - 1];
+			i--;
+		}
+		verdict->ranked[i] = cur;
+	}
+}
+
+void dp_stall_corr_evaluate(const struct dp_stats_snapshot_intf *rec,
+			    enum dp_stall_trigger trigger,
+			    struct dp_stall_verdict *verdict)
+{
+	const struct dp_stats_sample *samples = rec->samples;
+	uint32_t num = qdf_min((uint32_t)rec->num_samples,
+			       (uint32_t)DP_STATS_SAMPLER_HIST_LEN);
+	uint32_t tail_start, i;
+
+	qdf_mem_zero(verdict, sizeof(*verdict));
+	verdict->trigger = trigger;
+
+	if (trigger == DP_STALL_TRIGGER_FW)
+		verdict->evidence |= BIT(DP_STALL_EV_FW_TRIGGER);
+	else if (trigger == DP_STALL_TRIGGER_FW_RX_REFILL)
+		verdict->evidence |= BIT(DP_STALL_EV_RX_REFILL);
+
+	if (num) {
+		tail_start = num - 1;
+		while (tail_start &&
+		       samples[num - 1].timestamp_ms -
+		       samples[tail_start - 1].timestamp_ms <
+		       DP_STALL_CORR_TAIL_MS)
+			tail_start--;
+
+		for (i = 0; i < tail_start; i++)
+			dp_stall_corr_window_add(&verdict->base, &samples[i]);
+		for (; i < num; i++)
+			dp_stall_corr_window_add(&verdict->tail, &samples[i]);
+
+		verdict->evidence |=
+			dp_stall_corr_find_evidence(verdict, samples, num,
+						    tail_start);
+	}
+
+	dp_stall_corr_rank(verdict);
+}
+
+/**
+ * dp_stall_corr_log() - log a verdict
+ * @dp_intf: DP interface the verdict is on
+ * @verdict: verdict
+ *
+ * Return: None
+ */
+static void dp_stall_corr_log(struct wlan_dp_intf *dp_intf,
+			      struct dp_stall_verdict *verdict)
+{
+	struct dp_stall_corr_window *base = &verdict->base;
+	struct dp_stall_corr_window *tail = &verdict->tail;
+	struct dp_stall_cause_score *cs;
+	uint32_t i, ev;
+
+	dp_info("data stall on " QDF_MAC_ADDR_FMT " trigger %s: %u causes, evidence 0x%x",
+		QDF_MAC_ADDR_REF(dp_intf->mac_addr.bytes),
+		dp_stall_corr_trigger_names[verdict->trigger],
+		verdict->num_causes, verdict->evidence);
+	dp_info("base %u samples %u ms: tx %u dropped %u acked %u rx %u paused %u bw %u-%u",
+		base->num_samples, base->duration_ms, base->tx_called,
+		base->tx_dropped, base->tx_acked, base->rx_packets,
+		base->num_paused, base->bw_min, base->bw_max);
+	dp_info("tail %u samples %u ms: tx %u dropped %u acked %u rx %u paused %u bw %u-%u tx_pending %u/%u/%u wmi_pending %u/%u/%u",
+		tail->num_samples, tail->duration_ms, tail->tx_called,
+		tail->tx_dropped, tail->tx_acked, tail->rx_packets,
+		tail->num_paused, tail->bw_min, tail->bw_max,
+		tail->tx_pending_first, tail->tx_pending_min,
+		tail->tx_pending_last, tail->wmi_pending_first,
+		tail->wmi_pending_min, tail->wmi_pending_last);
+
+	if (!verdict->num_causes) {
+		dp_info("no root cause identified");
+		return;
+	}
+
+	for (i = 0; i < verdict->num_causes; i++) {
+		cs = &verdict->ranked[i];
+		dp_info("#%u %s score %u", i + 1,
+			dp_stall_corr_cause_names[cs->cause], cs->score);
+		for (ev = 0; ev < DP_STALL_EV_MAX; ev++)
+			if (cs->evidence & BIT(ev))
+				dp_info("    %s",
+					dp_stall_corr_evidence_names[ev]);
+	}
+}
+
+void dp_stall_corr_report(struct wlan_dp_intf *dp_intf,
+			  enum dp_stall_trigger trigger)
+{
+	struct dp_stats_snapshot_intf *rec;
+	struct dp_stall_verdict verdict;
+
+	if (trigger >= DP_STALL_TRIGGER_MAX)
+		return;
+
+	rec = qdf_mem_malloc(sizeof(*rec));
+	if (!rec)
+		return;
+
+	dp_stats_sampler_intf_read(dp_intf, rec);
+	dp_stall_corr_evaluate(rec, trigger, &verdict);
+	dp_stall_corr_log(dp_intf, &verdict);
+
+	qdf_mem_free(rec);
+}
+
+/**
+ * dp_stall_corr_intf_stalled() - check if an interface has a stalled vdev
+ * @dp_intf: DP interface
+ * @vdev_id_bitmap: vdevs reported as stalled
+ *
+ * Return: true if one of the links of @dp_intf is in @vdev_id_bitmap
+ */
+static bool dp_stall_corr_intf_stalled(struct wlan_dp_intf *dp_intf,
+				       uint32_t vdev_id_bitmap)
+{
+	struct wlan_dp_link *dp_link;
+	struct wlan_dp_link *dp_link_next;
+
+	dp_for_each_link_held_safe(dp_intf, dp_link, dp_link_next) {
+		if (dp_link->link_id < 32 &&
+		    vdev_id_bitmap & BIT(dp_link->link_id))
+			return true;
+	}
+
+	return false;
+}
+
+void dp_stall_corr_trigger(struct wlan_dp_psoc_context *dp_ctx,
+			   uint32_t vdev_id_bitmap,
+			   enum dp_stall_trigger trigger)
+{
+	struct wlan_dp_intf *dp_intf, *dp_intf_next;
+
+	dp_for_each_intf_held_safe(dp_ctx, dp_intf, dp_intf_next) {
+		if (!dp_intf->num_links)
+			continue;
+
+		if (vdev_id_bitmap &&
+		    !dp_stall_corr_intf_stalled(dp_intf, vdev_id_bitmap))
+			continue;
+
+		dp_stall_corr_report(dp_intf, trigger);
+	}
+}
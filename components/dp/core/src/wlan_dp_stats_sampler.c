@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: DP stats sampler implementation
+ */
+
+#include "wlan_dp_stats_sampler.h"
+#include "wlan_dp_main.h"
+#include "cds_api.h"
+#include <cdp_txrx_cmn.h>
+#include <cdp_txrx_misc.h>
+#include <qdf_mem.h>
+#include <qdf_periodic_work.h>
+#include <qdf_time.h>
+
+/**
+ * dp_stats_sampler_delta() - increase of a counter since the last sample
+ * @cur: current value
+ * @last: value at the last sample
+ *
+ * The counters are cleared on request, in which case everything counted
+ * since the clear is the increase.
+ *
+ * Return: increase of the counter
+ */
+static inline uint32_t dp_stats_sampler_delta(uint32_t cur, uint32_t last)
+{
+	return cur >= last ? cur - last : cur;
+}
+
+void dp_stats_sampler_intf_sample(struct wlan_dp_intf *dp_intf,
+				  uint64_t now_ms,
+				  const struct dp_stats_sampler_input *input)
+{
+	struct dp_stats_sampler_hist *hist = &dp_intf->stats_hist;
+	struct dp_tx_rx_stats *stats = &dp_intf->dp_stats.tx_rx_stats;
+	struct dp_stats_sample total = {0};
+	struct dp_stats_sample *sample;
+	uint32_t head;
+	int i;
+
+	/*
+	 * The per CPU counters are only written by their own CPU, reading
+	 * them here needs no lock and costs the datapath nothing.
+	 */
+	for (i = 0; i < NUM_CPUS; i++) {
+		total.tx_called += stats->per_cpu[i].tx_called;
+		total.tx_dropped += stats->per_cpu[i].tx_dropped;
+		total.tx_orphaned += stats->per_cpu[i].tx_orphaned;
+		total.rx_packets += stats->per_cpu[i].rx_packets;
+		total.rx_dropped += stats->per_cpu[i].rx_dropped;
+		total.rx_delivered += stats->per_cpu[i].rx_delivered;
+		total.rx_refused += stats->per_cpu[i].rx_refused;
+	}
+	total.tx_acked = input->tx_acked;
+
+	if (!hist->last_ms)
+		goto out;
+
+	head = (uint32_t)qdf_atomic_read(&hist->head);
+	sample = &hist->samples[head % DP_STATS_SAMPLER_HIST_LEN];
+	sample->timestamp_ms = now_ms;
+	sample->interval_ms = now_ms - hist->last_ms;
+	sample->tx_called = dp_stats_sampler_delta(total.tx_called,
+						   hist->last.tx_called);
+	sample->tx_dropped = dp_stats_sampler_delta(total.tx_dropped,
+						    hist->last.tx_dropped);
+	sample->tx_orphaned = dp_stats_sampler_delta(total.tx_orphaned,
+						     hist->last.tx_orphaned);
+	sample->rx_packets = dp_stats_sampler_delta(total.rx_packets,
+						    hist->last.rx_packets);
+	sample->rx_dropped = dp_stats_sampler_delta(total.rx_dropped,
+						    hist->last.rx_dropped);
+	sample->rx_delivered = dp_stats_sampler_delta(total.rx_delivered,
+						      hist->last.rx_delivered);
+	sample->rx_refused = dp_stats_sampler_delta(total.rx_refused,
+						    hist->last.rx_refused);
+	sample->bus_bw_level = dp_intf->dp_ctx->cur_vote_level;
+	sample->tx_acked = dp_stats_sampler_delta(total.tx_acked,
+						  hist->last.tx_acked);
+	sample->tx_pending = input->tx_pending;
+	sample->wmi_pending = input->wmi_pending;
+	sample->pause_map = input->pause_map;
+
+	/* the sample must be complete before readers can see it */
+	qdf_mb();
+	qdf_atomic_set(&hist->head, head + 1);
+
+out:
+	hist->last = total;
+	hist->last_ms = now_ms;
+}
+
+uint32_t dp_stats_sampler_intf_read(struct wlan_dp_intf *dp_intf,
+				    struct dp_stats_snapshot_intf *rec)
+{
+	struct dp_stats_sampler_hist *hist = &dp_intf->stats_hist;
+	uint32_t head, end, first, stable, num, i;
+
+	qdf_mem_copy(rec->mac_addr, dp_intf->mac_addr.bytes,
+		     QDF_MAC_ADDR_SIZE);
+	rec->device_mode = dp_intf->device_mode;
+
+	head = (uint32_t)qdf_atomic_read(&hist->head);
+	qdf_mb();
+
+	first = head > DP_STATS_SAMPLER_HIST_LEN ?
+		head - DP_STATS_SAMPLER_HIST_LEN : 0;
+	for (i = first; i != head; i++)
+		rec->samples[i - first] =
+			hist->samples[i % DP_STATS_SAMPLER_HIST_LEN];
+
+	qdf_mb();
+	end = (uint32_t)qdf_atomic_read(&hist->head);
+
+	/*
+	 * While the copy above ran, the sampler published the samples up to
+	 * end - 1 and may have been writing sample end, which reuses the
+	 * slot of sample end - DP_STATS_SAMPLER_HIST_LEN. Only the copied
+	 * samples after that one are intact.
+	 */
+	stable = end >= DP_STATS_SAMPLER_HIST_LEN ?
+		 end - DP_STATS_SAMPLER_HIST_LEN + 1 : 0;
+	if (stable > head)
+		stable = head;
+
+	num = head - first;
+	if (stable > first) {
+		num -= stable - first;
+		qdf_mem_move(rec->samples, &rec->samples[stable - first],
+			     num * sizeof(rec->samples[0]));
+	}
+
+	rec->num_samples = num;
+	rec->seq_end = head;
+
+	return num;
+}
+
+QDF_STATUS dp_stats_sampler_snapshot(struct wlan_dp_psoc_context *dp_ctx,
+				     dp_stats_snapshot_cb cb, void *cb_ctx)
+{
+	struct wlan_dp_intf *dp_intf, *dp_intf_next;
+	struct dp_stats_snapshot_intf *rec;
+	struct dp_stats_snapshot_hdr hdr = {0};
+
+	if (!dp_ctx || !cb)
+		return QDF_STATUS_E_INVAL;
+
+	rec = qdf_mem_malloc(sizeof(*rec));
+	if (!rec)
+		return QDF_STATUS_E_NOMEM;
+
+	hdr.magic = DP_STATS_SNAPSHOT_MAGIC;
+	hdr.version = DP_STATS_SNAPSHOT_VERSION;
+	hdr.hdr_len = sizeof(hdr);
+	hdr.intf_len = sizeof(*rec);
+	hdr.sample_len = sizeof(rec->samples[0]);
+	hdr.hist_len = DP_STATS_SAMPLER_HIST_LEN;
+	hdr.interval_ms = dp_ctx->dp_cfg.stats_sample_interval;
+	cb(cb_ctx, (uint8_t *)&hdr, sizeof(hdr));
+
+	dp_for_each_intf_held_safe(dp_ctx, dp_intf, dp_intf_next) {
+		qdf_mem_zero(rec, sizeof(*rec));
+		dp_stats_sampler_intf_read(dp_intf, rec);
+		cb(cb_ctx, (uint8_t *)rec, sizeof(*rec));
+	}
+
+	qdf_mem_free(rec);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * dp_stats_sampler_get_tx_acked() - frames acked on the links of an interface
+ * @dp_intf: DP interface
+ *
+ * Return: number of frames acked so far
+ */
+static uint32_t dp_stats_sampler_get_tx_acked(struct wlan_dp_intf *dp_intf)
+{
+	struct cdp_soc_t *soc = dp_intf->dp_ctx->cdp_soc;
+	struct wlan_dp_link *dp_link;
+	struct wlan_dp_link *dp_link_next;
+	uint32_t acked = 0;
+
+	dp_for_each_link_held_safe(dp_intf, dp_link, dp_link_next) {
+		acked += cdp_get_tx_ack_stats(soc, dp_link->link_id);
+	}
+
+	return acked;
+}
+
+/**
+ * __dp_stats_sampler_work_handler() - sample all interfaces
+ * @dp_ctx: DP context
+ *
+ * Return: None
+ */
+static void __dp_stats_sampler_work_handler(struct wlan_dp_psoc_context *dp_ctx)
+{
+	struct wlan_dp_psoc_callbacks *cb = &dp_ctx->dp_ops;
+	struct wlan_dp_intf *dp_intf, *dp_intf_next;
+	struct dp_stats_sampler_input input = {0};
+	cdp_config_param_type val = {0};
+	uint64_t now_ms;
+
+	if (dp_ctx->is_suspend)
+		return;
+
+	now_ms = qdf_get_system_timestamp();
+
+	if (QDF_IS_STATUS_SUCCESS(cdp_txrx_get_pdev_param(dp_ctx->cdp_soc,
+							  OL_TXRX_PDEV_ID,
+							  CDP_TX_PENDING,
+							  &val)))
+		input.tx_pending = val.cdp_pdev_param_tx_pending;
+
+	if (dp_ctx->sb_ops.dp_get_pending_wmi_cmds)
+		input.wmi_pending =
+			dp_ctx->sb_ops.dp_get_pending_wmi_cmds(dp_ctx->psoc);
+
+	dp_for_each_intf_held_safe(dp_ctx, dp_intf, dp_intf_next) {
+		if (!dp_intf->num_links)
+			continue;
+
+		input.tx_acked = dp_stats_sampler_get_tx_acked(dp_intf);
+		input.pause_map = cb->dp_get_pause_map ?
+			cb->dp_get_pause_map(cb->callback_ctx, dp_intf->dev) :
+			0;
+		dp_stats_sampler_intf_sample(dp_intf, now_ms, &input);
+	}
+}
+
+/**
+ * dp_stats_sampler_work_handler() - stats sampler work handler
+ * @context: DP context
+ *
+ * Return: None
+ */
+static void dp_stats_sampler_work_handler(void *context)
+{
+	struct wlan_dp_psoc_context *dp_ctx = context;
+	struct qdf_op_sync *op_sync;
+
+	if (qdf_op_protect(&op_sync))
+		return;
+
+	__dp_stats_sampler_work_handler(dp_ctx);
+
+	qdf_op_unprotect(op_sync);
+}
+
+void dp_stats_sampler_init(struct wlan_dp_psoc_context *dp_ctx)
+{
+	if (QDF_GLOBAL_FTM_MODE == cds_get_conparam())
+		return;
+
+	if (QDF_IS_STATUS_ERROR(qdf_periodic_work_create(
+					&dp_ctx->stats_sampler_work,
+					dp_stats_sampler_work_handler,
+					dp_ctx)))
+		dp_err("Failed to create the stats sampler work");
+}
+
+void dp_stats_sampler_deinit(struct wlan_dp_psoc_context *dp_ctx)
+{
+	if (QDF_GLOBAL_FTM_MODE == cds_get_conparam())
+		return;
+
+	/* expected to be stopped along with the bus bandwidth work */
+	QDF_BUG(!qdf_periodic_work_stop_sync(&dp_ctx->stats_sampler_work));
+	qdf_periodic_work_destroy(&dp_ctx->stats_sampler_work);
+}
+
+void dp_stats_sampler_start(struct wlan_dp_psoc_context *dp_ctx)
+{
+	if (QDF_GLOBAL_FTM_MODE == cds_get_conparam())
+		return;
+
+	if (!dp_ctx->dp_cfg.stats_sample_interval)
+		return;
+
+	qdf_periodic_work_start(&dp_ctx->stats_sampler_work,
+				dp_ctx->dp_cfg.stats_sample_interval);
+}
+
+void dp_stats_sampler_stop(struct wlan_dp_psoc_context *dp_ctx)
+{
+	if (QDF_GLOBAL_FTM_MODE == cds_get_conparam())
+		return;
+
+	qdf_periodic_work_stop_sync(&dp_ctx->stats_sampler_work);
+}
+
+void dp_stats_sampler_intf_init(struct wlan_dp_intf *dp_intf)
+{
+	struct dp_stats_sampler_hist *hist = &dp_intf->stats_hist;
+
+	qdf_mem_zero(hist, sizeof(*hist));
+	qdf_atomic_init(&hist->head);
+}
@@ -135,6 +135,164 @@ static int dp_intf_is_tx_allowed(qdf_nbuf_t nbuf,
 	return false;
 }
 
+#define DP_PKT_ETH_HDR_LEN		14
+#define DP_PKT_IPV4_FRAG_OFFSET		6
+#define DP_PKT_IPV4_FRAG_MASK		0x3fff
+#define DP_PKT_IPV4_FRAG_OFF_MASK	0x1fff
+#define DP_PKT_IPV6_NEXT_HDR_OFFSET	6
+#define DP_PKT_IPV6_HDR_LEN		40
+#define DP_PKT_TCP_MIN_LEN		20
+#define DP_PKT_UDP_HDR_LEN		8
+#define DP_PKT_DNS_FLAGS_OFFSET		2
+#define DP_PKT_DNS_OP_MASK		0xf800
+#define DP_PKT_DNS_STANDARD_RSP		0x8000
+#define DP_PKT_DNS_PORT			53
+#define DP_PKT_DHCP_SERVER_PORT		67
+#define DP_PKT_DHCP_CLIENT_PORT		68
+
+static inline uint16_t dp_pkt_get_be16(uint8_t *p)
+{
+	return (p[0] << 8) | p[1];
+}
+
+/**
+ * dp_pkt_classify_udp() - classify the UDP payload of an IPv4 frame
+ * @data: UDP header
+ * @len: bytes from the UDP header to the end of the frame
+ * @cls: classification to update
+ *
+ * Return: None
+ */
+static inline void dp_pkt_classify_udp(uint8_t *data, uint32_t len,
+				       struct dp_pkt_class *cls)
+{
+	uint16_t sport = dp_pkt_get_be16(data);
+	uint16_t dport = dp_pkt_get_be16(data + 2);
+	uint16_t dns_op;
+
+	if ((sport == DP_PKT_DHCP_SERVER_PORT &&
+	     dport == DP_PKT_DHCP_CLIENT_PORT) ||
+	    (sport == DP_PKT_DHCP_CLIENT_PORT &&
+	     dport == DP_PKT_DHCP_SERVER_PORT)) {
+		cls->flags |= DP_PKT_CLASS_DHCP;
+		return;
+	}
+
+	if ((sport != DP_PKT_DNS_PORT && dport != DP_PKT_DNS_PORT) ||
+	    len < DP_PKT_UDP_HDR_LEN + DP_PKT_DNS_FLAGS_OFFSET + 2)
+		return;
+
+	dns_op = dp_pkt_get_be16(data + DP_PKT_UDP_HDR_LEN +
+				 DP_PKT_DNS_FLAGS_OFFSET) & DP_PKT_DNS_OP_MASK;
+	if (dport == DP_PKT_DNS_PORT && !dns_op)
+		cls->flags |= DP_PKT_CLASS_DNS_QUERY;
+	else if (sport == DP_PKT_DNS_PORT && dns_op == DP_PKT_DNS_STANDARD_RSP)
+		cls->flags |= DP_PKT_CLASS_DNS_RSP;
+}
+
+/**
+ * dp_pkt_classify_ipv4() - classify an IPv4 frame
+ * @data: frame, starting with the ethernet header
+ * @len: frame length
+ * @cls: classification to update
+ *
+ * Return: None
+ */
+static inline void dp_pkt_classify_ipv4(uint8_t *data, uint32_t len,
+					struct dp_pkt_class *cls)
+{
+	uint8_t *ip = data + QDF_NBUF_TRAC_IPV4_OFFSET;
+	uint8_t *l4;
+	uint32_t l4_off;
+	uint16_t frag;
+	uint8_t proto;
+
+	if (len < QDF_NBUF_TRAC_IPV4_OFFSET + QDF_NBUF_TRAC_IPV4_HEADER_SIZE)
+		return;
+
+	cls->flags |= DP_PKT_CLASS_IPV4;
+	qdf_mem_copy(&cls->src_ip, data + QDF_NBUF_TRAC_IPV4_SRC_ADDR_OFFSET,
+		     sizeof(cls->src_ip));
+	qdf_mem_copy(&cls->dst_ip, data + QDF_NBUF_TRAC_IPV4_DEST_ADDR_OFFSET,
+		     sizeof(cls->dst_ip));
+
+	frag = dp_pkt_get_be16(ip + DP_PKT_IPV4_FRAG_OFFSET);
+	if (frag & DP_PKT_IPV4_FRAG_MASK) {
+		cls->flags |= DP_PKT_CLASS_IPV4_FRAG;
+		if (frag & DP_PKT_IPV4_FRAG_OFF_MASK)
+			return;
+	}
+
+	l4_off = QDF_NBUF_TRAC_IPV4_OFFSET +
+		 ((ip[0] & QDF_NBUF_TRAC_IPV4_HEADER_MASK) << 2);
+	proto = data[QDF_NBUF_TRAC_IPV4_PROTO_TYPE_OFFSET];
+	l4 = data + l4_off;
+
+	switch (proto) {
+	case QDF_NBUF_TRAC_ICMP_TYPE:
+		if (len <= l4_off)
+			return;
+		cls->flags |= DP_PKT_CLASS_ICMP;
+		cls->l4_op = l4[0];
+		break;
+	case QDF_NBUF_TRAC_TCP_TYPE:
+		if (len < l4_off + DP_PKT_TCP_MIN_LEN)
+			return;
+		cls->flags |= DP_PKT_CLASS_TCP;
+		qdf_mem_copy(&cls->src_port, l4 + QDF_NBUF_TRAC_TCP_SPORT_OFFSET,
+			     sizeof(cls->src_port));
+		qdf_mem_copy(&cls->dst_port, l4 + QDF_NBUF_TRAC_TCP_DPORT_OFFSET,
+			     sizeof(cls->dst_port));
+		cls->l4_op = l4[QDF_NBUF_TRAC_TCP_FLAGS_OFFSET];
+		break;
+	case QDF_NBUF_TRAC_UDP_TYPE:
+		if (len < l4_off + DP_PKT_UDP_HDR_LEN)
+			return;
+		cls->flags |= DP_PKT_CLASS_UDP;
+		qdf_mem_copy(&cls->src_port, l4, sizeof(cls->src_port));
+		qdf_mem_copy(&cls->dst_port, l4 + 2, sizeof(cls->dst_port));
+		dp_pkt_classify_udp(l4, len - l4_off, cls);
+		break;
+	default:
+		break;
+	}
+}
+
+void dp_pkt_classify_data(uint8_t *data, uint32_t len,
+			  struct dp_pkt_class *cls)
+{
+	uint32_t l4_off = DP_PKT_ETH_HDR_LEN + DP_PKT_IPV6_HDR_LEN;
+
+	qdf_mem_zero(cls, sizeof(*cls));
+
+	if (len < DP_PKT_ETH_HDR_LEN)
+		return;
+
+	switch (dp_pkt_get_be16(data + QDF_NBUF_TRAC_ETH_TYPE_OFFSET)) {
+	case QDF_NBUF_TRAC_IPV4_ETH_TYPE:
+		dp_pkt_classify_ipv4(data, len, cls);
+		break;
+	case QDF_NBUF_TRAC_IPV6_ETH_TYPE:
+		if (len < l4_off)
+			return;
+		cls->flags |= DP_PKT_CLASS_IPV6;
+		if (data[DP_PKT_ETH_HDR_LEN + DP_PKT_IPV6_NEXT_HDR_OFFSET] ==
+		    QDF_NBUF_TRAC_ICMPV6_TYPE && len > l4_off) {
+			cls->flags |= DP_PKT_CLASS_ICMPV6;
+			cls->l4_op = data[l4_off];
+		}
+		break;
+	case QDF_NBUF_TRAC_ARP_ETH_TYPE:
+		cls->flags |= DP_PKT_CLASS_ARP;
+		break;
+	case QDF_NBUF_TRAC_EAPOL_ETH_TYPE:
+		cls->flags |= DP_PKT_CLASS_EAPOL;
+		break;
+	default:
+		break;
+	}
+}
+
 /**
  * dp_tx_rx_is_dns_domain_name_match() - function to check whether dns
  * domain name in the received nbuf matches with the tracking dns domain
@@ -205,13 +363,25 @@ void dp_reset_all_intfs_connectivity_stats(struct wlan_dp_psoc_context *dp_ctx)
 	qdf_spin_unlock_bh(&dp_ctx->intf_list_lock);
 }
 
-void
-dp_tx_rx_collect_connectivity_stats_info(qdf_nbuf_t nbuf, void *context,
-		enum connectivity_stats_pkt_status action, uint8_t *pkt_type)
+/**
+ * __dp_tx_rx_collect_connectivity_stats_info() - collect connectivity stats
+ * @nbuf: pointer to n/w buffer
+ * @dp_link: DP link the frame is sent or received on
+ * @action: action done on pkt.
+ * @pkt_type: data pkt type
+ * @cls: classification of @nbuf, or NULL to classify it here if needed
+ *
+ * Return: None
+ */
+static void
+__dp_tx_rx_collect_connectivity_stats_info(qdf_nbuf_t nbuf,
+		struct wlan_dp_link *dp_link,
+		enum connectivity_stats_pkt_status action, uint8_t *pkt_type,
+		const struct dp_pkt_class *cls)
 {
 	uint32_t pkt_type_bitmap;
-	struct wlan_dp_link *dp_link = (struct wlan_dp_link *)context;
 	struct wlan_dp_intf *dp_intf = dp_link->dp_intf;
+	struct dp_pkt_class nbuf_cls;
 
 	/* ARP tracking is done already. */
 	pkt_type_bitmap = dp_intf->pkt_type_bitmap;
@@ -221,13 +391,19 @@ dp_tx_rx_collect_connectivity_stats_info(qdf_nbuf_t nbuf, void *context,
 	if (!pkt_type_bitmap)
 		return;
 
+	if (!cls && (action == PKT_TYPE_REQ ||
+		     action == PKT_TYPE_TX_HOST_FW_SENT ||
+		     action == PKT_TYPE_RSP)) {
+		dp_pkt_classify(nbuf, &nbuf_cls);
+		cls = &nbuf_cls;
+	}
+
 	switch (action) {
 	case PKT_TYPE_REQ:
 	case PKT_TYPE_TX_HOST_FW_SENT:
-		if (qdf_nbuf_is_icmp_pkt(nbuf)) {
-			if (qdf_nbuf_data_is_icmpv4_req(nbuf) &&
-			    dp_intf->track_dest_ipv4 ==
-			    qdf_nbuf_get_icmpv4_tgt_ip(nbuf)) {
+		if (cls->flags & DP_PKT_CLASS_ICMP) {
+			if (cls->l4_op == DP_PKT_ICMP_ECHO_REQ &&
+			    dp_intf->track_dest_ipv4 == cls->dst_ip) {
 				*pkt_type = DP_CONNECTIVITY_CHECK_SET_ICMPV4;
 				if (action == PKT_TYPE_REQ) {
 					++dp_intf->dp_stats.icmpv4_stats.
@@ -238,10 +414,9 @@ dp_tx_rx_collect_connectivity_stats_info(qdf_nbuf_t nbuf, void *context,
 					++dp_intf->dp_stats.icmpv4_stats.
 						tx_host_fw_sent;
 			}
-		} else if (qdf_nbuf_is_ipv4_tcp_pkt(nbuf)) {
-			if (qdf_nbuf_data_is_tcp_syn(nbuf) &&
-			    dp_intf->track_dest_port ==
-			    qdf_nbuf_data_get_tcp_dst_port(nbuf)) {
+		} else if (cls->flags & DP_PKT_CLASS_TCP) {
+			if (cls->l4_op == DP_PKT_TCP_SYN &&
+			    dp_intf->track_dest_port == cls->dst_port) {
 				*pkt_type = DP_CONNECTIVITY_CHECK_SET_TCP_SYN;
 				if (action == PKT_TYPE_REQ) {
 					++dp_intf->dp_stats.tcp_stats.
@@ -255,9 +430,8 @@ dp_tx_rx_collect_connectivity_stats_info(qdf_nbuf_t nbuf, void *context,
 			} else if ((dp_intf->dp_stats.tcp_stats.
 				    is_tcp_syn_ack_rcv || dp_intf->dp_stats.
 					tcp_stats.is_tcp_ack_sent) &&
-				   qdf_nbuf_data_is_tcp_ack(nbuf) &&
-				   (dp_intf->track_dest_port ==
-				    qdf_nbuf_data_get_tcp_dst_port(nbuf))) {
+				   cls->l4_op == DP_PKT_TCP_ACK &&
+				   dp_intf->track_dest_port == cls->dst_port) {
 				*pkt_type = DP_CONNECTIVITY_CHECK_SET_TCP_ACK;
 				if (action == PKT_TYPE_REQ &&
 					dp_intf->dp_stats.tcp_stats.
@@ -279,8 +453,8 @@ dp_tx_rx_collect_connectivity_stats_info(qdf_nbuf_t nbuf, void *context,
 							is_tcp_ack_sent = false;
 				}
 			}
-		} else if (qdf_nbuf_is_ipv4_udp_pkt(nbuf)) {
-			if (qdf_nbuf_data_is_dns_query(nbuf) &&
+		} else if (cls->flags & DP_PKT_CLASS_UDP) {
+			if (cls->flags & DP_PKT_CLASS_DNS_QUERY &&
 			    dp_tx_rx_is_dns_domain_name_match(nbuf, dp_intf)) {
 				*pkt_type = DP_CONNECTIVITY_CHECK_SET_DNS;
 				if (action == PKT_TYPE_REQ) {
@@ -296,20 +470,18 @@ dp_tx_rx_collect_connectivity_stats_info(qdf_nbuf_t nbuf, void *context,
 		break;
 
 	case PKT_TYPE_RSP:
-		if (qdf_nbuf_is_icmp_pkt(nbuf)) {
-			if (qdf_nbuf_data_is_icmpv4_rsp(nbuf) &&
-			    (dp_intf->track_dest_ipv4 ==
-					qdf_nbuf_get_icmpv4_src_ip(nbuf))) {
+		if (cls->flags & DP_PKT_CLASS_ICMP) {
+			if (cls->l4_op == DP_PKT_ICMP_ECHO_RSP &&
+			    dp_intf->track_dest_ipv4 == cls->src_ip) {
 				++dp_intf->dp_stats.icmpv4_stats.
 							rx_icmpv4_rsp_count;
 				*pkt_type =
 				DP_CONNECTIVITY_CHECK_SET_ICMPV4;
 				dp_info("ICMPv4 resp packet");
 			}
-		} else if (qdf_nbuf_is_ipv4_tcp_pkt(nbuf)) {
-			if (qdf_nbuf_data_is_tcp_syn_ack(nbuf) &&
-			    (dp_intf->track_dest_port ==
-					qdf_nbuf_data_get_tcp_src_port(nbuf))) {
+		} else if (cls->flags & DP_PKT_CLASS_TCP) {
+			if (cls->l4_op == DP_PKT_TCP_SYN_ACK &&
+			    dp_intf->track_dest_port == cls->src_port) {
 				++dp_intf->dp_stats.tcp_stats.
 							rx_tcp_syn_ack_count;
 				dp_intf->dp_stats.tcp_stats.
@@ -318,8 +490,8 @@ dp_tx_rx_collect_connectivity_stats_info(qdf_nbuf_t nbuf, void *context,
 				DP_CONNECTIVITY_CHECK_SET_TCP_SYN_ACK;
 				dp_info("TCP Syn ack packet");
 			}
-		} else if (qdf_nbuf_is_ipv4_udp_pkt(nbuf)) {
-			if (qdf_nbuf_data_is_dns_response(nbuf) &&
+		} else if (cls->flags & DP_PKT_CLASS_UDP) {
+			if (cls->flags & DP_PKT_CLASS_DNS_RSP &&
 			    dp_tx_rx_is_dns_domain_name_match(nbuf, dp_intf)) {
 				++dp_intf->dp_stats.dns_stats.
 							rx_dns_rsp_count;
@@ -404,6 +576,14 @@ dp_tx_rx_collect_connectivity_stats_info(qdf_nbuf_t nbuf, void *context,
 	}
 }
 
+void
+dp_tx_rx_collect_connectivity_stats_info(qdf_nbuf_t nbuf, void *context,
+		enum connectivity_stats_pkt_status action, uint8_t *pkt_type)
+{
+	__dp_tx_rx_collect_connectivity_stats_info(nbuf, context, action,
+						   pkt_type, NULL);
+}
+
 /**
  * dp_get_transmit_mac_addr() - Get the mac address to validate the xmit
  * @dp_link: DP link handle
@@ -503,6 +683,7 @@ static void dp_fix_broadcast_eapol(struct wlan_dp_link *dp_link,
  *			       to be sent to the FW.
  * @dp_ctx: Global dp context
  * @nbuf: packet to be transmitted
+ * @cls: classification of @nbuf
  *
  * This func sets the "to_fw" flag in the packet context block, if the
  * current packet is an ICMP request packet. This marking is done at a
@@ -512,7 +693,8 @@ static void dp_fix_broadcast_eapol(struct wlan_dp_link *dp_link,
  * Return: none
  */
 static void dp_mark_icmp_req_to_fw(struct wlan_dp_psoc_context *dp_ctx,
-				   qdf_nbuf_t nbuf)
+				   qdf_nbuf_t nbuf,
+				   const struct dp_pkt_class *cls)
 {
 	uint64_t curr_time, time_delta;
 	int time_interval_ms = dp_ctx->dp_cfg.icmp_req_to_fw_mark_interval;
@@ -521,8 +703,10 @@ static void dp_mark_icmp_req_to_fw(struct wlan_dp_psoc_context *dp_ctx,
 	if (!dp_ctx->dp_cfg.icmp_req_to_fw_mark_interval)
 		return;
 
-	if ((qdf_nbuf_get_icmp_subtype(nbuf) != QDF_PROTO_ICMP_REQ) &&
-	    (qdf_nbuf_get_icmpv6_subtype(nbuf) != QDF_PROTO_ICMPV6_REQ))
+	if (!((cls->flags & DP_PKT_CLASS_ICMP &&
+	       cls->l4_op == DP_PKT_ICMP_ECHO_REQ) ||
+	      (cls->flags & DP_PKT_CLASS_ICMPV6 &&
+	       cls->l4_op == DP_PKT_ICMPV6_ECHO_REQ)))
 		return;
 
 	/* Mark all ICMP request to be sent to FW */
@@ -532,8 +716,7 @@ static void dp_mark_icmp_req_to_fw(struct wlan_dp_psoc_context *dp_ctx,
 	/* For fragment IPV4 ICMP frames
 	 * only mark last segment once to FW
 	 */
-	if (qdf_nbuf_is_ipv4_pkt(nbuf) &&
-	    qdf_nbuf_is_ipv4_fragment(nbuf))
+	if (cls->flags & DP_PKT_CLASS_IPV4_FRAG)
 		return;
 
 	curr_time = qdf_get_log_timestamp();
@@ -546,7 +729,8 @@ static void dp_mark_icmp_req_to_fw(struct wlan_dp_psoc_context *dp_ctx,
 }
 #else
 static void dp_mark_icmp_req_to_fw(struct wlan_dp_psoc_context *dp_ctx,
-				   qdf_nbuf_t nbuf)
+				   qdf_nbuf_t nbuf,
+				   const struct dp_pkt_class *cls)
 {
 }
 #endif
@@ -584,6 +768,7 @@ dp_start_xmit(struct wlan_dp_link *dp_link, qdf_nbuf_t nbuf)
 	uint8_t pkt_type;
 	struct qdf_mac_addr mac_addr_tx_allowed = QDF_MAC_ADDR_ZERO_INIT;
 	int cpu = qdf_get_smp_processor_id();
+	struct dp_pkt_class cls = {0};
 
 	stats = &dp_intf->dp_stats.tx_rx_stats;
 	++stats->per_cpu[cpu].tx_called;
@@ -603,6 +788,12 @@ dp_start_xmit(struct wlan_dp_link *dp_link, qdf_nbuf_t nbuf)
 
 	pkt_type = QDF_NBUF_CB_GET_PACKET_TYPE(nbuf);
 
+	/* parse the headers once for ICMP marking and connectivity stats */
+	if (dp_intf->pkt_type_bitmap ||
+	    pkt_type == QDF_NBUF_CB_PACKET_TYPE_ICMP ||
+	    pkt_type == QDF_NBUF_CB_PACKET_TYPE_ICMPv6)
+		dp_pkt_classify(nbuf, &cls);
+
 	if (pkt_type == QDF_NBUF_CB_PACKET_TYPE_ARP) {
 		if (qdf_nbuf_data_is_arp_req(nbuf) &&
 		    (dp_intf->track_arp_ip == qdf_nbuf_get_arp_tgt_ip(nbuf))) {
@@ -630,16 +821,16 @@ dp_start_xmit(struct wlan_dp_link *dp_link, qdf_nbuf_t nbuf)
 		}
 	} else if ((pkt_type == QDF_NBUF_CB_PACKET_TYPE_ICMP) ||
 		   (pkt_type == QDF_NBUF_CB_PACKET_TYPE_ICMPv6)) {
-		dp_mark_icmp_req_to_fw(dp_ctx, nbuf);
+		dp_mark_icmp_req_to_fw(dp_ctx, nbuf, &cls);
 	}
 
 	wlan_dp_pkt_add_timestamp(dp_intf, QDF_PKT_TX_DRIVER_ENTRY, nbuf);
 
 	/* track connectivity stats */
 	if (dp_intf->pkt_type_bitmap)
-		dp_tx_rx_collect_connectivity_stats_info(nbuf, dp_link,
-							 PKT_TYPE_REQ,
-							 &pkt_type);
+		__dp_tx_rx_collect_connectivity_stats_info(nbuf, dp_link,
+							   PKT_TYPE_REQ,
+							   &pkt_type, &cls);
 
 	dp_get_transmit_mac_addr(dp_link, nbuf, &mac_addr_tx_allowed);
 	if (qdf_is_macaddr_zero(&mac_addr_tx_allowed)) {
@@ -1391,6 +1582,10 @@ QDF_STATUS dp_rx_pkt_thread_enqueue_cbk(void *link_ctx,
 		return QDF_STATUS_E_FAILURE;
 
 	dp_intf = dp_link->dp_intf;
+	nbuf_list = dp_host_apf_filter_list(dp_intf, nbuf_list);
+	if (!nbuf_list)
+		return QDF_STATUS_SUCCESS;
+
 	if (dp_intf->runtime_disable_rx_thread &&
 	    dp_intf->txrx_ops.rx.rx_stack)
 		return dp_intf->txrx_ops.rx.rx_stack(dp_link, nbuf_list);
@@ -1646,6 +1841,36 @@ QDF_STATUS wlan_dp_rx_fisa_flush_by_vdev_id(void *dp_soc, uint8_t vdev_id)
 }
 #endif
 
+/**
+ * dp_rx_pkt_classify() - classify a frame on the RX path
+ * @dp_intf: interface the frame is received on
+ * @nbuf: received frame
+ * @cls: classification to fill
+ *
+ * Only connectivity tracking needs the L3/L4 details. Without it just the
+ * ARP, EAPOL and DHCP flags the RX path acts on are set, from the same
+ * per protocol checks used before the single pass classifier.
+ *
+ * Return: None
+ */
+static inline void dp_rx_pkt_classify(struct wlan_dp_intf *dp_intf,
+				      qdf_nbuf_t nbuf,
+				      struct dp_pkt_class *cls)
+{
+	if (dp_intf->pkt_type_bitmap) {
+		dp_pkt_classify(nbuf, cls);
+		return;
+	}
+
+	cls->flags = 0;
+	if (qdf_nbuf_is_ipv4_arp_pkt(nbuf))
+		cls->flags = DP_PKT_CLASS_ARP;
+	else if (qdf_nbuf_is_ipv4_eapol_pkt(nbuf))
+		cls->flags = DP_PKT_CLASS_EAPOL;
+	else if (qdf_nbuf_is_ipv4_dhcp_pkt(nbuf))
+		cls->flags = DP_PKT_CLASS_DHCP;
+}
+
 QDF_STATUS dp_rx_packet_cbk(void *dp_link_context,
 			    qdf_nbuf_t rxBuf)
 {
@@ -1665,6 +1890,7 @@ QDF_STATUS dp_rx_packet_cbk(void *dp_link_context,
 	struct dp_tx_rx_stats *stats;
 	QDF_STATUS status;
 	uint8_t pkt_type;
+	struct dp_pkt_class cls;
 
 	/* Sanity check on inputs */
 	if (qdf_unlikely((!dp_link_context) || (!rxBuf))) {
@@ -1679,6 +1905,10 @@ QDF_STATUS dp_rx_packet_cbk(void *dp_link_context,
 	cpu_index = qdf_get_cpu();
 	stats = &dp_intf->dp_stats.tx_rx_stats;
 
+	/* with DP RX threads host APF already ran in the enqueue callback */
+	if (!dp_ctx->enable_dp_rx_threads)
+		rxBuf = dp_host_apf_filter_list(dp_intf, rxBuf);
+
 	next = rxBuf;
 
 	while (next) {
@@ -1689,7 +1919,8 @@ QDF_STATUS dp_rx_packet_cbk(void *dp_link_context,
 		is_dhcp = false;
 		send_over_nl = false;
 
-		if (qdf_nbuf_is_ipv4_arp_pkt(nbuf)) {
+		dp_rx_pkt_classify(dp_intf, nbuf, &cls);
+		if (cls.flags & DP_PKT_CLASS_ARP) {
 			if (qdf_nbuf_data_is_arp_rsp(nbuf) &&
 			    (dp_intf->track_arp_ip ==
 			     qdf_nbuf_get_arp_src_ip(nbuf))) {
@@ -1698,7 +1929,7 @@ QDF_STATUS dp_rx_packet_cbk(void *dp_link_context,
 				dp_debug("ARP packet received");
 				track_arp = true;
 			}
-		} else if (qdf_nbuf_is_ipv4_eapol_pkt(nbuf)) {
+		} else if (cls.flags & DP_PKT_CLASS_EAPOL) {
 			subtype = qdf_nbuf_get_eapol_subtype(nbuf);
 			send_over_nl = true;
 
@@ -1713,7 +1944,7 @@ QDF_STATUS dp_rx_packet_cbk(void *dp_link_context,
 						eapol_m3_count;
 				is_eapol = true;
 			}
-		} else if (qdf_nbuf_is_ipv4_dhcp_pkt(nbuf)) {
+		} else if (cls.flags & DP_PKT_CLASS_DHCP) {
 			subtype = qdf_nbuf_get_dhcp_subtype(nbuf);
 			if (subtype == QDF_PROTO_DHCP_OFFER) {
 				++dp_intf->dp_stats.dhcp_stats.
@@ -1731,9 +1962,10 @@ QDF_STATUS dp_rx_packet_cbk(void *dp_link_context,
 
 		/* track connectivity stats */
 		if (dp_intf->pkt_type_bitmap)
-			dp_tx_rx_collect_connectivity_stats_info(nbuf, dp_link,
-								 PKT_TYPE_RSP,
-								 &pkt_type);
+			__dp_tx_rx_collect_connectivity_stats_info(nbuf, dp_link,
+								   PKT_TYPE_RSP,
+								   &pkt_type,
+								   &cls);
 
 		if ((dp_link->conn_info.proxy_arp_service) &&
 		    dp_is_gratuitous_arp_unsolicited_na(dp_ctx, nbuf)) {
@@ -1745,7 +1977,8 @@ QDF_STATUS dp_rx_packet_cbk(void *dp_link_context,
 			continue;
 		}
 
-		dp_event_eapol_log(nbuf, QDF_RX);
+		if (cls.flags & DP_PKT_CLASS_EAPOL)
+			dp_event_eapol_log(nbuf, QDF_RX);
 		qdf_dp_trace_log_pkt(dp_link->link_id, nbuf, QDF_RX,
 				     QDF_TRACE_DEFAULT_PDEV_ID,
 				     dp_intf->device_mode);
@@ -1324,6 +1324,97 @@
 #define CFG_DP_DRIVER_TCP_DELACK
 #endif
 
+#ifdef WLAN_DP_HOST_APF
+/*
+ * <ini>
+ * gHostApfMode - Run the installed APF program on the host RX path
+ * @Min: 0
+ * @Max: 2
+ * @Default: 0
+ *
+ * This ini is used to run the APF program installed by userspace on RX
+ * frames while the host is awake, frames dropped by the program are
+ * freed before they reach the RX thread, GRO and the network stack.
+ * 0: Host APF disabled, program runs only in firmware.
+ * 1: Run host APF on group addressed frames only.
+ * 2: Run host APF on all frames.
+ *
+ * Related: gHostApfPredecode
+ *
+ * Supported Feature: APF
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_HOST_APF_MODE \
+		CFG_INI_UINT("gHostApfMode", \
+		0, \
+		2, \
+		0, \
+		CFG_VALUE_OR_DEFAULT, "Host APF mode")
+
+/*
+ * <ini>
+ * gHostApfPredecode - Pre-decode host APF programs
+ * @Default: true
+ *
+ * This ini is used to decode the APF program once when it is installed,
+ * instead of decoding every instruction for every frame.
+ *
+ * Related: gHostApfMode
+ *
+ * Supported Feature: APF
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_HOST_APF_PREDECODE \
+		CFG_INI_BOOL("gHostApfPredecode", \
+		true, \
+		"Pre-decode host APF programs")
+
+#define CFG_DP_HOST_APF_ALL \
+	CFG(CFG_DP_HOST_APF_MODE) \
+	CFG(CFG_DP_HOST_APF_PREDECODE)
+#else
+#define CFG_DP_HOST_APF_ALL
+#endif
+
+#ifdef WLAN_DP_STATS_SAMPLER
+/*
+ * <ini>
+ * gDpStatsSampleInterval - DP stats sampler interval in ms
+ * @Min: 0
+ * @Max: 10000
+ * @Default: 100
+ *
+ * This ini specifies how often the TX/RX counters of every interface are
+ * sampled into the per interface history read through the dp_stats_samples
+ * debugfs file. Sampling runs in its own work while the bus bandwidth
+ * work is running, independent of gBusBandwidthComputeInterval.
+ * 0: sampling disabled.
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_STATS_SAMPLE_INTERVAL \
+		CFG_INI_UINT( \
+		"gDpStatsSampleInterval", \
+		0, \
+		10000, \
+		100, \
+		CFG_VALUE_OR_DEFAULT, \
+		"DP stats sampler interval")
+
+#define CFG_DP_STATS_SAMPLER_ALL \
+	CFG(CFG_DP_STATS_SAMPLE_INTERVAL)
+#else
+#define CFG_DP_STATS_SAMPLER_ALL
+#endif
+
 #ifdef WLAN_SUPPORT_TXRX_HL_BUNDLE
 #define CFG_DP_HL_BUNDLE \
 	CFG(CFG_DP_HL_BUNDLE_HIGH_TH) \
@@ -1359,6 +1450,8 @@
 	CFG_DP_ENABLE_NUD_TRACKING_ALL \
 	CFG_DP_CONFIG_DP_TRACE_ALL \
 	CFG_DP_HL_BUNDLE \
+	CFG_DP_HOST_APF_ALL \
+	CFG_DP_STATS_SAMPLER_ALL \
 	CFG_DP_FISA
 
 #endif /* WLAN_DP_CFG_H__ */
@@ -351,6 +351,100 @@ struct dp_tx_rx_stats {
 	u64 last_txtimeout;
 };
 
+/* Number of samples kept per interface by the DP stats sampler */
+#define DP_STATS_SAMPLER_HIST_LEN	64
+
+/* "DPSS" in host byte order at the start of a stats snapshot */
+#define DP_STATS_SNAPSHOT_MAGIC		0x53535044
+#define DP_STATS_SNAPSHOT_VERSION	2
+
+/**
+ * struct dp_stats_sample - TX/RX counter deltas over one sampling interval
+ * @timestamp_ms: system timestamp at the end of the interval
+ * @interval_ms: length of the interval
+ * @tx_called: frames given to start_xmit
+ * @tx_dropped: frames dropped in start_xmit
+ * @tx_orphaned: frames orphaned in start_xmit
+ * @rx_packets: frames received from the lower layers
+ * @rx_dropped: received frames dropped
+ * @rx_delivered: received frames delivered to the network stack
+ * @rx_refused: received frames refused by the network stack
+ * @bus_bw_level: bus bandwidth vote at the end of the interval
+ * @tx_acked: frames acked by the peer
+ * @tx_pending: TX descriptors outstanding at the end of the interval
+ * @wmi_pending: WMI commands pending at the end of the interval
+ * @pause_map: netdev queue pause reasons at the end of the interval
+ */
+struct dp_stats_sample {
+	uint64_t timestamp_ms;
+	uint32_t interval_ms;
+	uint32_t tx_called;
+	uint32_t tx_dropped;
+	uint32_t tx_orphaned;
+	uint32_t rx_packets;
+	uint32_t rx_dropped;
+	uint32_t rx_delivered;
+	uint32_t rx_refused;
+	uint32_t bus_bw_level;
+	uint32_t tx_acked;
+	uint32_t tx_pending;
+	uint32_t wmi_pending;
+	uint32_t pause_map;
+} qdf_packed;
+
+/**
+ * struct dp_stats_snapshot_hdr - header of a binary stats snapshot
+ * @magic: DP_STATS_SNAPSHOT_MAGIC
+ * @version: DP_STATS_SNAPSHOT_VERSION
+ * @hdr_len: length of this header
+ * @intf_len: length of each struct dp_stats_snapshot_intf that follows
+ * @sample_len: length of struct dp_stats_sample
+ * @hist_len: number of samples kept per interface
+ * @interval_ms: configured sampling interval
+ *
+ * The header is followed by one record per interface up to the end of the
+ * snapshot. All fields are in host byte order.
+ */
+struct dp_stats_snapshot_hdr {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t hdr_len;
+	uint16_t intf_len;
+	uint16_t sample_len;
+	uint16_t hist_len;
+	uint16_t reserved;
+	uint32_t interval_ms;
+} qdf_packed;
+
+/**
+ * struct dp_stats_snapshot_intf - sample history of one interface
+ * @mac_addr: interface MAC address
+ * @device_mode: enum QDF_OPMODE of the interface
+ * @num_samples: number of valid entries in @samples
+ * @reserved: reserved
+ * @seq_end: number of samples recorded on the interface so far, the last
+ *	     valid entry of @samples is sample @seq_end - 1; lets a reader
+ *	     polling faster than the history wraps stitch snapshots together
+ * @samples: samples, oldest first
+ */
+struct dp_stats_snapshot_intf {
+	uint8_t mac_addr[QDF_MAC_ADDR_SIZE];
+	uint8_t device_mode;
+	uint8_t num_samples;
+	uint32_t reserved;
+	uint32_t seq_end;
+	struct dp_stats_sample samples[DP_STATS_SAMPLER_HIST_LEN];
+} qdf_packed;
+
+/**
+ * typedef dp_stats_snapshot_cb() - consumer of a binary stats snapshot
+ * @ctx: context given along with the callback
+ * @buf: next chunk of the snapshot
+ * @len: length of @buf
+ */
+typedef void (*dp_stats_snapshot_cb)(void *ctx, const uint8_t *buf,
+				     uint32_t len);
+
 /**
  * struct dp_dhcp_ind - DHCP Start/Stop indication message
  * @dhcp_start: Is DHCP start idication
@@ -417,6 +511,22 @@ enum dp_nud_state {
 	DP_NUD_STATE_INVALID
 };
 
+/**
+ * enum dp_stall_trigger - event asking for a data stall root cause verdict
+ * @DP_STALL_TRIGGER_NUD: gateway NUD failure honoured
+ * @DP_STALL_TRIGGER_HOST: data stall detected by the host
+ * @DP_STALL_TRIGGER_FW: data stall reported by the firmware
+ * @DP_STALL_TRIGGER_FW_RX_REFILL: firmware reported RX ring refill failures
+ * @DP_STALL_TRIGGER_MAX: number of triggers
+ */
+enum dp_stall_trigger {
+	DP_STALL_TRIGGER_NUD,
+	DP_STALL_TRIGGER_HOST,
+	DP_STALL_TRIGGER_FW,
+	DP_STALL_TRIGGER_FW_RX_REFILL,
+	DP_STALL_TRIGGER_MAX,
+};
+
 struct opaque_hdd_callback_handle;
 /*
  * typedef hdd_cb_handle - HDD Handle
@@ -733,6 +843,7 @@ struct wlan_dp_psoc_callbacks {
  * @arp_request_ctx: ARP request context
  * @dp_lro_config_cmd: Callback to  send LRO config command
  * @dp_send_dhcp_ind: Callback to send DHCP indication
+ * @dp_get_pending_wmi_cmds: Callback to get the number of pending WMI commands
  */
 struct wlan_dp_psoc_sb_ops {
 	/*TODO to add target if TX ops*/
@@ -747,6 +858,7 @@ struct wlan_dp_psoc_sb_ops {
 					struct cdp_lro_hash_config *dp_lro_cmd);
 	QDF_STATUS (*dp_send_dhcp_ind)(uint16_t vdev_id,
 				       struct dp_dhcp_ind *dhcp_ind);
+	uint32_t (*dp_get_pending_wmi_cmds)(struct wlan_objmgr_psoc *psoc);
 };
 
 /**
@@ -656,6 +656,19 @@ void ucfg_dp_bus_bw_compute_timer_start(struct wlan_objmgr_psoc *psoc);
  */
 void ucfg_dp_bus_bw_compute_timer_try_start(struct wlan_objmgr_psoc *psoc);
 
+/**
+ * ucfg_dp_bus_bw_set_pm_qos_cpu_hint() - set CPUs to vote for on high
+ *	throughput
+ * @psoc: psoc handle
+ * @mask: CPUs the datapath is placed on, empty mask to clear the hint
+ *
+ * The CPUs are voted for PM QoS instead of the whole perf cluster.
+ *
+ * Return: None
+ */
+void ucfg_dp_bus_bw_set_pm_qos_cpu_hint(struct wlan_objmgr_psoc *psoc,
+					qdf_cpu_mask *mask);
+
 /**
  * ucfg_dp_bus_bw_compute_timer_stop() - stop the bandwidth timer
  * @psoc: psoc handle
@@ -757,6 +770,60 @@ void ucfg_dp_nud_reset_tracking(struct wlan_objmgr_vdev *vdev);
  */
 uint8_t ucfg_dp_nud_tracking_enabled(struct wlan_objmgr_psoc *psoc);
 
+/**
+ * ucfg_dp_host_apf_write() - write into the host APF work memory mirror
+ * @vdev: vdev handle
+ * @offset: offset into the APF work memory
+ * @buf: bytes to write
+ * @len: length of @buf
+ * @prog_len: length of the program part of the work memory
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS ucfg_dp_host_apf_write(struct wlan_objmgr_vdev *vdev,
+				  uint32_t offset, const uint8_t *buf,
+				  uint32_t len, uint32_t prog_len);
+
+/**
+ * ucfg_dp_host_apf_commit() - verify and install the mirrored APF program
+ * @vdev: vdev handle
+ * @filter_id: filter id given by userspace
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS ucfg_dp_host_apf_commit(struct wlan_objmgr_vdev *vdev,
+				   uint32_t filter_id);
+
+/**
+ * ucfg_dp_host_apf_reset() - remove the host APF program
+ * @vdev: vdev handle
+ *
+ * Return: None
+ */
+void ucfg_dp_host_apf_reset(struct wlan_objmgr_vdev *vdev);
+
+/**
+ * ucfg_dp_host_apf_set_active() - enable/disable the host APF interpreter
+ * @vdev: vdev handle
+ * @active: enable or disable
+ *
+ * Return: None
+ */
+void ucfg_dp_host_apf_set_active(struct wlan_objmgr_vdev *vdev, bool active);
+
+/**
+ * ucfg_dp_host_apf_read_merge() - merge host APF counters into a
+ *				   firmware work memory read
+ * @vdev: vdev handle
+ * @offset: offset of @buf in the APF work memory
+ * @buf: work memory read back from firmware
+ * @len: length of @buf
+ *
+ * Return: None
+ */
+void ucfg_dp_host_apf_read_merge(struct wlan_objmgr_vdev *vdev,
+				 uint32_t offset, uint8_t *buf, uint32_t len);
+
 /**
  * ucfg_dp_nud_indicate_roam() - reset NUD when roaming happens
  * @vdev: vdev handle
@@ -1057,6 +1124,32 @@ void ucfg_dp_register_event_handler(struct wlan_objmgr_psoc *psoc,
  */
 uint32_t ucfg_dp_get_bus_bw_compute_interval(struct wlan_objmgr_psoc *psoc);
 
+/**
+ * ucfg_dp_stats_sampler_snapshot() - get a binary snapshot of the TX/RX
+ * sample history of all interfaces
+ * @psoc: psoc handle
+ * @cb: consumer of the snapshot, see struct dp_stats_snapshot_hdr
+ * @cb_ctx: context for @cb
+ *
+ * Return: QDF_STATUS_E_NOSUPPORT if the stats sampler is not compiled in
+ */
+QDF_STATUS ucfg_dp_stats_sampler_snapshot(struct wlan_objmgr_psoc *psoc,
+					  dp_stats_snapshot_cb cb,
+					  void *cb_ctx);
+
+/**
+ * ucfg_dp_stall_corr_trigger() - log the root cause verdict on a data stall
+ * @psoc: psoc handle
+ * @vdev_id_bitmap: vdevs reported as stalled, 0 for all the connected
+ *		    interfaces
+ * @trigger: event reporting the stall
+ *
+ * Return: None
+ */
+void ucfg_dp_stall_corr_trigger(struct wlan_objmgr_psoc *psoc,
+				uint32_t vdev_id_bitmap,
+				enum dp_stall_trigger trigger);
+
 /**
  * ucfg_dp_get_current_throughput_level() - get current bandwidth level
  * @psoc: psoc handle
@@ -1111,6 +1204,14 @@ void ucfg_dp_reset_cont_txtimeout_cnt(struct wlan_objmgr_vdev *vdev);
  */
 void ucfg_dp_set_rx_thread_affinity(struct wlan_objmgr_psoc *psoc);
 
+/**
+ * ucfg_dp_get_rx_thread_affinity_mask() - Get INI rx thread affinity mask
+ * @psoc: psoc handle
+ *
+ * Return: CPU mask configured for the rx threads, 0 if none is configured
+ */
+uint32_t ucfg_dp_get_rx_thread_affinity_mask(struct wlan_objmgr_psoc *psoc);
+
 /**
  * ucfg_dp_get_disable_rx_ol_val() - Get Rx OL concurrency value
  * @psoc: psoc handle
@@ -1324,6 +1425,23 @@ QDF_STATUS ucfg_dp_prealloc_init(struct cdp_ctrl_objmgr_psoc *ctrl_psoc);
  */
 void ucfg_dp_prealloc_deinit(void);
 
+/**
+ * ucfg_dp_prealloc_profile_show() - Dump DP pre-alloc usage profile
+ * @buf: buffer to write the profile to
+ * @size: size of @buf
+ *
+ * Return: number of bytes written
+ */
+int ucfg_dp_prealloc_profile_show(char *buf, qdf_size_t size);
+
+/**
+ * ucfg_dp_prealloc_profile_load() - Load DP pre-alloc usage profile
+ * @str: profile text previously dumped by ucfg_dp_prealloc_profile_show()
+ *
+ * Return: QDF_STATUS_SUCCESS on success, error qdf status on failure
+ */
+QDF_STATUS ucfg_dp_prealloc_profile_load(const char *str);
+
 #ifdef DP_MEM_PRE_ALLOC
 /**
  * ucfg_dp_prealloc_get_consistent_mem_unaligned() - gets pre-alloc unaligned
@@ -1583,6 +1701,16 @@ QDF_STATUS ucfg_dp_txrx_ext_dump_stats(ol_txrx_soc_handle soc,
 QDF_STATUS ucfg_dp_txrx_set_cpu_mask(ol_txrx_soc_handle soc,
 				     qdf_cpu_mask *new_mask);
 
+/**
+ * ucfg_dp_txrx_set_refill_cpu_mask() - set CPU mask for RX refill thread
+ * @soc: ol_txrx_soc_handle object
+ * @new_mask: New CPU mask pointer
+ *
+ * Return: QDF_STATUS_SUCCESS on success, error qdf status on failure
+ */
+QDF_STATUS ucfg_dp_txrx_set_refill_cpu_mask(ol_txrx_soc_handle soc,
+					    qdf_cpu_mask *new_mask);
+
 /**
  * ucfg_dp_get_per_link_peer_stats() - Call to get per link peer stats
  * @soc: soc handle
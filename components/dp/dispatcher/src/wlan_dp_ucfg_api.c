@@ -32,6 +32,9 @@
 #include "wlan_dp_bus_bandwidth.h"
 #include "wlan_dp_periodic_sta_stats.h"
 #include "wlan_dp_nud_tracking.h"
+#include "wlan_dp_apf.h"
+#include "wlan_dp_stats_sampler.h"
+#include "wlan_dp_stall_corr.h"
 #include "wlan_dp_txrx.h"
 #include "wlan_nlink_common.h"
 #include "wlan_pkt_capture_api.h"
@@ -226,6 +229,7 @@ ucfg_dp_create_intf(struct wlan_objmgr_psoc *psoc,
 	dp_intf->dp_ctx = dp_ctx;
 	dp_intf->dev = ndev;
 	qdf_copy_macaddr(&dp_intf->mac_addr, intf_addr);
+	dp_stats_sampler_intf_init(dp_intf);
 
 	qdf_spin_lock_bh(&dp_ctx->intf_list_lock);
 	qdf_list_insert_front(&dp_ctx->intf_list, &dp_intf->node);
@@ -237,6 +241,7 @@ ucfg_dp_create_intf(struct wlan_objmgr_psoc *psoc,
 	dp_periodic_sta_stats_init(dp_intf);
 	dp_periodic_sta_stats_mutex_create(dp_intf);
 	dp_nud_init_tracking(dp_intf);
+	dp_host_apf_init(dp_intf);
 	dp_mic_init_work(dp_intf);
 	qdf_atomic_init(&dp_ctx->num_latency_critical_clients);
 	qdf_atomic_init(&dp_intf->gro_disallowed);
@@ -268,6 +273,7 @@ ucfg_dp_destroy_intf(struct wlan_objmgr_psoc *psoc,
 
 	dp_periodic_sta_stats_mutex_destroy(dp_intf);
 	dp_nud_deinit_tracking(dp_intf);
+	dp_host_apf_deinit(dp_intf);
 	dp_mic_deinit_work(dp_intf);
 
 	qdf_spinlock_destroy(&dp_intf->dp_link_list_lock);
@@ -646,6 +652,7 @@ QDF_STATUS ucfg_dp_psoc_open(struct wlan_objmgr_psoc *psoc)
 	dp_register_pmo_handler();
 	dp_trace_init(psoc);
 	dp_bus_bandwidth_init(psoc);
+	dp_stats_sampler_init(dp_ctx);
 	qdf_wake_lock_create(&dp_ctx->rx_wake_lock, "qcom_rx_wakelock");
 
 	return QDF_STATUS_SUCCESS;
@@ -664,6 +671,7 @@ QDF_STATUS ucfg_dp_psoc_close(struct wlan_objmgr_psoc *psoc)
 	dp_rtpm_tput_policy_deinit(psoc);
 	dp_unregister_pmo_handler();
 	dp_bus_bandwidth_deinit(psoc);
+	dp_stats_sampler_deinit(dp_ctx);
 	qdf_wake_lock_destroy(&dp_ctx->rx_wake_lock);
 
 	return QDF_STATUS_SUCCESS;
@@ -1649,6 +1657,12 @@ void ucfg_dp_bus_bw_compute_timer_try_start(struct wlan_objmgr_psoc *psoc)
 	dp_bus_bw_compute_timer_try_start(psoc);
 }
 
+void ucfg_dp_bus_bw_set_pm_qos_cpu_hint(struct wlan_objmgr_psoc *psoc,
+					qdf_cpu_mask *mask)
+{
+	dp_bus_bw_set_pm_qos_cpu_hint(psoc, mask);
+}
+
 void ucfg_dp_bus_bw_compute_timer_stop(struct wlan_objmgr_psoc *psoc)
 {
 	dp_bus_bw_compute_timer_stop(psoc);
@@ -1724,6 +1738,71 @@ void ucfg_dp_nud_indicate_roam(struct wlan_objmgr_vdev *vdev)
 	dp_nud_indicate_roam(vdev);
 }
 
+QDF_STATUS ucfg_dp_host_apf_write(struct wlan_objmgr_vdev *vdev,
+				  uint32_t offset, const uint8_t *buf,
+				  uint32_t len, uint32_t prog_len)
+{
+	struct wlan_dp_link *dp_link = dp_get_vdev_priv_obj(vdev);
+
+	if (!dp_link) {
+		dp_err("Unable to get DP link");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	return dp_host_apf_write(dp_link->dp_intf, offset, buf, len,
+				 prog_len);
+}
+
+QDF_STATUS ucfg_dp_host_apf_commit(struct wlan_objmgr_vdev *vdev,
+				   uint32_t filter_id)
+{
+	struct wlan_dp_link *dp_link = dp_get_vdev_priv_obj(vdev);
+
+	if (!dp_link) {
+		dp_err("Unable to get DP link");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	return dp_host_apf_commit(dp_link->dp_intf, filter_id);
+}
+
+void ucfg_dp_host_apf_reset(struct wlan_objmgr_vdev *vdev)
+{
+	struct wlan_dp_link *dp_link = dp_get_vdev_priv_obj(vdev);
+
+	if (!dp_link) {
+		dp_err("Unable to get DP link");
+		return;
+	}
+
+	dp_host_apf_reset(dp_link->dp_intf);
+}
+
+void ucfg_dp_host_apf_set_active(struct wlan_objmgr_vdev *vdev, bool active)
+{
+	struct wlan_dp_link *dp_link = dp_get_vdev_priv_obj(vdev);
+
+	if (!dp_link) {
+		dp_err("Unable to get DP link");
+		return;
+	}
+
+	dp_host_apf_set_active(dp_link->dp_intf, active);
+}
+
+void ucfg_dp_host_apf_read_merge(struct wlan_objmgr_vdev *vdev,
+				 uint32_t offset, uint8_t *buf, uint32_t len)
+{
+	struct wlan_dp_link *dp_link = dp_get_vdev_priv_obj(vdev);
+
+	if (!dp_link) {
+		dp_err("Unable to get DP link");
+		return;
+	}
+
+	dp_host_apf_read_merge(dp_link->dp_intf, offset, buf, len);
+}
+
 void ucfg_dp_clear_arp_stats(struct wlan_objmgr_vdev *vdev)
 {
 	struct wlan_dp_link *dp_link = dp_get_vdev_priv_obj(vdev);
@@ -2262,6 +2341,34 @@ uint32_t ucfg_dp_get_bus_bw_compute_interval(struct wlan_objmgr_psoc *psoc)
 	return DP_BUS_BW_CFG(dp_ctx->dp_cfg.bus_bw_compute_interval);
 }
 
+QDF_STATUS ucfg_dp_stats_sampler_snapshot(struct wlan_objmgr_psoc *psoc,
+					  dp_stats_snapshot_cb cb,
+					  void *cb_ctx)
+{
+	struct wlan_dp_psoc_context *dp_ctx = dp_psoc_get_priv(psoc);
+
+	if (!dp_ctx) {
+		dp_err("DP ctx is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	return dp_stats_sampler_snapshot(dp_ctx, cb, cb_ctx);
+}
+
+void ucfg_dp_stall_corr_trigger(struct wlan_objmgr_psoc *psoc,
+				uint32_t vdev_id_bitmap,
+				enum dp_stall_trigger trigger)
+{
+	struct wlan_dp_psoc_context *dp_ctx = dp_psoc_get_priv(psoc);
+
+	if (!dp_ctx) {
+		dp_err("DP ctx is NULL");
+		return;
+	}
+
+	dp_stall_corr_trigger(dp_ctx, vdev_id_bitmap, trigger);
+}
+
 QDF_STATUS ucfg_dp_get_txrx_stats(struct wlan_objmgr_vdev *vdev,
 				  struct dp_tx_rx_stats *dp_stats)
 {
@@ -2369,6 +2476,18 @@ void ucfg_dp_set_rx_thread_affinity(struct wlan_objmgr_psoc *psoc)
 		cds_set_rx_thread_ul_cpu_mask(cfg->rx_thread_ul_affinity_mask);
 }
 
+uint32_t ucfg_dp_get_rx_thread_affinity_mask(struct wlan_objmgr_psoc *psoc)
+{
+	struct wlan_dp_psoc_context *dp_ctx = dp_psoc_get_priv(psoc);
+
+	if (!dp_ctx) {
+		dp_err("DP ctx is NULL");
+		return 0;
+	}
+
+	return dp_ctx->dp_cfg.rx_thread_affinity_mask;
+}
+
 void ucfg_dp_get_disable_rx_ol_val(struct wlan_objmgr_psoc *psoc,
 				   uint8_t *disable_conc,
 				   uint8_t *disable_low_tput)
@@ -2614,6 +2733,16 @@ void ucfg_dp_prealloc_deinit(void)
 	dp_prealloc_deinit();
 }
 
+int ucfg_dp_prealloc_profile_show(char *buf, qdf_size_t size)
+{
+	return dp_prealloc_profile_show(buf, size);
+}
+
+QDF_STATUS ucfg_dp_prealloc_profile_load(const char *str)
+{
+	return dp_prealloc_profile_load(str);
+}
+
 #ifdef DP_MEM_PRE_ALLOC
 void *ucfg_dp_prealloc_get_consistent_mem_unaligned(qdf_size_t size,
 						    qdf_dma_addr_t *base_addr,
@@ -2785,6 +2914,12 @@ QDF_STATUS ucfg_dp_txrx_set_cpu_mask(ol_txrx_soc_handle soc,
 	return dp_txrx_set_cpu_mask(soc, new_mask);
 }
 
+QDF_STATUS ucfg_dp_txrx_set_refill_cpu_mask(ol_txrx_soc_handle soc,
+					    qdf_cpu_mask *new_mask)
+{
+	return dp_txrx_set_refill_cpu_mask(soc, new_mask);
+}
+
 QDF_STATUS
 ucfg_dp_get_per_link_peer_stats(ol_txrx_soc_handle soc, uint8_t vdev_id,
 				uint8_t *peer_mac,
@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "wlan_dp_apf.h"
+#include "wlan_dp_apf_test.h"
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "qdf_util.h"
+
+#define apf_test_log(fmt, args...) \
+	qdf_nofl_info("dp_apf_test: " fmt, ##args)
+
+#define APF_T_LDB	1
+#define APF_T_LDH	2
+#define APF_T_LDW	3
+#define APF_T_LDHX	5
+#define APF_T_ADD	7
+#define APF_T_DIV	9
+#define APF_T_LI	13
+#define APF_T_JMP	14
+#define APF_T_JEQ	15
+#define APF_T_JNE	16
+#define APF_T_JNEBS	20
+#define APF_T_EXT	21
+#define APF_T_LDDW	22
+#define APF_T_STDW	23
+
+#define APF_T_LABEL_PASS	0
+#define APF_T_LABEL_DROP	1
+
+#define APF_T_MAX_FIXUPS	8
+#define APF_T_BENCH_ROUNDS	10000
+
+/**
+ * struct apf_test_asm - minimal APF assembler, every immediate is 4 bytes
+ * @buf: program bytes
+ * @len: program length
+ * @fixup_pos: offsets of jump immediates to patch
+ * @fixup_end: end of the instruction owning the immediate
+ * @fixup_label: APF_T_LABEL_* the jump branches to
+ * @num_fixups: number of pending fixups
+ */
+struct apf_test_asm {
+	uint8_t buf[128];
+	uint32_t len;
+	uint32_t fixup_pos[APF_T_MAX_FIXUPS];
+	uint32_t fixup_end[APF_T_MAX_FIXUPS];
+	uint8_t fixup_label[APF_T_MAX_FIXUPS];
+	uint32_t num_fixups;
+};
+
+static void apf_test_put32(uint8_t *buf, uint32_t val)
+{
+	buf[0] = val >> 24;
+	buf[1] = val >> 16;
+	buf[2] = val >> 8;
+	buf[3] = val;
+}
+
+static void apf_test_emit(struct apf_test_asm *a, uint8_t opcode, uint8_t reg,
+			  uint32_t imm)
+{
+	a->buf[a->len++] = (opcode << 3) | (3 << 1) | reg;
+	apf_test_put32(a->buf + a->len, imm);
+	a->len += 4;
+}
+
+static void apf_test_jump(struct apf_test_asm *a, uint8_t opcode,
+			  uint8_t label, uint32_t cmp, const uint8_t *bytes)
+{
+	uint32_t pos;
+
+	a->buf[a->len++] = (opcode << 3) | (3 << 1);
+	pos = a->len;
+	a->len += 4;
+	if (opcode != APF_T_JMP) {
+		apf_test_put32(a->buf + a->len, cmp);
+		a->len += 4;
+	}
+	if (opcode == APF_T_JNEBS) {
+		qdf_mem_copy(a->buf + a->len, bytes, cmp);
+		a->len += cmp;
+	}
+
+	a->fixup_pos[a->num_fixups] = pos;
+	a->fixup_end[a->num_fixups] = a->len;
+	a->fixup_label[a->num_fixups++] = label;
+}
+
+static void apf_test_finish(struct apf_test_asm *a)
+{
+	uint32_t i, target;
+
+	for (i = 0; i < a->num_fixups; i++) {
+		target = a->len + a->fixup_label[i];
+		apf_test_put32(a->buf + a->fixup_pos[i],
+			       target - a->fixup_end[i]);
+	}
+}
+
+static const uint8_t apf_test_mdns_mac[QDF_MAC_ADDR_SIZE] = {
+	0x01, 0x00, 0x5e, 0x00, 0x00, 0xfb
+};
+
+static const uint8_t apf_test_ssdp_mac[QDF_MAC_ADDR_SIZE] = {
+	0x01, 0x00, 0x5e, 0x7f, 0xff, 0xfa
+};
+
+static const uint8_t apf_test_bcast_mac[QDF_MAC_ADDR_SIZE] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+static const uint8_t apf_test_ucast_mac[QDF_MAC_ADDR_SIZE] = {
+	0x02, 0x11, 0x22, 0x33, 0x44, 0x55
+};
+
+/**
+ * apf_test_prog_mdns_ssdp() - drop IPv4 UDP frames to mDNS/SSDP ports
+ * @a: assembler
+ *
+ * Return: None
+ */
+static void apf_test_prog_mdns_ssdp(struct apf_test_asm *a)
+{
+	apf_test_emit(a, APF_T_LDH, 0, 12);
+	apf_test_jump(a, APF_T_JNE, APF_T_LABEL_PASS, 0x0800, NULL);
+	apf_test_emit(a, APF_T_LDB, 0, 23);
+	apf_test_jump(a, APF_T_JNE, APF_T_LABEL_PASS, 17, NULL);
+	/* R1 = IPv4 header length from the pre-filled memory slot */
+	apf_test_emit(a, APF_T_EXT, 1, 13);
+	apf_test_emit(a, APF_T_LDHX, 0, 16);
+	apf_test_jump(a, APF_T_JEQ, APF_T_LABEL_DROP, 5353, NULL);
+	apf_test_jump(a, APF_T_JEQ, APF_T_LABEL_DROP, 1900, NULL);
+	apf_test_finish(a);
+}
+
+/**
+ * apf_test_prog_counter() - drop mDNS MAC frames and count them in data
+ * @a: assembler
+ *
+ * The counter lives in the last 4 bytes of the data memory.
+ *
+ * Return: None
+ */
+static void apf_test_prog_counter(struct apf_test_asm *a)
+{
+	apf_test_emit(a, APF_T_LI, 0, 0);
+	apf_test_jump(a, APF_T_JNEBS, APF_T_LABEL_PASS, QDF_MAC_ADDR_SIZE,
+		      apf_test_mdns_mac);
+	apf_test_emit(a, APF_T_LI, 1, 0);
+	apf_test_emit(a, APF_T_LDDW, 0, (uint32_t)-4);
+	apf_test_emit(a, APF_T_ADD, 0, 1);
+	apf_test_emit(a, APF_T_STDW, 0, (uint32_t)-4);
+	apf_test_jump(a, APF_T_JMP, APF_T_LABEL_DROP, 0, NULL);
+	apf_test_finish(a);
+}
+
+/**
+ * struct apf_test_pkt - recorded frame of the test trace
+ * @data: frame bytes
+ * @len: frame length
+ * @mdns_ssdp: expected verdict of apf_test_prog_mdns_ssdp()
+ * @counter: expected verdict of apf_test_prog_counter()
+ */
+struct apf_test_pkt {
+	uint8_t data[64];
+	uint32_t len;
+	enum dp_apf_verdict mdns_ssdp;
+	enum dp_apf_verdict counter;
+};
+
+static void apf_test_build(struct apf_test_pkt *pkt, const uint8_t *da,
+			   uint16_t ether_type, uint8_t proto, uint16_t dport,
+			   uint32_t len)
+{
+	uint8_t *d = pkt->data;
+
+	qdf_mem_zero(pkt->data, sizeof(pkt->data));
+	qdf_mem_copy(d, da, QDF_MAC_ADDR_SIZE);
+	d[6] = 0x02;
+	d[11] = 0x01;
+	d[12] = ether_type >> 8;
+	d[13] = ether_type & 0xff;
+	d[14] = 0x45;
+	d[22] = 64;
+	d[23] = proto;
+	d[34] = 0x14;
+	d[35] = 0xe9;
+	d[36] = dport >> 8;
+	d[37] = dport & 0xff;
+	pkt->len = len;
+}
+
+static uint32_t apf_test_build_trace(struct apf_test_pkt *trace)
+{
+	apf_test_build(&trace[0], apf_test_mdns_mac, 0x0800, 17, 5353, 60);
+	trace[0].mdns_ssdp = DP_APF_DROP;
+	trace[0].counter = DP_APF_DROP;
+
+	apf_test_build(&trace[1], apf_test_ssdp_mac, 0x0800, 17, 1900, 60);
+	trace[1].mdns_ssdp = DP_APF_DROP;
+	trace[1].counter = DP_APF_PASS;
+
+	apf_test_build(&trace[2], apf_test_bcast_mac, 0x0806, 0, 0, 42);
+	trace[2].mdns_ssdp = DP_APF_PASS;
+	trace[2].counter = DP_APF_PASS;
+
+	apf_test_build(&trace[3], apf_test_ucast_mac, 0x0800, 6, 443, 60);
+	trace[3].mdns_ssdp = DP_APF_PASS;
+	trace[3].counter = DP_APF_PASS;
+
+	/* UDP header is cut off, the port load is out of bounds */
+	apf_test_build(&trace[4], apf_test_bcast_mac, 0x0800, 17, 5353, 30);
+	trace[4].mdns_ssdp = DP_APF_ABORT;
+	trace[4].counter = DP_APF_PASS;
+
+	/* shorter than the compared destination address */
+	apf_test_build(&trace[5], apf_test_mdns_mac, 0x0800, 17, 5353, 4);
+	trace[5].mdns_ssdp = DP_APF_ABORT;
+	trace[5].counter = DP_APF_ABORT;
+
+	return 6;
+}
+
+static uint32_t apf_test_verifier(void)
+{
+	static const uint8_t truncated[] = {
+		(APF_T_LDW << 3) | (3 << 1), 0x00, 0x00
+	};
+	static const uint8_t bad_opcode[] = { 31 << 3 };
+	static const uint8_t div_zero[] = { APF_T_DIV << 3 };
+	static const uint8_t mid_insn_jump[] = {
+		(APF_T_JMP << 3) | (1 << 1), 0x01,
+		(APF_T_LI << 3) | (3 << 1), 0x00, 0x00, 0x00, 0x01
+	};
+	static const uint8_t out_of_prog_jump[] = {
+		(APF_T_JMP << 3) | (1 << 1), 0x10
+	};
+	static const uint8_t jnebs_overrun[] = {
+		(APF_T_JNEBS << 3) | (1 << 1), 0x00, 0x08, 0xaa
+	};
+	struct {
+		const uint8_t *prog;
+		uint32_t len;
+	} bad[] = {
+		{ truncated, sizeof(truncated) },
+		{ bad_opcode, sizeof(bad_opcode) },
+		{ div_zero, sizeof(div_zero) },
+		{ mid_insn_jump, sizeof(mid_insn_jump) },
+		{ out_of_prog_jump, sizeof(out_of_prog_jump) },
+		{ jnebs_overrun, sizeof(jnebs_overrun) },
+	};
+	struct apf_test_asm a = {0};
+	uint32_t errors = 0;
+	bool has_store;
+	uint32_t i;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(bad); i++) {
+		if (QDF_IS_STATUS_SUCCESS(dp_apf_verify(bad[i].prog,
+							bad[i].len,
+							bad[i].len,
+							&has_store))) {
+			apf_test_log("verifier accepted bad program %u", i);
+			errors++;
+		}
+	}
+
+	apf_test_prog_counter(&a);
+	if (QDF_IS_STATUS_ERROR(dp_apf_verify(a.buf, a.len, a.len + 8,
+					      &has_store)) || !has_store) {
+		apf_test_log("verifier rejected counter program");
+		errors++;
+	}
+
+	return errors;
+}
+
+static uint32_t apf_test_run_trace(struct dp_apf_prog *prog,
+				   struct apf_test_pkt *trace, uint32_t num,
+				   bool counter_prog)
+{
+	enum dp_apf_verdict verdict, expected;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	for (i = 0; i < num; i++) {
+		verdict = dp_apf_run(prog, trace[i].data, trace[i].len);
+		expected = counter_prog ? trace[i].counter :
+					  trace[i].mdns_ssdp;
+		if (verdict != expected) {
+			apf_test_log("%s pkt %u: verdict %d expected %d",
+				     prog->insn ? "predecoded" : "interpreted",
+				     i, verdict, expected);
+			errors++;
+		}
+	}
+
+	return errors;
+}
+
+static uint32_t apf_test_counter(struct apf_test_pkt *trace, uint32_t num,
+				 bool predecode)
+{
+	struct apf_test_asm a = {0};
+	struct dp_apf_prog *prog;
+	uint8_t mem[sizeof(a.buf) + 8] = {0};
+	uint32_t errors = 0, count, i;
+	uint8_t *c;
+
+	apf_test_prog_counter(&a);
+	qdf_mem_copy(mem, a.buf, a.len);
+	prog = dp_apf_prog_alloc(mem, a.len, a.len + 8, 2, predecode);
+	if (!prog)
+		return 1;
+
+	for (i = 0; i < 3; i++)
+		errors += apf_test_run_trace(prog, trace, num, true);
+
+	/* trace[0] is the only frame which reaches the counter */
+	c = prog->mem + prog->mem_len - 4;
+	count = (c[0] << 24) | (c[1] << 16) | (c[2] << 8) | c[3];
+	if (count != 3) {
+		apf_test_log("counter %u expected 3", count);
+		errors++;
+	}
+
+	dp_apf_prog_put(prog);
+
+	return errors;
+}
+
+/**
+ * apf_test_bench() - compare interpreted and pre-decoded execution
+ * @trace: recorded frames
+ * @num: number of frames
+ *
+ * Return: number of errors
+ */
+static uint32_t apf_test_bench(struct apf_test_pkt *trace, uint32_t num)
+{
+	struct apf_test_asm a = {0};
+	struct dp_apf_prog *prog[2];
+	uint64_t start, elapsed_us[2];
+	uint32_t errors = 0;
+	uint32_t i, r, p;
+
+	apf_test_prog_mdns_ssdp(&a);
+	prog[0] = dp_apf_prog_alloc(a.buf, a.len, a.len, 1, false);
+	prog[1] = dp_apf_prog_alloc(a.buf, a.len, a.len, 1, true);
+	if (!prog[0] || !prog[1] || prog[0]->insn || !prog[1]->insn) {
+		apf_test_log("failed to install benchmark program");
+		errors++;
+		goto put;
+	}
+
+	for (p = 0; p < 2; p++) {
+		errors += apf_test_run_trace(prog[p], trace, num, false);
+
+		start = qdf_ktime_to_us(qdf_ktime_get());
+		for (r = 0; r < APF_T_BENCH_ROUNDS; r++)
+			for (i = 0; i < num; i++)
+				dp_apf_run(prog[p], trace[i].data,
+					   trace[i].len);
+		elapsed_us[p] = qdf_ktime_to_us(qdf_ktime_get()) - start;
+	}
+
+	apf_test_log("bench: %u frames x %u rounds, interpreted %llu us (%llu ns/frame), predecoded %llu us (%llu ns/frame)",
+		     num, APF_T_BENCH_ROUNDS, elapsed_us[0],
+		     qdf_do_div(elapsed_us[0] * 1000,
+				num * APF_T_BENCH_ROUNDS),
+		     elapsed_us[1],
+		     qdf_do_div(elapsed_us[1] * 1000,
+				num * APF_T_BENCH_ROUNDS));
+
+put:
+	if (prog[0])
+		dp_apf_prog_put(prog[0]);
+	if (prog[1])
+		dp_apf_prog_put(prog[1]);
+
+	return errors;
+}
+
+uint32_t dp_apf_unit_test(void)
+{
+	struct apf_test_pkt *trace;
+	uint32_t errors = 0;
+	uint32_t num;
+
+	trace = qdf_mem_malloc(6 * sizeof(*trace));
+	if (!trace)
+		return 1;
+
+	num = apf_test_build_trace(trace);
+
+	errors += apf_test_verifier();
+	errors += apf_test_counter(trace, num, false);
+	errors += apf_test_counter(trace, num, true);
+	errors += apf_test_bench(trace, num);
+
+	qdf_mem_free(trace);
+
+	return errors;
+}
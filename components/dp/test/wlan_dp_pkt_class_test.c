@@ -0,0 +1,460 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "wlan_dp_txrx.h"
+#include "wlan_dp_pkt_class_test.h"
+#include "qdf_mem.h"
+#include "qdf_nbuf.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "qdf_util.h"
+
+#define pkt_class_test_log(fmt, args...) \
+	qdf_nofl_info("dp_pkt_class_test: " fmt, ##args)
+
+#define PKT_T_FRAME_LEN		96
+#define PKT_T_BENCH_ROUNDS	10000
+
+/* verdict bits on top of the DP_PKT_CLASS_* flags */
+#define PKT_T_ICMP_REQ		BIT(16)
+#define PKT_T_ICMP_RSP		BIT(17)
+#define PKT_T_ICMPV6_REQ	BIT(18)
+#define PKT_T_TCP_SYN		BIT(19)
+#define PKT_T_TCP_SYN_ACK	BIT(20)
+#define PKT_T_TCP_ACK		BIT(21)
+
+#define PKT_T_V4		DP_PKT_CLASS_IPV4
+#define PKT_T_V4_ICMP		(PKT_T_V4 | DP_PKT_CLASS_ICMP)
+#define PKT_T_V4_TCP		(PKT_T_V4 | DP_PKT_CLASS_TCP)
+#define PKT_T_V4_UDP		(PKT_T_V4 | DP_PKT_CLASS_UDP)
+
+/**
+ * struct pkt_class_test_frame - synthetic frame and its expected verdict
+ * @name: frame name
+ * @ethertype: ethertype
+ * @ihl: IPv4 header length in 32-bit words, 0 for 5
+ * @frag: IPv4 flags and fragment offset
+ * @proto: IPv4 protocol or IPv6 next header
+ * @sport: TCP/UDP source port
+ * @dport: TCP/UDP destination port
+ * @l4_op: ICMP/ICMPv6 type or TCP flags
+ * @dns_flags: DNS header flags
+ * @len: frame length, 0 for PKT_T_FRAME_LEN
+ * @legacy: frame can be parsed by the fixed offset qdf helpers
+ * @verdict: expected verdict
+ */
+struct pkt_class_test_frame {
+	const char *name;
+	uint16_t ethertype;
+	uint8_t ihl;
+	uint16_t frag;
+	uint8_t proto;
+	uint16_t sport;
+	uint16_t dport;
+	uint8_t l4_op;
+	uint16_t dns_flags;
+	uint32_t len;
+	bool legacy;
+	uint32_t verdict;
+};
+
+static const struct pkt_class_test_frame pkt_class_test_frames[] = {
+	{ .name = "arp", .ethertype = QDF_NBUF_TRAC_ARP_ETH_TYPE,
+	  .legacy = true, .verdict = DP_PKT_CLASS_ARP },
+	{ .name = "eapol", .ethertype = QDF_NBUF_TRAC_EAPOL_ETH_TYPE,
+	  .legacy = true, .verdict = DP_PKT_CLASS_EAPOL },
+	{ .name = "icmp echo req", .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE,
+	  .proto = QDF_NBUF_TRAC_ICMP_TYPE, .l4_op = DP_PKT_ICMP_ECHO_REQ,
+	  .legacy = true, .verdict = PKT_T_V4_ICMP | PKT_T_ICMP_REQ },
+	{ .name = "icmp echo rsp", .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE,
+	  .proto = QDF_NBUF_TRAC_ICMP_TYPE, .l4_op = DP_PKT_ICMP_ECHO_RSP,
+	  .legacy = true, .verdict = PKT_T_V4_ICMP | PKT_T_ICMP_RSP },
+	{ .name = "icmp unreachable", .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE,
+	  .proto = QDF_NBUF_TRAC_ICMP_TYPE, .l4_op = 3,
+	  .legacy = true, .verdict = PKT_T_V4_ICMP },
+	{ .name = "tcp syn", .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE,
+	  .proto = QDF_NBUF_TRAC_TCP_TYPE, .sport = 40000, .dport = 443,
+	  .l4_op = DP_PKT_TCP_SYN,
+	  .legacy = true, .verdict = PKT_T_V4_TCP | PKT_T_TCP_SYN },
+	{ .name = "tcp syn ack", .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE,
+	  .proto = QDF_NBUF_TRAC_TCP_TYPE, .sport = 443, .dport = 40000,
+	  .l4_op = DP_PKT_TCP_SYN_ACK,
+	  .legacy = true, .verdict = PKT_T_V4_TCP | PKT_T_TCP_SYN_ACK },
+	{ .name = "tcp ack", .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE,
+	  .proto = QDF_NBUF_TRAC_TCP_TYPE, .sport = 40000, .dport = 443,
+	  .l4_op = DP_PKT_TCP_ACK,
+	  .legacy = true, .verdict = PKT_T_V4_TCP | PKT_T_TCP_ACK },
+	{ .name = "tcp data", .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE,
+	  .proto = QDF_NBUF_TRAC_TCP_TYPE, .sport = 40000, .dport = 443,
+	  .l4_op = 0x18, .legacy = true, .verdict = PKT_T_V4_TCP },
+	{ .name = "dns query", .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE,
+	  .proto = QDF_NBUF_TRAC_UDP_TYPE, .sport = 40001, .dport = 53,
+	  .dns_flags = 0x0100, .legacy = true,
+	  .verdict = PKT_T_V4_UDP | DP_PKT_CLASS_DNS_QUERY },
+	{ .name = "dns rsp", .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE,
+	  .proto = QDF_NBUF_TRAC_UDP_TYPE, .sport = 53, .dport = 40001,
+	  .dns_flags = 0x8180, .legacy = true,
+	  .verdict = PKT_T_V4_UDP | DP_PKT_CLASS_DNS_RSP },
+	{ .name = "dhcp discover", .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE,
+	  .proto = QDF_NBUF_TRAC_UDP_TYPE, .sport = 68, .dport = 67,
+	  .legacy = true, .verdict = PKT_T_V4_UDP | DP_PKT_CLASS_DHCP },
+	{ .name = "udp", .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE,
+	  .proto = QDF_NBUF_TRAC_UDP_TYPE, .sport = 5000, .dport = 5001,
+	  .legacy = true, .verdict = PKT_T_V4_UDP },
+	{ .name = "icmpv6 echo req", .ethertype = QDF_NBUF_TRAC_IPV6_ETH_TYPE,
+	  .proto = QDF_NBUF_TRAC_ICMPV6_TYPE, .l4_op = DP_PKT_ICMPV6_ECHO_REQ,
+	  .legacy = true,
+	  .verdict = DP_PKT_CLASS_IPV6 | DP_PKT_CLASS_ICMPV6 |
+		     PKT_T_ICMPV6_REQ },
+	{ .name = "ipv6 udp", .ethertype = QDF_NBUF_TRAC_IPV6_ETH_TYPE,
+	  .proto = QDF_NBUF_TRAC_UDP_TYPE, .sport = 5000, .dport = 5001,
+	  .legacy = true, .verdict = DP_PKT_CLASS_IPV6 },
+	{ .name = "icmp first fragment",
+	  .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE, .frag = 0x2000,
+	  .proto = QDF_NBUF_TRAC_ICMP_TYPE, .l4_op = DP_PKT_ICMP_ECHO_REQ,
+	  .legacy = true,
+	  .verdict = PKT_T_V4_ICMP | DP_PKT_CLASS_IPV4_FRAG |
+		     PKT_T_ICMP_REQ },
+	{ .name = "udp last fragment",
+	  .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE, .frag = 185,
+	  .proto = QDF_NBUF_TRAC_UDP_TYPE, .sport = 68, .dport = 67,
+	  .verdict = PKT_T_V4 | DP_PKT_CLASS_IPV4_FRAG },
+	{ .name = "tcp syn with ip options",
+	  .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE, .ihl = 6,
+	  .proto = QDF_NBUF_TRAC_TCP_TYPE, .sport = 40000, .dport = 443,
+	  .l4_op = DP_PKT_TCP_SYN,
+	  .verdict = PKT_T_V4_TCP | PKT_T_TCP_SYN },
+	{ .name = "truncated tcp", .ethertype = QDF_NBUF_TRAC_IPV4_ETH_TYPE,
+	  .proto = QDF_NBUF_TRAC_TCP_TYPE, .sport = 40000, .dport = 443,
+	  .l4_op = DP_PKT_TCP_SYN, .len = 44, .verdict = PKT_T_V4 },
+};
+
+#define PKT_T_NUM_FRAMES	QDF_ARRAY_SIZE(pkt_class_test_frames)
+
+static void pkt_class_test_put16(uint8_t *buf, uint16_t val)
+{
+	buf[0] = val >> 8;
+	buf[1] = val & 0xff;
+}
+
+/**
+ * pkt_class_test_build() - build the bytes of a synthetic frame
+ * @tf: frame description
+ * @buf: PKT_T_FRAME_LEN bytes to fill
+ *
+ * Return: frame length
+ */
+static uint32_t pkt_class_test_build(const struct pkt_class_test_frame *tf,
+				     uint8_t *buf)
+{
+	static const uint8_t src_ip[] = { 192, 168, 1, 2 };
+	static const uint8_t dst_ip[] = { 192, 168, 1, 1 };
+	uint32_t len = tf->len ? tf->len : PKT_T_FRAME_LEN;
+	uint8_t ihl = tf->ihl ? tf->ihl : 5;
+	uint8_t *ip = buf + QDF_NBUF_TRAC_IPV4_OFFSET;
+	uint8_t *l4;
+
+	qdf_mem_zero(buf, PKT_T_FRAME_LEN);
+	qdf_mem_set(buf, QDF_MAC_ADDR_SIZE, 0x02);
+	qdf_mem_set(buf + QDF_MAC_ADDR_SIZE, QDF_MAC_ADDR_SIZE, 0x04);
+	pkt_class_test_put16(buf + QDF_NBUF_TRAC_ETH_TYPE_OFFSET,
+			     tf->ethertype);
+
+	switch (tf->ethertype) {
+	case QDF_NBUF_TRAC_ARP_ETH_TYPE:
+		pkt_class_test_put16(ip, 1);
+		pkt_class_test_put16(ip + 2, QDF_NBUF_TRAC_IPV4_ETH_TYPE);
+		ip[4] = QDF_MAC_ADDR_SIZE;
+		ip[5] = sizeof(src_ip);
+		pkt_class_test_put16(ip + 6, 1);
+		return len;
+	case QDF_NBUF_TRAC_EAPOL_ETH_TYPE:
+		ip[0] = 2;
+		ip[1] = 3;
+		pkt_class_test_put16(ip + 2, len - QDF_NBUF_TRAC_IPV4_OFFSET - 4);
+		return len;
+	case QDF_NBUF_TRAC_IPV6_ETH_TYPE:
+		ip[0] = 0x60;
+		pkt_class_test_put16(ip + 4, len - QDF_NBUF_TRAC_IPV4_OFFSET - 40);
+		ip[6] = tf->proto;
+		ip[7] = 64;
+		l4 = ip + 40;
+		break;
+	default:
+		ip[0] = 0x40 | ihl;
+		pkt_class_test_put16(ip + 2, len - QDF_NBUF_TRAC_IPV4_OFFSET);
+		pkt_class_test_put16(ip + 6, tf->frag);
+		ip[8] = 64;
+		ip[9] = tf->proto;
+		qdf_mem_copy(ip + 12, src_ip, sizeof(src_ip));
+		qdf_mem_copy(ip + 16, dst_ip, sizeof(dst_ip));
+		/* NOP options */
+		qdf_mem_set(ip + 20, (ihl - 5) * 4, 0x01);
+		l4 = ip + ihl * 4;
+		break;
+	}
+
+	switch (tf->proto) {
+	case QDF_NBUF_TRAC_ICMP_TYPE:
+	case QDF_NBUF_TRAC_ICMPV6_TYPE:
+		l4[0] = tf->l4_op;
+		break;
+	case QDF_NBUF_TRAC_TCP_TYPE:
+		pkt_class_test_put16(l4, tf->sport);
+		pkt_class_test_put16(l4 + 2, tf->dport);
+		l4[12] = 0x50;
+		l4[13] = tf->l4_op;
+		break;
+	case QDF_NBUF_TRAC_UDP_TYPE:
+		pkt_class_test_put16(l4, tf->sport);
+		pkt_class_test_put16(l4 + 2, tf->dport);
+		pkt_class_test_put16(l4 + 4, buf + len - l4);
+		pkt_class_test_put16(l4 + 8, 0x1234);
+		pkt_class_test_put16(l4 + 10, tf->dns_flags);
+		break;
+	default:
+		break;
+	}
+
+	return len;
+}
+
+/**
+ * pkt_class_test_verdict() - reduce a classification to verdict bits
+ * @cls: classification
+ *
+ * Return: DP_PKT_CLASS_* flags and PKT_T_* bits
+ */
+static uint32_t pkt_class_test_verdict(const struct dp_pkt_class *cls)
+{
+	uint32_t verdict = cls->flags;
+
+	if (cls->flags & DP_PKT_CLASS_ICMP) {
+		if (cls->l4_op == DP_PKT_ICMP_ECHO_REQ)
+			verdict |= PKT_T_ICMP_REQ;
+		else if (cls->l4_op == DP_PKT_ICMP_ECHO_RSP)
+			verdict |= PKT_T_ICMP_RSP;
+	}
+
+	if (cls->flags & DP_PKT_CLASS_ICMPV6 &&
+	    cls->l4_op == DP_PKT_ICMPV6_ECHO_REQ)
+		verdict |= PKT_T_ICMPV6_REQ;
+
+	if (cls->flags & DP_PKT_CLASS_TCP) {
+		if (cls->l4_op == DP_PKT_TCP_SYN)
+			verdict |= PKT_T_TCP_SYN;
+		else if (cls->l4_op == DP_PKT_TCP_SYN_ACK)
+			verdict |= PKT_T_TCP_SYN_ACK;
+		else if (cls->l4_op == DP_PKT_TCP_ACK)
+			verdict |= PKT_T_TCP_ACK;
+	}
+
+	return verdict;
+}
+
+/**
+ * pkt_class_test_legacy() - classify through the qdf helper chain
+ * @nbuf: frame
+ * @cls: classification to fill, addresses and ports only for ICMP and TCP
+ *
+ * Mirrors the helpers the RX and TX paths used to call on every frame
+ * before the classifier.
+ *
+ * Return: verdict
+ */
+static uint32_t pkt_class_test_legacy(qdf_nbuf_t nbuf,
+				      struct dp_pkt_class *cls)
+{
+	uint32_t verdict = 0;
+
+	qdf_mem_zero(cls, sizeof(*cls));
+
+	if (qdf_nbuf_is_ipv4_arp_pkt(nbuf))
+		verdict |= DP_PKT_CLASS_ARP;
+	else if (qdf_nbuf_is_ipv4_eapol_pkt(nbuf))
+		verdict |= DP_PKT_CLASS_EAPOL;
+
+	if (qdf_nbuf_is_ipv4_pkt(nbuf)) {
+		verdict |= DP_PKT_CLASS_IPV4;
+		if (qdf_nbuf_is_ipv4_fragment(nbuf))
+			verdict |= DP_PKT_CLASS_IPV4_FRAG;
+	} else if (qdf_nbuf_is_ipv6_pkt(nbuf)) {
+		verdict |= DP_PKT_CLASS_IPV6;
+	}
+
+	if (qdf_nbuf_is_icmp_pkt(nbuf)) {
+		verdict |= DP_PKT_CLASS_ICMP;
+		if (qdf_nbuf_data_is_icmpv4_req(nbuf))
+			verdict |= PKT_T_ICMP_REQ;
+		else if (qdf_nbuf_data_is_icmpv4_rsp(nbuf))
+			verdict |= PKT_T_ICMP_RSP;
+		cls->src_ip = qdf_nbuf_get_icmpv4_src_ip(nbuf);
+		cls->dst_ip = qdf_nbuf_get_icmpv4_tgt_ip(nbuf);
+	} else if (qdf_nbuf_is_icmpv6_pkt(nbuf)) {
+		verdict |= DP_PKT_CLASS_ICMPV6;
+		if (qdf_nbuf_get_icmpv6_subtype(nbuf) == QDF_PROTO_ICMPV6_REQ)
+			verdict |= PKT_T_ICMPV6_REQ;
+	} else if (qdf_nbuf_is_ipv4_tcp_pkt(nbuf)) {
+		verdict |= DP_PKT_CLASS_TCP;
+		if (qdf_nbuf_data_is_tcp_syn(nbuf))
+			verdict |= PKT_T_TCP_SYN;
+		else if (qdf_nbuf_data_is_tcp_syn_ack(nbuf))
+			verdict |= PKT_T_TCP_SYN_ACK;
+		else if (qdf_nbuf_data_is_tcp_ack(nbuf))
+			verdict |= PKT_T_TCP_ACK;
+		cls->src_port = qdf_nbuf_data_get_tcp_src_port(nbuf);
+		cls->dst_port = qdf_nbuf_data_get_tcp_dst_port(nbuf);
+	} else if (qdf_nbuf_is_ipv4_udp_pkt(nbuf)) {
+		verdict |= DP_PKT_CLASS_UDP;
+		if (qdf_nbuf_is_ipv4_dhcp_pkt(nbuf))
+			verdict |= DP_PKT_CLASS_DHCP;
+		else if (qdf_nbuf_data_is_dns_query(nbuf))
+			verdict |= DP_PKT_CLASS_DNS_QUERY;
+		else if (qdf_nbuf_data_is_dns_response(nbuf))
+			verdict |= DP_PKT_CLASS_DNS_RSP;
+	}
+
+	return verdict;
+}
+
+/**
+ * pkt_class_test_check() - check the classification of one frame
+ * @tf: frame description
+ * @nbuf: frame
+ *
+ * Return: number of errors
+ */
+static uint32_t pkt_class_test_check(const struct pkt_class_test_frame *tf,
+				     qdf_nbuf_t nbuf)
+{
+	struct dp_pkt_class cls, legacy_cls;
+	uint32_t verdict, legacy_verdict;
+	uint32_t errors = 0;
+
+	dp_pkt_classify(nbuf, &cls);
+	verdict = pkt_class_test_verdict(&cls);
+	if (verdict != tf->verdict) {
+		pkt_class_test_log("%s: verdict 0x%x, expected 0x%x",
+				   tf->name, verdict, tf->verdict);
+		errors++;
+	}
+
+	if (cls.flags & (DP_PKT_CLASS_TCP | DP_PKT_CLASS_UDP) &&
+	    (qdf_ntohs(cls.src_port) != tf->sport ||
+	     qdf_ntohs(cls.dst_port) != tf->dport)) {
+		pkt_class_test_log("%s: ports %u/%u, expected %u/%u", tf->name,
+				   qdf_ntohs(cls.src_port),
+				   qdf_ntohs(cls.dst_port),
+				   tf->sport, tf->dport);
+		errors++;
+	}
+
+	if (!tf->legacy)
+		return errors;
+
+	legacy_verdict = pkt_class_test_legacy(nbuf, &legacy_cls);
+	if (verdict != legacy_verdict) {
+		pkt_class_test_log("%s: verdict 0x%x, helpers 0x%x",
+				   tf->name, verdict, legacy_verdict);
+		errors++;
+	}
+
+	if ((cls.flags & DP_PKT_CLASS_ICMP &&
+	     (cls.src_ip != legacy_cls.src_ip ||
+	      cls.dst_ip != legacy_cls.dst_ip)) ||
+	    (cls.flags & DP_PKT_CLASS_TCP &&
+	     (cls.src_port != legacy_cls.src_port ||
+	      cls.dst_port != legacy_cls.dst_port))) {
+		pkt_class_test_log("%s: addresses differ from helpers",
+				   tf->name);
+		errors++;
+	}
+
+	return errors;
+}
+
+/**
+ * pkt_class_test_bench() - time the helper chain against the classifier
+ * @nbufs: frames
+ *
+ * Return: none
+ */
+static void pkt_class_test_bench(qdf_nbuf_t *nbufs)
+{
+	struct dp_pkt_class cls;
+	uint64_t start, elapsed_us[2];
+	uint32_t volatile sink = 0;
+	uint32_t r, i;
+
+	start = qdf_ktime_to_us(qdf_ktime_get());
+	for (r = 0; r < PKT_T_BENCH_ROUNDS; r++)
+		for (i = 0; i < PKT_T_NUM_FRAMES; i++)
+			sink += pkt_class_test_legacy(nbufs[i], &cls);
+	elapsed_us[0] = qdf_ktime_to_us(qdf_ktime_get()) - start;
+
+	start = qdf_ktime_to_us(qdf_ktime_get());
+	for (r = 0; r < PKT_T_BENCH_ROUNDS; r++) {
+		for (i = 0; i < PKT_T_NUM_FRAMES; i++) {
+			dp_pkt_classify(nbufs[i], &cls);
+			sink += cls.flags;
+		}
+	}
+	elapsed_us[1] = qdf_ktime_to_us(qdf_ktime_get()) - start;
+
+	pkt_class_test_log("bench: %u frames x %u rounds, helpers %llu us (%llu ns/pkt), classifier %llu us (%llu ns/pkt)",
+			   (uint32_t)PKT_T_NUM_FRAMES, PKT_T_BENCH_ROUNDS,
+			   elapsed_us[0],
+			   qdf_do_div(elapsed_us[0] * 1000,
+				      PKT_T_NUM_FRAMES * PKT_T_BENCH_ROUNDS),
+			   elapsed_us[1],
+			   qdf_do_div(elapsed_us[1] * 1000,
+				      PKT_T_NUM_FRAMES * PKT_T_BENCH_ROUNDS));
+}
+
+uint32_t dp_pkt_class_unit_test(void)
+{
+	qdf_nbuf_t nbufs[PKT_T_NUM_FRAMES] = { NULL };
+	uint8_t buf[PKT_T_FRAME_LEN];
+	uint32_t errors = 0;
+	uint32_t len, i;
+
+	for (i = 0; i < PKT_T_NUM_FRAMES; i++) {
+		nbufs[i] = qdf_nbuf_alloc(NULL, PKT_T_FRAME_LEN, 0, 4, false);
+		if (!nbufs[i]) {
+			errors++;
+			goto free;
+		}
+
+		len = pkt_class_test_build(&pkt_class_test_frames[i], buf);
+		qdf_nbuf_put_tail(nbufs[i], len);
+		qdf_mem_copy(qdf_nbuf_data(nbufs[i]), buf, len);
+
+		errors += pkt_class_test_check(&pkt_class_test_frames[i],
+					       nbufs[i]);
+	}
+
+	pkt_class_test_bench(nbufs);
+
+free:
+	for (i = 0; i < PKT_T_NUM_FRAMES; i++)
+		if (nbufs[i])
+			qdf_nbuf_free(nbufs[i]);
+
+	return errors;
+}
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "wlan_dp_main.h"
+#include "wlan_dp_stall_corr.h"
+#include "wlan_dp_stall_corr_test.h"
+#include "wlan_dp_stats_sampler.h"
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "qdf_util.h"
+
+#define sc_test_log(fmt, args...) \
+	qdf_nofl_info("dp_stall_corr_test: " fmt, ##args)
+
+#define SC_T_MAX_PHASES		3
+#define SC_T_BASE_MS		1000
+#define SC_T_INTERVAL_MS	100
+#define SC_T_BENCH_ROUNDS	10000
+#define SC_T_NO_CAUSE		DP_STALL_CAUSE_MAX
+
+#define SC_EV(ev)		BIT(DP_STALL_EV_ ## ev)
+
+/**
+ * struct sc_test_phase - stretch of a recorded trace with steady rates
+ * @ticks: sampling ticks in the stretch
+ * @tx: frames given to start_xmit per tick
+ * @dropped: frames dropped in start_xmit per tick
+ * @acked: frames acked per tick
+ * @rx: frames received per tick
+ * @tx_pending: outstanding TX descriptors
+ * @wmi_pending: pending WMI commands
+ * @pause_map: netdev queue pause reasons
+ * @bw: bus bandwidth vote
+ */
+struct sc_test_phase {
+	uint32_t ticks;
+	uint32_t tx;
+	uint32_t dropped;
+	uint32_t acked;
+	uint32_t rx;
+	uint32_t tx_pending;
+	uint32_t wmi_pending;
+	uint32_t pause_map;
+	uint32_t bw;
+};
+
+/**
+ * struct sc_test_case - recorded trace and the verdict expected on it
+ * @name: case name
+ * @trigger: event asking for the verdict
+ * @phases: trace, the stall covers the last DP_STALL_CORR_TAIL_MS
+ * @top: expected best supported cause, SC_T_NO_CAUSE for none
+ * @num_causes: expected number of causes scored
+ * @evidence: evidence that must be found
+ * @absent: evidence that must not be found
+ */
+struct sc_test_case {
+	const char *name;
+	enum dp_stall_trigger trigger;
+	struct sc_test_phase phases[SC_T_MAX_PHASES];
+	uint8_t top;
+	uint8_t num_causes;
+	uint32_t evidence;
+	uint32_t absent;
+};
+
+/*
+ * 45 ticks of baseline prime the history and fill it up to the 20 samples
+ * of the tail, which the last phases cover.
+ */
+static const struct sc_test_case sc_test_cases[] = {
+	{ "rx refill", DP_STALL_TRIGGER_FW_RX_REFILL,
+	  { { 45, 100, 0, 100, 200, 0, 0, 0, 4 },
+	    { 20, 20, 0, 20, 0, 0, 0, 0, 4 } },
+	  DP_STALL_CAUSE_RX_STARVATION, 1,
+	  SC_EV(RX_COLLAPSED) | SC_EV(TX_ACKED) | SC_EV(RX_REFILL),
+	  SC_EV(BW_DOWNVOTE) },
+	{ "tx desc", DP_STALL_TRIGGER_HOST,
+	  { { 45, 100, 0, 100, 200, 50, 0, 0, 4 },
+	    { 20, 60, 50, 0, 200, 1024, 0, 0, 4 } },
+	  DP_STALL_CAUSE_TX_DESC_EXHAUSTION, 1,
+	  SC_EV(TX_PENDING_STUCK) | SC_EV(TX_DROPPED) |
+	  SC_EV(TX_NO_COMPLETION),
+	  SC_EV(WMI_STUCK) | SC_EV(RX_COLLAPSED) },
+	{ "flow paused", DP_STALL_TRIGGER_HOST,
+	  { { 45, 100, 0, 100, 200, 0, 0, 0, 4 },
+	    { 20, 0, 0, 0, 20, 0, 0, 0x1, 4 } },
+	  DP_STALL_CAUSE_FLOW_PAUSED, 2,
+	  SC_EV(PAUSED_MOST) | SC_EV(PAUSED_ALL) |
+	  SC_EV(TX_CALLED_COLLAPSED),
+	  SC_EV(TX_NO_COMPLETION) },
+	{ "bus bw downvote", DP_STALL_TRIGGER_HOST,
+	  { { 43, 150, 0, 150, 300, 0, 0, 0, 6 },
+	    { 2, 150, 0, 150, 300, 0, 0, 0, 1 },
+	    { 20, 10, 0, 10, 5, 0, 0, 0, 1 } },
+	  DP_STALL_CAUSE_BUS_BW_DOWNVOTE, 2,
+	  SC_EV(BW_DOWNVOTE) | SC_EV(BW_BEFORE_COLLAPSE) |
+	  SC_EV(TPUT_COLLAPSED),
+	  0 },
+	{ "firmware", DP_STALL_TRIGGER_FW,
+	  { { 45, 100, 0, 100, 200, 0, 0, 0, 5 },
+	    { 3, 30, 0, 0, 0, 300, 4, 0, 5 },
+	    { 17, 30, 0, 0, 0, 300, 4, 0, 1 } },
+	  DP_STALL_CAUSE_FW, 4,
+	  SC_EV(WMI_STUCK) | SC_EV(TX_NO_COMPLETION) | SC_EV(FW_TRIGGER) |
+	  SC_EV(BW_DOWNVOTE),
+	  SC_EV(BW_BEFORE_COLLAPSE) },
+	{ "healthy", DP_STALL_TRIGGER_NUD,
+	  { { 65, 100, 0, 100, 200, 0, 0, 0, 4 } },
+	  SC_T_NO_CAUSE, 0,
+	  0,
+	  SC_EV(RX_COLLAPSED) | SC_EV(TPUT_COLLAPSED) | SC_EV(BW_DOWNVOTE) },
+};
+
+/**
+ * sc_test_replay() - replay a trace through the stats sampler
+ * @dp_intf: simulated interface
+ * @tc: test case
+ *
+ * Return: none
+ */
+static void sc_test_replay(struct wlan_dp_intf *dp_intf,
+			   const struct sc_test_case *tc)
+{
+	struct dp_tx_rx_stats *stats = &dp_intf->dp_stats.tx_rx_stats;
+	struct dp_stats_sampler_input input = {0};
+	const struct sc_test_phase *phase;
+	uint32_t p, t, cpu, tick = 0;
+
+	qdf_mem_zero(stats->per_cpu, sizeof(stats->per_cpu));
+	dp_stats_sampler_intf_init(dp_intf);
+
+	for (p = 0; p < SC_T_MAX_PHASES; p++) {
+		phase = &tc->phases[p];
+		for (t = 0; t < phase->ticks; t++, tick++) {
+			cpu = tick % NUM_CPUS;
+			stats->per_cpu[cpu].tx_called += phase->tx;
+			stats->per_cpu[cpu].tx_dropped += phase->dropped;
+			stats->per_cpu[cpu].rx_packets += phase->rx;
+			input.tx_acked += phase->acked;
+			input.tx_pending = phase->tx_pending;
+			input.wmi_pending = phase->wmi_pending;
+			input.pause_map = phase->pause_map;
+			dp_intf->dp_ctx->cur_vote_level = phase->bw;
+			dp_stats_sampler_intf_sample(dp_intf, SC_T_BASE_MS +
+						     tick * SC_T_INTERVAL_MS,
+						     &input);
+		}
+	}
+}
+
+/**
+ * sc_test_run_case() - check the verdict on a replayed trace
+ * @dp_intf: simulated interface
+ * @rec: scratch record
+ * @tc: test case
+ *
+ * Return: number of errors
+ */
+static uint32_t sc_test_run_case(struct wlan_dp_intf *dp_intf,
+				 struct dp_stats_snapshot_intf *rec,
+				 const struct sc_test_case *tc)
+{
+	struct dp_stall_verdict verdict;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	sc_test_replay(dp_intf, tc);
+	dp_stats_sampler_intf_read(dp_intf, rec);
+	dp_stall_corr_evaluate(rec, tc->trigger, &verdict);
+
+	if (verdict.num_causes != tc->num_causes ||
+	    (tc->top == SC_T_NO_CAUSE) != !verdict.num_causes ||
+	    (verdict.num_causes && verdict.ranked[0].cause != tc->top)) {
+		sc_test_log("%s: %u causes, top %u, expected %u causes, top %u",
+			    tc->name, verdict.num_causes,
+			    verdict.num_causes ? verdict.ranked[0].cause :
+			    SC_T_NO_CAUSE, tc->num_causes, tc->top);
+		errors++;
+	}
+
+	if ((verdict.evidence & tc->evidence) != tc->evidence ||
+	    verdict.evidence & tc->absent) {
+		sc_test_log("%s: evidence 0x%x, expected 0x%x without 0x%x",
+			    tc->name, verdict.evidence, tc->evidence,
+			    tc->absent);
+		errors++;
+	}
+
+	for (i = 1; i < verdict.num_causes; i++) {
+		if (verdict.ranked[i].score > verdict.ranked[i - 1].score) {
+			sc_test_log("%s: causes not ranked", tc->name);
+			errors++;
+			break;
+		}
+	}
+
+	for (i = 0; i < verdict.num_causes; i++)
+		sc_test_log("%s: #%u cause %u score %u evidence 0x%x",
+			    tc->name, i + 1, verdict.ranked[i].cause,
+			    verdict.ranked[i].score,
+			    verdict.ranked[i].evidence);
+
+	return errors;
+}
+
+/**
+ * sc_test_empty() - ask for a verdict without any history
+ * @rec: scratch record
+ *
+ * Only the trigger itself can be evidence.
+ *
+ * Return: number of errors
+ */
+static uint32_t sc_test_empty(struct dp_stats_snapshot_intf *rec)
+{
+	struct dp_stall_verdict verdict;
+
+	qdf_mem_zero(rec, sizeof(*rec));
+	dp_stall_corr_evaluate(rec, DP_STALL_TRIGGER_FW, &verdict);
+	if (verdict.num_causes != 1 ||
+	    verdict.ranked[0].cause != DP_STALL_CAUSE_FW ||
+	    verdict.evidence != SC_EV(FW_TRIGGER)) {
+		sc_test_log("empty: %u causes, evidence 0x%x",
+			    verdict.num_causes, verdict.evidence);
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * sc_test_bench() - time the evaluation of a full history
+ * @dp_intf: simulated interface
+ * @rec: scratch record
+ *
+ * Return: none
+ */
+static void sc_test_bench(struct wlan_dp_intf *dp_intf,
+			  struct dp_stats_snapshot_intf *rec)
+{
+	const struct sc_test_case *tc =
+		&sc_test_cases[QDF_ARRAY_SIZE(sc_test_cases) - 2];
+	struct dp_stall_verdict verdict;
+	uint64_t start, elapsed_us;
+	uint32_t volatile sink = 0;
+	uint32_t r;
+
+	sc_test_replay(dp_intf, tc);
+	dp_stats_sampler_intf_read(dp_intf, rec);
+
+	start = qdf_ktime_to_us(qdf_ktime_get());
+	for (r = 0; r < SC_T_BENCH_ROUNDS; r++) {
+		dp_stall_corr_evaluate(rec, tc->trigger, &verdict);
+		sink += verdict.evidence;
+	}
+	elapsed_us = qdf_ktime_to_us(qdf_ktime_get()) - start;
+
+	sc_test_log("bench %s: %u rounds over %u samples, %llu us (%llu ns/verdict)",
+		    tc->name, SC_T_BENCH_ROUNDS, rec->num_samples, elapsed_us,
+		    qdf_do_div(elapsed_us * 1000, SC_T_BENCH_ROUNDS));
+}
+
+uint32_t dp_stall_corr_unit_test(void)
+{
+	struct wlan_dp_psoc_context *dp_ctx;
+	struct wlan_dp_intf *dp_intf;
+	struct dp_stats_snapshot_intf *rec;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	dp_ctx = qdf_mem_malloc(sizeof(*dp_ctx));
+	dp_intf = qdf_mem_malloc(sizeof(*dp_intf));
+	rec = qdf_mem_malloc(sizeof(*rec));
+	if (!dp_ctx || !dp_intf || !rec) {
+		errors = 1;
+		goto free;
+	}
+
+	dp_intf->dp_ctx = dp_ctx;
+	dp_intf->device_mode = QDF_STA_MODE;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(sc_test_cases); i++)
+		errors += sc_test_run_case(dp_intf, rec, &sc_test_cases[i]);
+
+	errors += sc_test_empty(rec);
+	sc_test_bench(dp_intf, rec);
+
+free:
+	if (rec)
+		qdf_mem_free(rec);
+	if (dp_intf)
+		qdf_mem_free(dp_intf);
+	if (dp_ctx)
+		qdf_mem_free(dp_ctx);
+
+	return errors;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __WLAN_DP_STALL_CORR_TEST
+#define __WLAN_DP_STALL_CORR_TEST
+
+#ifdef WLAN_DP_STALL_CORR_TEST
+/**
+ * dp_stall_corr_unit_test() - replay recorded stalls through the correlator
+ *
+ * Replays counter traces of RX refill failures, TX descriptor exhaustion,
+ * paused queues, a bus bandwidth downvote, a stuck firmware and a healthy
+ * link through the stats sampler, and checks the ranked causes and the
+ * evidence of the verdict on each. Logs the cost of an evaluation.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t dp_stall_corr_unit_test(void);
+#else
+static inline uint32_t dp_stall_corr_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_DP_STALL_CORR_TEST */
+
+#endif /* __WLAN_DP_STALL_CORR_TEST */
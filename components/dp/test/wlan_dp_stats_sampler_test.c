@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "wlan_dp_main.h"
+#include "wlan_dp_stats_sampler.h"
+#include "wlan_dp_stats_sampler_test.h"
+#include "qdf_lock.h"
+#include "qdf_list.h"
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "qdf_util.h"
+
+#define st_test_log(fmt, args...) \
+	qdf_nofl_info("dp_stats_sampler_test: " fmt, ##args)
+
+#define ST_T_TICKS		(DP_STATS_SAMPLER_HIST_LEN * 2 + 3)
+#define ST_T_BASE_MS		1000
+#define ST_T_INTERVAL_MS	100
+#define ST_T_VOTE_LEVEL		3
+#define ST_T_BENCH_ROUNDS	10000
+
+/**
+ * struct st_test_buf - snapshot collected through the snapshot callback
+ * @data: snapshot bytes
+ * @len: bytes collected
+ * @size: size of @data
+ * @overflow: snapshot did not fit in @data
+ */
+struct st_test_buf {
+	uint8_t *data;
+	uint32_t len;
+	uint32_t size;
+	bool overflow;
+};
+
+/**
+ * st_test_count() - bump the per CPU counters for one interval
+ * @dp_intf: simulated interface
+ * @input: sampler input to update
+ * @tick: sampling tick the interval ends on
+ *
+ * Counter increments are a function of @tick and are spread over the CPUs
+ * so the sampler has to sum them.
+ *
+ * Return: none
+ */
+static void st_test_count(struct wlan_dp_intf *dp_intf,
+			  struct dp_stats_sampler_input *input, uint32_t tick)
+{
+	struct dp_tx_rx_stats *stats = &dp_intf->dp_stats.tx_rx_stats;
+	uint32_t tx_cpu = tick % NUM_CPUS;
+	uint32_t rx_cpu = (tick + 1) % NUM_CPUS;
+
+	stats->per_cpu[tx_cpu].tx_called += tick;
+	stats->per_cpu[tx_cpu].tx_dropped += tick % 3;
+	stats->per_cpu[tx_cpu].tx_orphaned += tick % 2;
+	stats->per_cpu[rx_cpu].rx_packets += 2 * tick;
+	stats->per_cpu[rx_cpu].rx_dropped += tick % 5;
+	stats->per_cpu[rx_cpu].rx_delivered += 2 * tick - tick % 5;
+	stats->per_cpu[rx_cpu].rx_refused += tick % 7;
+
+	input->tx_acked += tick - tick % 3;
+	input->tx_pending = tick;
+	input->wmi_pending = tick % 4;
+	input->pause_map = tick & 1;
+}
+
+/**
+ * st_test_check_sample() - compare a sample against st_test_count()
+ * @sample: sample read back
+ * @seq: sequence number of the sample
+ *
+ * Sample @seq is taken on tick @seq + 1, the first tick only primes the
+ * totals.
+ *
+ * Return: true if the sample is as expected
+ */
+static bool st_test_check_sample(struct dp_stats_sample *sample, uint32_t seq)
+{
+	uint32_t tick = seq + 1;
+
+	return sample->timestamp_ms == ST_T_BASE_MS + tick * ST_T_INTERVAL_MS &&
+	       sample->interval_ms == ST_T_INTERVAL_MS &&
+	       sample->tx_called == tick &&
+	       sample->tx_dropped == tick % 3 &&
+	       sample->tx_orphaned == tick % 2 &&
+	       sample->rx_packets == 2 * tick &&
+	       sample->rx_dropped == tick % 5 &&
+	       sample->rx_delivered == 2 * tick - tick % 5 &&
+	       sample->rx_refused == tick % 7 &&
+	       sample->bus_bw_level == ST_T_VOTE_LEVEL &&
+	       sample->tx_acked == tick - tick % 3 &&
+	       sample->tx_pending == tick &&
+	       sample->wmi_pending == tick % 4 &&
+	       sample->pause_map == (tick & 1);
+}
+
+/**
+ * st_test_history() - sample past the history length, reading every time
+ * @dp_intf: simulated interface
+ * @rec: scratch record
+ *
+ * Return: number of errors
+ */
+static uint32_t st_test_history(struct wlan_dp_intf *dp_intf,
+				struct dp_stats_snapshot_intf *rec)
+{
+	struct dp_stats_sampler_input input = {0};
+	uint32_t errors = 0;
+	uint32_t tick, num, expected, first, j;
+
+	for (tick = 0; tick < ST_T_TICKS; tick++) {
+		st_test_count(dp_intf, &input, tick);
+		dp_stats_sampler_intf_sample(dp_intf, ST_T_BASE_MS +
+					     tick * ST_T_INTERVAL_MS, &input);
+
+		num = dp_stats_sampler_intf_read(dp_intf, rec);
+		expected = qdf_min(tick, (uint32_t)DP_STATS_SAMPLER_HIST_LEN);
+		if (num != expected || rec->num_samples != num ||
+		    rec->seq_end != tick) {
+			st_test_log("tick %u: %u samples up to %u, expected %u up to %u",
+				    tick, num, rec->seq_end, expected, tick);
+			errors++;
+			continue;
+		}
+
+		first = rec->seq_end - num;
+		for (j = 0; j < num; j++) {
+			if (!st_test_check_sample(&rec->samples[j],
+						  first + j)) {
+				st_test_log("tick %u: sample %u is wrong",
+					    tick, first + j);
+				errors++;
+				break;
+			}
+		}
+	}
+
+	if (qdf_mem_cmp(rec->mac_addr, dp_intf->mac_addr.bytes,
+			QDF_MAC_ADDR_SIZE) ||
+	    rec->device_mode != dp_intf->device_mode) {
+		st_test_log("interface identity not copied");
+		errors++;
+	}
+
+	return errors;
+}
+
+/**
+ * st_test_clear() - clear the counters between two samples
+ * @dp_intf: simulated interface
+ * @rec: scratch record
+ *
+ * Return: number of errors
+ */
+static uint32_t st_test_clear(struct wlan_dp_intf *dp_intf,
+			      struct dp_stats_snapshot_intf *rec)
+{
+	struct dp_tx_rx_stats *stats = &dp_intf->dp_stats.tx_rx_stats;
+	struct dp_stats_sampler_input input = {0};
+	struct dp_stats_sample *newest;
+	uint32_t num;
+
+	qdf_mem_zero(stats->per_cpu, sizeof(stats->per_cpu));
+	stats->per_cpu[0].tx_called = 5;
+	stats->per_cpu[0].rx_packets = 7;
+	dp_stats_sampler_intf_sample(dp_intf, ST_T_BASE_MS +
+				     ST_T_TICKS * ST_T_INTERVAL_MS, &input);
+
+	num = dp_stats_sampler_intf_read(dp_intf, rec);
+	if (num != DP_STATS_SAMPLER_HIST_LEN) {
+		st_test_log("clear: %u samples", num);
+		return 1;
+	}
+
+	newest = &rec->samples[num - 1];
+	if (newest->tx_called != 5 ||
+	    newest->rx_packets != 7 || newest->rx_delivered) {
+		st_test_log("clear: tx %u rx %u delivered %u",
+			    newest->tx_called, newest->rx_packets,
+			    newest->rx_delivered);
+		return 1;
+	}
+
+	return 0;
+}
+
+static void st_test_collect(void *ctx, const uint8_t *buf, uint32_t len)
+{
+	struct st_test_buf *snap = ctx;
+
+	if (len > snap->size - snap->len) {
+		snap->overflow = true;
+		return;
+	}
+
+	qdf_mem_copy(snap->data + snap->len, buf, len);
+	snap->len += len;
+}
+
+/**
+ * st_test_snapshot() - check the binary snapshot of two interfaces
+ * @dp_ctx: simulated DP context holding the interfaces
+ * @sampled: interface with a full history
+ * @idle: interface without samples
+ *
+ * Return: number of errors
+ */
+static uint32_t st_test_snapshot(struct wlan_dp_psoc_context *dp_ctx,
+				 struct wlan_dp_intf *sampled,
+				 struct wlan_dp_intf *idle)
+{
+	struct dp_stats_snapshot_hdr *hdr;
+	struct dp_stats_snapshot_intf *rec;
+	struct wlan_dp_intf *dp_intf;
+	struct st_test_buf snap = { 0 };
+	uint32_t errors = 0;
+	uint32_t off, expected;
+
+	snap.size = sizeof(*hdr) + 3 * sizeof(*rec);
+	snap.data = qdf_mem_malloc(snap.size);
+	if (!snap.data)
+		return 1;
+
+	if (QDF_IS_STATUS_ERROR(dp_stats_sampler_snapshot(dp_ctx,
+							  st_test_collect,
+							  &snap))) {
+		st_test_log("snapshot failed");
+		errors++;
+		goto free;
+	}
+
+	hdr = (struct dp_stats_snapshot_hdr *)snap.data;
+	if (snap.overflow || snap.len != sizeof(*hdr) + 2 * sizeof(*rec) ||
+	    hdr->magic != DP_STATS_SNAPSHOT_MAGIC ||
+	    hdr->version != DP_STATS_SNAPSHOT_VERSION ||
+	    hdr->hdr_len != sizeof(*hdr) || hdr->intf_len != sizeof(*rec) ||
+	    hdr->sample_len != sizeof(struct dp_stats_sample) ||
+	    hdr->hist_len != DP_STATS_SAMPLER_HIST_LEN ||
+	    hdr->interval_ms != ST_T_INTERVAL_MS) {
+		st_test_log("snapshot of %u bytes has a bad header", snap.len);
+		errors++;
+		goto free;
+	}
+
+	for (off = hdr->hdr_len; off < snap.len; off += hdr->intf_len) {
+		rec = (struct dp_stats_snapshot_intf *)(snap.data + off);
+		if (!qdf_mem_cmp(rec->mac_addr, sampled->mac_addr.bytes,
+				 QDF_MAC_ADDR_SIZE)) {
+			dp_intf = sampled;
+			expected = DP_STATS_SAMPLER_HIST_LEN;
+		} else {
+			dp_intf = idle;
+			expected = 0;
+		}
+
+		if (qdf_mem_cmp(rec->mac_addr, dp_intf->mac_addr.bytes,
+				QDF_MAC_ADDR_SIZE) ||
+		    rec->num_samples != expected ||
+		    (expected && rec->samples[expected - 1].tx_called != 5)) {
+			st_test_log("record at %u: %u samples, expected %u",
+				    off, rec->num_samples, expected);
+			errors++;
+		}
+	}
+
+free:
+	qdf_mem_free(snap.data);
+
+	return errors;
+}
+
+/**
+ * st_test_bench() - time a sample and a history read
+ * @dp_intf: simulated interface
+ * @rec: scratch record
+ *
+ * Return: none
+ */
+static void st_test_bench(struct wlan_dp_intf *dp_intf,
+			  struct dp_stats_snapshot_intf *rec)
+{
+	uint64_t start, elapsed_us[2];
+	uint64_t now_ms = ST_T_BASE_MS + ST_T_TICKS * ST_T_INTERVAL_MS;
+	struct dp_stats_sampler_input input = {0};
+	uint32_t volatile sink = 0;
+	uint32_t r;
+
+	start = qdf_ktime_to_us(qdf_ktime_get());
+	for (r = 0; r < ST_T_BENCH_ROUNDS; r++) {
+		now_ms += ST_T_INTERVAL_MS;
+		dp_stats_sampler_intf_sample(dp_intf, now_ms, &input);
+	}
+	elapsed_us[0] = qdf_ktime_to_us(qdf_ktime_get()) - start;
+
+	start = qdf_ktime_to_us(qdf_ktime_get());
+	for (r = 0; r < ST_T_BENCH_ROUNDS; r++)
+		sink += dp_stats_sampler_intf_read(dp_intf, rec);
+	elapsed_us[1] = qdf_ktime_to_us(qdf_ktime_get()) - start;
+
+	st_test_log("bench: %u rounds, %u CPUs, sample %llu us (%llu ns/sample), read of %u samples %llu us (%llu ns/read)",
+		    ST_T_BENCH_ROUNDS, (uint32_t)NUM_CPUS, elapsed_us[0],
+		    qdf_do_div(elapsed_us[0] * 1000, ST_T_BENCH_ROUNDS),
+		    (uint32_t)DP_STATS_SAMPLER_HIST_LEN, elapsed_us[1],
+		    qdf_do_div(elapsed_us[1] * 1000, ST_T_BENCH_ROUNDS));
+}
+
+uint32_t dp_stats_sampler_unit_test(void)
+{
+	struct wlan_dp_psoc_context *dp_ctx;
+	struct wlan_dp_intf *intfs[2] = { NULL };
+	struct dp_stats_snapshot_intf *rec;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	dp_ctx = qdf_mem_malloc(sizeof(*dp_ctx));
+	rec = qdf_mem_malloc(sizeof(*rec));
+	for (i = 0; i < QDF_ARRAY_SIZE(intfs); i++)
+		intfs[i] = qdf_mem_malloc(sizeof(*intfs[i]));
+	if (!dp_ctx || !rec || !intfs[0] || !intfs[1]) {
+		errors = 1;
+		goto free;
+	}
+
+	dp_ctx->cur_vote_level = ST_T_VOTE_LEVEL;
+	dp_ctx->dp_cfg.stats_sample_interval = ST_T_INTERVAL_MS;
+	qdf_spinlock_create(&dp_ctx->intf_list_lock);
+	qdf_list_create(&dp_ctx->intf_list, 0);
+
+	for (i = 0; i < QDF_ARRAY_SIZE(intfs); i++) {
+		intfs[i]->dp_ctx = dp_ctx;
+		intfs[i]->device_mode = i ? QDF_SAP_MODE : QDF_STA_MODE;
+		intfs[i]->mac_addr.bytes[0] = 0x02;
+		intfs[i]->mac_addr.bytes[5] = i + 1;
+		dp_stats_sampler_intf_init(intfs[i]);
+		qdf_list_insert_back(&dp_ctx->intf_list, &intfs[i]->node);
+	}
+
+	errors += st_test_history(intfs[0], rec);
+	errors += st_test_clear(intfs[0], rec);
+	errors += st_test_snapshot(dp_ctx, intfs[0], intfs[1]);
+	st_test_bench(intfs[0], rec);
+
+	for (i = 0; i < QDF_ARRAY_SIZE(intfs); i++)
+		qdf_list_remove_node(&dp_ctx->intf_list, &intfs[i]->node);
+	qdf_list_destroy(&dp_ctx->intf_list);
+	qdf_spinlock_destroy(&dp_ctx->intf_list_lock);
+
+free:
+	for (i = 0; i < QDF_ARRAY_SIZE(intfs); i++)
+		if (intfs[i])
+			qdf_mem_free(intfs[i]);
+	if (rec)
+		qdf_mem_free(rec);
+	if (dp_ctx)
+		qdf_mem_free(dp_ctx);
+
+	return errors;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __WLAN_DP_STATS_SAMPLER_TEST
+#define __WLAN_DP_STATS_SAMPLER_TEST
+
+#ifdef WLAN_DP_STATS_SAMPLER_TEST
+/**
+ * dp_stats_sampler_unit_test() - check the DP stats sampler history
+ *
+ * Drives the per CPU counters of simulated interfaces through more samples
+ * than the history holds and checks the deltas, ordering and sequence of
+ * every read, the handling of cleared counters and the layout of the binary
+ * snapshot, and logs the cost of a sample and of a history read.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t dp_stats_sampler_unit_test(void);
+#else
+static inline uint32_t dp_stats_sampler_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_DP_STATS_SAMPLER_TEST */
+
+#endif /* __WLAN_DP_STATS_SAMPLER_TEST */
@@ -718,6 +718,7 @@ QDF_STATUS p2p_psoc_object_open(struct wlan_objmgr_psoc *soc)
 {
 	QDF_STATUS status;
 	struct p2p_soc_priv_obj *p2p_soc_obj;
+	uint8_t i;
 
 	if (!soc) {
 		p2p_err("psoc context passed is NULL");
@@ -751,6 +752,8 @@ QDF_STATUS p2p_psoc_object_open(struct wlan_objmgr_psoc *soc)
 	qdf_runtime_lock_init(&p2p_soc_obj->roc_runtime_lock);
 	p2p_soc_obj->cur_roc_vdev_id = P2P_INVALID_VDEV_ID;
 	qdf_idr_create(&p2p_soc_obj->p2p_idr);
+	for (i = 0; i < MAX_QUEUE_LENGTH; i++)
+		p2p_soc_obj->roc_timer_data[i].p2p_soc_obj = p2p_soc_obj;
 
 	p2p_debug("p2p psoc object open successful");
 
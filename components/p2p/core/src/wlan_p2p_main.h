@@ -222,6 +222,54 @@ struct p2p_param {
 	bool indoor_channel_support;
 };
 
+/**
+ * struct p2p_roc_stats - RoC scheduling and group formation statistics
+ * @num_dwell:          Number of RoC dwells issued to scan component
+ * @num_coalesced:      Number of RoC requests merged into another dwell
+ * @num_dwell_extend:   Number of times a dwell was extended by a merge
+ * @num_pipelined:      Number of RoC scans issued while previous dwell
+ *                      was still active
+ * @num_ready:          Number of RoC requests which got on channel
+ * @ready_latency_sum:  Sum of request to on channel latency in ms
+ * @ready_latency_max:  Max request to on channel latency in ms
+ * @gf_start_ts:        Timestamp in ms of first frame of the ongoing group
+ *                      formation, 0 if none in progress
+ * @gf_start_dwell:     @num_dwell when the ongoing group formation started
+ * @num_gf:             Number of completed group formations
+ * @gf_latency_last:    Latency of the last group formation in ms
+ * @gf_latency_sum:     Sum of group formation latency in ms
+ * @gf_latency_max:     Max group formation latency in ms
+ */
+struct p2p_roc_stats {
+	uint32_t num_dwell;
+	uint32_t num_coalesced;
+	uint32_t num_dwell_extend;
+	uint32_t num_pipelined;
+	uint32_t num_ready;
+	uint64_t ready_latency_sum;
+	uint32_t ready_latency_max;
+	uint64_t gf_start_ts;
+	uint32_t gf_start_dwell;
+	uint32_t num_gf;
+	uint32_t gf_latency_last;
+	uint64_t gf_latency_sum;
+	uint32_t gf_latency_max;
+};
+
+/**
+ * struct p2p_roc_timer_data - Data passed to a roc timer
+ * @p2p_soc_obj: p2p psoc private object
+ * @roc_id:      id of the roc context the timer is armed for
+ *
+ * The roc timer expiry is delivered as a scheduler message which may be
+ * processed after the roc context is freed, so the timer identifies its
+ * roc context by id instead of by pointer.
+ */
+struct p2p_roc_timer_data {
+	struct p2p_soc_priv_obj *p2p_soc_obj;
+	int32_t roc_id;
+};
+
 /**
  * struct p2p_soc_priv_obj - Per SoC p2p private object
  * @soc:              Pointer to SoC context
@@ -239,6 +287,9 @@ struct p2p_param {
  * @cur_roc_vdev_id:  Vdev id of current roc
  * @p2p_idr:          p2p idr
  * @param:            p2p parameters to be used
+ * @roc_stats:        RoC scheduling and group formation statistics
+ * @roc_timer_data:   Data of the roc timers, used round robin
+ * @roc_timer_data_idx: Next entry of @roc_timer_data to use
  * @connection_status:Global P2P connection status
  * @mcc_quota_ev_os_if_cb:  callback to OS IF to indicate mcc quota event
  */
@@ -256,6 +307,9 @@ struct p2p_soc_priv_obj {
 	uint32_t cur_roc_vdev_id;
 	qdf_idr p2p_idr;
 	struct p2p_param param;
+	struct p2p_roc_stats roc_stats;
+	struct p2p_roc_timer_data roc_timer_data[MAX_QUEUE_LENGTH];
+	uint8_t roc_timer_data_idx;
 #ifdef WLAN_FEATURE_P2P_DEBUG
 	enum p2p_connection_status connection_status;
 #endif
@@ -1018,6 +1018,61 @@ static QDF_STATUS p2p_rx_update_connection_status(
 }
 #endif
 
+/**
+ * p2p_update_group_formation_stats() - Update group formation latency
+ * @p2p_soc_obj:        P2P soc private object
+ * @frame_info:         frame information of tx or rx frame
+ *
+ * Group formation is timed from the first provision discovery, GO
+ * negotiation or invitation request to the GO negotiation confirm or
+ * invitation response, in either direction.
+ *
+ * Return: None
+ */
+static void p2p_update_group_formation_stats(
+	struct p2p_soc_priv_obj *p2p_soc_obj,
+	struct p2p_frame_info *frame_info)
+{
+	struct p2p_roc_stats *stats = &p2p_soc_obj->roc_stats;
+	uint64_t now = qdf_get_system_timestamp();
+	uint32_t latency;
+
+	switch (frame_info->public_action_type) {
+	case P2P_PUBLIC_ACTION_PROV_DIS_REQ:
+	case P2P_PUBLIC_ACTION_NEG_REQ:
+	case P2P_PUBLIC_ACTION_INVIT_REQ:
+		if (stats->gf_start_ts &&
+		    now - stats->gf_start_ts < P2P_GROUP_FORMATION_TIMEOUT)
+			break;
+		stats->gf_start_ts = now;
+		stats->gf_start_dwell = stats->num_dwell;
+		break;
+	case P2P_PUBLIC_ACTION_NEG_CNF:
+	case P2P_PUBLIC_ACTION_INVIT_RSP:
+		if (!stats->gf_start_ts)
+			break;
+		latency = now - stats->gf_start_ts;
+		stats->gf_start_ts = 0;
+		stats->num_gf++;
+		stats->gf_latency_last = latency;
+		stats->gf_latency_sum += latency;
+		if (latency > stats->gf_latency_max)
+			stats->gf_latency_max = latency;
+		p2p_info("group formation %u ms, %u dwells, avg %llu max %u ms; roc ready avg %llu max %u ms, coalesced %u extended %u pipelined %u",
+			 latency, stats->num_dwell - stats->gf_start_dwell,
+			 qdf_do_div(stats->gf_latency_sum, stats->num_gf),
+			 stats->gf_latency_max,
+			 stats->num_ready ?
+			 qdf_do_div(stats->ready_latency_sum,
+				    stats->num_ready) : 0,
+			 stats->ready_latency_max, stats->num_coalesced,
+			 stats->num_dwell_extend, stats->num_pipelined);
+		break;
+	default:
+		break;
+	}
+}
+
 /**
  * p2p_packet_alloc() - allocate qdf nbuf
  * @size:         buffe size
@@ -1316,16 +1371,23 @@ static QDF_STATUS p2p_roc_req_for_tx_action(
 	p2p_debug("create roc request for off channel tx, tx ctx:%pK, roc ctx:%pK",
 		tx_ctx, roc_ctx);
 
-	status = p2p_process_roc_req(roc_ctx);
+	/*
+	 * Queue the tx context first, the roc request may be merged into a
+	 * dwell which is already on channel and send the frame right away.
+	 */
+	status = qdf_list_insert_back(&p2p_soc_obj->tx_q_roc,
+		&tx_ctx->node);
 	if (status != QDF_STATUS_SUCCESS) {
-		p2p_err("request roc for tx action frrame fail");
+		p2p_err("Failed to insert off chan tx context to wait roc req queue");
+		qdf_mem_free(roc_ctx);
 		return status;
 	}
 
-	status = qdf_list_insert_back(&p2p_soc_obj->tx_q_roc,
-		&tx_ctx->node);
-	if (status != QDF_STATUS_SUCCESS)
-		p2p_err("Failed to insert off chan tx context to wait roc req queue");
+	status = p2p_process_roc_req(roc_ctx);
+	if (status != QDF_STATUS_SUCCESS) {
+		p2p_err("request roc for tx action frrame fail");
+		qdf_list_remove_node(&p2p_soc_obj->tx_q_roc, &tx_ctx->node);
+	}
 
 	return status;
 }
@@ -3204,6 +3266,7 @@ QDF_STATUS p2p_process_mgmt_tx(struct tx_action_context *tx_ctx)
 	mac_to = &(tx_ctx->buf[DST_MAC_ADDR_OFFSET]);
 	p2p_tx_update_connection_status(p2p_soc_obj,
 		&(tx_ctx->frame_info), mac_to);
+	p2p_update_group_formation_stats(p2p_soc_obj, &tx_ctx->frame_info);
 
 	status = p2p_vdev_check_valid(tx_ctx);
 	if (status != QDF_STATUS_SUCCESS) {
@@ -3451,6 +3514,7 @@ QDF_STATUS p2p_process_rx_mgmt(
 		mac_from = &(rx_mgmt->buf[SRC_MAC_ADDR_OFFSET]);
 		p2p_rx_update_connection_status(p2p_soc_obj,
 						&frame_info, mac_from);
+		p2p_update_group_formation_stats(p2p_soc_obj, &frame_info);
 
 		p2p_debug("action_sub_type %u, action_type %d",
 				frame_info.public_action_type,
@@ -52,6 +52,7 @@
 #define P2P_ACTION_FRAME_RSP_WAIT               500
 #define P2P_ACTION_FRAME_ACK_WAIT               300
 #define P2P_ACTION_FRAME_TX_TIMEOUT             2000
+#define P2P_GROUP_FORMATION_TIMEOUT             15000
 
 #define DST_MAC_ADDR_OFFSET  4
 #define SRC_MAC_ADDR_OFFSET  (DST_MAC_ADDR_OFFSET + QDF_MAC_ADDR_SIZE)
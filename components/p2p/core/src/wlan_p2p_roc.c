@@ -68,6 +68,36 @@ static QDF_STATUS p2p_mgmt_rx_ops(struct wlan_objmgr_psoc *psoc,
 	return status;
 }
 
+/**
+ * p2p_roc_dwell_time() - Get dwell time needed by a roc request
+ * @roc_ctx: remain on channel request
+ *
+ * The dwell has to cover the roc request itself and every request which
+ * has been merged into it.
+ *
+ * Return: dwell time in ms
+ */
+static uint32_t p2p_roc_dwell_time(struct p2p_roc_context *roc_ctx)
+{
+	struct p2p_soc_priv_obj *p2p_soc_obj = roc_ctx->p2p_soc_obj;
+	struct p2p_roc_context *guest;
+	qdf_list_node_t *p_node;
+	uint32_t dwell = roc_ctx->duration;
+	QDF_STATUS status;
+
+	status = qdf_list_peek_front(&p2p_soc_obj->roc_q, &p_node);
+	while (QDF_IS_STATUS_SUCCESS(status)) {
+		guest = qdf_container_of(p_node,
+				struct p2p_roc_context, node);
+		if (guest->host_roc == roc_ctx && guest->duration > dwell)
+			dwell = guest->duration;
+		status = qdf_list_peek_next(&p2p_soc_obj->roc_q,
+						p_node, &p_node);
+	}
+
+	return dwell;
+}
+
 /**
  * p2p_scan_start() - Start scan
  * @roc_ctx: remain on channel request
@@ -120,7 +150,7 @@ static QDF_STATUS p2p_scan_start(struct p2p_roc_context *roc_ctx)
 	req->scan_req.scan_req_id = p2p_soc_obj->scan_req_id;
 	req->scan_req.chan_list.num_chan = 1;
 	req->scan_req.chan_list.chan[0].freq = roc_ctx->chan_freq;
-	req->scan_req.dwell_time_passive = roc_ctx->duration;
+	req->scan_req.dwell_time_passive = p2p_roc_dwell_time(roc_ctx);
 	req->scan_req.dwell_time_active = 0;
 	req->scan_req.scan_priority = SCAN_PRIORITY_HIGH;
 	req->scan_req.num_bssid = 1;
@@ -197,8 +227,11 @@ static QDF_STATUS p2p_scan_start(struct p2p_roc_context *roc_ctx)
 	}
 	p2p_debug("FW requested roc duration is:%d",
 		  req->scan_req.dwell_time_passive);
+	roc_ctx->fw_dwell = req->scan_req.dwell_time_passive;
 
 	status = wlan_scan_start(req);
+	if (QDF_IS_STATUS_SUCCESS(status))
+		p2p_soc_obj->roc_stats.num_dwell++;
 
 	p2p_debug("start scan, scan req id:%d, scan id:%d, status:%d",
 		p2p_soc_obj->scan_req_id, roc_ctx->scan_id, status);
@@ -295,12 +328,40 @@ static QDF_STATUS p2p_send_roc_event(
 
 	p2p_debug("roc_event: %d, cookie:%llx", p2p_evt.roc_event,
 		  p2p_evt.cookie);
+	if (evt == ROC_EVENT_READY_ON_CHAN)
+		roc_ctx->served = true;
 
 	start_param->event_cb(start_param->event_cb_data, &p2p_evt);
 
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * p2p_detach_roc_guests() - Detach requests merged into a roc request
+ * @roc_ctx: remain on channel request
+ *
+ * Detached requests stay queued and run their own dwell in queue order.
+ *
+ * Return: None
+ */
+static void p2p_detach_roc_guests(struct p2p_roc_context *roc_ctx)
+{
+	struct p2p_soc_priv_obj *p2p_soc_obj = roc_ctx->p2p_soc_obj;
+	struct p2p_roc_context *guest;
+	qdf_list_node_t *p_node;
+	QDF_STATUS status;
+
+	status = qdf_list_peek_front(&p2p_soc_obj->roc_q, &p_node);
+	while (QDF_IS_STATUS_SUCCESS(status)) {
+		guest = qdf_container_of(p_node,
+				struct p2p_roc_context, node);
+		if (guest->host_roc == roc_ctx)
+			guest->host_roc = NULL;
+		status = qdf_list_peek_next(&p2p_soc_obj->roc_q,
+						p_node, &p_node);
+	}
+}
+
 /**
  * p2p_destroy_roc_ctx() - destroy roc ctx
  * @roc_ctx:            remain on channel request
@@ -323,7 +384,7 @@ static QDF_STATUS p2p_destroy_roc_ctx(struct p2p_roc_context *roc_ctx,
 		  roc_ctx->vdev_id, roc_ctx->chan_freq, roc_ctx->duration);
 
 	if (up_layer_event) {
-		if (roc_ctx->roc_state < ROC_STATE_ON_CHAN)
+		if (roc_ctx->roc_state < ROC_STATE_ON_CHAN && !roc_ctx->served)
 			p2p_send_roc_event(roc_ctx, ROC_EVENT_READY_ON_CHAN);
 		p2p_send_roc_event(roc_ctx, ROC_EVENT_COMPLETED);
 	}
@@ -335,6 +396,8 @@ static QDF_STATUS p2p_destroy_roc_ctx(struct p2p_roc_context *roc_ctx,
 			p2p_err("Failed to remove roc req, status %d", status);
 	}
 
+	p2p_detach_roc_guests(roc_ctx);
+
 	qdf_idr_remove(&p2p_soc_obj->p2p_idr, roc_ctx->id);
 	qdf_mem_free(roc_ctx);
 
@@ -369,7 +432,8 @@ static QDF_STATUS p2p_execute_cancel_roc_req(
 		p2p_err("Failed to abort scan, status:%d, destroy roc %pK",
 			status, roc_ctx);
 		qdf_mc_timer_destroy(&roc_ctx->roc_timer);
-		p2p_mgmt_rx_ops(p2p_soc_obj->soc, false);
+		if (!roc_ctx->pipelined)
+			p2p_mgmt_rx_ops(p2p_soc_obj->soc, false);
 		p2p_destroy_roc_ctx(roc_ctx, true, true);
 		return status;
 	}
@@ -377,30 +441,69 @@ static QDF_STATUS p2p_execute_cancel_roc_req(
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * p2p_find_roc_ctx_by_id() - Find out roc context by id
+ * @p2p_soc_obj: p2p psoc private object
+ * @roc_id: id of the roc context
+ *
+ * Return: Pointer to roc context - success
+ *         NULL                   - failure
+ */
+static struct p2p_roc_context *p2p_find_roc_ctx_by_id(
+	struct p2p_soc_priv_obj *p2p_soc_obj, int32_t roc_id)
+{
+	struct p2p_roc_context *roc_ctx;
+	qdf_list_node_t *p_node;
+	QDF_STATUS status;
+
+	status = qdf_list_peek_front(&p2p_soc_obj->roc_q, &p_node);
+	while (QDF_IS_STATUS_SUCCESS(status)) {
+		roc_ctx = qdf_container_of(p_node,
+				struct p2p_roc_context, node);
+		if (roc_ctx->id == roc_id)
+			return roc_ctx;
+		status = qdf_list_peek_next(&p2p_soc_obj->roc_q,
+					    p_node, &p_node);
+	}
+
+	return NULL;
+}
+
 /**
  * p2p_roc_timeout() - Callback for roc timeout
- * @pdata: pointer to p2p soc private object
+ * @pdata: pointer to the roc timer data
  *
- * This function is callback for roc time out.
+ * This function is callback for roc time out. With a pipelined roc
+ * request two roc timers may be armed, so the expiry is applied to the
+ * roc context owning the timer rather than to the head of the queue.
+ * The expiry may be processed after the roc context was cancelled and
+ * freed, so the roc context is looked up again by its id and ignored
+ * if it is gone or its timer was armed again meanwhile.
  *
  * Return: None
  */
 static void p2p_roc_timeout(void *pdata)
 {
-	struct p2p_roc_context *roc_ctx;
+	struct p2p_roc_timer_data *timer_data = pdata;
 	struct p2p_soc_priv_obj *p2p_soc_obj;
+	struct p2p_roc_context *roc_ctx;
 
-	p2p_debug("p2p soc obj:%pK", pdata);
+	if (!timer_data || !timer_data->p2p_soc_obj) {
+		p2p_err("Invalid roc timer data");
+		return;
+	}
 
-	p2p_soc_obj = pdata;
-	if (!p2p_soc_obj) {
-		p2p_err("Invalid p2p soc object");
+	p2p_soc_obj = timer_data->p2p_soc_obj;
+	roc_ctx = p2p_find_roc_ctx_by_id(p2p_soc_obj, timer_data->roc_id);
+	if (!roc_ctx || roc_ctx->timer_data != timer_data) {
+		p2p_debug("roc id:%d is no longer pending",
+			  timer_data->roc_id);
 		return;
 	}
 
-	roc_ctx = p2p_find_current_roc_ctx(p2p_soc_obj);
-	if (!roc_ctx) {
-		p2p_debug("No P2P roc is pending");
+	if (qdf_mc_timer_get_current_state(&roc_ctx->roc_timer) ==
+	    QDF_TIMER_STATE_RUNNING) {
+		p2p_debug("roc ctx:%pK timer restarted", roc_ctx);
 		return;
 	}
 
@@ -419,6 +522,50 @@ static void p2p_roc_timeout(void *pdata)
 	p2p_execute_cancel_roc_req(roc_ctx);
 }
 
+/**
+ * p2p_roc_timer_init() - Init the roc timer of a roc request
+ * @roc_ctx: remain on channel request
+ *
+ * Return: QDF_STATUS_SUCCESS - in case of success
+ */
+static QDF_STATUS p2p_roc_timer_init(struct p2p_roc_context *roc_ctx)
+{
+	struct p2p_soc_priv_obj *p2p_soc_obj = roc_ctx->p2p_soc_obj;
+	struct p2p_roc_timer_data *timer_data;
+
+	timer_data = &p2p_soc_obj->roc_timer_data[
+			p2p_soc_obj->roc_timer_data_idx];
+	p2p_soc_obj->roc_timer_data_idx =
+		(p2p_soc_obj->roc_timer_data_idx + 1) % MAX_QUEUE_LENGTH;
+	timer_data->roc_id = roc_ctx->id;
+	roc_ctx->timer_data = timer_data;
+
+	return qdf_mc_timer_init(&roc_ctx->roc_timer, QDF_TIMER_TYPE_SW,
+				 p2p_roc_timeout, timer_data);
+}
+
+/**
+ * p2p_activate_roc() - Make a started roc request the current one
+ * @roc_ctx: remain on channel request
+ *
+ * This function registers mgmt rx callback for the vdev of the roc.
+ *
+ * Return: QDF_STATUS_SUCCESS - in case of success
+ */
+static QDF_STATUS p2p_activate_roc(struct p2p_roc_context *roc_ctx)
+{
+	QDF_STATUS status;
+	struct p2p_soc_priv_obj *p2p_soc_obj = roc_ctx->p2p_soc_obj;
+
+	p2p_soc_obj->cur_roc_vdev_id = roc_ctx->vdev_id;
+	status = p2p_mgmt_rx_ops(p2p_soc_obj->soc, true);
+	if (status != QDF_STATUS_SUCCESS)
+		p2p_err("Failed to register mgmt rx callback, status:%d",
+			status);
+
+	return status;
+}
+
 /**
  * p2p_execute_roc_req() - Execute roc request
  * @roc_ctx: remain on channel request
@@ -444,9 +591,7 @@ static QDF_STATUS p2p_execute_roc_req(struct p2p_roc_context *roc_ctx)
 	/* prevent runtime suspend */
 	qdf_runtime_pm_prevent_suspend(&p2p_soc_obj->roc_runtime_lock);
 
-	status = qdf_mc_timer_init(&roc_ctx->roc_timer,
-			QDF_TIMER_TYPE_SW, p2p_roc_timeout,
-			p2p_soc_obj);
+	status = p2p_roc_timer_init(roc_ctx);
 	if (status != QDF_STATUS_SUCCESS) {
 		p2p_err("failed to init roc timer, status:%d", status);
 		goto fail;
@@ -468,15 +613,269 @@ fail:
 		return status;
 	}
 
-	p2p_soc_obj->cur_roc_vdev_id = roc_ctx->vdev_id;
-	status = p2p_mgmt_rx_ops(p2p_soc_obj->soc, true);
-	if (status != QDF_STATUS_SUCCESS)
-		p2p_err("Failed to register mgmt rx callback, status:%d",
-			status);
+	return p2p_activate_roc(roc_ctx);
+}
+
+/**
+ * p2p_pipeline_next_roc() - Issue next roc request during current dwell
+ * @roc_ctx: remain on channel request which is on channel
+ *
+ * This function starts the scan of the first queued roc request which is
+ * not merged into another one. Scan component keeps it pending behind the
+ * ongoing listen scan, so firmware moves to the next channel as soon as
+ * the current dwell ends instead of after the scan complete round trip.
+ * Only one roc request is pipelined at a time, it is activated once the
+ * current one completes.
+ *
+ * Return: None
+ */
+static void p2p_pipeline_next_roc(struct p2p_roc_context *roc_ctx)
+{
+	struct p2p_soc_priv_obj *p2p_soc_obj = roc_ctx->p2p_soc_obj;
+	struct p2p_roc_context *next_roc_ctx = NULL;
+	struct p2p_roc_context *tmp;
+	qdf_list_node_t *p_node;
+	QDF_STATUS status;
+
+	status = qdf_list_peek_front(&p2p_soc_obj->roc_q, &p_node);
+	while (QDF_IS_STATUS_SUCCESS(status)) {
+		tmp = qdf_container_of(p_node,
+				struct p2p_roc_context, node);
+		status = qdf_list_peek_next(&p2p_soc_obj->roc_q,
+					    p_node, &p_node);
+		if (tmp == roc_ctx || tmp->host_roc)
+			continue;
+		if (tmp->roc_state != ROC_STATE_IDLE)
+			return;
+		if (!next_roc_ctx)
+			next_roc_ctx = tmp;
+	}
+
+	if (!next_roc_ctx)
+		return;
+
+	status = p2p_roc_timer_init(next_roc_ctx);
+	if (status != QDF_STATUS_SUCCESS) {
+		p2p_err("failed to init roc timer, status:%d", status);
+		return;
+	}
+
+	next_roc_ctx->roc_state = ROC_STATE_REQUESTED;
+	next_roc_ctx->pipelined = true;
+	status = p2p_scan_start(next_roc_ctx);
+	if (status != QDF_STATUS_SUCCESS) {
+		/* leave it queued, it is executed after current dwell */
+		p2p_debug("Failed to pipeline roc %pK, status:%d",
+			  next_roc_ctx, status);
+		qdf_mc_timer_destroy(&next_roc_ctx->roc_timer);
+		next_roc_ctx->roc_state = ROC_STATE_IDLE;
+		next_roc_ctx->pipelined = false;
+		return;
+	}
+
+	p2p_soc_obj->roc_stats.num_pipelined++;
+	p2p_debug("pipelined roc %pK, freq:%d, scan_id:%d", next_roc_ctx,
+		  next_roc_ctx->chan_freq, next_roc_ctx->scan_id);
+}
+
+/**
+ * p2p_serve_roc() - Indicate a roc request is on channel
+ * @roc_ctx: remain on channel request
+ * @now:     current timestamp in ms
+ *
+ * This function indicates ready on channel to up layer if this is user
+ * requested roc and sends the mgmt frames waiting for this roc.
+ *
+ * Return: QDF_STATUS_SUCCESS - in case of success
+ */
+static QDF_STATUS p2p_serve_roc(struct p2p_roc_context *roc_ctx,
+				uint64_t now)
+{
+	struct p2p_soc_priv_obj *p2p_soc_obj = roc_ctx->p2p_soc_obj;
+	struct p2p_roc_stats *stats = &p2p_soc_obj->roc_stats;
+	uint32_t latency;
+	QDF_STATUS status = QDF_STATUS_SUCCESS;
+
+	roc_ctx->served = true;
+	latency = now - roc_ctx->req_ts;
+	stats->num_ready++;
+	stats->ready_latency_sum += latency;
+	if (latency > stats->ready_latency_max)
+		stats->ready_latency_max = latency;
+	p2p_debug("roc %pK on chan %d, %u ms after request", roc_ctx,
+		  roc_ctx->chan_freq, latency);
+
+	if (roc_ctx->roc_type == USER_REQUESTED) {
+		p2p_debug("user required roc, send roc event");
+		status = p2p_send_roc_event(roc_ctx,
+				ROC_EVENT_READY_ON_CHAN);
+	}
+
+	/* ready to tx frame */
+	p2p_ready_to_tx_frame(p2p_soc_obj, (uintptr_t)roc_ctx);
 
 	return status;
 }
 
+/**
+ * p2p_serve_roc_guests() - Indicate merged requests are on channel
+ * @roc_ctx: remain on channel request which is on channel
+ * @now:     current timestamp in ms
+ *
+ * Return: None
+ */
+static void p2p_serve_roc_guests(struct p2p_roc_context *roc_ctx,
+				 uint64_t now)
+{
+	struct p2p_soc_priv_obj *p2p_soc_obj = roc_ctx->p2p_soc_obj;
+	struct p2p_roc_context *guest;
+	qdf_list_node_t *p_node;
+	QDF_STATUS status;
+
+	status = qdf_list_peek_front(&p2p_soc_obj->roc_q, &p_node);
+	while (QDF_IS_STATUS_SUCCESS(status)) {
+		guest = qdf_container_of(p_node,
+				struct p2p_roc_context, node);
+		status = qdf_list_peek_next(&p2p_soc_obj->roc_q,
+					    p_node, &p_node);
+		if (guest->host_roc == roc_ctx && !guest->served)
+			p2p_serve_roc(guest, now);
+	}
+}
+
+/**
+ * p2p_complete_roc_guests() - Complete requests merged into a roc request
+ * @roc_ctx: remain on channel request whose dwell ended
+ *
+ * Requests which were on channel with @roc_ctx are completed. Requests
+ * which never got on channel, because @roc_ctx was cancelled or failed
+ * before the foreign channel event, are detached and run their own dwell.
+ *
+ * Return: None
+ */
+static void p2p_complete_roc_guests(struct p2p_roc_context *roc_ctx)
+{
+	struct p2p_soc_priv_obj *p2p_soc_obj = roc_ctx->p2p_soc_obj;
+	struct p2p_roc_context *guest;
+	qdf_list_node_t *p_node;
+	QDF_STATUS status;
+
+	status = qdf_list_peek_front(&p2p_soc_obj->roc_q, &p_node);
+	while (QDF_IS_STATUS_SUCCESS(status)) {
+		guest = qdf_container_of(p_node,
+				struct p2p_roc_context, node);
+		status = qdf_list_peek_next(&p2p_soc_obj->roc_q,
+					    p_node, &p_node);
+		if (guest->host_roc != roc_ctx)
+			continue;
+
+		guest->host_roc = NULL;
+		if (!guest->served)
+			continue;
+
+		if (guest->roc_type == USER_REQUESTED)
+			p2p_send_roc_event(guest, ROC_EVENT_COMPLETED);
+		p2p_destroy_roc_ctx(guest, false, true);
+	}
+}
+
+/**
+ * p2p_find_roc_host() - Find a roc request which can cover a new one
+ * @roc_ctx: new remain on channel request
+ *
+ * A roc request can host the new request if it is for the same vdev and
+ * channel, is not being cancelled and the dwell requested from firmware
+ * still covers the new request. A queued roc request can always host it,
+ * its dwell is sized for all merged requests when it is executed.
+ *
+ * Return: Pointer to host roc context - success
+ *         NULL                        - failure
+ */
+static struct p2p_roc_context *p2p_find_roc_host(
+	struct p2p_roc_context *roc_ctx)
+{
+	struct p2p_soc_priv_obj *p2p_soc_obj = roc_ctx->p2p_soc_obj;
+	struct p2p_roc_context *host_roc_ctx;
+	qdf_list_node_t *p_node;
+	uint64_t now = qdf_get_system_timestamp();
+	QDF_STATUS status;
+
+	status = qdf_list_peek_front(&p2p_soc_obj->roc_q, &p_node);
+	while (QDF_IS_STATUS_SUCCESS(status)) {
+		host_roc_ctx = qdf_container_of(p_node,
+				struct p2p_roc_context, node);
+		status = qdf_list_peek_next(&p2p_soc_obj->roc_q,
+					    p_node, &p_node);
+		if (host_roc_ctx == roc_ctx || host_roc_ctx->host_roc ||
+		    host_roc_ctx->vdev_id != roc_ctx->vdev_id ||
+		    host_roc_ctx->chan_freq != roc_ctx->chan_freq)
+			continue;
+
+		switch (host_roc_ctx->roc_state) {
+		case ROC_STATE_IDLE:
+			return host_roc_ctx;
+		case ROC_STATE_REQUESTED:
+		case ROC_STATE_STARTED:
+			if (roc_ctx->duration <= host_roc_ctx->fw_dwell)
+				return host_roc_ctx;
+			break;
+		case ROC_STATE_ON_CHAN:
+			if (now + roc_ctx->duration <=
+			    host_roc_ctx->on_chan_ts + host_roc_ctx->fw_dwell)
+				return host_roc_ctx;
+			break;
+		default:
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * p2p_coalesce_roc() - Merge a roc request into another one's dwell
+ * @host_roc_ctx: remain on channel request owning the dwell
+ * @roc_ctx:      new remain on channel request
+ *
+ * If the host is already on channel the roc timer is pushed out to cover
+ * the new request and the new request is indicated on channel right away,
+ * otherwise it is indicated together with the host.
+ *
+ * Return: None
+ */
+static void p2p_coalesce_roc(struct p2p_roc_context *host_roc_ctx,
+			     struct p2p_roc_context *roc_ctx)
+{
+	struct p2p_soc_priv_obj *p2p_soc_obj = roc_ctx->p2p_soc_obj;
+	uint64_t now;
+	QDF_STATUS status;
+
+	roc_ctx->host_roc = host_roc_ctx;
+	p2p_soc_obj->roc_stats.num_coalesced++;
+	p2p_debug("merge roc %pK into roc %pK, freq:%d, state:%d",
+		  roc_ctx, host_roc_ctx, roc_ctx->chan_freq,
+		  host_roc_ctx->roc_state);
+
+	if (host_roc_ctx->roc_state != ROC_STATE_ON_CHAN)
+		return;
+
+	now = qdf_get_system_timestamp();
+	if (now + roc_ctx->duration > host_roc_ctx->dwell_end) {
+		status = qdf_mc_timer_stop_sync(&host_roc_ctx->roc_timer);
+		if (status != QDF_STATUS_SUCCESS)
+			p2p_err("Failed to stop roc timer");
+		status = qdf_mc_timer_start(&host_roc_ctx->roc_timer,
+					    roc_ctx->duration +
+					    P2P_EVENT_PROPAGATE_TIME);
+		if (status != QDF_STATUS_SUCCESS)
+			p2p_err("Remain on Channel timer start failed");
+		host_roc_ctx->dwell_end = now + roc_ctx->duration;
+		p2p_soc_obj->roc_stats.num_dwell_extend++;
+	}
+
+	p2p_serve_roc(roc_ctx, now);
+}
+
 /**
  * p2p_find_roc_ctx() - Find out roc context by cookie
  * @p2p_soc_obj: p2p psoc private object
@@ -510,6 +909,38 @@ static struct p2p_roc_context *p2p_find_roc_ctx(
 	return NULL;
 }
 
+/**
+ * p2p_find_roc_by_scan_id() - Find out started roc context by scan id
+ * @p2p_soc_obj: p2p psoc private object
+ * @scan_id: scan id of the roc request
+ *
+ * With a pipelined roc request two roc scans may be outstanding, scan
+ * events are matched to the roc request which issued the scan.
+ *
+ * Return: Pointer to roc context - success
+ *         NULL                   - failure
+ */
+static struct p2p_roc_context *p2p_find_roc_by_scan_id(
+	struct p2p_soc_priv_obj *p2p_soc_obj, uint32_t scan_id)
+{
+	struct p2p_roc_context *roc_ctx;
+	qdf_list_node_t *p_node;
+	QDF_STATUS status;
+
+	status = qdf_list_peek_front(&p2p_soc_obj->roc_q, &p_node);
+	while (QDF_IS_STATUS_SUCCESS(status)) {
+		roc_ctx = qdf_container_of(p_node,
+				struct p2p_roc_context, node);
+		if (roc_ctx->roc_state != ROC_STATE_IDLE &&
+		    roc_ctx->scan_id == scan_id)
+			return roc_ctx;
+		status = qdf_list_peek_next(&p2p_soc_obj->roc_q,
+						p_node, &p_node);
+	}
+
+	return NULL;
+}
+
 /**
  * p2p_process_scan_start_evt() - Process scan start event
  * @roc_ctx: remain on channel request
@@ -533,36 +964,35 @@ static QDF_STATUS p2p_process_scan_start_evt(
  *
  * This function process ready on channel event. Starts roc timer.
  * Indicates this event to up layer if this is user request roc. Sends
- * mgmt frame if this is off channel rx roc.
+ * mgmt frame if this is off channel rx roc. Requests merged into this
+ * roc are indicated as well and the next queued roc is pipelined.
  *
  * Return: QDF_STATUS_SUCCESS - in case of success
  */
 static QDF_STATUS p2p_process_ready_on_channel_evt(
 	struct p2p_roc_context *roc_ctx)
 {
-	uint64_t cookie;
-	struct p2p_soc_priv_obj *p2p_soc_obj;
+	uint32_t dwell;
+	uint64_t now;
 	QDF_STATUS status;
 
-	p2p_soc_obj = roc_ctx->p2p_soc_obj;
 	roc_ctx->roc_state = ROC_STATE_ON_CHAN;
 
 	p2p_debug("scan_id:%d, roc_state:%d", roc_ctx->scan_id,
 		  roc_ctx->roc_state);
 
+	now = qdf_get_system_timestamp();
+	dwell = p2p_roc_dwell_time(roc_ctx);
+	roc_ctx->on_chan_ts = now;
+	roc_ctx->dwell_end = now + dwell;
 	status = qdf_mc_timer_start(&roc_ctx->roc_timer,
-		(roc_ctx->duration + P2P_EVENT_PROPAGATE_TIME));
+		(dwell + P2P_EVENT_PROPAGATE_TIME));
 	if (status != QDF_STATUS_SUCCESS)
 		p2p_err("Remain on Channel timer start failed");
-	if (roc_ctx->roc_type == USER_REQUESTED) {
-		p2p_debug("user required roc, send roc event");
-		status = p2p_send_roc_event(roc_ctx,
-				ROC_EVENT_READY_ON_CHAN);
-	}
 
-	cookie = (uintptr_t)roc_ctx;
-		/* ready to tx frame */
-	p2p_ready_to_tx_frame(p2p_soc_obj, cookie);
+	status = p2p_serve_roc(roc_ctx, now);
+	p2p_serve_roc_guests(roc_ctx, now);
+	p2p_pipeline_next_roc(roc_ctx);
 
 	return status;
 }
@@ -581,13 +1011,15 @@ static QDF_STATUS p2p_process_scan_complete_evt(
 	QDF_STATUS status;
 	qdf_list_node_t *next_node;
 	uint32_t size;
+	bool pipelined = roc_ctx->pipelined;
 	struct p2p_soc_priv_obj *p2p_soc_obj = roc_ctx->p2p_soc_obj;
 
-	p2p_debug("vdev_id:%d scan_id:%d", roc_ctx->vdev_id, roc_ctx->scan_id);
+	p2p_debug("vdev_id:%d scan_id:%d pipelined:%d", roc_ctx->vdev_id,
+		  roc_ctx->scan_id, pipelined);
 
 	/* allow runtime suspend */
-	qdf_runtime_pm_allow_suspend(&p2p_soc_obj->roc_runtime_lock);
-
+	if (!pipelined)
+		qdf_runtime_pm_allow_suspend(&p2p_soc_obj->roc_runtime_lock);
 
 	status = qdf_mc_timer_stop_sync(&roc_ctx->roc_timer);
 	if (QDF_IS_STATUS_ERROR(status))
@@ -597,11 +1029,14 @@ static QDF_STATUS p2p_process_scan_complete_evt(
 	if (status != QDF_STATUS_SUCCESS)
 		p2p_err("Failed to destroy roc timer");
 
-	status = p2p_mgmt_rx_ops(p2p_soc_obj->soc, false);
-	p2p_soc_obj->cur_roc_vdev_id = P2P_INVALID_VDEV_ID;
-	if (status != QDF_STATUS_SUCCESS)
-		p2p_err("Failed to deregister mgmt rx callback");
+	if (!pipelined) {
+		status = p2p_mgmt_rx_ops(p2p_soc_obj->soc, false);
+		p2p_soc_obj->cur_roc_vdev_id = P2P_INVALID_VDEV_ID;
+		if (status != QDF_STATUS_SUCCESS)
+			p2p_err("Failed to deregister mgmt rx callback");
+	}
 
+	p2p_complete_roc_guests(roc_ctx);
 	if (roc_ctx->roc_type == USER_REQUESTED)
 		status = p2p_send_roc_event(roc_ctx,
 				ROC_EVENT_COMPLETED);
@@ -609,6 +1044,20 @@ static QDF_STATUS p2p_process_scan_complete_evt(
 	p2p_destroy_roc_ctx(roc_ctx, false, true);
 	qdf_event_set(&p2p_soc_obj->cleanup_roc_done);
 
+	/*
+	 * A pipelined roc dequeued before it got active leaves the current
+	 * roc running, otherwise the pipelined roc takes over.
+	 */
+	roc_ctx = p2p_find_current_roc_ctx(p2p_soc_obj);
+	if (roc_ctx) {
+		if (!roc_ctx->pipelined)
+			return status;
+
+		roc_ctx->pipelined = false;
+		qdf_runtime_pm_prevent_suspend(&p2p_soc_obj->roc_runtime_lock);
+		return p2p_activate_roc(roc_ctx);
+	}
+
 	size = qdf_list_size(&p2p_soc_obj->roc_q);
 
 	if (size > 0) {
@@ -714,7 +1163,12 @@ struct p2p_roc_context *p2p_find_roc_by_chan_freq(
 		roc_ctx = qdf_container_of(p_node,
 					   struct p2p_roc_context,
 					   node);
-		if (roc_ctx->chan_freq == chan_freq) {
+		/*
+		 * Guests ride on another roc's dwell and served entries
+		 * are already on channel, neither can take a new tx.
+		 */
+		if (!roc_ctx->host_roc && !roc_ctx->served &&
+		    roc_ctx->chan_freq == chan_freq) {
 			p2p_debug("p2p soc obj:%pK, roc ctx:%pK, vdev_id:%d,"
 				  " scan_id:%d, tx ctx:%pK, freq:%d,"
 				  " phy_mode:%d, duration:%d,"
@@ -737,20 +1191,26 @@ struct p2p_roc_context *p2p_find_roc_by_chan_freq(
 QDF_STATUS p2p_restart_roc_timer(struct p2p_roc_context *roc_ctx)
 {
 	QDF_STATUS status = QDF_STATUS_E_FAILURE;
+	uint32_t duration = roc_ctx->duration;
+	uint64_t now;
 
 	if (QDF_TIMER_STATE_RUNNING ==
 		qdf_mc_timer_get_current_state(&roc_ctx->roc_timer)) {
-		p2p_debug("roc restart duration:%d", roc_ctx->duration);
+		/* do not cut the dwell already promised to merged requests */
+		now = qdf_get_system_timestamp();
+		if (roc_ctx->dwell_end > now + duration)
+			duration = roc_ctx->dwell_end - now;
+		p2p_debug("roc restart duration:%d", duration);
 		status = qdf_mc_timer_stop_sync(&roc_ctx->roc_timer);
 		if (status != QDF_STATUS_SUCCESS) {
 			p2p_err("Failed to stop roc timer");
 			return status;
 		}
 
-		status = qdf_mc_timer_start(&roc_ctx->roc_timer,
-						roc_ctx->duration);
+		status = qdf_mc_timer_start(&roc_ctx->roc_timer, duration);
 		if (status != QDF_STATUS_SUCCESS)
 			p2p_err("Remain on Channel timer start failed");
+		roc_ctx->dwell_end = now + duration;
 	}
 
 	return status;
@@ -898,6 +1358,7 @@ QDF_STATUS p2p_process_roc_req(struct p2p_roc_context *roc_ctx)
 	uint32_t size;
 
 	p2p_soc_obj = roc_ctx->p2p_soc_obj;
+	roc_ctx->req_ts = qdf_get_system_timestamp();
 
 	p2p_debug("p2p soc obj:%pK, roc ctx:%pK, vdev_id:%d, scan_id:%d, "
 		  "tx_ctx:%pK, freq:%d, phy_mode:%d, duration:%d, "
@@ -919,8 +1380,19 @@ QDF_STATUS p2p_process_roc_req(struct p2p_roc_context *roc_ctx)
 	if (size == 1) {
 		status = p2p_execute_roc_req(roc_ctx);
 	} else if (size > 1) {
+		if (!roc_ctx->duration)
+			roc_ctx->duration = P2P_ROC_DEFAULT_DURATION;
+
+		curr_roc_ctx = p2p_find_roc_host(roc_ctx);
+		if (curr_roc_ctx) {
+			p2p_coalesce_roc(curr_roc_ctx, roc_ctx);
+			return status;
+		}
+
 		curr_roc_ctx = p2p_find_current_roc_ctx(p2p_soc_obj);
-		/*TODO, to handle extend roc */
+		if (curr_roc_ctx &&
+		    curr_roc_ctx->roc_state == ROC_STATE_ON_CHAN)
+			p2p_pipeline_next_roc(curr_roc_ctx);
 	}
 
 	return status;
@@ -975,7 +1447,9 @@ void p2p_scan_event_cb(struct wlan_objmgr_vdev *vdev,
 		return;
 	}
 
-	curr_roc_ctx = p2p_find_current_roc_ctx(p2p_soc_obj);
+	curr_roc_ctx = p2p_find_roc_by_scan_id(p2p_soc_obj, event->scan_id);
+	if (!curr_roc_ctx)
+		curr_roc_ctx = p2p_find_current_roc_ctx(p2p_soc_obj);
 	if (!curr_roc_ctx) {
 		p2p_err("Failed to find valid P2P roc context");
 		return;
@@ -45,6 +45,7 @@
 
 struct wlan_objmgr_vdev;
 struct scan_event;
+struct p2p_roc_timer_data;
 
 /**
  * enum roc_type - user requested or off channel tx
@@ -88,6 +89,16 @@ enum roc_state {
  * @roc_timer:   RoC timer
  * @roc_state:   Roc state
  * @id:          identifier of roc
+ * @host_roc:    RoC whose dwell this request has been merged into, NULL
+ *               if this request owns its dwell
+ * @served:      Dwell covering this request has started
+ * @pipelined:   Scan was issued while the previous dwell was still active,
+ *               cleared once this RoC becomes the current one
+ * @fw_dwell:    Dwell time requested from firmware in ms
+ * @req_ts:      Timestamp in ms when this request was queued
+ * @on_chan_ts:  Timestamp in ms when firmware got on channel
+ * @dwell_end:   Timestamp in ms when the roc timer expires
+ * @timer_data:  Data the roc timer was initialized with
  */
 struct p2p_roc_context {
 	qdf_list_node_t node;
@@ -102,6 +113,14 @@ struct p2p_roc_context {
 	qdf_mc_timer_t roc_timer;
 	enum roc_state roc_state;
 	int32_t id;
+	struct p2p_roc_context *host_roc;
+	bool served;
+	bool pipelined;
+	uint32_t fw_dwell;
+	uint64_t req_ts;
+	uint64_t on_chan_ts;
+	uint64_t dwell_end;
+	struct p2p_roc_timer_data *timer_data;
 };
 
 /**
@@ -170,7 +189,8 @@ struct p2p_roc_context *p2p_find_roc_by_tx_ctx(
  * @chan_freq: channel frequency of the ROC
  *
  * This function finds out roc context by channel from p2p psoc
- * private object
+ * private object. Guest requests merged into another roc and requests
+ * which are already served are skipped.
  *
  * Return: Pointer to roc context - success
  *         NULL                   - failure
@@ -55,6 +55,8 @@
  *                             device is in low power mode
  * @get_dtim_period: register callback to get dtim period from mlme
  * @get_beacon_interval: register callback to get beacon interval from mlme
+ * @sr_latency: suspend/resume latency trace
+ * @initial_wake_up_us: log timestamp of the last initial wake up interrupt
  * @lock: spin lock for pmo psoc
  */
 struct pmo_psoc_priv_obj {
@@ -72,6 +74,8 @@ struct pmo_psoc_priv_obj {
 	pmo_is_device_in_low_pwr_mode is_device_in_low_pwr_mode;
 	pmo_get_dtim_period get_dtim_period;
 	pmo_get_beacon_interval get_beacon_interval;
+	struct pmo_sr_latency sr_latency;
+	uint64_t initial_wake_up_us;
 	qdf_spinlock_t lock;
 };
 
@@ -393,6 +393,30 @@ int pmo_core_psoc_is_target_wake_up_received(struct wlan_objmgr_psoc *psoc);
  */
 int pmo_core_psoc_clear_target_wake_up(struct wlan_objmgr_psoc *psoc);
 
+/**
+ * pmo_core_sr_latency_record() - record the duration of a suspend/resume step
+ * @psoc: objmgr psoc handle
+ * @step: suspend/resume step
+ * @type: type of the suspend the step is part of
+ * @begin_us: log timestamp in microseconds when the step started
+ *
+ * Return: None
+ */
+void pmo_core_sr_latency_record(struct wlan_objmgr_psoc *psoc,
+				enum pmo_sr_step step,
+				enum qdf_suspend_type type,
+				uint64_t begin_us);
+
+/**
+ * pmo_core_get_sr_latency() - get a snapshot of the suspend/resume latency
+ * @psoc: objmgr psoc handle
+ * @latency: buffer to copy the latency trace into
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS pmo_core_get_sr_latency(struct wlan_objmgr_psoc *psoc,
+				   struct pmo_sr_latency *latency);
+
 /**
  * pmo_core_psoc_target_suspend_acknowledge() - update target susspend status
  * @context: HTC_INIT_INFO->context
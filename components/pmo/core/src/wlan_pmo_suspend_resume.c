@@ -323,40 +323,22 @@ bool pmo_is_listen_interval_user_set(struct pmo_vdev_priv_obj *vdev_ctx)
 }
 
 /**
- * pmo_core_set_suspend_dtim() - set suspend dtim
+ * pmo_core_set_vdev_suspend_params() - set suspend dtim and ps parameters
  * @psoc: objmgr psoc handle
+ * @vdev: objmgr vdev handle
+ * @li_offload_support: firmware supports listen interval offload
  *
  * Return: none
  */
-static void pmo_core_set_suspend_dtim(struct wlan_objmgr_psoc *psoc)
+static void pmo_core_set_vdev_suspend_params(struct wlan_objmgr_psoc *psoc,
+					     struct wlan_objmgr_vdev *vdev,
+					     bool li_offload_support)
 {
-	uint8_t vdev_id;
-	struct wlan_objmgr_vdev *vdev;
-	struct pmo_vdev_priv_obj *vdev_ctx;
-	struct pmo_psoc_priv_obj *psoc_ctx;
-	bool li_offload_support = false;
-
-	pmo_psoc_with_ctx(psoc, psoc_ctx) {
-		li_offload_support = psoc_ctx->caps.li_offload;
-	}
-
-	if (li_offload_support)
-		pmo_debug("listen interval offload support is enabled");
-
-	/* Iterate through VDEV list */
-	for (vdev_id = 0; vdev_id < WLAN_UMAC_PSOC_MAX_VDEVS; vdev_id++) {
-		vdev = wlan_objmgr_get_vdev_by_id_from_psoc(psoc, vdev_id,
-							    WLAN_PMO_ID);
-		if (!vdev)
-			continue;
+	struct pmo_vdev_priv_obj *vdev_ctx = pmo_vdev_get_priv(vdev);
 
-		vdev_ctx = pmo_vdev_get_priv(vdev);
-		if (!pmo_is_listen_interval_user_set(vdev_ctx)
-		    && !li_offload_support)
-			pmo_core_set_vdev_suspend_dtim(psoc, vdev, vdev_ctx);
-		pmo_configure_vdev_suspend_params(psoc, vdev, vdev_ctx);
-		wlan_objmgr_vdev_release_ref(vdev, WLAN_PMO_ID);
-	}
+	if (!pmo_is_listen_interval_user_set(vdev_ctx) && !li_offload_support)
+		pmo_core_set_vdev_suspend_dtim(psoc, vdev, vdev_ctx);
+	pmo_configure_vdev_suspend_params(psoc, vdev, vdev_ctx);
 }
 
 /**
@@ -381,75 +363,60 @@ void pmo_core_update_wow_bus_suspend(struct wlan_objmgr_psoc *psoc,
 #define EV_NLO WOW_NLO_SCAN_COMPLETE_EVENT
 #define EV_PWR WOW_CHIP_POWER_FAILURE_DETECT_EVENT
 
-void pmo_core_configure_dynamic_wake_events(struct wlan_objmgr_psoc *psoc)
+/**
+ * pmo_core_configure_vdev_dynamic_wake_events() - configure dynamic wake
+ *	events of a vdev
+ * @psoc: objmgr psoc handle
+ * @vdev: objmgr vdev handle
+ *
+ * Return: none
+ */
+static void
+pmo_core_configure_vdev_dynamic_wake_events(struct wlan_objmgr_psoc *psoc,
+					    struct wlan_objmgr_vdev *vdev)
 {
-	int vdev_id;
 	uint32_t adapter_type;
-	uint32_t enable_mask[BM_LEN];
-	uint32_t disable_mask[BM_LEN];
-	struct wlan_objmgr_vdev *vdev;
+	uint32_t enable_mask[BM_LEN] = {0};
+	uint32_t disable_mask[BM_LEN] = {0};
 	struct pmo_psoc_priv_obj *psoc_ctx;
-	bool enable_configured;
-	bool disable_configured;
-
-	/* Iterate through VDEV list */
-	for (vdev_id = 0; vdev_id < WLAN_UMAC_PSOC_MAX_VDEVS; vdev_id++) {
-
-		enable_configured = false;
-		disable_configured = false;
-
-		qdf_mem_zero(enable_mask,  sizeof(uint32_t) * BM_LEN);
-		qdf_mem_zero(disable_mask, sizeof(uint32_t) * BM_LEN);
-
-		vdev = wlan_objmgr_get_vdev_by_id_from_psoc(psoc, vdev_id,
-							    WLAN_PMO_ID);
-		if (!vdev)
-			continue;
-
-		if (ucfg_scan_get_pno_in_progress(vdev)) {
-			if (ucfg_scan_get_pno_match(vdev)) {
-				pmo_set_wow_event_bitmap(EV_NLO,
-							 BM_LEN,
-							 enable_mask);
-				enable_configured = true;
-			} else {
-				pmo_set_wow_event_bitmap(EV_NLO,
-							 BM_LEN,
-							 disable_mask);
-				disable_configured = true;
-			}
+	bool enable_configured = false;
+	bool disable_configured = false;
+	uint8_t vdev_id = pmo_vdev_get_id(vdev);
+
+	if (ucfg_scan_get_pno_in_progress(vdev)) {
+		if (ucfg_scan_get_pno_match(vdev)) {
+			pmo_set_wow_event_bitmap(EV_NLO, BM_LEN, enable_mask);
+			enable_configured = true;
+		} else {
+			pmo_set_wow_event_bitmap(EV_NLO, BM_LEN, disable_mask);
+			disable_configured = true;
 		}
+	}
 
-		adapter_type = pmo_get_vdev_opmode(vdev);
+	adapter_type = pmo_get_vdev_opmode(vdev);
 
-		psoc_ctx = pmo_psoc_get_priv(psoc);
+	psoc_ctx = pmo_psoc_get_priv(psoc);
 
-		if (psoc_ctx->psoc_cfg.auto_power_save_fail_mode ==
-		    PMO_FW_TO_SEND_WOW_IND_ON_PWR_FAILURE &&
-		    (adapter_type == QDF_STA_MODE ||
-		     adapter_type == QDF_P2P_CLIENT_MODE)) {
-			if (psoc_ctx->is_device_in_low_pwr_mode &&
-			    psoc_ctx->is_device_in_low_pwr_mode(vdev_id)) {
-				pmo_set_wow_event_bitmap(EV_PWR,
-							 BM_LEN,
-							 enable_mask);
-				enable_configured = true;
-			}
+	if (psoc_ctx->psoc_cfg.auto_power_save_fail_mode ==
+	    PMO_FW_TO_SEND_WOW_IND_ON_PWR_FAILURE &&
+	    (adapter_type == QDF_STA_MODE ||
+	     adapter_type == QDF_P2P_CLIENT_MODE)) {
+		if (psoc_ctx->is_device_in_low_pwr_mode &&
+		    psoc_ctx->is_device_in_low_pwr_mode(vdev_id)) {
+			pmo_set_wow_event_bitmap(EV_PWR, BM_LEN, enable_mask);
+			enable_configured = true;
 		}
-
-		if (enable_configured)
-			pmo_tgt_enable_wow_wakeup_event(vdev, enable_mask);
-		if (disable_configured)
-			pmo_tgt_disable_wow_wakeup_event(vdev, disable_mask);
-
-		wlan_objmgr_vdev_release_ref(vdev, WLAN_PMO_ID);
 	}
 
+	if (enable_configured)
+		pmo_tgt_enable_wow_wakeup_event(vdev, enable_mask);
+	if (disable_configured)
+		pmo_tgt_disable_wow_wakeup_event(vdev, disable_mask);
 }
 
-static void pmo_core_enable_runtime_pm_offloads(struct wlan_objmgr_psoc *psoc)
+void pmo_core_configure_dynamic_wake_events(struct wlan_objmgr_psoc *psoc)
 {
-	uint8_t vdev_id;
+	int vdev_id;
 	struct wlan_objmgr_vdev *vdev;
 
 	/* Iterate through VDEV list */
@@ -459,15 +426,38 @@ static void pmo_core_enable_runtime_pm_offloads(struct wlan_objmgr_psoc *psoc)
 		if (!vdev)
 			continue;
 
-		pmo_register_action_frame_patterns(vdev, QDF_RUNTIME_SUSPEND);
+		pmo_core_configure_vdev_dynamic_wake_events(psoc, vdev);
 		wlan_objmgr_vdev_release_ref(vdev, WLAN_PMO_ID);
 	}
 }
 
-static void pmo_core_disable_runtime_pm_offloads(struct wlan_objmgr_psoc *psoc)
+/**
+ * pmo_core_configure_vdevs_suspend() - apply per vdev suspend configuration
+ * @psoc: objmgr psoc handle
+ * @is_runtime_pm: indicate if it is used by runtime PM
+ * @wow: WoW suspend is selected
+ *
+ * Walks the vdev list once and issues all commands of a vdev back to back.
+ * None of the commands waits for a firmware response, so the firmware
+ * works through them while the host moves on to the next vdev and to the
+ * WoW enable command, which is the first step waiting for the firmware.
+ *
+ * Return: none
+ */
+static void pmo_core_configure_vdevs_suspend(struct wlan_objmgr_psoc *psoc,
+					     bool is_runtime_pm, bool wow)
 {
 	uint8_t vdev_id;
 	struct wlan_objmgr_vdev *vdev;
+	struct pmo_psoc_priv_obj *psoc_ctx;
+	bool li_offload_support = false;
+
+	pmo_psoc_with_ctx(psoc, psoc_ctx) {
+		li_offload_support = psoc_ctx->caps.li_offload;
+	}
+
+	if (li_offload_support)
+		pmo_debug("listen interval offload support is enabled");
 
 	/* Iterate through VDEV list */
 	for (vdev_id = 0; vdev_id < WLAN_UMAC_PSOC_MAX_VDEVS; vdev_id++) {
@@ -476,7 +466,30 @@ static void pmo_core_disable_runtime_pm_offloads(struct wlan_objmgr_psoc *psoc)
 		if (!vdev)
 			continue;
 
-		pmo_clear_action_frame_patterns(vdev);
+		if (is_runtime_pm) {
+			pmo_register_action_frame_patterns(vdev,
+							   QDF_RUNTIME_SUSPEND);
+		} else {
+			/*
+			 * Dynamic wake events should not be needed for
+			 * runtime PM. Any wake events can be configured by
+			 * default if they are really needed for runtime PM.
+			 * In fact, most of them are only needed for system
+			 * suspend.
+			 */
+			if (wow)
+				pmo_core_configure_vdev_dynamic_wake_events(
+								psoc, vdev);
+			/*
+			 * For runtime PM, since system is awake, DTIM related
+			 * commands do not have to be sent with WOW sequence.
+			 * They can be sent through other paths which will
+			 * just trigger a runtime resume.
+			 */
+			pmo_core_set_vdev_suspend_params(psoc, vdev,
+							 li_offload_support);
+		}
+
 		wlan_objmgr_vdev_release_ref(vdev, WLAN_PMO_ID);
 	}
 }
@@ -496,12 +509,11 @@ static QDF_STATUS pmo_core_psoc_configure_suspend(struct wlan_objmgr_psoc *psoc,
 	struct pmo_psoc_priv_obj *psoc_ctx;
 	struct hif_target_info *tgt_info;
 	struct hif_opaque_softc *hif_ctx;
+	uint64_t begin_us = qdf_get_log_timestamp_usecs();
+	bool wow;
 
 	psoc_ctx = pmo_psoc_get_priv(psoc);
 
-	if (is_runtime_pm)
-		pmo_core_enable_runtime_pm_offloads(psoc);
-
 	hif_ctx = pmo_core_psoc_get_hif_handle(psoc);
 	if (!hif_ctx) {
 		pmo_err("Invalid hif ctx");
@@ -509,20 +521,13 @@ static QDF_STATUS pmo_core_psoc_configure_suspend(struct wlan_objmgr_psoc *psoc,
 	}
 	tgt_info = hif_get_target_info_handle(hif_ctx);
 
-	if ((is_runtime_pm) ||
-	    (psoc_ctx->psoc_cfg.suspend_mode == PMO_SUSPEND_WOW &&
-	    ((tgt_info->target_type == TARGET_TYPE_QCA6490) ||
-	    pmo_core_is_wow_applicable(psoc)))) {
+	wow = is_runtime_pm ||
+	      (psoc_ctx->psoc_cfg.suspend_mode == PMO_SUSPEND_WOW &&
+	       (tgt_info->target_type == TARGET_TYPE_QCA6490 ||
+		pmo_core_is_wow_applicable(psoc)));
+	if (wow) {
 		pmo_debug("WOW Suspend");
 		pmo_core_apply_lphb(psoc);
-		/*
-		 * Dynamic wake events should not be needed for runtime PM.
-		 * Any wake events can be configured by default if they are
-		 * really needed for runtime PM. In fact, most of them are
-		 * only needed for system suspend.
-		 */
-		if (!is_runtime_pm)
-			pmo_core_configure_dynamic_wake_events(psoc);
 		pmo_core_update_wow_enable(psoc_ctx, true);
 		pmo_core_update_wow_enable_cmd_sent(psoc_ctx, false);
 	} else {
@@ -530,13 +535,7 @@ static QDF_STATUS pmo_core_psoc_configure_suspend(struct wlan_objmgr_psoc *psoc,
 		pmo_core_update_wow_enable(psoc_ctx, false);
 	}
 
-	/*
-	 * For runtime PM, since system is awake, DTIM related commands
-	 * do not have to be sent with WOW sequence. They can be sent
-	 * through other paths which will just trigger a runtime resume.
-	 */
-	if (!is_runtime_pm)
-		pmo_core_set_suspend_dtim(psoc);
+	pmo_core_configure_vdevs_suspend(psoc, is_runtime_pm, wow);
 
 	/*
 	 * To handle race between hif_pci_suspend and unpause/pause tx handler.
@@ -545,6 +544,11 @@ static QDF_STATUS pmo_core_psoc_configure_suspend(struct wlan_objmgr_psoc *psoc,
 	 */
 	pmo_core_update_wow_bus_suspend(psoc, psoc_ctx, true);
 
+	pmo_core_sr_latency_record(psoc, PMO_SR_STEP_VDEV_SUSPEND_CFG,
+				   is_runtime_pm ? QDF_RUNTIME_SUSPEND :
+						   QDF_SYSTEM_SUSPEND,
+				   begin_us);
+
 	pmo_exit();
 
 	return QDF_STATUS_SUCCESS;
@@ -613,12 +617,17 @@ static void pmo_core_set_vdev_resume_dtim(struct wlan_objmgr_psoc *psoc,
 }
 
 /**
- * pmo_core_set_resume_dtim() - set resume time dtim
+ * pmo_core_configure_vdevs_resume() - restore per vdev configuration
  * @psoc: objmgr psoc handle
+ * @is_runtime_pm: indicate if it is used by runtime PM
+ *
+ * Counterpart of pmo_core_configure_vdevs_suspend(), walks the vdev list
+ * once without waiting for the firmware.
  *
  * Return: none
  */
-static void pmo_core_set_resume_dtim(struct wlan_objmgr_psoc *psoc)
+static void pmo_core_configure_vdevs_resume(struct wlan_objmgr_psoc *psoc,
+					    bool is_runtime_pm)
 {
 	uint8_t vdev_id;
 	struct wlan_objmgr_vdev *vdev;
@@ -640,6 +649,18 @@ static void pmo_core_set_resume_dtim(struct wlan_objmgr_psoc *psoc)
 		if (!vdev)
 			continue;
 
+		if (is_runtime_pm) {
+			pmo_clear_action_frame_patterns(vdev);
+			wlan_objmgr_vdev_release_ref(vdev, WLAN_PMO_ID);
+			continue;
+		}
+
+		/*
+		 * For runtime PM, since system is awake, DTIM related
+		 * commands do not have to be sent with WOW sequence. They
+		 * can be sent through other paths which will just trigger
+		 * a runtime resume.
+		 */
 		vdev_ctx = pmo_vdev_get_priv(vdev);
 		if (!pmo_is_listen_interval_user_set(vdev_ctx)
 		    && !li_offload_support)
@@ -696,21 +717,19 @@ static QDF_STATUS pmo_core_psoc_configure_resume(struct wlan_objmgr_psoc *psoc,
 						 bool is_runtime_pm)
 {
 	struct pmo_psoc_priv_obj *psoc_ctx;
+	uint64_t begin_us = qdf_get_log_timestamp_usecs();
 
 	psoc_ctx = pmo_psoc_get_priv(psoc);
-	if (is_runtime_pm)
-		pmo_core_disable_runtime_pm_offloads(psoc);
 
-	/*
-	 * For runtime PM, since system is awake, DTIM related commands
-	 * do not have to be sent with WOW sequence. They can be sent
-	 * through other paths which will just trigger a runtime resume.
-	 */
-	if (!is_runtime_pm)
-		pmo_core_set_resume_dtim(psoc);
+	pmo_core_configure_vdevs_resume(psoc, is_runtime_pm);
 	pmo_core_update_wow_bus_suspend(psoc, psoc_ctx, false);
 	pmo_unpause_all_vdev(psoc, psoc_ctx);
 
+	pmo_core_sr_latency_record(psoc, PMO_SR_STEP_VDEV_RESUME_CFG,
+				   is_runtime_pm ? QDF_RUNTIME_SUSPEND :
+						   QDF_SYSTEM_SUSPEND,
+				   begin_us);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -993,6 +1012,7 @@ QDF_STATUS pmo_core_psoc_bus_suspend_req(struct wlan_objmgr_psoc *psoc,
 	end = qdf_get_log_timestamp_usecs();
 	pmo_debug("fw took total time %lu microseconds to enable wow",
 		  end - begin);
+	pmo_core_sr_latency_record(psoc, PMO_SR_STEP_WOW_ENABLE, type, begin);
 
 	pmo_psoc_put_ref(psoc);
 out:
@@ -1534,6 +1554,12 @@ QDF_STATUS pmo_core_psoc_bus_resume_req(struct wlan_objmgr_psoc *psoc,
 	}
 
 	begin = qdf_get_log_timestamp_usecs();
+	if (psoc_ctx->initial_wake_up_us) {
+		pmo_core_sr_latency_record(psoc, PMO_SR_STEP_INITIAL_WAKEUP,
+					   type, psoc_ctx->initial_wake_up_us);
+		psoc_ctx->initial_wake_up_us = 0;
+	}
+
 	if (wow_mode)
 		status = pmo_core_psoc_disable_wow_in_fw(psoc, psoc_ctx);
 	else
@@ -1541,6 +1567,7 @@ QDF_STATUS pmo_core_psoc_bus_resume_req(struct wlan_objmgr_psoc *psoc,
 	end = qdf_get_log_timestamp_usecs();
 	pmo_debug("fw took total time %lu microseconds to disable wow",
 		  end - begin);
+	pmo_core_sr_latency_record(psoc, PMO_SR_STEP_WOW_DISABLE, type, begin);
 
 	pmo_psoc_put_ref(psoc);
 
@@ -1671,6 +1698,62 @@ void pmo_core_psoc_handle_initial_wake_up(void *cb_ctx)
 
 	psoc_ctx = pmo_psoc_get_priv(psoc);
 	pmo_core_update_wow_initial_wake_up(psoc_ctx, 1);
+	psoc_ctx->initial_wake_up_us = qdf_get_log_timestamp_usecs();
+}
+
+void pmo_core_sr_latency_record(struct wlan_objmgr_psoc *psoc,
+				enum pmo_sr_step step,
+				enum qdf_suspend_type type,
+				uint64_t begin_us)
+{
+	struct pmo_psoc_priv_obj *psoc_ctx;
+	struct pmo_sr_latency *latency;
+	struct pmo_sr_step_stats *stats;
+	struct pmo_sr_trace_entry *entry;
+	uint64_t now_us = qdf_get_log_timestamp_usecs();
+	uint32_t duration_us;
+
+	if (step >= PMO_SR_STEP_MAX)
+		return;
+
+	psoc_ctx = pmo_psoc_get_priv(psoc);
+	if (!psoc_ctx)
+		return;
+
+	duration_us = now_us > begin_us ?
+		      (uint32_t)QDF_MIN(now_us - begin_us, UINT_MAX) : 0;
+
+	qdf_spin_lock_bh(&psoc_ctx->lock);
+	latency = &psoc_ctx->sr_latency;
+	stats = &latency->step[step];
+	stats->count++;
+	stats->last_us = duration_us;
+	stats->max_us = QDF_MAX(stats->max_us, duration_us);
+	stats->total_us += duration_us;
+
+	entry = &latency->trace[latency->trace_idx];
+	entry->timestamp_us = begin_us;
+	entry->duration_us = duration_us;
+	entry->step = step;
+	entry->type = type;
+	latency->trace_idx = (latency->trace_idx + 1) % PMO_SR_TRACE_MAX;
+	qdf_spin_unlock_bh(&psoc_ctx->lock);
+}
+
+QDF_STATUS pmo_core_get_sr_latency(struct wlan_objmgr_psoc *psoc,
+				   struct pmo_sr_latency *latency)
+{
+	struct pmo_psoc_priv_obj *psoc_ctx;
+
+	psoc_ctx = pmo_psoc_get_priv(psoc);
+	if (!psoc_ctx)
+		return QDF_STATUS_E_INVAL;
+
+	qdf_spin_lock_bh(&psoc_ctx->lock);
+	qdf_mem_copy(latency, &psoc_ctx->sr_latency, sizeof(*latency));
+	qdf_spin_unlock_bh(&psoc_ctx->lock);
+
+	return QDF_STATUS_SUCCESS;
 }
 
 QDF_STATUS pmo_core_config_listen_interval(struct wlan_objmgr_vdev *vdev,
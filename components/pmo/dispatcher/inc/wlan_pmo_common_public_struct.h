@@ -562,4 +562,78 @@ struct pmo_ps_params {
 	uint16_t ps_ito;
 	uint16_t spec_wake;
 };
+
+/* Number of suspend/resume steps kept in the latency trace history */
+#define PMO_SR_TRACE_MAX 32
+
+/**
+ * enum pmo_sr_step - suspend/resume steps tracked by the latency trace
+ * @PMO_SR_STEP_OFFLOAD_CFG: enable host offloads on all adapters
+ * @PMO_SR_STEP_VDEV_SUSPEND_CFG: apply per vdev DTIM/listen interval,
+ *	power save parameters and dynamic wake events
+ * @PMO_SR_STEP_WOW_ENABLE: send WoW enable (or pdev suspend) and wait for
+ *	the firmware ack
+ * @PMO_SR_STEP_BUS_SUSPEND: hif bus suspend
+ * @PMO_SR_STEP_INITIAL_WAKEUP: delay from the initial wake up interrupt
+ *	until the host starts resuming the target
+ * @PMO_SR_STEP_BUS_RESUME: hif bus resume
+ * @PMO_SR_STEP_WOW_DISABLE: send host wakeup indication (or pdev resume)
+ *	and wait for the firmware to come out of WoW
+ * @PMO_SR_STEP_VDEV_RESUME_CFG: restore per vdev DTIM/listen interval and
+ *	power save parameters
+ * @PMO_SR_STEP_OFFLOAD_RESTORE: disable host offloads on all adapters
+ * @PMO_SR_STEP_MAX: number of steps
+ */
+enum pmo_sr_step {
+	PMO_SR_STEP_OFFLOAD_CFG,
+	PMO_SR_STEP_VDEV_SUSPEND_CFG,
+	PMO_SR_STEP_WOW_ENABLE,
+	PMO_SR_STEP_BUS_SUSPEND,
+	PMO_SR_STEP_INITIAL_WAKEUP,
+	PMO_SR_STEP_BUS_RESUME,
+	PMO_SR_STEP_WOW_DISABLE,
+	PMO_SR_STEP_VDEV_RESUME_CFG,
+	PMO_SR_STEP_OFFLOAD_RESTORE,
+	PMO_SR_STEP_MAX,
+};
+
+/**
+ * struct pmo_sr_step_stats - latency statistics of one suspend/resume step
+ * @count: number of times the step was recorded
+ * @last_us: duration of the last occurrence in microseconds
+ * @max_us: longest duration in microseconds
+ * @total_us: sum of all durations in microseconds
+ */
+struct pmo_sr_step_stats {
+	uint32_t count;
+	uint32_t last_us;
+	uint32_t max_us;
+	uint64_t total_us;
+};
+
+/**
+ * struct pmo_sr_trace_entry - one entry of the suspend/resume latency trace
+ * @timestamp_us: log timestamp when the step started
+ * @duration_us: duration of the step in microseconds
+ * @step: enum pmo_sr_step
+ * @type: enum qdf_suspend_type the step was part of
+ */
+struct pmo_sr_trace_entry {
+	uint64_t timestamp_us;
+	uint32_t duration_us;
+	uint8_t step;
+	uint8_t type;
+};
+
+/**
+ * struct pmo_sr_latency - suspend/resume latency trace
+ * @step: per step statistics
+ * @trace: history of the most recent steps
+ * @trace_idx: index of the next @trace entry to write
+ */
+struct pmo_sr_latency {
+	struct pmo_sr_step_stats step[PMO_SR_STEP_MAX];
+	struct pmo_sr_trace_entry trace[PMO_SR_TRACE_MAX];
+	uint32_t trace_idx;
+};
 #endif /* end  of _WLAN_PMO_COMMONP_STRUCT_H_ */
@@ -1130,6 +1130,31 @@ void ucfg_pmo_psoc_target_suspend_acknowledge(void *context, bool wow_nack,
  */
 void ucfg_pmo_psoc_wakeup_host_event_received(struct wlan_objmgr_psoc *psoc);
 
+/**
+ * ucfg_pmo_sr_latency_record() - record the duration of a suspend/resume step
+ * @psoc: objmgr psoc handle
+ * @step: suspend/resume step
+ * @type: type of the suspend the step is part of
+ * @begin_us: qdf_get_log_timestamp_usecs() when the step started
+ *
+ * Return: None
+ */
+void ucfg_pmo_sr_latency_record(struct wlan_objmgr_psoc *psoc,
+				enum pmo_sr_step step,
+				enum qdf_suspend_type type,
+				uint64_t begin_us);
+
+/**
+ * ucfg_pmo_get_sr_latency() - get a snapshot of the suspend/resume latency
+ *	trace
+ * @psoc: objmgr psoc handle
+ * @latency: buffer to copy the latency trace into
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS ucfg_pmo_get_sr_latency(struct wlan_objmgr_psoc *psoc,
+				   struct pmo_sr_latency *latency);
+
 /**
  * ucfg_pmo_config_listen_interval() - function to configure listen interval
  * @vdev: objmgr vdev
@@ -1943,6 +1968,20 @@ ucfg_pmo_psoc_wakeup_host_event_received(struct wlan_objmgr_psoc *psoc)
 {
 }
 
+static inline void
+ucfg_pmo_sr_latency_record(struct wlan_objmgr_psoc *psoc,
+			   enum pmo_sr_step step, enum qdf_suspend_type type,
+			   uint64_t begin_us)
+{
+}
+
+static inline QDF_STATUS
+ucfg_pmo_get_sr_latency(struct wlan_objmgr_psoc *psoc,
+			struct pmo_sr_latency *latency)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
 static inline QDF_STATUS
 ucfg_pmo_enable_hw_filter_in_fwr(struct wlan_objmgr_vdev *vdev)
 {
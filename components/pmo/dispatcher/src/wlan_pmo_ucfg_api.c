@@ -537,6 +537,20 @@ void ucfg_pmo_psoc_wakeup_host_event_received(struct wlan_objmgr_psoc *psoc)
 	pmo_core_psoc_wakeup_host_event_received(psoc);
 }
 
+void ucfg_pmo_sr_latency_record(struct wlan_objmgr_psoc *psoc,
+				enum pmo_sr_step step,
+				enum qdf_suspend_type type,
+				uint64_t begin_us)
+{
+	pmo_core_sr_latency_record(psoc, step, type, begin_us);
+}
+
+QDF_STATUS ucfg_pmo_get_sr_latency(struct wlan_objmgr_psoc *psoc,
+				   struct pmo_sr_latency *latency)
+{
+	return pmo_core_get_sr_latency(psoc, latency);
+}
+
 QDF_STATUS ucfg_pmo_enable_hw_filter_in_fwr(struct wlan_objmgr_vdev *vdev)
 {
 	return pmo_core_enable_hw_filter_in_fwr(vdev);
@@ -355,6 +355,24 @@ target_if_dp_send_dhcp_ind(uint16_t vdev_id,
 	return status;
 }
 
+/**
+ * target_if_dp_get_pending_wmi_cmds() - get the number of pending WMI commands
+ * @psoc: psoc handle
+ *
+ * Return: number of WMI commands sent and not yet completed
+ */
+static uint32_t
+target_if_dp_get_pending_wmi_cmds(struct wlan_objmgr_psoc *psoc)
+{
+	struct wmi_unified *wmi_handle;
+
+	wmi_handle = get_wmi_unified_hdl_from_psoc(psoc);
+	if (!wmi_handle)
+		return 0;
+
+	return wmi_get_pending_cmds(wmi_handle);
+}
+
 void target_if_dp_register_tx_ops(struct wlan_dp_psoc_sb_ops *sb_ops)
 {
 	sb_ops->dp_arp_stats_register_event_handler =
@@ -368,6 +386,7 @@ void target_if_dp_register_tx_ops(struct wlan_dp_psoc_sb_ops *sb_ops)
 	sb_ops->dp_lro_config_cmd = target_if_dp_lro_config_cmd;
 	sb_ops->dp_send_dhcp_ind =
 		target_if_dp_send_dhcp_ind;
+	sb_ops->dp_get_pending_wmi_cmds = target_if_dp_get_pending_wmi_cmds;
 }
 
 void target_if_dp_register_rx_ops(struct wlan_dp_psoc_nb_ops *nb_ops)
@@ -190,6 +190,10 @@
 #define QCA_SUPPORT_TX_THROTTLE (1)
 #endif
 
+#ifdef CONFIG_QCA_LL_TX_THROTTLE_SHAPER
+#define QCA_LL_TX_THROTTLE_SHAPER (1)
+#endif
+
 #ifdef CONFIG_WMI_INTERFACE_EVENT_LOGGING
 #define WMI_INTERFACE_EVENT_LOGGING (1)
 #endif
@@ -573,6 +577,9 @@
 #ifdef CONFIG_WLAN_NAPI_DEBUG
 #define FEATURE_NAPI_DEBUG (1)
 #endif
+#ifdef CONFIG_WLAN_NAPI_AFFINITY_MGR
+#define WLAN_NAPI_AFFINITY_MGR (1)
+#endif
 #endif
 
 #if defined(CONFIG_ARCH_MSM) || defined(CONFIG_ARCH_QCOM)
@@ -595,6 +602,10 @@
 #define QCA_LL_TX_FLOW_GLOBAL_MGMT_POOL (1)
 #endif
 
+#ifdef CONFIG_WLAN_TX_FLOW_CONTROL_REBALANCE
+#define QCA_LL_TX_FLOW_CONTROL_REBALANCE (1)
+#endif
+
 #ifdef CONFIG_WLAN_TX_FLOW_CONTROL_LEGACY
 #define QCA_LL_LEGACY_TX_FLOW_CONTROL (1)
 #endif
@@ -1578,6 +1589,10 @@
 #define DP_MEM_PRE_ALLOC (1)
 #endif
 
+#ifdef CONFIG_DP_PREALLOC_AUTO_SIZE
+#define DP_PREALLOC_AUTO_SIZE (1)
+#endif
+
 #ifdef CONFIG_DP_TXRX_SOC_ATTACH
 #define DP_TXRX_SOC_ATTACH (1)
 #endif
@@ -2963,4 +2978,52 @@
 #define QDF_MAX_NO_OF_SAP_MODE CONFIG_QDF_MAX_NO_OF_SAP_MODE
 #endif
 
+#ifdef CONFIG_WLAN_DP_HOST_APF
+#define WLAN_DP_HOST_APF (1)
+#endif
+
+#ifdef CONFIG_DP_HOST_APF_TEST
+#define WLAN_DP_HOST_APF_TEST (1)
+#endif
+
+#ifdef CONFIG_DP_PKT_CLASS_TEST
+#define WLAN_DP_PKT_CLASS_TEST (1)
+#endif
+
+#ifdef CONFIG_POLICY_MGR_TEST
+#define WLAN_POLICY_MGR_TEST (1)
+#endif
+
+#ifdef CONFIG_OL_RX_PN_TEST
+#define WLAN_OL_RX_PN_TEST (1)
+#endif
+
+#ifdef CONFIG_OL_RX_DEFRAG_TEST
+#define WLAN_OL_RX_DEFRAG_TEST (1)
+#endif
+
+#ifdef CONFIG_OL_TX_PEER_BAL_TEST
+#define WLAN_OL_TX_PEER_BAL_TEST (1)
+#endif
+
+#ifdef CONFIG_PE_SESSION_LOOKUP_TEST
+#define WLAN_PE_SESSION_LOOKUP_TEST (1)
+#endif
+
+#ifdef CONFIG_WLAN_DP_STATS_SAMPLER
+#define WLAN_DP_STATS_SAMPLER (1)
+#endif
+
+#ifdef CONFIG_DP_STATS_SAMPLER_TEST
+#define WLAN_DP_STATS_SAMPLER_TEST (1)
+#endif
+
+#ifdef CONFIG_WLAN_DP_STALL_CORRELATOR
+#define WLAN_DP_STALL_CORRELATOR (1)
+#endif
+
+#ifdef CONFIG_DP_STALL_CORR_TEST
+#define WLAN_DP_STALL_CORR_TEST (1)
+#endif
+
 #endif /* CONFIG_TO_FEATURE_H */
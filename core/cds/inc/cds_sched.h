@@ -144,6 +144,9 @@ typedef struct _cds_sched_context {
 	bool rx_affinity_required;
 	uint8_t conf_rx_thread_ul_affinity;
 
+	/* CPUs the affinity manager placed the datapath on, empty if none */
+	struct cpumask affinity_hint_mask;
+
 	/* sta id packets under processing in thread context*/
 	uint16_t active_staid;
 #endif
@@ -278,6 +281,19 @@ void cds_set_rx_thread_ul_cpu_mask(uint8_t cpu_affinity_mask);
  */
 void cds_set_rx_thread_cpu_mask(uint8_t cpu_affinity_mask);
 
+/**
+ * cds_sched_set_affinity_hint() - set CPUs preferred for high throughput
+ * @mask: CPUs to affine the rx threads to, empty mask to clear the hint
+ *
+ * Used by the datapath CPU affinity manager. The hint replaces the perf
+ * cluster default when high throughput is required and no rx thread CPU
+ * mask is configured in INI, and is applied right away if high throughput
+ * is currently required.
+ *
+ * Return: None
+ */
+void cds_sched_set_affinity_hint(qdf_cpu_mask *mask);
+
 /**
  * cds_drop_rxpkt_by_staid() - api to drop pending rx packets for a sta
  * @pSchedContext: Pointer to the global CDS Sched Context
@@ -362,6 +378,8 @@ static inline void cds_set_rx_thread_ul_cpu_mask(uint8_t cpu_affinity_mask) {}
 
 static inline void cds_set_rx_thread_cpu_mask(uint8_t cpu_affinity_mask) {}
 
+static inline void cds_sched_set_affinity_hint(qdf_cpu_mask *mask) {}
+
 static inline
 void cds_drop_rxpkt_by_staid(p_cds_sched_context pSchedContext, uint16_t staId)
 {
@@ -162,8 +162,9 @@ static void cds_rx_thread_log_cpu_affinity_change(unsigned char core_affine_cnt,
  * Find current online cores.
  * During high TPUT,
  * 1) If user INI configured cores, affine to those cores
- * 2) Otherwise perf cores.
- * 3) Otherwise to all cores.
+ * 2) Otherwise the cores picked by the affinity manager, if any
+ * 3) Otherwise perf cores.
+ * 4) Otherwise to all cores.
  *
  * During low TPUT, set affinity to any core, let system decide.
  *
@@ -196,6 +197,11 @@ static int cds_sched_find_attach_cpu(p_cds_sched_context pSchedContext,
 				if (pSchedContext->conf_rx_thread_cpu_mask &
 								(1 << cpus))
 					qdf_cpumask_set_cpu(cpus, &new_mask);
+			} else if (!cpumask_empty(
+					&pSchedContext->affinity_hint_mask)) {
+				if (cpumask_test_cpu(cpus,
+					&pSchedContext->affinity_hint_mask))
+					qdf_cpumask_set_cpu(cpus, &new_mask);
 			} else if (topology_physical_package_id(cpus) ==
 						 CDS_CPU_CLUSTER_TYPE_PERF) {
 				qdf_cpumask_set_cpu(cpus, &new_mask);
@@ -252,6 +258,27 @@ int cds_sched_handle_cpu_hot_plug(void)
 	return 0;
 }
 
+void cds_sched_set_affinity_hint(qdf_cpu_mask *mask)
+{
+	p_cds_sched_context pschedcontext = get_cds_sched_ctxt();
+
+	if (!pschedcontext)
+		return;
+
+	mutex_lock(&pschedcontext->affinity_lock);
+	if (cpumask_equal(&pschedcontext->affinity_hint_mask, mask)) {
+		mutex_unlock(&pschedcontext->affinity_lock);
+		return;
+	}
+
+	cpumask_copy(&pschedcontext->affinity_hint_mask, mask);
+	if (pschedcontext->high_throughput_required &&
+	    !cds_is_load_or_unload_in_progress() &&
+	    cds_sched_find_attach_cpu(pschedcontext, true))
+		cds_err("failed to apply affinity hint");
+	mutex_unlock(&pschedcontext->affinity_lock);
+}
+
 void cds_sched_handle_rx_thread_affinity_req(bool high_throughput)
 {
 	p_cds_sched_context pschedcontext = get_cds_sched_ctxt();
@@ -194,6 +194,12 @@ void (*htt_rx_mpdu_desc_pn)(htt_pdev_handle pdev,
 			    void *mpdu_desc,
 			    union htt_rx_pn_t *pn, int pn_len_bits);
 
+void (*htt_rx_mpdu_desc_pn_batch)(htt_pdev_handle pdev,
+				  void **mpdu_desc,
+				  union htt_rx_pn_t *pn,
+				  uint8_t *encrypted, int num,
+				  int pn_len_bits);
+
 uint8_t (*htt_rx_mpdu_desc_tid)(htt_pdev_handle pdev, void *mpdu_desc);
 
 bool (*htt_rx_msdu_desc_completes_mpdu)(htt_pdev_handle pdev, void *msdu_desc);
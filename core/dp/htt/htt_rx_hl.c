@@ -448,6 +448,21 @@ htt_rx_mpdu_desc_pn_hl(
 	}
 }
 
+static void
+htt_rx_mpdu_desc_pn_batch_hl(htt_pdev_handle pdev, void **mpdu_desc,
+			     union htt_rx_pn_t *pn, uint8_t *encrypted,
+			     int num, int pn_len_bits)
+{
+	int i;
+
+	for (i = 0; i < num; i++) {
+		encrypted[i] = htt_rx_mpdu_is_encrypted_hl(pdev, mpdu_desc[i]);
+		if (encrypted[i])
+			htt_rx_mpdu_desc_pn_hl(pdev, mpdu_desc[i], &pn[i],
+					       pn_len_bits);
+	}
+}
+
 /**
  * htt_rx_mpdu_desc_tid_hl() - Returns the TID value from the Rx descriptor
  *                             for High Latency driver
@@ -522,6 +537,7 @@ int htt_rx_attach(struct htt_pdev_t *pdev)
 	htt_rx_mpdu_desc_retry = htt_rx_mpdu_desc_retry_hl;
 	htt_rx_mpdu_desc_seq_num = htt_rx_mpdu_desc_seq_num_hl;
 	htt_rx_mpdu_desc_pn = htt_rx_mpdu_desc_pn_hl;
+	htt_rx_mpdu_desc_pn_batch = htt_rx_mpdu_desc_pn_batch_hl;
 	htt_rx_mpdu_desc_tid = htt_rx_mpdu_desc_tid_hl;
 	htt_rx_msdu_desc_completes_mpdu = htt_rx_msdu_desc_completes_mpdu_hl;
 	htt_rx_msdu_first_msdu_flag = htt_rx_msdu_first_msdu_flag_hl;
@@ -857,6 +857,21 @@ htt_rx_mpdu_desc_pn_ll(htt_pdev_handle pdev,
 	};
 }
 
+static void
+htt_rx_mpdu_desc_pn_batch_ll(htt_pdev_handle pdev, void **mpdu_desc,
+			     union htt_rx_pn_t *pn, uint8_t *encrypted,
+			     int num, int pn_len_bits)
+{
+	int i;
+
+	for (i = 0; i < num; i++) {
+		encrypted[i] = htt_rx_mpdu_is_encrypted_ll(pdev, mpdu_desc[i]);
+		if (encrypted[i])
+			htt_rx_mpdu_desc_pn_ll(pdev, mpdu_desc[i], &pn[i],
+					       pn_len_bits);
+	}
+}
+
 /**
  * htt_rx_mpdu_desc_tid_ll() - Returns the TID value from the Rx descriptor
  *                             for Low Latency driver
@@ -2237,6 +2252,7 @@ int htt_rx_attach(struct htt_pdev_t *pdev)
 	htt_rx_mpdu_desc_retry = htt_rx_mpdu_desc_retry_ll;
 	htt_rx_mpdu_desc_seq_num = htt_rx_mpdu_desc_seq_num_ll;
 	htt_rx_mpdu_desc_pn = htt_rx_mpdu_desc_pn_ll;
+	htt_rx_mpdu_desc_pn_batch = htt_rx_mpdu_desc_pn_batch_ll;
 	htt_rx_mpdu_desc_tid = htt_rx_mpdu_desc_tid_ll;
 	htt_rx_msdu_desc_completes_mpdu = htt_rx_msdu_desc_completes_mpdu_ll;
 	htt_rx_msdu_first_msdu_flag = htt_rx_msdu_first_msdu_flag_ll;
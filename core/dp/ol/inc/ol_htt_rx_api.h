@@ -439,6 +439,27 @@ extern void (*htt_rx_mpdu_desc_pn)(htt_pdev_handle pdev,
 				   void *mpdu_desc,
 				   union htt_rx_pn_t *pn, int pn_len_bits);
 
+/**
+ * @brief Find the encryption flag and packet number for a batch of MPDUs.
+ * @details
+ *  Batched form of htt_rx_mpdu_is_encrypted() and htt_rx_mpdu_desc_pn(),
+ *  which costs a single indirect call for the whole batch rather than two
+ *  per MPDU. The PN is only read for encrypted MPDUs, the pn entries of
+ *  unencrypted MPDUs are left untouched.
+ *
+ * @param pdev - the HTT instance the rx data was received on
+ * @param mpdu_desc - array of abstract descriptors, one per MPDU
+ * @param pn - array the packet numbers are copied into
+ * @param encrypted - array the encryption flags are copied into
+ * @param num - number of MPDUs in the batch
+ * @param pn_len_bits - the PN size, in bits
+ */
+extern void (*htt_rx_mpdu_desc_pn_batch)(htt_pdev_handle pdev,
+					 void **mpdu_desc,
+					 union htt_rx_pn_t *pn,
+					 uint8_t *encrypted, int num,
+					 int pn_len_bits);
+
 /**
  * @brief This function Returns the TID value from the Rx descriptor
  *                             for Low Latency driver
@@ -420,8 +420,9 @@ ol_rx_reorder_store_frag(ol_txrx_pdev_handle pdev,
 			 unsigned int tid, uint16_t seq_num, qdf_nbuf_t frag)
 {
 	struct ieee80211_frame *fmac_hdr, *mac_hdr;
-	uint8_t fragno, more_frag, all_frag_present = 0;
+	uint8_t fragno, more_frag;
 	struct ol_rx_reorder_array_elem_t *rx_reorder_array_elem;
+	enum ol_rx_frag_slot_status status;
 	uint16_t frxseq, rxseq, seq;
 	htt_pdev_handle htt_pdev = pdev->htt_pdev;
 	void *rx_desc;
@@ -461,15 +462,6 @@ ol_rx_reorder_store_frag(ol_txrx_pdev_handle pdev,
 		return;
 	}
 
-	if ((!more_frag) && (!fragno) && (!rx_reorder_array_elem->head)) {
-		rx_reorder_array_elem->head = frag;
-		rx_reorder_array_elem->tail = frag;
-		qdf_nbuf_set_next(frag, NULL);
-		ol_rx_defrag(pdev, peer, tid, rx_reorder_array_elem->head);
-		rx_reorder_array_elem->head = NULL;
-		rx_reorder_array_elem->tail = NULL;
-		return;
-	}
 	if (rx_reorder_array_elem->head) {
 		fmac_hdr = (struct ieee80211_frame *)
 			ol_rx_frag_get_mac_hdr(htt_pdev,
@@ -492,14 +484,18 @@ ol_rx_reorder_store_frag(ol_txrx_pdev_handle pdev,
 		}
 	}
 
-	ol_rx_fraglist_insert(htt_pdev, &rx_reorder_array_elem->head,
-			      &rx_reorder_array_elem->tail, frag,
-			      &all_frag_present);
+	status = ol_rx_frag_slot_insert(&peer->tids_rx_reorder[tid], fragno,
+					more_frag, frag);
+	if (status == OL_RX_FRAG_SLOT_DUP ||
+	    status == OL_RX_FRAG_SLOT_INVALID) {
+		htt_rx_desc_frame_free(htt_pdev, frag);
+		return;
+	}
 
 	if (pdev->rx.flags.defrag_timeout_check)
 		ol_rx_defrag_waitlist_remove(peer, tid);
 
-	if (all_frag_present) {
+	if (status == OL_RX_FRAG_SLOT_COMPLETE) {
 		ol_rx_defrag(pdev, peer, tid, rx_reorder_array_elem->head);
 		rx_reorder_array_elem->head = NULL;
 		rx_reorder_array_elem->tail = NULL;
@@ -514,87 +510,60 @@ ol_rx_reorder_store_frag(ol_txrx_pdev_handle pdev,
 	}
 }
 
-/*
- * Insert and store fragments
- */
-void
-ol_rx_fraglist_insert(htt_pdev_handle htt_pdev,
-		      qdf_nbuf_t *head_addr,
-		      qdf_nbuf_t *tail_addr,
-		      qdf_nbuf_t frag, uint8_t *all_frag_present)
+enum ol_rx_frag_slot_status
+ol_rx_frag_slot_insert(struct ol_rx_reorder_t *rx_reorder, uint8_t fragno,
+		       bool more_frag, qdf_nbuf_t frag)
 {
-	qdf_nbuf_t next, prev = NULL, cur = *head_addr;
-	struct ieee80211_frame *mac_hdr, *cmac_hdr, *next_hdr, *lmac_hdr;
-	uint8_t fragno, cur_fragno, lfragno, next_fragno;
-	uint8_t last_morefrag = 1, count = 0;
+	struct ol_rx_reorder_array_elem_t *elem = &rx_reorder->array[0];
+	uint32_t bit, lower, higher;
+	qdf_nbuf_t prev, next;
+
+	/* the slots went stale when the chain was consumed or flushed */
+	if (!elem->head) {
+		rx_reorder->frag_bitmap = 0;
+		rx_reorder->frag_last = -1;
+	}
 
-	qdf_assert(frag);
+	if (fragno >= OL_RX_DEFRAG_MAX_FRAGS)
+		return OL_RX_FRAG_SLOT_INVALID;
 
-	mac_hdr = (struct ieee80211_frame *)
-		ol_rx_frag_get_mac_hdr(htt_pdev, frag);
-	fragno = qdf_le16_to_cpu(*(uint16_t *) mac_hdr->i_seq) &
-		IEEE80211_SEQ_FRAG_MASK;
+	bit = 1 << fragno;
+	if (rx_reorder->frag_bitmap & bit)
+		return OL_RX_FRAG_SLOT_DUP;
 
-	if (!(*head_addr)) {
-		*head_addr = frag;
-		*tail_addr = frag;
-		qdf_nbuf_set_next(*tail_addr, NULL);
-		return;
+	lower = rx_reorder->frag_bitmap & (bit - 1);
+	higher = rx_reorder->frag_bitmap & ~((bit << 1) - 1);
+
+	if (!more_frag) {
+		/* only one last fragment and nothing after it */
+		if (rx_reorder->frag_last >= 0 || higher)
+			return OL_RX_FRAG_SLOT_INVALID;
+		rx_reorder->frag_last = fragno;
+	} else if (rx_reorder->frag_last >= 0 &&
+		   fragno > rx_reorder->frag_last) {
+		return OL_RX_FRAG_SLOT_INVALID;
 	}
-	/* For efficiency, compare with tail first */
-	lmac_hdr = (struct ieee80211_frame *)
-		ol_rx_frag_get_mac_hdr(htt_pdev, *tail_addr);
-	lfragno = qdf_le16_to_cpu(*(uint16_t *) lmac_hdr->i_seq) &
-		  IEEE80211_SEQ_FRAG_MASK;
-	if (fragno > lfragno) {
-		qdf_nbuf_set_next(*tail_addr, frag);
-		*tail_addr = frag;
-		qdf_nbuf_set_next(*tail_addr, NULL);
-	} else {
-		do {
-			cmac_hdr = (struct ieee80211_frame *)
-				ol_rx_frag_get_mac_hdr(htt_pdev, cur);
-			cur_fragno =
-				qdf_le16_to_cpu(*(uint16_t *) cmac_hdr->i_seq) &
-				IEEE80211_SEQ_FRAG_MASK;
-			prev = cur;
-			cur = qdf_nbuf_next(cur);
-		} while (fragno > cur_fragno);
-
-		if (fragno == cur_fragno) {
-			htt_rx_desc_frame_free(htt_pdev, frag);
-			*all_frag_present = 0;
-			return;
-		}
 
+	prev = lower ? rx_reorder->frags[fls(lower) - 1] : NULL;
+	next = higher ? rx_reorder->frags[ffs(higher) - 1] : NULL;
+
+	qdf_nbuf_set_next(frag, next);
+	if (prev)
 		qdf_nbuf_set_next(prev, frag);
-		qdf_nbuf_set_next(frag, cur);
-	}
-	next = qdf_nbuf_next(*head_addr);
-	lmac_hdr = (struct ieee80211_frame *)ol_rx_frag_get_mac_hdr(htt_pdev,
-								    *tail_addr);
-	last_morefrag = lmac_hdr->i_fc[1] & IEEE80211_FC1_MORE_FRAG;
-	if (!last_morefrag) {
-		do {
-			next_hdr =
-				(struct ieee80211_frame *)
-				ol_rx_frag_get_mac_hdr(htt_pdev, next);
-			next_fragno =
-				qdf_le16_to_cpu(*(uint16_t *) next_hdr->i_seq) &
-				IEEE80211_SEQ_FRAG_MASK;
-			count++;
-			if (next_fragno != count)
-				break;
+	else
+		elem->head = frag;
+	if (!next)
+		elem->tail = frag;
 
-			next = qdf_nbuf_next(next);
-		} while (next);
+	rx_reorder->frags[fragno] = frag;
+	rx_reorder->frag_bitmap |= bit;
 
-		if (!next) {
-			*all_frag_present = 1;
-			return;
-		}
-	}
-	*all_frag_present = 0;
+	if (rx_reorder->frag_last >= 0 &&
+	    rx_reorder->frag_bitmap ==
+	    (1U << (rx_reorder->frag_last + 1)) - 1)
+		return OL_RX_FRAG_SLOT_COMPLETE;
+
+	return OL_RX_FRAG_SLOT_STORED;
 }
 
 /*
@@ -617,7 +586,8 @@ void ol_rx_defrag_waitlist_remove(struct ol_txrx_peer_t *peer, unsigned int tid)
 	struct ol_txrx_pdev_t *pdev = peer->vdev->pdev;
 	struct ol_rx_reorder_t *rx_reorder = &peer->tids_rx_reorder[tid];
 
-	if (rx_reorder->defrag_waitlist_elem.tqe_next) {
+	/* tqe_next is NULL for the last entry, tqe_prev never is if linked */
+	if (rx_reorder->defrag_waitlist_elem.tqe_prev) {
 
 		TAILQ_REMOVE(&pdev->rx.defrag.waitlist, rx_reorder,
 			     defrag_waitlist_elem);
@@ -644,13 +614,18 @@ void ol_rx_defrag_waitlist_flush(struct ol_txrx_pdev_t *pdev)
 	struct ol_rx_reorder_t *rx_reorder, *tmp;
 	uint32_t now_ms = qdf_system_ticks_to_msecs(qdf_system_ticks());
 
+	/*
+	 * Every TID is (re)added at the tail with the same pdev timeout, so
+	 * the waitlist is in expiry order and the walk stops at the first
+	 * TID still waiting.
+	 */
 	TAILQ_FOREACH_SAFE(rx_reorder, &pdev->rx.defrag.waitlist,
 			   defrag_waitlist_elem, tmp) {
 		struct ol_txrx_peer_t *peer;
 		struct ol_rx_reorder_t *rx_reorder_base;
 		unsigned int tid;
 
-		if (rx_reorder->defrag_timeout_ms > now_ms)
+		if ((int32_t)(rx_reorder->defrag_timeout_ms - now_ms) > 0)
 			break;
 
 		tid = rx_reorder->tid;
@@ -884,24 +859,29 @@ ol_rx_defrag(ol_txrx_pdev_handle pdev,
 		break;
 	}
 
-	msdu = ol_rx_defrag_decap_recombine(htt_pdev, frag_list, hdr_space);
-	if (!msdu)
-		return;
-
+	/*
+	 * Verify the MIC over the fragments in place, so a forged MPDU is
+	 * dropped before any payload is copied by the recombination.
+	 */
 	if (tkip_demic) {
 		qdf_mem_copy(key,
 			     peer->security[index].michael_key,
 			     sizeof(peer->security[index].michael_key));
-		if (!ol_rx_frag_tkip_demic(pdev, key, msdu, hdr_space)) {
+		if (!ol_rx_frag_tkip_demic_chain(pdev, key, frag_list,
+						 hdr_space)) {
 			uint64_t pn = 0;
 			ol_rx_err(pdev->ctrl_pdev,
 				  vdev->vdev_id, peer->mac_addr.raw, tid, 0,
-				  OL_RX_ERR_TKIP_MIC, msdu, &pn, 0);
-			htt_rx_desc_frame_free(htt_pdev, msdu);
+				  OL_RX_ERR_TKIP_MIC, frag_list, &pn, 0);
+			ol_rx_frames_free(htt_pdev, frag_list);
 			ol_txrx_err("TKIP demic failed");
 			return;
 		}
 	}
+
+	msdu = ol_rx_defrag_decap_recombine(htt_pdev, frag_list, hdr_space);
+	if (!msdu)
+		return;
 	wh = (struct ieee80211_frame *)ol_rx_frag_get_mac_hdr(htt_pdev, msdu);
 	if (DEFRAG_IEEE80211_QOS_HAS_SEQ(wh))
 		ol_rx_defrag_qos_decap(pdev, msdu, hdr_space);
@@ -1278,6 +1258,154 @@ ol_rx_defrag_mic(ol_txrx_pdev_handle pdev,
 	return OL_RX_DEFRAG_OK;
 }
 
+/**
+ * ol_rx_defrag_mic_chain() - Michael MIC over the payload of a fragment chain
+ * @pdev: data path pdev handle
+ * @key: Michael key
+ * @frag_list: fragments, each starting with its 802.11 header
+ * @hdrlen: 802.11 header length
+ * @data_len: payload length to cover, from the first fragment on
+ * @mic: computed MIC
+ *
+ * A 32-bit block split between fragments is gathered in a bounce word, the
+ * payload is otherwise read in place.
+ *
+ * Return: OL_RX_DEFRAG_OK on success else OL_RX_DEFRAG_ERR
+ */
+static int
+ol_rx_defrag_mic_chain(ol_txrx_pdev_handle pdev, const uint8_t *key,
+		       qdf_nbuf_t frag_list, uint16_t hdrlen,
+		       uint32_t data_len, uint8_t mic[])
+{
+	uint8_t hdr[16] = { 0, };
+	uint8_t blk[sizeof(uint32_t)];
+	uint32_t l, r, space, blk_len = 0;
+	const uint8_t *data;
+	void *rx_desc_old_position = NULL;
+	int rx_desc_len;
+	qdf_nbuf_t cur;
+
+	rx_desc_len = ol_rx_get_desc_len(pdev->htt_pdev, frag_list,
+					 &rx_desc_old_position);
+	ol_rx_defrag_michdr((struct ieee80211_frame *)
+			    (qdf_nbuf_data(frag_list) + rx_desc_len), hdr);
+	l = get_le32(key);
+	r = get_le32(key + 4);
+
+	/* Michael MIC pseudo header: DA, SA, 3 x 0, Priority */
+	l ^= get_le32(hdr);
+	michael_block(l, r);
+	l ^= get_le32(&hdr[4]);
+	michael_block(l, r);
+	l ^= get_le32(&hdr[8]);
+	michael_block(l, r);
+	l ^= get_le32(&hdr[12]);
+	michael_block(l, r);
+
+	for (cur = frag_list; cur && data_len; cur = qdf_nbuf_next(cur)) {
+		rx_desc_len = ol_rx_get_desc_len(pdev->htt_pdev, cur,
+						 &rx_desc_old_position);
+		data = (uint8_t *)qdf_nbuf_data(cur) + rx_desc_len + hdrlen;
+		space = qdf_min((uint32_t)(ol_rx_defrag_len(cur) -
+					   rx_desc_len - hdrlen), data_len);
+		data_len -= space;
+
+		/* finish the block started in the previous fragment */
+		while (blk_len && space) {
+			blk[blk_len++] = *data++;
+			space--;
+			if (blk_len == sizeof(uint32_t)) {
+				l ^= get_le32(blk);
+				michael_block(l, r);
+				blk_len = 0;
+			}
+		}
+
+		while (space >= sizeof(uint32_t)) {
+			l ^= get_le32(data);
+			michael_block(l, r);
+			data += sizeof(uint32_t);
+			space -= sizeof(uint32_t);
+		}
+
+		while (space) {
+			blk[blk_len++] = *data++;
+			space--;
+		}
+	}
+	if (data_len)
+		return OL_RX_DEFRAG_ERR;
+
+	/* Last block and padding (0x5a, 4..7 x 0) */
+	blk[blk_len++] = 0x5a;
+	while (blk_len < sizeof(uint32_t))
+		blk[blk_len++] = 0;
+	l ^= get_le32(blk);
+	michael_block(l, r);
+	michael_block(l, r);
+	put_le32(mic, l);
+	put_le32(mic + 4, r);
+
+	return OL_RX_DEFRAG_OK;
+}
+
+/*
+ * Verify and strip MIC from the fragment chain.
+ */
+int
+ol_rx_frag_tkip_demic_chain(ol_txrx_pdev_handle pdev, const uint8_t *key,
+			    qdf_nbuf_t frag_list, uint16_t hdrlen)
+{
+	uint8_t mic[IEEE80211_WEP_MICLEN];
+	uint8_t mic0[IEEE80211_WEP_MICLEN];
+	void *rx_desc_old_position = NULL;
+	qdf_nbuf_t cur, last = NULL, prev = NULL;
+	uint32_t pktlen = 0, last_len = 0, prev_len = 0;
+	uint32_t len, tail, head;
+	int rx_desc_len;
+
+	for (cur = frag_list; cur; cur = qdf_nbuf_next(cur)) {
+		rx_desc_len = ol_rx_get_desc_len(pdev->htt_pdev, cur,
+						 &rx_desc_old_position);
+		if (ol_rx_defrag_len(cur) < rx_desc_len + hdrlen)
+			return OL_RX_DEFRAG_ERR;
+
+		len = ol_rx_defrag_len(cur) - rx_desc_len - hdrlen;
+		pktlen += len;
+		prev = last;
+		prev_len = last_len;
+		last = cur;
+		last_len = len;
+	}
+	if (pktlen < f_tkip.ic_miclen)
+		return OL_RX_DEFRAG_ERR;
+
+	/* the received MIC may start in the fragment before the last one */
+	tail = qdf_min(last_len, (uint32_t)f_tkip.ic_miclen);
+	head = f_tkip.ic_miclen - tail;
+	if (head && (!prev || prev_len < head))
+		return OL_RX_DEFRAG_ERR;
+
+	if (ol_rx_defrag_mic_chain(pdev, key, frag_list, hdrlen,
+				   pktlen - f_tkip.ic_miclen, mic) !=
+	    OL_RX_DEFRAG_OK)
+		return OL_RX_DEFRAG_ERR;
+
+	if (head)
+		ol_rx_defrag_copydata(prev, ol_rx_defrag_len(prev) - head,
+				      head, (caddr_t)mic0);
+	ol_rx_defrag_copydata(last, ol_rx_defrag_len(last) - tail, tail,
+			      (caddr_t)(mic0 + head));
+	if (qdf_mem_cmp(mic, mic0, f_tkip.ic_miclen))
+		return OL_RX_DEFRAG_ERR;
+
+	qdf_nbuf_trim_tail(last, tail);
+	if (head)
+		qdf_nbuf_trim_tail(prev, head);
+
+	return OL_RX_DEFRAG_OK;
+}
+
 /*
  * Calculate headersize
  */
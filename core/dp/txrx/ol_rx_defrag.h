@@ -49,11 +49,36 @@ enum {
 #define ol_rx_defrag_len(buf) \
 	qdf_nbuf_len(buf)
 
-void
-ol_rx_fraglist_insert(htt_pdev_handle htt_pdev,
-		      qdf_nbuf_t *head_addr,
-		      qdf_nbuf_t *tail_addr,
-		      qdf_nbuf_t frag, uint8_t *all_frag_present);
+/**
+ * enum ol_rx_frag_slot_status - outcome of storing a fragment
+ * @OL_RX_FRAG_SLOT_STORED: stored, fragments still missing
+ * @OL_RX_FRAG_SLOT_COMPLETE: stored, all fragments of the MPDU present
+ * @OL_RX_FRAG_SLOT_DUP: not stored, fragment number already present
+ * @OL_RX_FRAG_SLOT_INVALID: not stored, inconsistent with the last fragment
+ */
+enum ol_rx_frag_slot_status {
+	OL_RX_FRAG_SLOT_STORED,
+	OL_RX_FRAG_SLOT_COMPLETE,
+	OL_RX_FRAG_SLOT_DUP,
+	OL_RX_FRAG_SLOT_INVALID,
+};
+
+/**
+ * ol_rx_frag_slot_insert() - store a fragment in the slot of its number
+ * @rx_reorder: rx reorder state of the TID
+ * @fragno: fragment number
+ * @more_frag: more fragments flag of the fragment
+ * @frag: fragment
+ *
+ * Links @frag into the fragment chain held in array[0] between the closest
+ * lower and higher fragment numbers present, found from the slot bitmap.
+ * A fragment that is not stored is left to the caller to free.
+ *
+ * Return: ol_rx_frag_slot_status
+ */
+enum ol_rx_frag_slot_status
+ol_rx_frag_slot_insert(struct ol_rx_reorder_t *rx_reorder, uint8_t fragno,
+		       bool more_frag, qdf_nbuf_t frag);
 
 void ol_rx_defrag_waitlist_add(struct ol_txrx_peer_t *peer, unsigned int tid);
 
@@ -85,6 +110,23 @@ int
 ol_rx_frag_tkip_demic(ol_txrx_pdev_handle pdev,
 		      const uint8_t *key, qdf_nbuf_t msdu, uint16_t hdrlen);
 
+/**
+ * ol_rx_frag_tkip_demic_chain() - verify and strip the Michael MIC of
+ *	a fragment chain
+ * @pdev: data path pdev handle
+ * @key: Michael key
+ * @frag_list: decapped fragments, each still with its 802.11 header
+ * @hdrlen: 802.11 header length
+ *
+ * Computes the MIC over the payload of all fragments in place, the MIC
+ * itself may straddle the last two fragments.
+ *
+ * Return: OL_RX_DEFRAG_OK on success else OL_RX_DEFRAG_ERR
+ */
+int
+ol_rx_frag_tkip_demic_chain(ol_txrx_pdev_handle pdev, const uint8_t *key,
+			    qdf_nbuf_t frag_list, uint16_t hdrlen);
+
 int
 ol_rx_frag_ccmp_decap(ol_txrx_pdev_handle pdev,
 		      qdf_nbuf_t nbuf, uint16_t hdrlen);
@@ -32,6 +32,9 @@
 #include <ol_tx.h>
 #include <ol_txrx.h>
 
+/* Window in ms over which the forwarded packets per second are computed */
+#define OL_RX_FWD_RATE_WINDOW_MS	1000
+
 /*
  * Porting from Ap11PrepareForwardedPacket.
  * This routine is called when a RX data frame from an associated station is
@@ -95,19 +98,20 @@ static inline void ol_ap_fwd_check(struct ol_txrx_vdev_t *vdev, qdf_nbuf_t msdu)
 	}
 }
 
-static inline void ol_rx_fwd_to_tx(struct ol_txrx_vdev_t *vdev, qdf_nbuf_t msdu)
+/**
+ * ol_rx_fwd_prep() - prepare a rx frame to be sent again by the tx path
+ * @vdev: vdev the frame will be sent on
+ * @msdu: rx frame
+ *
+ * Return: none
+ */
+static inline void ol_rx_fwd_prep(struct ol_txrx_vdev_t *vdev, qdf_nbuf_t msdu)
 {
 	struct ol_txrx_pdev_t *pdev = vdev->pdev;
 
 	if (pdev->frame_format == wlan_frm_fmt_native_wifi)
 		ol_ap_fwd_check(vdev, msdu);
 
-	/*
-	 * Map the netbuf, so it's accessible to the DMA that
-	 * sends it to the target.
-	 */
-	qdf_nbuf_set_next(msdu, NULL);  /* add NULL terminator */
-
 	/* for HL, point to payload before send to tx again.*/
 		if (pdev->cfg.is_high_latency) {
 			void *rx_desc;
@@ -122,17 +126,91 @@ static inline void ol_rx_fwd_to_tx(struct ol_txrx_vdev_t *vdev, qdf_nbuf_t msdu)
 	/* Clear the msdu control block as it will be re-interpreted */
 	qdf_mem_zero(msdu->cb, sizeof(msdu->cb));
 	/* update any cb field expected by OL_TX_SEND */
+}
 
-	msdu = OL_TX_SEND(vdev, msdu);
+/**
+ * ol_rx_fwd_to_tx() - hand a batch of forwarded frames to the tx path
+ * @vdev: vdev the frames are sent on
+ * @fwd_list: NULL terminated list of prepared frames
+ *
+ * Return: none
+ */
+static void ol_rx_fwd_to_tx(struct ol_txrx_vdev_t *vdev, qdf_nbuf_t fwd_list)
+{
+	qdf_nbuf_t msdu;
 
-	if (msdu) {
-		/*
-		 * The frame was not accepted by the tx.
-		 * We could store the frame and try again later,
-		 * but the simplest solution is to discard the frames.
-		 */
-		qdf_nbuf_tx_free(msdu, QDF_NBUF_PKT_ERROR);
+	fwd_list = OL_TX_SEND(vdev, fwd_list);
+	if (!fwd_list)
+		return;
+
+	/*
+	 * The frames were not accepted by the tx.
+	 * We could store the frames and try again later,
+	 * but the simplest solution is to discard the frames.
+	 */
+	for (msdu = fwd_list; msdu; msdu = qdf_nbuf_next(msdu))
+		vdev->pdev->rx_fwd_stats.tx_rejects++;
+	qdf_nbuf_tx_free(fwd_list, QDF_NBUF_PKT_ERROR);
+}
+
+/**
+ * ol_rx_fwd_echo() - get the frame echoed back into the BSS
+ * @pdev: pdev handle
+ * @msdu: rx frame which is also delivered to the OS
+ *
+ * A clone shares the payload with the frame delivered to the OS. That is
+ * only safe when neither the tx preparation nor the rx delivery rewrite
+ * the frame in place, i.e. for LL with 802.3 frames; otherwise copy.
+ *
+ * Return: frame to forward or NULL on allocation failure
+ */
+static inline qdf_nbuf_t ol_rx_fwd_echo(struct ol_txrx_pdev_t *pdev,
+					qdf_nbuf_t msdu)
+{
+	if (!pdev->cfg.is_high_latency &&
+	    pdev->frame_format == wlan_frm_fmt_802_3) {
+		pdev->rx_fwd_stats.clones++;
+		return qdf_nbuf_clone(msdu);
 	}
+
+	pdev->rx_fwd_stats.copies++;
+	return qdf_nbuf_copy(msdu);
+}
+
+/**
+ * ol_rx_fwd_stats_update() - account a forwarded batch
+ * @pdev: pdev handle
+ * @fwd_cnt: frames forwarded in the batch
+ * @start_ts: log timestamp at the start of the batch
+ *
+ * Return: none
+ */
+static void ol_rx_fwd_stats_update(struct ol_txrx_pdev_t *pdev,
+				   uint32_t fwd_cnt, uint64_t start_ts)
+{
+	struct ol_rx_fwd_stats *stats = &pdev->rx_fwd_stats;
+	unsigned long now = qdf_system_ticks();
+	uint32_t elapsed_ms, msdus;
+
+	stats->batches++;
+	stats->msdus += fwd_cnt;
+	if (fwd_cnt > stats->max_batch)
+		stats->max_batch = fwd_cnt;
+	stats->cost_ts += qdf_get_log_timestamp() - start_ts;
+
+	elapsed_ms = qdf_system_ticks_to_msecs(now - stats->rate_ts);
+	if (elapsed_ms < OL_RX_FWD_RATE_WINDOW_MS)
+		return;
+
+	msdus = stats->msdus - stats->rate_msdus;
+	stats->pps = qdf_do_div((uint64_t)msdus * 1000, elapsed_ms);
+	if (msdus)
+		stats->cost_ns = qdf_do_div(qdf_log_timestamp_to_usecs(
+				stats->cost_ts - stats->rate_cost_ts) * 1000,
+				msdus);
+	stats->rate_msdus = stats->msdus;
+	stats->rate_cost_ts = stats->cost_ts;
+	stats->rate_ts = now;
 }
 
 void
@@ -143,11 +221,15 @@ ol_rx_fwd_check(struct ol_txrx_vdev_t *vdev,
 	struct ol_txrx_pdev_t *pdev = vdev->pdev;
 	qdf_nbuf_t deliver_list_head = NULL;
 	qdf_nbuf_t deliver_list_tail = NULL;
+	qdf_nbuf_t fwd_list_head = NULL;
+	qdf_nbuf_t fwd_list_tail = NULL;
 	qdf_nbuf_t msdu;
+	uint64_t start_ts = qdf_get_log_timestamp();
+	uint32_t fwd_cnt = 0;
+	int32_t fwd_budget = -1;
 
 	msdu = msdu_list;
 	while (msdu) {
-		struct ol_txrx_vdev_t *tx_vdev;
 		void *rx_desc;
 		uint16_t off = 0;
 		/*
@@ -176,8 +258,9 @@ ol_rx_fwd_check(struct ol_txrx_vdev_t *vdev,
 			 * within the given vdev, so we would want to get the DA
 			 * peer ID from the target, so we can locate
 			 * the tx vdev.
+			 * All frames of the batch are collected in one list
+			 * and handed to the tx path once.
 			 */
-			tx_vdev = vdev;
 			/*
 			 * Copying TID value of RX packet to forwarded
 			 * packet if the tid is other than non qos tid.
@@ -191,11 +274,16 @@ ol_rx_fwd_check(struct ol_txrx_vdev_t *vdev,
 						 QDF_NBUF_TX_EXT_TID_INVALID);
 			}
 
-			if (!ol_txrx_fwd_desc_thresh_check(vdev)) {
+			/* descriptor threshold is checked once per batch */
+			if (fwd_budget < 0)
+				fwd_budget = ol_txrx_fwd_desc_budget(vdev);
+
+			if (!fwd_budget) {
 				/* Drop the packet*/
 				htt_rx_msdu_desc_free(pdev->htt_pdev, msdu);
 				TXRX_STATS_MSDU_LIST_INCR(
 					pdev, tx.dropped.host_reject, msdu);
+				pdev->rx_fwd_stats.desc_drops++;
 				/* add NULL terminator */
 				qdf_nbuf_set_next(msdu, NULL);
 				qdf_nbuf_tx_free(msdu,
@@ -228,23 +316,30 @@ ol_rx_fwd_check(struct ol_txrx_vdev_t *vdev,
 			 * This MSDU needs to be forwarded to the tx path.
 			 * Check whether it also needs to be sent to the OS
 			 * shim, in which case we need to make a copy
-			 * (or clone?).
+			 * (or clone).
 			 */
 			if (htt_rx_msdu_discard(pdev->htt_pdev, rx_desc)) {
 				htt_rx_msdu_desc_free(pdev->htt_pdev, msdu);
-				ol_rx_fwd_to_tx(tx_vdev, msdu);
+				ol_rx_fwd_prep(vdev, msdu);
+				OL_TXRX_LIST_APPEND(fwd_list_head,
+						    fwd_list_tail, msdu);
+				fwd_budget--;
+				fwd_cnt++;
 				msdu = NULL;    /* already handled this MSDU */
-				tx_vdev->fwd_tx_packets++;
 				vdev->fwd_rx_packets++;
 				TXRX_STATS_ADD(pdev,
 					 pub.rx.intra_bss_fwd.packets_fwd, 1);
 			} else {
 				qdf_nbuf_t copy;
 
-				copy = qdf_nbuf_copy(msdu);
+				copy = ol_rx_fwd_echo(pdev, msdu);
 				if (copy) {
-					ol_rx_fwd_to_tx(tx_vdev, copy);
-					tx_vdev->fwd_tx_packets++;
+					ol_rx_fwd_prep(vdev, copy);
+					OL_TXRX_LIST_APPEND(fwd_list_head,
+							    fwd_list_tail,
+							    copy);
+					fwd_budget--;
+					fwd_cnt++;
 				}
 				TXRX_STATS_ADD(pdev,
 				   pub.rx.intra_bss_fwd.packets_stack_n_fwd, 1);
@@ -260,6 +355,13 @@ ol_rx_fwd_check(struct ol_txrx_vdev_t *vdev,
 		}
 		msdu = msdu_list;
 	}
+	if (fwd_list_head) {
+		/* add NULL terminator */
+		qdf_nbuf_set_next(fwd_list_tail, NULL);
+		vdev->fwd_tx_packets += fwd_cnt;
+		ol_rx_fwd_to_tx(vdev, fwd_list_head);
+		ol_rx_fwd_stats_update(pdev, fwd_cnt, start_ts);
+	}
 	if (deliver_list_head) {
 		/* add NULL terminator */
 		qdf_nbuf_set_next(deliver_list_tail, NULL);
@@ -272,6 +374,18 @@ ol_rx_fwd_check(struct ol_txrx_vdev_t *vdev,
 	}
 }
 
+void ol_rx_fwd_stats_display(struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_rx_fwd_stats *stats = &pdev->rx_fwd_stats;
+
+	txrx_nofl_info("intra-BSS fwd: batches %llu msdus %llu max batch %u clone %llu copy %llu",
+		       stats->batches, stats->msdus, stats->max_batch,
+		       stats->clones, stats->copies);
+	txrx_nofl_info("  drops: desc %llu tx %llu | %u pps, %u ns/msdu",
+		       stats->desc_drops, stats->tx_rejects, stats->pps,
+		       stats->cost_ns);
+}
+
 /*
  * ol_get_intra_bss_fwd_pkts_count() - to get the total tx and rx packets
  *   that has been forwarded from txrx layer without going to upper layers.
@@ -48,12 +48,22 @@
  * 3.  If the AP receives a multicast frame, it will retransmit the frame
  *     within the BSS, in addition to sending the frame to the OS.
  *
+ * The frames to forward are collected into one list, checked once against
+ * the tx descriptor threshold and handed to the tx path in a single call.
  */
 void
 ol_rx_fwd_check(struct ol_txrx_vdev_t *vdev,
 		struct ol_txrx_peer_t *peer,
 		unsigned int tid, qdf_nbuf_t msdu_list);
 
+/**
+ * ol_rx_fwd_stats_display() - show intra-BSS forwarding fast path stats
+ * @pdev: pdev handle
+ *
+ * Return: none
+ */
+void ol_rx_fwd_stats_display(struct ol_txrx_pdev_t *pdev);
+
 /**
  * ol_get_intra_bss_fwd_pkts_count() - to get the total tx and rx packets
  *   that has been forwarded from txrx layer without going to upper layers.
@@ -36,9 +36,17 @@
 		tail = mpdu_tail;					\
 	} while (0)
 
-int ol_rx_pn_cmp24(union htt_rx_pn_t *new_pn,
-		   union htt_rx_pn_t *old_pn, int is_unicast, int opmode,
-		   bool strict_chk)
+/**
+ * ol_rx_pn_replay24() - check a 24-bit PN for replay
+ * @new_pn: PN of the received MPDU
+ * @old_pn: last PN accepted on the TID
+ * @strict_chk: require consecutive PNs
+ *
+ * Return: true if the MPDU is a replay
+ */
+static inline bool ol_rx_pn_replay24(const union htt_rx_pn_t *new_pn,
+				     const union htt_rx_pn_t *old_pn,
+				     bool strict_chk)
 {
 	if (strict_chk)
 		return ((new_pn->pn24 & 0xffffff) - (old_pn->pn24 & 0xffffff)
@@ -47,9 +55,17 @@ int ol_rx_pn_cmp24(union htt_rx_pn_t *new_pn,
 		return ((new_pn->pn24 & 0xffffff) <= (old_pn->pn24 & 0xffffff));
 }
 
-int ol_rx_pn_cmp48(union htt_rx_pn_t *new_pn,
-		   union htt_rx_pn_t *old_pn, int is_unicast, int opmode,
-		   bool strict_chk)
+/**
+ * ol_rx_pn_replay48() - check a 48-bit PN for replay
+ * @new_pn: PN of the received MPDU
+ * @old_pn: last PN accepted on the TID
+ * @strict_chk: require consecutive PNs
+ *
+ * Return: true if the MPDU is a replay
+ */
+static inline bool ol_rx_pn_replay48(const union htt_rx_pn_t *new_pn,
+				     const union htt_rx_pn_t *old_pn,
+				     bool strict_chk)
 {
 	if (strict_chk)
 		return ((new_pn->pn48 & 0xffffffffffffULL) -
@@ -59,9 +75,18 @@ int ol_rx_pn_cmp48(union htt_rx_pn_t *new_pn,
 			(old_pn->pn48 & 0xffffffffffffULL));
 }
 
-int ol_rx_pn_wapi_cmp(union htt_rx_pn_t *new_pn,
-		      union htt_rx_pn_t *old_pn, int is_unicast, int opmode,
-		      bool strict_chk)
+/**
+ * ol_rx_pn_replay_wapi() - check a 128-bit WAPI PN for replay
+ * @new_pn: PN of the received MPDU
+ * @old_pn: last PN accepted on the TID
+ * @is_unicast: unicast MPDU
+ * @opmode: vdev operating mode
+ *
+ * Return: true if the MPDU is a replay
+ */
+static inline bool ol_rx_pn_replay_wapi(const union htt_rx_pn_t *new_pn,
+					const union htt_rx_pn_t *old_pn,
+					int is_unicast, int opmode)
 {
 	int pn_is_replay = 0;
 
@@ -81,20 +106,230 @@ int ol_rx_pn_wapi_cmp(union htt_rx_pn_t *new_pn,
 	return pn_is_replay;
 }
 
+int ol_rx_pn_cmp24(union htt_rx_pn_t *new_pn,
+		   union htt_rx_pn_t *old_pn, int is_unicast, int opmode,
+		   bool strict_chk)
+{
+	return ol_rx_pn_replay24(new_pn, old_pn, strict_chk);
+}
+
+int ol_rx_pn_cmp48(union htt_rx_pn_t *new_pn,
+		   union htt_rx_pn_t *old_pn, int is_unicast, int opmode,
+		   bool strict_chk)
+{
+	return ol_rx_pn_replay48(new_pn, old_pn, strict_chk);
+}
+
+int ol_rx_pn_wapi_cmp(union htt_rx_pn_t *new_pn,
+		      union htt_rx_pn_t *old_pn, int is_unicast, int opmode,
+		      bool strict_chk)
+{
+	return ol_rx_pn_replay_wapi(new_pn, old_pn, is_unicast, opmode);
+}
+
+void ol_rx_pn_state_init(struct ol_rx_pn_state *st, ol_rx_pn_cmp_fp cmp,
+			 union htt_rx_pn_t *last_pn, int last_pn_valid,
+			 uint8_t *rekey_flag, int is_unicast, int opmode,
+			 bool strict_chk)
+{
+	st->cmp = cmp;
+	if (cmp == ol_rx_pn_cmp48)
+		st->cipher = OL_RX_PN_CIPHER_48;
+	else if (cmp == ol_rx_pn_wapi_cmp)
+		st->cipher = OL_RX_PN_CIPHER_WAPI;
+	else if (cmp == ol_rx_pn_cmp24)
+		st->cipher = OL_RX_PN_CIPHER_24;
+	else
+		st->cipher = OL_RX_PN_CIPHER_OTHER;
+	st->last_pn = last_pn;
+	st->last_pn_valid = last_pn_valid;
+	st->rekey_flag = rekey_flag;
+	st->is_unicast = is_unicast;
+	st->opmode = opmode;
+	st->strict_chk = strict_chk;
+	st->updated = 0;
+}
+
+/**
+ * ol_rx_pn_is_replay() - cipher specialized PN replay check
+ * @st: PN check state
+ * @new_pn: PN of the received MPDU
+ *
+ * Return: true if the MPDU is a replay
+ */
+static inline bool ol_rx_pn_is_replay(struct ol_rx_pn_state *st,
+				      union htt_rx_pn_t *new_pn)
+{
+	switch (st->cipher) {
+	case OL_RX_PN_CIPHER_48:
+		return ol_rx_pn_replay48(new_pn, st->last_pn, st->strict_chk);
+	case OL_RX_PN_CIPHER_WAPI:
+		return ol_rx_pn_replay_wapi(new_pn, st->last_pn,
+					    st->is_unicast, st->opmode);
+	case OL_RX_PN_CIPHER_24:
+		return ol_rx_pn_replay24(new_pn, st->last_pn, st->strict_chk);
+	default:
+		return st->cmp(new_pn, st->last_pn, st->is_unicast,
+			       st->opmode, st->strict_chk);
+	}
+}
+
+int ol_rx_pn_scan(struct ol_rx_pn_state *st, union htt_rx_pn_t *pn,
+		  const uint8_t *encrypted, int start, int num)
+{
+	int i;
+
+	for (i = start; i < num; i++) {
+		/* Don't check the PN replay for non-encrypted frames */
+		if (!encrypted[i])
+			continue;
+
+		/* if there was no prior PN, there's nothing to check */
+		if (st->last_pn_valid) {
+			if (ol_rx_pn_is_replay(st, &pn[i]))
+				return i;
+		} else {
+			st->last_pn_valid = 1;
+		}
+
+		/*
+		 * Remember the new PN.
+		 * For simplicity, just do 2 64-bit word copies to
+		 * cover the worst case (WAPI), regardless of the length
+		 * of the PN.
+		 * This is more efficient than doing a conditional
+		 * branch to copy only the relevant portion.
+
+		 * IWNCOM AP will send 1 packet with old PN after USK
+		 * rekey, don't update last_pn when recv the packet, or
+		 * PN check failed for later packets
+		 */
+		if (st->rekey_flag && *st->rekey_flag == 1) {
+			*st->rekey_flag = 0;
+		} else {
+			st->last_pn->pn128[0] = pn[i].pn128[0];
+			st->last_pn->pn128[1] = pn[i].pn128[1];
+			st->updated |= 1 << i;
+		}
+	}
+
+	return num;
+}
+
+/**
+ * ol_rx_pn_replay_drop() - report and drop a MPDU that failed the PN check
+ * @vdev: vdev the MPDU was received on
+ * @peer: peer the MPDU was received from
+ * @tid: TID of the MPDU
+ * @index: unicast vs. multicast
+ * @last_pn: last PN accepted on the TID
+ * @new_pn: PN of the MPDU
+ * @rx_desc: rx descriptor of the MPDU
+ * @mpdu: first MSDU of the MPDU
+ * @mpdu_tail: last MSDU of the MPDU
+ *
+ * Return: none
+ */
+static void ol_rx_pn_replay_drop(struct ol_txrx_vdev_t *vdev,
+				 struct ol_txrx_peer_t *peer,
+				 unsigned int tid, int index,
+				 union htt_rx_pn_t *last_pn,
+				 union htt_rx_pn_t *new_pn, void *rx_desc,
+				 qdf_nbuf_t mpdu, qdf_nbuf_t mpdu_tail)
+{
+	struct ol_txrx_pdev_t *pdev = vdev->pdev;
+	qdf_nbuf_t msdu;
+	static uint32_t last_pncheck_print_time /* = 0 */;
+	uint32_t current_time_ms;
+
+	/*
+	 * This MPDU failed the PN check:
+	 * 1.  notify the control SW of the PN failure
+	 *     (so countermeasures can be taken, if necessary)
+	 * 2.  Discard all the MSDUs from this MPDU.
+	 */
+	msdu = mpdu;
+	current_time_ms =
+		qdf_system_ticks_to_msecs(qdf_system_ticks());
+	if (TXRX_PN_CHECK_FAILURE_PRINT_PERIOD_MS <
+	    (current_time_ms - last_pncheck_print_time)) {
+		last_pncheck_print_time = current_time_ms;
+		ol_txrx_warn(
+		   "PN check failed - TID %d, peer %pK "
+		   "("QDF_MAC_ADDR_FMT") %s\n"
+		   "    old PN (u64 x2)= 0x%08llx %08llx (LSBs = %lld)\n"
+		   "    new PN (u64 x2)= 0x%08llx %08llx (LSBs = %lld)\n"
+		   "    new seq num = %d\n",
+		   tid, peer,
+		   QDF_MAC_ADDR_REF(peer->mac_addr.raw),
+		   (index ==
+		    txrx_sec_ucast) ? "ucast" : "mcast",
+		   last_pn->pn128[1], last_pn->pn128[0],
+		   last_pn->pn128[0] & 0xffffffffffffULL,
+		   new_pn->pn128[1], new_pn->pn128[0],
+		   new_pn->pn128[0] & 0xffffffffffffULL,
+		   htt_rx_mpdu_desc_seq_num(pdev->htt_pdev,
+					    rx_desc, false));
+	} else {
+		ol_txrx_dbg(
+		   "PN check failed - TID %d, peer %pK "
+		   "("QDF_MAC_ADDR_FMT") %s\n"
+		   "    old PN (u64 x2)= 0x%08llx %08llx (LSBs = %lld)\n"
+		   "    new PN (u64 x2)= 0x%08llx %08llx (LSBs = %lld)\n"
+		   "    new seq num = %d\n",
+		   tid, peer,
+		   QDF_MAC_ADDR_REF(peer->mac_addr.raw),
+		   (index ==
+		    txrx_sec_ucast) ? "ucast" : "mcast",
+		   last_pn->pn128[1], last_pn->pn128[0],
+		   last_pn->pn128[0] & 0xffffffffffffULL,
+		   new_pn->pn128[1], new_pn->pn128[0],
+		   new_pn->pn128[0] & 0xffffffffffffULL,
+		   htt_rx_mpdu_desc_seq_num(pdev->htt_pdev,
+					    rx_desc, false));
+	}
+#if defined(ENABLE_RX_PN_TRACE)
+	ol_rx_pn_trace_display(pdev, 1);
+#endif /* ENABLE_RX_PN_TRACE */
+	ol_rx_err(pdev->ctrl_pdev,
+		  vdev->vdev_id, peer->mac_addr.raw, tid,
+		  htt_rx_mpdu_desc_tsf32(pdev->htt_pdev,
+					 rx_desc), OL_RX_ERR_PN,
+		  mpdu, NULL, 0);
+	/* free all MSDUs within this MPDU */
+	do {
+		qdf_nbuf_t next_msdu;
+
+		OL_RX_ERR_STATISTICS_1(pdev, vdev, peer,
+				       rx_desc, OL_RX_ERR_PN);
+		next_msdu = qdf_nbuf_next(msdu);
+		htt_rx_desc_frame_free(pdev->htt_pdev, msdu);
+		if (msdu == mpdu_tail)
+			break;
+		msdu = next_msdu;
+	} while (1);
+}
+
 qdf_nbuf_t
 ol_rx_pn_check_base(struct ol_txrx_vdev_t *vdev,
 		    struct ol_txrx_peer_t *peer,
 		    unsigned int tid, qdf_nbuf_t msdu_list, bool strict_chk)
 {
 	struct ol_txrx_pdev_t *pdev = vdev->pdev;
-	union htt_rx_pn_t *last_pn;
+	struct ol_rx_pn_state st;
 	qdf_nbuf_t out_list_head = NULL;
 	qdf_nbuf_t out_list_tail = NULL;
 	qdf_nbuf_t mpdu;
+	qdf_nbuf_t mpdus[OL_RX_PN_BATCH_SIZE];
+	qdf_nbuf_t mpdu_tails[OL_RX_PN_BATCH_SIZE];
+	void *rx_descs[OL_RX_PN_BATCH_SIZE];
+	union htt_rx_pn_t pns[OL_RX_PN_BATCH_SIZE];
+	uint8_t encrypted[OL_RX_PN_BATCH_SIZE];
 	int index;              /* unicast vs. multicast */
 	int pn_len;
 	void *rx_desc;
-	int last_pn_valid;
+	int sec_type;
+	int num, i, replay;
 
 	/* Make sure host pn check is not redundant */
 	if ((qdf_atomic_read(&peer->fw_pn_check)) ||
@@ -107,147 +342,60 @@ ol_rx_pn_check_base(struct ol_txrx_vdev_t *vdev,
 	qdf_assert(htt_rx_msdu_has_wlan_mcast_flag(pdev->htt_pdev, rx_desc));
 	index = htt_rx_msdu_is_wlan_mcast(pdev->htt_pdev, rx_desc) ?
 		txrx_sec_mcast : txrx_sec_ucast;
-	pn_len = pdev->rx_pn[peer->security[index].sec_type].len;
+	sec_type = peer->security[index].sec_type;
+	pn_len = pdev->rx_pn[sec_type].len;
 	if (pn_len == 0)
 		return msdu_list;
 
-	last_pn_valid = peer->tids_last_pn_valid[tid];
-	last_pn = &peer->tids_last_pn[tid];
+	/* the IWNCOM rekey workaround only applies to unicast WAPI */
+	ol_rx_pn_state_init(&st, pdev->rx_pn[sec_type].cmp,
+			    &peer->tids_last_pn[tid],
+			    peer->tids_last_pn_valid[tid],
+			    (sec_type == htt_sec_type_wapi &&
+			     index == txrx_sec_ucast) ?
+			    &peer->tids_rekey_flag[tid] : NULL,
+			    index == txrx_sec_ucast, vdev->opmode, strict_chk);
+
 	mpdu = msdu_list;
 	while (mpdu) {
-		qdf_nbuf_t mpdu_tail, next_mpdu;
-		union htt_rx_pn_t new_pn;
-		int pn_is_replay = 0;
-
-		rx_desc = htt_rx_msdu_desc_retrieve(pdev->htt_pdev, mpdu);
-
 		/*
-		 * Find the last MSDU within this MPDU, and
-		 * the find the first MSDU within the next MPDU.
+		 * Split off the next batch of MPDUs, finding the last MSDU
+		 * within each MPDU, and fetch their PNs in one go.
 		 */
-		ol_rx_mpdu_list_next(pdev, mpdu, &mpdu_tail, &next_mpdu);
-
-		/* Don't check the PN replay for non-encrypted frames */
-		if (!htt_rx_mpdu_is_encrypted(pdev->htt_pdev, rx_desc)) {
-			ADD_MPDU_TO_LIST(out_list_head, out_list_tail,
-					       mpdu, mpdu_tail);
-			mpdu = next_mpdu;
-			continue;
+		for (num = 0; mpdu && num < OL_RX_PN_BATCH_SIZE; num++) {
+			rx_descs[num] = htt_rx_msdu_desc_retrieve(
+							pdev->htt_pdev, mpdu);
+			mpdus[num] = mpdu;
+			ol_rx_mpdu_list_next(pdev, mpdu, &mpdu_tails[num],
+					     &mpdu);
 		}
-
-		/* retrieve PN from rx descriptor */
-		htt_rx_mpdu_desc_pn(pdev->htt_pdev, rx_desc, &new_pn, pn_len);
-
-		/* if there was no prior PN, there's nothing to check */
-		if (last_pn_valid) {
-			pn_is_replay =
-				pdev->rx_pn[peer->security[index].sec_type].
-				cmp(&new_pn, last_pn, index == txrx_sec_ucast,
-				    vdev->opmode, strict_chk);
-		} else {
-			last_pn_valid = peer->tids_last_pn_valid[tid] = 1;
+		htt_rx_mpdu_desc_pn_batch(pdev->htt_pdev, rx_descs, pns,
+					  encrypted, num, pn_len);
+
+		st.updated = 0;
+		for (i = 0; i < num; i = replay + 1) {
+			replay = ol_rx_pn_scan(&st, pns, encrypted, i, num);
+			for (; i < replay; i++)
+				ADD_MPDU_TO_LIST(out_list_head, out_list_tail,
+						 mpdus[i], mpdu_tails[i]);
+			if (replay < num)
+				ol_rx_pn_replay_drop(vdev, peer, tid, index,
+						     st.last_pn, &pns[replay],
+						     rx_descs[replay],
+						     mpdus[replay],
+						     mpdu_tails[replay]);
 		}
 
-		if (pn_is_replay) {
-			qdf_nbuf_t msdu;
-			static uint32_t last_pncheck_print_time /* = 0 */;
-			uint32_t current_time_ms;
-
-			/*
-			 * This MPDU failed the PN check:
-			 * 1.  notify the control SW of the PN failure
-			 *     (so countermeasures can be taken, if necessary)
-			 * 2.  Discard all the MSDUs from this MPDU.
-			 */
-			msdu = mpdu;
-			current_time_ms =
-				qdf_system_ticks_to_msecs(qdf_system_ticks());
-			if (TXRX_PN_CHECK_FAILURE_PRINT_PERIOD_MS <
-			    (current_time_ms - last_pncheck_print_time)) {
-				last_pncheck_print_time = current_time_ms;
-				ol_txrx_warn(
-				   "PN check failed - TID %d, peer %pK "
-				   "("QDF_MAC_ADDR_FMT") %s\n"
-				   "    old PN (u64 x2)= 0x%08llx %08llx (LSBs = %lld)\n"
-				   "    new PN (u64 x2)= 0x%08llx %08llx (LSBs = %lld)\n"
-				   "    new seq num = %d\n",
-				   tid, peer,
-				   QDF_MAC_ADDR_REF(peer->mac_addr.raw),
-				   (index ==
-				    txrx_sec_ucast) ? "ucast" : "mcast",
-				   last_pn->pn128[1], last_pn->pn128[0],
-				   last_pn->pn128[0] & 0xffffffffffffULL,
-				   new_pn.pn128[1], new_pn.pn128[0],
-				   new_pn.pn128[0] & 0xffffffffffffULL,
-				   htt_rx_mpdu_desc_seq_num(pdev->htt_pdev,
-							    rx_desc, false));
-			} else {
-				ol_txrx_dbg(
-				   "PN check failed - TID %d, peer %pK "
-				   "("QDF_MAC_ADDR_FMT") %s\n"
-				   "    old PN (u64 x2)= 0x%08llx %08llx (LSBs = %lld)\n"
-				   "    new PN (u64 x2)= 0x%08llx %08llx (LSBs = %lld)\n"
-				   "    new seq num = %d\n",
-				   tid, peer,
-				   QDF_MAC_ADDR_REF(peer->mac_addr.raw),
-				   (index ==
-				    txrx_sec_ucast) ? "ucast" : "mcast",
-				   last_pn->pn128[1], last_pn->pn128[0],
-				   last_pn->pn128[0] & 0xffffffffffffULL,
-				   new_pn.pn128[1], new_pn.pn128[0],
-				   new_pn.pn128[0] & 0xffffffffffffULL,
-				   htt_rx_mpdu_desc_seq_num(pdev->htt_pdev,
-							    rx_desc, false));
-			}
 #if defined(ENABLE_RX_PN_TRACE)
-			ol_rx_pn_trace_display(pdev, 1);
+		for (i = 0; i < num; i++)
+			if (st.updated & (1 << i))
+				OL_RX_PN_TRACE_ADD(pdev, peer, tid,
+						   rx_descs[i]);
 #endif /* ENABLE_RX_PN_TRACE */
-			ol_rx_err(pdev->ctrl_pdev,
-				  vdev->vdev_id, peer->mac_addr.raw, tid,
-				  htt_rx_mpdu_desc_tsf32(pdev->htt_pdev,
-							 rx_desc), OL_RX_ERR_PN,
-				  mpdu, NULL, 0);
-			/* free all MSDUs within this MPDU */
-			do {
-				qdf_nbuf_t next_msdu;
-
-				OL_RX_ERR_STATISTICS_1(pdev, vdev, peer,
-						       rx_desc, OL_RX_ERR_PN);
-				next_msdu = qdf_nbuf_next(msdu);
-				htt_rx_desc_frame_free(pdev->htt_pdev, msdu);
-				if (msdu == mpdu_tail)
-					break;
-				msdu = next_msdu;
-			} while (1);
-		} else {
-			ADD_MPDU_TO_LIST(out_list_head, out_list_tail,
-					       mpdu, mpdu_tail);
-			/*
-			 * Remember the new PN.
-			 * For simplicity, just do 2 64-bit word copies to
-			 * cover the worst case (WAPI), regardless of the length
-			 * of the PN.
-			 * This is more efficient than doing a conditional
-			 * branch to copy only the relevant portion.
-
-			 * IWNCOM AP will send 1 packet with old PN after USK
-			 * rekey, don't update last_pn when recv the packet, or
-			 * PN check failed for later packets
-			 */
-			if ((peer->security[index].sec_type
-				== htt_sec_type_wapi) &&
-			    (peer->tids_rekey_flag[tid] == 1) &&
-			    (index == txrx_sec_ucast)) {
-				peer->tids_rekey_flag[tid] = 0;
-			} else {
-				last_pn->pn128[0] = new_pn.pn128[0];
-				last_pn->pn128[1] = new_pn.pn128[1];
-				OL_RX_PN_TRACE_ADD(pdev, peer, tid, rx_desc);
-			}
-		}
-
-		mpdu = next_mpdu;
 	}
+	if (st.last_pn_valid)
+		peer->tids_last_pn_valid[tid] = 1;
+
 	/* make sure the list is null-terminated */
 	if (out_list_tail)
 		qdf_nbuf_set_next(out_list_tail, NULL);
@@ -23,6 +23,83 @@
 
 #include <ol_txrx_api.h>        /* ol_txrx_peer_t, etc. */
 
+/* Number of MPDUs whose PNs are fetched and checked together */
+#define OL_RX_PN_BATCH_SIZE 8
+
+typedef int (*ol_rx_pn_cmp_fp)(union htt_rx_pn_t *new_pn,
+			       union htt_rx_pn_t *old_pn, int is_unicast,
+			       int opmode, bool strict_chk);
+
+/**
+ * enum ol_rx_pn_cipher - PN comparison specializations
+ * @OL_RX_PN_CIPHER_24: 24-bit PN, ol_rx_pn_cmp24()
+ * @OL_RX_PN_CIPHER_48: 48-bit PN, ol_rx_pn_cmp48()
+ * @OL_RX_PN_CIPHER_WAPI: 128-bit WAPI PN, ol_rx_pn_wapi_cmp()
+ * @OL_RX_PN_CIPHER_OTHER: any other comparison, called indirectly
+ */
+enum ol_rx_pn_cipher {
+	OL_RX_PN_CIPHER_24,
+	OL_RX_PN_CIPHER_48,
+	OL_RX_PN_CIPHER_WAPI,
+	OL_RX_PN_CIPHER_OTHER,
+};
+
+/**
+ * struct ol_rx_pn_state - PN replay state of a peer TID during a check
+ * @cmp: registered comparison for the security type
+ * @cipher: inlined specialization of @cmp
+ * @last_pn: last PN accepted on the TID
+ * @last_pn_valid: @last_pn holds a PN
+ * @rekey_flag: WAPI USK rekey flag of the TID, NULL if not applicable
+ * @is_unicast: unicast frames
+ * @opmode: vdev operating mode
+ * @strict_chk: require consecutive PNs
+ * @updated: bitmap of the batch entries which advanced @last_pn
+ */
+struct ol_rx_pn_state {
+	ol_rx_pn_cmp_fp cmp;
+	enum ol_rx_pn_cipher cipher;
+	union htt_rx_pn_t *last_pn;
+	int last_pn_valid;
+	uint8_t *rekey_flag;
+	int is_unicast;
+	int opmode;
+	bool strict_chk;
+	uint32_t updated;
+};
+
+/**
+ * ol_rx_pn_state_init() - set up the PN replay state for a check
+ * @st: state to initialize
+ * @cmp: registered comparison for the security type
+ * @last_pn: last PN accepted on the TID
+ * @last_pn_valid: @last_pn holds a PN
+ * @rekey_flag: WAPI USK rekey flag of the TID, NULL if not applicable
+ * @is_unicast: unicast frames
+ * @opmode: vdev operating mode
+ * @strict_chk: require consecutive PNs
+ *
+ * Return: none
+ */
+void ol_rx_pn_state_init(struct ol_rx_pn_state *st, ol_rx_pn_cmp_fp cmp,
+			 union htt_rx_pn_t *last_pn, int last_pn_valid,
+			 uint8_t *rekey_flag, int is_unicast, int opmode,
+			 bool strict_chk);
+
+/**
+ * ol_rx_pn_scan() - check a batch of PNs in order against the last PN
+ * @st: PN replay state, advanced for every accepted PN
+ * @pn: PNs of the batch
+ * @encrypted: encryption flags of the batch, unencrypted entries pass
+ * @start: first entry to check
+ * @num: number of entries in the batch, at most OL_RX_PN_BATCH_SIZE
+ *
+ * Return: index of the first replayed entry at or after @start, or @num
+ *	   if none of the remaining entries is a replay
+ */
+int ol_rx_pn_scan(struct ol_rx_pn_state *st, union htt_rx_pn_t *pn,
+		  const uint8_t *encrypted, int start, int num);
+
 int ol_rx_pn_cmp24(union htt_rx_pn_t *new_pn,
 		   union htt_rx_pn_t *old_pn, int is_unicast, int opmode,
 		   bool strict_chk);
@@ -84,6 +161,7 @@ ol_rx_pn_check_only(struct ol_txrx_vdev_t *vdev,
  * @details
  *  Same as ol_rx_pn_check but return valid rx netbufs
  *  rather than invoking the rx --> tx forwarding check.
+ *  The PNs are fetched and checked OL_RX_PN_BATCH_SIZE MPDUs at a time.
  *
  * @param vdev - which virtual device the frames were addressed to
  * @param peer - which peer the rx frames belong to
@@ -90,6 +90,8 @@ void ol_rx_reorder_init(struct ol_rx_reorder_t *rx_reorder, uint8_t tid)
 	rx_reorder->base.head = rx_reorder->base.tail = NULL;
 	rx_reorder->tid = tid;
 	rx_reorder->defrag_timeout_ms = 0;
+	rx_reorder->frag_bitmap = 0;
+	rx_reorder->frag_last = -1;
 
 	rx_reorder->defrag_waitlist_elem.tqe_next = NULL;
 	rx_reorder->defrag_waitlist_elem.tqe_prev = NULL;
@@ -29,6 +29,39 @@
 
 #ifdef QCA_SUPPORT_OL_RX_REORDER_TIMEOUT
 
+/**
+ * ol_rx_reorder_timeout_link() - arm a timeout in the timing wheel
+ * @rx_reorder_timeout_ac: AC timeouts
+ * @list_elem: timeout, with the expiration timestamp set
+ *
+ * Timeouts beyond the wheel go to its last slot and are moved again when
+ * that slot comes due.
+ *
+ * Return: none
+ */
+static void
+ol_rx_reorder_timeout_link(struct ol_tx_reorder_cat_timeout_t
+			   *rx_reorder_timeout_ac,
+			   struct ol_rx_reorder_timeout_list_elem_t *list_elem)
+{
+	int32_t delta_ms;
+	uint32_t ahead;
+
+	delta_ms = list_elem->timestamp_ms - rx_reorder_timeout_ac->cursor_ms;
+	ahead = delta_ms <= 0 ? 0 :
+		(delta_ms + OL_RX_REORDER_TIMEOUT_TICK_MS - 1) /
+		OL_RX_REORDER_TIMEOUT_TICK_MS;
+	if (ahead > OL_RX_REORDER_TIMEOUT_WHEEL_MASK)
+		ahead = OL_RX_REORDER_TIMEOUT_WHEEL_MASK;
+
+	list_elem->slot = (rx_reorder_timeout_ac->cursor_slot + ahead) &
+			  OL_RX_REORDER_TIMEOUT_WHEEL_MASK;
+	list_elem->active = 1;
+	TAILQ_INSERT_TAIL(&rx_reorder_timeout_ac->wheel[list_elem->slot],
+			  list_elem, reorder_timeout_list_elem);
+	rx_reorder_timeout_ac->num_armed++;
+}
+
 void ol_rx_reorder_timeout_remove(struct ol_txrx_peer_t *peer, unsigned int tid)
 {
 	struct ol_txrx_pdev_t *pdev;
@@ -40,26 +73,44 @@ void ol_rx_reorder_timeout_remove(struct ol_txrx_peer_t *peer, unsigned int tid)
 	ac = TXRX_TID_TO_WMM_AC(tid);
 	rx_reorder_timeout_ac = &pdev->rx.reorder_timeout.access_cats[ac];
 	list_elem = &peer->tids_rx_reorder[tid].timeout;
-	if (!list_elem->active) {
-		/* this element has already been removed */
-		return;
+	if (list_elem->active) {
+		list_elem->active = 0;
+		TAILQ_REMOVE(&rx_reorder_timeout_ac->wheel[list_elem->slot],
+			     list_elem, reorder_timeout_list_elem);
+		rx_reorder_timeout_ac->num_armed--;
+	} else if (list_elem->expired) {
+		list_elem->expired = 0;
+		TAILQ_REMOVE(&rx_reorder_timeout_ac->expired_list, list_elem,
+			     reorder_timeout_list_elem);
 	}
-	list_elem->active = 0;
-	TAILQ_REMOVE(&rx_reorder_timeout_ac->virtual_timer_list, list_elem,
-		     reorder_timeout_list_elem);
+	/* else this element has already been removed */
 }
 
+/**
+ * ol_rx_reorder_timeout_start() - start the timer for the first due tick
+ * @rx_reorder_timeout_ac: AC timeouts, with at least one armed
+ * @time_now_ms: current time
+ *
+ * Return: none
+ */
 static void
 ol_rx_reorder_timeout_start(struct ol_tx_reorder_cat_timeout_t
 			    *rx_reorder_timeout_ac, uint32_t time_now_ms)
 {
-	uint32_t duration_ms;
-	struct ol_rx_reorder_timeout_list_elem_t *list_elem;
-
-	list_elem = TAILQ_FIRST(&rx_reorder_timeout_ac->virtual_timer_list);
+	int32_t duration_ms;
+	uint32_t ahead, slot;
+
+	for (ahead = 0; ahead < OL_RX_REORDER_TIMEOUT_WHEEL_MASK; ahead++) {
+		slot = (rx_reorder_timeout_ac->cursor_slot + ahead) &
+		       OL_RX_REORDER_TIMEOUT_WHEEL_MASK;
+		if (!TAILQ_EMPTY(&rx_reorder_timeout_ac->wheel[slot]))
+			break;
+	}
 
-	duration_ms = list_elem->timestamp_ms - time_now_ms;
-	qdf_timer_start(&rx_reorder_timeout_ac->timer, duration_ms);
+	duration_ms = rx_reorder_timeout_ac->cursor_ms +
+		      ahead * OL_RX_REORDER_TIMEOUT_TICK_MS - time_now_ms;
+	qdf_timer_start(&rx_reorder_timeout_ac->timer,
+			duration_ms > 0 ? duration_ms : 0);
 }
 
 static inline void
@@ -77,7 +128,6 @@ ol_rx_reorder_timeout_add(struct ol_txrx_peer_t *peer, uint8_t tid)
 	rx_reorder_timeout_ac = &pdev->rx.reorder_timeout.access_cats[ac];
 	list_elem = &peer->tids_rx_reorder[tid].timeout;
 
-	list_elem->active = 1;
 	list_elem->peer = peer;
 	list_elem->tid = tid;
 
@@ -86,10 +136,12 @@ ol_rx_reorder_timeout_add(struct ol_txrx_peer_t *peer, uint8_t tid)
 	list_elem->timestamp_ms =
 		time_now_ms + rx_reorder_timeout_ac->duration_ms;
 
-	/* add to the queue */
-	start = TAILQ_EMPTY(&rx_reorder_timeout_ac->virtual_timer_list);
-	TAILQ_INSERT_TAIL(&rx_reorder_timeout_ac->virtual_timer_list,
-			  list_elem, reorder_timeout_list_elem);
+	/* an idle wheel restarts from the current time */
+	start = !rx_reorder_timeout_ac->num_armed;
+	if (start)
+		rx_reorder_timeout_ac->cursor_ms = time_now_ms;
+
+	ol_rx_reorder_timeout_link(rx_reorder_timeout_ac, list_elem);
 	if (start)
 		ol_rx_reorder_timeout_start(rx_reorder_timeout_ac, time_now_ms);
 }
@@ -108,19 +160,85 @@ void ol_rx_reorder_timeout_update(struct ol_txrx_peer_t *peer, uint8_t tid)
 
 	/*
 	 * If the virtual timer for this peer-TID is already running,
-	 * then leave it.
+	 * or it has expired and is about to be flushed, then leave it.
 	 */
-	if (peer->tids_rx_reorder[tid].timeout.active)
+	if (peer->tids_rx_reorder[tid].timeout.active ||
+	    peer->tids_rx_reorder[tid].timeout.expired)
 		return;
 
 	ol_rx_reorder_timeout_add(peer, tid);
 }
 
+/**
+ * ol_rx_reorder_timeout_advance() - move the due timeouts to the expired list
+ * @rx_reorder_timeout_ac: AC timeouts
+ * @time_now_ms: current time
+ *
+ * Must be called with the rx mutex held.
+ *
+ * Return: number of timeouts that expired
+ */
+static uint32_t
+ol_rx_reorder_timeout_advance(struct ol_tx_reorder_cat_timeout_t
+			      *rx_reorder_timeout_ac, uint32_t time_now_ms)
+{
+	struct ol_rx_reorder_timeout_list_t rearm;
+	struct ol_rx_reorder_timeout_list_t *slot;
+	struct ol_rx_reorder_timeout_list_elem_t *list_elem;
+	uint32_t num_expired = 0;
+	uint32_t ticks;
+
+	TAILQ_INIT(&rearm);
+	for (ticks = 0; ticks < OL_RX_REORDER_TIMEOUT_WHEEL_SLOTS &&
+	     (int32_t)(time_now_ms - rx_reorder_timeout_ac->cursor_ms) >= 0;
+	     ticks++) {
+		slot = &rx_reorder_timeout_ac->wheel[
+				rx_reorder_timeout_ac->cursor_slot];
+		while ((list_elem = TAILQ_FIRST(slot))) {
+			TAILQ_REMOVE(slot, list_elem,
+				     reorder_timeout_list_elem);
+			list_elem->active = 0;
+			rx_reorder_timeout_ac->num_armed--;
+
+			if ((int32_t)(list_elem->timestamp_ms -
+				      time_now_ms) > 0) {
+				/* beyond the wheel when it was armed */
+				TAILQ_INSERT_TAIL(&rearm, list_elem,
+						  reorder_timeout_list_elem);
+				continue;
+			}
+
+			list_elem->expired = 1;
+			TAILQ_INSERT_TAIL(&rx_reorder_timeout_ac->expired_list,
+					  list_elem, reorder_timeout_list_elem);
+			num_expired++;
+		}
+		rx_reorder_timeout_ac->cursor_slot =
+			(rx_reorder_timeout_ac->cursor_slot + 1) &
+			OL_RX_REORDER_TIMEOUT_WHEEL_MASK;
+		rx_reorder_timeout_ac->cursor_ms +=
+			OL_RX_REORDER_TIMEOUT_TICK_MS;
+	}
+
+	/* the timer ran later than a whole turn of the wheel */
+	if ((int32_t)(time_now_ms - rx_reorder_timeout_ac->cursor_ms) >= 0)
+		rx_reorder_timeout_ac->cursor_ms =
+			time_now_ms + OL_RX_REORDER_TIMEOUT_TICK_MS;
+
+	while ((list_elem = TAILQ_FIRST(&rearm))) {
+		TAILQ_REMOVE(&rearm, list_elem, reorder_timeout_list_elem);
+		ol_rx_reorder_timeout_link(rx_reorder_timeout_ac, list_elem);
+	}
+
+	return num_expired;
+}
+
 static void ol_rx_reorder_timeout(void *arg)
 {
 	struct ol_txrx_pdev_t *pdev;
-	struct ol_rx_reorder_timeout_list_elem_t *list_elem, *tmp;
+	struct ol_rx_reorder_timeout_list_elem_t *list_elem;
 	uint32_t time_now_ms;
+	uint32_t num_expired;
 	struct ol_tx_reorder_cat_timeout_t *rx_reorder_timeout_ac;
 
 	rx_reorder_timeout_ac = (struct ol_tx_reorder_cat_timeout_t *)arg;
@@ -129,19 +247,37 @@ static void ol_rx_reorder_timeout(void *arg)
 	pdev = rx_reorder_timeout_ac->pdev;
 	qdf_spin_lock(&pdev->rx.mutex);
 /* TODO: conditionally take mutex lock during regular rx */
-	TAILQ_FOREACH_SAFE(list_elem,
-			   &rx_reorder_timeout_ac->virtual_timer_list,
-			   reorder_timeout_list_elem, tmp) {
+	num_expired = ol_rx_reorder_timeout_advance(rx_reorder_timeout_ac,
+						    time_now_ms);
+	if (num_expired > rx_reorder_timeout_ac->max_batch)
+		rx_reorder_timeout_ac->max_batch = num_expired;
+
+	/* restart the timer if unexpired elements are left in the wheel */
+	if (rx_reorder_timeout_ac->num_armed)
+		ol_rx_reorder_timeout_start(rx_reorder_timeout_ac, time_now_ms);
+	qdf_spin_unlock(&pdev->rx.mutex);
+
+	/*
+	 * Flush the expired peer-TIDs one at a time, so that regular rx is
+	 * not held off for the whole batch. A peer-TID removed meanwhile is
+	 * unlinked from the expired list by ol_rx_reorder_timeout_remove().
+	 */
+	while (1) {
 		unsigned int idx_start, idx_end;
 		struct ol_txrx_peer_t *peer;
 
-		if (list_elem->timestamp_ms > time_now_ms)
-			break;  /* time has not expired yet for this element */
+		qdf_spin_lock(&pdev->rx.mutex);
+		list_elem = TAILQ_FIRST(&rx_reorder_timeout_ac->expired_list);
+		if (!list_elem) {
+			qdf_spin_unlock(&pdev->rx.mutex);
+			break;
+		}
 
-		list_elem->active = 0;
-		/* remove the expired element from the list */
-		TAILQ_REMOVE(&rx_reorder_timeout_ac->virtual_timer_list,
-			     list_elem, reorder_timeout_list_elem);
+		list_elem->expired = 0;
+		TAILQ_REMOVE(&rx_reorder_timeout_ac->expired_list, list_elem,
+			     reorder_timeout_list_elem);
+		list_elem->flush_cnt++;
+		rx_reorder_timeout_ac->flush_cnt++;
 
 		peer = list_elem->peer;
 
@@ -151,17 +287,13 @@ static void ol_rx_reorder_timeout(void *arg)
 				    peer,
 				    list_elem->tid,
 				    idx_start, idx_end, htt_rx_flush_release);
+		qdf_spin_unlock(&pdev->rx.mutex);
 	}
-	/* restart the timer if unexpired elements are left in the list */
-	if (!TAILQ_EMPTY(&rx_reorder_timeout_ac->virtual_timer_list))
-		ol_rx_reorder_timeout_start(rx_reorder_timeout_ac, time_now_ms);
-
-	qdf_spin_unlock(&pdev->rx.mutex);
 }
 
 void ol_rx_reorder_timeout_init(struct ol_txrx_pdev_t *pdev)
 {
-	int i;
+	int i, j;
 
 	for (i = 0; i < QDF_ARRAY_SIZE(pdev->rx.reorder_timeout.access_cats);
 		i++) {
@@ -175,8 +307,12 @@ void ol_rx_reorder_timeout_init(struct ol_txrx_pdev_t *pdev)
 				       ol_rx_reorder_timeout,
 				       rx_reorder_timeout_ac,
 				       QDF_TIMER_TYPE_SW);
-		/* init the virtual timer list */
-		TAILQ_INIT(&rx_reorder_timeout_ac->virtual_timer_list);
+		/* init the timing wheel */
+		for (j = 0; j < OL_RX_REORDER_TIMEOUT_WHEEL_SLOTS; j++)
+			TAILQ_INIT(&rx_reorder_timeout_ac->wheel[j]);
+		TAILQ_INIT(&rx_reorder_timeout_ac->expired_list);
+		rx_reorder_timeout_ac->cursor_slot = 0;
+		rx_reorder_timeout_ac->num_armed = 0;
 		rx_reorder_timeout_ac->pdev = pdev;
 	}
 	pdev->rx.reorder_timeout.access_cats[TXRX_WMM_AC_VO].duration_ms = 40;
@@ -195,6 +331,35 @@ void ol_rx_reorder_timeout_peer_cleanup(struct ol_txrx_peer_t *peer)
 	}
 }
 
+void ol_rx_reorder_timeout_peer_display(struct ol_txrx_peer_t *peer)
+{
+	int tid;
+
+	for (tid = 0; tid < OL_TXRX_NUM_EXT_TIDS; tid++) {
+		if (!peer->tids_rx_reorder[tid].timeout.flush_cnt)
+			continue;
+
+		txrx_nofl_info("rx reorder timeout: tid %d flushes %u", tid,
+			       peer->tids_rx_reorder[tid].timeout.flush_cnt);
+	}
+}
+
+void ol_rx_reorder_timeout_display(struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_tx_reorder_cat_timeout_t *rx_reorder_timeout_ac;
+	int i;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(pdev->rx.reorder_timeout.access_cats);
+		i++) {
+		rx_reorder_timeout_ac =
+			&pdev->rx.reorder_timeout.access_cats[i];
+		txrx_nofl_info("rx reorder timeout: ac %d armed %u flushes %u max batch %u",
+			       i, rx_reorder_timeout_ac->num_armed,
+			       rx_reorder_timeout_ac->flush_cnt,
+			       rx_reorder_timeout_ac->max_batch);
+	}
+}
+
 void ol_rx_reorder_timeout_cleanup(struct ol_txrx_pdev_t *pdev)
 {
 	int i;
@@ -29,11 +29,29 @@ void ol_rx_reorder_timeout_remove(struct ol_txrx_peer_t *peer,
 void ol_rx_reorder_timeout_update(struct ol_txrx_peer_t *peer, uint8_t tid);
 void ol_rx_reorder_timeout_peer_cleanup(struct ol_txrx_peer_t *peer);
 
+/**
+ * ol_rx_reorder_timeout_peer_display() - log the timeout flushes of a peer
+ * @peer: peer
+ *
+ * Return: none
+ */
+void ol_rx_reorder_timeout_peer_display(struct ol_txrx_peer_t *peer);
+
+/**
+ * ol_rx_reorder_timeout_display() - log the per-AC rx reorder timeout stats
+ * @pdev: physical device
+ *
+ * Return: none
+ */
+void ol_rx_reorder_timeout_display(struct ol_txrx_pdev_t *pdev);
+
 #define OL_RX_REORDER_TIMEOUT_INIT    ol_rx_reorder_timeout_init
 #define OL_RX_REORDER_TIMEOUT_PEER_CLEANUP ol_rx_reorder_timeout_peer_cleanup
 #define OL_RX_REORDER_TIMEOUT_CLEANUP ol_rx_reorder_timeout_cleanup
 #define OL_RX_REORDER_TIMEOUT_REMOVE  ol_rx_reorder_timeout_remove
 #define OL_RX_REORDER_TIMEOUT_UPDATE  ol_rx_reorder_timeout_update
+#define OL_RX_REORDER_TIMEOUT_PEER_DISPLAY ol_rx_reorder_timeout_peer_display
+#define OL_RX_REORDER_TIMEOUT_DISPLAY ol_rx_reorder_timeout_display
 #define OL_RX_REORDER_TIMEOUT_PEER_TID_INIT(peer, tid) \
 	(peer)->tids_rx_reorder[(tid)].timeout.active = 0
 #define OL_RX_REORDER_TIMEOUT_MUTEX_LOCK(pdev) \
@@ -48,6 +66,8 @@ void ol_rx_reorder_timeout_peer_cleanup(struct ol_txrx_peer_t *peer);
 #define OL_RX_REORDER_TIMEOUT_CLEANUP(pdev)     /* no-op */
 #define OL_RX_REORDER_TIMEOUT_REMOVE(peer, tid) /* no-op */
 #define OL_RX_REORDER_TIMEOUT_UPDATE(peer, tid) /* no-op */
+#define OL_RX_REORDER_TIMEOUT_PEER_DISPLAY(peer)        /* no-op */
+#define OL_RX_REORDER_TIMEOUT_DISPLAY(pdev)     /* no-op */
 #define OL_RX_REORDER_TIMEOUT_PEER_TID_INIT(peer, tid)  /* no-op */
 #define OL_RX_REORDER_TIMEOUT_MUTEX_LOCK(pdev)  /* no-op */
 #define OL_RX_REORDER_TIMEOUT_MUTEX_UNLOCK(pdev)        /* no-op */
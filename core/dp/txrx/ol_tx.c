@@ -80,6 +80,7 @@ qdf_nbuf_t ol_tx_data(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 
 	/* Terminate the (single-element) list of tx frames */
 	qdf_nbuf_set_next(skb, NULL);
+	ol_tx_throttle_shaper_account(pdev, skb);
 	ret = OL_TX_SEND(vdev, skb);
 	if (ret) {
 		ol_txrx_dbg("Failed to tx");
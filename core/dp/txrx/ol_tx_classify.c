@@ -96,6 +96,21 @@ ol_if_tx_bad_peer_txq_overflow(
 	else
 		return false;
 }
+
+/**
+ * ol_tx_bad_peer_desc_set() - record whose tx limit budget a frame uses
+ * @tx_desc: tx descriptor of the frame
+ * @txq: tx queue the frame is classified into
+ *
+ * Return: None
+ */
+static inline void
+ol_tx_bad_peer_desc_set(struct ol_tx_desc_t *tx_desc,
+			struct ol_tx_frms_queue_t *txq)
+{
+	tx_desc->bal_peer_id = (txq && txq->peer) ?
+			       txq->peer->peer_ids[0] : HTT_INVALID_PEER;
+}
 #else
 static inline A_BOOL ol_if_tx_bad_peer_txq_overflow(
 	struct ol_txrx_pdev_t *pdev,
@@ -104,6 +119,12 @@ static inline A_BOOL ol_if_tx_bad_peer_txq_overflow(
 {
 	return false;
 }
+
+static inline void
+ol_tx_bad_peer_desc_set(struct ol_tx_desc_t *tx_desc,
+			struct ol_tx_frms_queue_t *txq)
+{
+}
 #endif
 
 /* EAPOL go with voice priority: WMM_AC_TO_TID1(WMM_AC_VO);*/
@@ -341,16 +362,10 @@ struct ol_txrx_peer_t *ol_tx_tdls_peer_find(struct ol_txrx_pdev_t *pdev,
 	uint8_t zero_mac_addr[QDF_MAC_ADDR_SIZE] = { 0, 0, 0, 0, 0, 0 };
 	enum peer_debug_id_type id_type = PEER_DEBUG_ID_OL_INTERNAL;
 
-	struct ol_txrx_peer_t *(*find_peer)(struct ol_txrx_pdev_t *pdev,
-					    uint8_t *peer_mac_addr,
-					    int mac_addr_is_aligned,
-					    u8 check_valid,
-					    enum peer_debug_id_type dbg_id)
-		= ol_txrx_peer_find_hash_find_get_ref;
-
 	if (vdev->hlTdlsFlag) {
-		peer = find_peer(pdev, vdev->hl_tdls_ap_mac_addr.raw,
-				 0, 1, id_type);
+		peer = ol_txrx_peer_find_hash_find_get_ref_cached(
+				vdev, OL_TX_PEER_CACHE_UCAST,
+				vdev->hl_tdls_ap_mac_addr.raw, id_type);
 
 		if (peer && (peer->peer_ids[0] == HTT_INVALID_PEER_ID)) {
 			ol_txrx_peer_release_ref(peer, id_type);
@@ -387,8 +402,10 @@ struct ol_txrx_peer_t *ol_tx_tdls_peer_find(struct ol_txrx_pdev_t *pdev,
 		} else { /* packet destined for other peers and AP when
 			  * STA has TDLS link
 			  */
-			peer = find_peer(pdev, vdev->hl_tdls_ap_mac_addr.raw,
-					 0, 1, id_type);
+			peer = ol_txrx_peer_find_hash_find_get_ref_cached(
+					vdev, OL_TX_PEER_CACHE_UCAST,
+					vdev->hl_tdls_ap_mac_addr.raw,
+					id_type);
 
 			if (peer &&
 			    (peer->peer_ids[0] == HTT_INVALID_PEER_ID)) {
@@ -495,10 +512,10 @@ ol_tx_classify(
 			 * classify_extension function can check whether to
 			 * encrypt multicast / broadcast frames.
 			 */
-			peer = ol_txrx_peer_find_hash_find_get_ref
-						(pdev,
+			peer = ol_txrx_peer_find_hash_find_get_ref_cached
+						(vdev,
+						 OL_TX_PEER_CACHE_MCAST,
 						 vdev->mac_addr.raw,
-						 0, 1,
 						 PEER_DEBUG_ID_OL_INTERNAL);
 			if (!peer) {
 				QDF_TRACE(QDF_MODULE_ID_TXRX,
@@ -553,9 +570,9 @@ ol_tx_classify(
 						    dest_addr,
 						    &peer_id);
 		} else {
-			peer = ol_txrx_peer_find_hash_find_get_ref(pdev,
-								   dest_addr,
-								   0, 1,
+			peer = ol_txrx_peer_find_hash_find_get_ref_cached(
+						vdev, OL_TX_PEER_CACHE_UCAST,
+						dest_addr,
 						PEER_DEBUG_ID_OL_INTERNAL);
 		}
 		tx_msdu_info->htt.info.is_unicast = true;
@@ -643,6 +660,7 @@ ol_tx_classify(
 
 	/* Update Tx Queue info */
 	tx_desc->txq = txq;
+	ol_tx_bad_peer_desc_set(tx_desc, txq);
 
 	TX_SCHED_DEBUG_PRINT("Leave");
 	return txq;
@@ -758,6 +776,7 @@ ol_tx_classify_mgmt(
 
 	/* Update Tx Queue info */
 	tx_desc->txq = txq;
+	ol_tx_bad_peer_desc_set(tx_desc, txq);
 
 	TX_SCHED_DEBUG_PRINT("Leave");
 	return txq;
@@ -34,6 +34,7 @@
 #include <ol_txrx_encap.h>      /* OL_TX_RESTORE_HDR, etc */
 #endif
 #include <ol_txrx.h>
+#include <ol_tx_queue.h>        /* ol_tx_throttle_shaper_rehold */
 
 #ifdef QCA_SUPPORT_TXDESC_SANITY_CHECKS
 static inline void ol_tx_desc_sanity_checks(struct ol_txrx_pdev_t *pdev,
@@ -197,6 +198,8 @@ static void ol_tx_do_pdev_flow_control_unpause(struct ol_txrx_pdev_t *pdev)
 				pdev->pause_cb(vdev->vdev_id,
 					       WLAN_WAKE_NON_PRIORITY_QUEUE,
 					       WLAN_DATA_FLOW_CONTROL);
+				ol_tx_throttle_shaper_rehold(pdev,
+							     vdev->vdev_id);
 			}
 			pdev->tx_desc.status = FLOW_POOL_ACTIVE_UNPAUSED;
 		}
@@ -296,11 +299,13 @@ struct ol_tx_desc_t *ol_tx_desc_alloc(struct ol_txrx_pdev_t *pdev,
 	qdf_spin_lock_bh(&pool->flow_pool_lock);
 	if (pool->avail_desc) {
 		tx_desc = ol_tx_get_desc_flow_pool(pool);
+		pool->alloc_cnt++;
 		ol_tx_desc_dup_detect_set(pdev, tx_desc);
 		if (qdf_unlikely(pool->avail_desc < pool->stop_th &&
 				(pool->avail_desc >= pool->stop_priority_th) &&
 				(pool->status == FLOW_POOL_ACTIVE_UNPAUSED))) {
 			pool->status = FLOW_POOL_NON_PRIO_PAUSED;
+			ol_tx_flow_pool_pause_start(pool);
 			/* pause network NON PRIORITY queues */
 			pdev->pause_cb(vdev->vdev_id,
 				       WLAN_STOP_NON_PRIORITY_QUEUE,
@@ -612,7 +617,10 @@ void ol_tx_desc_free(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_t *tx_desc)
 			pdev->pause_cb(pool->member_flow_id,
 				       WLAN_WAKE_NON_PRIORITY_QUEUE,
 				       WLAN_DATA_FLOW_CONTROL);
+			ol_tx_throttle_shaper_rehold(pdev,
+						     pool->member_flow_id);
 			pool->status = FLOW_POOL_ACTIVE_UNPAUSED;
+			ol_tx_flow_pool_pause_end(pool);
 		}
 		break;
 	case FLOW_POOL_INVALID:
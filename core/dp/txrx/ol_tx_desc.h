@@ -338,6 +338,42 @@ void ol_tx_put_desc_flow_pool(struct ol_tx_flow_pool_t *pool,
 	pool->avail_desc++;
 }
 
+/**
+ * ol_tx_flow_pool_pause_start() - account a pause of the pool netif queues
+ * @pool: flow pool
+ *
+ * Called on the transition out of FLOW_POOL_ACTIVE_UNPAUSED, caller needs
+ * to hold the flow_pool_lock.
+ *
+ * Return: none
+ */
+static inline
+void ol_tx_flow_pool_pause_start(struct ol_tx_flow_pool_t *pool)
+{
+	pool->pause_cnt++;
+	pool->pause_ts = qdf_system_ticks();
+}
+
+/**
+ * ol_tx_flow_pool_pause_end() - account time the pool netif queues were paused
+ * @pool: flow pool
+ *
+ * Called on the transition back to FLOW_POOL_ACTIVE_UNPAUSED, caller needs
+ * to hold the flow_pool_lock.
+ *
+ * Return: none
+ */
+static inline
+void ol_tx_flow_pool_pause_end(struct ol_tx_flow_pool_t *pool)
+{
+	if (!pool->pause_ts)
+		return;
+
+	pool->paused_ms += qdf_system_ticks_to_msecs(qdf_system_ticks() -
+						     pool->pause_ts);
+	pool->pause_ts = 0;
+}
+
 #else
 static inline int ol_tx_free_invalid_flow_pool(void *pool)
 {
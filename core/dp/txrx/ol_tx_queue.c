@@ -19,6 +19,7 @@
 
 #include <qdf_nbuf.h>           /* qdf_nbuf_t, etc. */
 #include <qdf_atomic.h>         /* qdf_atomic_read, etc. */
+#include <qdf_time.h>           /* qdf_system_ticks, etc. */
 #include <ol_cfg.h>             /* ol_cfg_addba_retry */
 #include <htt.h>                /* HTT_TX_EXT_TID_MGMT */
 #include <ol_htt_tx_api.h>      /* htt_tx_desc_tid */
@@ -682,23 +683,49 @@ void ol_txrx_vdev_flush(struct cdp_soc_t *soc_hdl, uint8_t vdev_id)
 #ifdef QCA_BAD_PEER_TX_FLOW_CL
 
 /**
- * ol_txrx_peer_bal_add_limit_peer() - add one peer into limit list
- * @pdev:		Pointer to PDEV structure.
- * @peer_id:	Peer Identifier.
- * @peer_limit	Peer limit threshold
+ * ol_tx_peer_bal_inflight() - MSDUs of a peer held by the target
+ * @est: tx completion rate estimate of the peer
  *
- * Add one peer into the limit list of pdev
- * Note that the peer limit info will be also updated
- * If it is the first time, start the timer
+ * Return: MSDUs downloaded and not completed yet
+ */
+static inline u_int32_t
+ol_tx_peer_bal_inflight(struct ol_tx_peer_bal_est_t *est)
+{
+	int32_t inflight = est->dl_msdus - est->comp_msdus;
+
+	return inflight > 0 ? inflight : 0;
+}
+
+/**
+ * ol_tx_peer_bal_budget() - MSDUs a limited peer may still download
+ * @peer: peer device object
+ *
+ * Return: limit of the peer less its MSDUs held by the target
+ */
+static inline u_int16_t ol_tx_peer_bal_budget(struct ol_txrx_peer_t *peer)
+{
+	u_int32_t inflight = ol_tx_peer_bal_inflight(&peer->tx_bal_est);
+
+	return inflight < peer->tx_bal_est.limit ?
+	       peer->tx_bal_est.limit - inflight : 0;
+}
+
+/**
+ * ol_txrx_peer_bal_add_limit() - add one peer into limit list
+ * @pdev: Pointer to PDEV structure.
+ * @peer_id: Peer Identifier.
+ * @peer: peer of @peer_id, or NULL if it is not known
+ * @peer_limit: Peer limit threshold
+ *
+ * Caller must hold tx_peer_bal.mutex
  *
  * Return: None
  */
-void
-ol_txrx_peer_bal_add_limit_peer(struct ol_txrx_pdev_t *pdev,
-				u_int16_t peer_id, u_int16_t peer_limit)
+static void
+ol_txrx_peer_bal_add_limit(struct ol_txrx_pdev_t *pdev, u_int16_t peer_id,
+			   struct ol_txrx_peer_t *peer, u_int16_t peer_limit)
 {
 	u_int16_t i, existed = 0;
-	struct ol_txrx_peer_t *peer = NULL;
 
 	for (i = 0; i < pdev->tx_peer_bal.peer_num; i++) {
 		if (pdev->tx_peer_bal.limit_list[i].peer_id == peer_id) {
@@ -707,7 +734,14 @@ ol_txrx_peer_bal_add_limit_peer(struct ol_txrx_pdev_t *pdev,
 		}
 	}
 
-	if (!existed) {
+	if (existed) {
+		/* the PHY level may have changed, so may the limit */
+		pdev->tx_peer_bal.limit_list[i].limit = peer_limit;
+		if (peer) {
+			peer->tx_bal_est.limit = peer_limit;
+			peer->tx_limit = ol_tx_peer_bal_budget(peer);
+		}
+	} else {
 		u_int32_t peer_num = pdev->tx_peer_bal.peer_num;
 		/* Check if peer_num has reached the capabilit */
 		if (peer_num >= MAX_NO_PEERS_IN_LIMIT) {
@@ -720,10 +754,10 @@ ol_txrx_peer_bal_add_limit_peer(struct ol_txrx_pdev_t *pdev,
 		pdev->tx_peer_bal.limit_list[peer_num].limit = peer_limit;
 		pdev->tx_peer_bal.peer_num++;
 
-		peer = ol_txrx_peer_find_by_id(pdev, peer_id);
 		if (peer) {
 			peer->tx_limit_flag = true;
-			peer->tx_limit = peer_limit;
+			peer->tx_bal_est.limit = peer_limit;
+			peer->tx_limit = ol_tx_peer_bal_budget(peer);
 		}
 
 		TX_SCHED_DEBUG_PRINT_ALWAYS(
@@ -743,21 +777,20 @@ ol_txrx_peer_bal_add_limit_peer(struct ol_txrx_pdev_t *pdev,
 }
 
 /**
- * ol_txrx_peer_bal_remove_limit_peer() - remove one peer from limit list
- * @pdev:		Pointer to PDEV structure.
- * @peer_id:	Peer Identifier.
+ * ol_txrx_peer_bal_remove_limit() - remove one peer from limit list
+ * @pdev: Pointer to PDEV structure.
+ * @peer_id: Peer Identifier.
+ * @peer: peer of @peer_id, or NULL if it is not known
  *
- * Remove one peer from the limit list of pdev
- * Note that Only stop the timer if no peer in limit state
+ * Caller must hold tx_peer_bal.mutex
  *
- * Return: NULL
+ * Return: None
  */
-void
-ol_txrx_peer_bal_remove_limit_peer(struct ol_txrx_pdev_t *pdev,
-				   u_int16_t peer_id)
+static void
+ol_txrx_peer_bal_remove_limit(struct ol_txrx_pdev_t *pdev, u_int16_t peer_id,
+			      struct ol_txrx_peer_t *peer)
 {
 	u_int16_t i;
-	struct ol_txrx_peer_t *peer = NULL;
 
 	for (i = 0; i < pdev->tx_peer_bal.peer_num; i++) {
 		if (pdev->tx_peer_bal.limit_list[i].peer_id == peer_id) {
@@ -766,7 +799,6 @@ ol_txrx_peer_bal_remove_limit_peer(struct ol_txrx_pdev_t *pdev,
 					pdev->tx_peer_bal.peer_num - 1];
 			pdev->tx_peer_bal.peer_num--;
 
-			peer = ol_txrx_peer_find_by_id(pdev, peer_id);
 			if (peer)
 				peer->tx_limit_flag = false;
 
@@ -780,13 +812,54 @@ ol_txrx_peer_bal_remove_limit_peer(struct ol_txrx_pdev_t *pdev,
 	}
 
 	/* Only stop the timer if no peer in limit state */
-	if (pdev->tx_peer_bal.peer_num == 0) {
+	if (pdev->tx_peer_bal.peer_num == 0 &&
+	    pdev->tx_peer_bal.peer_bal_timer_state ==
+					ol_tx_peer_bal_timer_active) {
 		qdf_timer_stop(&pdev->tx_peer_bal.peer_bal_timer);
 		pdev->tx_peer_bal.peer_bal_timer_state =
 				ol_tx_peer_bal_timer_inactive;
 	}
 }
 
+/**
+ * ol_txrx_peer_bal_add_limit_peer() - add one peer into limit list
+ * @pdev:		Pointer to PDEV structure.
+ * @peer_id:	Peer Identifier.
+ * @peer_limit	Peer limit threshold
+ *
+ * Add one peer into the limit list of pdev
+ * Note that the peer limit info will be also updated
+ * If it is the first time, start the timer
+ *
+ * Return: None
+ */
+void
+ol_txrx_peer_bal_add_limit_peer(struct ol_txrx_pdev_t *pdev,
+				u_int16_t peer_id, u_int16_t peer_limit)
+{
+	ol_txrx_peer_bal_add_limit(pdev, peer_id,
+				   ol_txrx_peer_find_by_id(pdev, peer_id),
+				   peer_limit);
+}
+
+/**
+ * ol_txrx_peer_bal_remove_limit_peer() - remove one peer from limit list
+ * @pdev:		Pointer to PDEV structure.
+ * @peer_id:	Peer Identifier.
+ *
+ * Remove one peer from the limit list of pdev
+ * Note that Only stop the timer if no peer in limit state
+ *
+ * Return: NULL
+ */
+void
+ol_txrx_peer_bal_remove_limit_peer(struct ol_txrx_pdev_t *pdev,
+				   u_int16_t peer_id)
+{
+	ol_txrx_peer_bal_remove_limit(pdev, peer_id,
+				      ol_txrx_peer_find_by_id(pdev, peer_id));
+}
+
 void
 ol_txrx_peer_pause_but_no_mgmt_q(ol_txrx_peer_handle peer)
 {
@@ -855,6 +928,9 @@ ol_tx_bad_peer_update_tx_limit(struct ol_txrx_pdev_t *pdev,
 	}
 
 	qdf_spin_lock_bh(&pdev->tx_peer_bal.mutex);
+	if (txq->peer)
+		txq->peer->tx_bal_est.dl_msdus += frames;
+
 	if (tx_limit_flag && (txq->peer) &&
 	    (txq->peer->tx_limit_flag)) {
 		if (txq->peer->tx_limit < frames)
@@ -862,7 +938,7 @@ ol_tx_bad_peer_update_tx_limit(struct ol_txrx_pdev_t *pdev,
 		else
 			txq->peer->tx_limit -= frames;
 
-		TX_SCHED_DEBUG_PRINT_ALWAYS(
+		TX_SCHED_DEBUG_PRINT(
 				"Peer ID %d in limit, deque %d frms",
 				txq->peer->peer_ids[0], frames);
 	} else if (txq->peer) {
@@ -872,6 +948,129 @@ ol_tx_bad_peer_update_tx_limit(struct ol_txrx_pdev_t *pdev,
 	qdf_spin_unlock_bh(&pdev->tx_peer_bal.mutex);
 }
 
+enum ol_tx_peer_bal_verdict
+ol_tx_peer_bal_est_update(struct ol_tx_peer_bal_est_t *est,
+			  const struct tx_peer_threshold *ctl_thresh,
+			  bool limited, u_int32_t now_ms,
+			  u_int32_t bytes, bool acked)
+{
+	const struct tx_peer_threshold *level;
+	u_int32_t elapsed, sample, inflight;
+	u_int16_t msdus;
+
+	est->comp_msdus++;
+
+	/* a peer that went idle is not backlogged, start over */
+	if (est->win_msdus &&
+	    now_ms - est->last_comp_ms > OL_TX_PEER_BAL_WIN_MS)
+		est->win_msdus = 0;
+
+	inflight = ol_tx_peer_bal_inflight(est);
+	est->last_comp_ms = now_ms;
+	if (!est->win_msdus) {
+		est->win_start_ms = now_ms;
+		est->win_bytes = 0;
+		est->win_min_inflight = inflight;
+	}
+	est->win_msdus++;
+	if (acked)
+		est->win_bytes += bytes;
+	if (inflight < est->win_min_inflight)
+		est->win_min_inflight = inflight;
+
+	elapsed = now_ms - est->win_start_ms;
+	if (elapsed < OL_TX_PEER_BAL_WIN_MS)
+		return OL_TX_PEER_BAL_KEEP;
+
+	msdus = est->win_msdus;
+	sample = qdf_do_div((u_int64_t)est->win_bytes * 8, elapsed);
+	est->win_msdus = 0;
+
+	/* too little traffic to tell a slow peer from a quiet one */
+	if (msdus < OL_TX_PEER_BAL_MIN_MSDUS)
+		return OL_TX_PEER_BAL_KEEP;
+
+	est->tput = est->tput ? (est->tput * 3 + sample) / 4 : sample;
+
+	level = &ctl_thresh[est->phy_valid ? est->phy :
+			    OL_TX_PEER_BAL_DEFAULT_PHY];
+	if (!level->tput_thresh)
+		return OL_TX_PEER_BAL_KEEP;
+
+	/*
+	 * A slow peer sits on a pile of target descriptors for the whole
+	 * window, a peer merely starved of them by a slow one drains its
+	 * few on every completion batch
+	 */
+	if (!limited && est->tput < level->tput_thresh &&
+	    est->win_min_inflight > level->tx_limit)
+		return OL_TX_PEER_BAL_LIMIT;
+
+	if (limited &&
+	    est->tput >= level->tput_thresh + (level->tput_thresh >> 3))
+		return OL_TX_PEER_BAL_RELEASE;
+
+	return OL_TX_PEER_BAL_KEEP;
+}
+
+void
+ol_tx_bad_peer_peer_comp(struct ol_txrx_pdev_t *pdev,
+			 struct ol_txrx_peer_t *peer,
+			 u_int32_t now_ms, u_int32_t bytes, bool acked)
+{
+	struct ol_tx_peer_bal_est_t *est = &peer->tx_bal_est;
+	enum ol_tx_peer_bal_verdict verdict;
+	u_int32_t limit;
+
+	verdict = ol_tx_peer_bal_est_update(est, pdev->tx_peer_bal.ctl_thresh,
+					    peer->tx_limit_flag, now_ms,
+					    bytes, acked);
+	if (!peer->tx_limit_flag && verdict == OL_TX_PEER_BAL_KEEP)
+		return;
+
+	qdf_spin_lock_bh(&pdev->tx_peer_bal.mutex);
+
+	/* the completed MSDU no longer counts against the peer budget */
+	if (peer->tx_limit_flag)
+		peer->tx_limit = ol_tx_peer_bal_budget(peer);
+
+	if (verdict == OL_TX_PEER_BAL_LIMIT) {
+		limit = pdev->tx_peer_bal.ctl_thresh[est->phy_valid ?
+				est->phy : OL_TX_PEER_BAL_DEFAULT_PHY].tx_limit;
+		if (limit) {
+			TX_SCHED_DEBUG_PRINT(
+				"peer_id %d tput %d kbps, limit %d",
+				peer->peer_ids[0], est->tput, limit);
+			ol_txrx_peer_bal_add_limit(pdev, peer->peer_ids[0],
+						   peer, limit);
+		}
+	} else if (verdict == OL_TX_PEER_BAL_RELEASE) {
+		TX_SCHED_DEBUG_PRINT("peer_id %d tput %d kbps, release",
+				     peer->peer_ids[0], est->tput);
+		ol_txrx_peer_bal_remove_limit(pdev, peer->peer_ids[0], peer);
+	}
+
+	qdf_spin_unlock_bh(&pdev->tx_peer_bal.mutex);
+}
+
+void
+ol_tx_bad_peer_tx_comp(struct ol_txrx_pdev_t *pdev,
+		       struct ol_tx_desc_t *tx_desc,
+		       bool acked, u_int32_t now_ms)
+{
+	struct ol_txrx_peer_t *peer;
+
+	if (!pdev->cfg.is_high_latency ||
+	    pdev->tx_peer_bal.enabled != ol_tx_peer_bal_enable ||
+	    tx_desc->bal_peer_id == HTT_INVALID_PEER)
+		return;
+
+	peer = ol_txrx_peer_find_by_id(pdev, tx_desc->bal_peer_id);
+	if (peer)
+		ol_tx_bad_peer_peer_comp(pdev, peer, now_ms,
+					 qdf_nbuf_len(tx_desc->netbuf), acked);
+}
+
 void
 ol_txrx_bad_peer_txctl_set_setting(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
 				   int enable, int period, int txq_limit)
@@ -908,6 +1107,10 @@ ol_txrx_bad_peer_txctl_update_threshold(struct cdp_soc_t *soc_hdl,
  * ol_tx_pdev_peer_bal_timer() - timer function
  * @context: context of timer function
  *
+ * Limited peers get their budget back from tx completions. Top up the
+ * ones that have not seen a completion for a whole period, e.g. because
+ * the target dropped their frames, so they cannot stall for good.
+ *
  * Return: None
  */
 static void
@@ -915,6 +1118,8 @@ ol_tx_pdev_peer_bal_timer(void *context)
 {
 	int i;
 	struct ol_txrx_pdev_t *pdev = (struct ol_txrx_pdev_t *)context;
+	u_int32_t now_ms = qdf_system_ticks_to_msecs(qdf_system_ticks());
+	bool refilled = false;
 
 	qdf_spin_lock_bh(&pdev->tx_peer_bal.mutex);
 
@@ -934,14 +1139,21 @@ ol_tx_pdev_peer_bal_timer(void *context)
 				(int)peer, tx_limit);
 
 			/*
-			 * It is possible the peer limit is still not 0,
-			 * but it is the scenario should not be cared
+			 * MSDUs the target has not completed for a whole
+			 * period are taken as lost
 			 */
 			if (peer) {
-				peer->tx_limit = tx_limit;
+				if (peer->tx_limit < tx_limit &&
+				    now_ms - peer->tx_bal_est.last_comp_ms >=
+				    pdev->tx_peer_bal.peer_bal_period_ms) {
+					peer->tx_bal_est.comp_msdus =
+						peer->tx_bal_est.dl_msdus;
+					peer->tx_limit = tx_limit;
+					refilled = true;
+				}
 			} else {
-				ol_txrx_peer_bal_remove_limit_peer(pdev,
-								   peer_id);
+				ol_txrx_peer_bal_remove_limit(pdev, peer_id,
+							      NULL);
 				TX_SCHED_DEBUG_PRINT_ALWAYS(
 					"No such a peer, peer id = %d",
 					peer_id);
@@ -952,7 +1164,8 @@ ol_tx_pdev_peer_bal_timer(void *context)
 	qdf_spin_unlock_bh(&pdev->tx_peer_bal.mutex);
 
 	if (pdev->tx_peer_bal.peer_num) {
-		ol_tx_sched(pdev);
+		if (refilled)
+			ol_tx_sched(pdev);
 		qdf_timer_start(&pdev->tx_peer_bal.peer_bal_timer,
 					pdev->tx_peer_bal.peer_bal_period_ms);
 	}
@@ -1063,6 +1276,8 @@ ol_txrx_peer_link_status_handler(
 			u_int32_t thresh, limit, phy;
 
 			phy = peer_link_status->phy;
+			peer->tx_bal_est.phy = phy;
+			peer->tx_bal_est.phy_valid = true;
 			thresh = pdev->tx_peer_bal.ctl_thresh[phy].tput_thresh;
 			limit = pdev->tx_peer_bal.ctl_thresh[phy].tx_limit;
 
@@ -1071,14 +1286,14 @@ ol_txrx_peer_link_status_handler(
 				peer_limit = limit;
 
 			if (peer_limit) {
-				ol_txrx_peer_bal_add_limit_peer(pdev, peer_id,
-								peer_limit);
+				ol_txrx_peer_bal_add_limit(pdev, peer_id, peer,
+							   peer_limit);
 			} else if (pdev->tx_peer_bal.peer_num) {
 				TX_SCHED_DEBUG_PRINT(
 					"Check if peer_id %d exit limit",
 					peer_id);
-				ol_txrx_peer_bal_remove_limit_peer(pdev,
-								   peer_id);
+				ol_txrx_peer_bal_remove_limit(pdev, peer_id,
+							      peer);
 			}
 			if ((peer_tput == 0) &&
 			    (peer->tx_pause_flag == false)) {
@@ -26,6 +26,7 @@
 #include <qdf_nbuf.h>           /* qdf_nbuf_t */
 #include <cdp_txrx_cmn.h>       /* ol_txrx_vdev_t, etc. */
 #include <qdf_types.h>          /* bool */
+#include <ol_txrx_types.h>      /* ol_tx_peer_bal_est_t, etc. */
 
 /*--- function prototypes for optional queue log feature --------------------*/
 #if defined(ENABLE_TX_QUEUE_LOG) || \
@@ -353,6 +354,63 @@ ol_tx_bad_peer_update_tx_limit(struct ol_txrx_pdev_t *pdev,
 			       u_int16_t frames,
 			       u_int16_t tx_limit_flag);
 
+/**
+ * ol_tx_peer_bal_est_update() - account one tx completion of a peer
+ * @est: tx completion rate estimate of the peer
+ * @ctl_thresh: throughput thresholds and limits per PHY level
+ * @limited: the peer is currently in the limit list
+ * @now_ms: completion time
+ * @bytes: length of the completed MSDU
+ * @acked: the MSDU was acked
+ *
+ * Every OL_TX_PEER_BAL_WIN_MS of back to back completions the acked
+ * throughput of the window is folded into the smoothed estimate, which is
+ * then checked against the threshold of the peer PHY level. A peer below
+ * it is only limited if it held more MSDUs in the target than the limit of
+ * its level for the whole window, so peers starved by a slow one are left
+ * alone.
+ *
+ * Return: verdict on the peer, OL_TX_PEER_BAL_KEEP until a window closes
+ */
+enum ol_tx_peer_bal_verdict
+ol_tx_peer_bal_est_update(struct ol_tx_peer_bal_est_t *est,
+			  const struct tx_peer_threshold *ctl_thresh,
+			  bool limited, u_int32_t now_ms,
+			  u_int32_t bytes, bool acked);
+
+/**
+ * ol_tx_bad_peer_peer_comp() - handle one tx completion of a peer
+ * @pdev: the physical device object
+ * @peer: peer the MSDU was sent to
+ * @now_ms: completion time
+ * @bytes: length of the completed MSDU
+ * @acked: the MSDU was acked
+ *
+ * A limited peer may keep as many MSDUs in the target as its limit, so the
+ * completion hands its slot back. The peer is also added to or removed from
+ * the limit list when its completion rate estimate says so.
+ *
+ * Return: None
+ */
+void
+ol_tx_bad_peer_peer_comp(struct ol_txrx_pdev_t *pdev,
+			 struct ol_txrx_peer_t *peer,
+			 u_int32_t now_ms, u_int32_t bytes, bool acked);
+
+/**
+ * ol_tx_bad_peer_tx_comp() - feed a tx completion to bad peer flow control
+ * @pdev: the physical device object
+ * @tx_desc: completed tx descriptor
+ * @acked: the MSDU was acked
+ * @now_ms: completion time
+ *
+ * Return: None
+ */
+void
+ol_tx_bad_peer_tx_comp(struct ol_txrx_pdev_t *pdev,
+		       struct ol_tx_desc_t *tx_desc,
+		       bool acked, u_int32_t now_ms);
+
 /**
  * ol_txrx_set_txq_peer() - set peer to the tx queue's peer
  * @txq: tx queue for a given tid
@@ -417,6 +475,13 @@ ol_tx_bad_peer_update_tx_limit(struct ol_txrx_pdev_t *pdev,
 {
 }
 
+static inline void
+ol_tx_bad_peer_tx_comp(struct ol_txrx_pdev_t *pdev,
+		       struct ol_tx_desc_t *tx_desc,
+		       bool acked, u_int32_t now_ms)
+{
+}
+
 static inline void
 ol_txrx_set_txq_peer(
 		struct ol_tx_frms_queue_t *txq,
@@ -505,6 +570,100 @@ ol_tx_throttle_init_period(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
 {}
 #endif
 
+#if defined(QCA_SUPPORT_TX_THROTTLE) && defined(QCA_LL_TX_THROTTLE_SHAPER)
+/**
+ * ol_tx_throttle_shaper_account() - charge a tx frame to the thermal shaper
+ * @pdev: pdev handle
+ * @nbuf: tx frame
+ *
+ * Takes tokens while a throttle level is shaped. Queue groups are held
+ * back once the tokens drop below their reserve and woken by the refill
+ * timer.
+ *
+ * Return: none
+ */
+void ol_tx_throttle_shaper_account(struct ol_txrx_pdev_t *pdev,
+				   qdf_nbuf_t nbuf);
+
+/**
+ * ol_tx_throttle_shaper_delivered() - sample the delivered tx rate
+ * @pdev: pdev handle
+ * @len: bytes acked by a tx completion
+ *
+ * The link capacity the shaper rate is derived from is estimated from
+ * the delivered tx rate, both before and while a level is shaped.
+ *
+ * Return: none
+ */
+void ol_tx_throttle_shaper_delivered(struct ol_txrx_pdev_t *pdev,
+				     uint32_t len);
+
+/**
+ * ol_tx_throttle_shaper_rehold() - stop the held queue groups of a vdev again
+ * @pdev: pdev handle
+ * @vdev_id: vdev whose queues were woken
+ *
+ * Flow control wakes all netif queues of a vdev once descriptors are
+ * available again, which includes the groups the shaper holds back.
+ * Must be called after such a wake so the throttle is not bypassed.
+ *
+ * Return: none
+ */
+void ol_tx_throttle_shaper_rehold(struct ol_txrx_pdev_t *pdev,
+				  uint8_t vdev_id);
+
+/**
+ * ol_tx_throttle_shaper_display() - show per throttle level tx statistics
+ * @pdev: pdev handle
+ *
+ * Return: none
+ */
+void ol_tx_throttle_shaper_display(struct ol_txrx_pdev_t *pdev);
+
+/**
+ * ol_tx_throttle_shaper_clear() - clear per throttle level tx statistics
+ * @pdev: pdev handle
+ *
+ * Return: none
+ */
+void ol_tx_throttle_shaper_clear(struct ol_txrx_pdev_t *pdev);
+
+/**
+ * ol_tx_throttle_shaper_deinit() - stop and free the thermal shaper
+ * @pdev: pdev handle
+ *
+ * Return: none
+ */
+void ol_tx_throttle_shaper_deinit(struct ol_txrx_pdev_t *pdev);
+#else
+static inline void
+ol_tx_throttle_shaper_account(struct ol_txrx_pdev_t *pdev, qdf_nbuf_t nbuf)
+{
+}
+
+static inline void
+ol_tx_throttle_shaper_delivered(struct ol_txrx_pdev_t *pdev, uint32_t len)
+{
+}
+
+static inline void
+ol_tx_throttle_shaper_rehold(struct ol_txrx_pdev_t *pdev, uint8_t vdev_id)
+{
+}
+
+static inline void ol_tx_throttle_shaper_display(struct ol_txrx_pdev_t *pdev)
+{
+}
+
+static inline void ol_tx_throttle_shaper_clear(struct ol_txrx_pdev_t *pdev)
+{
+}
+
+static inline void ol_tx_throttle_shaper_deinit(struct ol_txrx_pdev_t *pdev)
+{
+}
+#endif
+
 #ifdef FEATURE_HL_GROUP_CREDIT_FLOW_CONTROL
 
 static inline bool
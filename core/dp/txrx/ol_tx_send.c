@@ -1043,6 +1043,7 @@ ol_tx_completion_handler(ol_txrx_pdev_handle pdev,
 	uint64_t tx_tsf64;
 	uint8_t tid;
 	uint8_t dp_status;
+	uint32_t now_ms = qdf_system_ticks_to_msecs(qdf_system_ticks());
 
 	TAILQ_INIT(&tx_descs);
 
@@ -1109,6 +1110,8 @@ ol_tx_completion_handler(ol_txrx_pdev_handle pdev,
 		ol_tx_update_connectivity_stats(tx_desc, netbuf,
 						status);
 		ol_tx_update_ack_count(tx_desc, status);
+		ol_tx_bad_peer_tx_comp(pdev, tx_desc,
+				       status == htt_tx_status_ok, now_ms);
 
 		ol_tx_send_pktlog(soc, pdev, tx_desc, netbuf, status,
 				  QDF_TX_DATA_PKT);
@@ -1184,6 +1187,8 @@ ol_tx_completion_handler(ol_txrx_pdev_handle pdev,
 	ol_tx_flow_ct_unpause_os_q(pdev);
 	/* Do one shot statistics */
 	TXRX_STATS_UPDATE_TX_STATS(pdev, status, num_msdus, byte_cnt);
+	if (status == htt_tx_status_ok)
+		ol_tx_throttle_shaper_delivered(pdev, byte_cnt);
 }
 
 #ifdef FEATURE_HL_GROUP_CREDIT_FLOW_CONTROL
@@ -1365,6 +1370,8 @@ ol_tx_single_completion_handler(ol_txrx_pdev_handle pdev,
 	TXRX_STATS_UPDATE_TX_STATS(pdev, status, 1, qdf_nbuf_len(netbuf));
 
 	ol_tx_send_pktlog(soc, pdev, tx_desc, netbuf, status, QDF_TX_MGMT_PKT);
+	ol_tx_bad_peer_tx_comp(pdev, tx_desc, status == htt_tx_status_ok,
+			       qdf_system_ticks_to_msecs(qdf_system_ticks()));
 
 	if (OL_TX_DESC_NO_REFS(tx_desc)) {
 		ol_tx_desc_frame_free_nonstd(pdev, tx_desc,
@@ -1408,6 +1415,7 @@ ol_tx_inspect_handler(ol_txrx_pdev_handle pdev,
 	qdf_nbuf_t netbuf;
 	ol_tx_desc_list tx_descs;
 	uint32_t is_tx_desc_freed = 0;
+	uint32_t now_ms = qdf_system_ticks_to_msecs(qdf_system_ticks());
 
 	TAILQ_INIT(&tx_descs);
 
@@ -1434,6 +1442,8 @@ ol_tx_inspect_handler(ol_txrx_pdev_handle pdev,
 
 		/* vdev now points to the vdev for this descriptor. */
 
+		ol_tx_bad_peer_tx_comp(pdev, tx_desc, true, now_ms);
+
 #ifndef ATH_11AC_TXCOMPACT
 		/* save this multicast packet to local free list */
 		if (qdf_atomic_dec_and_test(&tx_desc->ref_cnt))
@@ -93,6 +93,527 @@ void ol_txrx_thermal_unpause(struct ol_txrx_pdev_t *pdev)
 }
 #endif
 
+#ifdef QCA_LL_TX_THROTTLE_SHAPER
+/* Token refill period in ms */
+#define OL_TX_SHAPER_TICK_MS		5
+/* Bucket depth in refill ticks, bounds the burst after an idle period */
+#define OL_TX_SHAPER_BURST_TICKS	4
+/* Window in ms over which the delivered tx rate is sampled */
+#define OL_TX_SHAPER_SAMPLE_MS		100
+/* Capacity deviation, as a shift, ignored while a level is shaped */
+#define OL_TX_SHAPER_CAPACITY_TOLERANCE	3
+
+/*
+ * Share of the bucket depth reserved for higher access categories, a
+ * queue group is held back once the tokens drop below its reserve so
+ * voice keeps sending inside the budget while bulk traffic waits.
+ */
+static const uint8_t ol_tx_shaper_reserve_pct[OL_TX_SHAPER_GRP_MAX] = {
+	[OL_TX_SHAPER_GRP_VO] = 0,
+	[OL_TX_SHAPER_GRP_VI] = 15,
+	[OL_TX_SHAPER_GRP_BE_BK] = 30,
+};
+
+static const enum netif_action_type
+ol_tx_shaper_queue_off[OL_TX_SHAPER_GRP_MAX] = {
+	[OL_TX_SHAPER_GRP_VO] = WLAN_NETIF_VO_QUEUE_OFF,
+	[OL_TX_SHAPER_GRP_VI] = WLAN_NETIF_VI_QUEUE_OFF,
+	[OL_TX_SHAPER_GRP_BE_BK] = WLAN_NETIF_BE_BK_QUEUE_OFF,
+};
+
+static const enum netif_action_type
+ol_tx_shaper_queue_on[OL_TX_SHAPER_GRP_MAX] = {
+	[OL_TX_SHAPER_GRP_VO] = WLAN_NETIF_VO_QUEUE_ON,
+	[OL_TX_SHAPER_GRP_VI] = WLAN_NETIF_VI_QUEUE_ON,
+	[OL_TX_SHAPER_GRP_BE_BK] = WLAN_NETIF_BE_BK_QUEUE_ON,
+};
+
+static const char * const ol_tx_shaper_grp_str[OL_TX_SHAPER_GRP_MAX] = {
+	[OL_TX_SHAPER_GRP_VO] = "VO",
+	[OL_TX_SHAPER_GRP_VI] = "VI",
+	[OL_TX_SHAPER_GRP_BE_BK] = "BE/BK",
+};
+
+/**
+ * ol_tx_shaper_nbuf_grp() - get the queue group of a tx frame
+ * @nbuf: tx frame
+ *
+ * Return: queue group
+ */
+static inline enum ol_tx_shaper_grp ol_tx_shaper_nbuf_grp(qdf_nbuf_t nbuf)
+{
+	switch (TXRX_TID_TO_WMM_AC(qdf_nbuf_get_priority(nbuf) & 0x7)) {
+	case TXRX_WMM_AC_VO:
+		return OL_TX_SHAPER_GRP_VO;
+	case TXRX_WMM_AC_VI:
+		return OL_TX_SHAPER_GRP_VI;
+	default:
+		return OL_TX_SHAPER_GRP_BE_BK;
+	}
+}
+
+/**
+ * ol_tx_shaper_set_vdev_queues() - stop or wake queue groups of a vdev
+ * @pdev: pdev handle
+ * @vdev_id: vdev id
+ * @grp_map: bitmap of queue groups
+ * @on: true to wake the queues, false to stop them
+ *
+ * Return: none
+ */
+static void ol_tx_shaper_set_vdev_queues(struct ol_txrx_pdev_t *pdev,
+					 uint8_t vdev_id, uint8_t grp_map,
+					 bool on)
+{
+	int grp;
+
+	for (grp = 0; grp < OL_TX_SHAPER_GRP_MAX; grp++) {
+		if (!(grp_map & (1 << grp)))
+			continue;
+		pdev->pause_cb(vdev_id,
+			       on ? ol_tx_shaper_queue_on[grp] :
+				    ol_tx_shaper_queue_off[grp],
+			       WLAN_THERMAL_MITIGATION);
+	}
+}
+
+/**
+ * ol_tx_shaper_set_queues() - stop or wake queue groups of all vdevs
+ * @pdev: pdev handle
+ * @grp_map: bitmap of queue groups
+ * @on: true to wake the queues, false to stop them
+ *
+ * Caller needs to hold the tx_throttle mutex, so the queue actions are
+ * ordered against ol_tx_throttle_shaper_rehold().
+ *
+ * Return: none
+ */
+static void ol_tx_shaper_set_queues(struct ol_txrx_pdev_t *pdev,
+				    uint8_t grp_map, bool on)
+{
+	struct ol_txrx_vdev_t *vdev;
+
+	if (!grp_map || !pdev->pause_cb)
+		return;
+
+	qdf_spin_lock_bh(&pdev->vdev_list_lock);
+	TAILQ_FOREACH(vdev, &pdev->vdev_list, vdev_list_elem)
+		ol_tx_shaper_set_vdev_queues(pdev, vdev->vdev_id, grp_map, on);
+	qdf_spin_unlock_bh(&pdev->vdev_list_lock);
+}
+
+/**
+ * ol_tx_shaper_release() - account the hold time of released queue groups
+ * @shaper: shaper context
+ * @grp_map: bitmap of queue groups being woken
+ * @now: current system ticks
+ *
+ * Caller needs to hold the tx_throttle mutex.
+ *
+ * Return: none
+ */
+static void ol_tx_shaper_release(struct ol_tx_shaper *shaper,
+				 uint8_t grp_map, unsigned long now)
+{
+	struct ol_tx_shaper_level_stats *stats = &shaper->stats[shaper->level];
+	uint32_t hold_ms;
+	int grp;
+
+	for (grp = 0; grp < OL_TX_SHAPER_GRP_MAX; grp++) {
+		if (!(grp_map & (1 << grp)))
+			continue;
+		hold_ms = qdf_system_ticks_to_msecs(now - shaper->stop_ts[grp]);
+		stats->hold_ms[grp] += hold_ms;
+		if (hold_ms > stats->hold_max_ms[grp])
+			stats->hold_max_ms[grp] = hold_ms;
+	}
+	shaper->stopped &= ~grp_map;
+}
+
+/**
+ * ol_tx_shaper_tick() - refill the token bucket
+ * @context: pdev handle
+ *
+ * Return: none
+ */
+static void ol_tx_shaper_tick(void *context)
+{
+	struct ol_txrx_pdev_t *pdev = (struct ol_txrx_pdev_t *)context;
+	struct ol_tx_shaper *shaper = &pdev->tx_throttle.shaper;
+	uint8_t wake_map = 0;
+	int grp;
+
+	qdf_spin_lock_bh(&pdev->tx_throttle.mutex);
+	if (!shaper->active) {
+		qdf_spin_unlock_bh(&pdev->tx_throttle.mutex);
+		return;
+	}
+
+	shaper->tokens += shaper->rate;
+	if (shaper->tokens > (int32_t)shaper->depth)
+		shaper->tokens = shaper->depth;
+
+	for (grp = 0; grp < OL_TX_SHAPER_GRP_MAX; grp++) {
+		if ((shaper->stopped & (1 << grp)) &&
+		    shaper->tokens > (int32_t)shaper->floor[grp])
+			wake_map |= 1 << grp;
+	}
+	ol_tx_shaper_release(shaper, wake_map, qdf_system_ticks());
+	ol_tx_shaper_set_queues(pdev, wake_map, true);
+	qdf_spin_unlock_bh(&pdev->tx_throttle.mutex);
+
+	qdf_timer_start(&shaper->tick_timer, OL_TX_SHAPER_TICK_MS);
+}
+
+/**
+ * ol_tx_shaper_level_done() - close the statistics window of current level
+ * @shaper: shaper context
+ * @now: current system ticks
+ *
+ * Caller needs to hold the tx_throttle mutex.
+ *
+ * Return: none
+ */
+static void ol_tx_shaper_level_done(struct ol_tx_shaper *shaper,
+				    unsigned long now)
+{
+	shaper->stats[shaper->level].active_ms +=
+		qdf_system_ticks_to_msecs(now - shaper->level_ts);
+	shaper->level_ts = now;
+}
+
+/**
+ * ol_tx_shaper_set_rate() - derive the token rate from the capacity
+ * @pdev: pdev handle
+ *
+ * The on/off phases of the shaped level are turned into a token rate,
+ * the fraction of the link capacity the on phase allows.
+ *
+ * Caller needs to hold the tx_throttle mutex.
+ *
+ * Return: none
+ */
+static void ol_tx_shaper_set_rate(struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_tx_shaper *shaper = &pdev->tx_throttle.shaper;
+	uint32_t on_ms = pdev->tx_throttle.throttle_time_ms[shaper->level]
+							[THROTTLE_PHASE_ON];
+	uint32_t period = pdev->tx_throttle.throttle_period_ms;
+	int grp;
+
+	shaper->rate = qdf_do_div((uint64_t)shaper->capacity *
+				  OL_TX_SHAPER_TICK_MS * on_ms,
+				  period ? period : 1);
+	shaper->depth = shaper->rate * OL_TX_SHAPER_BURST_TICKS;
+	for (grp = 0; grp < OL_TX_SHAPER_GRP_MAX; grp++)
+		shaper->floor[grp] = shaper->depth *
+				     ol_tx_shaper_reserve_pct[grp] / 100;
+}
+
+/**
+ * ol_tx_shaper_start() - shape tx to the duty cycle of a throttle level
+ * @pdev: pdev handle
+ * @level: throttle level
+ *
+ * Shaping needs the link capacity, the level is left to the on/off
+ * phase timer while no delivered tx rate has been sampled yet.
+ *
+ * Return: true if the level is enforced by the shaper
+ */
+static bool ol_tx_shaper_start(struct ol_txrx_pdev_t *pdev, int level)
+{
+	struct ol_tx_shaper *shaper = &pdev->tx_throttle.shaper;
+	unsigned long now = qdf_system_ticks();
+	bool was_active;
+
+	qdf_spin_lock_bh(&pdev->tx_throttle.mutex);
+	if (!shaper->capacity) {
+		qdf_spin_unlock_bh(&pdev->tx_throttle.mutex);
+		ol_txrx_info("tx shaper capacity unknown, level %d uses duty cycle",
+			     level);
+		return false;
+	}
+
+	was_active = shaper->active;
+	if (was_active)
+		ol_tx_shaper_level_done(shaper, now);
+
+	shaper->level = level;
+	shaper->level_ts = now;
+	ol_tx_shaper_set_rate(pdev);
+	if (!was_active)
+		shaper->tokens = shaper->rate;
+	shaper->active = true;
+	qdf_spin_unlock_bh(&pdev->tx_throttle.mutex);
+
+	ol_txrx_info("tx shaper level %d rate %u B/%dms depth %u capacity %u B/ms",
+		     level, shaper->rate, OL_TX_SHAPER_TICK_MS, shaper->depth,
+		     shaper->capacity);
+
+	/* leave a full pause of a previous level */
+	ol_txrx_throttle_unpause(pdev);
+	ol_txrx_thermal_unpause(pdev);
+
+	if (!was_active)
+		qdf_timer_start(&shaper->tick_timer, OL_TX_SHAPER_TICK_MS);
+
+	return true;
+}
+
+/**
+ * ol_tx_shaper_stop() - stop shaping and wake the held back queues
+ * @pdev: pdev handle
+ *
+ * Return: none
+ */
+static void ol_tx_shaper_stop(struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_tx_shaper *shaper = &pdev->tx_throttle.shaper;
+	unsigned long now = qdf_system_ticks();
+	uint8_t wake_map;
+
+	qdf_spin_lock_bh(&pdev->tx_throttle.mutex);
+	if (!shaper->active) {
+		qdf_spin_unlock_bh(&pdev->tx_throttle.mutex);
+		return;
+	}
+	shaper->active = false;
+	ol_tx_shaper_level_done(shaper, now);
+	wake_map = shaper->stopped;
+	ol_tx_shaper_release(shaper, wake_map, now);
+	ol_tx_shaper_set_queues(pdev, wake_map, true);
+	qdf_spin_unlock_bh(&pdev->tx_throttle.mutex);
+
+	qdf_timer_stop(&shaper->tick_timer);
+}
+
+/**
+ * ol_tx_shaper_update_capacity() - fold a delivered rate into the capacity
+ * @pdev: pdev handle
+ * @sample: delivered tx rate of the closed window in bytes per ms
+ *
+ * Unshaped, the capacity follows a rising rate immediately and decays
+ * slowly. While a level is shaped only windows in which a queue group
+ * was held back are used, the delivered rate then is the on phase share
+ * of what the link carries and is scaled back by the duty cycle. Small
+ * deviations are ignored so the estimate does not creep along with the
+ * rate it sets.
+ *
+ * Caller needs to hold the tx_throttle mutex.
+ *
+ * Return: none
+ */
+static void ol_tx_shaper_update_capacity(struct ol_txrx_pdev_t *pdev,
+					 uint32_t sample)
+{
+	struct ol_tx_shaper *shaper = &pdev->tx_throttle.shaper;
+	uint32_t on_ms, period, delta;
+
+	if (!shaper->active) {
+		/* the phase timer duty cycle caps the rate, nothing to learn */
+		if (pdev->tx_throttle.current_throttle_level !=
+		    THROTTLE_LEVEL_0)
+			return;
+		if (sample > shaper->capacity)
+			shaper->capacity = sample;
+		else
+			shaper->capacity -= (shaper->capacity - sample) >> 3;
+		return;
+	}
+
+	if (!shaper->win_held)
+		return;
+
+	on_ms = pdev->tx_throttle.throttle_time_ms[shaper->level]
+						   [THROTTLE_PHASE_ON];
+	period = pdev->tx_throttle.throttle_period_ms;
+	if (!on_ms)
+		return;
+
+	sample = qdf_do_div((uint64_t)sample * period, on_ms);
+	delta = sample > shaper->capacity ? sample - shaper->capacity :
+					    shaper->capacity - sample;
+	if (delta <= shaper->capacity >> OL_TX_SHAPER_CAPACITY_TOLERANCE)
+		return;
+
+	if (sample > shaper->capacity)
+		shaper->capacity += delta >> 3;
+	else
+		shaper->capacity -= delta >> 3;
+	ol_tx_shaper_set_rate(pdev);
+}
+
+void ol_tx_throttle_shaper_delivered(struct ol_txrx_pdev_t *pdev,
+				     uint32_t len)
+{
+	struct ol_tx_shaper *shaper = &pdev->tx_throttle.shaper;
+	unsigned long now = qdf_system_ticks();
+	uint32_t elapsed_ms, sample;
+
+	qdf_atomic_add(len, &shaper->win_bytes);
+	elapsed_ms = qdf_system_ticks_to_msecs(now - shaper->win_start);
+	if (qdf_likely(elapsed_ms < OL_TX_SHAPER_SAMPLE_MS))
+		return;
+
+	qdf_spin_lock_bh(&pdev->tx_throttle.mutex);
+	elapsed_ms = qdf_system_ticks_to_msecs(now - shaper->win_start);
+	if (elapsed_ms >= OL_TX_SHAPER_SAMPLE_MS) {
+		sample = (uint32_t)qdf_atomic_read(&shaper->win_bytes) /
+			 elapsed_ms;
+		ol_tx_shaper_update_capacity(pdev, sample);
+		qdf_atomic_set(&shaper->win_bytes, 0);
+		shaper->win_start = now;
+		shaper->win_held = !!shaper->stopped;
+	}
+	qdf_spin_unlock_bh(&pdev->tx_throttle.mutex);
+}
+
+void ol_tx_throttle_shaper_rehold(struct ol_txrx_pdev_t *pdev,
+				  uint8_t vdev_id)
+{
+	struct ol_tx_shaper *shaper = &pdev->tx_throttle.shaper;
+
+	if (qdf_likely(!shaper->active) || !pdev->pause_cb)
+		return;
+
+	qdf_spin_lock_bh(&pdev->tx_throttle.mutex);
+	if (shaper->active && shaper->stopped)
+		ol_tx_shaper_set_vdev_queues(pdev, vdev_id, shaper->stopped,
+					     false);
+	qdf_spin_unlock_bh(&pdev->tx_throttle.mutex);
+}
+
+void ol_tx_throttle_shaper_account(struct ol_txrx_pdev_t *pdev,
+				   qdf_nbuf_t nbuf)
+{
+	struct ol_tx_shaper *shaper = &pdev->tx_throttle.shaper;
+	uint32_t len = qdf_nbuf_len(nbuf);
+	struct ol_tx_shaper_level_stats *stats;
+	unsigned long now;
+	uint8_t stop_map = 0;
+	int grp;
+
+	if (qdf_likely(!shaper->active))
+		return;
+
+	qdf_spin_lock_bh(&pdev->tx_throttle.mutex);
+	if (!shaper->active) {
+		qdf_spin_unlock_bh(&pdev->tx_throttle.mutex);
+		return;
+	}
+
+	stats = &shaper->stats[shaper->level];
+	stats->bytes += len;
+	stats->frames++;
+	shaper->tokens -= len;
+
+	/* the frame itself is never dropped, its group may run into debt */
+	now = qdf_system_ticks();
+	for (grp = 0; grp < OL_TX_SHAPER_GRP_MAX; grp++) {
+		if ((shaper->stopped & (1 << grp)) ||
+		    shaper->tokens >= (int32_t)shaper->floor[grp])
+			continue;
+		stop_map |= 1 << grp;
+		shaper->stop_ts[grp] = now;
+		stats->stop_cnt[grp]++;
+	}
+	shaper->stopped |= stop_map;
+	if (shaper->stopped)
+		shaper->win_held = true;
+	ol_tx_shaper_set_queues(pdev, stop_map, false);
+	qdf_spin_unlock_bh(&pdev->tx_throttle.mutex);
+}
+
+void ol_tx_throttle_shaper_display(struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_tx_shaper *shaper = &pdev->tx_throttle.shaper;
+	struct ol_tx_shaper_level_stats *stats;
+	uint32_t active_ms;
+	int level, grp;
+
+	txrx_nofl_info("TX shaper: %s level %d capacity %u B/ms rate %u B/%dms tokens %d",
+		       shaper->active ? "active" : "idle", shaper->level,
+		       shaper->capacity, shaper->rate, OL_TX_SHAPER_TICK_MS,
+		       shaper->tokens);
+
+	for (level = THROTTLE_LEVEL_0; level < THROTTLE_LEVEL_MAX; level++) {
+		stats = &shaper->stats[level];
+		active_ms = stats->active_ms;
+		if (shaper->active && shaper->level == level)
+			active_ms += qdf_system_ticks_to_msecs(
+					qdf_system_ticks() - shaper->level_ts);
+		if (!active_ms)
+			continue;
+
+		txrx_nofl_info("level %d: %u ms %llu B %u frames %llu kbps",
+			       level, active_ms, stats->bytes, stats->frames,
+			       qdf_do_div(stats->bytes * 8, active_ms));
+		for (grp = 0; grp < OL_TX_SHAPER_GRP_MAX; grp++) {
+			if (!stats->stop_cnt[grp])
+				continue;
+			txrx_nofl_info("  %s held %u times, avg %u ms max %u ms",
+				       ol_tx_shaper_grp_str[grp],
+				       stats->stop_cnt[grp],
+				       stats->hold_ms[grp] /
+				       stats->stop_cnt[grp],
+				       stats->hold_max_ms[grp]);
+		}
+	}
+}
+
+void ol_tx_throttle_shaper_clear(struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_tx_shaper *shaper = &pdev->tx_throttle.shaper;
+
+	qdf_spin_lock_bh(&pdev->tx_throttle.mutex);
+	qdf_mem_zero(shaper->stats, sizeof(shaper->stats));
+	shaper->level_ts = qdf_system_ticks();
+	qdf_spin_unlock_bh(&pdev->tx_throttle.mutex);
+}
+
+/**
+ * ol_tx_shaper_init() - initialize the tx shaper
+ * @pdev: pdev handle
+ *
+ * Return: none
+ */
+static void ol_tx_shaper_init(struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_tx_shaper *shaper = &pdev->tx_throttle.shaper;
+
+	qdf_mem_zero(shaper, sizeof(*shaper));
+	qdf_atomic_init(&shaper->win_bytes);
+	shaper->win_start = qdf_system_ticks();
+	qdf_timer_init(pdev->osdev, &shaper->tick_timer,
+		       ol_tx_shaper_tick, pdev, QDF_TIMER_TYPE_SW);
+}
+
+void ol_tx_throttle_shaper_deinit(struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_tx_shaper *shaper = &pdev->tx_throttle.shaper;
+
+	qdf_spin_lock_bh(&pdev->tx_throttle.mutex);
+	shaper->active = false;
+	qdf_spin_unlock_bh(&pdev->tx_throttle.mutex);
+
+	qdf_timer_sync_cancel(&shaper->tick_timer);
+	qdf_timer_free(&shaper->tick_timer);
+}
+#else
+static inline bool ol_tx_shaper_start(struct ol_txrx_pdev_t *pdev, int level)
+{
+	return false;
+}
+
+static inline void ol_tx_shaper_stop(struct ol_txrx_pdev_t *pdev)
+{
+}
+
+static inline void ol_tx_shaper_init(struct ol_txrx_pdev_t *pdev)
+{
+}
+#endif
+
 static void ol_tx_pdev_throttle_phase_timer(void *context)
 {
 	struct ol_txrx_pdev_t *pdev = (struct ol_txrx_pdev_t *)context;
@@ -196,17 +717,30 @@ ol_tx_set_throttle_phase_time(struct ol_txrx_pdev_t *pdev, int level, int *ms)
 	phase_off_time =
 		pdev->tx_throttle.throttle_time_ms[level][THROTTLE_PHASE_OFF];
 	if (phase_on_time && phase_off_time) {
+		/*
+		 * duty cycle is enforced by the token bucket if available,
+		 * an active shaper moves to the new level without restarting
+		 */
+		if (ol_tx_shaper_start(pdev, level)) {
+			pdev->tx_throttle.current_throttle_phase =
+							THROTTLE_PHASE_ON;
+			*ms = 0;
+			return;
+		}
+		ol_tx_shaper_stop(pdev);
 		pdev->tx_throttle.current_throttle_phase = THROTTLE_PHASE_OFF;
 		*ms =
 		pdev->tx_throttle.throttle_time_ms[level][THROTTLE_PHASE_OFF];
 		ol_txrx_throttle_pause(pdev);
 		ol_txrx_thermal_pause(pdev);
 	} else if (!phase_off_time) {
+		ol_tx_shaper_stop(pdev);
 		pdev->tx_throttle.current_throttle_phase = THROTTLE_PHASE_OFF;
 		*ms = 0;
 		ol_txrx_throttle_unpause(pdev);
 		ol_txrx_thermal_unpause(pdev);
 	} else {
+		ol_tx_shaper_stop(pdev);
 		pdev->tx_throttle.current_throttle_phase = THROTTLE_PHASE_OFF;
 		*ms = 0;
 		ol_txrx_throttle_pause(pdev);
@@ -306,6 +840,7 @@ void ol_tx_throttle_init(struct ol_txrx_pdev_t *pdev)
 	qdf_timer_init(pdev->osdev, &pdev->tx_throttle.phase_timer,
 		       ol_tx_pdev_throttle_phase_timer, pdev,
 		       QDF_TIMER_TYPE_SW);
+	ol_tx_shaper_init(pdev);
 
 #ifdef QCA_LL_LEGACY_TX_FLOW_CONTROL
 	qdf_timer_init(pdev->osdev, &pdev->tx_throttle.tx_timer,
@@ -1427,6 +1427,7 @@ ol_txrx_pdev_post_attach(struct cdp_soc_t *soc_hdl, uint8_t pdev_id)
 	qdf_spinlock_create(&pdev->rx.mutex);
 	qdf_spinlock_create(&pdev->last_real_peer_mutex);
 	qdf_spinlock_create(&pdev->peer_map_unmap_lock);
+	qdf_spinlock_create(&pdev->vdev_list_lock);
 	OL_TXRX_PEER_STATS_MUTEX_INIT(pdev);
 
 	if (OL_RX_REORDER_TRACE_ATTACH(pdev) != A_OK) {
@@ -1567,6 +1568,7 @@ reorder_trace_attach_fail:
 	qdf_spinlock_destroy(&pdev->rx.mutex);
 	qdf_spinlock_destroy(&pdev->last_real_peer_mutex);
 	qdf_spinlock_destroy(&pdev->peer_map_unmap_lock);
+	qdf_spinlock_destroy(&pdev->vdev_list_lock);
 	OL_TXRX_PEER_STATS_MUTEX_DESTROY(pdev);
 
 control_init_fail:
@@ -1719,6 +1721,7 @@ static void ol_txrx_pdev_pre_detach(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
 	qdf_timer_stop(&pdev->tx_throttle.tx_timer);
 	qdf_timer_free(&pdev->tx_throttle.tx_timer);
 #endif
+	ol_tx_throttle_shaper_deinit(pdev);
 #endif
 
 	if (force) {
@@ -1771,6 +1774,7 @@ static void ol_txrx_pdev_pre_detach(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
 	qdf_spinlock_destroy(&pdev->last_real_peer_mutex);
 	qdf_spinlock_destroy(&pdev->rx.mutex);
 	qdf_spinlock_destroy(&pdev->peer_map_unmap_lock);
+	qdf_spinlock_destroy(&pdev->vdev_list_lock);
 #ifdef QCA_SUPPORT_TX_THROTTLE
 	/* Thermal Mitigation */
 	qdf_spinlock_destroy(&pdev->tx_throttle.mutex);
@@ -1982,6 +1986,7 @@ ol_txrx_vdev_attach(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
 #endif
 
 	ol_txrx_vdev_txqs_init(vdev);
+	ol_tx_peer_cache_init(vdev);
 
 	qdf_spinlock_create(&vdev->ll_pause.mutex);
 	vdev->ll_pause.paused_reason = 0;
@@ -2027,7 +2032,9 @@ ol_txrx_vdev_attach(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
 	ol_txrx_vdev_init_tcp_del_ack(vdev);
 
 	/* add this vdev into the pdev's list */
+	qdf_spin_lock_bh(&pdev->vdev_list_lock);
 	TAILQ_INSERT_TAIL(&pdev->vdev_list, vdev, vdev_list_elem);
+	qdf_spin_unlock_bh(&pdev->vdev_list_lock);
 	if (QDF_GLOBAL_MONITOR_MODE == cds_get_conparam())
 		pdev->monitor_vdev = vdev;
 
@@ -2241,7 +2248,12 @@ ol_txrx_vdev_detach(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 	qdf_spinlock_destroy(&vdev->flow_control_lock);
 
 	/* remove the vdev from its parent pdev's list */
+	qdf_spin_lock_bh(&pdev->vdev_list_lock);
 	TAILQ_REMOVE(&pdev->vdev_list, vdev, vdev_list_elem);
+	qdf_spin_unlock_bh(&pdev->vdev_list_lock);
+
+	/* release the peers held by the tx peer cache */
+	ol_tx_peer_cache_deinit(vdev);
 
 	/*
 	 * Use peer_ref_mutex while accessing peer_list, in case
@@ -3547,6 +3559,9 @@ static QDF_STATUS ol_txrx_peer_detach(struct cdp_soc_t *soc_hdl,
 
 	peer->valid = 0;
 
+	/* drop the tx peer cache references, they would keep it alive */
+	ol_tx_peer_cache_invalidate(vdev->pdev, peer);
+
 	/* flush all rx packets before clearing up the peer local_id */
 	ol_txrx_clear_peer_internal(peer);
 
@@ -4579,6 +4594,7 @@ static void ol_txrx_disp_peer_stats(ol_txrx_pdev_handle pdev)
 			txrx_nofl_info("stats: peer 0x%pK local peer id %d",
 				       peer, i);
 			ol_txrx_disp_peer_cached_bufq_stats(peer);
+			OL_RX_REORDER_TIMEOUT_PEER_DISPLAY(peer);
 			ol_txrx_peer_release_ref(peer,
 						 PEER_DEBUG_ID_OL_INTERNAL);
 		}
@@ -4695,6 +4711,8 @@ void ol_txrx_stats_display(ol_txrx_pdev_handle pdev,
 		       pdev->stats.pub.rx.intra_bss_fwd.packets_stack,
 		       pdev->stats.pub.rx.intra_bss_fwd.packets_fwd,
 		       pdev->stats.pub.rx.intra_bss_fwd.packets_stack_n_fwd);
+	ol_rx_fwd_stats_display(pdev);
+	OL_RX_REORDER_TIMEOUT_DISPLAY(pdev);
 
 	txrx_nofl_info("packets per HTT message:\n"
 		       "Single Packet  %d\n"
@@ -4714,12 +4732,15 @@ void ol_txrx_stats_display(ol_txrx_pdev_handle pdev,
 		       pdev->stats.pub.rx.rx_ind_histogram.pkts_51_60,
 		       pdev->stats.pub.rx.rx_ind_histogram.pkts_61_plus);
 
+	ol_tx_throttle_shaper_display(pdev);
 	ol_txrx_disp_peer_stats(pdev);
 }
 
 void ol_txrx_stats_clear(ol_txrx_pdev_handle pdev)
 {
 	qdf_mem_zero(&pdev->stats, sizeof(pdev->stats));
+	qdf_mem_zero(&pdev->rx_fwd_stats, sizeof(pdev->rx_fwd_stats));
+	ol_tx_throttle_shaper_clear(pdev);
 }
 
 #if defined(ENABLE_TXRX_PROT_ANALYZE)
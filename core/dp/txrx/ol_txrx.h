@@ -566,6 +566,17 @@ uint32_t ol_tx_get_total_free_desc(struct ol_txrx_pdev_t *pdev);
  */
 bool ol_txrx_fwd_desc_thresh_check(struct ol_txrx_vdev_t *txrx_vdev);
 
+/**
+ * ol_txrx_fwd_desc_budget() - descriptors available to intra-bss forwarding
+ * @txrx_vdev: vdev the frames are forwarded on
+ *
+ * Batched variant of ol_txrx_fwd_desc_thresh_check(): the pool is checked
+ * once per rx batch and the result is consumed frame by frame.
+ *
+ * Return: number of frames which may be forwarded, 0 to drop
+ */
+uint16_t ol_txrx_fwd_desc_budget(struct ol_txrx_vdev_t *txrx_vdev);
+
 /**
  * ol_tx_desc_thresh_reached() - is tx desc threshold reached
  * @soc_hdl: Datapath soc handle
@@ -606,6 +617,12 @@ bool ol_txrx_fwd_desc_thresh_check(struct ol_txrx_vdev_t *txrx_vdev)
 	return true;
 }
 
+static inline
+uint16_t ol_txrx_fwd_desc_budget(struct ol_txrx_vdev_t *txrx_vdev)
+{
+	return 0xffff;
+}
+
 #endif
 
 #if defined(FEATURE_HL_GROUP_CREDIT_FLOW_CONTROL) && \
@@ -105,6 +105,29 @@ bool ol_txrx_fwd_desc_thresh_check(struct ol_txrx_vdev_t *txrx_vdev)
 	return enough_desc_flag;
 }
 
+uint16_t ol_txrx_fwd_desc_budget(struct ol_txrx_vdev_t *txrx_vdev)
+{
+	struct ol_tx_flow_pool_t *pool;
+	uint16_t reserve;
+	uint16_t budget = 0;
+
+	if (!txrx_vdev)
+		return 0;
+
+	pool = txrx_vdev->pool;
+
+	if (!pool)
+		return 0;
+
+	qdf_spin_lock_bh(&pool->flow_pool_lock);
+	reserve = pool->stop_th + OL_TX_NON_FWD_RESERVE;
+	/* same limit as ol_txrx_fwd_desc_thresh_check() applied per frame */
+	if (pool->avail_desc >= reserve)
+		budget = pool->avail_desc - reserve + 1;
+	qdf_spin_unlock_bh(&pool->flow_pool_lock);
+	return budget;
+}
+
 /**
  * ol_tx_set_desc_global_pool_size() - set global pool size
  * @num_msdu_desc: total number of descriptors
@@ -154,6 +177,435 @@ uint32_t ol_tx_get_total_free_desc(struct ol_txrx_pdev_t *pdev)
 	return free_desc;
 }
 
+#ifdef QCA_LL_TX_FLOW_CONTROL_REBALANCE
+/* Rebalance period in ms */
+#define OL_TX_REBAL_PERIOD_MS		100
+/* Number of periods the descriptor drain of a pool is predicted ahead */
+#define OL_TX_REBAL_HORIZON		2
+/* Idle periods before borrowed descriptors are given back */
+#define OL_TX_REBAL_RECLAIM_IDLE	10
+/* EWMA weight of a new sample is 1 / (1 << OL_TX_REBAL_EWMA_SHIFT) */
+#define OL_TX_REBAL_EWMA_SHIFT		2
+/* Fractional bits of the demand and completion EWMAs */
+#define OL_TX_REBAL_FRAC_BITS		4
+/* Upper bound of descriptors moved into or out of a pool per period */
+#define OL_TX_REBAL_MAX_MOVE		128
+
+/**
+ * ol_tx_flow_pool_rebal_ewma() - update a fixed point per period EWMA
+ * @avg: average to update
+ * @sample: sample of the last period
+ *
+ * Return: none
+ */
+static inline void ol_tx_flow_pool_rebal_ewma(uint32_t *avg, uint32_t sample)
+{
+	int32_t diff = (int32_t)(sample << OL_TX_REBAL_FRAC_BITS) -
+		       (int32_t)*avg;
+
+	*avg += diff / (1 << OL_TX_REBAL_EWMA_SHIFT);
+}
+
+/**
+ * ol_tx_flow_pool_rebal_sample() - sample the demand of a pool
+ * @pool: flow pool
+ *
+ * Updates the allocation and completion rates of the pool and predicts
+ * how many descriptors it needs to stay above its start threshold over
+ * the next OL_TX_REBAL_HORIZON periods, or how many it can spare.
+ * In-flight descriptors are the owned descriptors not on the freelist,
+ * completions are derived from allocations and the in-flight delta so
+ * the tx completion path does not need an extra counter.
+ * Caller needs to hold the flow_pool_lock.
+ *
+ * Return: none
+ */
+static void ol_tx_flow_pool_rebal_sample(struct ol_tx_flow_pool_t *pool)
+{
+	struct ol_tx_flow_pool_rebal *rebal = &pool->rebal;
+	int32_t in_flight, compl;
+	uint32_t allocs, demand, drain, target, keep;
+
+	in_flight = (int32_t)pool->flow_pool_size - pool->deficient_desc -
+		    pool->avail_desc;
+	if (in_flight < 0)
+		in_flight = 0;
+
+	allocs = pool->alloc_cnt - rebal->alloc_snap;
+	compl = (int32_t)allocs + rebal->in_flight - in_flight;
+	if (compl < 0)
+		compl = 0;
+
+	rebal->alloc_snap = pool->alloc_cnt;
+	rebal->in_flight = in_flight;
+	ol_tx_flow_pool_rebal_ewma(&rebal->demand, allocs);
+	ol_tx_flow_pool_rebal_ewma(&rebal->compl, compl);
+
+	/* deficient descriptors may have been refilled from global pool */
+	if (rebal->lent_desc > pool->deficient_desc)
+		rebal->lent_desc = pool->deficient_desc;
+
+	rebal->need = 0;
+	rebal->spare = 0;
+	rebal->excess = 0;
+
+	if (pool->status == FLOW_POOL_INVALID ||
+	    pool->status == FLOW_POOL_INACTIVE ||
+	    pool->flow_pool_id == TX_FLOW_MGMT_POOL_ID)
+		return;
+
+	demand = rebal->demand >> OL_TX_REBAL_FRAC_BITS;
+	drain = rebal->demand > rebal->compl ?
+		(rebal->demand - rebal->compl) >> OL_TX_REBAL_FRAC_BITS : 0;
+	target = pool->start_th + drain * OL_TX_REBAL_HORIZON;
+	/* headroom for one period of allocations on top of the target */
+	keep = target + demand;
+
+	if (pool->avail_desc < target &&
+	    (allocs || pool->status != FLOW_POOL_ACTIVE_UNPAUSED)) {
+		rebal->need = QDF_MIN(target - pool->avail_desc + 1,
+				      OL_TX_REBAL_MAX_MOVE);
+		rebal->idle = 0;
+		return;
+	}
+
+	if (rebal->idle < OL_TX_REBAL_RECLAIM_IDLE)
+		rebal->idle++;
+
+	if (pool->status != FLOW_POOL_ACTIVE_UNPAUSED ||
+	    pool->avail_desc <= keep)
+		return;
+
+	if (rebal->borrowed_desc)
+		rebal->excess = QDF_MIN(pool->avail_desc - keep,
+					rebal->borrowed_desc);
+	else
+		rebal->spare = QDF_MIN(pool->avail_desc - keep,
+				       OL_TX_REBAL_MAX_MOVE);
+}
+
+/**
+ * ol_tx_flow_pool_rebal_wake() - wake netif queues after a pool got refilled
+ * @pdev: pdev handle
+ * @pool: flow pool
+ *
+ * Caller needs to hold the flow_pool_lock.
+ *
+ * Return: none
+ */
+static void ol_tx_flow_pool_rebal_wake(struct ol_txrx_pdev_t *pdev,
+				       struct ol_tx_flow_pool_t *pool)
+{
+	if (pool->status == FLOW_POOL_ACTIVE_PAUSED &&
+	    pool->avail_desc > pool->start_priority_th) {
+		pdev->pause_cb(pool->member_flow_id,
+			       WLAN_NETIF_PRIORITY_QUEUE_ON,
+			       WLAN_DATA_FLOW_CONTROL_PRIORITY);
+		pool->status = FLOW_POOL_NON_PRIO_PAUSED;
+	}
+
+	if (pool->status == FLOW_POOL_NON_PRIO_PAUSED &&
+	    pool->avail_desc > pool->start_th) {
+		pdev->pause_cb(pool->member_flow_id,
+			       WLAN_WAKE_NON_PRIORITY_QUEUE,
+			       WLAN_DATA_FLOW_CONTROL);
+		ol_tx_throttle_shaper_rehold(pdev, pool->member_flow_id);
+		pool->status = FLOW_POOL_ACTIVE_UNPAUSED;
+		ol_tx_flow_pool_pause_end(pool);
+	}
+}
+
+/**
+ * ol_tx_flow_pool_rebal_move() - lend or give back free descriptors
+ * @pdev: pdev handle
+ * @src_pool: source pool
+ * @dst_pool: destination pool
+ * @count: descriptors to move
+ * @lend: true to lend to @dst_pool, false to give borrowed ones back
+ *
+ * A lender keeps its size and records the lent descriptors as deficient,
+ * so the global pool refill path and the lazy reclaim both make it whole
+ * again. A borrower grows by the borrowed descriptors so the pool delete
+ * and invalid pool accounting stay consistent, while its thresholds stay
+ * based on the size firmware assigned.
+ * Caller needs to hold the flow_pool_list_lock.
+ *
+ * Return: descriptors moved
+ */
+static uint16_t ol_tx_flow_pool_rebal_move(struct ol_txrx_pdev_t *pdev,
+					   struct ol_tx_flow_pool_t *src_pool,
+					   struct ol_tx_flow_pool_t *dst_pool,
+					   uint16_t count, bool lend)
+{
+	union ol_tx_desc_list_elem_t *temp_list = NULL;
+	struct ol_tx_desc_t *tx_desc;
+	uint16_t i;
+
+	qdf_spin_lock_bh(&src_pool->flow_pool_lock);
+	count = QDF_MIN(count, src_pool->avail_desc);
+	if (!lend)
+		count = QDF_MIN(count, src_pool->rebal.borrowed_desc);
+
+	for (i = 0; i < count; i++) {
+		tx_desc = ol_tx_get_desc_flow_pool(src_pool);
+		((union ol_tx_desc_list_elem_t *)tx_desc)->next = temp_list;
+		temp_list = (union ol_tx_desc_list_elem_t *)tx_desc;
+	}
+
+	if (lend) {
+		src_pool->deficient_desc += count;
+		src_pool->rebal.lent_desc += count;
+	} else {
+		src_pool->flow_pool_size -= count;
+		src_pool->rebal.borrowed_desc -= count;
+	}
+	qdf_spin_unlock_bh(&src_pool->flow_pool_lock);
+
+	if (!count)
+		return 0;
+
+	qdf_spin_lock_bh(&dst_pool->flow_pool_lock);
+	while (temp_list) {
+		tx_desc = &temp_list->tx_desc;
+		temp_list = temp_list->next;
+		ol_tx_put_desc_flow_pool(dst_pool, tx_desc);
+	}
+
+	if (lend) {
+		dst_pool->flow_pool_size += count;
+		dst_pool->rebal.borrowed_desc += count;
+		pdev->pool_stats.rebal_lent += count;
+	} else {
+		dst_pool->deficient_desc -= QDF_MIN(dst_pool->deficient_desc,
+						    count);
+		dst_pool->rebal.lent_desc -= QDF_MIN(dst_pool->rebal.lent_desc,
+						     count);
+		pdev->pool_stats.rebal_reclaimed += count;
+	}
+	ol_tx_flow_pool_rebal_wake(pdev, dst_pool);
+	qdf_spin_unlock_bh(&dst_pool->flow_pool_lock);
+
+	return count;
+}
+
+/**
+ * ol_tx_flow_pool_rebal_arm() - arm the rebalance timer if worth running
+ * @pdev: pdev handle
+ *
+ * The rebalancer only runs while at least two pools can exchange
+ * descriptors. Caller needs to hold the flow_pool_list_lock.
+ *
+ * Return: none
+ */
+static void ol_tx_flow_pool_rebal_arm(struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_tx_flow_pool_t *pool;
+	uint8_t num_pools = 0;
+
+	if (pdev->tx_flow_rebal_armed || pdev->tx_flow_rebal_stopped)
+		return;
+
+	TAILQ_FOREACH(pool, &pdev->tx_desc.flow_pool_list,
+		      flow_pool_list_elem) {
+		if (pool->flow_pool_id != TX_FLOW_MGMT_POOL_ID)
+			num_pools++;
+	}
+
+	if (num_pools < 2)
+		return;
+
+	pdev->tx_flow_rebal_armed = true;
+	qdf_timer_mod(&pdev->tx_flow_rebal_timer, OL_TX_REBAL_PERIOD_MS);
+}
+
+/**
+ * ol_tx_flow_pool_rebalance() - redistribute descriptors based on demand
+ * @pdev: pdev handle
+ *
+ * Samples the demand of every pool, first gives borrowed descriptors back
+ * to lenders which need them again or once the borrower turned idle, then
+ * lends spare descriptors to pools predicted to pause within the horizon.
+ *
+ * Return: none
+ */
+static void ol_tx_flow_pool_rebalance(struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_tx_flow_pool_t *src_pool, *dst_pool;
+	uint16_t count, moved;
+
+	qdf_spin_lock_bh(&pdev->tx_desc.flow_pool_list_lock);
+	TAILQ_FOREACH(dst_pool, &pdev->tx_desc.flow_pool_list,
+		      flow_pool_list_elem) {
+		qdf_spin_lock_bh(&dst_pool->flow_pool_lock);
+		ol_tx_flow_pool_rebal_sample(dst_pool);
+		qdf_spin_unlock_bh(&dst_pool->flow_pool_lock);
+	}
+
+	/* lazy reclaim: borrowers give back what they no longer need */
+	TAILQ_FOREACH(dst_pool, &pdev->tx_desc.flow_pool_list,
+		      flow_pool_list_elem) {
+		if (!dst_pool->rebal.lent_desc)
+			continue;
+
+		TAILQ_FOREACH(src_pool, &pdev->tx_desc.flow_pool_list,
+			      flow_pool_list_elem) {
+			if (!dst_pool->rebal.lent_desc)
+				break;
+			if (!src_pool->rebal.excess ||
+			    (!dst_pool->rebal.need &&
+			     src_pool->rebal.idle < OL_TX_REBAL_RECLAIM_IDLE))
+				continue;
+
+			count = QDF_MIN(src_pool->rebal.excess,
+					dst_pool->rebal.lent_desc);
+			moved = ol_tx_flow_pool_rebal_move(pdev, src_pool,
+							   dst_pool, count,
+							   false);
+			src_pool->rebal.excess -= moved;
+			dst_pool->rebal.need -= QDF_MIN(dst_pool->rebal.need,
+							moved);
+		}
+	}
+
+	/* lend ahead of depletion */
+	TAILQ_FOREACH(dst_pool, &pdev->tx_desc.flow_pool_list,
+		      flow_pool_list_elem) {
+		TAILQ_FOREACH(src_pool, &pdev->tx_desc.flow_pool_list,
+			      flow_pool_list_elem) {
+			if (!dst_pool->rebal.need)
+				break;
+			if (src_pool == dst_pool || !src_pool->rebal.spare)
+				continue;
+
+			count = QDF_MIN(src_pool->rebal.spare,
+					dst_pool->rebal.need);
+			moved = ol_tx_flow_pool_rebal_move(pdev, src_pool,
+							   dst_pool, count,
+							   true);
+			src_pool->rebal.spare -= moved;
+			dst_pool->rebal.need -= moved;
+		}
+	}
+
+	pdev->tx_flow_rebal_armed = false;
+	ol_tx_flow_pool_rebal_arm(pdev);
+	qdf_spin_unlock_bh(&pdev->tx_desc.flow_pool_list_lock);
+}
+
+/**
+ * ol_tx_flow_pool_rebal_timer() - rebalance timer handler
+ * @arg: pdev handle
+ *
+ * Return: none
+ */
+static void ol_tx_flow_pool_rebal_timer(void *arg)
+{
+	ol_tx_flow_pool_rebalance((struct ol_txrx_pdev_t *)arg);
+}
+
+/**
+ * ol_tx_flow_pool_rebal_init() - initialize the descriptor rebalancer
+ * @pdev: pdev handle
+ *
+ * Return: none
+ */
+static void ol_tx_flow_pool_rebal_init(struct ol_txrx_pdev_t *pdev)
+{
+	pdev->tx_flow_rebal_armed = false;
+	pdev->tx_flow_rebal_stopped = false;
+	qdf_timer_init(pdev->osdev, &pdev->tx_flow_rebal_timer,
+		       ol_tx_flow_pool_rebal_timer, pdev, QDF_TIMER_TYPE_SW);
+}
+
+/**
+ * ol_tx_flow_pool_rebal_deinit() - stop the descriptor rebalancer
+ * @pdev: pdev handle
+ *
+ * Return: none
+ */
+static void ol_tx_flow_pool_rebal_deinit(struct ol_txrx_pdev_t *pdev)
+{
+	qdf_spin_lock_bh(&pdev->tx_desc.flow_pool_list_lock);
+	pdev->tx_flow_rebal_stopped = true;
+	qdf_spin_unlock_bh(&pdev->tx_desc.flow_pool_list_lock);
+
+	qdf_timer_sync_cancel(&pdev->tx_flow_rebal_timer);
+	qdf_timer_free(&pdev->tx_flow_rebal_timer);
+	pdev->tx_flow_rebal_armed = false;
+}
+
+/**
+ * ol_tx_flow_pool_rebal_detach() - write off descriptors lent by a pool
+ * @pool: flow pool being deleted
+ *
+ * Borrowers keep what they got, the descriptors return to the global pool
+ * once the borrowers are deleted. Caller needs to hold the flow_pool_lock.
+ *
+ * Return: none
+ */
+static void ol_tx_flow_pool_rebal_detach(struct ol_tx_flow_pool_t *pool)
+{
+	uint16_t lent = QDF_MIN(pool->rebal.lent_desc, pool->deficient_desc);
+
+	pool->flow_pool_size -= lent;
+	pool->deficient_desc -= lent;
+	pool->rebal.lent_desc = 0;
+}
+
+/**
+ * ol_tx_flow_pool_rebal_borrowed() - descriptors a pool borrowed
+ * @pool: flow pool
+ *
+ * Return: borrowed descriptors
+ */
+static inline uint16_t
+ol_tx_flow_pool_rebal_borrowed(struct ol_tx_flow_pool_t *pool)
+{
+	return pool->rebal.borrowed_desc;
+}
+
+/**
+ * ol_tx_flow_pool_rebal_dump() - dump rebalancer state of a pool
+ * @pool: copy of the flow pool
+ *
+ * Return: none
+ */
+static void ol_tx_flow_pool_rebal_dump(struct ol_tx_flow_pool_t *pool)
+{
+	txrx_nofl_info("rebalance: lent %d borrowed %d demand %u compl %u per %dms",
+		       pool->rebal.lent_desc, pool->rebal.borrowed_desc,
+		       pool->rebal.demand >> OL_TX_REBAL_FRAC_BITS,
+		       pool->rebal.compl >> OL_TX_REBAL_FRAC_BITS,
+		       OL_TX_REBAL_PERIOD_MS);
+}
+#else
+static inline void ol_tx_flow_pool_rebal_arm(struct ol_txrx_pdev_t *pdev)
+{
+}
+
+static inline void ol_tx_flow_pool_rebal_init(struct ol_txrx_pdev_t *pdev)
+{
+}
+
+static inline void ol_tx_flow_pool_rebal_deinit(struct ol_txrx_pdev_t *pdev)
+{
+}
+
+static inline void ol_tx_flow_pool_rebal_detach(struct ol_tx_flow_pool_t *pool)
+{
+}
+
+static inline uint16_t
+ol_tx_flow_pool_rebal_borrowed(struct ol_tx_flow_pool_t *pool)
+{
+	return 0;
+}
+
+static inline void ol_tx_flow_pool_rebal_dump(struct ol_tx_flow_pool_t *pool)
+{
+}
+#endif
+
 /**
  * ol_tx_register_flow_control() - Register fw based tx flow control
  * @pdev: pdev handle
@@ -164,6 +616,7 @@ void ol_tx_register_flow_control(struct ol_txrx_pdev_t *pdev)
 {
 	qdf_spinlock_create(&pdev->tx_desc.flow_pool_list_lock);
 	TAILQ_INIT(&pdev->tx_desc.flow_pool_list);
+	ol_tx_flow_pool_rebal_init(pdev);
 
 	if (!ol_tx_get_is_mgmt_over_wmi_enabled())
 		ol_tx_register_global_mgmt_pool(pdev);
@@ -181,6 +634,8 @@ void ol_tx_deregister_flow_control(struct ol_txrx_pdev_t *pdev)
 	struct ol_tx_flow_pool_t *pool = NULL;
 	struct cdp_soc_t *soc;
 
+	ol_tx_flow_pool_rebal_deinit(pdev);
+
 	if (!ol_tx_get_is_mgmt_over_wmi_enabled())
 		ol_tx_deregister_global_mgmt_pool(pdev);
 
@@ -243,6 +698,7 @@ static int ol_tx_delete_flow_pool(struct ol_tx_flow_pool_t *pool, bool force)
 	}
 
 	qdf_spin_lock_bh(&pool->flow_pool_lock);
+	ol_tx_flow_pool_rebal_detach(pool);
 	if (pool->avail_desc == pool->flow_pool_size || force == true)
 		pool->status = FLOW_POOL_INACTIVE;
 	else
@@ -418,6 +874,7 @@ void ol_tx_dump_flow_pool_info(struct cdp_soc_t *soc_hdl)
 	ol_txrx_pdev_handle pdev;
 	struct ol_tx_flow_pool_t *pool = NULL, *pool_prev = NULL;
 	struct ol_tx_flow_pool_t tmp_pool;
+	uint32_t paused_ms;
 
 	if (qdf_unlikely(!soc)) {
 		ol_txrx_err("soc is NULL");
@@ -442,6 +899,9 @@ void ol_tx_dump_flow_pool_info(struct cdp_soc_t *soc_hdl)
 		       pdev->pool_stats.pool_unmap_count,
 		       pdev->pool_stats.pool_resize_count,
 		       pdev->pool_stats.pkt_drop_no_pool);
+	txrx_nofl_info("rebalance lent %u reclaimed %u",
+		       pdev->pool_stats.rebal_lent,
+		       pdev->pool_stats.rebal_reclaimed);
 	/*
 	 * Nested spin lock.
 	 * Always take in below order.
@@ -473,6 +933,14 @@ void ol_tx_dump_flow_pool_info(struct cdp_soc_t *soc_hdl)
 			       tmp_pool.start_th, tmp_pool.stop_th,
 			       tmp_pool.start_priority_th,
 			       tmp_pool.stop_priority_th);
+		paused_ms = tmp_pool.paused_ms;
+		if (tmp_pool.pause_ts)
+			paused_ms += qdf_system_ticks_to_msecs(
+					qdf_system_ticks() - tmp_pool.pause_ts);
+		txrx_nofl_info("allocs %u :: pause events %u :: paused %u ms",
+			       tmp_pool.alloc_cnt, tmp_pool.pause_cnt,
+			       paused_ms);
+		ol_tx_flow_pool_rebal_dump(&tmp_pool);
 		pool_prev = pool;
 		qdf_spin_lock_bh(&pdev->tx_desc.flow_pool_list_lock);
 	}
@@ -493,6 +961,7 @@ void ol_tx_clear_flow_pool_stats(void)
 {
 	struct ol_txrx_soc_t *soc = cds_get_context(QDF_MODULE_ID_SOC);
 	ol_txrx_pdev_handle pdev;
+	struct ol_tx_flow_pool_t *pool;
 
 	if (qdf_unlikely(!soc))
 		return;
@@ -503,6 +972,18 @@ void ol_tx_clear_flow_pool_stats(void)
 		return;
 	}
 	qdf_mem_zero(&pdev->pool_stats, sizeof(pdev->pool_stats));
+
+	qdf_spin_lock_bh(&pdev->tx_desc.flow_pool_list_lock);
+	TAILQ_FOREACH(pool, &pdev->tx_desc.flow_pool_list,
+		      flow_pool_list_elem) {
+		qdf_spin_lock_bh(&pool->flow_pool_lock);
+		pool->pause_cnt = 0;
+		pool->paused_ms = 0;
+		if (pool->pause_ts)
+			pool->pause_ts = qdf_system_ticks();
+		qdf_spin_unlock_bh(&pool->flow_pool_lock);
+	}
+	qdf_spin_unlock_bh(&pdev->tx_desc.flow_pool_list_lock);
 }
 
 /**
@@ -607,9 +1088,12 @@ ol_tx_distribute_descs_to_deficient_pools(struct ol_tx_flow_pool_t *src_pool)
 					pdev->pause_cb(dst_pool->member_flow_id,
 						      WLAN_WAKE_ALL_NETIF_QUEUE,
 						      WLAN_DATA_FLOW_CONTROL);
+					ol_tx_throttle_shaper_rehold(pdev,
+						dst_pool->member_flow_id);
 
 					dst_pool->status =
 						FLOW_POOL_ACTIVE_UNPAUSED;
+					ol_tx_flow_pool_pause_end(dst_pool);
 				}
 			}
 		}
@@ -700,6 +1184,7 @@ struct ol_tx_flow_pool_t *ol_tx_create_flow_pool(uint8_t flow_pool_id,
 	qdf_spin_lock_bh(&pdev->tx_desc.flow_pool_list_lock);
 	TAILQ_INSERT_TAIL(&pdev->tx_desc.flow_pool_list, pool,
 			 flow_pool_list_elem);
+	ol_tx_flow_pool_rebal_arm(pdev);
 	qdf_spin_unlock_bh(&pdev->tx_desc.flow_pool_list_lock);
 
 	return pool;
@@ -886,6 +1371,7 @@ void ol_tx_flow_pool_map_handler(uint8_t flow_id, uint8_t flow_type,
 		pdev->pause_cb(flow_id,
 			       WLAN_WAKE_ALL_NETIF_QUEUE,
 			       WLAN_DATA_FLOW_CONTROL);
+		ol_tx_throttle_shaper_rehold(pdev, flow_id);
 		break;
 	default:
 		if (pool_create)
@@ -1029,8 +1515,11 @@ int ol_tx_distribute_descs_to_deficient_pools_from_global_pool(void)
 					pdev->pause_cb(dst_pool->member_flow_id,
 						      WLAN_WAKE_ALL_NETIF_QUEUE,
 						      WLAN_DATA_FLOW_CONTROL);
+					ol_tx_throttle_shaper_rehold(pdev,
+						dst_pool->member_flow_id);
 					dst_pool->status =
 						FLOW_POOL_ACTIVE_UNPAUSED;
+					ol_tx_flow_pool_pause_end(dst_pool);
 				}
 			} else if ((dst_pool->status == FLOW_POOL_INVALID) &&
 				   (dst_pool->avail_desc ==
@@ -1064,12 +1553,16 @@ static void ol_tx_flow_pool_update_queue_state(struct ol_txrx_pdev_t *pdev,
 	qdf_spin_lock_bh(&pool->flow_pool_lock);
 	if (pool->avail_desc > pool->start_th) {
 		pool->status = FLOW_POOL_ACTIVE_UNPAUSED;
+		ol_tx_flow_pool_pause_end(pool);
 		qdf_spin_unlock_bh(&pool->flow_pool_lock);
 		pdev->pause_cb(pool->member_flow_id,
 			       WLAN_WAKE_ALL_NETIF_QUEUE,
 			       WLAN_DATA_FLOW_CONTROL);
+		ol_tx_throttle_shaper_rehold(pdev, pool->member_flow_id);
 	} else if (pool->avail_desc < pool->stop_th &&
 		   pool->avail_desc >= pool->stop_priority_th) {
+		if (pool->status == FLOW_POOL_ACTIVE_UNPAUSED)
+			ol_tx_flow_pool_pause_start(pool);
 		pool->status = FLOW_POOL_NON_PRIO_PAUSED;
 		qdf_spin_unlock_bh(&pool->flow_pool_lock);
 		pdev->pause_cb(pool->member_flow_id,
@@ -1079,6 +1572,8 @@ static void ol_tx_flow_pool_update_queue_state(struct ol_txrx_pdev_t *pdev,
 			       WLAN_NETIF_PRIORITY_QUEUE_ON,
 			       WLAN_DATA_FLOW_CONTROL);
 	} else if (pool->avail_desc < pool->stop_priority_th) {
+		if (pool->status == FLOW_POOL_ACTIVE_UNPAUSED)
+			ol_tx_flow_pool_pause_start(pool);
 		pool->status = FLOW_POOL_ACTIVE_PAUSED;
 		qdf_spin_unlock_bh(&pool->flow_pool_lock);
 		pdev->pause_cb(pool->member_flow_id,
@@ -1167,6 +1662,8 @@ static void ol_tx_flow_pool_resize(struct ol_tx_flow_pool_t *pool,
 	}
 
 	qdf_spin_lock_bh(&pool->flow_pool_lock);
+	/* descriptors borrowed by the rebalancer stay on top of fw size */
+	new_pool_size += ol_tx_flow_pool_rebal_borrowed(pool);
 	if (pool->flow_pool_size == new_pool_size) {
 		qdf_spin_unlock_bh(&pool->flow_pool_lock);
 		ol_txrx_info("pool resize received with same size");
@@ -1406,6 +1903,7 @@ void ol_txrx_vdev_unpause(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 
 	pdev->pause_cb(vdev->vdev_id, WLAN_WAKE_ALL_NETIF_QUEUE,
 			netif_reason);
+	ol_tx_throttle_shaper_rehold(pdev, vdev->vdev_id);
 }
 
 /**
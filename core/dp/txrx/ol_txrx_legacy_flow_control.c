@@ -651,6 +651,9 @@ void ol_txrx_flow_control_cb(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 	if ((vdev->osif_flow_control_cb) && (vdev->osif_fc_ctx))
 		vdev->osif_flow_control_cb(vdev->osif_fc_ctx, tx_resume);
 	qdf_spin_unlock_bh(&vdev->flow_control_lock);
+
+	if (tx_resume)
+		ol_tx_throttle_shaper_rehold(vdev->pdev, vdev_id);
 }
 
 /**
@@ -22,6 +22,8 @@
 #include <osdep.h>              /* uint32_t, etc. */
 #include <qdf_mem.h>         /* qdf_mem_malloc, etc. */
 #include <qdf_types.h>          /* qdf_device_t, qdf_print */
+#include <qdf_time.h>           /* qdf_get_log_timestamp */
+#include <qdf_util.h>           /* qdf_get_cpu */
 /* header files for utilities */
 #include "queue.h"         /* TAILQ */
 
@@ -237,6 +239,153 @@ struct ol_txrx_peer_t *
 	return NULL;            /* failure */
 }
 
+#if defined(CONFIG_HL_SUPPORT)
+#if defined(TXRX_DEBUG_LEVEL) && TXRX_DEBUG_LEVEL > 5
+static inline uint64_t ol_tx_peer_cache_ts(void)
+{
+	return qdf_get_log_timestamp();
+}
+
+static inline void ol_tx_peer_cache_ticks(uint64_t *ticks, uint64_t start)
+{
+	*ticks += qdf_get_log_timestamp() - start;
+}
+#else
+static inline uint64_t ol_tx_peer_cache_ts(void)
+{
+	return 0;
+}
+
+static inline void ol_tx_peer_cache_ticks(uint64_t *ticks, uint64_t start)
+{
+}
+#endif
+
+struct ol_txrx_peer_t *
+ol_txrx_peer_find_hash_find_get_ref_cached(struct ol_txrx_vdev_t *vdev,
+					   enum ol_tx_peer_cache_type type,
+					   uint8_t *peer_mac_addr,
+					   enum peer_debug_id_type dbg_id)
+{
+	union ol_txrx_align_mac_addr_t mac_addr;
+	struct ol_tx_peer_cache_t *cache;
+	struct ol_txrx_peer_t *peer, *old;
+	uint64_t start;
+
+	qdf_mem_copy(&mac_addr.raw[0], peer_mac_addr, QDF_MAC_ADDR_SIZE);
+	start = ol_tx_peer_cache_ts();
+	cache = &vdev->tx_peer_cache[qdf_get_cpu() %
+				     OL_TX_PEER_CACHE_CPUS][type];
+
+	/*
+	 * The entry holds a reference on its peer, so the peer cannot be
+	 * freed while it is cached and a hit needs no peer_ref_mutex.
+	 */
+	qdf_spin_lock_bh(&cache->lock);
+	peer = cache->peer;
+	if (peer &&
+	    !ol_txrx_peer_find_mac_addr_cmp(&mac_addr, &cache->mac_addr) &&
+	    peer->valid) {
+		ol_txrx_peer_get_ref(peer, dbg_id);
+		cache->hits++;
+		ol_tx_peer_cache_ticks(&cache->hit_ticks, start);
+		qdf_spin_unlock_bh(&cache->lock);
+		return peer;
+	}
+	qdf_spin_unlock_bh(&cache->lock);
+
+	peer = ol_txrx_peer_find_hash_find_get_ref(vdev->pdev, mac_addr.raw,
+						   1, 1, dbg_id);
+	if (peer)
+		ol_txrx_peer_get_ref(peer, PEER_DEBUG_ID_OL_INTERNAL);
+
+	qdf_spin_lock_bh(&cache->lock);
+	old = NULL;
+	/*
+	 * ol_tx_peer_cache_invalidate() clears valid before it looks at the
+	 * entry, a peer detached since the hash walk is not cached.
+	 */
+	if (peer && peer->valid) {
+		old = cache->peer;
+		cache->mac_addr = mac_addr;
+		cache->peer = peer;
+	} else if (peer) {
+		old = peer;
+	}
+	cache->misses++;
+	ol_tx_peer_cache_ticks(&cache->miss_ticks, start);
+	qdf_spin_unlock_bh(&cache->lock);
+
+	if (old)
+		ol_txrx_peer_release_ref(old, PEER_DEBUG_ID_OL_INTERNAL);
+
+	return peer;
+}
+
+void ol_tx_peer_cache_init(struct ol_txrx_vdev_t *vdev)
+{
+	struct ol_tx_peer_cache_t *cache;
+	int cpu, type;
+
+	for (cpu = 0; cpu < OL_TX_PEER_CACHE_CPUS; cpu++) {
+		for (type = 0; type < OL_TX_PEER_CACHE_MAX; type++) {
+			cache = &vdev->tx_peer_cache[cpu][type];
+			qdf_spinlock_create(&cache->lock);
+		}
+	}
+}
+
+void ol_tx_peer_cache_deinit(struct ol_txrx_vdev_t *vdev)
+{
+	struct ol_tx_peer_cache_t *cache;
+	struct ol_txrx_peer_t *peer;
+	int cpu, type;
+
+	for (cpu = 0; cpu < OL_TX_PEER_CACHE_CPUS; cpu++) {
+		for (type = 0; type < OL_TX_PEER_CACHE_MAX; type++) {
+			cache = &vdev->tx_peer_cache[cpu][type];
+			qdf_spin_lock_bh(&cache->lock);
+			peer = cache->peer;
+			cache->peer = NULL;
+			qdf_spin_unlock_bh(&cache->lock);
+			qdf_spinlock_destroy(&cache->lock);
+
+			if (peer)
+				ol_txrx_peer_release_ref(
+					peer, PEER_DEBUG_ID_OL_INTERNAL);
+		}
+	}
+}
+
+void ol_tx_peer_cache_invalidate(struct ol_txrx_pdev_t *pdev,
+				 struct ol_txrx_peer_t *peer)
+{
+	struct ol_tx_peer_cache_t *cache;
+	struct ol_txrx_vdev_t *vdev;
+	int cpu, type, refs = 0;
+
+	/* a lookup on any vdev can cache the peer, e.g. the TDLS AP peer */
+	qdf_spin_lock_bh(&pdev->vdev_list_lock);
+	TAILQ_FOREACH(vdev, &pdev->vdev_list, vdev_list_elem) {
+		for (cpu = 0; cpu < OL_TX_PEER_CACHE_CPUS; cpu++) {
+			for (type = 0; type < OL_TX_PEER_CACHE_MAX; type++) {
+				cache = &vdev->tx_peer_cache[cpu][type];
+				qdf_spin_lock_bh(&cache->lock);
+				if (cache->peer == peer) {
+					cache->peer = NULL;
+					refs++;
+				}
+				qdf_spin_unlock_bh(&cache->lock);
+			}
+		}
+	}
+	qdf_spin_unlock_bh(&pdev->vdev_list_lock);
+
+	while (refs--)
+		ol_txrx_peer_release_ref(peer, PEER_DEBUG_ID_OL_INTERNAL);
+}
+#endif
+
 void
 ol_txrx_peer_find_hash_remove(struct ol_txrx_pdev_t *pdev,
 			      struct ol_txrx_peer_t *peer)
@@ -843,6 +992,62 @@ struct ol_txrx_peer_t *ol_txrx_assoc_peer_find(struct ol_txrx_vdev_t *vdev)
 /*=== function definitions for debug ========================================*/
 
 #if defined(TXRX_DEBUG_LEVEL) && TXRX_DEBUG_LEVEL > 5
+#if defined(CONFIG_HL_SUPPORT)
+/**
+ * ol_txrx_peer_cache_display() - show the HL tx peer cache stats of each vdev
+ * @pdev: physical device
+ * @indent: indentation
+ *
+ * Lookups served from the cache skip the peer hash walk, the time saved is
+ * estimated from the average cost of the lookups that walked it.
+ *
+ * Return: none
+ */
+static void ol_txrx_peer_cache_display(ol_txrx_pdev_handle pdev, int indent)
+{
+	struct ol_txrx_vdev_t *vdev;
+	struct ol_tx_peer_cache_t *cache;
+	uint64_t hits, misses, hit_ticks, miss_ticks, walk_ticks, saved;
+	int cpu, type;
+
+	TAILQ_FOREACH(vdev, &pdev->vdev_list, vdev_list_elem) {
+		hits = 0;
+		misses = 0;
+		hit_ticks = 0;
+		miss_ticks = 0;
+		for (cpu = 0; cpu < OL_TX_PEER_CACHE_CPUS; cpu++) {
+			for (type = 0; type < OL_TX_PEER_CACHE_MAX; type++) {
+				cache = &vdev->tx_peer_cache[cpu][type];
+				hits += cache->hits;
+				misses += cache->misses;
+				hit_ticks += cache->hit_ticks;
+				miss_ticks += cache->miss_ticks;
+			}
+		}
+
+		saved = 0;
+		if (misses) {
+			walk_ticks = hits * qdf_do_div(miss_ticks,
+						       (uint32_t)misses);
+			if (walk_ticks > hit_ticks)
+				saved = walk_ticks - hit_ticks;
+		}
+
+		QDF_TRACE(QDF_MODULE_ID_TXRX, QDF_TRACE_LEVEL_INFO_LOW,
+			  "%*svdev %d tx peer cache: hits %llu misses %llu (%llu%% hit), log timestamp ticks saved %llu\n",
+			  indent, " ", vdev->vdev_id, hits, misses,
+			  hits + misses ? qdf_do_div(hits * 100,
+						     (uint32_t)(hits + misses)) :
+			  0, saved);
+	}
+}
+#else
+static inline void ol_txrx_peer_cache_display(ol_txrx_pdev_handle pdev,
+					      int indent)
+{
+}
+#endif
+
 void ol_txrx_peer_find_display(ol_txrx_pdev_handle pdev, int indent)
 {
 	int i, max_peers;
@@ -874,6 +1079,7 @@ void ol_txrx_peer_find_display(ol_txrx_pdev_handle pdev, int indent)
 			}
 		}
 	}
+	ol_txrx_peer_cache_display(pdev, indent);
 }
 
 #endif /* if TXRX_DEBUG_LEVEL */
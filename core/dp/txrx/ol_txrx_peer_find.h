@@ -103,6 +103,71 @@ struct ol_txrx_peer_t *
 				u8 check_valid,
 				enum peer_debug_id_type dbg_id);
 
+#if defined(CONFIG_HL_SUPPORT)
+/**
+ * ol_txrx_peer_find_hash_find_get_ref_cached() - find a valid peer by MAC
+ *	address through the vdev's per-CPU last peer cache
+ * @vdev: vdev doing the lookup
+ * @type: cache entry to use, multicast self peer or unicast lookup
+ * @peer_mac_addr: unaligned peer MAC address
+ * @dbg_id: debug id of the reference taken
+ *
+ * Same as ol_txrx_peer_find_hash_find_get_ref() with check_valid set, but
+ * back to back lookups of the same address skip the peer hash walk.
+ *
+ * Return: peer with a reference taken, or NULL
+ */
+struct ol_txrx_peer_t *
+ol_txrx_peer_find_hash_find_get_ref_cached(struct ol_txrx_vdev_t *vdev,
+					   enum ol_tx_peer_cache_type type,
+					   uint8_t *peer_mac_addr,
+					   enum peer_debug_id_type dbg_id);
+
+/**
+ * ol_tx_peer_cache_init() - set up a vdev's HL tx peer cache
+ * @vdev: vdev being attached
+ *
+ * Return: none
+ */
+void ol_tx_peer_cache_init(struct ol_txrx_vdev_t *vdev);
+
+/**
+ * ol_tx_peer_cache_deinit() - drop the peers cached by a vdev's HL tx
+ *	classify and tear the cache down
+ * @vdev: vdev being detached, already removed from the pdev vdev list
+ *
+ * Return: none
+ */
+void ol_tx_peer_cache_deinit(struct ol_txrx_vdev_t *vdev);
+
+/**
+ * ol_tx_peer_cache_invalidate() - drop a peer from every vdev's HL tx
+ *	peer cache
+ * @pdev: physical device
+ * @peer: peer being detached, its valid flag already cleared
+ *
+ * Releases the references the cache entries hold on @peer, so that its
+ * deletion is not held up by a stale entry.
+ *
+ * Return: none
+ */
+void ol_tx_peer_cache_invalidate(struct ol_txrx_pdev_t *pdev,
+				 struct ol_txrx_peer_t *peer);
+#else
+static inline void ol_tx_peer_cache_init(struct ol_txrx_vdev_t *vdev)
+{
+}
+
+static inline void ol_tx_peer_cache_deinit(struct ol_txrx_vdev_t *vdev)
+{
+}
+
+static inline void ol_tx_peer_cache_invalidate(struct ol_txrx_pdev_t *pdev,
+					       struct ol_txrx_peer_t *peer)
+{
+}
+#endif
+
 struct
 ol_txrx_peer_t *ol_txrx_peer_vdev_find_hash(struct ol_txrx_pdev_t *pdev,
 					    struct ol_txrx_vdev_t *vdev,
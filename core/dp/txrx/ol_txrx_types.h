@@ -152,6 +152,58 @@ struct tx_peer_threshold {
 	u_int32_t tput_thresh;
 	u_int32_t tx_limit;
 };
+
+/* length of a tx completion rate estimation window */
+#define OL_TX_PEER_BAL_WIN_MS		100
+/* completions a window needs before the peer is judged on it */
+#define OL_TX_PEER_BAL_MIN_MSDUS	16
+/* threshold level used until the target reports the PHY mode of a peer */
+#define OL_TX_PEER_BAL_DEFAULT_PHY	TXRX_IEEE11_N
+
+/**
+ * struct ol_tx_peer_bal_est_t - tx completion rate estimate of a peer
+ * @win_start_ms: time of the first completion of the current window
+ * @last_comp_ms: time of the last tx completion
+ * @win_bytes: bytes acked in the current window
+ * @win_msdus: MSDUs completed in the current window
+ * @win_min_inflight: fewest MSDUs held by the target in the current window
+ * @tput: smoothed acked throughput in kbps, same unit as the target
+ *	  rate report
+ * @dl_msdus: MSDUs downloaded to the target, written by the scheduler
+ * @comp_msdus: MSDUs completed by the target
+ * @limit: in flight MSDU budget of the peer while it is limited
+ * @phy: PHY level from the last target link status report
+ * @phy_valid: @phy has been reported by the target
+ *
+ * Written from the tx completion context, except @dl_msdus, @limit, @phy
+ * and @phy_valid which are written under tx_peer_bal.mutex.
+ */
+struct ol_tx_peer_bal_est_t {
+	u_int32_t win_start_ms;
+	u_int32_t last_comp_ms;
+	u_int32_t win_bytes;
+	u_int16_t win_msdus;
+	u_int32_t win_min_inflight;
+	u_int32_t tput;
+	u_int32_t dl_msdus;
+	u_int32_t comp_msdus;
+	u_int16_t limit;
+	u_int8_t phy;
+	bool phy_valid;
+};
+
+/**
+ * enum ol_tx_peer_bal_verdict - outcome of a tx completion rate estimate
+ * @OL_TX_PEER_BAL_KEEP: leave the peer as it is
+ * @OL_TX_PEER_BAL_LIMIT: peer acked throughput fell below its threshold
+ *	while it never held fewer target descriptors than its limit
+ * @OL_TX_PEER_BAL_RELEASE: limited peer recovered above its threshold
+ */
+enum ol_tx_peer_bal_verdict {
+	OL_TX_PEER_BAL_KEEP,
+	OL_TX_PEER_BAL_LIMIT,
+	OL_TX_PEER_BAL_RELEASE,
+};
 #endif
 
 
@@ -199,6 +251,11 @@ struct ol_tx_desc_t {
 
 	void *txq;
 
+#if defined(CONFIG_HL_SUPPORT) && defined(QCA_BAD_PEER_TX_FLOW_CL)
+	/* peer whose tx limit budget the completion returns to */
+	u_int16_t bal_peer_id;
+#endif
+
 #ifdef QCA_SUPPORT_SW_TXRX_ENCAP
 	/*
 	 * used by tx encap, to restore the os buf start offset
@@ -234,6 +291,17 @@ union ol_txrx_align_mac_addr_t {
 	} align4;
 };
 
+/**
+ * struct ol_rx_reorder_timeout_list_elem_t - rx reorder timeout of a peer TID
+ * @reorder_timeout_list_elem: link in a timing wheel slot or the expired list
+ * @timestamp_ms: expiration time
+ * @peer: peer the TID belongs to
+ * @tid: TID
+ * @active: armed, linked in the wheel slot @slot
+ * @expired: expired, linked in the expired list waiting to be flushed
+ * @slot: timing wheel slot while @active
+ * @flush_cnt: number of reorder flushes done on timeout
+ */
 struct ol_rx_reorder_timeout_list_elem_t {
 	TAILQ_ENTRY(ol_rx_reorder_timeout_list_elem_t)
 	reorder_timeout_list_elem;
@@ -241,6 +309,9 @@ struct ol_rx_reorder_timeout_list_elem_t {
 	struct ol_txrx_peer_t *peer;
 	uint8_t tid;
 	uint8_t active;
+	uint8_t expired;
+	uint8_t slot;
+	uint32_t flush_cnt;
 };
 
 /* wait on peer deletion timeout value in milliseconds */
@@ -291,11 +362,41 @@ A_COMPILE_TIME_ASSERT(ol_tx_sched_htt_ac_values,
 	((int)OL_TX_SCHED_WRR_ADV_CAT_MCAST_MGMT
 		== (int)HTT_AC_EXT_MCAST_MGMT));
 
+/* rx reorder timeout wheel, must cover the longest per-AC timeout */
+#define OL_RX_REORDER_TIMEOUT_TICK_MS		10
+#define OL_RX_REORDER_TIMEOUT_WHEEL_SLOTS	32
+#define OL_RX_REORDER_TIMEOUT_WHEEL_MASK \
+	(OL_RX_REORDER_TIMEOUT_WHEEL_SLOTS - 1)
+
+TAILQ_HEAD(ol_rx_reorder_timeout_list_t, ol_rx_reorder_timeout_list_elem_t);
+
+/**
+ * struct ol_tx_reorder_cat_timeout_t - rx reorder timeouts of an AC
+ * @wheel: timing wheel, slot i ahead of @cursor_slot holds the timeouts
+ *	expiring within OL_RX_REORDER_TIMEOUT_TICK_MS before @cursor_ms plus
+ *	i ticks, the last slot also holds the ones beyond the wheel
+ * @expired_list: expired timeouts waiting to be flushed
+ * @cursor_slot: slot of the current tick
+ * @cursor_ms: end of the current tick
+ * @num_armed: number of timeouts in @wheel
+ * @timer: fires on the first non empty tick
+ * @duration_ms: reorder timeout
+ * @pdev: physical device
+ * @flush_cnt: number of reorder flushes done on timeout
+ * @max_batch: largest number of timeouts expiring in one timer run
+ */
 struct ol_tx_reorder_cat_timeout_t {
-	TAILQ_HEAD(, ol_rx_reorder_timeout_list_elem_t) virtual_timer_list;
+	struct ol_rx_reorder_timeout_list_t
+		wheel[OL_RX_REORDER_TIMEOUT_WHEEL_SLOTS];
+	struct ol_rx_reorder_timeout_list_t expired_list;
+	uint32_t cursor_slot;
+	uint32_t cursor_ms;
+	uint32_t num_armed;
 	qdf_timer_t timer;
 	uint32_t duration_ms;
 	struct ol_txrx_pdev_t *pdev;
+	uint32_t flush_cnt;
+	uint32_t max_batch;
 };
 
 enum ol_tx_scheduler_status {
@@ -424,6 +525,76 @@ enum throttle_phase {
 
 #define THROTTLE_TX_THRESHOLD (100)
 
+#ifdef QCA_LL_TX_THROTTLE_SHAPER
+/**
+ * enum ol_tx_shaper_grp - netif queue groups controlled by the tx shaper
+ * @OL_TX_SHAPER_GRP_VO: voice queues
+ * @OL_TX_SHAPER_GRP_VI: video queues
+ * @OL_TX_SHAPER_GRP_BE_BK: best effort and background queues
+ * @OL_TX_SHAPER_GRP_MAX: number of queue groups
+ */
+enum ol_tx_shaper_grp {
+	OL_TX_SHAPER_GRP_VO,
+	OL_TX_SHAPER_GRP_VI,
+	OL_TX_SHAPER_GRP_BE_BK,
+	OL_TX_SHAPER_GRP_MAX
+};
+
+/**
+ * struct ol_tx_shaper_level_stats - tx shaper statistics of a throttle level
+ * @active_ms: time spent shaping at this level
+ * @bytes: bytes sent while shaping at this level
+ * @frames: frames sent while shaping at this level
+ * @stop_cnt: number of times a queue group was held back
+ * @hold_ms: total time a queue group was held back
+ * @hold_max_ms: longest time a queue group was held back
+ */
+struct ol_tx_shaper_level_stats {
+	uint32_t active_ms;
+	uint64_t bytes;
+	uint32_t frames;
+	uint32_t stop_cnt[OL_TX_SHAPER_GRP_MAX];
+	uint32_t hold_ms[OL_TX_SHAPER_GRP_MAX];
+	uint32_t hold_max_ms[OL_TX_SHAPER_GRP_MAX];
+};
+
+/**
+ * struct ol_tx_shaper - token bucket enforcing the thermal duty cycle
+ * @tick_timer: token refill timer
+ * @active: shaper is enforcing a throttle level
+ * @level: throttle level being enforced
+ * @tokens: available tokens in bytes, negative when in debt
+ * @rate: tokens added per refill tick
+ * @depth: bucket depth in bytes
+ * @floor: token level below which a queue group is held back
+ * @capacity: estimated unthrottled tx rate in bytes per ms, 0 if unknown
+ * @win_bytes: bytes delivered in the current capacity sampling window
+ * @win_start: system ticks at start of the capacity sampling window
+ * @win_held: a queue group was held back in the current sampling window
+ * @stopped: bitmap of queue groups currently held back
+ * @stop_ts: system ticks when a queue group was held back
+ * @level_ts: system ticks when shaping at @level started
+ * @stats: per throttle level statistics
+ */
+struct ol_tx_shaper {
+	qdf_timer_t tick_timer;
+	bool active;
+	enum throttle_level level;
+	int32_t tokens;
+	uint32_t rate;
+	uint32_t depth;
+	uint32_t floor[OL_TX_SHAPER_GRP_MAX];
+	uint32_t capacity;
+	qdf_atomic_t win_bytes;
+	unsigned long win_start;
+	bool win_held;
+	uint8_t stopped;
+	unsigned long stop_ts[OL_TX_SHAPER_GRP_MAX];
+	unsigned long level_ts;
+	struct ol_tx_shaper_level_stats stats[THROTTLE_LEVEL_MAX];
+};
+#endif
+
 /*
  * Threshold to stop/start priority queue in term of % the actual flow start
  * and stop thresholds. When num of available descriptors falls below
@@ -484,14 +655,49 @@ enum flow_pool_status {
  * @pool_unmap_count: flow pool unmap received
  * @pool_resize_count: flow pool resize command received
  * @pkt_drop_no_pool: packets dropped due to unavailablity of pool
+ * @rebal_lent: descriptors lent to busy pools by the rebalancer
+ * @rebal_reclaimed: descriptors reclaimed back to lending pools
  */
 struct ol_txrx_pool_stats {
 	uint16_t pool_map_count;
 	uint16_t pool_unmap_count;
 	uint16_t pool_resize_count;
 	uint16_t pkt_drop_no_pool;
+	uint32_t rebal_lent;
+	uint32_t rebal_reclaimed;
 };
 
+#ifdef QCA_LL_TX_FLOW_CONTROL_REBALANCE
+/**
+ * struct ol_tx_flow_pool_rebal - per pool demand tracking of the rebalancer
+ * @alloc_snap: alloc_cnt of the pool at the previous rebalance period
+ * @in_flight: descriptors in flight at the previous rebalance period
+ * @demand: EWMA of descriptor allocations per period, fixed point
+ * @compl: EWMA of descriptor completions per period, fixed point
+ * @lent_desc: descriptors lent to other pools and not yet reclaimed
+ * @borrowed_desc: descriptors borrowed from other pools
+ * @idle: consecutive periods the pool did not need extra descriptors
+ * @need: descriptors needed to stay unpaused over the prediction horizon
+ * @spare: descriptors which can be lent without risking a pause
+ * @excess: borrowed descriptors not needed over the prediction horizon
+ *
+ * @lent_desc and @borrowed_desc are protected by the flow_pool_lock, the
+ * remaining fields are only accessed from the rebalance timer.
+ */
+struct ol_tx_flow_pool_rebal {
+	uint32_t alloc_snap;
+	uint16_t in_flight;
+	uint32_t demand;
+	uint32_t compl;
+	uint16_t lent_desc;
+	uint16_t borrowed_desc;
+	uint8_t idle;
+	uint16_t need;
+	uint16_t spare;
+	uint16_t excess;
+};
+#endif
+
 /**
  * struct ol_tx_flow_pool_t - flow_pool info
  * @flow_pool_list_elem: flow_pool_list element
@@ -511,6 +717,11 @@ struct ol_txrx_pool_stats {
  * @ref_cnt: pool's ref count
  * @stop_priority_th: Threshold to stop priority queue
  * @start_priority_th: Threshold to start priority queue
+ * @alloc_cnt: descriptors allocated from the pool
+ * @pause_cnt: number of times the pool paused the netif queues
+ * @pause_ts: system ticks when the pool last paused, 0 if not paused
+ * @paused_ms: total time in ms the pool kept the netif queues paused
+ * @rebal: demand tracking state of the descriptor rebalancer
  */
 struct ol_tx_flow_pool_t {
 	TAILQ_ENTRY(ol_tx_flow_pool_t) flow_pool_list_elem;
@@ -530,9 +741,48 @@ struct ol_tx_flow_pool_t {
 	qdf_atomic_t ref_cnt;
 	uint16_t stop_priority_th;
 	uint16_t start_priority_th;
+	uint32_t alloc_cnt;
+	uint32_t pause_cnt;
+	unsigned long pause_ts;
+	uint32_t paused_ms;
+#ifdef QCA_LL_TX_FLOW_CONTROL_REBALANCE
+	struct ol_tx_flow_pool_rebal rebal;
+#endif
 };
 #endif
 
+/**
+ * struct ol_rx_fwd_stats - intra-BSS forwarding fast path statistics
+ * @batches: rx batches which forwarded at least one frame
+ * @msdus: frames handed to the tx path
+ * @max_batch: largest number of frames forwarded in one batch
+ * @clones: multicast echoes served by a clone of the rx frame
+ * @copies: multicast echoes which needed a full copy
+ * @desc_drops: frames dropped as the tx descriptor budget was used up
+ * @tx_rejects: frames not accepted by the tx path
+ * @cost_ts: log timestamp ticks spent in batches that forwarded frames
+ * @pps: forwarded frames per second over the last rate window
+ * @cost_ns: average cost per forwarded frame over the last rate window
+ * @rate_ts: system ticks at the start of the rate window
+ * @rate_msdus: @msdus at the start of the rate window
+ * @rate_cost_ts: @cost_ts at the start of the rate window
+ */
+struct ol_rx_fwd_stats {
+	uint64_t batches;
+	uint64_t msdus;
+	uint32_t max_batch;
+	uint64_t clones;
+	uint64_t copies;
+	uint64_t desc_drops;
+	uint64_t tx_rejects;
+	uint64_t cost_ts;
+	uint32_t pps;
+	uint32_t cost_ns;
+	unsigned long rate_ts;
+	uint64_t rate_msdus;
+	uint64_t rate_cost_ts;
+};
+
 #define OL_TXRX_INVALID_PEER_UNMAP_COUNT 0xF
 /*
  * struct ol_txrx_peer_id_map - Map of firmware peer_ids to peers on host
@@ -726,6 +976,8 @@ struct ol_txrx_pdev_t {
 
 	/* ol_txrx_vdev list */
 	TAILQ_HEAD(, ol_txrx_vdev_t) vdev_list;
+	/* protects vdev_list against walks from timer context */
+	qdf_spinlock_t vdev_list_lock;
 
 	/* Inactive peer list */
 	TAILQ_HEAD(, ol_txrx_peer_t) inactive_peer_list;
@@ -826,6 +1078,12 @@ struct ol_txrx_pdev_t {
 #ifdef QCA_LL_TX_FLOW_GLOBAL_MGMT_POOL
 	struct ol_tx_flow_pool_t *mgmt_pool;
 #endif
+#ifdef QCA_LL_TX_FLOW_CONTROL_REBALANCE
+	/* periodic demand driven descriptor redistribution across pools */
+	qdf_timer_t tx_flow_rebal_timer;
+	bool tx_flow_rebal_armed;
+	bool tx_flow_rebal_stopped;
+#endif
 #endif
 
 	struct {
@@ -890,6 +1148,8 @@ struct ol_txrx_pdev_t {
 		struct ol_txrx_stats pub;
 	} stats;
 
+	struct ol_rx_fwd_stats rx_fwd_stats;
+
 #if defined(ENABLE_RX_REORDER_TRACE)
 	struct {
 		uint32_t mask;
@@ -1034,6 +1294,10 @@ struct ol_txrx_pdev_t {
 		bool is_paused;
 		/* Save outstanding packet number */
 		uint16_t prev_outstanding_num;
+#ifdef QCA_LL_TX_THROTTLE_SHAPER
+		/* rate based shaping used instead of the on/off phases */
+		struct ol_tx_shaper shaper;
+#endif
 	} tx_throttle;
 
 #if defined(FEATURE_TSO)
@@ -1057,7 +1321,10 @@ struct ol_txrx_pdev_t {
 	struct {
 		enum ol_tx_peer_bal_state enabled;
 		qdf_spinlock_t mutex;
-		/* timer used to trigger more frames for bad peers */
+		/*
+		 * Limited peers get their budget back on tx completion,
+		 * this timer only tops up peers starved of completions
+		 */
 		qdf_timer_t peer_bal_timer;
 		/*This is the time in ms of the peer balance timer period */
 		u_int32_t peer_bal_period_ms;
@@ -1186,6 +1453,51 @@ struct tcp_del_ack_hash_node {
 	struct tcp_stream_node *head;
 };
 
+/**
+ * enum ol_tx_peer_cache_type - HL tx peer cache entry used by a lookup
+ * @OL_TX_PEER_CACHE_UCAST: unicast destination and TDLS AP lookups
+ * @OL_TX_PEER_CACHE_MCAST: self peer lookups of multicast frames
+ * @OL_TX_PEER_CACHE_MAX: number of cache entries per CPU
+ *
+ * Mixed unicast and multicast traffic would otherwise evict the other
+ * kind's entry on every switch.
+ */
+enum ol_tx_peer_cache_type {
+	OL_TX_PEER_CACHE_UCAST,
+	OL_TX_PEER_CACHE_MCAST,
+	OL_TX_PEER_CACHE_MAX
+};
+
+/*
+ * Number of HL tx peer cache entries of each type per vdev, CPUs beyond it
+ * share entries.
+ */
+#define OL_TX_PEER_CACHE_CPUS 8
+
+/**
+ * struct ol_tx_peer_cache_t - last peer found by a vdev's HL tx classify
+ * @lock: serializes the CPUs sharing the entry with the peer invalidation
+ * @mac_addr: destination looked up
+ * @peer: peer found for @mac_addr, the entry holds a
+ *	PEER_DEBUG_ID_OL_INTERNAL reference on it until the peer is
+ *	detached or the entry is replaced
+ * @hits: lookups served from the cache
+ * @misses: lookups that walked the peer hash
+ * @hit_ticks: time spent in lookups served from the cache, only
+ *	measured with TXRX_DEBUG_LEVEL > 5
+ * @miss_ticks: time spent in lookups that walked the peer hash, only
+ *	measured with TXRX_DEBUG_LEVEL > 5
+ */
+struct ol_tx_peer_cache_t {
+	qdf_spinlock_t lock;
+	union ol_txrx_align_mac_addr_t mac_addr;
+	struct ol_txrx_peer_t *peer;
+	uint32_t hits;
+	uint32_t misses;
+	uint64_t hit_ticks;
+	uint64_t miss_ticks;
+};
+
 struct ol_txrx_vdev_t {
 	struct ol_txrx_pdev_t *pdev; /* pdev - the physical device that is
 				      * the parent of this virtual device
@@ -1258,6 +1570,8 @@ struct ol_txrx_vdev_t {
 
 #if defined(CONFIG_HL_SUPPORT)
 	struct ol_tx_frms_queue_t txqs[OL_TX_VDEV_NUM_QUEUES];
+	struct ol_tx_peer_cache_t
+		tx_peer_cache[OL_TX_PEER_CACHE_CPUS][OL_TX_PEER_CACHE_MAX];
 #endif
 
 	struct {
@@ -1378,6 +1692,9 @@ struct ol_rx_reorder_array_elem_t {
 	qdf_nbuf_t tail;
 };
 
+/* the fragment number is 4 bits of the sequence control field */
+#define OL_RX_DEFRAG_MAX_FRAGS 16
+
 struct ol_rx_reorder_t {
 	uint8_t win_sz;
 	uint8_t win_sz_mask;
@@ -1391,6 +1708,15 @@ struct ol_rx_reorder_t {
 	/* only used for defrag right now */
 	TAILQ_ENTRY(ol_rx_reorder_t) defrag_waitlist_elem;
 	uint32_t defrag_timeout_ms;
+	/*
+	 * fragments of the MPDU being reassembled, indexed by fragment
+	 * number and also linked in order from array[0]; only valid while
+	 * array[0] holds fragments
+	 */
+	qdf_nbuf_t frags[OL_RX_DEFRAG_MAX_FRAGS];
+	uint16_t frag_bitmap;
+	/* fragment number of the fragment without more frag flag, or -1 */
+	int8_t frag_last;
 	/* get back to parent ol_txrx_peer_t when ol_rx_reorder_t is in a
 	 * waitlist
 	 */
@@ -1544,6 +1870,7 @@ struct ol_txrx_peer_t {
 	u_int16_t tx_limit;
 	u_int16_t tx_limit_flag;
 	u_int16_t tx_pause_flag;
+	struct ol_tx_peer_bal_est_t tx_bal_est;
 #endif
 	qdf_time_t last_assoc_rcvd;
 	qdf_time_t last_disassoc_rcvd;
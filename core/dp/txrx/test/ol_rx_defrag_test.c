@@ -0,0 +1,524 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <ol_txrx_types.h>
+#include <ol_rx_reorder.h>
+#include <ol_rx_defrag.h>
+#include <ol_rx.h>
+#include "ol_rx_defrag_test.h"
+#include "qdf_mem.h"
+#include "qdf_nbuf.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "qdf_util.h"
+
+#define df_test_log(fmt, args...) \
+	qdf_nofl_info("ol_rx_defrag_test: " fmt, ##args)
+
+#define DF_T_SLOT_ROUNDS	2000
+#define DF_T_PEERS		4
+#define DF_T_TIDS		8
+#define DF_T_WAIT_MS		60000
+#define DF_T_MIC_ROUNDS		500
+#define DF_T_MIC_MAX_PAYLOAD	1500
+#define DF_T_HDR_LEN		sizeof(struct ieee80211_frame)
+
+static uint32_t df_test_rand(uint32_t *seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+	return *seed >> 16;
+}
+
+static qdf_nbuf_t df_test_alloc(uint32_t len)
+{
+	qdf_nbuf_t nbuf;
+
+	nbuf = qdf_nbuf_alloc(NULL, len, 0, 4, false);
+	if (nbuf)
+		qdf_nbuf_put_tail(nbuf, len);
+
+	return nbuf;
+}
+
+/**
+ * df_test_chain_check() - check the fragment chain of a TID
+ * @rx_reorder: rx reorder state of the TID
+ * @present: bitmap of the fragment numbers expected in the chain
+ *
+ * Every test fragment carries its fragment number in its first byte.
+ *
+ * Return: number of errors
+ */
+static uint32_t df_test_chain_check(struct ol_rx_reorder_t *rx_reorder,
+				    uint32_t present)
+{
+	struct ol_rx_reorder_array_elem_t *elem = &rx_reorder->array[0];
+	qdf_nbuf_t cur, last = NULL;
+	uint32_t seen = 0;
+	int prev = -1;
+	int fragno;
+
+	for (cur = elem->head; cur; cur = qdf_nbuf_next(cur)) {
+		fragno = *qdf_nbuf_data(cur);
+		if (fragno <= prev)
+			return 1;
+
+		seen |= 1 << fragno;
+		prev = fragno;
+		last = cur;
+	}
+
+	return seen != present || last != elem->tail;
+}
+
+/**
+ * df_test_slots() - feed shuffled MPDUs through the fragment slots
+ * @seed: random seed
+ *
+ * Every MPDU has a random number of fragments sent in random order with
+ * duplicates, followed by strays past the last fragment once that one is
+ * in. All MPDUs go through the same TID, so each one starts on the stale
+ * slots of the previous one.
+ *
+ * Return: number of errors
+ */
+static uint32_t df_test_slots(uint32_t *seed)
+{
+	struct ol_rx_reorder_t *rx_reorder;
+	enum ol_rx_frag_slot_status status, expected;
+	uint32_t errors = 0;
+	uint32_t present, full, r, sent;
+	uint8_t num, fragno;
+	bool last_seen;
+	qdf_nbuf_t frag;
+
+	rx_reorder = qdf_mem_malloc(sizeof(*rx_reorder));
+	if (!rx_reorder)
+		return 1;
+
+	ol_rx_reorder_init(rx_reorder, 0);
+
+	for (r = 0; r < DF_T_SLOT_ROUNDS && !errors; r++) {
+		num = 1 + df_test_rand(seed) % OL_RX_DEFRAG_MAX_FRAGS;
+		full = (1 << num) - 1;
+		present = 0;
+		last_seen = false;
+		status = OL_RX_FRAG_SLOT_STORED;
+
+		for (sent = 0; status != OL_RX_FRAG_SLOT_COMPLETE; sent++) {
+			if (sent > 16 * OL_RX_DEFRAG_MAX_FRAGS) {
+				df_test_log("round %u: %u of %u fragments never completed",
+					    r, qdf_get_hweight32(present), num);
+				errors++;
+				break;
+			}
+
+			if (last_seen && num < OL_RX_DEFRAG_MAX_FRAGS &&
+			    !(df_test_rand(seed) % 8))
+				fragno = num + df_test_rand(seed) %
+					 (OL_RX_DEFRAG_MAX_FRAGS - num);
+			else
+				fragno = df_test_rand(seed) % num;
+
+			if (fragno >= num)
+				expected = OL_RX_FRAG_SLOT_INVALID;
+			else if (present & (1 << fragno))
+				expected = OL_RX_FRAG_SLOT_DUP;
+			else if ((present | (1 << fragno)) == full)
+				expected = OL_RX_FRAG_SLOT_COMPLETE;
+			else
+				expected = OL_RX_FRAG_SLOT_STORED;
+
+			frag = df_test_alloc(1);
+			if (!frag) {
+				errors++;
+				break;
+			}
+			*qdf_nbuf_data(frag) = fragno;
+
+			status = ol_rx_frag_slot_insert(rx_reorder, fragno,
+							fragno != num - 1,
+							frag);
+			if (status != expected) {
+				df_test_log("round %u: fragment %u of %u status %d, expected %d",
+					    r, fragno, num, status, expected);
+				errors++;
+			}
+
+			if (status == OL_RX_FRAG_SLOT_DUP ||
+			    status == OL_RX_FRAG_SLOT_INVALID) {
+				qdf_nbuf_free(frag);
+			} else {
+				present |= 1 << fragno;
+				if (fragno == num - 1)
+					last_seen = true;
+			}
+
+			if (df_test_chain_check(rx_reorder, present)) {
+				df_test_log("round %u: fragment chain out of order after fragment %u",
+					    r, fragno);
+				errors++;
+			}
+
+			if (errors)
+				break;
+		}
+
+		/* consumed the way ol_rx_reorder_store_frag() does */
+		ol_rx_frames_free(NULL, rx_reorder->array[0].head);
+		rx_reorder->array[0].head = NULL;
+		rx_reorder->array[0].tail = NULL;
+	}
+
+	qdf_mem_free(rx_reorder);
+
+	return errors;
+}
+
+/**
+ * df_test_expiry() - expire part of a defrag waitlist
+ * @seed: random seed
+ *
+ * Arms a random set of peer TIDs holding a fragment, the first ones
+ * already expired, then re-arms some of them from anywhere in the list,
+ * including its tail. Only the TIDs still expired must be flushed.
+ *
+ * Return: number of errors
+ */
+static uint32_t df_test_expiry(uint32_t *seed)
+{
+	struct ol_txrx_peer_t *peers[DF_T_PEERS] = { NULL };
+	uint32_t order[DF_T_PEERS * DF_T_TIDS];
+	uint32_t expire[DF_T_PEERS] = { 0 };
+	uint32_t armed[DF_T_PEERS] = { 0 };
+	struct ol_rx_reorder_t *rx_reorder, *tmp;
+	struct ol_txrx_pdev_t *pdev;
+	struct ol_txrx_vdev_t *vdev;
+	uint32_t errors = 0, num, cut, linked = 0, left = 0;
+	uint32_t i, j, k, p, tid, now_ms;
+	qdf_nbuf_t frag;
+
+	pdev = qdf_mem_malloc(sizeof(*pdev));
+	vdev = qdf_mem_malloc(sizeof(*vdev));
+	if (!pdev || !vdev) {
+		errors = 1;
+		goto free;
+	}
+
+	vdev->pdev = pdev;
+	TAILQ_INIT(&pdev->rx.defrag.waitlist);
+	for (p = 0; p < DF_T_PEERS; p++) {
+		peers[p] = qdf_mem_malloc(sizeof(*peers[p]));
+		if (!peers[p]) {
+			errors = 1;
+			goto free;
+		}
+		peers[p]->vdev = vdev;
+		for (tid = 0; tid < OL_TXRX_NUM_EXT_TIDS; tid++)
+			ol_rx_reorder_init(&peers[p]->tids_rx_reorder[tid], tid);
+	}
+
+	for (i = 0; i < QDF_ARRAY_SIZE(order); i++)
+		order[i] = i;
+	for (i = QDF_ARRAY_SIZE(order) - 1; i > 0; i--) {
+		j = df_test_rand(seed) % (i + 1);
+		k = order[i];
+		order[i] = order[j];
+		order[j] = k;
+	}
+
+	num = 1 + df_test_rand(seed) % QDF_ARRAY_SIZE(order);
+	cut = df_test_rand(seed) % (num + 1);
+	now_ms = qdf_system_ticks_to_msecs(qdf_system_ticks());
+
+	/* armed in expiry order, as the pdev wide timeout keeps them */
+	for (i = 0; i < num; i++) {
+		p = order[i] / DF_T_TIDS;
+		tid = order[i] % DF_T_TIDS;
+		rx_reorder = &peers[p]->tids_rx_reorder[tid];
+
+		frag = df_test_alloc(1);
+		if (!frag) {
+			errors++;
+			goto flush;
+		}
+		ol_rx_frag_slot_insert(rx_reorder, 0, true, frag);
+
+		if (i < cut) {
+			rx_reorder->defrag_timeout_ms = now_ms - (num - i);
+			expire[p] |= 1 << tid;
+		} else {
+			rx_reorder->defrag_timeout_ms = now_ms + DF_T_WAIT_MS + i;
+		}
+		ol_rx_defrag_waitlist_add(peers[p], tid);
+		armed[p] |= 1 << tid;
+	}
+
+	/* re-arm later than everything armed so far, like a new fragment */
+	for (k = 0; k < num / 2; k++) {
+		i = df_test_rand(seed) % num;
+		if (!(df_test_rand(seed) % 4))
+			i = num - 1;
+		p = order[i] / DF_T_TIDS;
+		tid = order[i] % DF_T_TIDS;
+		rx_reorder = &peers[p]->tids_rx_reorder[tid];
+
+		ol_rx_defrag_waitlist_remove(peers[p], tid);
+		rx_reorder->defrag_timeout_ms = now_ms + DF_T_WAIT_MS + num + k;
+		ol_rx_defrag_waitlist_add(peers[p], tid);
+		expire[p] &= ~(1 << tid);
+	}
+
+	ol_rx_defrag_waitlist_flush(pdev);
+
+	for (p = 0; p < DF_T_PEERS; p++) {
+		for (tid = 0; tid < DF_T_TIDS; tid++) {
+			if (!(armed[p] & (1 << tid)))
+				continue;
+
+			rx_reorder = &peers[p]->tids_rx_reorder[tid];
+			if (expire[p] & (1 << tid)) {
+				if (rx_reorder->array[0].head ||
+				    rx_reorder->defrag_waitlist_elem.tqe_prev) {
+					df_test_log("peer %u tid %u: expired fragments kept",
+						    p, tid);
+					errors++;
+				}
+			} else {
+				left++;
+				if (!rx_reorder->array[0].head ||
+				    !rx_reorder->defrag_waitlist_elem.tqe_prev) {
+					df_test_log("peer %u tid %u: waiting fragments flushed",
+						    p, tid);
+					errors++;
+				}
+			}
+		}
+	}
+
+	TAILQ_FOREACH(rx_reorder, &pdev->rx.defrag.waitlist,
+		      defrag_waitlist_elem)
+		linked++;
+	if (linked != left) {
+		df_test_log("waitlist holds %u TIDs, expected %u",
+			    linked, left);
+		errors++;
+	}
+
+	df_test_log("expiry: %u TIDs armed, %u re-armed, %u flushed",
+		    num, num / 2, num - left);
+
+flush:
+	TAILQ_FOREACH_SAFE(rx_reorder, &pdev->rx.defrag.waitlist,
+			   defrag_waitlist_elem, tmp) {
+		TAILQ_REMOVE(&pdev->rx.defrag.waitlist, rx_reorder,
+			     defrag_waitlist_elem);
+		rx_reorder->defrag_waitlist_elem.tqe_next = NULL;
+		rx_reorder->defrag_waitlist_elem.tqe_prev = NULL;
+	}
+	for (p = 0; p < DF_T_PEERS; p++)
+		for (tid = 0; tid < DF_T_TIDS; tid++)
+			ol_rx_reorder_flush_frag(NULL, peers[p], tid, 0);
+
+free:
+	for (p = 0; p < DF_T_PEERS; p++)
+		if (peers[p])
+			qdf_mem_free(peers[p]);
+	if (vdev)
+		qdf_mem_free(vdev);
+	if (pdev)
+		qdf_mem_free(pdev);
+
+	return errors;
+}
+
+#ifndef CONFIG_HL_SUPPORT
+/**
+ * df_test_mic_split() - split an MSDU into fragments of random size
+ * @seed: random seed
+ * @data: 802.11 header followed by the payload and MIC
+ * @total: payload and MIC length
+ * @spread: set if the MIC spans more than the last two fragments
+ *
+ * Short fragments are favoured so the MIC often straddles fragments.
+ *
+ * Return: fragment chain, NULL on allocation failure
+ */
+static qdf_nbuf_t df_test_mic_split(uint32_t *seed, uint8_t *data,
+				    uint32_t total, bool *spread)
+{
+	qdf_nbuf_t head = NULL, tail = NULL, frag;
+	uint32_t off, len, cap;
+	uint32_t last_len = 0, prev_len = 0;
+
+	for (off = 0; off < total; off += len) {
+		len = 1 + df_test_rand(seed) % (total - off);
+		cap = 1 + df_test_rand(seed) % IEEE80211_WEP_MICLEN;
+		if (df_test_rand(seed) % 2 && len > cap)
+			len = cap;
+
+		frag = df_test_alloc(DF_T_HDR_LEN + len);
+		if (!frag) {
+			ol_rx_frames_free(NULL, head);
+			return NULL;
+		}
+		qdf_mem_copy(qdf_nbuf_data(frag), data, DF_T_HDR_LEN);
+		qdf_mem_copy(qdf_nbuf_data(frag) + DF_T_HDR_LEN,
+			     data + DF_T_HDR_LEN + off, len);
+
+		if (tail)
+			qdf_nbuf_set_next(tail, frag);
+		else
+			head = frag;
+		tail = frag;
+		prev_len = last_len;
+		last_len = len;
+	}
+
+	*spread = last_len + prev_len < IEEE80211_WEP_MICLEN;
+
+	return head;
+}
+
+/**
+ * df_test_mic() - check the Michael MIC over split fragment chains
+ * @seed: random seed
+ *
+ * The reference MIC is computed over the linear MSDU. A quarter of the
+ * chains get a byte of payload or MIC flipped and must fail; the others
+ * must pass unless the MIC spans more than the last two fragments, and
+ * come out with the MIC stripped and the payload untouched.
+ *
+ * Return: number of errors
+ */
+static uint32_t df_test_mic(uint32_t *seed)
+{
+	uint8_t key[DEFRAG_IEEE80211_KEY_LEN];
+	struct ol_txrx_pdev_t *pdev;
+	struct ieee80211_frame *wh;
+	qdf_nbuf_t lin, head, cur;
+	uint32_t errors = 0, failed = 0;
+	uint32_t r, i, plen, total, off, len;
+	uint8_t *data;
+	bool corrupt, spread;
+	int status, expected;
+
+	pdev = qdf_mem_malloc(sizeof(*pdev));
+	if (!pdev)
+		return 1;
+
+	for (r = 0; r < DF_T_MIC_ROUNDS; r++) {
+		plen = 1 + df_test_rand(seed) % DF_T_MIC_MAX_PAYLOAD;
+		total = plen + IEEE80211_WEP_MICLEN;
+		lin = df_test_alloc(DF_T_HDR_LEN + total);
+		if (!lin) {
+			errors++;
+			break;
+		}
+
+		data = qdf_nbuf_data(lin);
+		for (i = 0; i < DF_T_HDR_LEN + plen; i++)
+			data[i] = df_test_rand(seed);
+		wh = (struct ieee80211_frame *)data;
+		wh->i_fc[0] = IEEE80211_FC0_TYPE_DATA;
+		wh->i_fc[1] = IEEE80211_FC1_DIR_NODS;
+		for (i = 0; i < DEFRAG_IEEE80211_KEY_LEN; i++)
+			key[i] = df_test_rand(seed);
+		ol_rx_defrag_mic(pdev, key, lin, DF_T_HDR_LEN, plen,
+				 data + DF_T_HDR_LEN + plen);
+
+		head = df_test_mic_split(seed, data, total, &spread);
+		if (!head) {
+			qdf_nbuf_free(lin);
+			errors++;
+			break;
+		}
+
+		corrupt = !(df_test_rand(seed) % 4);
+		if (corrupt) {
+			off = df_test_rand(seed) % total;
+			for (cur = head; cur; cur = qdf_nbuf_next(cur)) {
+				len = qdf_nbuf_len(cur) - DF_T_HDR_LEN;
+				if (off < len) {
+					qdf_nbuf_data(cur)[DF_T_HDR_LEN + off] ^=
+						0x40;
+					break;
+				}
+				off -= len;
+			}
+		}
+
+		expected = (corrupt || spread) ? OL_RX_DEFRAG_ERR :
+						 OL_RX_DEFRAG_OK;
+		status = ol_rx_frag_tkip_demic_chain(pdev, key, head,
+						     DF_T_HDR_LEN);
+		if (status != expected) {
+			df_test_log("round %u: %u byte payload%s, status %d, expected %d",
+				    r, plen, corrupt ? " corrupted" : "",
+				    status, expected);
+			errors++;
+		} else if (status == OL_RX_DEFRAG_OK) {
+			off = 0;
+			for (cur = head; cur; cur = qdf_nbuf_next(cur)) {
+				len = qdf_nbuf_len(cur) - DF_T_HDR_LEN;
+				if (off + len > plen ||
+				    qdf_mem_cmp(qdf_nbuf_data(cur) +
+						DF_T_HDR_LEN,
+						data + DF_T_HDR_LEN + off,
+						len))
+					break;
+				off += len;
+			}
+			if (cur || off != plen) {
+				df_test_log("round %u: payload damaged by MIC strip",
+					    r);
+				errors++;
+			}
+		} else {
+			failed++;
+		}
+
+		ol_rx_frames_free(NULL, head);
+		qdf_nbuf_free(lin);
+	}
+
+	df_test_log("mic: %u split MSDUs, %u rejected", r, failed);
+	qdf_mem_free(pdev);
+
+	return errors;
+}
+#else
+static inline uint32_t df_test_mic(uint32_t *seed)
+{
+	/* HL fragments carry rx descriptors the test does not build */
+	return 0;
+}
+#endif /* CONFIG_HL_SUPPORT */
+
+uint32_t ol_rx_defrag_unit_test(void)
+{
+	uint32_t seed = 0xdef7a9;
+	uint32_t errors = 0;
+
+	errors += df_test_slots(&seed);
+	errors += df_test_expiry(&seed);
+	errors += df_test_mic(&seed);
+
+	return errors;
+}
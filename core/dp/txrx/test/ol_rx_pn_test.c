@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <ol_htt_rx_api.h>
+#include <ol_txrx_api.h>
+#include <ol_rx_pn.h>
+#include "ol_rx_pn_test.h"
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "qdf_util.h"
+
+#define pn_test_log(fmt, args...) \
+	qdf_nofl_info("ol_rx_pn_test: " fmt, ##args)
+
+#define PN_T_STREAM_LEN		256
+#define PN_T_BENCH_ROUNDS	2000
+
+/**
+ * struct pn_test_stream - synthetic rx stream of one peer TID
+ * @pn: PN of every MPDU
+ * @encrypted: encryption flag of every MPDU
+ * @num: number of MPDUs
+ */
+struct pn_test_stream {
+	union htt_rx_pn_t pn[PN_T_STREAM_LEN];
+	uint8_t encrypted[PN_T_STREAM_LEN];
+	int num;
+};
+
+/**
+ * struct pn_test_case - checker configuration to replay a stream with
+ * @name: case name
+ * @cmp: registered comparison
+ * @wapi: generate 128-bit WAPI PNs
+ * @is_unicast: unicast frames
+ * @opmode: vdev operating mode
+ * @strict_chk: require consecutive PNs
+ * @rekey: start with the WAPI USK rekey flag set
+ */
+struct pn_test_case {
+	const char *name;
+	ol_rx_pn_cmp_fp cmp;
+	bool wapi;
+	int is_unicast;
+	int opmode;
+	bool strict_chk;
+	bool rekey;
+};
+
+static const struct pn_test_case pn_test_cases[] = {
+	{ "ccmp", ol_rx_pn_cmp48, false, 1, wlan_op_mode_sta, false, false },
+	{ "ccmp strict", ol_rx_pn_cmp48, false, 1, wlan_op_mode_sta,
+	  true, false },
+	{ "wep24", ol_rx_pn_cmp24, false, 0, wlan_op_mode_sta, false, false },
+	{ "wapi ap", ol_rx_pn_wapi_cmp, true, 1, wlan_op_mode_ap,
+	  false, true },
+	{ "wapi sta", ol_rx_pn_wapi_cmp, true, 1, wlan_op_mode_sta,
+	  false, true },
+	{ "wapi mcast", ol_rx_pn_wapi_cmp, true, 0, wlan_op_mode_sta,
+	  false, false },
+};
+
+static uint32_t pn_test_rand(uint32_t *seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+	return *seed >> 16;
+}
+
+/**
+ * pn_test_build_stream() - generate mostly increasing PNs with replays
+ * @stream: stream to fill
+ * @wapi: generate 128-bit WAPI PNs, stepping by 2 to keep the parity
+ * @seed: random seed
+ *
+ * Return: none
+ */
+static void pn_test_build_stream(struct pn_test_stream *stream, bool wapi,
+				 uint32_t seed)
+{
+	uint64_t pn = wapi ? 0xfffffffffffffff0ULL : 0xfffff0;
+	uint64_t hi = 0;
+	uint32_t r;
+	int i;
+
+	for (i = 0; i < PN_T_STREAM_LEN; i++) {
+		r = pn_test_rand(&seed) % 16;
+
+		if (r == 0) {
+			/* duplicate of the previous PN */
+		} else if (r == 1) {
+			/* stale PN */
+			pn -= wapi ? 6 : 3;
+		} else if (r == 2) {
+			/* gap in the PN sequence */
+			pn += wapi ? 8 : 4;
+		} else {
+			if (wapi && pn + 2 < pn)
+				hi++;
+			pn += wapi ? 2 : 1;
+		}
+
+		qdf_mem_zero(&stream->pn[i], sizeof(stream->pn[i]));
+		if (wapi) {
+			stream->pn[i].pn128[0] = pn | (r == 3 ? 1 : 0);
+			stream->pn[i].pn128[1] = hi;
+		} else {
+			stream->pn[i].pn48 = pn;
+		}
+		stream->encrypted[i] = (r != 4);
+	}
+	stream->num = PN_T_STREAM_LEN;
+}
+
+/**
+ * pn_test_legacy() - per-MPDU check through the indirect comparison
+ * @st: PN replay state
+ * @stream: stream to check
+ * @verdict: replay verdict of every MPDU
+ *
+ * Mirrors the per-MPDU loop ol_rx_pn_check_base() used before batching.
+ *
+ * Return: none
+ */
+static void pn_test_legacy(struct ol_rx_pn_state *st,
+			   struct pn_test_stream *stream, uint8_t *verdict)
+{
+	ol_rx_pn_cmp_fp volatile cmp = st->cmp;
+	int i;
+
+	for (i = 0; i < stream->num; i++) {
+		verdict[i] = 0;
+		if (!stream->encrypted[i])
+			continue;
+
+		if (st->last_pn_valid) {
+			verdict[i] = cmp(&stream->pn[i], st->last_pn,
+					 st->is_unicast, st->opmode,
+					 st->strict_chk);
+			if (verdict[i])
+				continue;
+		} else {
+			st->last_pn_valid = 1;
+		}
+
+		if (st->rekey_flag && *st->rekey_flag == 1) {
+			*st->rekey_flag = 0;
+		} else {
+			st->last_pn->pn128[0] = stream->pn[i].pn128[0];
+			st->last_pn->pn128[1] = stream->pn[i].pn128[1];
+		}
+	}
+}
+
+/**
+ * pn_test_batched() - check a stream the way ol_rx_pn_check_base() does
+ * @st: PN replay state
+ * @stream: stream to check
+ * @verdict: replay verdict of every MPDU
+ *
+ * Return: none
+ */
+static void pn_test_batched(struct ol_rx_pn_state *st,
+			    struct pn_test_stream *stream, uint8_t *verdict)
+{
+	int base, num, i, replay;
+
+	for (base = 0; base < stream->num; base += num) {
+		num = qdf_min(stream->num - base, OL_RX_PN_BATCH_SIZE);
+		st->updated = 0;
+		for (i = 0; i < num; i = replay + 1) {
+			replay = ol_rx_pn_scan(st, &stream->pn[base],
+					       &stream->encrypted[base], i, num);
+			for (; i < replay; i++)
+				verdict[base + i] = 0;
+			if (replay < num)
+				verdict[base + replay] = 1;
+		}
+	}
+}
+
+static void pn_test_state_init(struct ol_rx_pn_state *st,
+			       const struct pn_test_case *tc,
+			       union htt_rx_pn_t *last_pn, uint8_t *rekey)
+{
+	qdf_mem_zero(last_pn, sizeof(*last_pn));
+	*rekey = tc->rekey;
+	ol_rx_pn_state_init(st, tc->cmp, last_pn, 0,
+			    tc->wapi && tc->is_unicast ? rekey : NULL,
+			    tc->is_unicast, tc->opmode, tc->strict_chk);
+}
+
+/**
+ * pn_test_run_case() - compare and time batched and per-MPDU checks
+ * @tc: test case
+ * @stream: scratch stream
+ *
+ * Return: number of errors
+ */
+static uint32_t pn_test_run_case(const struct pn_test_case *tc,
+				 struct pn_test_stream *stream)
+{
+	struct ol_rx_pn_state st[2];
+	union htt_rx_pn_t last_pn[2];
+	uint8_t rekey[2];
+	uint8_t verdict[2][PN_T_STREAM_LEN];
+	uint64_t start, elapsed_us[2];
+	uint32_t errors = 0;
+	uint32_t replays = 0;
+	uint32_t r;
+	int i;
+
+	pn_test_build_stream(stream, tc->wapi, 0x5eed + tc->opmode);
+
+	pn_test_state_init(&st[0], tc, &last_pn[0], &rekey[0]);
+	pn_test_legacy(&st[0], stream, verdict[0]);
+	pn_test_state_init(&st[1], tc, &last_pn[1], &rekey[1]);
+	pn_test_batched(&st[1], stream, verdict[1]);
+
+	for (i = 0; i < stream->num; i++) {
+		replays += verdict[0][i];
+		if (verdict[0][i] != verdict[1][i]) {
+			pn_test_log("%s: MPDU %d verdict %u, expected %u",
+				    tc->name, i, verdict[1][i], verdict[0][i]);
+			errors++;
+		}
+	}
+
+	if (qdf_mem_cmp(&last_pn[0], &last_pn[1], sizeof(last_pn[0])) ||
+	    st[0].last_pn_valid != st[1].last_pn_valid ||
+	    rekey[0] != rekey[1]) {
+		pn_test_log("%s: final TID state differs", tc->name);
+		errors++;
+	}
+
+	if (!replays) {
+		pn_test_log("%s: stream has no replays", tc->name);
+		errors++;
+	}
+
+	start = qdf_ktime_to_us(qdf_ktime_get());
+	for (r = 0; r < PN_T_BENCH_ROUNDS; r++) {
+		pn_test_state_init(&st[0], tc, &last_pn[0], &rekey[0]);
+		pn_test_legacy(&st[0], stream, verdict[0]);
+	}
+	elapsed_us[0] = qdf_ktime_to_us(qdf_ktime_get()) - start;
+
+	start = qdf_ktime_to_us(qdf_ktime_get());
+	for (r = 0; r < PN_T_BENCH_ROUNDS; r++) {
+		pn_test_state_init(&st[1], tc, &last_pn[1], &rekey[1]);
+		pn_test_batched(&st[1], stream, verdict[1]);
+	}
+	elapsed_us[1] = qdf_ktime_to_us(qdf_ktime_get()) - start;
+
+	pn_test_log("bench %s: %d MPDUs x %u rounds, %u replays, per-MPDU %llu us (%llu ns/MPDU), batched %llu us (%llu ns/MPDU)",
+		    tc->name, stream->num, PN_T_BENCH_ROUNDS, replays,
+		    elapsed_us[0],
+		    qdf_do_div(elapsed_us[0] * 1000,
+			       stream->num * PN_T_BENCH_ROUNDS),
+		    elapsed_us[1],
+		    qdf_do_div(elapsed_us[1] * 1000,
+			       stream->num * PN_T_BENCH_ROUNDS));
+
+	return errors;
+}
+
+uint32_t ol_rx_pn_unit_test(void)
+{
+	struct pn_test_stream *stream;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	stream = qdf_mem_malloc(sizeof(*stream));
+	if (!stream)
+		return 1;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(pn_test_cases); i++)
+		errors += pn_test_run_case(&pn_test_cases[i], stream);
+
+	qdf_mem_free(stream);
+
+	return errors;
+}
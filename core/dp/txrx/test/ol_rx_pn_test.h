@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __OL_RX_PN_TEST
+#define __OL_RX_PN_TEST
+
+#ifdef WLAN_OL_RX_PN_TEST
+/**
+ * ol_rx_pn_unit_test() - check batched PN replay detection
+ *
+ * Replays synthetic PN streams through the batched checker and through the
+ * per-MPDU indirect comparison it replaces, checks both reach the same
+ * verdicts and final TID state, and logs the time taken by each.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t ol_rx_pn_unit_test(void);
+#else
+static inline uint32_t ol_rx_pn_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_OL_RX_PN_TEST */
+
+#endif /* __OL_RX_PN_TEST */
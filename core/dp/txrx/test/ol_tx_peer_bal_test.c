@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <ol_txrx_types.h>
+#include <ol_tx_queue.h>
+#include "ol_tx_peer_bal_test.h"
+#include "qdf_lock.h"
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "qdf_util.h"
+
+#define pb_test_log(fmt, args...) \
+	qdf_nofl_info("ol_tx_peer_bal_test: " fmt, ##args)
+
+#define PB_T_MAX_PEERS		4
+/* target tx descriptors shared by all peers */
+#define PB_T_CREDITS		64
+#define PB_T_MSDU_BYTES		1500
+/* per TXOP overhead and cap of the simulated target */
+#define PB_T_TXOP_OVERHEAD_US	100
+#define PB_T_TXOP_MAX_US	4000
+#define PB_T_AMPDU_MAX		64
+#define PB_T_DURATION_US	5000000
+#define PB_T_TPUT_THRESH	20000
+#define PB_T_TX_LIMIT		4
+
+/**
+ * struct pb_test_case - SAP with always backlogged clients
+ * @name: case name
+ * @phy_mbps: PHY rate of every client
+ * @limited: bitmap of the clients expected to end up limited
+ */
+struct pb_test_case {
+	const char *name;
+	uint32_t phy_mbps[PB_T_MAX_PEERS];
+	uint32_t limited;
+};
+
+static const struct pb_test_case pb_test_cases[] = {
+	{ "all fast", { 300, 300, 300, 300 }, 0x0 },
+	{ "one slow", { 300, 300, 300, 6 }, 0x8 },
+	{ "two slow", { 300, 300, 6, 6 }, 0xc },
+	{ "mixed", { 300, 150, 54, 6 }, 0xc },
+};
+
+/**
+ * struct pb_test_result - outcome of one simulation run
+ * @kbps: acked throughput of every client
+ * @total_kbps: aggregate acked throughput
+ * @limited: bitmap of the clients limited at the end of the run
+ */
+struct pb_test_result {
+	uint32_t kbps[PB_T_MAX_PEERS];
+	uint32_t total_kbps;
+	uint32_t limited;
+};
+
+/**
+ * pb_test_host_sched() - hand free target credits to the clients
+ * @pdev: simulated pdev
+ * @peers: clients
+ * @fw_msdus: MSDUs every client holds in the target
+ * @credits: free target credits
+ * @rr: round robin position
+ *
+ * One MSDU per client in turn, going through the same bad peer hooks as
+ * the tx scheduler.
+ *
+ * Return: none
+ */
+static void pb_test_host_sched(struct ol_txrx_pdev_t *pdev,
+			       struct ol_txrx_peer_t **peers,
+			       uint32_t *fw_msdus, uint32_t *credits,
+			       uint32_t *rr)
+{
+	struct ol_tx_frms_queue_t *txq;
+	u_int16_t frames, tx_limit_flag;
+	uint32_t idle = 0;
+
+	while (*credits && idle < PB_T_MAX_PEERS) {
+		txq = &peers[*rr]->txqs[0];
+		tx_limit_flag = 0;
+		frames = ol_tx_bad_peer_dequeue_check(txq, 1, &tx_limit_flag);
+		ol_tx_bad_peer_update_tx_limit(pdev, txq, frames,
+					       tx_limit_flag);
+		if (frames) {
+			fw_msdus[*rr] += frames;
+			*credits -= frames;
+			idle = 0;
+		} else {
+			idle++;
+		}
+		*rr = (*rr + 1) % PB_T_MAX_PEERS;
+	}
+}
+
+/**
+ * pb_test_run() - simulate a SAP serving its clients
+ * @pdev: simulated pdev
+ * @peers: clients
+ * @tc: test case
+ * @balance: feed tx completions to bad peer flow control
+ * @res: result to fill
+ *
+ * The target serves the clients holding MSDUs round robin, one A-MPDU of
+ * at most PB_T_TXOP_MAX_US airtime each, and completes it at once.
+ *
+ * Return: none
+ */
+static void pb_test_run(struct ol_txrx_pdev_t *pdev,
+			struct ol_txrx_peer_t **peers,
+			const struct pb_test_case *tc, bool balance,
+			struct pb_test_result *res)
+{
+	uint32_t fw_msdus[PB_T_MAX_PEERS] = { 0 };
+	uint64_t acked[PB_T_MAX_PEERS] = { 0 };
+	uint32_t credits = PB_T_CREDITS;
+	uint32_t rr = 0, fw_rr = 0;
+	uint64_t now_us = 0, total = 0;
+	uint32_t i, k, n, max_n, msdu_us;
+
+	for (i = 0; i < PB_T_MAX_PEERS; i++) {
+		qdf_mem_zero(peers[i], sizeof(*peers[i]));
+		peers[i]->peer_ids[0] = i;
+		ol_txrx_set_txq_peer(&peers[i]->txqs[0], peers[i]);
+	}
+	pdev->tx_peer_bal.peer_num = 0;
+
+	while (now_us < PB_T_DURATION_US) {
+		pb_test_host_sched(pdev, peers, fw_msdus, &credits, &rr);
+
+		for (k = 0; k < PB_T_MAX_PEERS; k++)
+			if (fw_msdus[(fw_rr + k) % PB_T_MAX_PEERS])
+				break;
+		if (k == PB_T_MAX_PEERS) {
+			now_us += PB_T_TXOP_OVERHEAD_US;
+			continue;
+		}
+
+		i = (fw_rr + k) % PB_T_MAX_PEERS;
+		fw_rr = (i + 1) % PB_T_MAX_PEERS;
+
+		msdu_us = PB_T_MSDU_BYTES * 8 / tc->phy_mbps[i];
+		max_n = qdf_max(PB_T_TXOP_MAX_US / msdu_us, 1U);
+		n = qdf_min(qdf_min(fw_msdus[i], (uint32_t)PB_T_AMPDU_MAX),
+			    max_n);
+		now_us += PB_T_TXOP_OVERHEAD_US + n * msdu_us;
+
+		fw_msdus[i] -= n;
+		credits += n;
+		acked[i] += n * PB_T_MSDU_BYTES;
+		if (!balance)
+			continue;
+
+		for (k = 0; k < n; k++)
+			ol_tx_bad_peer_peer_comp(pdev, peers[i],
+						 qdf_do_div(now_us, 1000),
+						 PB_T_MSDU_BYTES, true);
+	}
+
+	res->limited = 0;
+	for (i = 0; i < PB_T_MAX_PEERS; i++) {
+		res->kbps[i] = qdf_do_div(acked[i] * 8 * 1000, now_us);
+		total += acked[i];
+		if (peers[i]->tx_limit_flag)
+			res->limited |= 1 << i;
+	}
+	res->total_kbps = qdf_do_div(total * 8 * 1000, now_us);
+}
+
+/**
+ * pb_test_run_case() - compare a SAP with and without flow control
+ * @pdev: simulated pdev
+ * @peers: clients
+ * @tc: test case
+ *
+ * Return: number of errors
+ */
+static uint32_t pb_test_run_case(struct ol_txrx_pdev_t *pdev,
+				 struct ol_txrx_peer_t **peers,
+				 const struct pb_test_case *tc)
+{
+	struct pb_test_result res[2];
+	uint32_t errors = 0;
+	uint32_t i;
+
+	pb_test_run(pdev, peers, tc, false, &res[0]);
+	pb_test_run(pdev, peers, tc, true, &res[1]);
+
+	if (res[1].limited != tc->limited) {
+		pb_test_log("%s: limited peers 0x%x, expected 0x%x",
+			    tc->name, res[1].limited, tc->limited);
+		errors++;
+	}
+
+	if (tc->limited && res[1].total_kbps <= res[0].total_kbps) {
+		pb_test_log("%s: aggregate %u kbps with flow control, %u kbps without",
+			    tc->name, res[1].total_kbps, res[0].total_kbps);
+		errors++;
+	}
+
+	for (i = 0; i < PB_T_MAX_PEERS; i++)
+		pb_test_log("%s: peer %u phy %u Mbps, %u kbps without, %u kbps with flow control",
+			    tc->name, i, tc->phy_mbps[i], res[0].kbps[i],
+			    res[1].kbps[i]);
+
+	pb_test_log("bench %s: %u peers x %u ms, aggregate %u kbps without, %u kbps with flow control",
+		    tc->name, PB_T_MAX_PEERS, PB_T_DURATION_US / 1000,
+		    res[0].total_kbps, res[1].total_kbps);
+
+	return errors;
+}
+
+uint32_t ol_tx_peer_bal_unit_test(void)
+{
+	struct ol_txrx_peer_t *peers[PB_T_MAX_PEERS] = { NULL };
+	struct ol_txrx_pdev_t *pdev;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	pdev = qdf_mem_malloc(sizeof(*pdev));
+	if (!pdev)
+		return 1;
+
+	for (i = 0; i < PB_T_MAX_PEERS; i++) {
+		peers[i] = qdf_mem_malloc(sizeof(*peers[i]));
+		if (!peers[i]) {
+			errors = 1;
+			goto free;
+		}
+	}
+
+	qdf_spinlock_create(&pdev->tx_peer_bal.mutex);
+	pdev->tx_peer_bal.enabled = ol_tx_peer_bal_enable;
+	/* the peers are not in the peer map, keep the timer off */
+	pdev->tx_peer_bal.peer_bal_timer_state = ol_tx_peer_bal_timer_disable;
+	for (i = 0; i < TXRX_IEEE11_MAX; i++) {
+		pdev->tx_peer_bal.ctl_thresh[i].tput_thresh = PB_T_TPUT_THRESH;
+		pdev->tx_peer_bal.ctl_thresh[i].tx_limit = PB_T_TX_LIMIT;
+	}
+
+	for (i = 0; i < QDF_ARRAY_SIZE(pb_test_cases); i++)
+		errors += pb_test_run_case(pdev, peers, &pb_test_cases[i]);
+
+	qdf_spinlock_destroy(&pdev->tx_peer_bal.mutex);
+
+free:
+	for (i = 0; i < PB_T_MAX_PEERS; i++)
+		if (peers[i])
+			qdf_mem_free(peers[i]);
+	qdf_mem_free(pdev);
+
+	return errors;
+}
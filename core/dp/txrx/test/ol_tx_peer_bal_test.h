@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __OL_TX_PEER_BAL_TEST
+#define __OL_TX_PEER_BAL_TEST
+
+#if defined(WLAN_OL_TX_PEER_BAL_TEST) && defined(QCA_BAD_PEER_TX_FLOW_CL)
+/**
+ * ol_tx_peer_bal_unit_test() - simulate bad peer flow control on a SAP
+ *
+ * Runs always backlogged peers of various PHY rates through the bad peer
+ * dequeue and tx completion hooks against a simulated target that shares
+ * its descriptors and airtime between them. Checks only the slow peers get
+ * limited and logs the aggregate and per peer throughput with and without
+ * flow control.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t ol_tx_peer_bal_unit_test(void);
+#else
+static inline uint32_t ol_tx_peer_bal_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_OL_TX_PEER_BAL_TEST && QCA_BAD_PEER_TX_FLOW_CL */
+
+#endif /* __OL_TX_PEER_BAL_TEST */
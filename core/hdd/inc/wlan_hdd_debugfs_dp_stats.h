@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_debugfs_dp_stats.h
+ *
+ * WLAN Host Device Driver implementation to update
+ * debugfs with the DP stats sampler history
+ */
+
+#ifndef _WLAN_HDD_DEBUGFS_DP_STATS_H
+#define _WLAN_HDD_DEBUGFS_DP_STATS_H
+
+#if defined(WLAN_DEBUGFS) && defined(WLAN_DP_STATS_SAMPLER)
+/**
+ * hdd_debugfs_dp_stats_init() - create DP stats samples file
+ * @hdd_ctx: hdd context
+ *
+ * file path: /sys/kernel/debug/wlan/dp_stats_samples
+ *
+ * Return: None
+ */
+void hdd_debugfs_dp_stats_init(struct hdd_context *hdd_ctx);
+
+/**
+ * hdd_debugfs_dp_stats_deinit() - remove DP stats samples file
+ * @hdd_ctx: hdd context
+ *
+ * Return: None
+ */
+void hdd_debugfs_dp_stats_deinit(struct hdd_context *hdd_ctx);
+#else
+static inline void hdd_debugfs_dp_stats_init(struct hdd_context *hdd_ctx)
+{
+}
+
+static inline void hdd_debugfs_dp_stats_deinit(struct hdd_context *hdd_ctx)
+{
+}
+#endif
+#endif /* _WLAN_HDD_DEBUGFS_DP_STATS_H */
@@ -143,6 +143,7 @@
  * @buf: Buffer to accumulate read memory chunks
  * @buf_len: Length of the read memory requested
  * @offset: APF work memory offset to fetch from
+ * @filter_id: filter id of the last program set by userspace
  * @lock: APF Context lock
  */
 struct hdd_apf_context {
@@ -153,6 +154,7 @@ struct hdd_apf_context {
 	uint8_t *buf;
 	uint32_t buf_len;
 	uint32_t offset;
+	uint32_t filter_id;
 	qdf_spinlock_t lock;
 };
 #endif /* FEATURE_WLAN_APF */
@@ -99,4 +99,44 @@ static inline int hdd_napi_serialize(int is_on)
 }
 #endif /* FEATURE_NAPI */
 
+struct hdd_context;
+
+#if defined(FEATURE_NAPI) && defined(WLAN_NAPI_AFFINITY_MGR)
+/**
+ * hdd_napi_affinity_update() - re-evaluate datapath CPU placement
+ * @hdd_ctx: HDD context
+ * @tx_packets: number of tx packets in the last bus bandwidth interval
+ * @rx_packets: number of rx packets in the last bus bandwidth interval
+ *
+ * Samples per CPU utilization and the CPU topology and, on high
+ * throughput, places NAPI, the DP RX threads and the RX refill thread
+ * on the least loaded CPUs of one cluster, preferring the perf cluster.
+ * The placement is released on low throughput.
+ *
+ * Return: None
+ */
+void hdd_napi_affinity_update(struct hdd_context *hdd_ctx,
+			      uint64_t tx_packets, uint64_t rx_packets);
+
+/**
+ * hdd_napi_affinity_show() - print topology and placement decisions
+ * @buf: sysfs buffer, PAGE_SIZE bytes
+ * @size: bytes already written to @buf
+ *
+ * Return: total bytes written to @buf
+ */
+ssize_t hdd_napi_affinity_show(char *buf, ssize_t size);
+#else
+static inline void hdd_napi_affinity_update(struct hdd_context *hdd_ctx,
+					    uint64_t tx_packets,
+					    uint64_t rx_packets)
+{
+}
+
+static inline ssize_t hdd_napi_affinity_show(char *buf, ssize_t size)
+{
+	return size;
+}
+#endif /* FEATURE_NAPI && WLAN_NAPI_AFFINITY_MGR */
+
 #endif /*  HDD_NAPI_H__ */
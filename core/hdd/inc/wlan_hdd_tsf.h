@@ -117,6 +117,66 @@ static inline void hdd_tsf_auto_report_init(struct hdd_adapter *adapter)
 }
 #endif
 
+#ifdef WLAN_FEATURE_TSF_PLUS
+/* Number of TSF/host capture pairs the conversion is fitted over */
+#define HDD_TSF_CONV_SAMPLES 8
+
+/**
+ * enum hdd_tsf_conv_domain - time domains mapped by the TSF conversion
+ * @HDD_TSF_CONV_NONE: no conversion published
+ * @HDD_TSF_CONV_TARGET32_HOST: 32 bit target time (us) to host time (ns)
+ * @HDD_TSF_CONV_TSF64_SOC: 64 bit global TSF (us) to SOC time (ns)
+ */
+enum hdd_tsf_conv_domain {
+	HDD_TSF_CONV_NONE,
+	HDD_TSF_CONV_TARGET32_HOST,
+	HDD_TSF_CONV_TSF64_SOC,
+};
+
+/**
+ * struct hdd_tsf_conv - published target to host time conversion
+ * @domain: time domains mapped, HDD_TSF_CONV_NONE if not usable
+ * @base_target: target time (us) of the reference point
+ * @base_host: fitted host time (ns) at @base_target
+ * @drift_q32: deviation from 1000 ns/us, in ns per us as Q32.32
+ *
+ * host = base_host + 1000 * dt + (drift_q32 * dt >> 32), dt in us
+ */
+struct hdd_tsf_conv {
+	enum hdd_tsf_conv_domain domain;
+	uint64_t base_target;
+	uint64_t base_host;
+	int64_t drift_q32;
+};
+
+/**
+ * struct hdd_tsf_conv_sample - TSF/host capture pair
+ * @target: target time, us, unwrapped for 32 bit target times
+ * @host: host time, ns
+ */
+struct hdd_tsf_conv_sample {
+	uint64_t target;
+	uint64_t host;
+};
+
+/**
+ * struct hdd_tsf_conv_stats - conversion residual statistics
+ * @samples: number of capture pairs checked against the prediction
+ * @last_ns: residual of the last capture pair
+ * @max_abs_ns: largest absolute residual
+ * @sum_abs_ns: sum of the absolute residuals
+ * @nominal_max_abs_ns: largest absolute residual of the fixed ratio,
+ *                      single sample mapping, for comparison
+ */
+struct hdd_tsf_conv_stats {
+	uint32_t samples;
+	int64_t last_ns;
+	uint64_t max_abs_ns;
+	uint64_t sum_abs_ns;
+	uint64_t nominal_max_abs_ns;
+};
+#endif
+
 /**
  * struct hdd_vdev_tsf - Adapter level tsf params
  * @cur_target_time: tsf value received from firmware.
@@ -143,6 +203,12 @@ static inline void hdd_tsf_auto_report_init(struct hdd_adapter *adapter)
  * @tsf_sync_ready_flag: to indicate whether tsf_sync has been initialized.
  * @gpio_tsf_sync_work: work to sync send TSF CAP WMI command.
  * @auto_rpt_src: bitmap to record trigger sources of TSF auto report
+ * @conv_seq: sequence count of @conv, odd while it is being updated
+ * @conv: conversion published to the per packet timestamping paths
+ * @conv_samples: recent capture pairs, written under host_target_sync_lock
+ * @conv_num_samples: number of valid entries in @conv_samples
+ * @conv_next: next entry of @conv_samples to write
+ * @conv_stats: residual statistics of @conv
  */
 struct hdd_vdev_tsf {
 	uint64_t cur_target_time;
@@ -174,6 +240,12 @@ struct hdd_vdev_tsf {
 #ifdef WLAN_FEATURE_TSF_PLUS_EXT_GPIO_SYNC
 	qdf_work_t gpio_tsf_sync_work;
 #endif
+	qdf_atomic_t conv_seq;
+	struct hdd_tsf_conv conv;
+	struct hdd_tsf_conv_sample conv_samples[HDD_TSF_CONV_SAMPLES];
+	uint8_t conv_num_samples;
+	uint8_t conv_next;
+	struct hdd_tsf_conv_stats conv_stats;
 #endif /* WLAN_FEATURE_TSF_PLUS */
 #ifdef WLAN_FEATURE_TSF_AUTO_REPORT
 	unsigned long auto_rpt_src;
@@ -27,6 +27,7 @@
 #include "osif_sync.h"
 #include "qca_vendor.h"
 #include "wlan_osif_request_manager.h"
+#include "wlan_dp_ucfg_api.h"
 
 /*
  * define short names for the global vendor params
@@ -210,6 +211,48 @@ cleanup:
 	return ret;
 }
 
+/**
+ * hdd_apf_host_mirror_set() - Mirror a legacy APF set/reset to host APF
+ * @adapter: pointer to adapter struct
+ * @apf_set_offload: APF program chunk sent to firmware
+ *
+ * The program is installed in the host APF engine once its last chunk
+ * has been received.
+ *
+ * Return: None
+ */
+static void
+hdd_apf_host_mirror_set(struct hdd_adapter *adapter,
+			struct sir_apf_set_offload *apf_set_offload)
+{
+	struct wlan_objmgr_vdev *vdev;
+	QDF_STATUS status;
+
+	vdev = hdd_objmgr_get_vdev_by_user(adapter->deflink, WLAN_OSIF_ID);
+	if (!vdev)
+		return;
+
+	adapter->apf_context.filter_id = apf_set_offload->filter_id;
+	if (!apf_set_offload->total_length) {
+		ucfg_dp_host_apf_reset(vdev);
+		goto put_vdev;
+	}
+
+	status = ucfg_dp_host_apf_write(vdev, apf_set_offload->current_offset,
+					apf_set_offload->program,
+					apf_set_offload->current_length,
+					apf_set_offload->total_length);
+	if (QDF_IS_STATUS_ERROR(status))
+		goto put_vdev;
+
+	if (apf_set_offload->current_offset +
+	    apf_set_offload->current_length >= apf_set_offload->total_length)
+		ucfg_dp_host_apf_commit(vdev, apf_set_offload->filter_id);
+
+put_vdev:
+	hdd_objmgr_put_vdev_by_user(vdev, WLAN_OSIF_ID);
+}
+
 /**
  * hdd_set_reset_apf_offload - Post set/reset apf to SME
  * @hdd_ctx: Hdd context
@@ -295,6 +338,7 @@ post_sme:
 		ret = -EINVAL;
 		goto fail;
 	}
+	hdd_apf_host_mirror_set(adapter, &apf_set_offload);
 	hdd_exit();
 
 fail:
@@ -317,6 +361,7 @@ fail:
 static int
 hdd_enable_disable_apf(struct hdd_adapter *adapter, bool apf_enable)
 {
+	struct wlan_objmgr_vdev *vdev;
 	QDF_STATUS status;
 
 	status = sme_set_apf_enable_disable(hdd_adapter_get_mac_handle(adapter),
@@ -330,9 +375,44 @@ hdd_enable_disable_apf(struct hdd_adapter *adapter, bool apf_enable)
 
 	adapter->apf_context.apf_enabled = apf_enable;
 
+	vdev = hdd_objmgr_get_vdev_by_user(adapter->deflink, WLAN_OSIF_ID);
+	if (vdev) {
+		if (apf_enable)
+			ucfg_dp_host_apf_commit(vdev,
+						adapter->apf_context.filter_id);
+		ucfg_dp_host_apf_set_active(vdev, apf_enable);
+		hdd_objmgr_put_vdev_by_user(vdev, WLAN_OSIF_ID);
+	}
+
 	return 0;
 }
 
+/**
+ * hdd_apf_host_mirror_write() - Mirror an APF work memory write to host APF
+ * @adapter: HDD Adapter
+ * @write_mem_params: work memory write sent to firmware
+ *
+ * The mirrored program is installed in the host APF engine when userspace
+ * enables the APF interpreter again.
+ *
+ * Return: None
+ */
+static void
+hdd_apf_host_mirror_write(struct hdd_adapter *adapter,
+			  struct wmi_apf_write_memory_params *write_mem_params)
+{
+	struct wlan_objmgr_vdev *vdev;
+
+	vdev = hdd_objmgr_get_vdev_by_user(adapter->deflink, WLAN_OSIF_ID);
+	if (!vdev)
+		return;
+
+	ucfg_dp_host_apf_write(vdev, write_mem_params->addr_offset,
+			       write_mem_params->buf, write_mem_params->length,
+			       write_mem_params->program_len);
+	hdd_objmgr_put_vdev_by_user(vdev, WLAN_OSIF_ID);
+}
+
 /**
  * hdd_apf_write_memory - Write into the apf work memory
  * @adapter: HDD Adapter
@@ -397,6 +477,8 @@ hdd_apf_write_memory(struct hdd_adapter *adapter, struct nlattr **tb)
 	if (!QDF_IS_STATUS_SUCCESS(status)) {
 		hdd_err("Unable to retrieve APF caps");
 		ret = -EINVAL;
+	} else {
+		hdd_apf_host_mirror_write(adapter, &write_mem_params);
 	}
 
 	hdd_debug("Writing successful into APF work memory from offset 0x%X:",
@@ -479,6 +561,29 @@ hdd_apf_read_memory_callback(void *hdd_context,
 	hdd_exit();
 }
 
+/**
+ * hdd_apf_host_merge_read() - Add host APF counters to a work memory read
+ * @adapter: HDD Adapter
+ * @offset: APF work memory offset of @buf
+ * @buf: work memory read back from firmware
+ * @len: length of @buf
+ *
+ * Return: None
+ */
+static void
+hdd_apf_host_merge_read(struct hdd_adapter *adapter, uint32_t offset,
+			uint8_t *buf, uint32_t len)
+{
+	struct wlan_objmgr_vdev *vdev;
+
+	vdev = hdd_objmgr_get_vdev_by_user(adapter->deflink, WLAN_OSIF_ID);
+	if (!vdev)
+		return;
+
+	ucfg_dp_host_apf_read_merge(vdev, offset, buf, len);
+	hdd_objmgr_put_vdev_by_user(vdev, WLAN_OSIF_ID);
+}
+
 /**
  * hdd_apf_read_memory - Read part of the apf work memory
  * @adapter: HDD Adapter
@@ -563,6 +668,9 @@ static int hdd_apf_read_memory(struct hdd_adapter *adapter, struct nlattr **tb)
 		goto fail;
 	}
 
+	hdd_apf_host_merge_read(adapter, read_mem_params.addr_offset,
+				context->buf, read_mem_params.length);
+
 	nl_buf_len += sizeof(uint32_t) + NLA_HDRLEN;
 	nl_buf_len += context->buf_len + NLA_HDRLEN;
 	skb = wlan_cfg80211_vendor_cmd_alloc_reply_skb(hdd_ctx->wiphy,
@@ -8910,6 +8910,7 @@ static int wlan_hdd_handle_restrict_offchan_config(struct hdd_adapter *adapter,
 		wlan_vdev_obj_lock(vdev);
 		wlan_vdev_mlme_cap_set(vdev, WLAN_VDEV_C_RESTRICT_OFFCHAN);
 		wlan_vdev_obj_unlock(vdev);
+		policy_mgr_invalidate_pcl_cache(hdd_ctx->psoc);
 		freq = policy_mgr_get_channel(hdd_ctx->psoc, pmode, &vdev_id);
 		if (!freq ||
 		    wlan_hdd_send_avoid_freq_for_dnbs(hdd_ctx, freq)) {
@@ -8921,6 +8922,7 @@ static int wlan_hdd_handle_restrict_offchan_config(struct hdd_adapter *adapter,
 		wlan_vdev_obj_lock(vdev);
 		wlan_vdev_mlme_cap_clear(vdev, WLAN_VDEV_C_RESTRICT_OFFCHAN);
 		wlan_vdev_obj_unlock(vdev);
+		policy_mgr_invalidate_pcl_cache(hdd_ctx->psoc);
 		if (wlan_hdd_send_avoid_freq_for_dnbs(hdd_ctx, 0)) {
 			hdd_err("unable to clear avoid_freq");
 			ret_val = -EINVAL;
@@ -31,6 +31,7 @@
 #include "cdp_txrx_misc.h"
 #include "ol_txrx_types.h"
 #include "ol_defines.h"
+#include "wlan_dp_ucfg_api.h"
 #ifdef FEATURE_WLAN_DIAG_SUPPORT
 #include "host_diag_core_event.h"
 #include "host_diag_core_log.h"
@@ -64,6 +65,38 @@ static inline void hdd_data_stall_send_event(uint32_t reason)
 }
 #endif
 
+/**
+ * hdd_data_stall_correlate() - log the root cause verdict on a data stall
+ * @info: data stall information
+ *
+ * Return: void
+ */
+static void hdd_data_stall_correlate(struct data_stall_event_info *info)
+{
+	struct hdd_context *hdd_ctx = cds_get_context(QDF_MODULE_ID_HDD);
+	enum dp_stall_trigger trigger;
+
+	if (!hdd_ctx)
+		return;
+
+	if (info->data_stall_type == DATA_STALL_LOG_NUD_FAILURE) {
+		/* reported by DP on the failing interface when it tracks NUD */
+		if (ucfg_dp_nud_tracking_enabled(hdd_ctx->psoc))
+			return;
+		trigger = DP_STALL_TRIGGER_NUD;
+	} else if (info->data_stall_type ==
+		   DATA_STALL_LOG_FW_RX_REFILL_FAILED) {
+		trigger = DP_STALL_TRIGGER_FW_RX_REFILL;
+	} else if (info->indicator == DATA_STALL_LOG_INDICATOR_FIRMWARE) {
+		trigger = DP_STALL_TRIGGER_FW;
+	} else {
+		trigger = DP_STALL_TRIGGER_HOST;
+	}
+
+	ucfg_dp_stall_corr_trigger(hdd_ctx->psoc, info->vdev_id_bitmap,
+				   trigger);
+}
+
 /**
  * hdd_data_stall_process_event() - Process data stall event
  * @msg: data stall message
@@ -81,6 +114,7 @@ static QDF_STATUS hdd_data_stall_process_event(struct scheduler_msg *msg)
 
 	data_stall_info = msg->bodyptr;
 
+	hdd_data_stall_correlate(data_stall_info);
 	hdd_data_stall_send_event(data_stall_info->data_stall_type);
 
 	return QDF_STATUS_SUCCESS;
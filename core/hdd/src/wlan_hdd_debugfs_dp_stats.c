@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_debugfs_dp_stats.c
+ *
+ * Binary snapshot of the per interface TX/RX sample history kept by the
+ * DP stats sampler. The file holds a struct dp_stats_snapshot_hdr followed
+ * by one struct dp_stats_snapshot_intf per interface, see
+ * wlan_dp_public_struct.h for the layout.
+ *
+ * Example to save a snapshot:
+ * sm8650:/ # cat /sys/kernel/debug/wlan/dp_stats_samples > /data/dp_stats
+ */
+
+#include "wlan_hdd_main.h"
+#include "osif_psoc_sync.h"
+#include "wlan_dp_ucfg_api.h"
+#include "wlan_hdd_debugfs_dp_stats.h"
+
+#define DP_STATS_DEBUGFS_PERMS	(QDF_FILE_USR_READ |	\
+				 QDF_FILE_GRP_READ)
+
+static void hdd_debugfs_dp_stats_write(void *ctx, const uint8_t *buf,
+				       uint32_t len)
+{
+	qdf_debugfs_write(ctx, buf, len);
+}
+
+static QDF_STATUS hdd_debugfs_dp_stats_read(qdf_debugfs_file_t file,
+					    void *arg)
+{
+	struct osif_psoc_sync *psoc_sync;
+	struct hdd_context *hdd_ctx = arg;
+	QDF_STATUS status;
+	int ret;
+
+	ret = wlan_hdd_validate_context(hdd_ctx);
+	if (ret)
+		return qdf_status_from_os_return(ret);
+
+	ret = osif_psoc_sync_op_start(wiphy_dev(hdd_ctx->wiphy), &psoc_sync);
+	if (ret)
+		return qdf_status_from_os_return(ret);
+
+	status = ucfg_dp_stats_sampler_snapshot(hdd_ctx->psoc,
+						hdd_debugfs_dp_stats_write,
+						file);
+
+	osif_psoc_sync_op_stop(psoc_sync);
+
+	return status;
+}
+
+static struct qdf_debugfs_fops hdd_dp_stats_debugfs_fops = {
+	.show = hdd_debugfs_dp_stats_read,
+};
+
+void hdd_debugfs_dp_stats_init(struct hdd_context *hdd_ctx)
+{
+	hdd_dp_stats_debugfs_fops.priv = hdd_ctx;
+	if (!qdf_debugfs_create_file("dp_stats_samples",
+				     DP_STATS_DEBUGFS_PERMS, NULL,
+				     &hdd_dp_stats_debugfs_fops))
+		hdd_err("Failed to create the DP stats samples file");
+}
+
+void hdd_debugfs_dp_stats_deinit(struct hdd_context *hdd_ctx)
+{
+	/*
+	 * The samples file doesn't have a directory, it is removed as part
+	 * of qdf remove
+	 */
+}
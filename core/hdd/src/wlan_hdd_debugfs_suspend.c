@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_debugfs_suspend.c
+ *
+ * Per step suspend/resume latency statistics and the trace of the most
+ * recent steps.
+ *
+ * Example to read the latency trace:
+ * sm8650:/ # cat /sys/kernel/debug/wlan/suspend_resume_latency
+ */
+
+#include "wlan_hdd_main.h"
+#include "osif_psoc_sync.h"
+#include "wlan_pmo_ucfg_api.h"
+#include "wlan_hdd_debugfs_suspend.h"
+
+#define SUSPEND_LATENCY_DEBUGFS_PERMS	(QDF_FILE_USR_READ |	\
+					 QDF_FILE_GRP_READ |	\
+					 QDF_FILE_OTH_READ)
+
+static const char *hdd_sr_step_str(uint8_t step)
+{
+	switch (step) {
+	case PMO_SR_STEP_OFFLOAD_CFG:
+		return "offload_cfg";
+	case PMO_SR_STEP_VDEV_SUSPEND_CFG:
+		return "vdev_suspend_cfg";
+	case PMO_SR_STEP_WOW_ENABLE:
+		return "wow_enable";
+	case PMO_SR_STEP_BUS_SUSPEND:
+		return "bus_suspend";
+	case PMO_SR_STEP_INITIAL_WAKEUP:
+		return "initial_wakeup";
+	case PMO_SR_STEP_BUS_RESUME:
+		return "bus_resume";
+	case PMO_SR_STEP_WOW_DISABLE:
+		return "wow_disable";
+	case PMO_SR_STEP_VDEV_RESUME_CFG:
+		return "vdev_resume_cfg";
+	case PMO_SR_STEP_OFFLOAD_RESTORE:
+		return "offload_restore";
+	default:
+		return "unknown";
+	}
+}
+
+static const char *hdd_sr_type_str(uint8_t type)
+{
+	switch (type) {
+	case QDF_SYSTEM_SUSPEND:
+		return "system";
+	case QDF_RUNTIME_SUSPEND:
+		return "runtime";
+	case QDF_UNIT_TEST_WOW_SUSPEND:
+		return "unit_test";
+	default:
+		return "unknown";
+	}
+}
+
+static QDF_STATUS
+__hdd_debugfs_suspend_latency_read(struct hdd_context *hdd_ctx,
+				   qdf_debugfs_file_t file)
+{
+	struct pmo_sr_latency *latency;
+	struct pmo_sr_step_stats *stats;
+	struct pmo_sr_trace_entry *entry;
+	QDF_STATUS status;
+	uint32_t i, idx;
+
+	latency = qdf_mem_malloc(sizeof(*latency));
+	if (!latency)
+		return QDF_STATUS_E_NOMEM;
+
+	status = ucfg_pmo_get_sr_latency(hdd_ctx->psoc, latency);
+	if (QDF_IS_STATUS_ERROR(status))
+		goto free;
+
+	qdf_debugfs_printf(file, "%-18s %8s %10s %10s %10s\n", "step",
+			   "count", "last_us", "avg_us", "max_us");
+	for (i = 0; i < PMO_SR_STEP_MAX; i++) {
+		stats = &latency->step[i];
+		qdf_debugfs_printf(file, "%-18s %8u %10u %10llu %10u\n",
+				   hdd_sr_step_str(i), stats->count,
+				   stats->last_us,
+				   stats->count ?
+				   qdf_do_div(stats->total_us, stats->count) :
+				   0,
+				   stats->max_us);
+	}
+
+	qdf_debugfs_printf(file, "\nrecent steps (oldest first):\n");
+	for (i = 0; i < PMO_SR_TRACE_MAX; i++) {
+		idx = (latency->trace_idx + i) % PMO_SR_TRACE_MAX;
+		entry = &latency->trace[idx];
+		if (!entry->timestamp_us)
+			continue;
+
+		qdf_debugfs_printf(file, "%llu %-8s %-18s %u us\n",
+				   entry->timestamp_us,
+				   hdd_sr_type_str(entry->type),
+				   hdd_sr_step_str(entry->step),
+				   entry->duration_us);
+	}
+
+free:
+	qdf_mem_free(latency);
+
+	return status;
+}
+
+static QDF_STATUS hdd_debugfs_suspend_latency_read(qdf_debugfs_file_t file,
+						   void *arg)
+{
+	struct osif_psoc_sync *psoc_sync;
+	struct hdd_context *hdd_ctx = arg;
+	QDF_STATUS status;
+	int ret;
+
+	ret = wlan_hdd_validate_context(hdd_ctx);
+	if (ret)
+		return qdf_status_from_os_return(ret);
+
+	ret = osif_psoc_sync_op_start(wiphy_dev(hdd_ctx->wiphy), &psoc_sync);
+	if (ret)
+		return qdf_status_from_os_return(ret);
+
+	status = __hdd_debugfs_suspend_latency_read(hdd_ctx, file);
+
+	osif_psoc_sync_op_stop(psoc_sync);
+
+	return status;
+}
+
+static struct qdf_debugfs_fops hdd_suspend_latency_debugfs_fops = {
+	.show = hdd_debugfs_suspend_latency_read,
+};
+
+void hdd_debugfs_suspend_latency_init(struct hdd_context *hdd_ctx)
+{
+	hdd_suspend_latency_debugfs_fops.priv = hdd_ctx;
+	if (!qdf_debugfs_create_file("suspend_resume_latency",
+				     SUSPEND_LATENCY_DEBUGFS_PERMS, NULL,
+				     &hdd_suspend_latency_debugfs_fops))
+		hdd_err("Failed to create the suspend resume latency file");
+}
+
+void hdd_debugfs_suspend_latency_deinit(struct hdd_context *hdd_ctx)
+{
+	/*
+	 * The latency file doesn't have a directory, it is removed as part
+	 * of qdf remove
+	 */
+}
@@ -1305,6 +1305,7 @@ static int __wlan_hdd_bus_suspend(struct wow_enable_params wow_params,
 	struct pmo_wow_enable_params pmo_params;
 	int pending;
 	struct bbm_params param = {0};
+	uint64_t begin_us;
 
 	hdd_info("starting bus suspend");
 
@@ -1368,11 +1369,14 @@ static int __wlan_hdd_bus_suspend(struct wow_enable_params wow_params,
 
 	hif_system_pm_set_state_suspended(hif_ctx);
 
+	begin_us = qdf_get_log_timestamp_usecs();
 	err = hif_bus_suspend(hif_ctx);
 	if (err) {
 		hdd_err("Failed hif bus suspend: %d", err);
 		goto resume_pmo;
 	}
+	ucfg_pmo_sr_latency_record(hdd_ctx->psoc, PMO_SR_STEP_BUS_SUSPEND,
+				   type, begin_us);
 
 	status = ucfg_pmo_core_txrx_suspend(hdd_ctx->psoc);
 	err = qdf_status_to_os_return(status);
@@ -1552,6 +1556,7 @@ int wlan_hdd_bus_resume(enum qdf_suspend_type type)
 	QDF_STATUS qdf_status;
 	void *dp_soc;
 	struct bbm_params param = {0};
+	uint64_t begin_us;
 
 	if (cds_is_driver_recovering())
 		return 0;
@@ -1583,11 +1588,14 @@ int wlan_hdd_bus_resume(enum qdf_suspend_type type)
 	param.policy_info.flag = BBM_APPS_RESUME;
 	ucfg_dp_bbm_apply_independent_policy(hdd_ctx->psoc, &param);
 
+	begin_us = qdf_get_log_timestamp_usecs();
 	status = hif_bus_resume(hif_ctx);
 	if (status) {
 		hdd_err("Failed hif bus resume");
 		goto out;
 	}
+	ucfg_pmo_sr_latency_record(hdd_ctx->psoc, PMO_SR_STEP_BUS_RESUME,
+				   type, begin_us);
 
 	hif_system_pm_set_state_resuming(hif_ctx);
 
@@ -1774,6 +1774,7 @@ static void hdd_fill_station_info(struct hdd_adapter *adapter,
 	}
 
 	qdf_mem_copy(&stainfo->mld_addr, &event->sta_mld, QDF_MAC_ADDR_SIZE);
+	hdd_sta_info_rehash(&adapter->sta_info_list, stainfo, true);
 
 	cache_sta_info =
 		hdd_get_sta_info_by_mac(&adapter->cache_sta_info_list,
@@ -1842,6 +1843,8 @@ static void hdd_fill_station_info(struct hdd_adapter *adapter,
 	} else {
 		qdf_copy_macaddr(&cache_sta_info->sta_mac, &event->staMac);
 		qdf_copy_macaddr(&cache_sta_info->mld_addr, &event->sta_mld);
+		hdd_sta_info_rehash(&adapter->cache_sta_info_list,
+				    cache_sta_info, true);
 		hdd_put_sta_info_ref(&adapter->cache_sta_info_list,
 				     &cache_sta_info, true,
 				     STA_INFO_FILL_STATION_INFO);
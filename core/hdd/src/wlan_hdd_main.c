@@ -186,6 +186,8 @@
 #include <wlan_interop_issues_ap_ucfg_api.h>
 #include <target_type.h>
 #include <wlan_hdd_debugfs_coex.h>
+#include "wlan_hdd_debugfs_suspend.h"
+#include "wlan_hdd_debugfs_dp_stats.h"
 #include <wlan_hdd_debugfs_config.h>
 #include "wlan_dlm_ucfg_api.h"
 #include "ftm_time_sync_ucfg_api.h"
@@ -11508,6 +11510,8 @@ void hdd_wlan_exit(struct hdd_context *hdd_ctx)
 	ucfg_dp_wait_complete_tasks();
 	wlan_hdd_destroy_mib_stats_lock();
 	hdd_debugfs_ini_config_deinit(hdd_ctx);
+	hdd_debugfs_suspend_latency_deinit(hdd_ctx);
+	hdd_debugfs_dp_stats_deinit(hdd_ctx);
 	hdd_debugfs_mws_coex_info_deinit(hdd_ctx);
 	hdd_psoc_idle_timer_stop(hdd_ctx);
 	hdd_regulatory_deinit(hdd_ctx);
@@ -12353,6 +12357,8 @@ int wlan_hdd_napi_apply_throughput_policy(hdd_cb_handle context,
 		hdd_err("hdd_ctx is null");
 		return 0;
 	}
+
+	hdd_napi_affinity_update(hdd_ctx, tx_packets, rx_packets);
 	if (hdd_ctx->config->napi_cpu_affinity_mask)
 		rc = hdd_napi_apply_throughput_policy(hdd_ctx, tx_packets,
 						      rx_packets);
@@ -17723,6 +17729,8 @@ int hdd_wlan_startup(struct hdd_context *hdd_ctx)
 	hdd_set_idle_ps_config(hdd_ctx, is_imps_enabled);
 	hdd_debugfs_mws_coex_info_init(hdd_ctx);
 	hdd_debugfs_ini_config_init(hdd_ctx);
+	hdd_debugfs_suspend_latency_init(hdd_ctx);
+	hdd_debugfs_dp_stats_init(hdd_ctx);
 	wlan_hdd_debugfs_unit_test_host_create(hdd_ctx);
 	wlan_hdd_create_mib_stats_lock();
 	wlan_cfg80211_init_interop_issues_ap(hdd_ctx->pdev);
@@ -22394,3 +22402,28 @@ static const struct kernel_param_ops timer_multiplier_ops = {
 };
 
 module_param_cb(timer_multiplier, &timer_multiplier_ops, NULL, 0644);
+
+#ifdef DP_MEM_PRE_ALLOC
+static int dp_prealloc_profile_get_handler(char *buffer,
+					   const struct kernel_param *kp)
+{
+	return ucfg_dp_prealloc_profile_show(buffer, PAGE_SIZE);
+}
+
+static int dp_prealloc_profile_set_handler(const char *kmessage,
+					   const struct kernel_param *kp)
+{
+	QDF_STATUS status;
+
+	status = ucfg_dp_prealloc_profile_load(kmessage);
+
+	return qdf_status_to_os_return(status);
+}
+
+static const struct kernel_param_ops dp_prealloc_profile_ops = {
+	.get = dp_prealloc_profile_get_handler,
+	.set = dp_prealloc_profile_set_handler,
+};
+
+module_param_cb(dp_prealloc_profile, &dp_prealloc_profile_ops, NULL, 0644);
+#endif
@@ -23,6 +23,7 @@
  * WLAN HDD NAPI interface implementation
  */
 #include <linux/smp.h> /* get_cpu */
+#include <linux/cpufreq.h> /* get_cpu_idle_time */
 
 #include "wlan_hdd_napi.h"
 #include "cds_api.h"       /* cds_get_context */
@@ -262,9 +263,381 @@ int hdd_napi_event(enum qca_napi_event event, void *data)
 	return rc;
 }
 
+/* default CPUs of the min frequency request, the perf cluster */
+#define HDD_NAPI_PERF_CLUSTER_COREMASK 0x0f0
+
+#ifdef WLAN_NAPI_AFFINITY_MGR
+/* CPUs and clusters tracked by the affinity manager */
+#define HDD_NAPI_AFF_MAX_CPUS 16
+#define HDD_NAPI_AFF_MAX_CLUSTERS 4
+/* CPU busier than this is not picked for the datapath */
+#define HDD_NAPI_AFF_BUSY_PCT 85
+#define HDD_NAPI_AFF_TRACE_SIZE 16
+
+/**
+ * struct hdd_napi_aff_cluster - CPU cluster as seen by the affinity manager
+ * @cpus: online CPUs of the cluster
+ * @num_cpus: number of bits set in @cpus
+ * @perf: cluster is part of the perf cluster bitmap
+ * @util_pct: mean utilization of @cpus over the last sampling window
+ */
+struct hdd_napi_aff_cluster {
+	unsigned long cpus;
+	uint8_t num_cpus;
+	bool perf;
+	uint8_t util_pct;
+};
+
+/**
+ * struct hdd_napi_aff_trace - affinity manager decision record
+ * @timestamp: qdf log timestamp of the decision
+ * @packets: tx + rx packets of the bus bandwidth interval
+ * @high_tput: high throughput placement requested
+ * @cluster: cluster picked, -1 if placement was released
+ * @cpus: CPUs the datapath was placed on
+ * @util_pct: mean utilization of each cluster when deciding
+ * @reason: why @cluster was picked
+ */
+struct hdd_napi_aff_trace {
+	uint64_t timestamp;
+	uint64_t packets;
+	bool high_tput;
+	int8_t cluster;
+	unsigned long cpus;
+	uint8_t util_pct[HDD_NAPI_AFF_MAX_CLUSTERS];
+	const char *reason;
+};
+
+/**
+ * struct hdd_napi_aff_mgr - datapath CPU affinity manager
+ * @prev_idle_us: per CPU idle time at the previous sample
+ * @prev_wall_us: per CPU wall time at the previous sample
+ * @util_pct: per CPU utilization over the last sampling window
+ * @cluster: CPU topology discovered at the last sample
+ * @cur_cluster: cluster the datapath is placed on, -1 if none
+ * @cur_cpus: CPUs the datapath is placed on, 0 if none
+ * @num_decisions: number of placement changes
+ * @trace: ring of the last HDD_NAPI_AFF_TRACE_SIZE decisions
+ */
+struct hdd_napi_aff_mgr {
+	uint64_t prev_idle_us[HDD_NAPI_AFF_MAX_CPUS];
+	uint64_t prev_wall_us[HDD_NAPI_AFF_MAX_CPUS];
+	uint8_t util_pct[HDD_NAPI_AFF_MAX_CPUS];
+	struct hdd_napi_aff_cluster cluster[HDD_NAPI_AFF_MAX_CLUSTERS];
+	int8_t cur_cluster;
+	unsigned long cur_cpus;
+	uint32_t num_decisions;
+	struct hdd_napi_aff_trace trace[HDD_NAPI_AFF_TRACE_SIZE];
+};
+
+static struct hdd_napi_aff_mgr hdd_napi_aff = { .cur_cluster = -1 };
+static DEFINE_MUTEX(hdd_napi_aff_lock);
+
+/**
+ * hdd_napi_aff_sample() - sample CPU utilization and topology
+ * @mgr: affinity manager
+ *
+ * Return: None
+ */
+static void hdd_napi_aff_sample(struct hdd_napi_aff_mgr *mgr)
+{
+	struct hdd_napi_aff_cluster *cluster;
+	uint32_t util_sum[HDD_NAPI_AFF_MAX_CLUSTERS] = {0};
+	uint64_t idle_us, wall_us, d_idle, d_wall;
+	int perf_cluster = hif_get_perf_cluster_bitmap();
+	unsigned int cpu;
+	int package_id, i;
+
+	qdf_mem_zero(mgr->cluster, sizeof(mgr->cluster));
+	qdf_for_each_online_cpu(cpu) {
+		if (cpu >= HDD_NAPI_AFF_MAX_CPUS)
+			continue;
+
+		idle_us = get_cpu_idle_time(cpu, &wall_us, 0);
+		d_idle = idle_us - mgr->prev_idle_us[cpu];
+		d_wall = wall_us - mgr->prev_wall_us[cpu];
+		mgr->prev_idle_us[cpu] = idle_us;
+		mgr->prev_wall_us[cpu] = wall_us;
+		if (d_wall && d_idle <= d_wall)
+			mgr->util_pct[cpu] = 100 -
+				div64_u64(d_idle * 100, d_wall);
+
+		package_id = qdf_topology_physical_package_id(cpu);
+		if (package_id < 0 || package_id >= HDD_NAPI_AFF_MAX_CLUSTERS)
+			continue;
+
+		cluster = &mgr->cluster[package_id];
+		cluster->cpus |= BIT(cpu);
+		cluster->num_cpus++;
+		cluster->perf = !!(BIT(package_id) & perf_cluster);
+		util_sum[package_id] += mgr->util_pct[cpu];
+	}
+
+	for (i = 0; i < HDD_NAPI_AFF_MAX_CLUSTERS; i++)
+		if (mgr->cluster[i].num_cpus)
+			mgr->cluster[i].util_pct = util_sum[i] /
+						   mgr->cluster[i].num_cpus;
+}
+
+/**
+ * hdd_napi_aff_pick_cluster() - pick the cluster to place the datapath on
+ * @mgr: affinity manager
+ * @reason: filled with the reason of the choice
+ *
+ * Stay on the current cluster while it has headroom, otherwise take the
+ * perf cluster with the most idle capacity, and fall back to the least
+ * loaded cluster when all perf clusters are busy.
+ *
+ * Return: cluster index, -1 if no cluster is online
+ */
+static int hdd_napi_aff_pick_cluster(struct hdd_napi_aff_mgr *mgr,
+				     const char **reason)
+{
+	struct hdd_napi_aff_cluster *cluster;
+	uint32_t headroom, best_perf = 0, best_any = 0;
+	int i, perf_idx = -1, any_idx = -1;
+
+	if (mgr->cur_cluster >= 0) {
+		cluster = &mgr->cluster[mgr->cur_cluster];
+		if (cluster->num_cpus &&
+		    cluster->util_pct < HDD_NAPI_AFF_BUSY_PCT) {
+			*reason = "keep";
+			return mgr->cur_cluster;
+		}
+	}
+
+	for (i = 0; i < HDD_NAPI_AFF_MAX_CLUSTERS; i++) {
+		cluster = &mgr->cluster[i];
+		if (!cluster->num_cpus)
+			continue;
+
+		headroom = cluster->num_cpus * (100 - cluster->util_pct);
+		if (cluster->perf &&
+		    cluster->util_pct < HDD_NAPI_AFF_BUSY_PCT &&
+		    (perf_idx < 0 || headroom > best_perf)) {
+			perf_idx = i;
+			best_perf = headroom;
+		}
+		if (any_idx < 0 || headroom > best_any) {
+			any_idx = i;
+			best_any = headroom;
+		}
+	}
+
+	if (perf_idx >= 0) {
+		*reason = "perf";
+		return perf_idx;
+	}
+
+	*reason = "least_loaded";
+	return any_idx;
+}
+
+#ifdef WLAN_DP_LEGACY_OL_RX_THREAD
+/**
+ * hdd_napi_aff_set_rx_threads() - move the RX threads to @mask
+ * @mask: CPUs to place the RX threads on, empty to release the placement
+ *
+ * On targets with the CDS scheduler the RX threads are affined by it, it
+ * takes @mask as a hint so INI configured masks keep precedence.
+ *
+ * Return: None
+ */
+static void hdd_napi_aff_set_rx_threads(qdf_cpu_mask *mask)
+{
+	cds_sched_set_affinity_hint(mask);
+}
+#else
+/*
+ * The DP RX threads are moved directly, unless the INI configures their
+ * CPU mask, which keeps precedence like on the CDS scheduler.
+ */
+static void hdd_napi_aff_set_rx_threads(qdf_cpu_mask *mask)
+{
+	struct hdd_context *hdd_ctx = cds_get_context(QDF_MODULE_ID_HDD);
+	qdf_cpu_mask rx_mask;
+
+	if (!hdd_ctx ||
+	    ucfg_dp_get_rx_thread_affinity_mask(hdd_ctx->psoc))
+		return;
+
+	qdf_cpumask_copy(&rx_mask, mask);
+	if (qdf_cpumask_empty(&rx_mask))
+		qdf_cpumask_setall(&rx_mask);
+	ucfg_dp_txrx_set_cpu_mask(cds_get_context(QDF_MODULE_ID_SOC),
+				  &rx_mask);
+}
+#endif
+
+/**
+ * hdd_napi_aff_apply() - move the datapath threads and NAPI to @cpus
+ * @cpus: CPUs to place the datapath on, 0 to release the placement
+ *
+ * The NAPI CPU mask is used by HIF on the next throughput state change,
+ * the CPUs are also voted for PM QoS on high throughput.
+ *
+ * Return: None
+ */
+static void hdd_napi_aff_apply(unsigned long cpus)
+{
+	struct qca_napi_data *napid = hdd_napi_get_all();
+	struct hdd_context *hdd_ctx = cds_get_context(QDF_MODULE_ID_HDD);
+	qdf_cpu_mask mask;
+	unsigned int cpu;
+
+	qdf_cpumask_clear(&mask);
+	for (cpu = 0; cpu < HDD_NAPI_AFF_MAX_CPUS; cpu++)
+		if (cpus & BIT(cpu))
+			qdf_cpumask_set_cpu(cpu, &mask);
+
+	hdd_napi_aff_set_rx_threads(&mask);
+	if (hdd_ctx)
+		ucfg_dp_bus_bw_set_pm_qos_cpu_hint(hdd_ctx->psoc, &mask);
+
+	if (!cpus)
+		qdf_cpumask_setall(&mask);
+	ucfg_dp_txrx_set_refill_cpu_mask(cds_get_context(QDF_MODULE_ID_SOC),
+					 &mask);
+
+	if (napid && hdd_ctx) {
+		qdf_spin_lock_bh(&napid->lock);
+		if (!cpus)
+			napid->user_cpu_affin_mask =
+				hdd_ctx->config->napi_cpu_affinity_mask;
+		else if (hdd_ctx->config->napi_cpu_affinity_mask & cpus)
+			napid->user_cpu_affin_mask =
+				hdd_ctx->config->napi_cpu_affinity_mask & cpus;
+		else
+			napid->user_cpu_affin_mask = cpus;
+		qdf_spin_unlock_bh(&napid->lock);
+	}
+}
+
+void hdd_napi_affinity_update(struct hdd_context *hdd_ctx,
+			      uint64_t tx_packets, uint64_t rx_packets)
+{
+	struct hdd_napi_aff_mgr *mgr = &hdd_napi_aff;
+	struct hdd_napi_aff_trace *trace;
+	uint64_t packets = tx_packets + rx_packets;
+	const char *reason = "low_tput";
+	unsigned long cpus = 0;
+	unsigned int cpu;
+	bool high_tput;
+	int cluster = -1;
+	int i;
+
+	high_tput = packets > ucfg_dp_get_bus_bw_high_threshold(hdd_ctx->psoc);
+
+	mutex_lock(&hdd_napi_aff_lock);
+	hdd_napi_aff_sample(mgr);
+
+	if (high_tput) {
+		cluster = hdd_napi_aff_pick_cluster(mgr, &reason);
+		if (cluster >= 0) {
+			/* keep off CPUs saturated by other work */
+			for (cpu = 0; cpu < HDD_NAPI_AFF_MAX_CPUS; cpu++)
+				if (mgr->cluster[cluster].cpus & BIT(cpu) &&
+				    mgr->util_pct[cpu] < HDD_NAPI_AFF_BUSY_PCT)
+					cpus |= BIT(cpu);
+			if (!cpus)
+				cpus = mgr->cluster[cluster].cpus;
+		}
+	}
+
+	if (cpus == mgr->cur_cpus) {
+		mutex_unlock(&hdd_napi_aff_lock);
+		return;
+	}
+
+	trace = &mgr->trace[mgr->num_decisions % HDD_NAPI_AFF_TRACE_SIZE];
+	trace->timestamp = qdf_get_log_timestamp();
+	trace->packets = packets;
+	trace->high_tput = high_tput;
+	trace->cluster = cluster;
+	trace->cpus = cpus;
+	trace->reason = reason;
+	for (i = 0; i < HDD_NAPI_AFF_MAX_CLUSTERS; i++)
+		trace->util_pct[i] = mgr->cluster[i].util_pct;
+	mgr->num_decisions++;
+	mgr->cur_cluster = cluster;
+	mgr->cur_cpus = cpus;
+
+	hdd_napi_aff_apply(cpus);
+	mutex_unlock(&hdd_napi_aff_lock);
+
+	hdd_debug("datapath placed on cluster %d cpus 0x%lx (%s)",
+		  cluster, cpus, reason);
+}
+
+ssize_t hdd_napi_affinity_show(char *buf, ssize_t size)
+{
+	struct hdd_napi_aff_mgr *mgr = &hdd_napi_aff;
+	struct hdd_napi_aff_cluster *cluster;
+	struct hdd_napi_aff_trace *trace;
+	uint32_t i, first;
+	int j;
+
+	mutex_lock(&hdd_napi_aff_lock);
+	for (i = 0; i < HDD_NAPI_AFF_MAX_CLUSTERS; i++) {
+		cluster = &mgr->cluster[i];
+		if (!cluster->num_cpus)
+			continue;
+		size += scnprintf(buf + size, PAGE_SIZE - size,
+				  "cluster %u cpus 0x%lx perf %d util %u%%\n",
+				  i, cluster->cpus, cluster->perf,
+				  cluster->util_pct);
+	}
+	size += scnprintf(buf + size, PAGE_SIZE - size,
+			  "placed cluster %d cpus 0x%lx decisions %u\n",
+			  mgr->cur_cluster, mgr->cur_cpus,
+			  mgr->num_decisions);
+
+	first = mgr->num_decisions > HDD_NAPI_AFF_TRACE_SIZE ?
+		mgr->num_decisions - HDD_NAPI_AFF_TRACE_SIZE : 0;
+	for (i = first; i < mgr->num_decisions; i++) {
+		trace = &mgr->trace[i % HDD_NAPI_AFF_TRACE_SIZE];
+		size += scnprintf(buf + size, PAGE_SIZE - size,
+				  "%llu pkts %llu hi %d cluster %d cpus 0x%lx %s util",
+				  trace->timestamp, trace->packets,
+				  trace->high_tput, trace->cluster,
+				  trace->cpus, trace->reason);
+		for (j = 0; j < HDD_NAPI_AFF_MAX_CLUSTERS; j++)
+			size += scnprintf(buf + size, PAGE_SIZE - size,
+					  " %u", trace->util_pct[j]);
+		size += scnprintf(buf + size, PAGE_SIZE - size, "\n");
+	}
+	mutex_unlock(&hdd_napi_aff_lock);
+
+	return size;
+}
+
+/**
+ * hdd_napi_affinity_coremask() - CPUs to raise the min frequency of
+ *
+ * Return: CPUs the datapath is placed on, perf cluster if not placed
+ */
+static inline uint32_t hdd_napi_affinity_coremask(void)
+{
+	uint32_t coremask;
+
+	mutex_lock(&hdd_napi_aff_lock);
+	coremask = hdd_napi_aff.cur_cpus;
+	mutex_unlock(&hdd_napi_aff_lock);
+
+	return coremask ? coremask : HDD_NAPI_PERF_CLUSTER_COREMASK;
+}
+#else
+static inline uint32_t hdd_napi_affinity_coremask(void)
+{
+	return HDD_NAPI_PERF_CLUSTER_COREMASK;
+}
+#endif /* WLAN_NAPI_AFFINITY_MGR */
+
 #if defined HELIUMPLUS && defined MSM_PLATFORM
 
 static int napi_tput_policy_delay;
+/* CPUs of the min frequency request in effect, 0 if none */
+static uint32_t napi_perfd_coremask;
 
 /**
  * hdd_napi_perfd_cpufreq() - set/reset min CPU freq for cores
@@ -308,7 +681,7 @@ static int hdd_napi_perfd_cpufreq(enum qca_napi_tput_state req_state)
 	case QCA_NAPI_TPUT_HI:
 		req.magic    = WLAN_CORE_MINFREQ_MAGIC;
 		req.reserved = 0; /* unused */
-		req.coremask = 0x0f0; /* perf cluster */
+		req.coremask = hdd_napi_affinity_coremask();
 		req.freq     = 700;   /* KHz */
 		break;
 	default:
@@ -319,6 +692,7 @@ static int hdd_napi_perfd_cpufreq(enum qca_napi_tput_state req_state)
 
 	NAPI_DEBUG("CPU min freq to %d",
 		   (req.freq == 0)?"Resetting":"Setting", req.freq);
+	napi_perfd_coremask = req.coremask;
 	/* the following service function returns void */
 	wlan_hdd_send_svc_nlink_msg(hdd_ctx->radio_index,
 				WLAN_SVC_CORE_MINFREQ,
@@ -398,6 +772,15 @@ int hdd_napi_apply_throughput_policy(struct hdd_context *hddctx,
 		rc = hdd_napi_perfd_cpufreq(req_state);
 		/* denylist/boost_mode on/off */
 		rc = hdd_napi_event(NAPI_EVT_TPUT_STATE, (void *)req_state);
+	} else if (req_state == QCA_NAPI_TPUT_HI &&
+		   napi_perfd_coremask != hdd_napi_affinity_coremask()) {
+		/* datapath moved, each set must be preceded by a reset */
+		hdd_napi_perfd_cpufreq(QCA_NAPI_TPUT_LO);
+		rc = hdd_napi_perfd_cpufreq(QCA_NAPI_TPUT_HI);
+		/* let HIF pick the NAPI CPUs again */
+		hdd_napi_event(NAPI_EVT_TPUT_STATE,
+			       (void *)QCA_NAPI_TPUT_LO);
+		rc = hdd_napi_event(NAPI_EVT_TPUT_STATE, (void *)req_state);
 	}
 	return rc;
 }
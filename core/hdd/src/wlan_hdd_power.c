@@ -1614,6 +1614,7 @@ hdd_suspend_wlan(void)
 	struct hdd_adapter *adapter = NULL, *next_adapter = NULL;
 	uint32_t conn_state_mask = 0;
 	struct wlan_hdd_link_info *link_info;
+	uint64_t begin_us;
 
 	hdd_info("WLAN being suspended by OS");
 
@@ -1627,6 +1628,7 @@ hdd_suspend_wlan(void)
 		return -EINVAL;
 	}
 
+	begin_us = qdf_get_log_timestamp_usecs();
 	hdd_for_each_adapter_dev_held_safe(hdd_ctx, adapter, next_adapter,
 					   NET_DEV_HOLD_SUSPEND_WLAN) {
 		hdd_adapter_for_each_active_link_info(adapter, link_info) {
@@ -1643,6 +1645,8 @@ hdd_suspend_wlan(void)
 		}
 		hdd_adapter_dev_put_debug(adapter, NET_DEV_HOLD_SUSPEND_WLAN);
 	}
+	ucfg_pmo_sr_latency_record(hdd_ctx->psoc, PMO_SR_STEP_OFFLOAD_CFG,
+				   QDF_SYSTEM_SUSPEND, begin_us);
 
 	status = ucfg_pmo_psoc_user_space_suspend_req(hdd_ctx->psoc,
 						      QDF_SYSTEM_SUSPEND);
@@ -1671,6 +1675,7 @@ static int hdd_resume_wlan(void)
 	struct hdd_adapter *adapter, *next_adapter = NULL;
 	QDF_STATUS status;
 	struct wlan_hdd_link_info *link_info;
+	uint64_t begin_us;
 
 	hdd_info("WLAN being resumed by OS");
 
@@ -1688,6 +1693,7 @@ static int hdd_resume_wlan(void)
 	hdd_wlan_suspend_resume_event(HDD_WLAN_EARLY_RESUME);
 
 	/*loop through all adapters. Concurrency */
+	begin_us = qdf_get_log_timestamp_usecs();
 	hdd_for_each_adapter_dev_held_safe(hdd_ctx, adapter, next_adapter,
 					   NET_DEV_HOLD_RESUME_WLAN) {
 		hdd_adapter_for_each_active_link_info(adapter, link_info) {
@@ -1705,6 +1711,8 @@ static int hdd_resume_wlan(void)
 		}
 		hdd_adapter_dev_put_debug(adapter, NET_DEV_HOLD_RESUME_WLAN);
 	}
+	ucfg_pmo_sr_latency_record(hdd_ctx->psoc, PMO_SR_STEP_OFFLOAD_RESTORE,
+				   QDF_SYSTEM_SUSPEND, begin_us);
 
 	ucfg_ipa_resume(hdd_ctx->pdev);
 	ucfg_dp_resume_wlan(hdd_ctx->psoc);
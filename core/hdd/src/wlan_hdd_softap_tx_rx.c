@@ -406,6 +406,7 @@ static QDF_STATUS hdd_sta_info_re_attach(
 	hdd_take_sta_info_ref(sta_info_container, sta_info, false,
 			      STA_INFO_ATTACH_DETACH);
 	qdf_mem_copy(&sta_info->sta_mac, sta_mac, sizeof(struct qdf_mac_addr));
+	hdd_sta_info_rehash(sta_info_container, sta_info, false);
 	sta_info->is_attached = true;
 	qdf_spin_unlock_bh(&sta_info_container->sta_obj_lock);
 
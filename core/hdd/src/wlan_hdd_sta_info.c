@@ -78,6 +78,125 @@ char *sta_info_string_from_dbgid(wlan_sta_info_dbgid id)
 	return (char *)strings[id];
 }
 
+static inline uint8_t hdd_sta_info_hash(const uint8_t *addr)
+{
+	/* the OUI bytes are shared by many clients, hash the NIC part */
+	return (addr[3] ^ (addr[4] << 1) ^ addr[5] ^ (addr[5] >> 4)) &
+	       (HDD_STA_INFO_HASH_SIZE - 1);
+}
+
+static inline struct qdf_mac_addr *
+hdd_sta_info_key_addr(struct hdd_station_info *sta_info,
+		      enum hdd_sta_info_key key)
+{
+	return key == HDD_STA_INFO_KEY_LINK ? &sta_info->sta_mac :
+					      &sta_info->mld_addr;
+}
+
+/**
+ * hdd_sta_info_hash_write_begin() - start changing the address hashes
+ * @sta_info_container: station info container
+ *
+ * Caller must hold sta_obj_lock.
+ *
+ * Return: None
+ */
+static inline void
+hdd_sta_info_hash_write_begin(struct hdd_sta_info_obj *sta_info_container)
+{
+	/* odd sequence count tells readers a miss may be a false one */
+	qdf_atomic_inc(&sta_info_container->hash_seq);
+	qdf_mb();
+}
+
+static inline void
+hdd_sta_info_hash_write_end(struct hdd_sta_info_obj *sta_info_container)
+{
+	qdf_mb();
+	qdf_atomic_inc(&sta_info_container->hash_seq);
+}
+
+/**
+ * hdd_sta_info_unhash() - remove a station from the address hashes
+ * @sta_info_container: station info container
+ * @sta_info: station to remove
+ *
+ * Caller must hold sta_obj_lock and be in a hash write section. The hash
+ * links of @sta_info are left intact for lockless readers standing on it.
+ *
+ * Return: None
+ */
+static void hdd_sta_info_unhash(struct hdd_sta_info_obj *sta_info_container,
+				struct hdd_station_info *sta_info)
+{
+	struct hdd_station_info **pprev;
+	enum hdd_sta_info_key key;
+
+	for (key = 0; key < HDD_STA_INFO_KEY_MAX; key++) {
+		if (!(sta_info->hashed & BIT(key)))
+			continue;
+
+		pprev = &sta_info_container->hash[key][sta_info->hash_idx[key]];
+		while (*pprev && *pprev != sta_info)
+			pprev = &(*pprev)->hash_next[key];
+		if (*pprev)
+			rcu_assign_pointer(*pprev, sta_info->hash_next[key]);
+	}
+
+	sta_info->hashed = 0;
+}
+
+/**
+ * hdd_sta_info_hash_add() - add a station to the address hashes
+ * @sta_info_container: station info container
+ * @sta_info: station to add, not on any hash
+ *
+ * Caller must hold sta_obj_lock and be in a hash write section. A station
+ * is hashed on its link address and, when it has one, on its MLD address.
+ *
+ * Return: None
+ */
+static void hdd_sta_info_hash_add(struct hdd_sta_info_obj *sta_info_container,
+				  struct hdd_station_info *sta_info)
+{
+	struct qdf_mac_addr *addr;
+	enum hdd_sta_info_key key;
+	uint8_t idx;
+
+	for (key = 0; key < HDD_STA_INFO_KEY_MAX; key++) {
+		addr = hdd_sta_info_key_addr(sta_info, key);
+		if (qdf_is_macaddr_zero(addr))
+			continue;
+
+		idx = hdd_sta_info_hash(addr->bytes);
+		sta_info->hash_idx[key] = idx;
+		sta_info->hash_next[key] = sta_info_container->hash[key][idx];
+		rcu_assign_pointer(sta_info_container->hash[key][idx], sta_info);
+		sta_info->hashed |= BIT(key);
+	}
+}
+
+void hdd_sta_info_rehash(struct hdd_sta_info_obj *sta_info_container,
+			 struct hdd_station_info *sta_info,
+			 bool lock_required)
+{
+	if (!sta_info_container || !sta_info) {
+		hdd_err("Parameter(s) null");
+		return;
+	}
+
+	if (lock_required)
+		qdf_spin_lock_bh(&sta_info_container->sta_obj_lock);
+
+	hdd_sta_info_hash_write_begin(sta_info_container);
+	hdd_sta_info_unhash(sta_info_container, sta_info);
+	hdd_sta_info_hash_add(sta_info_container, sta_info);
+	hdd_sta_info_hash_write_end(sta_info_container);
+
+	if (lock_required)
+		qdf_spin_unlock_bh(&sta_info_container->sta_obj_lock);
+}
+
 QDF_STATUS hdd_sta_info_init(struct hdd_sta_info_obj *sta_info_container)
 {
 	if (!sta_info_container) {
@@ -87,6 +206,9 @@ QDF_STATUS hdd_sta_info_init(struct hdd_sta_info_obj *sta_info_container)
 
 	qdf_spinlock_create(&sta_info_container->sta_obj_lock);
 	qdf_list_create(&sta_info_container->sta_obj, HDD_MAX_PEERS);
+	qdf_mem_zero(sta_info_container->hash,
+		     sizeof(sta_info_container->hash));
+	qdf_atomic_init(&sta_info_container->hash_seq);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -98,6 +220,8 @@ void hdd_sta_info_deinit(struct hdd_sta_info_obj *sta_info_container)
 		return;
 	}
 
+	/* wait for the stations freed after a grace period */
+	rcu_barrier();
 	qdf_list_destroy(&sta_info_container->sta_obj);
 	qdf_spinlock_destroy(&sta_info_container->sta_obj_lock);
 }
@@ -116,6 +240,12 @@ QDF_STATUS hdd_sta_info_attach(struct hdd_sta_info_obj *sta_info_container,
 			      STA_INFO_ATTACH_DETACH);
 	qdf_list_insert_front(&sta_info_container->sta_obj,
 			      &sta_info->sta_node);
+	/* the hash links may have been copied along with another sta_info */
+	qdf_mem_zero(sta_info->hash_next, sizeof(sta_info->hash_next));
+	sta_info->hashed = 0;
+	hdd_sta_info_hash_write_begin(sta_info_container);
+	hdd_sta_info_hash_add(sta_info_container, sta_info);
+	hdd_sta_info_hash_write_end(sta_info_container);
 	sta_info->is_attached = true;
 
 	qdf_spin_unlock_bh(&sta_info_container->sta_obj_lock);
@@ -183,12 +313,55 @@ struct hdd_station_info *hdd_get_sta_info_by_id(
 	return NULL;
 }
 
+/**
+ * hdd_sta_info_hash_find() - look a station up in the address hashes
+ * @sta_info_container: station info container
+ * @idx: hash bucket of @mac_addr
+ * @mac_addr: link or MLD address of the station
+ * @sta_info_dbgid: debug id the reference is taken for
+ *
+ * Caller must be in an RCU read side section. Stations whose last
+ * reference is gone are skipped, they are being freed.
+ *
+ * Return: station with a reference taken, NULL if not found
+ */
+static struct hdd_station_info *
+hdd_sta_info_hash_find(struct hdd_sta_info_obj *sta_info_container,
+		       uint8_t idx, const uint8_t *mac_addr,
+		       wlan_sta_info_dbgid sta_info_dbgid)
+{
+	struct hdd_station_info *sta_info;
+	enum hdd_sta_info_key key;
+
+	for (key = 0; key < HDD_STA_INFO_KEY_MAX; key++) {
+		for (sta_info = rcu_dereference(
+				sta_info_container->hash[key][idx]);
+		     sta_info;
+		     sta_info = rcu_dereference(sta_info->hash_next[key])) {
+			if (!qdf_is_macaddr_equal(
+					hdd_sta_info_key_addr(sta_info, key),
+					(struct qdf_mac_addr *)mac_addr))
+				continue;
+
+			if (!qdf_atomic_inc_not_zero(&sta_info->ref_cnt))
+				continue;
+
+			qdf_atomic_inc(&sta_info->ref_cnt_dbgid[sta_info_dbgid]);
+			return sta_info;
+		}
+	}
+
+	return NULL;
+}
+
 struct hdd_station_info *hdd_get_sta_info_by_mac(
 				struct hdd_sta_info_obj *sta_info_container,
 				const uint8_t *mac_addr,
 				wlan_sta_info_dbgid sta_info_dbgid)
 {
 	struct hdd_station_info *sta_info = NULL;
+	int32_t seq;
+	uint8_t idx;
 
 	if (!mac_addr || !sta_info_container ||
 	    qdf_is_macaddr_zero((struct qdf_mac_addr *)mac_addr)) {
@@ -196,23 +369,34 @@ struct hdd_station_info *hdd_get_sta_info_by_mac(
 		return NULL;
 	}
 
-	qdf_spin_lock_bh(&sta_info_container->sta_obj_lock);
-
-	qdf_list_for_each(&sta_info_container->sta_obj, sta_info, sta_node) {
-		if (qdf_is_macaddr_equal(&sta_info->sta_mac,
-					 (struct qdf_mac_addr *)mac_addr) ||
-		    qdf_is_macaddr_equal(&sta_info->mld_addr,
-					 (struct qdf_mac_addr *)mac_addr)) {
-			hdd_take_sta_info_ref(sta_info_container,
-					      sta_info, false, sta_info_dbgid);
-			qdf_spin_unlock_bh(&sta_info_container->sta_obj_lock);
-			return sta_info;
-		}
+	if (sta_info_dbgid >= STA_INFO_ID_MAX) {
+		hdd_err("Invalid sta_info debug id %d", sta_info_dbgid);
+		return NULL;
 	}
 
-	qdf_spin_unlock_bh(&sta_info_container->sta_obj_lock);
+	idx = hdd_sta_info_hash(mac_addr);
 
-	return NULL;
+	/*
+	 * A hit is always good. A station moved between buckets while the
+	 * walk was on it can hide the rest of a bucket, so a miss is only
+	 * trusted if no writer ran meanwhile.
+	 */
+	rcu_read_lock();
+	do {
+		seq = qdf_atomic_read(&sta_info_container->hash_seq);
+		if (seq & 1)
+			continue;
+		qdf_mb();
+		sta_info = hdd_sta_info_hash_find(sta_info_container, idx,
+						  mac_addr, sta_info_dbgid);
+		if (sta_info)
+			break;
+		qdf_mb();
+	} while ((seq & 1) ||
+		 qdf_atomic_read(&sta_info_container->hash_seq) != seq);
+	rcu_read_unlock();
+
+	return sta_info;
 }
 
 void hdd_take_sta_info_ref(struct hdd_sta_info_obj *sta_info_container,
@@ -240,6 +424,11 @@ void hdd_take_sta_info_ref(struct hdd_sta_info_obj *sta_info_container,
 		qdf_spin_unlock_bh(&sta_info_container->sta_obj_lock);
 }
 
+static void hdd_sta_info_free_rcu(struct rcu_head *rcu)
+{
+	qdf_mem_free(container_of(rcu, struct hdd_station_info, rcu));
+}
+
 void
 hdd_put_sta_info_ref(struct hdd_sta_info_obj *sta_info_container,
 		     struct hdd_station_info **sta_info, bool lock_required,
@@ -297,8 +486,12 @@ hdd_put_sta_info_ref(struct hdd_sta_info_obj *sta_info_container,
 		info->assoc_req_ies.len = 0;
 	}
 
+	hdd_sta_info_hash_write_begin(sta_info_container);
+	hdd_sta_info_unhash(sta_info_container, info);
+	hdd_sta_info_hash_write_end(sta_info_container);
 	qdf_list_remove_node(&sta_info_container->sta_obj, &info->sta_node);
-	qdf_mem_free(info);
+	/* lockless lookups may still be walking the hash links of info */
+	call_rcu(&info->rcu, hdd_sta_info_free_rcu);
 	*sta_info = NULL;
 
 	if (lock_required)
@@ -34,6 +34,7 @@
 #include "cdp_txrx_cmn_struct.h"
 #include "sir_mac_prot_def.h"
 #include <linux/ieee80211.h>
+#include <linux/rcupdate.h>
 #include <wlan_mlme_public_struct.h>
 
 /* Opaque handle for abstraction */
@@ -165,6 +166,21 @@ typedef enum {
  */
 char *sta_info_string_from_dbgid(wlan_sta_info_dbgid id);
 
+/* Number of buckets of each sta_info address hash, power of 2 */
+#define HDD_STA_INFO_HASH_SIZE 64
+
+/**
+ * enum hdd_sta_info_key - sta_info address a container is hashed on
+ * @HDD_STA_INFO_KEY_LINK: link address, sta_mac
+ * @HDD_STA_INFO_KEY_MLD: MLD address, mld_addr
+ * @HDD_STA_INFO_KEY_MAX: number of hashed addresses
+ */
+enum hdd_sta_info_key {
+	HDD_STA_INFO_KEY_LINK,
+	HDD_STA_INFO_KEY_MLD,
+	HDD_STA_INFO_KEY_MAX,
+};
+
 /**
  * struct hdd_station_info - Per station structure kept in HDD for
  *                                     multiple station support for SoftAP
@@ -248,6 +264,10 @@ char *sta_info_string_from_dbgid(wlan_sta_info_dbgid id);
  * @tx_pkt_per_mcs: Number of tx rate counts for each MCS
  * @rx_pkt_per_mcs: Number of rx rate counts for each MCS
  * @vlan_id: VLAN id
+ * @hash_next: next station in the same bucket of each address hash
+ * @hash_idx: bucket of each address hash the station is on
+ * @hashed: bitmap of the address hashes the station is on
+ * @rcu: frees the station once lockless hash readers are done with it
  */
 struct hdd_station_info {
 	qdf_list_node_t sta_node;
@@ -318,16 +338,27 @@ struct hdd_station_info {
 	uint32_t *tx_pkt_per_mcs;
 	uint32_t *rx_pkt_per_mcs;
 	uint16_t vlan_id;
+	struct hdd_station_info *hash_next[HDD_STA_INFO_KEY_MAX];
+	uint8_t hash_idx[HDD_STA_INFO_KEY_MAX];
+	uint8_t hashed;
+	struct rcu_head rcu;
 };
 
 /**
  * struct hdd_sta_info_obj - Station info container structure
  * @sta_obj: The sta info object that stores the sta_info
  * @sta_obj_lock: Lock to protect the sta_obj read/write access
+ * @hash: sta_info hashed on the link and on the MLD address, for lookup by
+ *        MAC address. Changed under @sta_obj_lock, read under RCU.
+ * @hash_seq: odd while @hash is being changed, lookups which miss retry
+ *            when it moved
  */
 struct hdd_sta_info_obj {
 	qdf_list_t sta_obj;
 	qdf_spinlock_t sta_obj_lock;
+	struct hdd_station_info *hash[HDD_STA_INFO_KEY_MAX]
+				    [HDD_STA_INFO_HASH_SIZE];
+	qdf_atomic_t hash_seq;
 };
 
 /**
@@ -549,6 +580,9 @@ struct hdd_station_info *hdd_get_sta_info_by_id(
  * @mac_addr: The mac addr by which the sta_info has to be fetched.
  * @sta_info_dbgid: Debug ID of the caller API
  *
+ * Does not take sta_obj_lock, a station whose last reference is being
+ * dropped is not returned.
+ *
  * Return: Pointer to the hdd_station_info structure which contains the mac
  *         address passed
  */
@@ -557,6 +591,23 @@ struct hdd_station_info *hdd_get_sta_info_by_mac(
 				const uint8_t *mac_addr,
 				wlan_sta_info_dbgid sta_info_dbgid);
 
+/**
+ * hdd_sta_info_rehash() - Update the address hash of a station
+ * @sta_info_container: The station info container obj that stores and maintains
+ *                      the sta_info obj.
+ * @sta_info: The attached station whose link or MLD address has changed
+ * @lock_required: Flag to acquire lock or not
+ *
+ * Must be called after sta_mac or mld_addr of a station that is in the
+ * container is changed, for hdd_get_sta_info_by_mac() to find it by the new
+ * address.
+ *
+ * Return: None
+ */
+void hdd_sta_info_rehash(struct hdd_sta_info_obj *sta_info_container,
+			 struct hdd_station_info *sta_info,
+			 bool lock_required);
+
 /**
  * hdd_clear_cached_sta_info() - Clear the cached sta info from the container
  * @hdd_adapter: The adapter containing the station info container obj that
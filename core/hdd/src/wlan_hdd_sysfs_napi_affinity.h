@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_sysfs_napi_affinity.h
+ *
+ * Implementation to add sysfs node napi_affinity
+ */
+
+#ifndef _WLAN_HDD_SYSFS_NAPI_AFFINITY_H
+#define _WLAN_HDD_SYSFS_NAPI_AFFINITY_H
+
+#if defined(WLAN_SYSFS) && defined(CONFIG_WLAN_SYSFS_NAPI_AFFINITY)
+/**
+ * hdd_sysfs_napi_affinity_create() - Function to create napi_affinity
+ * sysfs node to dump the datapath CPU affinity manager decisions
+ * @wlan_kobject: sysfs wlan kobject
+ *
+ * file path: /sys/kernel/wifi/wlan/napi_affinity
+ *
+ * usage: cat /sys/kernel/wifi/wlan/napi_affinity
+ *
+ * Return: 0 on success and errno on failure
+ */
+int hdd_sysfs_napi_affinity_create(struct kobject *wlan_kobject);
+
+/**
+ * hdd_sysfs_napi_affinity_destroy() - API to destroy napi_affinity
+ * @wlan_kobject: sysfs wlan kobject
+ *
+ * Return: none
+ */
+void hdd_sysfs_napi_affinity_destroy(struct kobject *wlan_kobject);
+#else
+static inline int
+hdd_sysfs_napi_affinity_create(struct kobject *wlan_kobject)
+{
+	return 0;
+}
+
+static inline void
+hdd_sysfs_napi_affinity_destroy(struct kobject *wlan_kobject)
+{
+}
+#endif /* WLAN_SYSFS && CONFIG_WLAN_SYSFS_NAPI_AFFINITY */
+#endif /* _WLAN_HDD_SYSFS_NAPI_AFFINITY_H */
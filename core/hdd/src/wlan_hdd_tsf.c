@@ -918,18 +918,6 @@ enum hdd_tsf_op_result __hdd_stop_tsf_sync(struct hdd_adapter *adapter)
 	return HDD_TSF_OP_SUCC;
 }
 
-static inline void hdd_reset_timestamps(struct hdd_adapter *adapter)
-{
-	struct hdd_vdev_tsf *tsf = &adapter->tsf;
-
-	qdf_spin_lock_bh(&tsf->host_target_sync_lock);
-	tsf->cur_host_time = 0;
-	tsf->cur_target_time = 0;
-	tsf->last_host_time = 0;
-	tsf->last_target_time = 0;
-	qdf_spin_unlock_bh(&tsf->host_target_sync_lock);
-}
-
 /**
  * hdd_check_timestamp_status() - return the tstamp status
  * @last_target_time: the last saved target time
@@ -1048,34 +1036,330 @@ static inline int hdd_uint64_minus(uint64_t x, uint64_t y, uint64_t *ret)
 	return 0;
 }
 
+/**
+ * hdd_tsf_conv_fit() - least squares fit of the recent capture pairs
+ * @tsf: vdev tsf context, conv_samples must hold at least one pair
+ * @conv: filled with the fitted conversion
+ *
+ * The deviation of each pair from the nominal 1000 ns/us relative to the
+ * newest pair is regressed against the target time (in ms to keep the
+ * sums within 64 bits). With a single pair this degenerates to the legacy
+ * fixed ratio mapping anchored on that pair.
+ *
+ * Return: None
+ */
+static void hdd_tsf_conv_fit(struct hdd_vdev_tsf *tsf,
+			     struct hdd_tsf_conv *conv)
+{
+	struct hdd_tsf_conv_sample *ref, *sample;
+	int64_t dx[HDD_TSF_CONV_SAMPLES], err[HDD_TSF_CONV_SAMPLES];
+	int64_t sum_dx = 0, sum_err = 0, sxx = 0, sxe = 0;
+	int64_t mean_dx, mean_err, x, den;
+	uint8_t i, n = tsf->conv_num_samples;
+	int shift;
+
+	ref = &tsf->conv_samples[(tsf->conv_next + HDD_TSF_CONV_SAMPLES - 1) %
+				 HDD_TSF_CONV_SAMPLES];
+	conv->base_target = ref->target;
+	conv->base_host = ref->host;
+	conv->drift_q32 = 0;
+	if (n < 2)
+		return;
+
+	for (i = 0; i < n; i++) {
+		sample = &tsf->conv_samples[i];
+		dx[i] = (int64_t)(sample->target - ref->target);
+		err[i] = (int64_t)(sample->host - ref->host) -
+			 dx[i] * NSEC_PER_USEC;
+		sum_dx += dx[i];
+		sum_err += err[i];
+	}
+	mean_dx = div_s64(sum_dx, n);
+	mean_err = div_s64(sum_err, n);
+
+	for (i = 0; i < n; i++) {
+		x = div_s64(dx[i] - mean_dx, USEC_PER_MSEC);
+		sxx += x * x;
+		sxe += x * (err[i] - mean_err);
+	}
+	if (sxx <= 0)
+		return;
+
+	/*
+	 * drift_q32 = (sxe << 32) / (sxx * 1000); shift the numerator up as
+	 * far as it fits and the denominator down by the rest.
+	 */
+	den = sxx * USEC_PER_MSEC;
+	for (shift = 0; shift < 32; shift++)
+		if (abs(sxe) > (S64_MAX >> (shift + 1)))
+			break;
+	den >>= 32 - shift;
+	if (!den)
+		return;
+
+	conv->drift_q32 = div64_s64(sxe * ((int64_t)1 << shift), den);
+	/* the fitted line passes through the centroid of the pairs */
+	conv->base_host += mean_err - ((conv->drift_q32 * mean_dx) >> 32);
+}
+
+/**
+ * hdd_tsf_conv_map() - map a target time with a published conversion
+ * @conv: conversion to use
+ * @delta_target: target time relative to conv->base_target, us
+ * @host_time: mapped host time, ns
+ *
+ * Return: 0 on success, -EINVAL on overflow
+ */
+static inline int hdd_tsf_conv_map(const struct hdd_tsf_conv *conv,
+				   int64_t delta_target, uint64_t *host_time)
+{
+	int64_t delta_host;
+
+	delta_host = delta_target * NSEC_PER_USEC +
+		     ((conv->drift_q32 * delta_target) >> 32);
+
+	return hdd_64bit_plus(conv->base_host, delta_host, host_time);
+}
+
+/**
+ * hdd_tsf_conv_publish() - publish a new conversion to the readers
+ * @tsf: vdev tsf context
+ * @conv: conversion to publish
+ *
+ * Caller must hold host_target_sync_lock, which serializes the writers.
+ *
+ * Return: None
+ */
+static void hdd_tsf_conv_publish(struct hdd_vdev_tsf *tsf,
+				 const struct hdd_tsf_conv *conv)
+{
+	/* odd sequence count tells readers the copy below is in progress */
+	qdf_atomic_inc(&tsf->conv_seq);
+	qdf_mb();
+	tsf->conv = *conv;
+	qdf_mb();
+	qdf_atomic_inc(&tsf->conv_seq);
+}
+
+/**
+ * hdd_tsf_conv_get() - get a consistent copy of the published conversion
+ * @tsf: vdev tsf context
+ * @domain: time domains the caller converts between
+ * @conv: filled with the published conversion
+ *
+ * Never takes host_target_sync_lock, the copy is retried until no writer
+ * raced with it. Writers publish with bottom halves disabled and only copy
+ * a few words, so a reader spins at most for one publish.
+ *
+ * Return: true if a conversion for @domain is published
+ */
+static bool hdd_tsf_conv_get(struct hdd_vdev_tsf *tsf,
+			     enum hdd_tsf_conv_domain domain,
+			     struct hdd_tsf_conv *conv)
+{
+	int32_t seq;
+
+	do {
+		seq = qdf_atomic_read(&tsf->conv_seq);
+		if (seq & 1)
+			continue;
+		qdf_mb();
+		*conv = tsf->conv;
+		qdf_mb();
+	} while ((seq & 1) || qdf_atomic_read(&tsf->conv_seq) != seq);
+
+	return conv->domain == domain;
+}
+
+/**
+ * hdd_tsf_conv_reset() - drop the capture pairs and the conversion
+ * @tsf: vdev tsf context
+ *
+ * Caller must hold host_target_sync_lock.
+ *
+ * Return: None
+ */
+static void hdd_tsf_conv_reset(struct hdd_vdev_tsf *tsf)
+{
+	struct hdd_tsf_conv conv = { .domain = HDD_TSF_CONV_NONE };
+
+	tsf->conv_num_samples = 0;
+	tsf->conv_next = 0;
+	hdd_tsf_conv_publish(tsf, &conv);
+}
+
+/**
+ * hdd_tsf_conv_update_stats() - account the residual of a new capture pair
+ * @tsf: vdev tsf context
+ * @target: target time of the new pair, us
+ * @host: host time of the new pair, ns
+ *
+ * The residual is taken against the conversion currently published, the
+ * nominal residual against the fixed ratio mapping of the newest pair.
+ *
+ * Return: None
+ */
+static void hdd_tsf_conv_update_stats(struct hdd_vdev_tsf *tsf,
+				      uint64_t target, uint64_t host)
+{
+	struct hdd_tsf_conv_stats *stats = &tsf->conv_stats;
+	struct hdd_tsf_conv_sample *last;
+	struct hdd_tsf_conv nominal;
+	uint64_t predicted, abs_ns;
+
+	if (!tsf->conv_num_samples)
+		return;
+
+	if (hdd_tsf_conv_map(&tsf->conv,
+			     (int64_t)(target - tsf->conv.base_target),
+			     &predicted))
+		return;
+
+	stats->last_ns = (int64_t)(host - predicted);
+	abs_ns = abs(stats->last_ns);
+	stats->samples++;
+	stats->sum_abs_ns += abs_ns;
+	if (abs_ns > stats->max_abs_ns)
+		stats->max_abs_ns = abs_ns;
+
+	last = &tsf->conv_samples[(tsf->conv_next + HDD_TSF_CONV_SAMPLES - 1) %
+				  HDD_TSF_CONV_SAMPLES];
+	nominal.base_target = last->target;
+	nominal.base_host = last->host;
+	nominal.drift_q32 = 0;
+	if (hdd_tsf_conv_map(&nominal, (int64_t)(target - last->target),
+			     &predicted))
+		return;
+
+	abs_ns = abs((int64_t)(host - predicted));
+	if (abs_ns > stats->nominal_max_abs_ns)
+		stats->nominal_max_abs_ns = abs_ns;
+}
+
+/**
+ * hdd_tsf_conv_add_sample() - add a capture pair and refit the conversion
+ * @tsf: vdev tsf context
+ * @domain: time domains of the pair
+ * @target: target time, us
+ * @host: host time, ns
+ * @restart: pair is not continuous with the previous ones
+ *
+ * Caller must hold host_target_sync_lock.
+ *
+ * Return: None
+ */
+static void hdd_tsf_conv_add_sample(struct hdd_vdev_tsf *tsf,
+				    enum hdd_tsf_conv_domain domain,
+				    uint64_t target, uint64_t host,
+				    bool restart)
+{
+	struct hdd_tsf_conv_sample *last;
+	struct hdd_tsf_conv conv;
+
+	if (restart || tsf->conv.domain != domain)
+		tsf->conv_num_samples = 0;
+
+	if (tsf->conv_num_samples) {
+		last = &tsf->conv_samples[(tsf->conv_next +
+					   HDD_TSF_CONV_SAMPLES - 1) %
+					  HDD_TSF_CONV_SAMPLES];
+		/* at present, target_time is only 32bit in fact */
+		if (domain == HDD_TSF_CONV_TARGET32_HOST)
+			target = last->target +
+				 ((target - last->target) & U32_MAX);
+		if (target <= last->target || host <= last->host)
+			tsf->conv_num_samples = 0;
+	}
+
+	hdd_tsf_conv_update_stats(tsf, target, host);
+
+	if (!tsf->conv_num_samples)
+		tsf->conv_next = 0;
+	tsf->conv_samples[tsf->conv_next].target = target;
+	tsf->conv_samples[tsf->conv_next].host = host;
+	tsf->conv_next = (tsf->conv_next + 1) % HDD_TSF_CONV_SAMPLES;
+	if (tsf->conv_num_samples < HDD_TSF_CONV_SAMPLES)
+		tsf->conv_num_samples++;
+
+	hdd_tsf_conv_fit(tsf, &conv);
+	conv.domain = domain;
+	hdd_tsf_conv_publish(tsf, &conv);
+	hdd_debug("tsf conv: samples %u drift_q32 %lld residual %lld ns",
+		  tsf->conv_num_samples, conv.drift_q32,
+		  tsf->conv_stats.last_ns);
+}
+
+static inline void hdd_reset_timestamps(struct hdd_adapter *adapter)
+{
+	struct hdd_vdev_tsf *tsf = &adapter->tsf;
+
+	qdf_spin_lock_bh(&tsf->host_target_sync_lock);
+	tsf->cur_host_time = 0;
+	tsf->cur_target_time = 0;
+	tsf->last_host_time = 0;
+	tsf->last_target_time = 0;
+	hdd_tsf_conv_reset(tsf);
+	qdf_mem_zero(&tsf->conv_stats, sizeof(tsf->conv_stats));
+	qdf_spin_unlock_bh(&tsf->host_target_sync_lock);
+}
+
+/**
+ * hdd_tsf_conv_stats_show() - append the conversion residual statistics
+ * @adapter: pointer to adapter
+ * @buf: sysfs buffer
+ * @size: bytes already written to @buf
+ *
+ * Return: total bytes written to @buf
+ */
+static ssize_t hdd_tsf_conv_stats_show(struct hdd_adapter *adapter,
+				       char *buf, ssize_t size)
+{
+	struct hdd_vdev_tsf *tsf = &adapter->tsf;
+	struct hdd_tsf_conv_stats stats;
+	struct hdd_tsf_conv conv;
+	uint64_t avg_ns = 0;
+
+	qdf_spin_lock_bh(&tsf->host_target_sync_lock);
+	stats = tsf->conv_stats;
+	conv = tsf->conv;
+	qdf_spin_unlock_bh(&tsf->host_target_sync_lock);
+
+	if (stats.samples)
+		avg_ns = div_u64(stats.sum_abs_ns, stats.samples);
+
+	return size + scnprintf(buf + size, PAGE_SIZE - size,
+				"conv: samples %u last %lld max %llu avg %llu nominal_max %llu drift_ppb %lld\n",
+				stats.samples, stats.last_ns,
+				stats.max_abs_ns, avg_ns,
+				stats.nominal_max_abs_ns,
+				(conv.drift_q32 * 1000000) >> 32);
+}
+
 static inline int32_t hdd_get_hosttime_from_targettime(
 	struct hdd_adapter *adapter, uint64_t target_time,
 	uint64_t *host_time)
 {
 	struct hdd_vdev_tsf *tsf;
-	int32_t ret = -EINVAL;
 	int64_t delta32_target;
-	bool in_cap_state;
 	int64_t normal_interval_target;
+	struct hdd_tsf_conv conv;
 
-	in_cap_state = hdd_tsf_is_in_cap(adapter);
 	tsf = &adapter->tsf;
 
+	normal_interval_target = WLAN_HDD_CAPTURE_TSF_INTERVAL_SEC *
+		qdf_do_div(NSEC_PER_SEC, HOST_TO_TARGET_TIME_RATIO);
+
 	/*
-	 * To avoid check the lock when it's not capturing tsf
-	 * (the tstamp-pair won't be changed)
+	 * Every capture pair is published with the fit, so this is the same
+	 * pair the legacy mapping used, also while a capture is in progress.
 	 */
-	if (in_cap_state)
-		qdf_spin_lock_bh(&tsf->host_target_sync_lock);
+	if (!hdd_tsf_conv_get(tsf, HDD_TSF_CONV_TARGET32_HOST, &conv))
+		return -EINVAL;
 
 	hdd_wlan_restart_tsf_cap(adapter);
 	/* at present, target_time is only 32bit in fact */
 	delta32_target = (int64_t)((target_time & U32_MAX) -
-			(tsf->last_target_time & U32_MAX));
-
-	normal_interval_target = WLAN_HDD_CAPTURE_TSF_INTERVAL_SEC *
-		qdf_do_div(NSEC_PER_SEC, HOST_TO_TARGET_TIME_RATIO);
-
+			(conv.base_target & U32_MAX));
 	if (delta32_target <
 			(normal_interval_target - OVERFLOW_INDICATOR32))
 		delta32_target += OVERFLOW_INDICATOR32;
@@ -1083,14 +1367,7 @@ static inline int32_t hdd_get_hosttime_from_targettime(
 			(OVERFLOW_INDICATOR32 - normal_interval_target))
 		delta32_target -= OVERFLOW_INDICATOR32;
 
-	ret = hdd_64bit_plus(tsf->last_host_time,
-			     HOST_TO_TARGET_TIME_RATIO * delta32_target,
-			     host_time);
-
-	if (in_cap_state)
-		qdf_spin_unlock_bh(&tsf->host_target_sync_lock);
-
-	return ret;
+	return hdd_tsf_conv_map(&conv, delta32_target, host_time);
 }
 
 static inline int32_t hdd_get_targettime_from_hosttime(
@@ -1148,44 +1425,17 @@ static inline int32_t hdd_get_soctime_from_tsf64time(
 	uint64_t *soc_time)
 {
 	struct hdd_vdev_tsf *tsf;
-	int32_t ret = -EINVAL;
-	uint64_t delta64_tsf64time;
-	uint64_t delta64_soctime;
-	bool in_cap_state;
+	struct hdd_tsf_conv conv;
 
-	in_cap_state = hdd_tsf_is_in_cap(adapter);
 	tsf = &adapter->tsf;
 
-	/*
-	 * To avoid check the lock when it's not capturing tsf
-	 * (the tstamp-pair won't be changed)
-	 */
-	if (in_cap_state)
-		qdf_spin_lock_bh(&tsf->host_target_sync_lock);
-
-	/* at present, target_time is 64bit (g_tsf64), us*/
-	if (tsf64_time > tsf->last_target_global_tsf_time) {
-		delta64_tsf64time = tsf64_time -
-				    tsf->last_target_global_tsf_time;
-		delta64_soctime = delta64_tsf64time * NSEC_PER_USEC;
-
-		/* soc_time (ns)*/
-		ret = hdd_uint64_plus(tsf->last_tsf_sync_soc_time,
-				      delta64_soctime, soc_time);
-	} else {
-		delta64_tsf64time = tsf->last_target_global_tsf_time -
-				    tsf64_time;
-		delta64_soctime = delta64_tsf64time * NSEC_PER_USEC;
-
-		/* soc_time (ns)*/
-		ret = hdd_uint64_minus(tsf->last_tsf_sync_soc_time,
-				       delta64_soctime, soc_time);
-	}
-
-	if (in_cap_state)
-		qdf_spin_unlock_bh(&tsf->host_target_sync_lock);
+	/* lockless, also while a capture is in progress */
+	if (!hdd_tsf_conv_get(tsf, HDD_TSF_CONV_TSF64_SOC, &conv))
+		return -EINVAL;
 
-	return ret;
+	/* at present, target_time is 64bit (g_tsf64), us */
+	return hdd_tsf_conv_map(&conv, (int64_t)(tsf64_time - conv.base_target),
+				soc_time);
 }
 
 /**
@@ -1697,6 +1947,7 @@ static void hdd_update_timestamp(struct hdd_adapter *adapter)
 	int interval = 0;
 	enum hdd_ts_status sync_status;
 	struct hdd_vdev_tsf *tsf;
+	bool conv_restart = false;
 
 	if (!adapter)
 		return;
@@ -1732,6 +1983,7 @@ static void hdd_update_timestamp(struct hdd_adapter *adapter)
 		hdd_debug("Reach the max continuous error count");
 
 		/* If reach MAX_CONTINUOUS_ERROR_CNT, treat it as valid pair */
+		conv_restart = true;
 		fallthrough;
 	case HDD_TS_STATUS_READY:
 		tsf->last_target_time = tsf->cur_target_time;
@@ -1739,6 +1991,10 @@ static void hdd_update_timestamp(struct hdd_adapter *adapter)
 			tsf->cur_target_global_tsf_time;
 		tsf->last_tsf_sync_soc_time =
 				tsf->cur_tsf_sync_soc_time;
+		hdd_tsf_conv_add_sample(tsf, HDD_TSF_CONV_TSF64_SOC,
+					tsf->last_target_global_tsf_time,
+					tsf->last_tsf_sync_soc_time,
+					conv_restart);
 		tsf->cur_target_time = 0;
 		tsf->cur_target_global_tsf_time = 0;
 		tsf->cur_tsf_sync_soc_time = 0;
@@ -1846,7 +2102,7 @@ static ssize_t __hdd_wlan_tsf_show(struct device *dev,
 				 qtime, host_time, target_time);
 	}
 
-	return size;
+	return hdd_tsf_conv_stats_show(adapter, buf, size);
 }
 
 static inline void hdd_update_tsf(struct hdd_adapter *adapter, uint64_t tsf)
@@ -1863,6 +2119,7 @@ static void hdd_update_timestamp(struct hdd_adapter *adapter,
 	int interval = 0;
 	enum hdd_ts_status sync_status;
 	struct hdd_vdev_tsf	*tsf;
+	bool conv_restart = false;
 	if (!adapter)
 		return;
 	tsf = &adapter->tsf;
@@ -1906,9 +2163,13 @@ static void hdd_update_timestamp(struct hdd_adapter *adapter,
 		 * If reach MAX_CONTINUOUS_ERROR_CNT, treat it as a
 		 * valid pair
 		 */
+		conv_restart = true;
 	case HDD_TS_STATUS_READY:
 		tsf->last_target_time = tsf->cur_target_time;
 		tsf->last_host_time = tsf->cur_host_time;
+		hdd_tsf_conv_add_sample(tsf, HDD_TSF_CONV_TARGET32_HOST,
+					tsf->last_target_time,
+					tsf->last_host_time, conv_restart);
 		tsf->cur_target_time = 0;
 		tsf->cur_host_time = 0;
 		hdd_debug("ts-pair updated: target: %llu; host: %llu",
@@ -2004,6 +2265,7 @@ static ssize_t __hdd_wlan_tsf_show(struct device *dev,
 					 buf, target_time, host_time,
 					 QDF_MAC_ADDR_REF(mac));
 		}
+		size = hdd_tsf_conv_stats_show(adapter, buf, size);
 	}
 
 	return size;
@@ -34,6 +34,15 @@
 #include "qdf_tracker_test.h"
 #include "qdf_types_test.h"
 #include "wlan_dsc_test.h"
+#include "wlan_dp_apf_test.h"
+#include "wlan_dp_pkt_class_test.h"
+#include "wlan_dp_stall_corr_test.h"
+#include "wlan_dp_stats_sampler_test.h"
+#include "wlan_policy_mgr_test.h"
+#include "ol_rx_pn_test.h"
+#include "ol_rx_defrag_test.h"
+#include "ol_tx_peer_bal_test.h"
+#include "lim_session_test.h"
 #include "wlan_hdd_unit_test.h"
 
 typedef uint32_t (*hdd_ut_callback)(void);
@@ -45,6 +54,16 @@ struct hdd_ut_entry {
 
 struct hdd_ut_entry hdd_ut_entries[] = {
 	{ .name = "dsc", .callback = dsc_unit_test },
+	{ .name = "dp_host_apf", .callback = dp_apf_unit_test },
+	{ .name = "dp_pkt_class", .callback = dp_pkt_class_unit_test },
+	{ .name = "dp_stall_corr", .callback = dp_stall_corr_unit_test },
+	{ .name = "dp_stats_sampler", .callback = dp_stats_sampler_unit_test },
+	{ .name = "policy_mgr", .callback = policy_mgr_unit_test },
+	{ .name = "ol_rx_pn", .callback = ol_rx_pn_unit_test },
+	{ .name = "ol_rx_defrag", .callback = ol_rx_defrag_unit_test },
+	{ .name = "ol_tx_peer_bal", .callback = ol_tx_peer_bal_unit_test },
+	{ .name = "pe_session_lookup",
+	  .callback = pe_session_lookup_unit_test },
 	{ .name = "qdf_delayed_work", .callback = qdf_delayed_work_unit_test },
 	{ .name = "qdf_ht", .callback = qdf_ht_unit_test },
 	{ .name = "qdf_periodic_work",
@@ -559,10 +559,13 @@ struct lim_context {
 	/* wsc info required to form the wsc IE */
 	tLimWscIeInfo wscIeInfo;
 	struct pe_session *gpSession;  /* Pointer to  session table */
+	struct dph_peer_index peer_index;
+	struct pe_session_index session_index;
 	uint8_t max_sta_of_pe_session;
 
 	qdf_mutex_t lim_frame_register_lock;
 	qdf_list_t gLimMgmtFrameRegistratinQueue;
+	struct lim_mgmt_frm_matcher *mgmt_frm_matcher;
 	uint32_t tdls_frm_session_id;
 
 	struct pe_session *pe_session;
@@ -585,12 +588,39 @@ struct lim_context {
 
 struct mgmt_frm_reg_info {
 	qdf_list_node_t node;   /* MUST be first element */
+	uint32_t hits;
 	uint16_t frameType;
 	uint16_t matchLen;
 	uint16_t sessionId;
 	uint8_t matchData[1];
 };
 
+/* one bucket per 2-bit frame type and 4-bit subtype, frameType >> 2 */
+#define LIM_MGMT_MATCH_FRM_KEYS		64
+#define LIM_MGMT_MATCH_ACTION_CATS	256
+#define LIM_MGMT_MATCH_BUCKETS \
+	(LIM_MGMT_MATCH_FRM_KEYS + LIM_MGMT_MATCH_ACTION_CATS)
+
+/**
+ * struct lim_mgmt_frm_matcher - compiled management frame registrations
+ * @num_regs: number of registrations compiled in
+ * @bucket: first @entry of every bucket, bucket i spans
+ *	[bucket[i], bucket[i + 1])
+ * @entry: registrations that can match the frames of each bucket, in
+ *	registration list order
+ *
+ * Frames are bucketed by type/subtype. Action frames that carry a category
+ * are bucketed by category instead, after the type/subtype buckets. A
+ * registration is compiled into every bucket it can match, including the
+ * SIR_MAC_MGMT_RESERVED15 wildcard, so the first entry of a bucket that
+ * matches is the one the registration list walk used to find.
+ */
+struct lim_mgmt_frm_matcher {
+	uint16_t num_regs;
+	uint32_t bucket[LIM_MGMT_MATCH_BUCKETS + 1];
+	struct mgmt_frm_reg_info *entry[];
+};
+
 typedef struct sRrmContext {
 	struct rrm_config_param rrmConfig;
 	tRrmSMEContext rrmSmeContext[MAX_MEASUREMENT_REQUEST];
@@ -41,6 +41,9 @@ void dph_hash_table_init(struct mac_context *mac,
 {
 	uint16_t i;
 
+	/* Nodes still added belong to peers of a stopped BSS */
+	dph_peer_index_flush(mac, hash_table);
+
 	for (i = 0; i < hash_table->size; i++) {
 		hash_table->pHashTable[i] = 0;
 	}
@@ -53,33 +56,153 @@ void dph_hash_table_init(struct mac_context *mac,
 
 }
 
-/* --------------------------------------------------------------------- */
+#define dph_rol32(word, shift) \
+	(((word) << (shift)) | ((word) >> (32 - (shift))))
+
 /**
- * hash_function
- *
- * FUNCTION:
- * Hashing function
- *
- * LOGIC:
- *
- * ASSUMPTIONS:
+ * dph_mac_hash() - Keyed hash of a MAC address
+ * @seed: hash seed
+ * @addr: MAC address
  *
- * NOTE:
+ * Uses the final mix of Bob Jenkins' lookup3 hash (as done by jhash) so
+ * that peers sharing an OUI, or only differing in a few bits, spread over
+ * all buckets instead of the narrow range a byte sum produces.
  *
- * @param staAddr MAC address of the station
- * @return None
+ * Return: 32 bit hash value
  */
+static uint32_t dph_mac_hash(uint32_t seed, const uint8_t *addr)
+{
+	uint32_t a, b, c;
+
+	a = 0xdeadbeef + QDF_MAC_ADDR_SIZE + seed;
+	b = a;
+	c = a;
+
+	a += addr[0] | addr[1] << 8 | addr[2] << 16 | (uint32_t)addr[3] << 24;
+	b += addr[4] | addr[5] << 8;
+
+	c ^= b;
+	c -= dph_rol32(b, 14);
+	a ^= c;
+	a -= dph_rol32(c, 11);
+	b ^= a;
+	b -= dph_rol32(a, 25);
+	c ^= b;
+	c -= dph_rol32(b, 16);
+	a ^= c;
+	a -= dph_rol32(c, 4);
+	b ^= a;
+	b -= dph_rol32(a, 14);
+	c ^= b;
+	c -= dph_rol32(b, 24);
+
+	return c;
+}
 
+/**
+ * hash_function() - Bucket of a station in a per session DPH table
+ * @mac: Global MAC Context
+ * @staAddr: MAC address of the station
+ * @numSta: size of the table
+ *
+ * Return: bucket index
+ */
 static uint16_t hash_function(struct mac_context *mac, uint8_t staAddr[],
 			      uint16_t numSta)
 {
-	int i;
-	uint16_t sum = 0;
+	return dph_mac_hash(mac->lim.peer_index.seed, staAddr) % numSta;
+}
 
-	for (i = 0; i < 6; i++)
-		sum += staAddr[i];
+static inline uint32_t dph_peer_index_bucket(struct dph_peer_index *index,
+					     const uint8_t *addr)
+{
+	return dph_mac_hash(index->seed, addr) & (DPH_PEER_INDEX_SIZE - 1);
+}
 
-	return sum % numSta;
+void dph_peer_index_init(struct dph_peer_index *peer_index)
+{
+	qdf_mem_zero(peer_index, sizeof(*peer_index));
+	qdf_get_random_bytes(&peer_index->seed, sizeof(peer_index->seed));
+}
+
+static void dph_peer_index_add(struct dph_hash_table *hash_table,
+			       tpDphHashNode node)
+{
+	struct dph_peer_index *index = hash_table->peer_index;
+	uint32_t bucket;
+
+	if (!index)
+		return;
+
+	bucket = dph_peer_index_bucket(index, node->staAddr);
+	node->pe_session_id = hash_table->session_id;
+	node->peer_index_next = index->bucket[bucket];
+	index->bucket[bucket] = node;
+	index->count++;
+}
+
+static void dph_peer_index_del(struct dph_hash_table *hash_table,
+			       tpDphHashNode node)
+{
+	struct dph_peer_index *index = hash_table->peer_index;
+	tpDphHashNode *link;
+
+	if (!index)
+		return;
+
+	link = &index->bucket[dph_peer_index_bucket(index, node->staAddr)];
+	for (; *link; link = &(*link)->peer_index_next) {
+		if (*link != node)
+			continue;
+		*link = node->peer_index_next;
+		node->peer_index_next = NULL;
+		index->count--;
+		return;
+	}
+
+	pe_err("STA "QDF_MAC_ADDR_FMT" missing from peer index",
+	       QDF_MAC_ADDR_REF(node->staAddr));
+}
+
+tpDphHashNode dph_peer_index_lookup(struct mac_context *mac, uint8_t *addr,
+				    uint8_t *session_id, uint16_t *assoc_id)
+{
+	struct dph_peer_index *index = &mac->lim.peer_index;
+	tpDphHashNode node, found = NULL;
+
+	/*
+	 * A peer may be added to more than one session, return the one of
+	 * the lowest PE session id like a scan of the session table does.
+	 */
+	node = index->bucket[dph_peer_index_bucket(index, addr)];
+	for (; node; node = node->peer_index_next) {
+		if (!dph_compare_mac_addr(addr, node->staAddr))
+			continue;
+		if (!found || node->pe_session_id < found->pe_session_id)
+			found = node;
+	}
+
+	if (found) {
+		*session_id = found->pe_session_id;
+		*assoc_id = found->assocId;
+	}
+
+	return found;
+}
+
+void dph_peer_index_flush(struct mac_context *mac,
+			  struct dph_hash_table *hash_table)
+{
+	uint16_t i;
+
+	if (!hash_table->pDphNodeArray)
+		return;
+
+	for (i = 0; i < hash_table->size; i++) {
+		if (hash_table->pDphNodeArray[i].added)
+			dph_peer_index_del(hash_table,
+					   &hash_table->pDphNodeArray[i]);
+	}
 }
 
 /* --------------------------------------------------------------------- */
@@ -175,7 +298,8 @@ tpDphHashNode dph_init_sta_state(struct mac_context *mac, tSirMacAddr staAddr,
 				 uint16_t assocId,
 				 struct dph_hash_table *hash_table)
 {
-	tpDphHashNode sta, pnext;
+	tpDphHashNode sta, pnext, peer_index_next;
+	uint8_t pe_session_id;
 
 	if (assocId >= hash_table->size) {
 		pe_err("Invalid Assoc Id %d", assocId);
@@ -184,10 +308,14 @@ tpDphHashNode dph_init_sta_state(struct mac_context *mac, tSirMacAddr staAddr,
 
 	sta = get_node(mac, (uint8_t) assocId, hash_table);
 	pnext = sta->next;
+	peer_index_next = sta->peer_index_next;
+	pe_session_id = sta->pe_session_id;
 
-	/* Clear the STA node except for the next pointer */
+	/* Clear the STA node except for the hash chain links */
 	qdf_mem_zero((uint8_t *)sta, sizeof(tDphHashNode));
 	sta->next = pnext;
+	sta->peer_index_next = peer_index_next;
+	sta->pe_session_id = pe_session_id;
 
 	/* Initialize the assocId */
 	sta->assocId = assocId;
@@ -270,6 +398,7 @@ tpDphHashNode dph_add_hash_entry(struct mac_context *mac, tSirMacAddr staAddr,
 			&hash_table->pDphNodeArray[assocId];
 
 		node = hash_table->pHashTable[index];
+		dph_peer_index_add(hash_table, node);
 		return node;
 	}
 }
@@ -324,6 +453,7 @@ QDF_STATUS dph_delete_hash_entry(struct mac_context *mac, tSirMacAddr staAddr,
 	}
 
 	if (ptr) {
+		dph_peer_index_del(hash_table, ptr);
 		/* / Delete the entry after invalidating it */
 		ptr->valid = 0;
 		memset(ptr->staAddr, 0, sizeof(ptr->staAddr));
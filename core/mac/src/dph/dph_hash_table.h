@@ -47,11 +47,15 @@ static inline uint8_t dph_compare_mac_addr(uint8_t addr1[], uint8_t addr2[])
  * @pHashTable: The actual hash table
  * @pDphNodeArray: The state array
  * @size: The size of the hash table
+ * @peer_index: psoc wide peer index the nodes are also added to
+ * @session_id: PE session owning the table
  */
 struct dph_hash_table {
 	tpDphHashNode *pHashTable;
 	tDphHashNode *pDphNodeArray;
 	uint16_t size;
+	struct dph_peer_index *peer_index;
+	uint8_t session_id;
 };
 
 tpDphHashNode dph_lookup_hash_entry(struct mac_context *mac, uint8_t staAddr[],
@@ -81,6 +85,39 @@ QDF_STATUS dph_delete_hash_entry(struct mac_context *mac,
 void dph_hash_table_init(struct mac_context *mac,
 			 struct dph_hash_table *hash_table);
 
+/**
+ * dph_peer_index_init() - Initialize the psoc wide peer index
+ * @peer_index: peer index to initialize
+ *
+ * Must be called before any PE session is created, the hash seed is also
+ * used by the per session DPH hash tables.
+ */
+void dph_peer_index_init(struct dph_peer_index *peer_index);
+
+/**
+ * dph_peer_index_lookup() - Find a peer in the psoc wide peer index
+ * @mac: Global MAC Context
+ * @addr: MAC address of the peer
+ * @session_id: PE session id of the peer, filled on success
+ * @assoc_id: association id of the peer, filled on success
+ *
+ * If the peer is added to several sessions, the node of the session with
+ * the lowest PE session id is returned.
+ *
+ * Return: DPH node of the peer, NULL if the peer is not added to any
+ * session
+ */
+tpDphHashNode dph_peer_index_lookup(struct mac_context *mac, uint8_t *addr,
+				    uint8_t *session_id, uint16_t *assoc_id);
+
+/**
+ * dph_peer_index_flush() - Remove all nodes of a DPH table from the index
+ * @mac: Global MAC Context
+ * @hash_table: DPH table of the PE session being deleted
+ */
+void dph_peer_index_flush(struct mac_context *mac,
+			  struct dph_hash_table *hash_table);
+
 /* Initialize STA state */
 tpDphHashNode dph_init_sta_state(struct mac_context *mac,
 				 tSirMacAddr staAddr,
@@ -212,6 +212,10 @@ typedef struct sDphHashNode {
 	 * end of the structure.
 	 */
 	struct sDphHashNode *next;
+	/* Chain of the psoc wide peer index, preserved like @next */
+	struct sDphHashNode *peer_index_next;
+	/* PE session the node belongs to, set when added to the index */
+	uint8_t pe_session_id;
 #ifdef WLAN_FEATURE_11BE_MLO
 	bool recv_assoc_frm;
 	uint8_t mld_addr[QDF_MAC_ADDR_SIZE];
@@ -219,6 +223,26 @@ typedef struct sDphHashNode {
 #endif
 } tDphHashNode, *tpDphHashNode;
 
+/* Number of buckets of the peer index, must be a power of two */
+#define DPH_PEER_INDEX_SIZE 256
+
+/**
+ * struct dph_peer_index - psoc wide peer MAC address index
+ * @seed: random hash seed, chosen once at PE open
+ * @count: number of nodes in the index
+ * @bucket: heads of the per bucket node chains
+ *
+ * Maps a peer MAC address to the DPH node of the PE session the peer is
+ * added to, so that a peer can be located without walking every session.
+ * Nodes are linked through tDphHashNode::peer_index_next and are
+ * maintained by dph_add_hash_entry() and dph_delete_hash_entry().
+ */
+struct dph_peer_index {
+	uint32_t seed;
+	uint32_t count;
+	tpDphHashNode bucket[DPH_PEER_INDEX_SIZE];
+};
+
 #include "dph_hash_table.h"
 
 /* ------------------------------------------------------------------- */
@@ -445,4 +445,24 @@ struct lim_delba_req_info {
 	uint8_t tid;
 	uint8_t reason_code;
 };
+
+/* Number of BSSID buckets of the PE session index, must be a power of two */
+#define PE_SESSION_INDEX_BSSID_BUCKETS 16
+
+/**
+ * struct pe_session_index - PE session lookup by vdev id and BSSID
+ * @enabled: session table fits the bitmaps, lookups scan the table if not
+ * @vdev: per vdev id bitmap of the PE session ids on that vdev
+ * @bssid: per BSSID bucket bitmap of the PE session ids hashing there
+ *
+ * Sessions are added by pe_create_session(), re-keyed through
+ * pe_session_set_bssid() and pe_session_set_vdev_id() and removed by
+ * pe_delete_session(). Walking a bitmap from its lowest bit returns the
+ * same session a linear scan of the session table would.
+ */
+struct pe_session_index {
+	bool enabled;
+	unsigned long vdev[WLAN_MAX_VDEVS];
+	unsigned long bssid[PE_SESSION_INDEX_BSSID_BUCKETS];
+};
 #endif
@@ -584,6 +584,7 @@ struct wlan_mlo_ie_info {
  *                      to TFP
  * @schBeaconOffsetBegin: Size of the beginning portion
  * @schBeaconOffsetEnd: Size of the trailing portion
+ * @bcn_tmpl: beacon template cache, allocated on the first template build
  * @isOSENConnection:
  * @QosMapSet: DSCP to UP mapping for HS 2.0
  * @bRoamSynchInProgress:
@@ -899,6 +900,7 @@ struct pe_session {
 	uint8_t *pSchBeaconFrameEnd;
 	uint16_t schBeaconOffsetBegin;
 	uint16_t schBeaconOffsetEnd;
+	struct sch_bcn_tmpl *bcn_tmpl;
 	bool isOSENConnection;
 	struct qos_map_set QosMapSet;
 
@@ -1059,6 +1061,34 @@ struct pe_session *pe_create_session(struct mac_context *mac,
 				     uint16_t numSta, enum bss_type bssType,
 				     uint8_t vdev_id);
 
+/**
+ * pe_session_set_bssid() - change the BSSID of a PE session
+ * @mac: pointer to global adapter context
+ * @session: PE session
+ * @bssid: new BSSID
+ *
+ * The BSSID of a session must only be changed through this API so that
+ * pe_find_session_by_bssid() keeps finding the session.
+ *
+ * Return: None
+ */
+void pe_session_set_bssid(struct mac_context *mac, struct pe_session *session,
+			  uint8_t *bssid);
+
+/**
+ * pe_session_set_vdev_id() - change the vdev id of a PE session
+ * @mac: pointer to global adapter context
+ * @session: PE session
+ * @vdev_id: new vdev id
+ *
+ * The vdev id of a session must only be changed through this API so that
+ * the vdev id based session lookups keep finding the session.
+ *
+ * Return: None
+ */
+void pe_session_set_vdev_id(struct mac_context *mac,
+			    struct pe_session *session, uint8_t vdev_id);
+
 /**
  * pe_find_session_by_bssid() - looks up the PE session given the BSSID.
  *
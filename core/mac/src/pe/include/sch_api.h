@@ -57,6 +57,41 @@ void sch_edca_profile_update(struct mac_context *mac,
 QDF_STATUS sch_set_fixed_beacon_fields(struct mac_context *mac,
 				       struct pe_session *pe_session);
 
+/**
+ * sch_update_csa_count() - apply the CSA/ECSA countdown to the template
+ * @mac: pointer to mac structure
+ * @session: pe session
+ *
+ * Writes the current switch count of @session in the CSA/ECSA IEs of the
+ * last built beacon template and probe response, instead of rebuilding
+ * them. Only possible when the channel switch parameters did not change
+ * since the template was built.
+ *
+ * Return: QDF_STATUS_SUCCESS if the template was updated, error if
+ * sch_set_fixed_beacon_fields() must be used instead
+ */
+QDF_STATUS sch_update_csa_count(struct mac_context *mac,
+				struct pe_session *session);
+
+/**
+ * sch_free_bcn_tmpl() - free the beacon template cache of a session
+ * @session: pe session
+ *
+ * Return: None
+ */
+void sch_free_bcn_tmpl(struct pe_session *session);
+
+/**
+ * sch_reset_bcn_tmpl_sent() - forget the last template sent to firmware
+ * @session: pe session
+ *
+ * To be called when firmware may have lost the template, i.e. on vdev
+ * start, restart and stop, or when a template send failed.
+ *
+ * Return: None
+ */
+void sch_reset_bcn_tmpl_sent(struct pe_session *session);
+
 /**
  * sch_process_pre_beacon_ind() - Process the PreBeacon Indication from the Lim
  * @mac: pointer to mac structure
@@ -79,6 +79,94 @@ struct mlo_sch_partner_links {
 };
 #endif
 
+/**
+ * struct sch_bcn_tmpl_stats - beacon template update statistics
+ * @full_builds: templates rebuilt from the complete session state
+ * @count_patches: CSA/ECSA countdowns applied to the cached template
+ * @sent: templates sent to firmware
+ * @skipped: templates not sent as firmware already has the same content
+ * @bytes_skipped: template bytes not sent because of @skipped
+ */
+struct sch_bcn_tmpl_stats {
+	uint32_t full_builds;
+	uint32_t count_patches;
+	uint32_t sent;
+	uint32_t skipped;
+	uint64_t bytes_skipped;
+};
+
+/**
+ * struct sch_bcn_csa_key - channel switch state a template was built for
+ * @sw_target_freq: target frequency
+ * @ch_width: target channel width
+ * @primary_channel: target primary channel
+ * @seg0: target center frequency segment 0
+ * @seg1: target center frequency segment 1
+ * @sec_ch_offset: target secondary channel offset
+ * @switch_mode: switch mode
+ * @non_ecsa_cap_num: number of peers without ECSA capability
+ * @dfs_include_ch_sw_ie: CSA/ECSA IEs are included
+ * @bw_update_include_ch_sw_ie: CSA/ECSA IEs are included for a BW update
+ */
+struct sch_bcn_csa_key {
+	uint32_t sw_target_freq;
+	enum phy_ch_width ch_width;
+	uint8_t primary_channel;
+	uint8_t seg0;
+	uint8_t seg1;
+	uint8_t sec_ch_offset;
+	uint8_t switch_mode;
+	uint8_t non_ecsa_cap_num;
+	bool dfs_include_ch_sw_ie;
+	bool bw_update_include_ch_sw_ie;
+};
+
+/**
+ * struct sch_bcn_tmpl - per session beacon template cache
+ * @bcn_1: scratch frame for the fixed part of the beacon
+ * @bcn_2: scratch frame for the variable part of the beacon
+ * @wsc_prb_res: scratch WSC probe response IE
+ * @valid: the template in pSchBeaconFrameEnd can be patched in place
+ * @csa_key: channel switch state the template was built for
+ * @csa_ie_ofst: CSA switch count offset in pSchBeaconFrameEnd, 0 if absent
+ * @ecsa_ie_ofst: ECSA switch count offset in pSchBeaconFrameEnd, 0 if absent
+ * @csa_count_offset: CSA switch count offset sent to firmware
+ * @ecsa_count_offset: ECSA switch count offset sent to firmware
+ * @p2p_ie_offset: P2P IE offset sent to firmware
+ * @last_len: length of @last_bcn, 0 if nothing was sent yet
+ * @last_tim_ofst: TIM IE offset of @last_bcn
+ * @last_csa_ofst: CSA switch count offset sent with @last_bcn
+ * @last_ecsa_ofst: ECSA switch count offset sent with @last_bcn
+ * @last_p2p_ofst: P2P IE offset sent with @last_bcn
+ * @last_bcn: last template sent to firmware
+ * @stats: update statistics
+ *
+ * The dot11f frames are kept across updates so that a template update does
+ * not need to allocate them. The CSA/ECSA count offsets allow the countdown
+ * of a channel switch to be applied to the last built template, without
+ * regenerating every IE. @last_bcn lets the WMI send of a template identical
+ * to the one firmware already has be skipped.
+ */
+struct sch_bcn_tmpl {
+	tDot11fBeacon1 bcn_1;
+	tDot11fBeacon2 bcn_2;
+	tDot11fIEWscProbeRes wsc_prb_res;
+	bool valid;
+	struct sch_bcn_csa_key csa_key;
+	uint32_t csa_ie_ofst;
+	uint32_t ecsa_ie_ofst;
+	uint32_t csa_count_offset;
+	uint32_t ecsa_count_offset;
+	uint16_t p2p_ie_offset;
+	uint16_t last_len;
+	uint16_t last_tim_ofst;
+	uint32_t last_csa_ofst;
+	uint32_t last_ecsa_ofst;
+	uint16_t last_p2p_ofst;
+	uint8_t last_bcn[SIR_MAX_BEACON_SIZE];
+	struct sch_bcn_tmpl_stats stats;
+};
+
 /**
  * struct sch_context - SCH global context
  * @beacon_interval: global beacon interval
@@ -104,6 +104,10 @@ static void __lim_init_bss_vars(struct mac_context *mac)
 {
 	qdf_mem_zero((void *)mac->lim.gpSession,
 		    sizeof(*mac->lim.gpSession) * mac->lim.maxBssId);
+	qdf_mem_zero(mac->lim.session_index.vdev,
+		     sizeof(mac->lim.session_index.vdev));
+	qdf_mem_zero(mac->lim.session_index.bssid,
+		     sizeof(mac->lim.session_index.bssid));
 }
 
 static void __lim_init_stats_vars(struct mac_context *mac)
@@ -401,6 +405,7 @@ QDF_STATUS lim_initialize(struct mac_context *mac)
 	}
 
 	qdf_list_create(&mac->lim.gLimMgmtFrameRegistratinQueue, 0);
+	lim_mgmt_frm_matcher_update(mac);
 
 	/* initialize the TSPEC admission control table. */
 	/* Note that this was initially done after resume notification from HAL. */
@@ -434,6 +439,9 @@ void lim_cleanup(struct mac_context *mac)
 {
 	uint8_t i;
 	qdf_list_node_t *lst_node;
+	struct mgmt_frm_reg_info *reg;
+
+	lim_mgmt_frm_matcher_free(mac);
 
 	/*
 	 * Before destroying the list making sure all the nodes have been
@@ -442,6 +450,9 @@ void lim_cleanup(struct mac_context *mac)
 	while (qdf_list_remove_front(
 			&mac->lim.gLimMgmtFrameRegistratinQueue,
 			&lst_node) == QDF_STATUS_SUCCESS) {
+		reg = (struct mgmt_frm_reg_info *)lst_node;
+		pe_nofl_debug("Register Frame: type %d, match length %d, %u hits",
+			      reg->frameType, reg->matchLen, reg->hits);
 		qdf_mem_free(lst_node);
 	}
 	qdf_list_destroy(&mac->lim.gLimMgmtFrameRegistratinQueue);
@@ -823,6 +834,16 @@ QDF_STATUS pe_open(struct mac_context *mac, struct cds_config_info *cds_cfg)
 		return QDF_STATUS_E_FAILURE;
 	}
 
+	/* the PE session index tracks session ids in unsigned long bitmaps */
+	mac->lim.session_index.enabled =
+		mac->lim.maxBssId <= WLAN_MAX_VDEVS &&
+		mac->lim.maxBssId <= sizeof(unsigned long) * 8;
+	if (!mac->lim.session_index.enabled)
+		pe_info("max number of Bssid %d, PE session index not used",
+			mac->lim.maxBssId);
+
+	dph_peer_index_init(&mac->lim.peer_index);
+
 	if (!QDF_IS_STATUS_SUCCESS(pe_allocate_dph_node_array_buffer())) {
 		pe_err("g_dph_node_array memory allocate failed!");
 		return QDF_STATUS_E_NOMEM;
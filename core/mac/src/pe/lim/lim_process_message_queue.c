@@ -1161,60 +1161,21 @@ lim_check_mgmt_registered_frames(struct mac_context *mac_ctx, uint8_t *buff_desc
 	tSirMacFrameCtl fc;
 	tpSirMacMgmtHdr hdr;
 	uint8_t *body;
-	struct mgmt_frm_reg_info *mgmt_frame = NULL;
-	struct mgmt_frm_reg_info *next_frm = NULL;
-	uint16_t frm_type;
+	struct mgmt_frm_reg_info *mgmt_frame;
 	uint16_t frm_len;
-	uint8_t type, sub_type;
-	bool match = false;
+	bool match;
 	uint8_t vdev_id = WLAN_INVALID_VDEV_ID;
-	QDF_STATUS qdf_status;
 
 	hdr = WMA_GET_RX_MAC_HEADER(buff_desc);
 	fc = hdr->fc;
-	frm_type = (fc.type << 2) | (fc.subType << 4);
 	body = WMA_GET_RX_MPDU_DATA(buff_desc);
 	frm_len = WMA_GET_RX_PAYLOAD_LEN(buff_desc);
 
-	qdf_mutex_acquire(&mac_ctx->lim.lim_frame_register_lock);
-	qdf_list_peek_front(&mac_ctx->lim.gLimMgmtFrameRegistratinQueue,
-			    (qdf_list_node_t **) &mgmt_frame);
-	qdf_mutex_release(&mac_ctx->lim.lim_frame_register_lock);
-
-	while (mgmt_frame) {
-		type = (mgmt_frame->frameType >> 2) & 0x03;
-		sub_type = (mgmt_frame->frameType >> 4) & 0x0f;
-		if ((type == SIR_MAC_MGMT_FRAME)
-		    && (fc.type == SIR_MAC_MGMT_FRAME)
-		    && (sub_type == SIR_MAC_MGMT_RESERVED15)) {
-			pe_debug("rcvd frm match for SIR_MAC_MGMT_RESERVED15");
-			match = true;
-			break;
-		}
-		if (mgmt_frame->frameType == frm_type) {
-			if (mgmt_frame->matchLen <= 0) {
-				match = true;
-				break;
-			}
-			if (mgmt_frame->matchLen <= frm_len &&
-				(!qdf_mem_cmp(mgmt_frame->matchData, body,
-				mgmt_frame->matchLen))) {
-				/* found match! */
-				match = true;
-				break;
-			}
-		}
+	mgmt_frame = lim_mgmt_frm_match(mac_ctx, fc, body, frm_len);
+	match = !!mgmt_frame;
+	if (match && lim_mgmt_reg_is_wildcard(mgmt_frame))
+		pe_debug("rcvd frm match for SIR_MAC_MGMT_RESERVED15");
 
-		qdf_mutex_acquire(&mac_ctx->lim.lim_frame_register_lock);
-		qdf_status =
-			qdf_list_peek_next(
-			&mac_ctx->lim.gLimMgmtFrameRegistratinQueue,
-			(qdf_list_node_t *) mgmt_frame,
-			(qdf_list_node_t **) &next_frm);
-		qdf_mutex_release(&mac_ctx->lim.lim_frame_register_lock);
-		mgmt_frame = next_frm;
-		next_frm = NULL;
-	}
 	if (match) {
 		pe_debug("rcvd frame match with registered frame params");
 
@@ -1241,9 +1202,7 @@ lim_check_mgmt_registered_frames(struct mac_context *mac_ctx, uint8_t *buff_desc
 			WMA_GET_RX_RSSI_NORMALIZED(buff_desc),
 			RXMGMT_FLAG_NONE);
 
-		if ((type == SIR_MAC_MGMT_FRAME)
-		    && (fc.type == SIR_MAC_MGMT_FRAME)
-		    && (sub_type == SIR_MAC_MGMT_RESERVED15))
+		if (lim_mgmt_reg_is_wildcard(mgmt_frame))
 			/* These packets needs to be processed by PE/SME
 			 * as well as HDD.If it returns true here,
 			 * the packet is forwarded to HDD only.
@@ -5264,7 +5264,7 @@ static void lim_handle_reassoc_req(struct cm_vdev_join_req *req)
 				goto end;
 			}
 
-			session_entry->vdev_id = vdev_id;
+			pe_session_set_vdev_id(mac_ctx, session_entry, vdev_id);
 			mlm_reassoc_req =
 				qdf_mem_malloc(sizeof(*mlm_reassoc_req));
 			if (!mlm_reassoc_req) {
@@ -6841,7 +6841,7 @@ static void __lim_process_sme_deauth_req(struct mac_context *mac_ctx,
 			session_entry, 0, sme_deauth_req.reasonCode);
 #endif /* FEATURE_WLAN_DIAG_SUPPORT */
 
-	session_entry->vdev_id = vdev_id;
+	pe_session_set_vdev_id(mac_ctx, session_entry, vdev_id);
 
 	switch (GET_LIM_SYSTEM_ROLE(session_entry)) {
 	case eLIM_STA_ROLE:
@@ -7139,6 +7139,7 @@ QDF_STATUS lim_send_vdev_stop(struct pe_session *session)
 	struct mac_context *mac_ctx = session->mac_ctx;
 	QDF_STATUS status;
 
+	sch_reset_bcn_tmpl_sent(session);
 	status = lim_del_bss(mac_ctx, NULL, session->vdev_id, session);
 
 	if (QDF_IS_STATUS_ERROR(status)) {
@@ -8419,13 +8420,23 @@ skip_match:
 		next = NULL;
 	}
 	if (match) {
+		pe_nofl_debug("Register Frame: drop type %d, match length %d, %u hits",
+			      lim_mgmt_regn->frameType,
+			      lim_mgmt_regn->matchLen, lim_mgmt_regn->hits);
 		qdf_mutex_acquire(&mac_ctx->lim.lim_frame_register_lock);
 		if (QDF_STATUS_SUCCESS ==
 				qdf_list_remove_node(
 				&mac_ctx->lim.gLimMgmtFrameRegistratinQueue,
-				(qdf_list_node_t *)lim_mgmt_regn))
+				(qdf_list_node_t *)lim_mgmt_regn)) {
+			/* the matcher must not point at the freed node */
+			qdf_mutex_release(
+					&mac_ctx->lim.lim_frame_register_lock);
+			lim_mgmt_frm_matcher_update(mac_ctx);
 			qdf_mem_free(lim_mgmt_regn);
-		qdf_mutex_release(&mac_ctx->lim.lim_frame_register_lock);
+		} else {
+			qdf_mutex_release(
+					&mac_ctx->lim.lim_frame_register_lock);
+		}
 	}
 
 	if (sme_req->registerFrame) {
@@ -8448,6 +8459,7 @@ skip_match:
 					      &lim_mgmt_regn->node);
 			qdf_mutex_release(
 					&mac_ctx->lim.lim_frame_register_lock);
+			lim_mgmt_frm_matcher_update(mac_ctx);
 		}
 	}
 	return;
@@ -8904,11 +8916,20 @@ static void lim_process_sme_deauth_req(struct mac_context *mac_ctx,
 
 void lim_send_bcn_rsp(struct mac_context *mac_ctx, tpSendbeaconParams rsp)
 {
+	struct pe_session *session;
+
 	if (!rsp) {
 		pe_err("rsp is NULL");
 		return;
 	}
 
+	/* Firmware may not have the template, do not skip the next one */
+	if (QDF_IS_STATUS_ERROR(rsp->status)) {
+		session = pe_find_session_by_vdev_id(mac_ctx, rsp->vdev_id);
+		if (session)
+			sch_reset_bcn_tmpl_sent(session);
+	}
+
 	/* Success case response is sent from beacon_tx completion/timeout */
 	if (rsp->reason == REASON_CH_WIDTH_UPDATE &&
 	    QDF_IS_STATUS_SUCCESS(rsp->status))
@@ -524,6 +524,110 @@ void lim_update_bcn_probe_filter(struct mac_context *mac_ctx,
 		 filter->num_sap_sessions);
 }
 
+/**
+ * pe_session_index_bucket() - BSSID bucket of the PE session index
+ * @bssid: BSSID to hash
+ *
+ * Return: bucket index
+ */
+static inline uint8_t pe_session_index_bucket(uint8_t *bssid)
+{
+	uint8_t hash = bssid[0] ^ bssid[1] ^ bssid[2] ^
+		       bssid[3] ^ bssid[4] ^ bssid[5];
+
+	return (hash ^ (hash >> 4)) & (PE_SESSION_INDEX_BSSID_BUCKETS - 1);
+}
+
+/**
+ * pe_session_index_first() - lowest PE session id of an index bitmap
+ * @sessions: non zero bitmap of PE session ids
+ *
+ * Return: PE session id
+ */
+static inline uint8_t pe_session_index_first(unsigned long sessions)
+{
+	return qdf_ffz(~sessions);
+}
+
+/**
+ * pe_session_index_next() - next candidate of a PE session lookup
+ * @mac: pointer to global adapter context
+ * @sessions: candidate bitmap from the index, consumed as it is walked
+ * @i: PE session id the walk continues from
+ *
+ * Without the index every PE session of the table is a candidate, in
+ * table order.
+ *
+ * Return: PE session id of the next candidate, mac->lim.maxBssId if there
+ * is none left
+ */
+static inline uint8_t pe_session_index_next(struct mac_context *mac,
+					    unsigned long *sessions, uint8_t i)
+{
+	if (!mac->lim.session_index.enabled)
+		return i;
+
+	if (!*sessions)
+		return mac->lim.maxBssId;
+
+	i = pe_session_index_first(*sessions);
+	*sessions &= *sessions - 1;
+
+	return i;
+}
+
+static void pe_session_index_add(struct mac_context *mac,
+				 struct pe_session *session)
+{
+	struct pe_session_index *index = &mac->lim.session_index;
+	unsigned long bit = 1UL << session->peSessionId;
+
+	if (!index->enabled)
+		return;
+
+	if (session->vdev_id < WLAN_MAX_VDEVS)
+		index->vdev[session->vdev_id] |= bit;
+	index->bssid[pe_session_index_bucket(session->bssId)] |= bit;
+}
+
+/*
+ * Only ever clears the bits of @session, so it is harmless to call for a
+ * session which has not been added yet.
+ */
+static void pe_session_index_del(struct mac_context *mac,
+				 struct pe_session *session)
+{
+	struct pe_session_index *index = &mac->lim.session_index;
+	unsigned long bit = 1UL << session->peSessionId;
+
+	if (!index->enabled)
+		return;
+
+	if (session->vdev_id < WLAN_MAX_VDEVS)
+		index->vdev[session->vdev_id] &= ~bit;
+	index->bssid[pe_session_index_bucket(session->bssId)] &= ~bit;
+}
+
+void pe_session_set_bssid(struct mac_context *mac, struct pe_session *session,
+			  uint8_t *bssid)
+{
+	if (session->valid)
+		pe_session_index_del(mac, session);
+	sir_copy_mac_addr(session->bssId, bssid);
+	if (session->valid)
+		pe_session_index_add(mac, session);
+}
+
+void pe_session_set_vdev_id(struct mac_context *mac,
+			    struct pe_session *session, uint8_t vdev_id)
+{
+	if (session->valid)
+		pe_session_index_del(mac, session);
+	session->vdev_id = vdev_id;
+	if (session->valid)
+		pe_session_index_add(mac, session);
+}
+
 struct pe_session *pe_create_session(struct mac_context *mac,
 				     uint8_t *bssid, uint8_t *sessionId,
 				     uint16_t numSta, enum bss_type bssType,
@@ -557,9 +661,11 @@ struct pe_session *pe_create_session(struct mac_context *mac,
 	session_ptr->dph.dphHashTable.pDphNodeArray =
 					pe_get_session_dph_node_array(i);
 	session_ptr->dph.dphHashTable.size = numSta + 1;
+	session_ptr->dph.dphHashTable.peer_index = &mac->lim.peer_index;
+	session_ptr->dph.dphHashTable.session_id = i;
 	dph_hash_table_init(mac, &session_ptr->dph.dphHashTable);
 
-	/* Copy the BSSID to the session table */
+	/* Copy the BSSID to the session table, indexed once vdev_id is set */
 	sir_copy_mac_addr(session_ptr->bssId, bssid);
 	if (bssType == eSIR_MONITOR_MODE)
 		sir_copy_mac_addr(mac->lim.gpSession[i].self_mac_addr, bssid);
@@ -615,6 +721,7 @@ struct pe_session *pe_create_session(struct mac_context *mac,
 	}
 	session_ptr->vdev = vdev;
 	session_ptr->vdev_id = vdev_id;
+	pe_session_index_add(mac, session_ptr);
 	session_ptr->mac_ctx = mac;
 	session_ptr->opmode = wlan_vdev_mlme_get_opmode(vdev);
 	mlme_set_tdls_chan_switch_prohibited(vdev, false);
@@ -690,6 +797,7 @@ free_session_attrs:
 
 	session_ptr->dph.dphHashTable.pHashTable = NULL;
 	session_ptr->dph.dphHashTable.pDphNodeArray = NULL;
+	pe_session_index_del(mac, session_ptr);
 	session_ptr->valid = false;
 
 	return NULL;
@@ -712,9 +820,13 @@ free_session_attrs:
 struct pe_session *pe_find_session_by_bssid(struct mac_context *mac, uint8_t *bssid,
 				     uint8_t *sessionId)
 {
+	unsigned long sessions;
 	uint8_t i;
 
-	for (i = 0; i < mac->lim.maxBssId; i++) {
+	sessions = mac->lim.session_index.bssid[pe_session_index_bucket(bssid)];
+	for (i = pe_session_index_next(mac, &sessions, 0);
+	     i < mac->lim.maxBssId;
+	     i = pe_session_index_next(mac, &sessions, i + 1)) {
 		/* If BSSID matches return corresponding tables address */
 		if ((mac->lim.gpSession[i].valid)
 		    && (sir_compare_mac_addr(mac->lim.gpSession[i].bssId,
@@ -728,15 +840,33 @@ struct pe_session *pe_find_session_by_bssid(struct mac_context *mac, uint8_t *bs
 
 }
 
+/**
+ * pe_session_index_vdev() - PE sessions on a vdev
+ * @mac: pointer to global adapter context
+ * @vdev_id: vdev id
+ *
+ * Return: bitmap of the PE session ids on @vdev_id
+ */
+static inline unsigned long pe_session_index_vdev(struct mac_context *mac,
+						  uint8_t vdev_id)
+{
+	if (vdev_id >= WLAN_MAX_VDEVS)
+		return 0;
+
+	return mac->lim.session_index.vdev[vdev_id];
+}
+
 struct pe_session *pe_find_session_by_vdev_id(struct mac_context *mac,
 					      uint8_t vdev_id)
 {
+	unsigned long sessions = pe_session_index_vdev(mac, vdev_id);
 	uint8_t i;
 
-	for (i = 0; i < mac->lim.maxBssId; i++) {
-		/* If BSSID matches return corresponding tables address */
-		if ((mac->lim.gpSession[i].valid) &&
-		    (mac->lim.gpSession[i].vdev_id == vdev_id))
+	for (i = pe_session_index_next(mac, &sessions, 0);
+	     i < mac->lim.maxBssId;
+	     i = pe_session_index_next(mac, &sessions, i + 1)) {
+		if (mac->lim.gpSession[i].valid &&
+		    mac->lim.gpSession[i].vdev_id == vdev_id)
 			return &mac->lim.gpSession[i];
 	}
 	pe_debug("Session lookup fails for vdev_id: %d", vdev_id);
@@ -749,9 +879,12 @@ struct pe_session
 				      uint8_t vdev_id,
 				      enum eLimMlmStates lim_state)
 {
+	unsigned long sessions = pe_session_index_vdev(mac, vdev_id);
 	uint8_t i;
 
-	for (i = 0; i < mac->lim.maxBssId; i++) {
+	for (i = pe_session_index_next(mac, &sessions, 0);
+	     i < mac->lim.maxBssId;
+	     i = pe_session_index_next(mac, &sessions, i + 1)) {
 		if (mac->lim.gpSession[i].valid &&
 		    mac->lim.gpSession[i].vdev_id == vdev_id &&
 		    mac->lim.gpSession[i].limMlmState == lim_state)
@@ -769,9 +902,12 @@ pe_find_session_by_bssid_and_vdev_id(struct mac_context *mac,
 				     uint8_t vdev_id,
 				     uint8_t *sessionId)
 {
+	unsigned long sessions = pe_session_index_vdev(mac, vdev_id);
 	uint8_t i;
 
-	for (i = 0; i < mac->lim.maxBssId; i++) {
+	for (i = pe_session_index_next(mac, &sessions, 0);
+	     i < mac->lim.maxBssId;
+	     i = pe_session_index_next(mac, &sessions, i + 1)) {
 		/* If BSSID matches return corresponding tables address */
 		if ((mac->lim.gpSession[i].valid) &&
 		    (mac->lim.gpSession[i].vdev_id == vdev_id) &&
@@ -915,6 +1051,7 @@ void pe_delete_session(struct mac_context *mac_ctx, struct pe_session *session)
 		session->pLimMlmJoinReq = NULL;
 	}
 
+	dph_peer_index_flush(mac_ctx, &session->dph.dphHashTable);
 	if (session->dph.dphHashTable.pHashTable) {
 		qdf_mem_free(session->dph.dphHashTable.pHashTable);
 		session->dph.dphHashTable.pHashTable = NULL;
@@ -989,6 +1126,8 @@ void pe_delete_session(struct mac_context *mac_ctx, struct pe_session *session)
 		session->pSchBeaconFrameBegin = NULL;
 	}
 
+	sch_free_bcn_tmpl(session);
+
 	if (session->pSchBeaconFrameEnd) {
 		qdf_mem_free(session->pSchBeaconFrameEnd);
 		session->pSchBeaconFrameEnd = NULL;
@@ -1012,6 +1151,7 @@ void pe_delete_session(struct mac_context *mac_ctx, struct pe_session *session)
 	}
 	pe_delete_fils_info(session);
 	lim_clear_pmfcomeback_timer(session);
+	pe_session_index_del(mac_ctx, session);
 	session->valid = false;
 
 	session->mac_ctx = NULL;
@@ -1039,6 +1179,7 @@ void pe_delete_session(struct mac_context *mac_ctx, struct pe_session *session)
 
    This function returns the session context and the session ID if the session
    corresponding to the given station address is found in the PE session table.
+   The peer is located through the psoc wide DPH peer index.
 
    \param mac                   - pointer to global adapter context
    \param sa                       - Peer STA Address of the session
@@ -1056,17 +1197,10 @@ struct pe_session *pe_find_session_by_peer_sta(struct mac_context *mac, uint8_t
 	tpDphHashNode pSta;
 	uint16_t aid;
 
-	for (i = 0; i < mac->lim.maxBssId; i++) {
-		if ((mac->lim.gpSession[i].valid)) {
-			pSta =
-				dph_lookup_hash_entry(mac, sa, &aid,
-						      &mac->lim.gpSession[i].dph.
-						      dphHashTable);
-			if (pSta) {
-				*sessionId = i;
-				return &mac->lim.gpSession[i];
-			}
-		}
+	pSta = dph_peer_index_lookup(mac, sa, &i, &aid);
+	if (pSta && i < mac->lim.maxBssId && mac->lim.gpSession[i].valid) {
+		*sessionId = i;
+		return &mac->lim.gpSession[i];
 	}
 
 	pe_debug("Session lookup fails for Peer: "QDF_MAC_ADDR_FMT,
@@ -9935,8 +9935,13 @@ send_frame:
 void
 lim_send_dfs_chan_sw_ie_update(struct mac_context *mac_ctx, struct pe_session *session)
 {
-	/* Update the beacon template and send to FW */
-	if (sch_set_fixed_beacon_fields(mac_ctx, session) !=
+	/*
+	 * Update the beacon template and send to FW. A countdown of the
+	 * switch count is applied to the last template, without rebuilding
+	 * it.
+	 */
+	if (QDF_IS_STATUS_ERROR(sch_update_csa_count(mac_ctx, session)) &&
+	    sch_set_fixed_beacon_fields(mac_ctx, session) !=
 					QDF_STATUS_SUCCESS) {
 		pe_err("Unable to set CSA IE in beacon");
 		return;
@@ -11059,6 +11064,9 @@ QDF_STATUS lim_pre_vdev_start(struct mac_context *mac,
 	struct ch_params ch_params = {0};
 	qdf_freq_t sec_chan_freq = 0;
 
+	/* a started or restarted vdev needs a full beacon template */
+	sch_reset_bcn_tmpl_sent(session);
+
 	band = wlan_reg_freq_to_band(session->curr_op_freq);
 	band_mask = 1 << band;
 
@@ -11724,3 +11732,191 @@ lim_convert_vht_chwidth_to_phy_chwidth(uint8_t ch_width, bool is_40)
 	}
 	return CH_WIDTH_20MHZ;
 }
+
+/**
+ * lim_mgmt_match_bucket() - matcher bucket of a received frame
+ * @type: frame type
+ * @sub_type: frame subtype
+ * @body: frame body
+ * @len: frame body length
+ *
+ * Return: bucket index
+ */
+static inline uint16_t lim_mgmt_match_bucket(uint8_t type, uint8_t sub_type,
+					     uint8_t *body, uint16_t len)
+{
+	if (type == SIR_MAC_MGMT_FRAME && sub_type == SIR_MAC_MGMT_ACTION &&
+	    len)
+		return LIM_MGMT_MATCH_FRM_KEYS + body[0];
+
+	return ((sub_type & 0x0f) << 2) | (type & 0x03);
+}
+
+/**
+ * lim_mgmt_reg_in_bucket() - can a registration match the frames of a bucket
+ * @reg: frame registration
+ * @bucket: bucket index
+ *
+ * Return: true if @reg is to be compiled into @bucket
+ */
+static bool lim_mgmt_reg_in_bucket(struct mgmt_frm_reg_info *reg,
+				   uint16_t bucket)
+{
+	uint16_t key = bucket;
+
+	if (bucket >= LIM_MGMT_MATCH_FRM_KEYS)
+		key = (SIR_MAC_MGMT_ACTION << 2) | SIR_MAC_MGMT_FRAME;
+
+	if (lim_mgmt_reg_is_wildcard(reg))
+		return (key & 0x03) == SIR_MAC_MGMT_FRAME;
+
+	if (reg->frameType != key << 2)
+		return false;
+
+	if (bucket < LIM_MGMT_MATCH_FRM_KEYS || !reg->matchLen)
+		return true;
+
+	return reg->matchData[0] == bucket - LIM_MGMT_MATCH_FRM_KEYS;
+}
+
+static inline bool lim_mgmt_reg_match(struct mgmt_frm_reg_info *reg,
+				      uint8_t *body, uint16_t len)
+{
+	if (lim_mgmt_reg_is_wildcard(reg) || !reg->matchLen)
+		return true;
+
+	return reg->matchLen <= len &&
+	       !qdf_mem_cmp(reg->matchData, body, reg->matchLen);
+}
+
+void lim_mgmt_frm_matcher_free(struct mac_context *mac)
+{
+	struct lim_mgmt_frm_matcher *matcher = mac->lim.mgmt_frm_matcher;
+
+	mac->lim.mgmt_frm_matcher = NULL;
+	qdf_mem_free(matcher);
+}
+
+void lim_mgmt_frm_matcher_update(struct mac_context *mac)
+{
+	struct lim_mgmt_frm_matcher *matcher = NULL;
+	struct mgmt_frm_reg_info **regs = NULL;
+	qdf_list_node_t *node = NULL, *next;
+	uint32_t num_regs, total = 0;
+	uint32_t i, b;
+
+	qdf_mutex_acquire(&mac->lim.lim_frame_register_lock);
+
+	num_regs = qdf_list_size(&mac->lim.gLimMgmtFrameRegistratinQueue);
+	if (num_regs) {
+		regs = qdf_mem_malloc(num_regs * sizeof(*regs));
+		if (!regs)
+			goto publish;
+	}
+
+	i = 0;
+	qdf_list_peek_front(&mac->lim.gLimMgmtFrameRegistratinQueue, &node);
+	while (node && i < num_regs) {
+		regs[i++] = (struct mgmt_frm_reg_info *)node;
+		next = NULL;
+		qdf_list_peek_next(&mac->lim.gLimMgmtFrameRegistratinQueue,
+				   node, &next);
+		node = next;
+	}
+	num_regs = i;
+
+	for (b = 0; b < LIM_MGMT_MATCH_BUCKETS; b++)
+		for (i = 0; i < num_regs; i++)
+			total += lim_mgmt_reg_in_bucket(regs[i], b);
+
+	matcher = qdf_mem_malloc(sizeof(*matcher) +
+				 total * sizeof(matcher->entry[0]));
+	if (!matcher)
+		goto publish;
+
+	matcher->num_regs = num_regs;
+	total = 0;
+	for (b = 0; b < LIM_MGMT_MATCH_BUCKETS; b++) {
+		matcher->bucket[b] = total;
+		for (i = 0; i < num_regs; i++)
+			if (lim_mgmt_reg_in_bucket(regs[i], b))
+				matcher->entry[total++] = regs[i];
+	}
+	matcher->bucket[LIM_MGMT_MATCH_BUCKETS] = total;
+
+publish:
+	qdf_mem_free(regs);
+	lim_mgmt_frm_matcher_free(mac);
+	mac->lim.mgmt_frm_matcher = matcher;
+	qdf_mutex_release(&mac->lim.lim_frame_register_lock);
+
+	if (!matcher)
+		pe_err("Failed to compile %u frame registrations", num_regs);
+	else
+		pe_debug("Compiled %u frame registrations into %u entries",
+			 num_regs, total);
+}
+
+/**
+ * lim_mgmt_frm_match_list() - match a frame by walking the registrations
+ * @mac: global MAC context
+ * @bucket: bucket of the frame
+ * @body: frame body
+ * @len: frame body length
+ *
+ * Used when no matcher could be compiled.
+ *
+ * Return: first matching registration or NULL
+ */
+static struct mgmt_frm_reg_info *
+lim_mgmt_frm_match_list(struct mac_context *mac, uint16_t bucket,
+			uint8_t *body, uint16_t len)
+{
+	struct mgmt_frm_reg_info *reg = NULL;
+	qdf_list_node_t *node = NULL, *next;
+
+	qdf_mutex_acquire(&mac->lim.lim_frame_register_lock);
+	qdf_list_peek_front(&mac->lim.gLimMgmtFrameRegistratinQueue, &node);
+	while (node) {
+		if (lim_mgmt_reg_in_bucket((struct mgmt_frm_reg_info *)node,
+					   bucket) &&
+		    lim_mgmt_reg_match((struct mgmt_frm_reg_info *)node,
+				       body, len)) {
+			reg = (struct mgmt_frm_reg_info *)node;
+			reg->hits++;
+			break;
+		}
+		next = NULL;
+		qdf_list_peek_next(&mac->lim.gLimMgmtFrameRegistratinQueue,
+				   node, &next);
+		node = next;
+	}
+	qdf_mutex_release(&mac->lim.lim_frame_register_lock);
+
+	return reg;
+}
+
+struct mgmt_frm_reg_info *lim_mgmt_frm_match(struct mac_context *mac,
+					     tSirMacFrameCtl fc,
+					     uint8_t *body, uint16_t len)
+{
+	struct lim_mgmt_frm_matcher *matcher = mac->lim.mgmt_frm_matcher;
+	struct mgmt_frm_reg_info *reg;
+	uint32_t i;
+	uint16_t bucket;
+
+	bucket = lim_mgmt_match_bucket(fc.type, fc.subType, body, len);
+	if (!matcher)
+		return lim_mgmt_frm_match_list(mac, bucket, body, len);
+
+	for (i = matcher->bucket[bucket]; i < matcher->bucket[bucket + 1];
+	     i++) {
+		reg = matcher->entry[i];
+		if (lim_mgmt_reg_match(reg, body, len)) {
+			reg->hits++;
+			return reg;
+		}
+	}
+
+	return NULL;
+}
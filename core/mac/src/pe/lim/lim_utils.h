@@ -3385,4 +3385,58 @@ lim_get_connected_chan_for_mode(struct wlan_objmgr_psoc *psoc,
  */
 enum phy_ch_width
 lim_convert_vht_chwidth_to_phy_chwidth(uint8_t ch_width, bool is_40);
+
+/**
+ * lim_mgmt_reg_is_wildcard() - is a frame registration the RESERVED15 one
+ * @reg: frame registration
+ *
+ * A management frame registration with the reserved subtype 15 matches all
+ * received management frames, which are then processed by PE as well.
+ *
+ * Return: true if @reg matches all management frames
+ */
+static inline bool lim_mgmt_reg_is_wildcard(struct mgmt_frm_reg_info *reg)
+{
+	return ((reg->frameType >> 2) & 0x03) == SIR_MAC_MGMT_FRAME &&
+	       ((reg->frameType >> 4) & 0x0f) == SIR_MAC_MGMT_RESERVED15;
+}
+
+/**
+ * lim_mgmt_frm_matcher_update() - recompile the frame registrations
+ * @mac: global MAC context
+ *
+ * Called after every change of gLimMgmtFrameRegistratinQueue. Builds a new
+ * matcher from the registration list and publishes it with a single pointer
+ * store. The matcher is only read from the PE message context, which is
+ * also where registrations change, so the previous one is freed right away.
+ * If the new matcher can't be allocated none is published and lookups fall
+ * back to walking the registration list.
+ *
+ * Return: None
+ */
+void lim_mgmt_frm_matcher_update(struct mac_context *mac);
+
+/**
+ * lim_mgmt_frm_matcher_free() - free the compiled frame registrations
+ * @mac: global MAC context
+ *
+ * Return: None
+ */
+void lim_mgmt_frm_matcher_free(struct mac_context *mac);
+
+/**
+ * lim_mgmt_frm_match() - find the registration a received frame matches
+ * @mac: global MAC context
+ * @fc: frame control of the received frame
+ * @body: frame body
+ * @len: frame body length
+ *
+ * Returns the first registration in list order whose frame type and match
+ * data match the frame, and counts the hit against it.
+ *
+ * Return: matching registration or NULL
+ */
+struct mgmt_frm_reg_info *lim_mgmt_frm_match(struct mac_context *mac,
+					     tSirMacFrameCtl fc,
+					     uint8_t *body, uint16_t len);
 #endif /* __LIM_UTILS_H */
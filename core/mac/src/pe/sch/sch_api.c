@@ -557,6 +557,69 @@ memfree:
 	return status;
 }
 
+/**
+ * sch_is_bcn_tmpl_sent() - check if firmware already has a beacon template
+ * @session: pe session
+ * @params: beacon template update
+ *
+ * Template updates posted for a channel switch, NSS, channel width or BSS
+ * color change expect a response and MLO templates carry partner link
+ * state beyond the frame content, these are always sent.
+ *
+ * Return: true if @params matches the last template sent for @session
+ */
+static bool sch_is_bcn_tmpl_sent(struct pe_session *session,
+				 tpSendbeaconParams params)
+{
+	struct sch_bcn_tmpl *tmpl = session->bcn_tmpl;
+
+	if (!tmpl || !tmpl->last_len)
+		return false;
+
+	switch (params->reason) {
+	case REASON_DEFAULT:
+	case REASON_CONFIG_UPDATE:
+	case REASON_SET_HT2040:
+	case REASON_RNR_UPDATE:
+		break;
+	default:
+		return false;
+	}
+
+	if (wlan_vdev_mlme_is_mlo_ap(session->vdev))
+		return false;
+
+	return params->beaconLength == tmpl->last_len &&
+	       params->timIeOffset == tmpl->last_tim_ofst &&
+	       params->csa_count_offset == tmpl->last_csa_ofst &&
+	       params->ecsa_count_offset == tmpl->last_ecsa_ofst &&
+	       params->p2pIeOffset == tmpl->last_p2p_ofst &&
+	       !qdf_mem_cmp(params->beacon, tmpl->last_bcn, tmpl->last_len);
+}
+
+void sch_reset_bcn_tmpl_sent(struct pe_session *session)
+{
+	if (session->bcn_tmpl)
+		session->bcn_tmpl->last_len = 0;
+}
+
+static void sch_save_bcn_tmpl_sent(struct pe_session *session,
+				   tpSendbeaconParams params)
+{
+	struct sch_bcn_tmpl *tmpl = session->bcn_tmpl;
+
+	if (!tmpl)
+		return;
+
+	tmpl->stats.sent++;
+	qdf_mem_copy(tmpl->last_bcn, params->beacon, params->beaconLength);
+	tmpl->last_len = params->beaconLength;
+	tmpl->last_tim_ofst = params->timIeOffset;
+	tmpl->last_csa_ofst = params->csa_count_offset;
+	tmpl->last_ecsa_ofst = params->ecsa_count_offset;
+	tmpl->last_p2p_ofst = params->p2pIeOffset;
+}
+
 QDF_STATUS sch_send_beacon_req(struct mac_context *mac, uint8_t *beaconPayload,
 			       uint16_t size, struct pe_session *pe_session,
 			       enum sir_bcn_update_reason reason)
@@ -625,14 +688,26 @@ QDF_STATUS sch_send_beacon_req(struct mac_context *mac, uint8_t *beaconPayload,
 	qdf_mem_copy(beaconParams->beacon, beaconPayload, size);
 
 	beaconParams->beaconLength = (uint32_t) size;
+
+	/* WMA still refreshes its beacon copy and the P2P GO beacon IE */
+	if (sch_is_bcn_tmpl_sent(pe_session, beaconParams)) {
+		beaconParams->tmpl_unchanged = true;
+		pe_session->bcn_tmpl->stats.skipped++;
+		pe_session->bcn_tmpl->stats.bytes_skipped += size;
+	} else {
+		sch_save_bcn_tmpl_sent(pe_session, beaconParams);
+	}
+
 	msgQ.bodyptr = beaconParams;
 	msgQ.bodyval = 0;
 
 	MTRACE(mac_trace_msg_tx(mac, pe_session->peSessionId, msgQ.type));
 	retCode = wma_post_ctrl_msg(mac, &msgQ);
-	if (QDF_STATUS_SUCCESS != retCode)
+	if (QDF_STATUS_SUCCESS != retCode) {
 		pe_err("Posting SEND_BEACON_REQ to HAL failed, reason=%X",
 			retCode);
+		sch_reset_bcn_tmpl_sent(pe_session);
+	}
 
 	if (QDF_IS_STATUS_SUCCESS(retCode)) {
 		if (wlan_vdev_mlme_is_mlo_ap(pe_session->vdev))
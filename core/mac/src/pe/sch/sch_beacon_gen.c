@@ -528,6 +528,61 @@ static inline void omit_caps_for_2link_sap(tDot11fBeacon2 *bcn_2)
 }
 #endif
 
+static struct sch_bcn_tmpl *sch_get_bcn_tmpl(struct pe_session *session)
+{
+	if (!session->bcn_tmpl)
+		session->bcn_tmpl = qdf_mem_malloc(sizeof(*session->bcn_tmpl));
+
+	return session->bcn_tmpl;
+}
+
+static void sch_get_bcn_csa_key(struct pe_session *session,
+				struct sch_bcn_csa_key *key)
+{
+	tLimChannelSwitchInfo *ch_sw = &session->gLimChannelSwitch;
+
+	qdf_mem_zero(key, sizeof(*key));
+	key->sw_target_freq = ch_sw->sw_target_freq;
+	key->ch_width = ch_sw->ch_width;
+	key->primary_channel = ch_sw->primaryChannel;
+	key->seg0 = ch_sw->ch_center_freq_seg0;
+	key->seg1 = ch_sw->ch_center_freq_seg1;
+	key->sec_ch_offset = ch_sw->sec_ch_offset;
+	key->switch_mode = ch_sw->switchMode;
+	key->non_ecsa_cap_num = session->lim_non_ecsa_cap_num;
+	key->dfs_include_ch_sw_ie = session->dfsIncludeChanSwIe;
+	key->bw_update_include_ch_sw_ie = session->bw_update_include_ch_sw_ie;
+}
+
+/**
+ * sch_save_bcn_tmpl_state() - save the state of a newly built template
+ * @mac_ctx: mac global context
+ * @session: pe session entry
+ * @tmpl: template cache of @session
+ * @csa_ie_ofst: CSA switch count offset in pSchBeaconFrameEnd
+ * @ecsa_ie_ofst: ECSA switch count offset in pSchBeaconFrameEnd
+ *
+ * MLO templates also carry the partner link CSA state, they are always
+ * rebuilt.
+ *
+ * Return: None
+ */
+static void sch_save_bcn_tmpl_state(struct mac_context *mac_ctx,
+				    struct pe_session *session,
+				    struct sch_bcn_tmpl *tmpl,
+				    uint32_t csa_ie_ofst,
+				    uint32_t ecsa_ie_ofst)
+{
+	sch_get_bcn_csa_key(session, &tmpl->csa_key);
+	tmpl->csa_ie_ofst = csa_ie_ofst;
+	tmpl->ecsa_ie_ofst = ecsa_ie_ofst;
+	tmpl->csa_count_offset = mac_ctx->sch.csa_count_offset;
+	tmpl->ecsa_count_offset = mac_ctx->sch.ecsa_count_offset;
+	tmpl->p2p_ie_offset = mac_ctx->sch.p2p_ie_offset;
+	tmpl->valid = !wlan_vdev_mlme_is_mlo_ap(session->vdev);
+	tmpl->stats.full_builds++;
+}
+
 /**
  * sch_set_fixed_beacon_fields() - sets the fixed params in beacon frame
  * @mac_ctx:       mac global context
@@ -571,25 +626,21 @@ sch_set_fixed_beacon_fields(struct mac_context *mac_ctx, struct pe_session *sess
 	uint16_t mlo_ie_len = 0;
 	uint16_t tim_size;
 	uint8_t reg_cc[REG_ALPHA2_LEN + 1];
+	struct sch_bcn_tmpl *tmpl;
 
 	tim_size = sch_get_tim_size(HAL_NUM_STA);
 
-	bcn_1 = qdf_mem_malloc(sizeof(tDot11fBeacon1));
-	if (!bcn_1)
-		return QDF_STATUS_E_NOMEM;
-
-	bcn_2 = qdf_mem_malloc(sizeof(tDot11fBeacon2));
-	if (!bcn_2) {
-		qdf_mem_free(bcn_1);
+	tmpl = sch_get_bcn_tmpl(session);
+	if (!tmpl)
 		return QDF_STATUS_E_NOMEM;
-	}
 
-	wsc_prb_res = qdf_mem_malloc(sizeof(tDot11fIEWscProbeRes));
-	if (!wsc_prb_res) {
-		qdf_mem_free(bcn_1);
-		qdf_mem_free(bcn_2);
-		return QDF_STATUS_E_NOMEM;
-	}
+	tmpl->valid = false;
+	bcn_1 = &tmpl->bcn_1;
+	bcn_2 = &tmpl->bcn_2;
+	wsc_prb_res = &tmpl->wsc_prb_res;
+	qdf_mem_zero(bcn_1, sizeof(*bcn_1));
+	qdf_mem_zero(bcn_2, sizeof(*bcn_2));
+	qdf_mem_zero(wsc_prb_res, sizeof(*wsc_prb_res));
 	/*
 	 * First set the fixed fields:
 	 * set the TFP headers, set the mac header
@@ -654,9 +705,6 @@ sch_set_fixed_beacon_fields(struct mac_context *mac_ctx, struct pe_session *sess
 	if (DOT11F_FAILED(n_status)) {
 		pe_err("Failed to packed a tDot11fBeacon1 (0x%08x)",
 			n_status);
-		qdf_mem_free(bcn_1);
-		qdf_mem_free(bcn_2);
-		qdf_mem_free(wsc_prb_res);
 		return QDF_STATUS_E_FAILURE;
 	} else if (DOT11F_WARNED(n_status)) {
 		pe_warn("Warnings while packing a tDot11fBeacon1(0x%08x)",
@@ -882,12 +930,8 @@ sch_set_fixed_beacon_fields(struct mac_context *mac_ctx, struct pe_session *sess
 
 		addn_ielen = session->add_ie_params.probeRespBCNDataLen;
 		addn_ie = qdf_mem_malloc(addn_ielen);
-		if (!addn_ie) {
-			qdf_mem_free(bcn_1);
-			qdf_mem_free(bcn_2);
-			qdf_mem_free(wsc_prb_res);
+		if (!addn_ie)
 			return QDF_STATUS_E_NOMEM;
-		}
 		qdf_mem_copy(addn_ie,
 			session->add_ie_params.probeRespBCNData_buff,
 			addn_ielen);
@@ -1080,17 +1124,74 @@ sch_set_fixed_beacon_fields(struct mac_context *mac_ctx, struct pe_session *sess
 			 session->gLimChannelSwitch.switchCount,
 			 session->gLimChannelSwitch.switchMode);
 	}
+	sch_save_bcn_tmpl_state(mac_ctx, session, tmpl, csa_count_offset,
+				ecsa_count_offset);
 	mac_ctx->sch.beacon_changed = 1;
 	status = QDF_STATUS_SUCCESS;
 
 free_and_exit:
-	qdf_mem_free(bcn_1);
-	qdf_mem_free(bcn_2);
-	qdf_mem_free(wsc_prb_res);
 	qdf_mem_free(addn_ie);
 	return status;
 }
 
+QDF_STATUS sch_update_csa_count(struct mac_context *mac_ctx,
+				struct pe_session *session)
+{
+	struct sch_bcn_tmpl *tmpl = session->bcn_tmpl;
+	struct sch_bcn_csa_key key;
+	uint8_t count;
+
+	if (!tmpl || !tmpl->valid || !session->dfsIncludeChanSwIe)
+		return QDF_STATUS_E_INVAL;
+
+	if (session->gLimChannelSwitch.switchCount <= 0)
+		return QDF_STATUS_E_INVAL;
+
+	if (!tmpl->csa_ie_ofst && !tmpl->ecsa_ie_ofst)
+		return QDF_STATUS_E_INVAL;
+
+	sch_get_bcn_csa_key(session, &key);
+	if (qdf_mem_cmp(&key, &tmpl->csa_key, sizeof(key)))
+		return QDF_STATUS_E_INVAL;
+
+	count = session->gLimChannelSwitch.switchCount;
+	if (tmpl->csa_ie_ofst)
+		session->pSchBeaconFrameEnd[tmpl->csa_ie_ofst] = count;
+	if (tmpl->ecsa_ie_ofst)
+		session->pSchBeaconFrameEnd[tmpl->ecsa_ie_ofst] = count;
+
+	if (session->probeRespFrame.ChanSwitchAnn.present)
+		session->probeRespFrame.ChanSwitchAnn.switchCount = count;
+	if (session->probeRespFrame.ext_chan_switch_ann.present)
+		session->probeRespFrame.ext_chan_switch_ann.switch_count =
+									count;
+
+	/* the SCH offsets are shared, another session may have changed them */
+	mac_ctx->sch.csa_count_offset = tmpl->csa_count_offset;
+	mac_ctx->sch.ecsa_count_offset = tmpl->ecsa_count_offset;
+	mac_ctx->sch.p2p_ie_offset = tmpl->p2p_ie_offset;
+	mac_ctx->sch.beacon_changed = 1;
+	tmpl->stats.count_patches++;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+void sch_free_bcn_tmpl(struct pe_session *session)
+{
+	struct sch_bcn_tmpl *tmpl = session->bcn_tmpl;
+
+	if (!tmpl)
+		return;
+
+	pe_debug("vdev %d: bcn tmpl builds %u count patches %u sent %u skipped %u (%llu bytes)",
+		 session->vdev_id, tmpl->stats.full_builds,
+		 tmpl->stats.count_patches, tmpl->stats.sent,
+		 tmpl->stats.skipped, tmpl->stats.bytes_skipped);
+
+	session->bcn_tmpl = NULL;
+	qdf_mem_free(tmpl);
+}
+
 QDF_STATUS
 lim_update_probe_rsp_template_ie_bitmap_beacon1(struct mac_context *mac,
 						tDot11fBeacon1 *beacon1,
@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "ani_global.h"
+#include "dph_hash_table.h"
+#include "lim_session.h"
+#include "lim_session_test.h"
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+
+#define pe_test_log(fmt, args...) \
+	qdf_nofl_info("lim_session_test: " fmt, ##args)
+
+#define PE_T_SESSIONS		4
+#define PE_T_USED_SESSIONS	3
+#define PE_T_PEERS		4
+#define PE_T_MAX_ADDRS		64
+#define PE_T_BENCH_ROUNDS	1000
+
+/**
+ * enum pe_test_key - kind of lookup
+ * @PE_T_KEY_BSSID: pe_find_session_by_bssid()
+ * @PE_T_KEY_PEER: pe_find_session_by_peer_sta()
+ * @PE_T_KEY_MAX: number of lookup kinds
+ */
+enum pe_test_key {
+	PE_T_KEY_BSSID,
+	PE_T_KEY_PEER,
+	PE_T_KEY_MAX,
+};
+
+static const char * const pe_test_key_name[PE_T_KEY_MAX] = {
+	"bssid", "peer",
+};
+
+/**
+ * struct pe_test_addrs - addresses to look up
+ * @addr: addresses, live ones followed by unused ones
+ * @num: number of addresses
+ */
+struct pe_test_addrs {
+	tSirMacAddr addr[PE_T_MAX_ADDRS];
+	uint32_t num;
+};
+
+static void pe_test_mac_destroy(struct mac_context *mac)
+{
+	struct dph_hash_table *table;
+	uint8_t i;
+
+	if (mac->lim.gpSession) {
+		for (i = 0; i < PE_T_SESSIONS; i++) {
+			table = &mac->lim.gpSession[i].dph.dphHashTable;
+			qdf_mem_free(table->pDphNodeArray);
+			qdf_mem_free(table->pHashTable);
+		}
+		qdf_mem_free(mac->lim.gpSession);
+	}
+	qdf_mem_free(mac);
+}
+
+/**
+ * pe_test_mac_create() - MAC context with a private PE session table
+ *
+ * Only the session table, the session index and the peer index of the
+ * LIM context are set up. Every session gets an empty DPH table.
+ *
+ * Return: MAC context, NULL on allocation failure
+ */
+static struct mac_context *pe_test_mac_create(void)
+{
+	struct dph_hash_table *table;
+	struct mac_context *mac;
+	uint8_t i;
+
+	mac = qdf_mem_malloc(sizeof(*mac));
+	if (!mac)
+		return NULL;
+
+	mac->lim.maxBssId = PE_T_SESSIONS;
+	mac->lim.session_index.enabled = true;
+	dph_peer_index_init(&mac->lim.peer_index);
+	mac->lim.gpSession = qdf_mem_malloc(sizeof(*mac->lim.gpSession) *
+					    PE_T_SESSIONS);
+	if (!mac->lim.gpSession)
+		goto fail;
+
+	for (i = 0; i < PE_T_SESSIONS; i++) {
+		table = &mac->lim.gpSession[i].dph.dphHashTable;
+		table->pHashTable = qdf_mem_malloc(sizeof(*table->pHashTable) *
+						   (PE_T_PEERS + 1));
+		table->pDphNodeArray =
+			qdf_mem_malloc(sizeof(*table->pDphNodeArray) *
+				       (PE_T_PEERS + 1));
+		if (!table->pHashTable || !table->pDphNodeArray)
+			goto fail;
+
+		table->size = PE_T_PEERS + 1;
+		table->peer_index = &mac->lim.peer_index;
+		table->session_id = i;
+		dph_hash_table_init(mac, table);
+	}
+
+	return mac;
+
+fail:
+	pe_test_mac_destroy(mac);
+
+	return NULL;
+}
+
+/**
+ * pe_test_sessions_setup() - fill the private session table
+ * @mac: MAC context from pe_test_mac_create()
+ *
+ * Sessions 0 and 2 share a BSSID, sessions 1 and 2 share vdev 1 and one
+ * peer, which is added to session 1 first. The last session is not used.
+ *
+ * Return: number of errors
+ */
+static uint32_t pe_test_sessions_setup(struct mac_context *mac)
+{
+	static const uint8_t vdev_id[PE_T_USED_SESSIONS] = {0, 1, 1};
+	tSirMacAddr bssid = {0x02, 0x00, 0x5e, 0x7e, 0x57, 0x00};
+	tSirMacAddr peer = {0x02, 0x00, 0x5e, 0x7e, 0x58, 0x00};
+	struct pe_session *session;
+	struct dph_hash_table *table;
+	uint32_t errors = 0;
+	uint16_t j;
+	uint8_t i;
+
+	for (i = 0; i < PE_T_USED_SESSIONS; i++) {
+		session = &mac->lim.gpSession[i];
+		table = &session->dph.dphHashTable;
+		session->valid = true;
+		session->peSessionId = i;
+		bssid[5] = i & 1;
+		pe_session_set_vdev_id(mac, session, vdev_id[i]);
+		pe_session_set_bssid(mac, session, bssid);
+
+		for (j = 1; j < PE_T_PEERS; j++) {
+			peer[4] = i;
+			peer[5] = j;
+			if (!dph_add_hash_entry(mac, peer, j, table))
+				errors++;
+		}
+	}
+
+	peer[4] = 0xff;
+	peer[5] = 0xff;
+	for (i = 1; i < PE_T_USED_SESSIONS; i++) {
+		table = &mac->lim.gpSession[i].dph.dphHashTable;
+		if (!dph_add_hash_entry(mac, peer, PE_T_PEERS, table))
+			errors++;
+	}
+
+	if (errors)
+		pe_test_log("setup: %u peers not added", errors);
+
+	return errors;
+}
+
+static void pe_test_add_addr(struct pe_test_addrs *addrs, uint8_t *addr)
+{
+	if (addrs->num < PE_T_MAX_ADDRS)
+		sir_copy_mac_addr(addrs->addr[addrs->num++], addr);
+}
+
+/**
+ * pe_test_collect() - gather the BSSIDs and peers of the sessions
+ * @mac: MAC context from pe_test_mac_create()
+ * @addrs: per lookup kind address lists to fill
+ *
+ * Every address is also added with its last byte flipped, which is
+ * expected to miss.
+ *
+ * Return: none
+ */
+static void pe_test_collect(struct mac_context *mac,
+			    struct pe_test_addrs *addrs)
+{
+	struct pe_session *session;
+	struct dph_hash_table *table;
+	uint32_t live, k;
+	uint16_t i, j;
+
+	for (i = 0; i < mac->lim.maxBssId; i++) {
+		session = &mac->lim.gpSession[i];
+		if (!session->valid)
+			continue;
+
+		pe_test_add_addr(&addrs[PE_T_KEY_BSSID], session->bssId);
+		table = &session->dph.dphHashTable;
+		for (j = 0; j < table->size; j++)
+			if (table->pDphNodeArray[j].added)
+				pe_test_add_addr(&addrs[PE_T_KEY_PEER],
+						 table->pDphNodeArray[j].staAddr);
+	}
+
+	for (k = 0; k < PE_T_KEY_MAX; k++) {
+		live = addrs[k].num;
+		for (j = 0; j < live; j++) {
+			pe_test_add_addr(&addrs[k], addrs[k].addr[j]);
+			addrs[k].addr[addrs[k].num - 1][5] ^= 0xff;
+		}
+	}
+}
+
+static struct pe_session *pe_test_scan_bssid(struct mac_context *mac,
+					     uint8_t *bssid)
+{
+	uint8_t i;
+
+	for (i = 0; i < mac->lim.maxBssId; i++)
+		if (mac->lim.gpSession[i].valid &&
+		    sir_compare_mac_addr(mac->lim.gpSession[i].bssId, bssid))
+			return &mac->lim.gpSession[i];
+
+	return NULL;
+}
+
+static struct pe_session *pe_test_scan_peer(struct mac_context *mac,
+					    uint8_t *sa)
+{
+	struct pe_session *session;
+	uint16_t aid;
+	uint8_t i;
+
+	for (i = 0; i < mac->lim.maxBssId; i++) {
+		session = &mac->lim.gpSession[i];
+		if (session->valid &&
+		    dph_lookup_hash_entry(mac, sa, &aid,
+					  &session->dph.dphHashTable))
+			return session;
+	}
+
+	return NULL;
+}
+
+static struct pe_session *pe_test_scan_vdev(struct mac_context *mac,
+					    uint8_t vdev_id)
+{
+	uint8_t i;
+
+	for (i = 0; i < mac->lim.maxBssId; i++)
+		if (mac->lim.gpSession[i].valid &&
+		    mac->lim.gpSession[i].vdev_id == vdev_id)
+			return &mac->lim.gpSession[i];
+
+	return NULL;
+}
+
+static struct pe_session *pe_test_lookup(struct mac_context *mac,
+					 enum pe_test_key key, uint8_t *addr,
+					 bool indexed)
+{
+	uint8_t session_id;
+
+	if (key == PE_T_KEY_BSSID)
+		return indexed ?
+			pe_find_session_by_bssid(mac, addr, &session_id) :
+			pe_test_scan_bssid(mac, addr);
+
+	return indexed ? pe_find_session_by_peer_sta(mac, addr, &session_id) :
+			 pe_test_scan_peer(mac, addr);
+}
+
+/**
+ * pe_test_addr_lookups() - compare and time address based lookups
+ * @mac: MAC context from pe_test_mac_create()
+ * @key: lookup kind
+ * @addrs: addresses to look up
+ *
+ * Return: number of errors
+ */
+static uint32_t pe_test_addr_lookups(struct mac_context *mac,
+				     enum pe_test_key key,
+				     struct pe_test_addrs *addrs)
+{
+	struct pe_session *expected;
+	uint64_t start, elapsed_us[2];
+	uint32_t errors = 0;
+	uint32_t i, r, p;
+
+	if (!addrs->num)
+		return 0;
+
+	for (i = 0; i < addrs->num; i++) {
+		expected = pe_test_lookup(mac, key, addrs->addr[i], false);
+		if (pe_test_lookup(mac, key, addrs->addr[i], true) !=
+		    expected) {
+			pe_test_log("%s "QDF_MAC_ADDR_FMT": lookup disagrees with scan",
+				    pe_test_key_name[key],
+				    QDF_MAC_ADDR_REF(addrs->addr[i]));
+			errors++;
+		}
+	}
+
+	for (p = 0; p < 2; p++) {
+		start = qdf_ktime_to_us(qdf_ktime_get());
+		for (r = 0; r < PE_T_BENCH_ROUNDS; r++)
+			for (i = 0; i < addrs->num; i++)
+				pe_test_lookup(mac, key, addrs->addr[i], p);
+		elapsed_us[p] = qdf_ktime_to_us(qdf_ktime_get()) - start;
+	}
+
+	pe_test_log("bench %s: %u lookups x %u rounds, scan %llu us (%llu ns/lookup), lookup %llu us (%llu ns/lookup)",
+		    pe_test_key_name[key], addrs->num, PE_T_BENCH_ROUNDS,
+		    elapsed_us[0],
+		    qdf_do_div(elapsed_us[0] * 1000,
+			       addrs->num * PE_T_BENCH_ROUNDS),
+		    elapsed_us[1],
+		    qdf_do_div(elapsed_us[1] * 1000,
+			       addrs->num * PE_T_BENCH_ROUNDS));
+
+	return errors;
+}
+
+/**
+ * pe_test_vdev_lookups() - compare vdev id based lookups
+ * @mac: MAC context from pe_test_mac_create()
+ *
+ * Return: number of errors
+ */
+static uint32_t pe_test_vdev_lookups(struct mac_context *mac)
+{
+	uint32_t errors = 0;
+	uint8_t vdev_id;
+
+	for (vdev_id = 0; vdev_id < WLAN_MAX_VDEVS; vdev_id++) {
+		if (pe_find_session_by_vdev_id(mac, vdev_id) !=
+		    pe_test_scan_vdev(mac, vdev_id)) {
+			pe_test_log("vdev %d: lookup disagrees with scan",
+				    vdev_id);
+			errors++;
+		}
+	}
+
+	return errors;
+}
+
+/**
+ * pe_test_lookups() - run the lookup checks on the private session table
+ * @mac: MAC context from pe_test_mac_create()
+ *
+ * Return: number of errors
+ */
+static uint32_t pe_test_lookups(struct mac_context *mac)
+{
+	struct pe_test_addrs *addrs;
+	uint32_t errors = 0;
+	uint32_t k;
+
+	addrs = qdf_mem_malloc(sizeof(*addrs) * PE_T_KEY_MAX);
+	if (!addrs)
+		return 1;
+
+	pe_test_collect(mac, addrs);
+	for (k = 0; k < PE_T_KEY_MAX; k++)
+		errors += pe_test_addr_lookups(mac, k, &addrs[k]);
+	errors += pe_test_vdev_lookups(mac);
+
+	qdf_mem_free(addrs);
+
+	return errors;
+}
+
+/**
+ * pe_test_stop_bss() - peers of a stopped BSS must leave the peer index
+ * @mac: MAC context from pe_test_mac_create()
+ *
+ * Adds associated peers to the DPH table of the unused session, then
+ * re-initializes the table the way a SAP stop does on the DEL BSS
+ * response, and looks the peers up again.
+ *
+ * Return: number of errors
+ */
+static uint32_t pe_test_stop_bss(struct mac_context *mac)
+{
+	tSirMacAddr addr = {0x02, 0x00, 0x5e, 0x7e, 0x59, 0x00};
+	struct dph_hash_table *table;
+	uint32_t count = mac->lim.peer_index.count;
+	uint32_t errors = 0;
+	uint16_t assoc_id;
+	uint8_t session_id;
+	uint16_t i;
+
+	table = &mac->lim.gpSession[PE_T_SESSIONS - 1].dph.dphHashTable;
+	for (i = 1; i <= PE_T_PEERS; i++) {
+		addr[5] = i;
+		if (!dph_add_hash_entry(mac, addr, i, table) ||
+		    !dph_peer_index_lookup(mac, addr, &session_id,
+					   &assoc_id)) {
+			pe_test_log("stop bss: peer %d not indexed", i);
+			errors++;
+		}
+	}
+
+	/* what lim_process_sme_del_bss_rsp() does to the session table */
+	dph_hash_table_init(mac, table);
+
+	for (i = 1; i <= PE_T_PEERS; i++) {
+		addr[5] = i;
+		if (dph_peer_index_lookup(mac, addr, &session_id, &assoc_id)) {
+			pe_test_log("stop bss: peer "QDF_MAC_ADDR_FMT" still indexed",
+				    QDF_MAC_ADDR_REF(addr));
+			errors++;
+		}
+	}
+	if (mac->lim.peer_index.count != count) {
+		pe_test_log("stop bss: %u nodes left in the index",
+			    mac->lim.peer_index.count - count);
+		errors++;
+	}
+
+	return errors;
+}
+
+uint32_t pe_session_lookup_unit_test(void)
+{
+	struct mac_context *mac;
+	uint32_t errors;
+
+	mac = pe_test_mac_create();
+	if (!mac)
+		return 1;
+
+	errors = pe_test_sessions_setup(mac);
+	errors += pe_test_lookups(mac);
+
+	/* a session table too large for the index falls back to scans */
+	mac->lim.session_index.enabled = false;
+	errors += pe_test_lookups(mac);
+	mac->lim.session_index.enabled = true;
+
+	errors += pe_test_stop_bss(mac);
+
+	pe_test_mac_destroy(mac);
+
+	return errors;
+}
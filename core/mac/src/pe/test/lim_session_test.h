@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2024 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __LIM_SESSION_TEST
+#define __LIM_SESSION_TEST
+
+#ifdef WLAN_PE_SESSION_LOOKUP_TEST
+/**
+ * pe_session_lookup_unit_test() - check and time indexed PE session lookups
+ *
+ * Builds a private PE session table with shared BSSIDs, vdev ids and
+ * peers. Looks up every session by BSSID and vdev id and every peer by
+ * MAC address, plus addresses and vdev ids which are not in use, through
+ * both the PE lookup APIs and a linear scan of the table, with and
+ * without the session index. Checks both agree and logs the time taken
+ * by each. Also checks that the peers of a stopped BSS leave the peer
+ * index.
+ *
+ * Return: number of failed test cases
+ */
+uint32_t pe_session_lookup_unit_test(void);
+#else
+static inline uint32_t pe_session_lookup_unit_test(void)
+{
+	return 0;
+}
+#endif /* WLAN_PE_SESSION_LOOKUP_TEST */
+
+#endif /* __LIM_SESSION_TEST */
@@ -505,6 +505,8 @@ struct beacon_gen_params {
  * @ecsa_count_offset: Offset of Switch count field in ECSA IE
  * @reason: bcn update reason
  * @status: beacon send status
+ * @tmpl_unchanged: firmware already has this template, only the host side
+ *		    copies are updated
  */
 typedef struct {
 	uint8_t vdev_id;
@@ -517,6 +519,7 @@ typedef struct {
 	uint32_t ecsa_count_offset;
 	enum sir_bcn_update_reason reason;
 	QDF_STATUS status;
+	bool tmpl_unchanged;
 #ifdef WLAN_FEATURE_11BE_MLO
 	struct mlo_bcn_templ_partner_links mlo_partner;
 #endif
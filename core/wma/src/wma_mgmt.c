@@ -2526,10 +2526,13 @@ void wma_send_beacon(tp_wma_handle wma, tpSendbeaconParams bcn_info)
 
 	if (wmi_service_enabled(wma->wmi_handle,
 				   wmi_service_beacon_offload)) {
-		status = wma_unified_bcn_tmpl_send(wma, vdev_id, bcn_info, 4);
-		if (QDF_IS_STATUS_ERROR(status)) {
-			wma_err("wmi_unified_bcn_tmpl_send Failed");
-			goto send_rsp;
+		if (!bcn_info->tmpl_unchanged) {
+			status = wma_unified_bcn_tmpl_send(wma, vdev_id,
+							   bcn_info, 4);
+			if (QDF_IS_STATUS_ERROR(status)) {
+				wma_err("wmi_unified_bcn_tmpl_send Failed");
+				goto send_rsp;
+			}
 		}
 
 		if (bcn_info->p2pIeOffset) {
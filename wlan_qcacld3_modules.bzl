@@ -188,6 +188,7 @@ _fixed_ipaths = [
     "components/cmn_services/logging/inc",
     "components/cmn_services/policy_mgr/inc",
     "components/cmn_services/policy_mgr/src",
+    "components/cmn_services/policy_mgr/test",
     "components/coap/core/inc",
     "components/coap/dispatcher/inc",
     "components/coex/core/inc",
@@ -201,6 +202,7 @@ _fixed_ipaths = [
     "components/dp/core/inc",
     "components/dp/core/src",
     "components/dp/dispatcher/inc",
+    "components/dp/test",
     "components/dsc/inc",
     "components/dsc/src",
     "components/dsc/test",
@@ -271,6 +273,7 @@ _fixed_ipaths = [
     "core/dp/htt",
     "core/dp/ol/inc",
     "core/dp/txrx",
+    "core/dp/txrx/test",
     "core/hdd/inc",
     "core/hdd/src",
     "core/mac/inc",
@@ -279,6 +282,7 @@ _fixed_ipaths = [
     "core/mac/src/pe/include",
     "core/mac/src/pe/lim",
     "core/mac/src/pe/nan",
+    "core/mac/src/pe/test",
     "core/mac/src/sys/common/inc",
     "core/mac/src/sys/legacy/src/platform/inc",
     "core/mac/src/sys/legacy/src/system/inc",
@@ -695,6 +699,51 @@ _conditional_srcs = {
             "cmn/hif/src/kiwidef.c",
         ],
     },
+    "CONFIG_DP_HOST_APF_TEST": {
+        True: [
+            "components/dp/test/wlan_dp_apf_test.c",
+        ],
+    },
+    "CONFIG_DP_PKT_CLASS_TEST": {
+        True: [
+            "components/dp/test/wlan_dp_pkt_class_test.c",
+        ],
+    },
+    "CONFIG_DP_STALL_CORR_TEST": {
+        True: [
+            "components/dp/test/wlan_dp_stall_corr_test.c",
+        ],
+    },
+    "CONFIG_DP_STATS_SAMPLER_TEST": {
+        True: [
+            "components/dp/test/wlan_dp_stats_sampler_test.c",
+        ],
+    },
+    "CONFIG_POLICY_MGR_TEST": {
+        True: [
+            "components/cmn_services/policy_mgr/test/wlan_policy_mgr_test.c",
+        ],
+    },
+    "CONFIG_OL_RX_PN_TEST": {
+        True: [
+            "core/dp/txrx/test/ol_rx_pn_test.c",
+        ],
+    },
+    "CONFIG_OL_RX_DEFRAG_TEST": {
+        True: [
+            "core/dp/txrx/test/ol_rx_defrag_test.c",
+        ],
+    },
+    "CONFIG_OL_TX_PEER_BAL_TEST": {
+        True: [
+            "core/dp/txrx/test/ol_tx_peer_bal_test.c",
+        ],
+    },
+    "CONFIG_PE_SESSION_LOOKUP_TEST": {
+        True: [
+            "core/mac/src/pe/test/lim_session_test.c",
+        ],
+    },
     "CONFIG_QCA6750_HEADERS_DEF": {
         True: [
             "cmn/hal/wifi3.0/qca6750/hal_6750.c",
@@ -1397,6 +1446,27 @@ _conditional_srcs = {
             "cmn/dp/wifi3.0/monitor/2.0/dp_tx_mon_status_2.0.c",
         ],
     },
+    "CONFIG_WLAN_DP_HOST_APF": {
+        True: [
+            "components/dp/core/src/wlan_dp_apf.c",
+        ],
+    },
+    "CONFIG_WLAN_DP_STALL_CORRELATOR": {
+        True: [
+            "components/dp/core/src/wlan_dp_stall_corr.c",
+        ],
+    },
+    "CONFIG_WLAN_DP_STATS_SAMPLER": {
+        True: [
+            "components/dp/core/src/wlan_dp_stats_sampler.c",
+            "core/hdd/src/wlan_hdd_debugfs_dp_stats.c",
+        ],
+    },
+    "CONFIG_WLAN_SYSFS_NAPI_AFFINITY": {
+        True: [
+            "core/hdd/src/wlan_hdd_sysfs_napi_affinity.c",
+        ],
+    },
     "CONFIG_WLAN_TX_MON_2_0_Y_WLAN_DP_LOCAL_PKT_CAPTURE": {
         True: [
             "os_if/dp/src/os_if_dp_local_pkt_capture.c",
@@ -1486,6 +1556,7 @@ _conditional_srcs = {
             "core/hdd/src/wlan_hdd_debugfs_csr.c",
             "core/hdd/src/wlan_hdd_debugfs_offload.c",
             "core/hdd/src/wlan_hdd_debugfs_roam.c",
+            "core/hdd/src/wlan_hdd_debugfs_suspend.c",
             "core/hdd/src/wlan_hdd_debugfs_unit_test.c",
             "cmn/qdf/linux/src/qdf_debugfs.c",
         ],